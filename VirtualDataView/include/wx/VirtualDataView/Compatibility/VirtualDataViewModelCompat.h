@@ -71,6 +71,7 @@ class WXDLLIMPEXP_VDV wxVirtualDataViewModelCompat : public wxVirtualIDataModel
                                         const wxVirtualItemID &rID2,
                                         const wxVariant &rValue2,
                                         size_t uiField);                                    ///< \brief compare 2 items values
+        virtual bool            HasCustomCompare(size_t uiField);                           ///< \brief check if Compare() is reimplemented for a field
 
         //interface : misc
         virtual bool            HasExpander(const wxVirtualItemID &rID);                    ///< \brief return true if an item expander should be drawn for this item
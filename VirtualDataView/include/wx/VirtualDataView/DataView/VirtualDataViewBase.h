@@ -11,6 +11,7 @@
 #include <wx/VirtualDataView/VirtualDataViewDefs.h>
 #include <wx/VirtualDataView/ModelRenderer/VirtualIModelRenderer.h>
 #include <wx/VirtualDataView/DataView/VirtualDataViewEvent.h>
+#include <wx/VirtualDataView/Models/VirtualIDataModelObserver.h>
 #include <wx/systhemectrl.h>
 #include <wx/control.h>
 
@@ -23,7 +24,8 @@ class WXDLLIMPEXP_VDV wxVirtualItemID;
 
 extern const char wxsVirtualDataViewBaseName[];
 
-class WXDLLIMPEXP_VDV wxVirtualDataViewBase : public wxSystemThemedControl<wxControl>
+class WXDLLIMPEXP_VDV wxVirtualDataViewBase : public wxSystemThemedControl<wxControl>,
+                                              public wxVirtualIDataModelObserver
 {
     public:
 
@@ -101,6 +103,30 @@ class WXDLLIMPEXP_VDV wxVirtualDataViewBase : public wxSystemThemedControl<wxCon
         void OnDataModelChanged(void);                                      ///< \brief called by the client to notify that the data model has changed
         void OnLayoutChanged(void);                                         ///< \brief called by the client to notify changes in layout
 
+        //data model change notifications
+        virtual void OnItemsInserted(wxVirtualIDataModel *pModel,
+                                     const wxVirtualItemID &rParent,
+                                     size_t uiFirst, size_t uiCount);       ///< \brief some items were inserted
+        virtual void OnItemsRemoved(wxVirtualIDataModel *pModel,
+                                    const wxVirtualItemID &rParent,
+                                    size_t uiFirst, size_t uiCount);        ///< \brief some items were removed
+        virtual void OnItemsChanged(wxVirtualIDataModel *pModel,
+                                    const wxVirtualItemIDs &vIDs,
+                                    const TFieldIDs &vFields);              ///< \brief the values of some items changed
+        virtual void OnItemsMoved(wxVirtualIDataModel *pModel,
+                                  const wxVirtualItemID &rParent,
+                                  size_t uiFirst, size_t uiCount,
+                                  size_t uiDestination);                    ///< \brief some items were moved
+        virtual void OnChildrenReset(wxVirtualIDataModel *pModel,
+                                     const wxVirtualItemID &rParent);       ///< \brief the children of an item changed
+        virtual void OnModelReset(wxVirtualIDataModel *pModel);             ///< \brief the whole model changed
+        virtual void OnItemIDsShifted(wxVirtualIDataModel *pModel,
+                                      wxVirtualIListDataModel *pListModel,
+                                      size_t uiFirst, size_t uiCount,
+                                      bool bInserted);                      ///< \brief the item IDs of a list model were shifted
+        virtual void OnItemsRefreshed(wxVirtualIDataModel *pModel,
+                                      const wxVirtualItemIDs &vIDs);        ///< \brief some items must be repainted
+
         //sending events
         bool SendEvent(wxEventType eType, const wxVirtualItemID &rID,
                        size_t uiField = 0, size_t uiCol = 0);               ///< \brief send an event
@@ -118,14 +144,8 @@ class WXDLLIMPEXP_VDV wxVirtualDataViewBase : public wxSystemThemedControl<wxCon
         bool SendKeyboardEvent(const wxVirtualItemID &rID, size_t uiField,
                                size_t uiCol, wxKeyEvent &rEvent);           ///< \brief send a keyboard event on item
         bool SendScrollEvent(wxScrollWinEvent &rEvent);                     ///< \brief send a scrolling event
-        bool SendSelectionChangingEvent(wxVirtualItemIDs &vOld,
-                                        wxVirtualItemIDs &vNew);            ///< \brief send a selection changing event
-        bool SendSelectionChangedEvent(wxVirtualItemIDs &vOld,
-                                       wxVirtualItemIDs &vNew);             ///< \brief send a selection changed event
-        bool SendSelectionChangingEventByCopy(const wxVirtualItemIDs &vOld,
-                                              const wxVirtualItemIDs &vNew);///< \brief send a selection changing event
-        bool SendSelectionChangedEventByCopy(const wxVirtualItemIDs &vOld,
-                                             const wxVirtualItemIDs &vNew); ///< \brief send a selection changed event
+        bool SendSelectionChangingEvent(const wxVirtualSelectionDelta &rDelta); ///< \brief send a selection changing event
+        bool SendSelectionChangedEvent(wxVirtualSelectionDelta &rDelta);    ///< \brief send a selection changed event
         bool SendItemFocusedEvent(const wxVirtualItemID &rID,
                               size_t uiField, size_t uiCol, bool bFocused); ///< \brief send a get focus / lose focus event
         bool SendContextMenuEvent(const wxVirtualItemID &rID,
@@ -179,6 +199,12 @@ class WXDLLIMPEXP_VDV wxVirtualDataViewBase : public wxSystemThemedControl<wxCon
         void ReleaseDataModel(void);                                        ///< \brief release the data model
         void ReleaseStateModel(void);                                       ///< \brief release the state model
         void ReleaseModelRenderer(void);                                    ///< \brief release the model renderer
+        void OnChildrenChanged(const wxVirtualItemID &rParent);             ///< \brief the children of an item were inserted / removed / re-ordered
+        void OnRowsShifted(const wxVirtualItemID &rParent,
+                           size_t uiFirst, size_t uiCount,
+                           bool bInserted);                                 ///< \brief some children of an item were inserted / removed
+        void OnChildrenLayoutChanged(bool bRefresh,
+                                     const wxVirtualItemID &rFirstNew = wxVirtualItemID()); ///< \brief update the sizes after a change of the children of an item
 
         //interface: event handlers
         virtual void OnPaintEvent(wxPaintEvent &rEvent);                    ///< \brief paint handler
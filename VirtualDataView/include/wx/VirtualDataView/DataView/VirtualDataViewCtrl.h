@@ -14,6 +14,7 @@
 #include <wx/VirtualDataView/Columns/VirtualDataViewColumnsList.h>
 #include <wx/VirtualDataView/VirtualItemID.h>
 #include <wx/VirtualDataView/CellAttrs/VirtualDataViewItemAttr.h>
+#include <wx/VirtualDataView/ModelRenderer/VirtualIModelRenderer.h>
 
 class WXDLLIMPEXP_VDV wxVirtualIDataModel;
 class WXDLLIMPEXP_VDV wxVirtualIProxyDataModel;
@@ -28,6 +29,7 @@ class WXDLLIMPEXP_VDV wxVirtualDataViewCornerHeader;
 class WXDLLIMPEXP_VDV wxVirtualHeaderCtrlEvent;
 class WXDLLIMPEXP_VDV wxVirtualDataViewEvent;
 class WXDLLIMPEXP_VDV wxVirtualDataViewFilter;
+struct WXDLLIMPEXP_VDV wxVirtualDataViewStats;
 
 #if WX_USE_COMPATIBILITY_LAYER_WITH_DVC != 0
     class WXDLLIMPEXP_VDV wxDataViewModel;
@@ -145,6 +147,16 @@ class WXDLLIMPEXP_VDV wxVirtualDataViewCtrl : public wxSystemThemedControl<wxCon
         bool IsColumnShown(size_t uiColumn) const;                              ///< \brief check if a column is shown
         bool IsColumnHidden(size_t uiColumn) const;                             ///< \brief check if a column is hidden
 
+        //column auto-sizing
+        wxVirtualIModelRenderer::EAutoSizeMode GetAutoSizeMode(void) const;     ///< \brief get the column auto-sizing strategy
+        void SetAutoSizeMode(wxVirtualIModelRenderer::EAutoSizeMode eMode);     ///< \brief set the column auto-sizing strategy
+        size_t GetAutoSizeSampleSize(void) const;                               ///< \brief get the amount of rows sampled by WX_AUTOSIZE_SAMPLED
+        void SetAutoSizeSampleSize(size_t uiSampleSize);                        ///< \brief set the amount of rows sampled by WX_AUTOSIZE_SAMPLED
+        void InvalidateAutoSizeCache(void);                                     ///< \brief forget the cached best widths & stop background measurements
+        void InvalidateAutoSizeCache(const wxVector<size_t> &vFields);          ///< \brief forget the cached best widths of some model columns
+        void ExtendAutoSizeMeasures(const wxVirtualItemID &rFirstNew);          ///< \brief measure rows appended after the last top-level row
+        bool IsAutoSizing(void) const;                                          ///< \brief check if columns are measured in background
+
         //refresh
         void RefreshHeaders(void);                                              ///< \brief refresh the headers windows
         void RefreshDataView(void);                                             ///< \brief refresh the data view only
@@ -190,6 +202,7 @@ class WXDLLIMPEXP_VDV wxVirtualDataViewCtrl : public wxSystemThemedControl<wxCon
 
         //selection
         size_t GetSelectedItems(wxVirtualItemIDs &vIDs) const;                  ///< \brief get all the selected items
+        size_t GetSelectedItemCount(void) const;                                ///< \brief get the amount of selected items
         wxVirtualItemID GetFirstSelectedItem(void) const;                       ///< \brief get the 1st selected item
         wxVirtualItemID GetNextSelectedItem(const wxVirtualItemID &rID) const;  ///< \brief get the next selected item
         wxVirtualItemID GetPrevSelectedItem(const wxVirtualItemID &rID) const;  ///< \brief get the previous selected item
@@ -426,6 +439,12 @@ class WXDLLIMPEXP_VDV wxVirtualDataViewCtrl : public wxSystemThemedControl<wxCon
         bool ResizingColumn(size_t uiCol, int iNewWidth);                       ///< \brief currently resizing a column
         bool ResizeColumn(size_t uiCol, int iNewWidth);                         ///< \brief finish resizing a column
 
+        //performance counters
+        static void EnablePerformanceCounters(bool bEnable = true);             ///< \brief enable / disable the performance counters
+        static bool ArePerformanceCountersEnabled(void);                        ///< \brief check if the performance counters are enabled
+        void GetStatistics(wxVirtualDataViewStats &rStats) const;               ///< \brief get the performance counters
+        void ResetStatistics(void);                                             ///< \brief reset the performance counters
+
         //compatibility layer with wxDataViewCtrl
 #if WX_USE_COMPATIBILITY_LAYER_WITH_DVC != 0
         virtual bool  AssociateModel(wxDataViewModel *pDataModel);              ///< \brief associate a new data model
@@ -589,13 +608,22 @@ class WXDLLIMPEXP_VDV wxVirtualDataViewCtrl : public wxSystemThemedControl<wxCon
         wxVirtualDataViewColumnsList    m_vColumns;                             ///< \brief list of columns
         wxVirtualSortingDataModel*      m_pSortingModel;                        ///< \brief sorting data model
         wxVirtualFilteringDataModel*    m_pFilteringModel;                      ///< \brief filtering data model
+        wxVirtualIModelRenderer::EAutoSizeMode m_eAutoSizeMode;                 ///< \brief column auto-sizing strategy
+        size_t                          m_uiAutoSizeSampleSize;                 ///< \brief amount of rows sampled by WX_AUTOSIZE_SAMPLED
+        wxVector<int>                   m_vAutoSizeCache;                       ///< \brief best width per model column. < 0 : not computed
+        wxVector<wxVirtualIModelRenderer::TColumnMeasure> m_vAutoSizeJobs;      ///< \brief background measurements in progress
 
         //methods
         void InitDataView(void);                                                ///< \brief initialize the control
+        int  GetColumnBestWidth(wxVirtualIModelRenderer *pModelRenderer,
+                                size_t uiColumn);                               ///< \brief get the best width of a column, from the cache if possible
+        void ApplyColumnBestWidth(wxVirtualDataViewColumn *pCol, int iWidth);   ///< \brief resize a column to its best width
+        void UpdateColumnsLayout(void);                                         ///< \brief update scrollbars & redraw after column widths changed
 
         //event handlers
         virtual void OnSize(wxSizeEvent &rEvent);                               ///< \brief sizing event handlers
         virtual void OnScrollEvent(wxScrollWinEvent &rEvent);                   ///< \brief scrolling event handler
+        virtual void OnIdleEvent(wxIdleEvent &rEvent);                          ///< \brief idle event handler : background column measurements
 
         //column header event handlers
         virtual void OnColHeaderBeginSize(wxVirtualHeaderCtrlEvent &rEvent);    ///< \brief a column header is starting to be resized
@@ -9,6 +9,7 @@
 #define _WX_VIRTUAL_VIEW_EVENT_H_
 
 #include <wx/VirtualDataView/VirtualItemID.h>
+#include <wx/VirtualDataView/DataView/VirtualSelectionDelta.h>
 #include <wx/event.h>
 
 #if wxUSE_DRAG_AND_DROP
@@ -17,6 +18,7 @@
 #endif // wxUSE_DRAG_AND_DROP
 
 class WXDLLIMPEXP_VDV   wxVirtualDataViewColumn;
+class WXDLLIMPEXP_VDV   wxVirtualIStateModel;
 
 /** \class wxVirtualDataViewEvent : an event class for wxVirtualDataViewCtrl
   */
@@ -58,12 +60,18 @@ class WXDLLIMPEXP_VDV wxVirtualDataViewEvent : public wxNotifyEvent
         size_t GetFieldIndex(void) const;                                   ///< \brief get the item field index
 
         //selection changing / changed
+        void SetSelectionDelta(const wxVirtualSelectionDelta &rDelta);      ///< \brief set the change of selection (copy performed)
+        void AssignSelectionDelta(wxVirtualSelectionDelta &rDelta);         ///< \brief set the change of selection (move performed)
+        const wxVirtualSelectionDelta& GetSelectionDelta(void) const;       ///< \brief get the change of selection
         void SetDeselectedItems(const wxVirtualItemIDs &vIDs);              ///< \brief set the de-selected items (copy performed)
         void AssignDeselectedItems(wxVirtualItemIDs &vIDs);                 ///< \brief set the de-selected items (move performed)
         const wxVirtualItemIDs& GetDeselectedItems(void) const;             ///< \brief get the de-selected items
         void SetSelectedItems(const wxVirtualItemIDs &vIDs);                ///< \brief set the selected items
         void AssignSelectedItems(wxVirtualItemIDs &vIDs);                   ///< \brief set the selected items (move performed)
         const wxVirtualItemIDs& GetSelectedItems(void) const;               ///< \brief get the selected items
+        void SetStateModel(wxVirtualIStateModel *pStateModel);              ///< \brief set the state model holding the selection
+        size_t GetCurrentSelection(wxVirtualItemIDs &vIDs) const;           ///< \brief get the full selection (computed on demand)
+        size_t GetCurrentSelectionCount(void) const;                        ///< \brief get the amount of selected items (computed on demand)
 
         //column
         void SetColumnIndex(size_t uiViewColumn);                           ///< \brief set the view column
@@ -131,8 +139,8 @@ class WXDLLIMPEXP_VDV wxVirtualDataViewEvent : public wxNotifyEvent
         wxUint32                    m_uiHitTestFlags;                       ///< \brief hit test flags (for mouse events)
         wxPoint                     m_ptRelativePos;                        ///< \brief position relative to item bounding rectangle (for mouse events)
         wxKeyEvent                  m_KeyEvent;                             ///< \brief keyboard event
-        wxVirtualItemIDs            m_vDeselectedItems;                     ///< \brief de-selected items
-        wxVirtualItemIDs            m_vSelectedItems;                       ///< \brief selected items
+        wxVirtualSelectionDelta     m_SelectionDelta;                       ///< \brief change of selection
+        wxVirtualIStateModel*       m_pStateModel;                          ///< \brief state model holding the selection
 
     #if wxUSE_DRAG_AND_DROP
         //drag operations
@@ -0,0 +1,70 @@
+/**********************************************************************/
+/** FILE    : VirtualSelectionDelta.h                                **/
+/** PROJECT : wxVirtualDataViewCtrl                                  **/
+/** LICENSE : wxWindows Library Licence                              **/
+/** PURPOSE : description of a change of selection                   **/
+/**********************************************************************/
+
+#ifndef _WX_VIRTUAL_SELECTION_DELTA_H_
+#define _WX_VIRTUAL_SELECTION_DELTA_H_
+
+#include <wx/VirtualDataView/VirtualItemID.h>
+
+/** \class wxVirtualSelectionDelta : describes a change of selection, without listing the whole selection
+  * The change is applied in the following order:
+  *     1 - if IsDeselectAll() : all the items are deselected
+  *     2 - if IsSelectAll()   : all the items are selected
+  *     3 - the deselected ranges & items are deselected
+  *     4 - the selected ranges & items are selected
+  * A range is given by its first and last items (both included), in the order of
+  * wxVirtualIDataModel::NextItem (collapsed children skipped).
+  * The size of the description is proportional to the amount of changes described, not to the
+  * amount of selected items: selecting all the items, or a range of 1 million items, costs 1 entry
+  */
+class WXDLLIMPEXP_VDV wxVirtualSelectionDelta
+{
+    public:
+        //constructors & destructor
+        wxVirtualSelectionDelta(void);                                      ///< \brief constructor
+        ~wxVirtualSelectionDelta(void);                                     ///< \brief destructor
+
+        //general
+        void Clear(void);                                                   ///< \brief clear the description
+        bool IsEmpty(void) const;                                           ///< \brief check if no change is described
+        void Swap(wxVirtualSelectionDelta &rhs);                            ///< \brief swap the content with another object
+
+        //global changes
+        void SetDeselectAll(bool bDeselectAll = true);                      ///< \brief all items are deselected first
+        bool IsDeselectAll(void) const;                                     ///< \brief check if all items are deselected first
+        void SetSelectAll(bool bSelectAll = true);                          ///< \brief all items are selected
+        bool IsSelectAll(void) const;                                       ///< \brief check if all items are selected
+
+        //items
+        void AddItem(const wxVirtualItemID &rID, bool bSelect = true);      ///< \brief add a selected / deselected item
+        void AddItems(const wxVirtualItemIDs &vIDs, bool bSelect = true);   ///< \brief add a list of selected / deselected items
+        const wxVirtualItemIDs& GetSelectedItems(void) const;               ///< \brief get the selected items
+        const wxVirtualItemIDs& GetDeselectedItems(void) const;             ///< \brief get the deselected items
+        wxVirtualItemIDs& SelectedItems(void);                              ///< \brief get the selected items (read/write)
+        wxVirtualItemIDs& DeselectedItems(void);                            ///< \brief get the deselected items (read/write)
+
+        //ranges
+        void AddRange(const wxVirtualItemID &rFirst,
+                      const wxVirtualItemID &rLast, bool bSelect = true);   ///< \brief add a selected / deselected range
+        size_t GetSelectedRangeCount(void) const;                           ///< \brief get the amount of selected ranges
+        void GetSelectedRange(size_t uiRange, wxVirtualItemID &rFirst,
+                              wxVirtualItemID &rLast) const;                ///< \brief get a selected range
+        size_t GetDeselectedRangeCount(void) const;                         ///< \brief get the amount of deselected ranges
+        void GetDeselectedRange(size_t uiRange, wxVirtualItemID &rFirst,
+                                wxVirtualItemID &rLast) const;              ///< \brief get a deselected range
+
+    private:
+        //data
+        bool                m_bDeselectAll;                                 ///< \brief all items are deselected first
+        bool                m_bSelectAll;                                   ///< \brief all items are selected
+        wxVirtualItemIDs    m_vSelectedItems;                               ///< \brief selected items
+        wxVirtualItemIDs    m_vDeselectedItems;                             ///< \brief deselected items
+        wxVirtualItemIDs    m_vSelectedRanges;                              ///< \brief selected ranges (first, last) pairs
+        wxVirtualItemIDs    m_vDeselectedRanges;                            ///< \brief deselected ranges (first, last) pairs
+};
+
+#endif //_WX_VIRTUAL_SELECTION_DELTA_H_
@@ -11,9 +11,11 @@
 
 #include <wx/defs.h>
 #include <wx/VirtualDataView/VirtualDataViewDefs.h>
+#include <wx/string.h>
 
 //forward declarations
 class WXDLLIMPEXP_BASE wxVariant;
+class WXDLLIMPEXP_VDV wxVirtualValue;
 
 /** \class wxVirtualDataViewFilter : a filter for wxVirtualDataViewCtrl
   */
@@ -27,6 +29,9 @@ class WXDLLIMPEXP_VDV wxVirtualDataViewFilter
         //interface
         virtual wxVirtualDataViewFilter* Clone(void) const                  = 0;    ///< \brief clone the filter
         virtual bool      AcceptValue(const wxVariant& rvValue)             = 0;    ///< \brief accept or reject a value
+        virtual bool      AcceptItemValue(const wxVirtualValue &rValue);            ///< \brief accept or reject a value without allocation
+        virtual wxString  GetFilterType(void) const;                                ///< \brief get the type of the filter
+        virtual bool      IsRefinementOf(const wxVirtualDataViewFilter &rOther) const;  ///< \brief check if the filter accepts a subset of another filter
 
         //information
         bool    IsActive(void) const;                                               ///< \brief check if the filter is active
@@ -38,13 +43,18 @@ class WXDLLIMPEXP_VDV wxVirtualDataViewFilter
         bool    IsRecursive(void) const;                                            ///< \brief return true if the filter is recursive
         void    SetRecursive(bool bRecursive);                                      ///< \brief set if the filter is recursive
 
+        //revision
+        size_t  GetRevision(void) const;                                            ///< \brief get the revision of the filter criteria
+
     protected:
         //data
         bool    m_bIsActive;                                                        ///< \brief true if the filter is active
         bool    m_bIsRecursive;                                                     ///< \brief true if the filter is recursive (item accepted when 1 child is accepted)
+        size_t  m_uiRevision;                                                       ///< \brief revision of the filter criteria. Unique among all filters
 
         //methods
         void CopyBase(const wxVirtualDataViewFilter &rhs);                          ///< \brief copy base object
+        void OnFilterChanged(void);                                                 ///< \brief the filter criteria changed : get a new revision
 };
 
 #endif
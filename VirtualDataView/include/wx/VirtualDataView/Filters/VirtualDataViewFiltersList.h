@@ -12,6 +12,8 @@
 #include <wx/defs.h>
 #include <wx/VirtualDataView/VirtualDataViewDefs.h>
 #include <wx/VirtualDataView/VirtualItemID.h>
+#include <wx/VirtualDataView/Types/BitArray.h>
+#include <wx/hashmap.h>
 #include <vector>
 
 //forward declarations
@@ -19,8 +21,30 @@ class WXDLLIMPEXP_BASE  wxVariant;
 class WXDLLIMPEXP_VDV   wxVirtualDataViewFilter;
 class WXDLLIMPEXP_VDV   wxVirtualIDataModel;
 
+WX_DECLARE_HASH_MAP(wxVirtualItemID, bool, wxVirtualItemIDHash, wxVirtualItemIDEqual, THashMapAcceptance);
 
 /** \class wxVirtualDataViewFiltersList : a filter for wxVirtualDataViewCtrl
+  *
+  * FilterItems() has 2 evaluation modes:
+  *     - item by item : all filters are evaluated for an item, then the next item is evaluated
+  *     - columnar (default): each active filter is evaluated for all items, and its results are
+  *       stored in a bit array (1 bit per item). The bit arrays are AND-ed together, and
+  *       the accepted items are extracted at the end.
+  *       The bit array of each filter is kept: if FilterItems() is called again on the same
+  *       items, only the filters whose criteria changed (see wxVirtualDataViewFilter::GetRevision())
+  *       are re-evaluated. The results are kept only for the last list of items.
+  *       ClearCachedResults() must be called if the values of the items changed.
+  *       When a filter is replaced by a refinement of a kept filter on the same field (see
+  *       wxVirtualDataViewFilter::IsRefinementOf()), only the items accepted by the kept filter
+  *       are evaluated: typing "err", "erro", "error" in a search box evaluates the whole list
+  *       once, then only the shrinking result set.
+  * Both modes give the same results.
+  *
+  * Recursive filters (an item rejected by the filter is kept if one of its descendants is accepted):
+  * the acceptance of the items which needed a scan of their children is memorized, so that each
+  * sub-tree is explored only once, whatever the depth of the tree. The scan is iterative (post-order,
+  * no recursion). The memorized results are dropped when the filters change (added, removed,
+  * (de)activated, or criteria changed), when the data model changes, and by ClearCachedResults().
   */
 class WXDLLIMPEXP_VDV wxVirtualDataViewFiltersList
 {
@@ -61,9 +85,70 @@ class WXDLLIMPEXP_VDV wxVirtualDataViewFiltersList
                             const wxVirtualItemIDs &vUnfilteredIDs,
                             wxVirtualIDataModel *pDataModel);                       ///< \brief filter a list of items from a wxVirtualIDataModel
 
+        //evaluation mode
+        bool    UsesColumnarEvaluation(void) const;                                 ///< \brief check if the filters are evaluated column by column
+        void    UseColumnarEvaluation(bool bColumnar = true);                       ///< \brief evaluate the filters column by column, or item by item
+        void    ClearCachedResults(void);                                           ///< \brief clear the results kept for each filter
+
     protected:
+        //types
+        /// \struct TFilterResult : the results of 1 filter for a list of items
+        struct TFilterResult
+        {
+            size_t                      m_uiField;                                  ///< \brief the filtered field
+            size_t                      m_uiRevision;                               ///< \brief the revision of the filter
+            wxVirtualDataViewFilter*    m_pFilter;                                  ///< \brief a copy of the filter (owned by m_vCachedResults). Can be NULL
+            wxBitArray                  m_vAccepted;                                ///< \brief 1 bit per item: true if accepted
+        };
+        typedef std::vector<TFilterResult>  TFilterResults;                         ///< \brief array of filter results
+
+        /// \struct TFilterState : the state of a filter, for detecting changes of the filters
+        struct TFilterState
+        {
+            size_t                      m_uiField;                                  ///< \brief the filtered field
+            size_t                      m_uiRevision;                               ///< \brief the revision of the filter
+            bool                        m_bActive;                                  ///< \brief true if the filter is active
+            bool                        m_bRecursive;                               ///< \brief true if the filter is recursive
+        };
+        typedef std::vector<TFilterState>   TFilterStates;                          ///< \brief array of filter states
+
+        /// \struct TAcceptanceFrame : 1 level of the post-order scan of a sub-tree
+        struct TAcceptanceFrame
+        {
+            wxVirtualItemID             m_ID;                                       ///< \brief the item
+            wxVirtualItemIDs            m_vChildren;                                ///< \brief the children of the item
+            size_t                      m_uiNextChild;                              ///< \brief index of the next child to examine
+            bool                        m_bAccepted;                                ///< \brief true if at least 1 child is accepted
+        };
+
         //data
-        TFilters        m_vFilters;                                                 ///< \brief list of filters
+        TFilters                m_vFilters;                                         ///< \brief list of filters
+        bool                    m_bColumnarEvaluation;                              ///< \brief true for columnar evaluation
+        TFilterResults          m_vCachedResults;                                   ///< \brief results of the filters, for the last list of items
+        wxVirtualIDataModel*    m_pCachedDataModel;                                 ///< \brief data model of the last list of items
+        wxVirtualItemIDs        m_vCachedIDs;                                       ///< \brief copy of the last list of items
+        THashMapAcceptance      m_MapOfAcceptance;                                  ///< \brief memorized acceptance of items (recursive filters only)
+        TFilterStates           m_vAcceptanceStates;                                ///< \brief state of the filters used for m_MapOfAcceptance
+        wxVirtualIDataModel*    m_pAcceptanceDataModel;                             ///< \brief data model used for m_MapOfAcceptance
+
+        //methods
+        void    FilterItemsColumnar(wxVirtualItemIDs &vFilteredIDs,
+                                    const wxVirtualItemIDs &vUnfilteredIDs,
+                                    wxVirtualIDataModel *pDataModel);               ///< \brief filter a list of items, column by column
+        void    EvaluateFilter(TFilterResult &rResult, const TFilter &rFilter,
+                               const wxVirtualItemIDs &vIDs,
+                               wxVirtualIDataModel *pDataModel,
+                               const wxBitArray *pCandidates);                      ///< \brief evaluate 1 filter for a list of items
+        TFilterResult* FindRefinedResult(const TFilter &rFilter);                   ///< \brief find kept results of a filter refined by rFilter
+        void    DeleteCachedFilters(void);                                          ///< \brief delete the copies of the filters kept in m_vCachedResults
+        bool    IsAcceptedByChildren(const wxVirtualItemID &rID,
+                                     wxVirtualIDataModel *pDataModel);              ///< \brief check if at least 1 child of an item is accepted
+        bool    DoIsAccepted(const wxVirtualItemID &rID,
+                             wxVirtualIDataModel *pDataModel);                      ///< \brief accept or reject an item, using the memorized results
+        bool    IsAcceptedByItself(const wxVirtualItemID &rID,
+                                   wxVirtualIDataModel *pDataModel,
+                                   bool &bRecursive);                               ///< \brief accept or reject an item, without looking at its children
+        void    ValidateAcceptanceCache(wxVirtualIDataModel *pDataModel);           ///< \brief drop the memorized acceptance if the filters changed
 };
 
 #endif
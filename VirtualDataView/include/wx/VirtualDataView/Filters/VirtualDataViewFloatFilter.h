@@ -26,11 +26,14 @@ class WXDLLIMPEXP_VDV wxVirtualDataViewFloatFilter : public wxVirtualDataViewNum
         //interface
         virtual wxVirtualDataViewFilter* Clone(void) const;                     ///< \brief clone the filter
         virtual bool AcceptValue(const wxVariant& rvValue);                     ///< \brief accept or reject a value
+        virtual bool AcceptItemValue(const wxVirtualValue &rValue);             ///< \brief accept or reject a value without allocation
+        virtual wxString GetFilterType(void) const;                             ///< \brief get the type of the filter
 
     protected:
 
         //methods
         void CopyFloat(const wxVirtualDataViewFloatFilter &rhs);                ///< \brief copy object
+        bool AcceptDouble(double fValue) const;                                 ///< \brief accept or reject a floating point value
 };
 
 #endif
@@ -26,11 +26,15 @@ class WXDLLIMPEXP_VDV wxVirtualDataViewIntegerFilter : public wxVirtualDataViewN
         //interface
         virtual wxVirtualDataViewFilter* Clone(void) const;                     ///< \brief clone the filter
         virtual bool AcceptValue(const wxVariant& rvValue);                     ///< \brief accept or reject a value
+        virtual bool AcceptItemValue(const wxVirtualValue &rValue);             ///< \brief accept or reject a value without allocation
+        virtual wxString GetFilterType(void) const;                             ///< \brief get the type of the filter
 
     protected:
 
         //methods
         void CopyInteger(const wxVirtualDataViewIntegerFilter &rhs);            ///< \brief copy object
+        virtual int CompareReferenceValue(const wxVariant &rvValue) const;      ///< \brief compare the reference value to another value
+        bool AcceptLongLong(const wxLongLong &lValue) const;                    ///< \brief accept or reject an integer
 };
 
 #endif
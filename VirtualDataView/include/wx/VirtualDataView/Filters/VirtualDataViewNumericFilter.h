@@ -47,6 +47,10 @@ class WXDLLIMPEXP_VDV wxVirtualDataViewNumericFilter : public wxVirtualDataViewS
         void UseStringMatch(bool bUseStringMatching = true);                    ///< \brief toggle the use of string matching / numeric matching
         void UseNumericMatching(bool bUseNumericMatching = true);               ///< \brief toggle the use of numeric matching / string matching
 
+        //interface
+        virtual bool IsRefinementOf(const wxVirtualDataViewFilter &rOther) const;   ///< \brief check if the filter accepts a subset of another filter
+        virtual bool AcceptItemValue(const wxVirtualValue &rValue);             ///< \brief accept or reject a value without allocation
+
     protected:
         //data
         EOperator   m_eOperator;                                                ///< \brief comparison operator
@@ -54,6 +58,7 @@ class WXDLLIMPEXP_VDV wxVirtualDataViewNumericFilter : public wxVirtualDataViewS
 
         //methods
         void CopyNumeric(const wxVirtualDataViewNumericFilter &rhs);            ///< \brief copy object
+        virtual int CompareReferenceValue(const wxVariant &rvValue) const;      ///< \brief compare the reference value to another value
 };
 
 #endif
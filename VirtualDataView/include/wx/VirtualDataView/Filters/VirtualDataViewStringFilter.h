@@ -32,6 +32,9 @@ class WXDLLIMPEXP_VDV wxVirtualDataViewStringFilter : public wxVirtualDataViewFi
         //interface
         virtual wxVirtualDataViewFilter* Clone(void) const;                     ///< \brief clone the filter
         virtual bool AcceptValue(const wxVariant& rvValue);                     ///< \brief accept or reject a value
+        virtual bool AcceptItemValue(const wxVirtualValue &rValue);             ///< \brief accept or reject a value without allocation
+        virtual wxString GetFilterType(void) const;                             ///< \brief get the type of the filter
+        virtual bool IsRefinementOf(const wxVirtualDataViewFilter &rOther) const;   ///< \brief check if the filter accepts a subset of another filter
 
         //reference value - stored as variant
         wxVariant GetReferenceValue(void) const;                                ///< \brief get the reference value
@@ -66,6 +69,9 @@ class WXDLLIMPEXP_VDV wxVirtualDataViewStringFilter : public wxVirtualDataViewFi
         void CopyString(const wxVirtualDataViewStringFilter &rhs);              ///< \brief copy object
         void CompileRegEx(void);                                                ///< \brief compile the regular expression
         bool AcceptString(const wxVariant& rvValue);                            ///< \brief accept or reject a value based on its string representation
+        bool AcceptString(const wxVirtualValue &rValue);                        ///< \brief accept or reject a value based on its string representation
+        bool AcceptText(const wxString &rsValue);                               ///< \brief accept or reject a string
+        bool IsStringRefinementOf(const wxVirtualDataViewStringFilter &rOther) const;   ///< \brief check if the string matching accepts a subset of another filter
 
         //pattern - stored as string
         wxString    GetPattern(void) const;                                     ///< \brief get the string pattern
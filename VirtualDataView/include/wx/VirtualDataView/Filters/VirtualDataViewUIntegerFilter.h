@@ -26,11 +26,13 @@ class WXDLLIMPEXP_VDV wxVirtualDataViewUIntegerFilter : public wxVirtualDataView
         //interface
         virtual wxVirtualDataViewFilter* Clone(void) const;                     ///< \brief clone the filter
         virtual bool AcceptValue(const wxVariant& rvValue);                     ///< \brief accept or reject a value
+        virtual wxString GetFilterType(void) const;                             ///< \brief get the type of the filter
 
     protected:
 
         //methods
         void CopyUInteger(const wxVirtualDataViewUIntegerFilter &rhs);          ///< \brief copy object
+        virtual int CompareReferenceValue(const wxVariant &rvValue) const;      ///< \brief compare the reference value to another value
 };
 
 #endif
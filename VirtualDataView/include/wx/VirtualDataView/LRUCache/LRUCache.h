@@ -10,31 +10,56 @@
 #ifndef _lru_cache_using_std_
 #define _lru_cache_using_std_
 
-#include <list>
+#include <vector>
+#include <stddef.h>
 
-#define USE_BOOST_HASH_MAP      0
-#if USE_BOOST_HASH_MAP != 0
-    #include <boost/unordered_map.hpp>
-
-    inline std::size_t hash_value(const wxVirtualItemID &rID)
-    {
-        return(rID.GetHashCode());
-    }
-
-    #define TMAP                 boost::unordered_map
-
-#else
-    #include <map>
-
-    #define TMAP                std::map
-#endif
+//------------------------ DEFAULT FUNCTORS -------------------------//
+/** \class LRUCacheHash : default hash functor. Uses K::GetHashCode()
+  */
+template <typename K>
+struct LRUCacheHash
+{
+    size_t operator()(const K &rKey) const {return(rKey.GetHashCode());}
+};
 
+/** \class LRUCacheEqual : default equality functor. Uses K::operator==
+  */
+template <typename K>
+struct LRUCacheEqual
+{
+    bool operator()(const K &rKey1, const K &rKey2) const {return(rKey1 == rKey2);}
+};
 
+/** \class LRUCacheCost : default cost functor.
+  * Returns the amount of bytes allocated by the value outside of sizeof(V) (0 by default)
+  * Specialize it, or give another functor to LRUCache, for values owning memory (arrays, strings, ...)
+  */
+template <typename V>
+struct LRUCacheCost
+{
+    size_t operator()(const V &rValue) const {return(0);}
+};
 
 /** \class LRUCache : provides a Least-Recently-Used (LRU) replacement cache
-  * The cache has a fixed size.
+  * The entries are stored in a hash table (O(1) lookup), and are linked together in a doubly
+  * linked list ordered by recency (O(1) refresh & eviction). Both structures are intrusive:
+  * 1 allocation per entry.
+  *
+  * The cache is limited by:
+  *     - an amount of entries (SetCacheSize)
+  *     - an amount of bytes (SetMemoryLimit). The cost of an entry is the size of the entry, plus
+  *       the memory allocated by the value, as given by the TCost functor.
+  * When a limit is exceeded, the least recently used entries are evicted. The most recently used
+  * entry is always kept, even if it alone exceeds the memory limit: a large value stays cached
+  * until another entry is inserted.
+  * Find(), GetValue() and operator() refresh the recency of the entry. HasKey() does not.
+  *
+  * Hits, misses and evictions are counted (see GetHits(), GetMisses(), GetEvictions())
   */
-template <typename K, typename V>
+template <typename K, typename V,
+          typename THash = LRUCacheHash<K>,
+          typename TEqual = LRUCacheEqual<K>,
+          typename TCost = LRUCacheCost<V> >
 class LRUCache
 {
     public:
@@ -51,35 +76,75 @@ class LRUCache
 
         //query & insert
         bool        HasKey(const TKey &rKey) const;                 ///< \brief check if a key is present in the cache
+        TValue*     Find(const TKey &rKey);                         ///< \brief find the value stored, and mark it as recently used
         TValue&     GetValue(const TKey &rKey);                     ///< \brief get the value stored
         void Insert(const TKey &rKey,const TValue &rValue);         ///< \brief record a new key/value pair in the cache
-
+        bool        Remove(const TKey &rKey);                       ///< \brief remove a key from the cache
+        void        UpdateCost(const TKey &rKey);                   ///< \brief re-evaluate the cost of a value modified in place
 
         //capacity
         size_t GetCacheSize(void) const;                            ///< \brief get cache size
         void   SetCacheSize(size_t uiSize);                         ///< \brief set new cache size
+        size_t GetMemoryLimit(void) const;                          ///< \brief get the maximal amount of bytes
+        void   SetMemoryLimit(size_t uiBytes);                      ///< \brief set the maximal amount of bytes
+        size_t GetMemoryUsage(void) const;                          ///< \brief get the amount of bytes used by the entries
+        size_t GetCount(void) const;                                ///< \brief get the amount of entries
+
+        //statistics
+        size_t GetHits(void) const;                                 ///< \brief get the amount of successful lookups
+        size_t GetMisses(void) const;                               ///< \brief get the amount of failed lookups
+        size_t GetEvictions(void) const;                            ///< \brief get the amount of evicted entries
+        void   ResetStatistics(void);                               ///< \brief reset the hits, misses & evictions counters
 
         //clear
         void   ClearCache(void);                                    ///< \brief clear the cache
 
     private:
-        //typedefs
-
-        typedef std::list<TKey> TKeyTracker;                        ///< \brief Key access history, most recent at back
-        typedef typename TKeyTracker::iterator TKeyIterator;        ///< \brief key tracker iterator
-        typedef std::pair<TValue, TKeyIterator> TValueKeyIterator;  ///< \brief (value, key tracker iterator) pair
-        typedef TMAP<TKey,TValueKeyIterator> TKeyToValue;           ///< \brief Key to value and key history iterator
-        //typedef boost::unordered_map<TKey, TValueKeyIterator> TKeyToValue;
+        //types
+        /// \struct TNode : 1 entry, linked in its hash bucket and in the recency list
+        struct TNode
+        {
+            TNode(const TKey &rKey, const TValue &rValue, size_t uiHash)
+                : m_Key(rKey), m_Value(rValue), m_uiHash(uiHash), m_uiCost(0),
+                  m_pNextInBucket(NULL), m_pPrev(NULL), m_pNext(NULL) {}
+
+            TKey    m_Key;                                          ///< \brief the key
+            TValue  m_Value;                                        ///< \brief the value
+            size_t  m_uiHash;                                       ///< \brief hash of the key
+            size_t  m_uiCost;                                       ///< \brief cost of the entry, in bytes
+            TNode*  m_pNextInBucket;                                ///< \brief next entry in the same bucket
+            TNode*  m_pPrev;                                        ///< \brief previous entry in recency order (more recent)
+            TNode*  m_pNext;                                        ///< \brief next entry in recency order (less recent)
+        };
+        typedef std::vector<TNode*> TBuckets;                       ///< \brief hash table
 
         //data
         size_t          m_uiCapacity;                               ///< \brief Maximum number of key-value pairs to be retained
-        TKeyTracker     m_KeyTracker;                               ///< \brief key access history - most recent at back (use a std::list)
-        TKeyToValue     m_KeyToValue;                               ///< \brief key to value map
+        size_t          m_uiMemoryLimit;                            ///< \brief Maximum amount of bytes to be retained
+        size_t          m_uiMemoryUsage;                            ///< \brief current amount of bytes
+        size_t          m_uiCount;                                  ///< \brief current number of key-value pairs
+        TBuckets        m_vBuckets;                                 ///< \brief hash table. Size is a power of 2
+        TNode*          m_pMostRecent;                              ///< \brief head of the recency list
+        TNode*          m_pLeastRecent;                             ///< \brief tail of the recency list
+        TValue          m_DefaultValue;                             ///< \brief value returned by GetValue() on a miss
+        size_t          m_uiHits;                                   ///< \brief amount of successful lookups
+        size_t          m_uiMisses;                                 ///< \brief amount of failed lookups
+        size_t          m_uiEvictions;                              ///< \brief amount of evicted entries
+        THash           m_Hash;                                     ///< \brief hash functor
+        TEqual          m_Equal;                                    ///< \brief equality functor
+        TCost           m_Cost;                                     ///< \brief cost functor
 
         //methods
-        void Evict(void);                                           ///< \brief purge the least recently used element in the cache
-
-
+        TNode*  FindNode(const TKey &rKey, size_t uiHash) const;    ///< \brief find the entry of a key
+        void    Unlink(TNode *pNode);                               ///< \brief remove an entry from the hash table & the recency list
+        void    LinkAsMostRecent(TNode *pNode);                     ///< \brief insert an entry at the head of the recency list
+        void    Rehash(size_t uiNbBuckets);                         ///< \brief resize the hash table
+        void    Evict(void);                                        ///< \brief purge the least recently used element in the cache
+        void    EnforceLimits(void);                                ///< \brief evict entries until the limits are respected
+
+        //no copy
+        LRUCache(const LRUCache &rhs);
+        LRUCache& operator=(const LRUCache &rhs);
 };
 
 //------------------- IMPLEMENTATION --------------------------------//
@@ -88,167 +153,406 @@ class LRUCache
   * maximum number of records to be stored
   * \param uiMaxSize [input]: the maximal size of the cache
   */
-template <typename K, typename V>
-inline LRUCache<K, V>::LRUCache(size_t uiMaxSize)
-    : m_uiCapacity(uiMaxSize)
+template <typename K, typename V, typename THash, typename TEqual, typename TCost>
+inline LRUCache<K, V, THash, TEqual, TCost>::LRUCache(size_t uiMaxSize)
+    : m_uiCapacity(uiMaxSize),
+      m_uiMemoryLimit(size_t(-1)),
+      m_uiMemoryUsage(0),
+      m_uiCount(0),
+      m_vBuckets(16, (TNode*) NULL),
+      m_pMostRecent(NULL),
+      m_pLeastRecent(NULL),
+      m_DefaultValue(),
+      m_uiHits(0),
+      m_uiMisses(0),
+      m_uiEvictions(0)
 {
-    if (m_uiCapacity == 0) m_uiCapacity++;
 }
 
 /** Destructor
   */
-template <typename K, typename V>
-inline LRUCache<K, V>::~LRUCache(void)
+template <typename K, typename V, typename THash, typename TEqual, typename TCost>
+inline LRUCache<K, V, THash, TEqual, TCost>::~LRUCache(void)
 {
+    ClearCache();
 }
 
 //---------------- INTERNAL METHODS ---------------------------------//
+/** Find the entry of a key
+  * \param rKey   [input]: the key to find
+  * \param uiHash [input]: the hash of the key
+  * \return the entry, or NULL if not found
+  */
+template <typename K, typename V, typename THash, typename TEqual, typename TCost>
+inline typename LRUCache<K, V, THash, TEqual, TCost>::TNode*
+LRUCache<K, V, THash, TEqual, TCost>::FindNode(const TKey &rKey, size_t uiHash) const
+{
+    TNode *pNode = m_vBuckets[uiHash & (m_vBuckets.size() - 1)];
+    while (pNode)
+    {
+        if ((pNode->m_uiHash == uiHash) && (m_Equal(pNode->m_Key, rKey))) return(pNode);
+        pNode = pNode->m_pNextInBucket;
+    }
+    return(NULL);
+}
+
+/** Remove an entry from the hash table & the recency list. The entry is not deleted
+  * \param pNode [input]: the entry to unlink
+  */
+template <typename K, typename V, typename THash, typename TEqual, typename TCost>
+inline void LRUCache<K, V, THash, TEqual, TCost>::Unlink(TNode *pNode)
+{
+    //hash table
+    TNode **ppNode = &m_vBuckets[pNode->m_uiHash & (m_vBuckets.size() - 1)];
+    while (*ppNode != pNode) ppNode = &((*ppNode)->m_pNextInBucket);
+    *ppNode = pNode->m_pNextInBucket;
+    pNode->m_pNextInBucket = NULL;
+
+    //recency list
+    if (pNode->m_pPrev) pNode->m_pPrev->m_pNext = pNode->m_pNext;
+    else                m_pMostRecent = pNode->m_pNext;
+    if (pNode->m_pNext) pNode->m_pNext->m_pPrev = pNode->m_pPrev;
+    else                m_pLeastRecent = pNode->m_pPrev;
+    pNode->m_pPrev = NULL;
+    pNode->m_pNext = NULL;
+
+    m_uiCount--;
+    m_uiMemoryUsage -= pNode->m_uiCost;
+}
+
+/** Insert an entry at the head of the recency list
+  * \param pNode [input]: the entry. It must not be in the list
+  */
+template <typename K, typename V, typename THash, typename TEqual, typename TCost>
+inline void LRUCache<K, V, THash, TEqual, TCost>::LinkAsMostRecent(TNode *pNode)
+{
+    pNode->m_pPrev = NULL;
+    pNode->m_pNext = m_pMostRecent;
+    if (m_pMostRecent) m_pMostRecent->m_pPrev = pNode;
+    else               m_pLeastRecent = pNode;
+    m_pMostRecent = pNode;
+}
+
+/** Resize the hash table
+  * \param uiNbBuckets [input]: the new amount of buckets. Must be a power of 2
+  */
+template <typename K, typename V, typename THash, typename TEqual, typename TCost>
+inline void LRUCache<K, V, THash, TEqual, TCost>::Rehash(size_t uiNbBuckets)
+{
+    TBuckets vBuckets(uiNbBuckets, (TNode*) NULL);
+    size_t i, uiSize;
+    uiSize = m_vBuckets.size();
+    for(i=0;i<uiSize;i++)
+    {
+        TNode *pNode = m_vBuckets[i];
+        while (pNode)
+        {
+            TNode *pNext = pNode->m_pNextInBucket;
+            TNode *&rpHead = vBuckets[pNode->m_uiHash & (uiNbBuckets - 1)];
+            pNode->m_pNextInBucket = rpHead;
+            rpHead = pNode;
+            pNode = pNext;
+        }
+    }
+    m_vBuckets.swap(vBuckets);
+}
+
 /** Purge the least-recently-used element in the cache
   */
-template <typename K, typename V>
-inline void LRUCache<K, V>::Evict(void)
+template <typename K, typename V, typename THash, typename TEqual, typename TCost>
+inline void LRUCache<K, V, THash, TEqual, TCost>::Evict(void)
 {
-    //Assert method is never called when cache is empty
-    if (m_KeyTracker.empty()) return;
+    TNode *pNode = m_pLeastRecent;
+    if (!pNode) return;
 
-    //Identify least recently used key
-    typename TKeyToValue::iterator it;
-    it = m_KeyToValue.find(m_KeyTracker.front());
-    if (it == m_KeyToValue.end()) return;
+    Unlink(pNode);
+    delete(pNode);
+    m_uiEvictions++;
+}
 
-    //Erase both elements to completely purge record
-    m_KeyToValue.erase(it);
-    m_KeyTracker.pop_front();
+/** Evict entries until the limits are respected
+  * The most recently used entry is never evicted for the memory limit
+  */
+template <typename K, typename V, typename THash, typename TEqual, typename TCost>
+inline void LRUCache<K, V, THash, TEqual, TCost>::EnforceLimits(void)
+{
+    while ((m_pLeastRecent) &&
+           ((m_uiCount > m_uiCapacity) ||
+            ((m_uiMemoryUsage > m_uiMemoryLimit) && (m_pLeastRecent != m_pMostRecent))))
+    {
+        Evict();
+    }
 }
 
 //-------------------- QUERY & INSERT -------------------------------//
 /** Check if a key is present in the cache
+  * The recency of the entry and the statistics are not modified
   * \param rKey [input]: the key to retrieve
   * \return true if an entry for this key exists, false otherwise
   */
-template <typename K, typename V>
-inline bool LRUCache<K, V>::HasKey(const TKey &rKey) const
+template <typename K, typename V, typename THash, typename TEqual, typename TCost>
+inline bool LRUCache<K, V, THash, TEqual, TCost>::HasKey(const TKey &rKey) const
 {
-    if (m_KeyToValue.find(rKey) != m_KeyToValue.end()) return(true);
+    if (FindNode(rKey, m_Hash(rKey))) return(true);
     return(false);
 }
 
-/** Get the value stored
+/** Find the value stored, and mark it as the most recently used
   * \param rKey [input]: the key to retrieve
-  * \return a reference to the value stored
+  * \return a pointer to the value stored. NULL if the key is not in the cache
+  *         The pointer is valid until the next insertion / removal
   */
-template <typename K, typename V>
-inline typename LRUCache<K, V>::TValue& LRUCache<K, V>::GetValue(const TKey &rKey)
+template <typename K, typename V, typename THash, typename TEqual, typename TCost>
+inline typename LRUCache<K, V, THash, TEqual, TCost>::TValue*
+LRUCache<K, V, THash, TEqual, TCost>::Find(const TKey &rKey)
 {
-    typename TKeyToValue::iterator it = m_KeyToValue.find(rKey);
-    if (it == m_KeyToValue.end())
+    TNode *pNode = FindNode(rKey, m_Hash(rKey));
+    if (!pNode)
     {
-        TValue vValue;
-        Insert(rKey, vValue);
-        it = m_KeyToValue.find(rKey);
+        m_uiMisses++;
+        return(NULL);
     }
 
-    TValueKeyIterator &rValueIteratorPair = it->second;
-    return(rValueIteratorPair.first);
+    m_uiHits++;
+    if (pNode != m_pMostRecent)
+    {
+        //move to the head of the recency list
+        pNode->m_pPrev->m_pNext = pNode->m_pNext;
+        if (pNode->m_pNext) pNode->m_pNext->m_pPrev = pNode->m_pPrev;
+        else                m_pLeastRecent = pNode->m_pPrev;
+        LinkAsMostRecent(pNode);
+    }
+    return(&(pNode->m_Value));
+}
+
+/** Get the value stored, and mark it as the most recently used
+  * \param rKey [input]: the key to retrieve
+  * \return a reference to the value stored
+  *         If the key is not in the cache, nothing is inserted and a reference to a default
+  *         constructed value is returned
+  */
+template <typename K, typename V, typename THash, typename TEqual, typename TCost>
+inline typename LRUCache<K, V, THash, TEqual, TCost>::TValue&
+LRUCache<K, V, THash, TEqual, TCost>::GetValue(const TKey &rKey)
+{
+    TValue *pValue = Find(rKey);
+    if (pValue) return(*pValue);
+
+    m_DefaultValue = TValue();
+    return(m_DefaultValue);
 }
 
 /** Record a new key/value pair in the cache
+  * If the key is already present, its value is replaced.
+  * The entry becomes the most recently used one. Least recently used entries are evicted
+  * if a limit is exceeded. An entry which alone exceeds the memory limit is stored, and all
+  * the other entries are evicted
   * \param rKey   [input]: the key to store
   * \param rValue [input]: the value to store
   */
-template <typename K, typename V>
-inline void LRUCache<K, V>::Insert(const TKey &rKey,const TValue &rValue)
+template <typename K, typename V, typename THash, typename TEqual, typename TCost>
+inline void LRUCache<K, V, THash, TEqual, TCost>::Insert(const TKey &rKey,const TValue &rValue)
 {
-    //Method is only called on cache misses
-    if (m_KeyToValue.find(rKey) != m_KeyToValue.end())
+    size_t uiHash = m_Hash(rKey);
+    size_t uiCost = sizeof(TNode) + m_Cost(rValue);
+
+    //remove the previous value
+    TNode *pNode = FindNode(rKey, uiHash);
+    if (pNode)
     {
-        return;
+        Unlink(pNode);
+        delete(pNode);
     }
 
-    //Make space if necessary
-    if (m_KeyToValue.size() == m_uiCapacity) Evict();
+    //no entries allowed
+    if (m_uiCapacity == 0) return;
+
+    //grow the hash table (load factor <= 1)
+    if (m_uiCount >= m_vBuckets.size()) Rehash(m_vBuckets.size() * 2);
+
+    //store
+    pNode = new TNode(rKey, rValue, uiHash);
+    pNode->m_uiCost = uiCost;
+    TNode *&rpHead = m_vBuckets[uiHash & (m_vBuckets.size() - 1)];
+    pNode->m_pNextInBucket = rpHead;
+    rpHead = pNode;
+    LinkAsMostRecent(pNode);
+    m_uiCount++;
+    m_uiMemoryUsage += uiCost;
+
+    EnforceLimits();
+}
+
+/** Remove a key from the cache
+  * \param rKey [input]: the key to remove
+  * \return true if the key was removed, false if it was not in the cache
+  */
+template <typename K, typename V, typename THash, typename TEqual, typename TCost>
+inline bool LRUCache<K, V, THash, TEqual, TCost>::Remove(const TKey &rKey)
+{
+    TNode *pNode = FindNode(rKey, m_Hash(rKey));
+    if (!pNode) return(false);
+
+    Unlink(pNode);
+    delete(pNode);
+    return(true);
+}
+
+/** Re-evaluate the cost of a value modified in place (through the pointer returned by Find())
+  * Least recently used entries are evicted if a limit is exceeded
+  * \param rKey [input]: the key of the modified value
+  */
+template <typename K, typename V, typename THash, typename TEqual, typename TCost>
+inline void LRUCache<K, V, THash, TEqual, TCost>::UpdateCost(const TKey &rKey)
+{
+    TNode *pNode = FindNode(rKey, m_Hash(rKey));
+    if (!pNode) return;
 
-    //Record k as most-recently-used key
-    typename TKeyTracker::iterator it;
-    it = m_KeyTracker.insert(m_KeyTracker.end(), rKey);
+    size_t uiCost = sizeof(TNode) + m_Cost(pNode->m_Value);
+    m_uiMemoryUsage -= pNode->m_uiCost;
+    m_uiMemoryUsage += uiCost;
+    pNode->m_uiCost  = uiCost;
 
-    //Create the key-value entry, linked to the usage record.
-    m_KeyToValue.insert(std::make_pair(rKey,
-                                       std::make_pair(rValue, it)
-                                       )
-                       );
+    EnforceLimits();
 }
 
 //----------------- CAPACITY ----------------------------------------//
 /** Get cache size
-  * \return the cache size
+  * \return the cache size (maximal amount of entries)
   */
-template <typename K, typename V>
-inline size_t LRUCache<K, V>::GetCacheSize(void) const
+template <typename K, typename V, typename THash, typename TEqual, typename TCost>
+inline size_t LRUCache<K, V, THash, TEqual, TCost>::GetCacheSize(void) const
 {
     return(m_uiCapacity);
 }
 
 /** Set new cache size
-  * \param uiSize [input]: the new cache size
+  * \param uiSize [input]: the new cache size (maximal amount of entries). 0 disables the cache
   */
-template <typename K, typename V>
-inline void LRUCache<K, V>::SetCacheSize(size_t uiSize)
+template <typename K, typename V, typename THash, typename TEqual, typename TCost>
+inline void LRUCache<K, V, THash, TEqual, TCost>::SetCacheSize(size_t uiSize)
 {
-    if (uiSize < m_uiCapacity)
-    {
-        //make space
-        size_t uiDiff = m_uiCapacity - uiSize;
-        size_t i;
-        for(i=0;i<uiDiff;i++)
-        {
-            Evict();
-        }
-    }
     m_uiCapacity = uiSize;
+    EnforceLimits();
+}
+
+/** Get the maximal amount of bytes
+  * \return the maximal amount of bytes used by the entries. size_t(-1) for no limit
+  */
+template <typename K, typename V, typename THash, typename TEqual, typename TCost>
+inline size_t LRUCache<K, V, THash, TEqual, TCost>::GetMemoryLimit(void) const
+{
+    return(m_uiMemoryLimit);
+}
+
+/** Set the maximal amount of bytes
+  * \param uiBytes [input]: the maximal amount of bytes used by the entries. size_t(-1) for no limit
+  */
+template <typename K, typename V, typename THash, typename TEqual, typename TCost>
+inline void LRUCache<K, V, THash, TEqual, TCost>::SetMemoryLimit(size_t uiBytes)
+{
+    m_uiMemoryLimit = uiBytes;
+    EnforceLimits();
+}
+
+/** Get the amount of bytes used by the entries
+  * \return the sum of the costs of all entries. The hash table itself is not counted
+  */
+template <typename K, typename V, typename THash, typename TEqual, typename TCost>
+inline size_t LRUCache<K, V, THash, TEqual, TCost>::GetMemoryUsage(void) const
+{
+    return(m_uiMemoryUsage);
+}
+
+/** Get the amount of entries
+  * \return the amount of key/value pairs currently stored
+  */
+template <typename K, typename V, typename THash, typename TEqual, typename TCost>
+inline size_t LRUCache<K, V, THash, TEqual, TCost>::GetCount(void) const
+{
+    return(m_uiCount);
+}
+
+//---------------------- STATISTICS ---------------------------------//
+/** Get the amount of successful lookups
+  * \return the amount of calls to Find(), GetValue() or operator() which found the key
+  */
+template <typename K, typename V, typename THash, typename TEqual, typename TCost>
+inline size_t LRUCache<K, V, THash, TEqual, TCost>::GetHits(void) const
+{
+    return(m_uiHits);
+}
+
+/** Get the amount of failed lookups
+  * \return the amount of calls to Find(), GetValue() or operator() which did not find the key
+  */
+template <typename K, typename V, typename THash, typename TEqual, typename TCost>
+inline size_t LRUCache<K, V, THash, TEqual, TCost>::GetMisses(void) const
+{
+    return(m_uiMisses);
+}
+
+/** Get the amount of evicted entries
+  * \return the amount of entries removed because a limit was exceeded
+  */
+template <typename K, typename V, typename THash, typename TEqual, typename TCost>
+inline size_t LRUCache<K, V, THash, TEqual, TCost>::GetEvictions(void) const
+{
+    return(m_uiEvictions);
+}
+
+/** Reset the hits, misses & evictions counters
+  */
+template <typename K, typename V, typename THash, typename TEqual, typename TCost>
+inline void LRUCache<K, V, THash, TEqual, TCost>::ResetStatistics(void)
+{
+    m_uiHits      = 0;
+    m_uiMisses    = 0;
+    m_uiEvictions = 0;
 }
 
 //--------------------- CLEAR THE CACHE -----------------------------//
 /** Clear the cache
   */
-template <typename K, typename V>
-inline void LRUCache<K, V>::ClearCache(void)
+template <typename K, typename V, typename THash, typename TEqual, typename TCost>
+inline void LRUCache<K, V, THash, TEqual, TCost>::ClearCache(void)
 {
-    m_KeyTracker.clear();
-    m_KeyToValue.clear();
+    TNode *pNode = m_pMostRecent;
+    while (pNode)
+    {
+        TNode *pNext = pNode->m_pNext;
+        delete(pNode);
+        pNode = pNext;
+    }
+
+    m_pMostRecent   = NULL;
+    m_pLeastRecent  = NULL;
+    m_uiCount       = 0;
+    m_uiMemoryUsage = 0;
+    TBuckets vBuckets(16, (TNode*) NULL);
+    m_vBuckets.swap(vBuckets);
 }
 
 //----------------------- GET CACHED VALUE --------------------------//
 /** Get the cached value for a given key
   * \param rKey [input] : the key
-  * \return the cached value
+  * \return the cached value. If the key is not in the cache, a default value is inserted
   */
-template <typename K, typename V>
-inline typename LRUCache<K, V>::TValue& LRUCache<K, V>::operator()(const TKey &rKey)
+template <typename K, typename V, typename THash, typename TEqual, typename TCost>
+inline typename LRUCache<K, V, THash, TEqual, TCost>::TValue&
+LRUCache<K, V, THash, TEqual, TCost>::operator()(const TKey &rKey)
 {
-    //Attempt to find existing record
-    const typename TKeyToValue::iterator it = m_KeyToValue.find(rKey);
-
-    if (it == m_KeyToValue.end())
-    {
-        //not in cache. Create new record
-        const TValue vValue;
-        Insert(rKey, vValue);
-
-        //Return the freshly computed value
-        return(vValue);
-    }
+    TValue *pValue = Find(rKey);
+    if (pValue) return(*pValue);
 
-    //We do have it:
-    //Update access record by moving accessed key to back of list
-    TValueKeyIterator &rValueKeyIterator = it->second;
-    TKeyIterator      &rKeyIterator      = rValueKeyIterator.second;
-    m_KeyTracker.splice(m_KeyTracker.end(),
-                        m_KeyTracker,
-                        rKeyIterator);
+    //not in cache. Create new record
+    Insert(rKey, TValue());
+    TNode *pNode = FindNode(rKey, m_Hash(rKey));
+    if (pNode) return(pNode->m_Value);
 
-    //Return the retrieved value
-    return(rValueKeyIterator.first);
+    //the cache is disabled
+    m_DefaultValue = TValue();
+    return(m_DefaultValue);
 }
 
 #endif
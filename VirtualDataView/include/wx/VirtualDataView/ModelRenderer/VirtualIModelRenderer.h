@@ -50,6 +50,15 @@ class WXDLLIMPEXP_VDV wxVirtualIModelRenderer
             WX_VISIBLE_AT_BOTTOM    = 2                                 ///< \brief the item must be the last visible
         };
 
+        /// \enum EAutoSizeMode : how the best width of a column is computed
+        enum EAutoSizeMode
+        {
+            WX_AUTOSIZE_ALL_ROWS        = 0,                            ///< \brief measure all the expanded rows (exact, slow on large models)
+            WX_AUTOSIZE_VISIBLE_ROWS    = 1,                            ///< \brief measure only the rows shown in the client area
+            WX_AUTOSIZE_SAMPLED         = 2,                            ///< \brief measure the shown rows + the longest values of a sample of rows
+            WX_AUTOSIZE_BACKGROUND      = 3                             ///< \brief measure the shown rows, then all the rows during idle time
+        };
+
         //structures
         struct THitTest
         {
@@ -66,6 +75,17 @@ class WXDLLIMPEXP_VDV wxVirtualIModelRenderer
             wxCoord         m_RelativeY;                                ///< \brief the Y coordinate of the point, relative to the hit sub-item rect top left corner
         };
 
+        /// \struct TColumnMeasure : state of an incremental measurement of a column (see MeasureColumn())
+        struct TColumnMeasure
+        {
+            size_t          m_uiColID;                                  ///< \brief the column to measure (view coord)
+            size_t          m_uiField;                                  ///< \brief the model column of the column to measure
+            wxVirtualItemID m_ID;                                       ///< \brief the next item to measure
+            size_t          m_uiLevel;                                  ///< \brief the level of the next item to measure
+            bool            m_bStarted;                                 ///< \brief false if no items were measured yet
+            int             m_iWidth;                                   ///< \brief the best width found so far
+        };
+
         //constructors & destructor
         wxVirtualIModelRenderer(wxVirtualDataViewBase* pClient,
                                 wxVirtualDataViewCtrl* pScroller);      ///< \brief constructor
@@ -82,6 +102,7 @@ class WXDLLIMPEXP_VDV wxVirtualIModelRenderer
 
         //interface - event handling
         virtual bool PaintModel(wxDC &rDC)                        = 0;  ///< \brief paint the model
+        virtual bool PaintRect(wxDC &rDC, const wxRect &rUpdateRect);   ///< \brief paint only a part of the model
         virtual bool EraseBackgroundEvent(wxEraseEvent &rEvent)   = 0;  ///< \brief erase background event
         virtual bool SizeEvent(wxSizeEvent &rEvent)               = 0;  ///< \brief a size event occurred
         virtual bool FocusEvent(wxFocusEvent &rEvent)             = 0;  ///< \brief a focus event occurred
@@ -97,6 +118,10 @@ class WXDLLIMPEXP_VDV wxVirtualIModelRenderer
         //interface - sizing
         virtual wxSize GetBestSize(void) const                    = 0;  ///< \brief get the best size
         virtual wxSize GetBestSize(size_t uiColID) const;               ///< \brief get the best size of a column
+        virtual wxSize GetBestSize(size_t uiColID, EAutoSizeMode eMode,
+                                   size_t uiSampleSize) const;          ///< \brief get the best size of a column, with a measuring strategy
+        virtual bool MeasureColumn(TColumnMeasure &rMeasure,
+                                   size_t uiMaxItems) const;            ///< \brief measure the next items of a column
         virtual bool HitTest(THitTest &rResult,
                              wxCoord x, wxCoord y,
                              bool bClientAreaOnly = true)         = 0;  ///< \brief performs a hit test
@@ -142,6 +167,12 @@ class WXDLLIMPEXP_VDV wxVirtualIModelRenderer
         //interface - callbacks
         virtual void OnDataModelChanged(void)                     = 0;  ///< \brief called by the client to notify that the data model has changed
         virtual void OnLayoutChanged(void)                        = 0;  ///< \brief called by the client to notify changes in layout
+        virtual void OnChildrenChanged(const wxVirtualItemID &rParent); ///< \brief called by the client to notify that the children of an item changed
+        virtual bool OnItemsInserted(const wxVirtualItemID &rParent,
+                                     size_t uiFirst, size_t uiCount);   ///< \brief called by the client to notify that some items were inserted
+        virtual bool OnItemsRemoved(const wxVirtualItemID &rParent,
+                                    size_t uiFirst, size_t uiCount);    ///< \brief called by the client to notify that some items were removed
+        virtual void OnItemsChanged(const wxVirtualItemIDs &vIDs);      ///< \brief called by the client to notify that the values of some items changed
 
     protected:
         //data
@@ -0,0 +1,107 @@
+/**********************************************************************/
+/** FILE    : VirtualPaintCache.h                                    **/
+/** PROJECT : wxVirtualDataViewCtrl                                  **/
+/** LICENSE : wxWindows Library Licence                              **/
+/** PURPOSE : GDI objects & attributes reused while painting         **/
+/**********************************************************************/
+
+#ifndef _VIRTUAL_PAINT_CACHE_H_
+#define _VIRTUAL_PAINT_CACHE_H_
+
+#include <wx/VirtualDataView/VirtualDataViewDefs.h>
+#include <wx/VirtualDataView/CellAttrs/VirtualDataViewItemAttr.h>
+#include <wx/brush.h>
+#include <wx/pen.h>
+#include <wx/font.h>
+#include <wx/vector.h>
+
+/** \class wxVirtualPaintCache : GDI objects & resolved attributes reused while painting
+  * Brushes, pens and fonts are keyed by their colour / style, and kept from one paint
+  * to the next one: painting the same rows again creates no GDI objects.
+  * Combined attributes (item attribute + column attribute) are resolved once per paint:
+  * the font of the result is the effective font (bold / italic applied), so that the
+  * cell renderers do not create a new font for each cell. They are indexed by a hash of
+  * the 2 attribute pointers.
+  * Each list is bounded: when it is full, it is emptied.
+  */
+class WXDLLIMPEXP_VDV wxVirtualPaintCache
+{
+    public:
+        //constructors & destructor
+        wxVirtualPaintCache(void);                                      ///< \brief constructor
+        ~wxVirtualPaintCache(void);                                     ///< \brief destructor
+
+        //general
+        void BeginPaint(const wxFont &rDefaultFont);                    ///< \brief start a new paint
+        void Clear(void);                                               ///< \brief release all the objects
+
+        //GDI objects
+        const wxBrush& GetBrush(const wxColour &rColour);               ///< \brief get a solid brush
+        const wxPen& GetPen(const wxColour &rColour, int iWidth = 1,
+                            wxPenStyle eStyle = wxPENSTYLE_SOLID);      ///< \brief get a pen
+        const wxFont& GetFont(const wxFont &rFont,
+                              bool bBold, bool bItalic);                ///< \brief get a font with bold / italic applied
+
+        //attributes
+        wxVirtualDataViewItemAttr* ResolveAttribute(
+                                wxVirtualDataViewItemAttr *pItemAttr,
+                                wxVirtualDataViewItemAttr *pColAttr);   ///< \brief combine 2 attributes & resolve the font
+
+    private:
+        //structs
+        /// \struct TBrush : a cached brush
+        struct TBrush
+        {
+            wxUint64    m_uiColour;                                     ///< \brief the colour (see ToRGBA())
+            wxBrush     m_Brush;                                        ///< \brief the brush
+        };
+
+        /// \struct TPen : a cached pen
+        struct TPen
+        {
+            wxUint64    m_uiColour;                                     ///< \brief the colour (see ToRGBA())
+            int         m_iWidth;                                       ///< \brief the width
+            wxPenStyle  m_eStyle;                                       ///< \brief the style
+            wxPen       m_Pen;                                          ///< \brief the pen
+        };
+
+        /// \struct TFont : a cached font
+        struct TFont
+        {
+            wxFont      m_BaseFont;                                     ///< \brief the base font
+            bool        m_bBold;                                        ///< \brief true if bold is applied
+            bool        m_bItalic;                                      ///< \brief true if italic is applied
+            wxFont      m_Font;                                         ///< \brief the resulting font
+        };
+
+        /// \struct TAttr : a resolved attribute
+        struct TAttr
+        {
+            wxVirtualDataViewItemAttr*  m_pItemAttr;                    ///< \brief the item attribute (owned by the model)
+            wxVirtualDataViewItemAttr*  m_pColAttr;                     ///< \brief the column attribute
+            wxVirtualDataViewItemAttr   m_Source;                       ///< \brief copy of the item attribute when it was resolved
+            wxVirtualDataViewItemAttr   m_Resolved;                     ///< \brief the resolved attribute
+            size_t                      m_uiNext;                       ///< \brief next resolved attribute with the same hash. size_t(-1) if none
+        };
+
+        typedef wxVector<TBrush>    TBrushes;                           ///< \brief list of brushes
+        typedef wxVector<TPen>      TPens;                              ///< \brief list of pens
+        typedef wxVector<TFont>     TFonts;                             ///< \brief list of fonts
+        typedef wxVector<TAttr>     TAttrs;                             ///< \brief list of resolved attributes
+
+        //data
+        TBrushes    m_vBrushes;                                         ///< \brief cached brushes
+        TPens       m_vPens;                                            ///< \brief cached pens
+        TFonts      m_vFonts;                                           ///< \brief cached fonts
+        TAttrs      m_vAttrs;                                           ///< \brief resolved attributes of the current paint
+        wxVector<size_t> m_vAttrBuckets;                                ///< \brief for each hash, the last resolved attribute in m_vAttrs. size_t(-1) if none
+        wxFont      m_DefaultFont;                                      ///< \brief the font of the window
+
+        //methods
+        static wxUint64 ToRGBA(const wxColour &rColour);                ///< \brief convert a colour to a key
+        void ClearAttributes(void);                                     ///< \brief forget the resolved attributes
+        size_t GetAttributeBucket(wxVirtualDataViewItemAttr *pItemAttr,
+                                  wxVirtualDataViewItemAttr *pColAttr) const;   ///< \brief get the hash bucket of 2 attributes
+};
+
+#endif //_VIRTUAL_PAINT_CACHE_H_
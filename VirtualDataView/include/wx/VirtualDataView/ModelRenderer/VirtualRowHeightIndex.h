@@ -0,0 +1,106 @@
+/**********************************************************************/
+/** FILE    : VirtualRowHeightIndex.h                                **/
+/** PROJECT : wxVirtualDataViewCtrl                                  **/
+/** LICENSE : wxWindows Library Licence                              **/
+/** PURPOSE : prefix sum index of variable row heights               **/
+/**********************************************************************/
+
+
+#ifndef WX_VIRTUAL_ROW_HEIGHT_INDEX_H_
+#define WX_VIRTUAL_ROW_HEIGHT_INDEX_H_
+
+#include <wx/VirtualDataView/VirtualItemID.h>
+#include <wx/hashmap.h>
+#include <wx/vector.h>
+
+class WXDLLIMPEXP_VDV wxVirtualIDataModel;
+class WXDLLIMPEXP_VDV wxVirtualIStateModel;
+class WXDLLIMPEXP_VDV wxVirtualTreeModelRenderer;
+struct wxVirtualRowHeightNode;
+
+WX_DECLARE_HASH_MAP(wxVirtualItemID, wxVirtualRowHeightNode*, wxVirtualItemIDHash,
+                    wxVirtualItemIDEqual, THashMapRowHeightNodes);
+
+/** \class wxVirtualRowHeightIndex : a prefix sum index of the heights of the visible rows of a tree.
+  * This is the pixel counterpart of wxVirtualVisibleRowIndex, used by wxVirtualTreeModelRenderer
+  * when the rows have variable heights.
+  * For each indexed node, a Fenwick tree (binary indexed tree) stores the height contributed by
+  * each child (the height of the child row for a collapsed child, the height of the child row +
+  * the height of its visible sub-tree for an expanded child). This allows:
+  *     - GetTotalHeight()  : O(1) time once the root is indexed
+  *     - GetItemPosition() : O(d.log(k)) time (d = depth of the item, k = amount of siblings)
+  *     - FindItem()        : O(d.log(k)) time
+  *
+  * The index is built lazily: a node is indexed the first time it is needed, which costs
+  * O(k) time (k = amount of children) and k row height measurements. If an estimated height is
+  * set, the rows are not measured when indexed: the estimate is used instead, and the real
+  * height is set with SetRowHeight() when the row is measured (usually, when it is painted).
+  * Expanding or collapsing an item, or changing the height of 1 row, costs O(d.log(k)) time.
+  *
+  * An indexed node is always accurate, even if it is collapsed: its size is the height of the
+  * visible rows it would have if expanded.
+  *
+  * The owner must call:
+  *     - OnExpand() when an item is expanded / collapsed (after updating the state)
+  *     - Clear() when the expansion state or the row heights change in an unknown way
+  *     - OnChildrenChanged() when children are inserted / removed / re-ordered
+  *     - SetModels() before using the index (the index is cleared if the models have changed)
+  */
+class WXDLLIMPEXP_VDV wxVirtualRowHeightIndex
+{
+    public:
+        //constructors & destructor
+        wxVirtualRowHeightIndex(wxVirtualTreeModelRenderer *pRenderer);                     ///< \brief constructor
+        ~wxVirtualRowHeightIndex(void);                                                     ///< \brief destructor
+
+        //models
+        wxVirtualIDataModel* GetDataModel(void) const;                                      ///< \brief get the indexed data model
+        wxVirtualIStateModel* GetStateModel(void) const;                                    ///< \brief get the state model
+        void SetModels(wxVirtualIDataModel *pDataModel,
+                       wxVirtualIStateModel *pStateModel);                                  ///< \brief set the data & state models
+
+        //estimated height
+        int  GetEstimatedHeight(void) const;                                                ///< \brief get the estimated row height
+        void SetEstimatedHeight(int iHeight);                                               ///< \brief set the estimated row height
+
+        //maintenance
+        void Clear(void);                                                                   ///< \brief clear the index
+        bool IsEmpty(void) const;                                                           ///< \brief check if the index is empty
+        size_t GetIndexedNodesCount(void) const;                                            ///< \brief get the amount of indexed nodes
+        void OnExpand(const wxVirtualItemID &rID, bool bExpand);                            ///< \brief an item has been expanded / collapsed
+        void OnChildrenChanged(const wxVirtualItemID &rParent);                             ///< \brief the children of an item changed
+        bool SetRowHeight(const wxVirtualItemID &rID, int iHeight);                         ///< \brief set the measured height of 1 row
+
+        //queries
+        wxInt64         GetTotalHeight(void);                                               ///< \brief get the height of all the visible rows
+        bool            GetItemPosition(const wxVirtualItemID &rID, wxInt64 &y);            ///< \brief get the vertical position of a visible item
+        wxVirtualItemID FindItem(wxInt64 y, wxInt64 &yItem);                                ///< \brief find the visible item at a vertical position
+
+    private:
+        //data
+        THashMapRowHeightNodes      m_MapOfNodes;                                           ///< \brief indexed nodes
+        wxVirtualTreeModelRenderer* m_pRenderer;                                            ///< \brief renderer measuring the rows
+        wxVirtualIDataModel*        m_pDataModel;                                           ///< \brief indexed data model
+        wxVirtualIStateModel*       m_pStateModel;                                          ///< \brief state model giving expansion states
+        int                         m_iEstimatedHeight;                                     ///< \brief estimated row height. <= 0 : rows are measured
+        int                         m_iRootHeight;                                          ///< \brief height of the root row. < 0 : not measured yet
+
+        //methods
+        wxVirtualRowHeightNode* FindNode(const wxVirtualItemID &rID) const;                 ///< \brief get an indexed node, without building it
+        wxVirtualRowHeightNode* GetNode(const wxVirtualItemID &rID);                        ///< \brief get an indexed node, build it if needed
+        wxVirtualRowHeightNode* BuildNode(const wxVirtualItemID &rID);                      ///< \brief build an indexed node
+        int  GetRootHeight(void);                                                           ///< \brief get the height of the root row
+        int  MeasureRow(const wxVirtualItemID &rID) const;                                  ///< \brief get the height of a row being indexed
+        void Propagate(const wxVirtualItemID &rID, wxInt64 iDelta);                         ///< \brief propagate a height change to ancestors
+
+        //Fenwick tree helpers
+        static wxInt64 PrefixSum(const wxVirtualRowHeightNode *pNode, size_t uiCount);      ///< \brief sum of the uiCount first contributions
+        static void    Add(wxVirtualRowHeightNode *pNode, size_t uiIndex, wxInt64 iDelta);  ///< \brief add a value to one contribution
+        static size_t  Search(const wxVirtualRowHeightNode *pNode, wxInt64 &y);             ///< \brief find the child containing a position
+
+        //forbidden
+        wxVirtualRowHeightIndex(const wxVirtualRowHeightIndex &rhs);                        ///< \brief copy constructor (forbidden)
+        wxVirtualRowHeightIndex& operator=(const wxVirtualRowHeightIndex &rhs);             ///< \brief assignation operator (forbidden)
+};
+
+#endif
@@ -12,7 +12,11 @@
 #include <wx/VirtualDataView/VirtualItemID.h>
 #include <wx/VirtualDataView/DataView/VirtualTreePath.h>
 #include <wx/VirtualDataView/ModelRenderer/VirtualIModelRenderer.h>
+#include <wx/VirtualDataView/ModelRenderer/VirtualPaintCache.h>
+#include <wx/VirtualDataView/ModelRenderer/VirtualRowHeightIndex.h>
+#include <wx/VirtualDataView/Types/VirtualValue.h>
 #include <wx/vector.h>
+#include <wx/stopwatch.h>
 
 class WXDLLIMPEXP_VDV wxVirtualDataViewBase;
 class WXDLLIMPEXP_VDV wxVirtualDataViewItemState;
@@ -35,6 +39,7 @@ class WXDLLIMPEXP_VDV wxVirtualTreeModelRenderer : public wxVirtualIModelRendere
 
         //interface implementation - event handling
         virtual bool PaintModel(wxDC &rDC);                             ///< \brief paint the model
+        virtual bool PaintRect(wxDC &rDC, const wxRect &rUpdateRect);   ///< \brief paint only a part of the model
         virtual bool EraseBackgroundEvent(wxEraseEvent &rEvent);        ///< \brief erase background event
         virtual bool SizeEvent(wxSizeEvent &rEvent);                    ///< \brief a size event occurred
         virtual bool FocusEvent(wxFocusEvent &rEvent);                  ///< \brief a focus event occurred
@@ -50,6 +55,10 @@ class WXDLLIMPEXP_VDV wxVirtualTreeModelRenderer : public wxVirtualIModelRendere
         //interface implementation - sizing
         virtual wxSize GetBestSize(void) const;                         ///< \brief get the best size
         virtual wxSize GetBestSize(size_t uiColID) const;               ///< \brief get the best size of a column
+        virtual wxSize GetBestSize(size_t uiColID, EAutoSizeMode eMode,
+                                   size_t uiSampleSize) const;          ///< \brief get the best size of a column, with a measuring strategy
+        virtual bool MeasureColumn(TColumnMeasure &rMeasure,
+                                   size_t uiMaxItems) const;            ///< \brief measure the next items of a column
         virtual bool HitTest(THitTest &rResult,
                              wxCoord x, wxCoord y,
                              bool bClientAreaOnly = true);              ///< \brief performs a hit test
@@ -76,6 +85,11 @@ class WXDLLIMPEXP_VDV wxVirtualTreeModelRenderer : public wxVirtualIModelRendere
         //interface implementation - callbacks
         virtual void OnDataModelChanged(void);                          ///< \brief called by the client to notify that the data model has changed
         virtual void OnLayoutChanged(void);                             ///< \brief called by the client to notify changes in layout
+        virtual void OnChildrenChanged(const wxVirtualItemID &rParent); ///< \brief called by the client to notify that the children of an item changed
+        virtual bool OnItemsInserted(const wxVirtualItemID &rParent,
+                                     size_t uiFirst, size_t uiCount);   ///< \brief called by the client to notify that some items were inserted
+        virtual bool OnItemsRemoved(const wxVirtualItemID &rParent,
+                                    size_t uiFirst, size_t uiCount);    ///< \brief called by the client to notify that some items were removed
 
         //margins
         int  GetLeftMargin(void) const;                                 ///< \brief get the left margin, in pixels
@@ -159,6 +173,11 @@ class WXDLLIMPEXP_VDV wxVirtualTreeModelRenderer : public wxVirtualIModelRendere
         int  GetUniformRowHeight(void) const;                           ///< \brief get the uniform row height value
         int  GetRowHeightWithMargins(int iHeightWithoutMargins) const;  ///< \brief get the row height with margins
 
+        //variable row heights
+        int  GetRowHeight(const wxVirtualItemID &rID) const;            ///< \brief get the height of 1 row, with margins
+        int  GetEstimatedRowHeight(void) const;                         ///< \brief get the estimated height of the rows not measured yet
+        void SetEstimatedRowHeight(int iHeight = 0);                    ///< \brief set the estimated height of the rows not measured yet
+
         //uniform column widths
         bool HasUniformColWidth(void) const;                            ///< \brief return true if the tree has uniform column widths
         void SetUniformColWidth(bool bHasUniformColWidth = true);       ///< \brief set/unset uniform column widths
@@ -188,7 +207,27 @@ class WXDLLIMPEXP_VDV wxVirtualTreeModelRenderer : public wxVirtualIModelRendere
         virtual bool MoveTo(size_t uiRank, bool bControlDown,
                             bool bShiftDown);                           ///< \brief update vertical scrollbar position and select object
 
+        //live data
+        bool  IsFollowingTail(void) const;                              ///< \brief check if the view follows the end of the list
+        void  SetFollowTail(bool bFollow = true);                       ///< \brief follow the end of the list when rows are appended
+        bool  IsShowingTail(void) const;                                ///< \brief check if the last row is visible
+
+        //view hints
+        bool  AreViewportHintsEnabled(void) const;                      ///< \brief check if the viewport is sent to the data model
+        void  EnableViewportHints(bool bEnable = true);                 ///< \brief send the viewport to the data model when it changes
+
     protected:
+        /// \struct TPaintRow : a row drawn by the current paint
+        struct TPaintRow
+        {
+            wxVirtualItemID             m_ID;                           ///< \brief the item
+            size_t                      m_uiLevel;                      ///< \brief the hierarchy level of the item
+            size_t                      m_uiRank;                       ///< \brief the rank of the item
+            size_t                      m_uiCount;                      ///< \brief amount of items before this one
+            wxCoord                     m_y;                            ///< \brief vertical position of the row
+            int                         m_iHeight;                      ///< \brief height of the row
+        };
+
         //data
         bool                            m_bHasFocus;                    ///< \brief true if the window has the focus
         int                             m_iMarginLeft;                  ///< \brief left margin, in pixels
@@ -215,10 +254,20 @@ class WXDLLIMPEXP_VDV wxVirtualTreeModelRenderer : public wxVirtualIModelRendere
         int                             m_iIndentation;                 ///< \brief item indentation
         bool                            m_bUniformRowHeight;            ///< \brief true if each row has the same height
         int                             m_iRowHeight;                   ///< \brief for uniform row height, the height of the row
+        mutable wxVirtualRowHeightIndex m_RowHeightIndex;               ///< \brief for variable row height, prefix sums of the row heights
         bool                            m_bUniformColWidth;             ///< \brief true if each column has the same width
         int                             m_iColWidth;                    ///< \brief for uniform column width, the width of the column
         wxVirtualTreePath               m_FirstVisibleItem;             ///< \brief the 1st visible item
         int                             m_iFirstVisibleLine;            ///< \brief the 1st visible line
+        int                             m_iPaintedFirstLine;            ///< \brief the 1st visible line currently displayed on screen
+        int                             m_iPaintedHorzPos;              ///< \brief the horizontal scroll position currently displayed on screen
+        wxRect                          m_rPaintRect;                   ///< \brief the area being repainted (client coordinates)
+        wxVirtualPaintCache             m_PaintCache;                   ///< \brief GDI objects & attributes reused while painting
+        wxVector<TPaintRow>             m_vPaintRows;                   ///< \brief the rows drawn by the current paint
+        wxVirtualItemIDs                m_vPaintIDs;                    ///< \brief the items drawn by the current paint
+        wxVector<size_t>                m_vPaintFields;                 ///< \brief the fields fetched by the current paint
+        wxVector<size_t>                m_vPaintColumns;                ///< \brief for each column, its index in m_vPaintFields. size_t(-1) if not fetched
+        wxVirtualValues                 m_vPaintValues;                 ///< \brief the values fetched by the current paint, row by row
         bool                            m_bGuard;                       ///< \brief reentrency guard
         size_t                          m_uiFieldFocusedItem;           ///< \brief field of the focused item
         size_t                          m_uiColFocusedItem;             ///< \brief column index of the focused item
@@ -233,6 +282,14 @@ class WXDLLIMPEXP_VDV wxVirtualTreeModelRenderer : public wxVirtualIModelRendere
         wxVirtualDataViewEditor*        m_pEditor;                      ///< \brief current cell editor
         wxSize                          m_sVirtualSize;                 ///< \brief virtual size of the control
         int                             m_iNbVisiblesItems;             ///< \brief amount of visible items in the control (not invisible due to collapsed parent)
+        bool                            m_bFollowTail;                  ///< \brief true if the view follows the end of the list
+        bool                            m_bViewportHints;               ///< \brief true if the viewport is sent to the data model
+        wxVirtualIDataModel*            m_pHintModel;                   ///< \brief the data model which received the last viewport
+        size_t                          m_uiHintFirstRank;              ///< \brief rank of the 1st visible item of the last viewport
+        size_t                          m_uiHintRowCount;               ///< \brief amount of rows of the last viewport
+        double                          m_dHintVelocity;                ///< \brief smoothed scrolling speed, in rows per second
+        int                             m_iHintDirection;               ///< \brief last scrolling direction : 1 down, -1 up, 0 unknown
+        wxStopWatch                     m_HintStopWatch;                ///< \brief time since the last viewport
         wxSize                          m_sCurrentClientSize;           ///< \brief current client size
         bool                            m_bShowSelectedItemsAsFocused;  ///< \brief true for showing selected items as focused
         wxColour                        m_cSelectedItemsColour;         ///< \brief selected items colour
@@ -257,6 +314,10 @@ class WXDLLIMPEXP_VDV wxVirtualTreeModelRenderer : public wxVirtualIModelRendere
         virtual void RecomputeFirstVisibleItem(void);                   ///< \brief recompute the 1st visible item
         virtual void InvalidateFirstVisibleItem(void);                  ///< \brief invalidate the 1st visible item
         virtual void ScrollEditorWindow(void);                          ///< \brief scroll the editor window
+        virtual void ScrollDisplay(void);                               ///< \brief scroll the displayed pixels & repaint the exposed area
+        bool UpdateShiftedRows(const wxVirtualItemID &rParent,
+                               size_t uiFirst, size_t uiCount,
+                               bool bInserted);                         ///< \brief update the display after inserting / removing rows
         virtual wxSize GetItemSize(const wxVirtualItemID &rID,
                                    size_t uiColID) const;               ///< \brief get the size of 1 item
         virtual bool MakeItemVisible(const wxVirtualItemID &rID,
@@ -273,6 +334,13 @@ class WXDLLIMPEXP_VDV wxVirtualTreeModelRenderer : public wxVirtualIModelRendere
         wxSize GetTargetSize(void) const;                               ///< \brief get scrolled window client size
         wxSize GetScrollerVisibleSize(void) const;                      ///< \brief client size available if no scrollbars are shown
 
+        //column auto-sizing
+        int GetCellBestWidth(const wxVirtualItemID &rID,
+                             size_t uiColID) const;                     ///< \brief get the best width of 1 cell, with margins
+        wxSize GetBestSizeOfVisibleRows(size_t uiColID) const;          ///< \brief get the best size of a column, from the shown rows
+        wxSize GetBestSizeOfSample(size_t uiColID,
+                                   size_t uiSampleSize) const;          ///< \brief get the best size of a column, from a sample of rows
+
         //column resizing
         bool ResizeColumn(const THitTest &ht, wxMouseEvent &rEvent);    ///< \brief check and perform columns resizing when needed
 
@@ -356,7 +424,14 @@ class WXDLLIMPEXP_VDV wxVirtualTreeModelRenderer : public wxVirtualIModelRendere
                               const wxVirtualDataViewItemState &rState,
                               wxVirtualIDataModel *pModel,
                               long lLevel, size_t uiRank,
-                              size_t uiCount);                          ///< \brief draw one item
+                              size_t uiCount,
+                              const wxVirtualValue *pValues
+                                                = WX_VDV_NULL_PTR);     ///< \brief draw one item
+        void FetchPaintValues(wxVirtualIDataModel *pDataModel,
+                              int x0);                                  ///< \brief get the values of the visible cells
+        void PublishViewport(wxVirtualIDataModel *pDataModel,
+                             const wxVirtualItemID &rFirstID,
+                             size_t uiFirstRank, size_t uiCount);       ///< \brief send the viewport to the data model if it changed
         virtual void DrawTreeLines(wxDC &rDC, wxRect &rRect,
                                    const wxVirtualItemID &rID,
                                    wxVirtualIDataModel *pModel,
@@ -0,0 +1,244 @@
+/**********************************************************************/
+/** FILE    : VirtualAsyncDataModel.h                                **/
+/** PROJECT : wxVirtualDataViewCtrl                                  **/
+/** LICENSE : wxWindows Library Licence                              **/
+/** PURPOSE : proxy data model fetching the values in worker threads **/
+/**********************************************************************/
+
+
+#ifndef WX_VIRTUAL_ASYNC_DATA_MODEL_H_
+#define WX_VIRTUAL_ASYNC_DATA_MODEL_H_
+
+#include <wx/VirtualDataView/Models/VirtualIProxyDataModel.h>
+#include <wx/VirtualDataView/LRUCache/LRUCache.h>
+#include <wx/vector.h>
+#include <wx/hashset.h>
+#include <deque>
+#if wxUSE_THREADS
+    #include <wx/thread.h>
+#endif // wxUSE_THREADS
+
+#define WX_VDV_ASYNC_DEFAULT_CACHE_SIZE     65536                                           ///< \brief default amount of cells kept in the values cache
+#define WX_VDV_ASYNC_DEFAULT_MAX_REQUESTS   4096                                            ///< \brief default maximal amount of queued requests
+
+class wxVirtualAsyncWorker;
+class wxVirtualAsyncNotifier;
+
+/** \class wxVirtualAsyncCellKey : identifies 1 cell (item + field) of the async data model
+  */
+struct wxVirtualAsyncCellKey
+{
+    wxVirtualItemID m_ID;                                                                   ///< \brief the item
+    size_t          m_uiField;                                                              ///< \brief the field
+
+    size_t GetHashCode(void) const
+    {
+        return(size_t(m_ID.GetHashCode()) ^ (m_uiField * 2654435761u));
+    }
+
+    bool operator==(const wxVirtualAsyncCellKey &rhs) const
+    {
+        return((m_uiField == rhs.m_uiField) && (m_ID == rhs.m_ID));
+    }
+};
+
+//----------------- HASHING FUNCTORS --------------------------------//
+class wxVirtualAsyncCellKeyHash
+{
+    public:
+        wxVirtualAsyncCellKeyHash(void) {}
+        unsigned long operator()(const wxVirtualAsyncCellKey &key) const
+        {
+            return(key.GetHashCode());
+        }
+        wxVirtualAsyncCellKeyHash& operator=(const wxVirtualAsyncCellKeyHash &rhs)
+        {
+            return(*this);
+        }
+};
+
+class wxVirtualAsyncCellKeyEqual
+{
+    public:
+        wxVirtualAsyncCellKeyEqual(void) {}
+        unsigned long operator()(const wxVirtualAsyncCellKey &a,
+                                 const wxVirtualAsyncCellKey &b) const
+        {
+            return(a == b);
+        }
+        wxVirtualAsyncCellKeyEqual& operator=(const wxVirtualAsyncCellKeyEqual &rhs)
+        {
+            return(*this);
+        }
+};
+
+WX_DECLARE_HASH_SET(wxVirtualAsyncCellKey, wxVirtualAsyncCellKeyHash,
+                    wxVirtualAsyncCellKeyEqual, TSetOfAsyncCells);
+
+/** \class wxVirtualAsyncDataModel : proxy data model reading the values of a slow master model in worker threads
+  * The main data of the painted cells (GetItemDataBatch() inside an OnPaintFetch() scope) is
+  * served from a LRU cache of values. When a cell is not in the cache, a placeholder value is
+  * returned immediately (SetPlaceholder(), null by default: the cell is drawn empty), and the cell
+  * is queued for a pool of worker threads, which read it from the master model. The resolved values are delivered in the GUI thread,
+  * stored in the cache, and notified with 1 ItemsRefreshed() per batch: only the rows visible on
+  * screen are repainted. The proxy models above are not notified: they never see the placeholders.
+  *
+  * Scheduling:
+  *     - the cells missed while painting (GetItemDataBatch()) are the visible window: they are
+  *       queued in front of all other requests, in painting order
+  *     - when the visible rows change (OnViewportChanged()), the requests queued for the previous
+  *       visible window and not read again by the next painted batch are cancelled. Their rows are
+  *       repainted (ItemsRefreshed()): the ones still on screen are requested again
+  *     - the queue is bounded (SetMaxPendingRequests()). When it is full, the oldest requests,
+  *       which were queued for rows scrolled out of view since, are cancelled
+  *     - CancelPendingRequests() cancels all the requests not started yet
+  *
+  * All other reads get the real values: GetItemData() and GetItemValue() use the cache, and read
+  * the missing cells synchronously from the master model; GetItemDataBatch() outside of the paint
+  * scope is forwarded to the master model. Searching, sorting and filtering, wherever their proxy
+  * models are in the chain, never see the placeholders. All other data types (attributes, flags,
+  * hierarchy, ...) are forwarded synchronously to the master model.
+  *
+  * The workers call only GetItemData() on the master model, while the GUI thread keeps using
+  * it: the master model must be thread safe (IsThreadSafe()), and its data must not be modified
+  * while the workers read it. Call StopWorkers() before detaching or modifying the master model:
+  * the workers are restarted automatically on the next cache miss.
+  *
+  * If the master model is not thread safe, or if the threads are not available, the values are
+  * read synchronously (the cache is still used).
+  */
+class WXDLLIMPEXP_VDV wxVirtualAsyncDataModel : public wxVirtualIProxyDataModel
+{
+    friend class wxVirtualAsyncWorker;
+    friend class wxVirtualAsyncNotifier;
+
+    public:
+        //constructors & destructor
+        wxVirtualAsyncDataModel(void);                                                      ///< \brief default constructor
+        virtual ~wxVirtualAsyncDataModel(void);                                             ///< \brief destructor
+
+        //placeholder
+        const wxVariant& GetPlaceholder(void) const;                                        ///< \brief get the value shown while a cell is fetched
+        void             SetPlaceholder(const wxVariant &rvPlaceholder);                    ///< \brief set the value shown while a cell is fetched
+
+        //cache
+        size_t  GetCacheSize(void) const;                                                   ///< \brief get the maximal amount of cached cells
+        void    SetCacheSize(size_t uiCells);                                               ///< \brief set the maximal amount of cached cells
+        void    ClearCache(void);                                                           ///< \brief clear the cached values & cancel the requests
+        bool    IsCached(const wxVirtualItemID &rID, size_t uiField) const;                 ///< \brief check if a cell is in the cache
+        size_t  GetCacheHits(void) const;                                                   ///< \brief get the amount of cells served from the cache
+        size_t  GetCacheMisses(void) const;                                                 ///< \brief get the amount of cells served as placeholder
+
+        //workers
+        size_t  GetWorkerCount(void) const;                                                 ///< \brief get the requested amount of workers
+        void    SetWorkerCount(size_t uiWorkers);                                           ///< \brief set the amount of workers (0 = 1 per CPU)
+        void    StopWorkers(void);                                                          ///< \brief cancel the requests and stop the workers
+
+        //requests
+        size_t  GetMaxPendingRequests(void) const;                                          ///< \brief get the maximal amount of queued requests
+        void    SetMaxPendingRequests(size_t uiMaxRequests);                                ///< \brief set the maximal amount of queued requests
+        size_t  GetPendingRequestCount(void) const;                                         ///< \brief get the amount of queued requests
+        size_t  GetCancelledRequestCount(void) const;                                       ///< \brief get the amount of requests cancelled
+        void    CancelPendingRequests(void);                                                ///< \brief cancel all the requests not started yet
+        void    DeliverResults(void);                                                       ///< \brief deliver the resolved values now
+
+        //interface : item data
+        virtual wxVariant GetItemData(const wxVirtualItemID &rID,
+                                      size_t uiField = 0,
+                                      EDataType eType = WX_ITEM_MAIN_DATA);                 ///< \brief get the item data
+        virtual void      GetItemValue(wxVirtualValue &rValue,
+                                       const wxVirtualItemID &rID,
+                                       size_t uiField = 0,
+                                       EDataType eType = WX_ITEM_MAIN_DATA);                ///< \brief get the item data without allocation
+        virtual void      GetItemDataBatch(wxVirtualValues &vValues,
+                                           const wxVirtualItemIDs &vIDs,
+                                           const TFieldIDs &vFields,
+                                           EDataType eType = WX_ITEM_MAIN_DATA);            ///< \brief get the data of several items & fields at once
+        virtual bool      SetItemData(const wxVirtualItemID &rID, size_t uiField,
+                                      const wxVariant &vValue,
+                                      EDataType eType = WX_ITEM_MAIN_DATA);                 ///< \brief set the item data
+
+        //multi-threading
+        virtual bool IsThreadSafe(void);                                                    ///< \brief check if GetItemData() & Compare() can be called from worker threads
+
+        //view hints
+        virtual void OnPaintFetch(bool bStart);                                             ///< \brief the view starts / stops reading the values of the painted cells
+        virtual void OnViewportChanged(const wxVirtualViewportHint &rHint);                 ///< \brief the rows shown by the view changed
+
+    protected:
+        /// \struct TRequest : a cell to fetch
+        struct TRequest
+        {
+            wxVirtualAsyncCellKey   m_Key;                                                  ///< \brief the cell
+            size_t                  m_uiGeneration;                                         ///< \brief generation of the cache when the request was made
+        };
+
+        /// \struct TResult : a fetched cell
+        struct TResult
+        {
+            wxVirtualAsyncCellKey   m_Key;                                                  ///< \brief the cell
+            wxVariant               m_vValue;                                               ///< \brief its value
+            size_t                  m_uiGeneration;                                         ///< \brief generation of the cache when the request was made
+        };
+
+        typedef LRUCache<wxVirtualAsyncCellKey, wxVariant>  TValuesCache;                   ///< \brief values cache
+        typedef std::deque<TRequest>                        TRequests;                      ///< \brief queue of requests
+        typedef wxVector<TResult>                           TResults;                       ///< \brief array of results
+        typedef wxVector<wxVirtualAsyncWorker*>             TWorkers;                       ///< \brief array of workers
+
+        //data : cache (GUI thread)
+        TValuesCache                m_Cache;                                                ///< \brief the resolved values
+        wxVariant                   m_vPlaceholder;                                         ///< \brief value shown while a cell is fetched
+        size_t                      m_uiMisses;                                             ///< \brief amount of cells served as placeholder
+        wxVector<wxVirtualAsyncCellKey> m_vMissedCells;                                     ///< \brief cells missed by the current batch
+        bool                        m_bPaintFetch;                                          ///< \brief true while the view reads the painted cells
+        bool                        m_bWindowMoved;                                         ///< \brief true if the visible rows changed since the last painted batch
+
+        //data : requests (protected by m_Mutex)
+        TRequests                   m_dqRequests;                                           ///< \brief queued requests, most urgent first
+        TSetOfAsyncCells            m_setPending;                                           ///< \brief cells queued, being fetched, or not delivered yet
+        TSetOfAsyncCells            m_setStale;                                             ///< \brief cells being fetched, which changed meanwhile
+        TResults                    m_vResults;                                             ///< \brief resolved values not delivered yet
+        wxVirtualItemIDs            m_vCancelledIDs;                                        ///< \brief items whose requests were cancelled, to repaint
+        size_t                      m_uiGeneration;                                         ///< \brief incremented each time the cache is reset
+        size_t                      m_uiMaxRequests;                                        ///< \brief maximal amount of queued requests
+        size_t                      m_uiCancelled;                                          ///< \brief amount of cancelled requests
+        bool                        m_bDeliveryQueued;                                      ///< \brief true if a delivery is already requested
+        bool                        m_bStop;                                                ///< \brief true if the workers must exit
+
+        //data : workers
+        size_t                      m_uiWorkerCount;                                        ///< \brief requested amount of workers (0 = 1 per CPU)
+        TWorkers                    m_vWorkers;                                             ///< \brief the running workers
+#if wxUSE_THREADS
+        mutable wxMutex             m_Mutex;                                                ///< \brief protects the requests & results
+        wxCondition                 m_Condition;                                            ///< \brief wakes up the workers
+        wxVirtualAsyncNotifier*     m_pNotifier;                                            ///< \brief delivers the results in the GUI thread
+#endif // wxUSE_THREADS
+
+        //methods
+        bool    FindValue(wxVariant &rvValue, const wxVirtualAsyncCellKey &rKey);           ///< \brief get a value from the cache, or the placeholder
+        void    RequestCells(const wxVirtualAsyncCellKey *pKeys, size_t uiNbKeys,
+                             bool bNewWindow);                                              ///< \brief queue requests in front of the queue
+        bool    StartWorkers(void);                                                         ///< \brief start the workers if needed
+        bool    PopRequest(TRequest &rRequest, wxVirtualIDataModel* &pMaster);              ///< \brief get the next request (worker threads)
+        void    PushResult(const TRequest &rRequest, wxVariant &rvValue);                   ///< \brief store a result (worker threads)
+        void    ResetCache(void);                                                           ///< \brief clear the cache, and cancel the requests
+
+        //reaction to the notifications of the master model
+        virtual void OnItemIDsShifted(wxVirtualIListDataModel *pListModel,
+                                      size_t uiFirst, size_t uiCount,
+                                      bool bInserted);                                      ///< \brief the rows of the bottom list model were shifted
+        virtual void OnMasterItemsRemoved(const wxVirtualItemID &rParent,
+                                          size_t uiFirst, size_t uiCount);                  ///< \brief some items were removed from the master model
+        virtual void OnMasterItemsChanged(const wxVirtualItemIDs &vIDs,
+                                          const TFieldIDs &vFields);                        ///< \brief the values of some items of the master model changed
+        virtual void OnMasterChildrenReset(const wxVirtualItemID &rParent);                 ///< \brief the children of an item of the master model changed
+        virtual void OnMasterModelReset(void);                                              ///< \brief the whole master model changed
+
+    private:
+        //forbidden
+        wxVirtualAsyncDataModel(const wxVirtualAsyncDataModel &rhs);                        ///< \brief copy constructor (forbidden)
+        wxVirtualAsyncDataModel& operator=(const wxVirtualAsyncDataModel &rhs);             ///< \brief assignation operator (forbidden)
+};
+
+#endif
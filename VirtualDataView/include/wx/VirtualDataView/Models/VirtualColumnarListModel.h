@@ -0,0 +1,169 @@
+/**********************************************************************/
+/** FILE    : VirtualColumnarListModel.h                             **/
+/** PROJECT : wxVirtualDataViewCtrl                                  **/
+/** LICENSE : wxWindows Library Licence                              **/
+/** PURPOSE : in-memory list data model storing typed columns        **/
+/**********************************************************************/
+
+
+#ifndef WX_VIRTUAL_COLUMNAR_LIST_MODEL_H_
+#define WX_VIRTUAL_COLUMNAR_LIST_MODEL_H_
+
+#include <wx/VirtualDataView/Models/VirtualIListDataModel.h>
+#include <wx/VirtualDataView/Types/SortKeys.h>
+#include <wx/hashmap.h>
+#include <wx/vector.h>
+#if wxUSE_DATETIME
+    #include <wx/datetime.h>
+#endif // wxUSE_DATETIME
+
+WX_DECLARE_STRING_HASH_MAP(wxUint32, THashMapColumnarStrings);
+
+/** \class wxVirtualColumnarListModel : a ready-made in-memory list model.
+  * Each column is stored as a contiguous array of 1 type:
+  *     - WX_COLUMN_INT64    : 8 bytes per row
+  *     - WX_COLUMN_DOUBLE   : 8 bytes per row
+  *     - WX_COLUMN_BOOL     : 1 byte per row
+  *     - WX_COLUMN_DATETIME : 8 bytes per row (milliseconds since epoch)
+  *     - WX_COLUMN_STRING   : 4 bytes per row + 1 copy of each distinct string (dictionary encoding)
+  *
+  * The model reimplements the data access & sorting methods with typed code:
+  *     - GetListItemValue() & GetListItemDataBatch() read the arrays directly. Strings are returned
+  *       by reference to the dictionary: they stay valid until the model is modified
+  *     - CanSort() returns true for all the columns : wxVirtualDataViewCtrl::SortItems() calls Sort()
+  *       instead of attaching a wxVirtualSortingDataModel. Sort() builds the sort keys directly from
+  *       the arrays (strings: rank of the dictionary entry) and does a radix sort. The sorted order
+  *       is stored as a permutation of the rows (1 size_t per row)
+  *     - GetAllValues() for strings & variants (the lists of values shown by the filter editors) gives
+  *       the distinct values from the dictionary, or by sorting a copy of the column. The other typed
+  *       GetAllValues() overloads (bool, integers, floats...) keep the default implementation, which
+  *       reads the values 1 by 1 through GetItemData()
+  *
+  * Row indices given to the accessors are the displayed indices (after sorting).
+  * The model does not notify the control: call wxVirtualDataViewCtrl::OnDataModelChanged() after
+  * modifying it.
+  */
+class WXDLLIMPEXP_VDV wxVirtualColumnarListModel : public wxVirtualIListDataModel
+{
+    public:
+        /// \enum EColumnType : the type of values stored in a column
+        enum EColumnType
+        {
+            WX_COLUMN_INT64     = 0,                                                        ///< \brief signed 64 bits integers
+            WX_COLUMN_DOUBLE    = 1,                                                        ///< \brief doubles
+            WX_COLUMN_BOOL      = 2,                                                        ///< \brief booleans
+            WX_COLUMN_DATETIME  = 3,                                                        ///< \brief date/times (milliseconds since epoch)
+            WX_COLUMN_STRING    = 4                                                         ///< \brief dictionary encoded strings
+        };
+
+        //constructors & destructor
+        wxVirtualColumnarListModel(void);                                                   ///< \brief default constructor
+        virtual ~wxVirtualColumnarListModel(void);                                          ///< \brief destructor
+
+        //columns
+        size_t      AddColumn(EColumnType eType, const wxString &sName = wxEmptyString);    ///< \brief add a column
+        size_t      GetColumnCount(void) const;                                             ///< \brief get the amount of columns
+        EColumnType GetColumnType(size_t uiField) const;                                    ///< \brief get the type of a column
+        wxString    GetColumnName(size_t uiField) const;                                    ///< \brief get the name of a column
+
+        //rows
+        size_t      GetRowCount(void) const;                                                ///< \brief get the amount of rows
+        void        Reserve(size_t uiRowCount);                                             ///< \brief reserve memory for rows
+        size_t      AppendRow(void);                                                        ///< \brief append a row with default values
+        void        SetRowCount(size_t uiRowCount);                                         ///< \brief add or remove rows at the end
+        void        Clear(void);                                                            ///< \brief remove all rows
+
+        //typed getters
+        wxInt64         GetInt64(size_t uiRow, size_t uiField) const;                       ///< \brief get a value of a WX_COLUMN_INT64 column
+        double          GetDouble(size_t uiRow, size_t uiField) const;                      ///< \brief get a value of a WX_COLUMN_DOUBLE column
+        bool            GetBool(size_t uiRow, size_t uiField) const;                        ///< \brief get a value of a WX_COLUMN_BOOL column
+#if wxUSE_DATETIME
+        wxDateTime      GetDateTime(size_t uiRow, size_t uiField) const;                    ///< \brief get a value of a WX_COLUMN_DATETIME column
+#endif // wxUSE_DATETIME
+        const wxString& GetString(size_t uiRow, size_t uiField) const;                      ///< \brief get a value of a WX_COLUMN_STRING column
+
+        //typed setters
+        void SetInt64(size_t uiRow, size_t uiField, wxInt64 iValue);                        ///< \brief set a value of a WX_COLUMN_INT64 column
+        void SetDouble(size_t uiRow, size_t uiField, double dValue);                        ///< \brief set a value of a WX_COLUMN_DOUBLE column
+        void SetBool(size_t uiRow, size_t uiField, bool bValue);                            ///< \brief set a value of a WX_COLUMN_BOOL column
+#if wxUSE_DATETIME
+        void SetDateTime(size_t uiRow, size_t uiField, const wxDateTime &rValue);           ///< \brief set a value of a WX_COLUMN_DATETIME column
+#endif // wxUSE_DATETIME
+        void SetString(size_t uiRow, size_t uiField, const wxString &rsValue);              ///< \brief set a value of a WX_COLUMN_STRING column
+
+        //dictionary
+        size_t GetDictionarySize(size_t uiField) const;                                     ///< \brief get the amount of strings in the dictionary of a column
+
+        //wxVirtualIListDataModel interface
+        virtual size_t    GetItemCount(void);                                               ///< \brief get amount of items
+        virtual size_t    GetFieldCount(const wxVirtualItemID &rID);                        ///< \brief get the amount of fields in the item
+        virtual wxVariant GetListItemData(size_t uiItemID,
+                                          size_t uiField = 0,
+                                          EDataType eType = WX_ITEM_MAIN_DATA);             ///< \brief get the item data
+        virtual void      GetListItemValue(wxVirtualValue &rValue,
+                                           size_t uiItemID,
+                                           size_t uiField = 0,
+                                           EDataType eType = WX_ITEM_MAIN_DATA);            ///< \brief get the item data without allocation
+        virtual void      GetListItemDataBatch(wxVirtualValues &vValues,
+                                               const TRowIndices &vRows,
+                                               const TFieldIDs &vFields,
+                                               EDataType eType = WX_ITEM_MAIN_DATA);        ///< \brief get the data of several rows & fields at once
+        virtual bool      SetListItemData(size_t uiItemID, size_t uiField,
+                                          const wxVariant &vValue,
+                                          EDataType eType = WX_ITEM_MAIN_DATA);             ///< \brief set the item data
+
+        //sorting
+        virtual bool CanSort(const TSortFilters &vSortFilters) const;                       ///< \brief check if the field can be sorted by the data model
+        virtual void Sort(const TSortFilters &vSortFilters);                                ///< \brief sort the values
+        virtual void ResetSorting(void);                                                    ///< \brief restore the storage order
+        virtual ECompareResult Compare(const wxVirtualItemID &rID1,
+                                       const wxVirtualItemID &rID2,
+                                       size_t uiField);                                     ///< \brief compare 2 items
+
+        //filtering
+        virtual void GetAllValues(wxArrayString &rvStrings, size_t uiField,
+                                  wxVirtualIStateModel *pStateModel);                       ///< \brief get all the values inside an array of strings
+        virtual void GetAllValues(wxVector<wxVariant> &rvVariants, size_t uiField,
+                                  wxVirtualIStateModel *pStateModel);                       ///< \brief get all the values inside an array of variants
+
+        //multi-threading
+        virtual bool IsThreadSafe(void);                                                    ///< \brief check if GetItemData() & Compare() can be called from worker threads
+
+    protected:
+        /// \struct TColumn : the storage of 1 column
+        struct TColumn
+        {
+            EColumnType             m_eType;                                                ///< \brief type of the values
+            wxString                m_sName;                                                ///< \brief name of the column
+            wxVector<wxInt64>       m_vInt64s;                                              ///< \brief values of WX_COLUMN_INT64 & WX_COLUMN_DATETIME columns
+            wxVector<double>        m_vDoubles;                                             ///< \brief values of WX_COLUMN_DOUBLE columns
+            wxVector<wxUint8>       m_vBools;                                               ///< \brief values of WX_COLUMN_BOOL columns
+            wxVector<wxUint32>      m_vCodes;                                               ///< \brief values of WX_COLUMN_STRING columns (index in m_vStrings)
+            wxVector<wxString>      m_vStrings;                                             ///< \brief dictionary of WX_COLUMN_STRING columns
+            THashMapColumnarStrings m_MapOfCodes;                                           ///< \brief string -> index in m_vStrings
+        };
+        typedef wxVector<TColumn*> TColumns;                                                ///< \brief array of columns
+
+        //data
+        TColumns            m_vColumns;                                                     ///< \brief the columns (owned)
+        size_t              m_uiRowCount;                                                   ///< \brief amount of rows
+        TSortPermutation    m_vOrder;                                                       ///< \brief m_vOrder[i] = storage index of the row i. Empty if not sorted
+
+        //methods
+        size_t      GetStorageRow(size_t uiRow) const;                                      ///< \brief convert a row index to a storage index
+        void        GetStorageValue(wxVirtualValue &rValue, const TColumn *pColumn,
+                                    size_t uiStorageRow) const;                             ///< \brief get a value from its storage index
+        wxUint32    GetStringCode(TColumn *pColumn, const wxString &rsValue);               ///< \brief get the dictionary code of a string, add it if needed
+        void        ResizeColumn(TColumn *pColumn, size_t uiRowCount);                      ///< \brief resize the storage of a column
+        void        GetSortKeys(TSortKeys &vKeys, const TColumn *pColumn,
+                                bool bDescending) const;                                    ///< \brief get the sort keys of all the rows of a column
+        void        GetDistinctValues(wxVector<wxVariant> &rvVariants,
+                                      const TColumn *pColumn) const;                        ///< \brief get the sorted distinct values of a column
+
+    private:
+        //forbidden
+        wxVirtualColumnarListModel(const wxVirtualColumnarListModel &rhs);                  ///< \brief copy constructor (forbidden)
+        wxVirtualColumnarListModel& operator=(const wxVirtualColumnarListModel &rhs);       ///< \brief assignation operator (forbidden)
+};
+
+#endif
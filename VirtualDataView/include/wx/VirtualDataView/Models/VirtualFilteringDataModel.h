@@ -35,6 +35,9 @@ class WXDLLIMPEXP_VDV wxVirtualFilteringDataModel : public wxVirtualIArrayProxyD
         wxVirtualDataViewFiltersList&       Filters(void);                                  ///< \brief get all the filters
         const wxVirtualDataViewFiltersList& Filters(void) const;                            ///< \brief get all the filters - const version
 
+        //cache
+        virtual void ClearCache(void);                                                      ///< \brief clear the cached results
+
         //interface reimplementation from wxVirtualIDataModel
         //filtering - get all values as string
         virtual void GetAllValues(wxArrayString &rvStrings, size_t uiField,
@@ -84,6 +87,28 @@ class WXDLLIMPEXP_VDV wxVirtualFilteringDataModel : public wxVirtualIArrayProxyD
         virtual void    DoGetChildren(wxVirtualItemIDs &vChildren,
                                       const wxVirtualItemID &rIDParent);                    ///< \brief get all children
 
+        //partial updates
+        virtual void    OnItemIDsShifted(wxVirtualIListDataModel *pListModel,
+                                         size_t uiFirst, size_t uiCount,
+                                         bool bInserted);                                   ///< \brief the rows of the bottom list model were shifted
+        virtual void    OnMasterItemsChanged(const wxVirtualItemIDs &vIDs,
+                                             const TFieldIDs &vFields);                     ///< \brief the values of some items of the master model changed
+        virtual void    OnMasterItemsMoved(const wxVirtualItemID &rParent,
+                                           size_t uiFirst, size_t uiCount,
+                                           size_t uiDestination);                           ///< \brief some items of the master model were moved
+        virtual void    OnMasterChildrenReset(const wxVirtualItemID &rParent);              ///< \brief the children of an item of the master model changed
+        virtual bool    IsAffectedByFields(const TFieldIDs &vFields) const;                 ///< \brief check if changing some fields can modify the children arrays
+        virtual bool    DoInsertChildren(wxVirtualItemIDs &vChildren,
+                                         const wxVirtualItemID &rIDParent,
+                                         const wxVirtualItemIDs &vNewIDs,
+                                         TPositions &vPositions);                           ///< \brief insert new items in cached children
+        virtual bool    DoUpdateChildren(wxVirtualItemIDs &vChildren,
+                                         const wxVirtualItemID &rIDParent,
+                                         const wxVirtualItemIDs &vChangedIDs,
+                                         TPositions &vRemoved,
+                                         TPositions &vInserted);                            ///< \brief re-position changed items in cached children
+        wxVirtualIListDataModel* GetMasterListModel(void);                                  ///< \brief get the master model if it is the bottom list model
+
         //apply filter
         bool IsAccepted(const wxVirtualItemID &rID);                                        ///< \brief check if an item is accepted
         bool IsAcceptedNonRecursive(const wxVirtualItemID &rID);                            ///< \brief check if an item is accepted, ignoring filter recursivity
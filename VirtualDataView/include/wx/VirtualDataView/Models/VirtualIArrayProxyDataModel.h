@@ -11,6 +11,18 @@
 
 #include <wx/VirtualDataView/Models/VirtualIProxyDataModel.h>
 #include <wx/VirtualDataView/LRUCache/LRUCache.h>
+#include <wx/hashset.h>
+
+WX_DECLARE_HASH_SET(wxVirtualItemID, wxVirtualItemIDHash, wxVirtualItemIDEqual, TSetOfItemIDs);
+
+#define WX_VDV_DEFAULT_CHILDREN_CACHE_MEMORY    (size_t(256) * 1024 * 1024)                 ///< \brief default memory limit of the children cache (256 MB)
+
+/** \class wxVirtualItemIDsCost : memory cost of an array of item IDs, for LRUCache
+  */
+struct wxVirtualItemIDsCost
+{
+    size_t operator()(const wxVirtualItemIDs &vIDs) const {return(vIDs.size() * sizeof(wxVirtualItemID));}
+};
 
 /** \class wxVirtualIArrayProxyDataModel: all methods are implemented or reimplemented.
   *       The child items are stored inside an array, and are further processed
@@ -18,9 +30,11 @@
   *       For speeding up the results, a cache system is implemented
   *
   *       The cache system is configurable:
-  *         - SetCacheSize gives the maximal cache size. As soon as the max cache size is reached,
-  *           the least-used item is removed to make room (LRU cache : Least-Recently-Used)
-  *           10000 is a good suggested value
+  *         - SetCacheMemoryLimit gives the maximal amount of bytes used by the cached children.
+  *           As soon as it is reached, the least recently used items are removed to make room
+  *           (LRU cache : Least-Recently-Used). The default is 256 MB
+  *         - SetCacheSize gives the maximal amount of cached items. Unlimited by default: the memory
+  *           limit is usually a better criteria.
   *         - SetMinAmountOfChildrenForCaching indicates that items with strictly less than N children will not be cached
   *           This avoids polluting the cache with items which can be recomputed quickly
   *           A suggested value is 5
@@ -28,6 +42,16 @@
   *           This avoids high memory consumption when many large items need to be cached.
   *           Set this limit only if memory is very scarce.
   *           A suggested value is size_t(-1) (no limit)
+  *
+  *       The change notifications of the master model (see wxVirtualIDataModel::ItemsInserted() and others)
+  *       update only the cached children of the affected parent: derived classes insert / re-position the
+  *       items in the cached array (DoInsertChildren(), DoUpdateChildren()) instead of rebuilding it.
+  *       The notification is then translated to the positions of this model. When an update cannot be done
+  *       partially, the cached children of the parent are dropped, and ChildrenReset() is sent.
+  *       Removed items can be identified only for list models (their IDs are row indices).
+  *
+  *       The values are not transformed: GetItemValue() and GetItemDataBatch() are forwarded to the
+  *       master model. Derived classes which override GetItemData() must override them too.
   */
 class WXDLLIMPEXP_VDV wxVirtualIArrayProxyDataModel : public wxVirtualIProxyDataModel
 {
@@ -80,10 +104,28 @@ class WXDLLIMPEXP_VDV wxVirtualIArrayProxyDataModel : public wxVirtualIProxyData
                                          wxVirtualIStateModel *pStateModel,
                                          size_t uiNbItems = 1);                             ///< \brief find the previous item
 
+        //interface : item data (the values are not transformed)
+        virtual void      GetItemValue(wxVirtualValue &rValue,
+                                       const wxVirtualItemID &rID,
+                                       size_t uiField = 0,
+                                       EDataType eType = WX_ITEM_MAIN_DATA);                ///< \brief get the item data without allocation
+        virtual void      GetItemDataBatch(wxVirtualValues &vValues,
+                                           const wxVirtualItemIDs &vIDs,
+                                           const TFieldIDs &vFields,
+                                           EDataType eType = WX_ITEM_MAIN_DATA);            ///< \brief get the data of several items & fields at once
+
+        //proxy data model
+        virtual bool IsReorderingProxy(void) const;                                         ///< \brief return true : the children are reordered / filtered
+
         //cache
-        void    ClearCache(void);                                                           ///< \brief clear the cached results
+        virtual void ClearCache(void);                                                      ///< \brief clear the cached results
         void    SetCacheSize(size_t uiMaxAmountOfItemsInCache);                             ///< \brief set the cache size
         size_t  GetCacheSize(void) const;                                                   ///< \brief get the cache size
+        void    SetCacheMemoryLimit(size_t uiMaxBytes);                                     ///< \brief set the maximal amount of bytes used by the cache
+        size_t  GetCacheMemoryLimit(void) const;                                            ///< \brief get the maximal amount of bytes used by the cache
+        size_t  GetCacheMemoryUsage(void) const;                                            ///< \brief get the amount of bytes used by the cache
+        void    GetCacheStatistics(size_t &uiHits, size_t &uiMisses,
+                                   size_t &uiEvictions) const;                              ///< \brief get the hits, misses & evictions of the cache
         size_t  MinAmountOfChildrenForCaching(void) const;                                  ///< \brief get the minimal amount of children for caching the result
         void    SetMinAmountOfChildrenForCaching(size_t uiMin);                             ///< \brief set the minimal amount of children for caching the result
         size_t  MaxAmountOfChildrenForCaching(void) const;                                  ///< \brief get the maximal amount of children for caching the result
@@ -91,8 +133,12 @@ class WXDLLIMPEXP_VDV wxVirtualIArrayProxyDataModel : public wxVirtualIProxyData
 
     protected:
         //typedef
-        typedef LRUCache<wxVirtualItemID, wxVirtualItemIDs> TCachedResults;
-        typedef LRUCache<wxVirtualItemID, size_t> TCachedChildrenIndices;
+        typedef wxVector<size_t> TPositions;                                                ///< \brief array of child indices
+        typedef LRUCache<wxVirtualItemID, wxVirtualItemIDs,
+                         wxVirtualItemIDHash, wxVirtualItemIDEqual,
+                         wxVirtualItemIDsCost>                          TCachedResults;
+        typedef LRUCache<wxVirtualItemID, size_t,
+                         wxVirtualItemIDHash, wxVirtualItemIDEqual>     TCachedChildrenIndices;
 
         //data
         wxVirtualItemIDs        m_vChildren;                                                ///< \brief temp array
@@ -108,6 +154,46 @@ class WXDLLIMPEXP_VDV wxVirtualIArrayProxyDataModel : public wxVirtualIProxyData
         //new interface
         virtual void            DoGetChildren(wxVirtualItemIDs &vChildren,
                                               const wxVirtualItemID &rIDParent) = 0;        ///< \brief get all children
+
+        //new interface : partial updates of the cached children
+        virtual bool            IsAffectedByFields(const TFieldIDs &vFields) const;         ///< \brief check if changing some fields can modify the children arrays
+        virtual bool            DoInsertChildren(wxVirtualItemIDs &vChildren,
+                                                 const wxVirtualItemID &rIDParent,
+                                                 const wxVirtualItemIDs &vNewIDs,
+                                                 TPositions &vPositions);                   ///< \brief insert new items in cached children
+        virtual bool            DoUpdateChildren(wxVirtualItemIDs &vChildren,
+                                                 const wxVirtualItemID &rIDParent,
+                                                 const wxVirtualItemIDs &vChangedIDs,
+                                                 TPositions &vRemoved,
+                                                 TPositions &vInserted);                    ///< \brief re-position changed items in cached children
+
+        //reaction to the notifications of the master model
+        virtual void OnItemIDsShifted(wxVirtualIListDataModel *pListModel,
+                                      size_t uiFirst, size_t uiCount,
+                                      bool bInserted);                                      ///< \brief the rows of the bottom list model were shifted
+        virtual void OnMasterItemsInserted(const wxVirtualItemID &rParent,
+                                           size_t uiFirst, size_t uiCount);                 ///< \brief some items were inserted in the master model
+        virtual void OnMasterItemsRemoved(const wxVirtualItemID &rParent,
+                                          size_t uiFirst, size_t uiCount);                  ///< \brief some items were removed from the master model
+        virtual void OnMasterItemsChanged(const wxVirtualItemIDs &vIDs,
+                                          const TFieldIDs &vFields);                        ///< \brief the values of some items of the master model changed
+        virtual void OnMasterItemsMoved(const wxVirtualItemID &rParent,
+                                        size_t uiFirst, size_t uiCount,
+                                        size_t uiDestination);                              ///< \brief some items of the master model were moved
+        virtual void OnMasterChildrenReset(const wxVirtualItemID &rParent);                 ///< \brief the children of an item of the master model changed
+        virtual void OnMasterModelReset(void);                                              ///< \brief the whole master model changed
+
+        //helpers for partial updates
+        wxVirtualIListDataModel* GetBottomListModel(void);                                  ///< \brief get the bottom model if it is a list model
+        static void MergeChildren(wxVirtualItemIDs &vChildren,
+                                  const wxVirtualItemIDs &vNewIDs,
+                                  const TPositions &vInsertBefore,
+                                  TPositions &vPositions);                                  ///< \brief insert ordered items at known positions
+        static void EraseInvalidChildren(wxVirtualItemIDs &vChildren,
+                                         TPositions &vRemoved);                             ///< \brief remove the items marked as invalid
+        void        NotifyChildrenUpdated(const wxVirtualItemID &rParent,
+                                          const TPositions &vRemoved,
+                                          const TPositions &vInserted);                     ///< \brief send the notifications for removed & inserted children
 };
 
 #endif
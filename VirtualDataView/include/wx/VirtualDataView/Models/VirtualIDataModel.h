@@ -11,12 +11,16 @@
 
 #include <wx/VirtualDataView/VirtualItemID.h>
 #include <wx/VirtualDataView/Types/ArrayDefs.h>
+#include <wx/VirtualDataView/Types/VirtualValue.h>
 #include <wx/variant.h>
 
 class WXDLLIMPEXP_VDV wxVirtualDataViewItemAttr;
 class WXDLLIMPEXP_VDV wxVirtualDataViewCellAttrProvider;
 class WXDLLIMPEXP_VDV wxVirtualIStateModel;
 class WXDLLIMPEXP_VDV wxVirtualDataViewItemState;
+class WXDLLIMPEXP_VDV wxVirtualIDataModelObserver;
+class WXDLLIMPEXP_VDV wxVirtualIListDataModel;
+struct wxVirtualViewportHint;
 
 
 
@@ -81,6 +85,26 @@ class WXDLLIMPEXP_VDV wxVirtualDataViewItemState;
   *
   * <B> FILTERING : </B>
   *
+  * <B> CHANGE NOTIFICATIONS : </B>
+  *     When the data changes, the model can describe the change precisely instead of letting the control
+  *     rebuild everything (wxVirtualDataViewCtrl::OnDataModelChanged()):
+  *     \code
+  *         ItemsInserted(rParent, uiFirst, uiCount);           //children [uiFirst, uiFirst + uiCount[ are new
+  *         ItemsRemoved(rParent, uiFirst, uiCount);            //children [uiFirst, uiFirst + uiCount[ were removed
+  *         ItemsChanged(vIDs, vFields);                        //values changed (all fields if vFields is empty)
+  *         ItemsRefreshed(vIDs);                               //values unchanged, but must be repainted
+  *         ItemsMoved(rParent, uiFirst, uiCount, uiDestination);
+  *         ChildrenReset(rParent);                             //children of rParent changed in an unspecified way
+  *         ModelReset();                                       //everything changed
+  *     \endcode
+  *     These methods must be called from the GUI thread, after the change.
+  *     The notifications go up the chain of proxy models: each proxy updates only the affected part of its
+  *     caches, and translates the notification to its own positions. The top-most model forwards them to its
+  *     observers (see wxVirtualIDataModelObserver). The controls observe their data model.
+  *     ItemsRefreshed() is the exception: it skips the proxy models, and goes straight to the observers.
+  *     List models (WX_MODEL_CLASS_LIST) identify their items by row index: inserting or removing rows changes
+  *     the ID of the following rows. The proxies remap the IDs they keep before processing the notification.
+  *
   * <B> Subclassing: </B>
   *     - models implementation must implement the pure-virtual methods. There are only 3,
   *       and they define the item hierarchy
@@ -173,6 +197,7 @@ class WXDLLIMPEXP_VDV wxVirtualIDataModel
             WX_MODEL_CLASS_PROXY    = 0x04                                                  ///< \brief proxy data model
         };
         virtual int GetModelClass(void) const;                                              ///< \brief get the model class flags
+        virtual wxVirtualIListDataModel* AsListModel(void);                                 ///< \brief get this model as a wxVirtualIListDataModel, if it is one
 
         //interface : hierarchy
         virtual wxVirtualItemID GetParent(const wxVirtualItemID &rID = s_RootID)    = 0;    ///< \brief get the parent item ID
@@ -187,6 +212,15 @@ class WXDLLIMPEXP_VDV wxVirtualIDataModel
         virtual wxVariant GetItemData(const wxVirtualItemID &rID,
                                       size_t uiField = 0,
                                       EDataType eType = WX_ITEM_MAIN_DATA);                 ///< \brief get the item data
+        virtual void      GetItemValue(wxVirtualValue &rValue,
+                                       const wxVirtualItemID &rID,
+                                       size_t uiField = 0,
+                                       EDataType eType = WX_ITEM_MAIN_DATA);                ///< \brief get the item data without allocation
+        typedef wxVector<size_t> TFieldIDs;                                                 ///< \brief array of field indices
+        virtual void      GetItemDataBatch(wxVirtualValues &vValues,
+                                           const wxVirtualItemIDs &vIDs,
+                                           const TFieldIDs &vFields,
+                                           EDataType eType = WX_ITEM_MAIN_DATA);            ///< \brief get the data of several items & fields at once
         virtual wxVirtualDataViewItemAttr* GetItemAttribute(const wxVirtualItemID &rID,
                                                             size_t uiField,
                                               const wxVirtualDataViewItemState &rState);    ///< \brief get the item graphic attributes
@@ -311,6 +345,7 @@ class WXDLLIMPEXP_VDV wxVirtualIDataModel
                                         const wxVirtualItemID &rID2,
                                         const wxVariant &rValue2,
                                         size_t uiField);                                    ///< \brief compare 2 items values
+        virtual bool            HasCustomCompare(size_t uiField);                           ///< \brief check if Compare() is reimplemented for a field
 
         //filtering - get all values as string
         virtual void GetAllValues(wxArrayString &rvStrings, size_t uiField,
@@ -350,16 +385,60 @@ class WXDLLIMPEXP_VDV wxVirtualIDataModel
         virtual void GetAllValues(wxVector<wxVariant> &rvVariants, size_t uiField,
                                   wxVirtualIStateModel *pStateModel);                       ///< \brief get all the values inside an array of variants
 
+        //multi-threading
+        virtual bool IsThreadSafe(void);                                                    ///< \brief check if GetItemData() & Compare() can be called from worker threads
+
+        //view hints
+        virtual void OnViewportChanged(const wxVirtualViewportHint &rHint);                 ///< \brief the rows shown by the view changed
+        virtual void OnPaintFetch(bool bStart);                                             ///< \brief the view starts / stops reading the values of the painted cells
+
         //proxy data model
         virtual bool IsProxyDataModel(void) const;                                          ///< \brief return true if the model is a proxy data model
+        virtual bool IsReorderingProxy(void) const;                                         ///< \brief return true if the model changes the order or the set of the children
         virtual wxVirtualIDataModel* GetParentModel(void);                                  ///< \brief get parent model
         virtual void                 SetParentModel(wxVirtualIDataModel *pParentModel);     ///< \brief set parent model
         virtual wxVirtualIDataModel* GetTopModel(void);                                     ///< \brief get top model (the top-most proxy one)
         virtual wxVirtualIDataModel* GetBottomModel(void);                                  ///< \brief get last model (the real one)
 
+        //change notifications
+        void AddObserver(wxVirtualIDataModelObserver *pObserver);                           ///< \brief register an observer of the changes
+        void RemoveObserver(wxVirtualIDataModelObserver *pObserver);                        ///< \brief unregister an observer of the changes
+        void ItemsInserted(const wxVirtualItemID &rParent,
+                           size_t uiFirst, size_t uiCount);                                 ///< \brief notify that some items were inserted
+        void ItemsRemoved(const wxVirtualItemID &rParent,
+                          size_t uiFirst, size_t uiCount);                                  ///< \brief notify that some items were removed
+        void ItemsChanged(const wxVirtualItemIDs &vIDs,
+                          const TFieldIDs &vFields = TFieldIDs());                          ///< \brief notify that the values of some items changed
+        void ItemsMoved(const wxVirtualItemID &rParent,
+                        size_t uiFirst, size_t uiCount,
+                        size_t uiDestination);                                              ///< \brief notify that some items were moved
+        void ItemsRefreshed(const wxVirtualItemIDs &vIDs);                                  ///< \brief notify that some items must be repainted
+        void ChildrenReset(const wxVirtualItemID &rParent);                                 ///< \brief notify that the children of an item changed
+        void ModelReset(void);                                                              ///< \brief notify that the whole model changed
+
     protected:
+        //typedefs
+        typedef wxVector<wxVirtualIDataModelObserver*> TObservers;                          ///< \brief array of observers
+
         //data
         wxVirtualIDataModel*        m_pParentModel;                                         ///< \brief parent data model
+        TObservers                  m_vObservers;                                           ///< \brief observers of the changes (top-most model only)
+
+        //reaction to the notifications of the master model (proxy models)
+        virtual void OnItemIDsShifted(wxVirtualIListDataModel *pListModel,
+                                      size_t uiFirst, size_t uiCount,
+                                      bool bInserted);                                      ///< \brief the rows of the bottom list model were shifted
+        virtual void OnMasterItemsInserted(const wxVirtualItemID &rParent,
+                                           size_t uiFirst, size_t uiCount);                 ///< \brief some items were inserted in the master model
+        virtual void OnMasterItemsRemoved(const wxVirtualItemID &rParent,
+                                          size_t uiFirst, size_t uiCount);                  ///< \brief some items were removed from the master model
+        virtual void OnMasterItemsChanged(const wxVirtualItemIDs &vIDs,
+                                          const TFieldIDs &vFields);                        ///< \brief the values of some items of the master model changed
+        virtual void OnMasterItemsMoved(const wxVirtualItemID &rParent,
+                                        size_t uiFirst, size_t uiCount,
+                                        size_t uiDestination);                              ///< \brief some items of the master model were moved
+        virtual void OnMasterChildrenReset(const wxVirtualItemID &rParent);                 ///< \brief the children of an item of the master model changed
+        virtual void OnMasterModelReset(void);                                              ///< \brief the whole master model changed
 
         //methods
         wxVirtualItemID CreateItemID(void *pID) const;                                      ///< \brief create an item ID from a void pointer
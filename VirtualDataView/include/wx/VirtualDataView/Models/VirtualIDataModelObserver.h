@@ -0,0 +1,74 @@
+/**********************************************************************/
+/** FILE    : VirtualIDataModelObserver.h                            **/
+/** PROJECT : wxVirtualDataViewCtrl                                  **/
+/** LICENSE : wxWindows Library Licence                              **/
+/** PURPOSE : interface for receiving data model change notifications**/
+/**********************************************************************/
+
+
+#ifndef WX_VIRTUAL_I_DATA_MODEL_OBSERVER_H_
+#define WX_VIRTUAL_I_DATA_MODEL_OBSERVER_H_
+
+#include <wx/VirtualDataView/Models/VirtualIDataModel.h>
+
+/** \class wxVirtualIDataModelObserver : receives the change notifications of a data model
+  * An observer is registered with wxVirtualIDataModel::AddObserver(). The observers are always
+  * held by the top-most model of a chain of proxy models: the notifications they receive are
+  * expressed in terms of the top-most model (positions of the items after sorting / filtering).
+  *
+  * The notifications are sent after the change, in the GUI thread. The positions are child indices
+  * in the model sending the notification:
+  *     - OnItemsInserted() : the children [uiFirst, uiFirst + uiCount[ of rParent are new
+  *     - OnItemsRemoved()  : the children which were at [uiFirst, uiFirst + uiCount[ have been removed
+  *     - OnItemsChanged()  : the values of some items changed, but not the hierarchy
+  *     - OnItemsMoved()    : the children [uiFirst, uiFirst + uiCount[ moved before the child uiDestination
+  *                           (uiDestination is expressed before the move)
+  *     - OnChildrenReset() : the children of rParent changed in an unspecified way
+  *     - OnModelReset()    : the whole model changed
+  *
+  * OnItemIDsShifted() is sent before OnItemsInserted() / OnItemsRemoved() when rows are inserted in
+  * or removed from a list model. Unlike the other notifications, the positions are the row indices in
+  * that list model (pListModel), which are also its item IDs (row index + 1): observers keeping per-item
+  * data keyed by item ID must shift it. The default implementation does nothing
+  *
+  * OnItemsRefreshed() is sent when some items must be repainted, but their values did not change
+  * (e.g. values fetched in background are available). The default implementation calls OnItemsChanged()
+  */
+class WXDLLIMPEXP_VDV wxVirtualIDataModelObserver
+{
+    public:
+        //typedefs
+        typedef wxVirtualIDataModel::TFieldIDs TFieldIDs;                                   ///< \brief array of field indices
+
+        //constructors & destructor
+        wxVirtualIDataModelObserver(void);                                                  ///< \brief default constructor
+        virtual ~wxVirtualIDataModelObserver(void);                                         ///< \brief destructor
+
+        //interface
+        virtual void OnItemsInserted(wxVirtualIDataModel *pModel,
+                                     const wxVirtualItemID &rParent,
+                                     size_t uiFirst, size_t uiCount)            = 0;        ///< \brief some items were inserted
+        virtual void OnItemsRemoved(wxVirtualIDataModel *pModel,
+                                    const wxVirtualItemID &rParent,
+                                    size_t uiFirst, size_t uiCount)             = 0;        ///< \brief some items were removed
+        virtual void OnItemsChanged(wxVirtualIDataModel *pModel,
+                                    const wxVirtualItemIDs &vIDs,
+                                    const TFieldIDs &vFields)                   = 0;        ///< \brief the values of some items changed
+        virtual void OnItemsMoved(wxVirtualIDataModel *pModel,
+                                  const wxVirtualItemID &rParent,
+                                  size_t uiFirst, size_t uiCount,
+                                  size_t uiDestination)                         = 0;        ///< \brief some items were moved
+        virtual void OnChildrenReset(wxVirtualIDataModel *pModel,
+                                     const wxVirtualItemID &rParent)            = 0;        ///< \brief the children of an item changed
+        virtual void OnModelReset(wxVirtualIDataModel *pModel)                  = 0;        ///< \brief the whole model changed
+
+        //interface with default implementation
+        virtual void OnItemIDsShifted(wxVirtualIDataModel *pModel,
+                                      wxVirtualIListDataModel *pListModel,
+                                      size_t uiFirst, size_t uiCount,
+                                      bool bInserted);                                      ///< \brief the item IDs of a list model were shifted
+        virtual void OnItemsRefreshed(wxVirtualIDataModel *pModel,
+                                      const wxVirtualItemIDs &vIDs);                        ///< \brief some items must be repainted
+};
+
+#endif
@@ -32,6 +32,7 @@ class WXDLLIMPEXP_VDV wxVirtualIListDataModel : public wxVirtualIDataModel
 
         //interface: class type
         virtual int GetModelClass(void) const;                                              ///< \brief get the model class flags
+        virtual wxVirtualIListDataModel* AsListModel(void);                                 ///< \brief get this model as a wxVirtualIListDataModel
 
         //new interface
         virtual size_t GetItemCount(void) = 0;                                              ///< \brief get amount of items
@@ -40,6 +41,15 @@ class WXDLLIMPEXP_VDV wxVirtualIListDataModel : public wxVirtualIDataModel
         virtual wxVariant GetListItemData(size_t uiItemID,
                                       size_t uiField = 0,
                                       EDataType eType = WX_ITEM_MAIN_DATA);                 ///< \brief get the item data
+        virtual void      GetListItemValue(wxVirtualValue &rValue,
+                                           size_t uiItemID,
+                                           size_t uiField = 0,
+                                           EDataType eType = WX_ITEM_MAIN_DATA);            ///< \brief get the item data without allocation
+        typedef wxVector<size_t> TRowIndices;                                               ///< \brief array of row indices
+        virtual void      GetListItemDataBatch(wxVirtualValues &vValues,
+                                               const TRowIndices &vRows,
+                                               const TFieldIDs &vFields,
+                                               EDataType eType = WX_ITEM_MAIN_DATA);        ///< \brief get the data of several rows & fields at once
         virtual wxVirtualDataViewItemAttr* GetListItemAttribute(size_t uiItemID,
                                                             size_t uiField,
                                               const wxVirtualDataViewItemState &rState);    ///< \brief get the item graphic attributes
@@ -61,6 +71,14 @@ class WXDLLIMPEXP_VDV wxVirtualIListDataModel : public wxVirtualIDataModel
         virtual wxVariant GetItemData(const wxVirtualItemID &rID,
                                       size_t uiField = 0,
                                       EDataType eType = WX_ITEM_MAIN_DATA);                 ///< \brief get the item data
+        virtual void      GetItemValue(wxVirtualValue &rValue,
+                                       const wxVirtualItemID &rID,
+                                       size_t uiField = 0,
+                                       EDataType eType = WX_ITEM_MAIN_DATA);                ///< \brief get the item data without allocation
+        virtual void      GetItemDataBatch(wxVirtualValues &vValues,
+                                           const wxVirtualItemIDs &vIDs,
+                                           const TFieldIDs &vFields,
+                                           EDataType eType = WX_ITEM_MAIN_DATA);            ///< \brief get the data of several items & fields at once
         virtual wxVirtualDataViewItemAttr* GetItemAttribute(const wxVirtualItemID &rID,
                                                             size_t uiField,
                                               const wxVirtualDataViewItemState &rState);    ///< \brief get the item graphic attributes
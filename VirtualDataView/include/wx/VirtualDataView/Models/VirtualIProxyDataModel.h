@@ -51,6 +51,14 @@ class WXDLLIMPEXP_VDV wxVirtualIProxyDataModel : public wxVirtualIDataModel
         virtual wxVariant GetItemData(const wxVirtualItemID &rID,
                                       size_t uiField = 0,
                                       EDataType eType = WX_ITEM_MAIN_DATA);                 ///< \brief get the item data
+        virtual void      GetItemValue(wxVirtualValue &rValue,
+                                       const wxVirtualItemID &rID,
+                                       size_t uiField = 0,
+                                       EDataType eType = WX_ITEM_MAIN_DATA);                ///< \brief get the item data without allocation
+        virtual void      GetItemDataBatch(wxVirtualValues &vValues,
+                                           const wxVirtualItemIDs &vIDs,
+                                           const TFieldIDs &vFields,
+                                           EDataType eType = WX_ITEM_MAIN_DATA);            ///< \brief get the data of several items & fields at once
         virtual wxVirtualDataViewItemAttr* GetItemAttribute(const wxVirtualItemID &rID,
                                                             size_t uiField,
                                               const wxVirtualDataViewItemState &rState);    ///< \brief get the item graphic attributes
@@ -189,6 +197,14 @@ class WXDLLIMPEXP_VDV wxVirtualIProxyDataModel : public wxVirtualIDataModel
                                         const wxVirtualItemID &rID2,
                                         const wxVariant &rValue2,
                                         size_t uiField);                                    ///< \brief compare 2 items values
+        virtual bool            HasCustomCompare(size_t uiField);                           ///< \brief check if Compare() is reimplemented for a field
+
+        //multi-threading
+        virtual bool IsThreadSafe(void);                                                    ///< \brief check if GetItemData() & Compare() can be called from worker threads
+
+        //view hints
+        virtual void OnViewportChanged(const wxVirtualViewportHint &rHint);                 ///< \brief the rows shown by the view changed
+        virtual void OnPaintFetch(bool bStart);                                             ///< \brief the view starts / stops reading the values of the painted cells
 
         //proxy data model
         virtual bool IsProxyDataModel(void) const;                                          ///< \brief return true if the model is a proxy data model
@@ -197,6 +213,11 @@ class WXDLLIMPEXP_VDV wxVirtualIProxyDataModel : public wxVirtualIDataModel
         //data
         wxVirtualIDataModel*        m_pDataModel;                                           ///< \brief the model which is shadowed
 
+        //item data forwarding, for proxies which do not transform the values
+        void ForwardItemValue(wxVirtualValue &rValue, const wxVirtualItemID &rID,
+                              size_t uiField, EDataType eType);                             ///< \brief get the item data from the master model
+        void ForwardItemDataBatch(wxVirtualValues &vValues, const wxVirtualItemIDs &vIDs,
+                                  const TFieldIDs &vFields, EDataType eType);               ///< \brief get the data of several items from the master model
 };
 
 #endif
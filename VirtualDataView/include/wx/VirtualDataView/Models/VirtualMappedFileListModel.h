@@ -0,0 +1,221 @@
+/**********************************************************************/
+/** FILE    : VirtualMappedFileListModel.h                           **/
+/** PROJECT : wxVirtualDataViewCtrl                                  **/
+/** LICENSE : wxWindows Library Licence                              **/
+/** PURPOSE : list data model reading a memory-mapped file           **/
+/**********************************************************************/
+
+
+#ifndef WX_VIRTUAL_MAPPED_FILE_LIST_MODEL_H_
+#define WX_VIRTUAL_MAPPED_FILE_LIST_MODEL_H_
+
+#include <wx/VirtualDataView/Models/VirtualIListDataModel.h>
+#include <wx/VirtualDataView/Utilities/VirtualMappedFile.h>
+#include <wx/VirtualDataView/LRUCache/LRUCache.h>
+#include <wx/vector.h>
+#if wxUSE_THREADS
+    #include <wx/thread.h>
+#endif // wxUSE_THREADS
+
+#define WX_VDV_MAPPED_FILE_BLOCK_ROWS   256                                                 ///< \brief amount of rows sharing 1 absolute offset in the line index
+
+class wxVirtualMappedFileIndexer;
+class wxVirtualMappedFileNotifier;
+
+/** \class wxVirtualDecodedRowHash : hash functor for the row indices of the decoded rows cache
+  */
+struct wxVirtualDecodedRowHash
+{
+    size_t operator()(size_t uiRow) const {return(uiRow * 2654435761u);}
+};
+
+/** \class wxVirtualDecodedRowCost : cost functor for the decoded rows cache
+  */
+struct wxVirtualDecodedRowCost
+{
+    size_t operator()(const wxVector<wxString> &vFields) const
+    {
+        size_t i, uiSize, uiCost;
+        uiSize = vFields.size();
+        uiCost = uiSize * sizeof(wxString);
+        for(i = 0; i < uiSize; i++) uiCost += vFields[i].length() * sizeof(wxChar);
+        return(uiCost);
+    }
+};
+
+/** \class wxVirtualMappedFileListModel : a read-only list model reading its rows from a file
+  * The file is mapped in memory (see wxVirtualMappedFile): nothing is loaded up-front. 2 formats
+  * are supported:
+  *     - delimited text (CSV, TSV, ...): 1 row per line, UTF-8. Fields may be quoted; a doubled
+  *       quote inside a quoted field is an escaped quote. Quoted fields cannot contain line breaks.
+  *       The rows are found by a background thread, which stores the offset of each line.
+  *       The index costs ~4 bytes per row. The rows already indexed can be displayed while
+  *       indexing continues: the new rows are notified with ItemsInserted(), a few times per second
+  *     - fixed-size binary records: the row count is known immediately. The fields are described
+  *       by AddRecordField() (offset & type in the record, native byte order)
+  *
+  * The fields are parsed on demand. The text fields of recently read rows are kept in a small LRU
+  * cache: the resident memory is bounded by the offset index and the cache.
+  *
+  * The data are read from the GUI thread only (IsThreadSafe() returns false). The background
+  * indexing does not use the GUI.
+  */
+class WXDLLIMPEXP_VDV wxVirtualMappedFileListModel : public wxVirtualIListDataModel
+{
+    friend class wxVirtualMappedFileIndexer;
+    friend class wxVirtualMappedFileNotifier;
+
+    public:
+        /// \enum EFormat : format of the file
+        enum EFormat
+        {
+            WX_FORMAT_NONE          = 0,                                                    ///< \brief no file opened
+            WX_FORMAT_DELIMITED     = 1,                                                    ///< \brief delimited text file (1 row per line)
+            WX_FORMAT_RECORDS       = 2                                                     ///< \brief fixed-size binary records
+        };
+
+        /// \enum EFieldType : type of a field
+        enum EFieldType
+        {
+            WX_FIELD_TEXT           = 0,                                                    ///< \brief text (UTF-8). Default for delimited files
+            WX_FIELD_INT8           = 1,                                                    ///< \brief signed 8 bits integer
+            WX_FIELD_INT16          = 2,                                                    ///< \brief signed 16 bits integer
+            WX_FIELD_INT32          = 3,                                                    ///< \brief signed 32 bits integer
+            WX_FIELD_INT64          = 4,                                                    ///< \brief signed 64 bits integer
+            WX_FIELD_UINT8          = 5,                                                    ///< \brief unsigned 8 bits integer
+            WX_FIELD_UINT16         = 6,                                                    ///< \brief unsigned 16 bits integer
+            WX_FIELD_UINT32         = 7,                                                    ///< \brief unsigned 32 bits integer
+            WX_FIELD_UINT64         = 8,                                                    ///< \brief unsigned 64 bits integer (shown as signed above 2^63)
+            WX_FIELD_FLOAT          = 9,                                                    ///< \brief 32 bits float
+            WX_FIELD_DOUBLE         = 10                                                    ///< \brief 64 bits double
+        };
+
+        //constructors & destructor
+        wxVirtualMappedFileListModel(void);                                                 ///< \brief default constructor
+        virtual ~wxVirtualMappedFileListModel(void);                                        ///< \brief destructor
+
+        //open / close
+        bool OpenDelimitedFile(const wxString &sFileName, wxChar cSeparator = wxT(','),
+                               bool bHasHeader = true, wxChar cQuote = wxT('"'));           ///< \brief open a delimited text file
+        bool OpenRecordsFile(const wxString &sFileName, size_t uiRecordSize,
+                             wxUint64 uiHeaderSize = 0);                                    ///< \brief open a file of fixed-size records
+        void Close(void);                                                                   ///< \brief close the file
+        bool IsOpened(void) const;                                                          ///< \brief check if a file is opened
+        EFormat  GetFormat(void) const;                                                     ///< \brief get the format of the file
+        wxString GetFileName(void) const;                                                   ///< \brief get the name of the file
+        wxUint64 GetFileSize(void) const;                                                   ///< \brief get the size of the file
+
+        //fields
+        size_t      AddRecordField(EFieldType eType, size_t uiOffset, size_t uiSize = 0,
+                                   const wxString &sName = wxEmptyString);                  ///< \brief describe a field of the records
+        size_t      GetColumnCount(void) const;                                             ///< \brief get the amount of fields
+        wxString    GetColumnName(size_t uiField) const;                                    ///< \brief get the name of a field
+        void        SetColumnName(size_t uiField, const wxString &sName);                   ///< \brief set the name of a field
+        EFieldType  GetFieldType(size_t uiField) const;                                     ///< \brief get the type of a field
+        void        SetFieldType(size_t uiField, EFieldType eType);                         ///< \brief set the type of a field of a delimited file
+
+        //indexing
+        bool   IsIndexing(void) const;                                                      ///< \brief check if the background indexing is running
+        double GetIndexingProgress(void) const;                                             ///< \brief get the fraction of the file already indexed
+        void   WaitForIndex(void);                                                          ///< \brief wait until the whole file is indexed
+        bool   HasIndexError(void) const;                                                   ///< \brief check if the indexing stopped on an error
+
+        //decoded rows cache
+        void   SetCacheSize(size_t uiRows);                                                 ///< \brief set the maximal amount of decoded rows in the cache
+        size_t GetCacheSize(void) const;                                                    ///< \brief get the maximal amount of decoded rows in the cache
+        void   SetCacheMemoryLimit(size_t uiBytes);                                         ///< \brief set the maximal amount of bytes used by the cache
+        size_t GetCacheMemoryLimit(void) const;                                             ///< \brief get the maximal amount of bytes used by the cache
+        void   ClearCache(void);                                                            ///< \brief clear the decoded rows cache
+
+        //wxVirtualIListDataModel interface
+        virtual size_t    GetItemCount(void);                                               ///< \brief get amount of items
+        virtual size_t    GetFieldCount(const wxVirtualItemID &rID);                        ///< \brief get the amount of fields in the item
+        virtual wxVariant GetListItemData(size_t uiItemID,
+                                          size_t uiField = 0,
+                                          EDataType eType = WX_ITEM_MAIN_DATA);             ///< \brief get the item data
+        virtual void      GetListItemValue(wxVirtualValue &rValue,
+                                           size_t uiItemID,
+                                           size_t uiField = 0,
+                                           EDataType eType = WX_ITEM_MAIN_DATA);            ///< \brief get the item data without allocation
+        virtual void      GetListItemDataBatch(wxVirtualValues &vValues,
+                                               const TRowIndices &vRows,
+                                               const TFieldIDs &vFields,
+                                               EDataType eType = WX_ITEM_MAIN_DATA);        ///< \brief get the data of several rows & fields at once
+        virtual EFlags    GetListItemFlags(size_t uiItemID, size_t uiField);                ///< \brief get the item flags
+
+        //sorting
+        virtual bool      HasCustomCompare(size_t uiField);                                 ///< \brief check if Compare() is reimplemented for a field
+
+    protected:
+        /// \struct TField : description of 1 field
+        struct TField
+        {
+            EFieldType  m_eType;                                                            ///< \brief type of the field
+            size_t      m_uiOffset;                                                         ///< \brief offset in the record (binary records only)
+            size_t      m_uiSize;                                                           ///< \brief size in the record (binary records only)
+            wxString    m_sName;                                                            ///< \brief name of the field
+        };
+        typedef wxVector<TField>                                    TFields;                ///< \brief array of fields
+        typedef wxVector<wxString>                                  TDecodedRow;            ///< \brief text fields of 1 row
+        typedef LRUCache<size_t, TDecodedRow,
+                         wxVirtualDecodedRowHash, LRUCacheEqual<size_t>,
+                         wxVirtualDecodedRowCost>                   TDecodedRowsCache;      ///< \brief decoded rows cache
+
+        //data : file
+        wxVirtualMappedFile         m_File;                                                 ///< \brief the mapped file
+        EFormat                     m_eFormat;                                              ///< \brief format of the file
+        TFields                     m_vFields;                                              ///< \brief the fields
+        size_t                      m_uiRowCount;                                           ///< \brief amount of rows published to the GUI
+
+        //data : delimited files
+        char                        m_cSeparator;                                           ///< \brief fields separator
+        char                        m_cQuote;                                               ///< \brief quote character (0 if none)
+        wxUint64                    m_uiDataStart;                                          ///< \brief offset of the 1st row (after the header line)
+
+        //data : binary records
+        size_t                      m_uiRecordSize;                                         ///< \brief size of 1 record
+
+        //data : line index. Offset of the row i = m_vBlockStarts[i / WX_VDV_MAPPED_FILE_BLOCK_ROWS] + m_vRowOffsets[i]
+        wxVector<wxUint64>          m_vBlockStarts;                                         ///< \brief offset of the 1st row of each block of rows
+        wxVector<wxUint32>          m_vRowOffsets;                                          ///< \brief offset of each row, relative to the start of its block
+        wxUint64                    m_uiIndexEnd;                                           ///< \brief end of the last indexed row
+        bool                        m_bIndexError;                                          ///< \brief true if the indexing stopped on an error
+        bool                        m_bIndexing;                                            ///< \brief true while the file is being indexed
+#if wxUSE_THREADS
+        mutable wxCriticalSection   m_IndexLock;                                            ///< \brief protects the line index
+        wxVirtualMappedFileIndexer* m_pIndexer;                                             ///< \brief the indexing thread
+        wxVirtualMappedFileNotifier* m_pNotifier;                                           ///< \brief receives the progress of the indexing thread in the GUI thread
+#endif // wxUSE_THREADS
+
+        //data : cache
+        TDecodedRowsCache           m_DecodedRows;                                          ///< \brief text fields of recently read rows
+        wxVector<TDecodedRow>       m_vBatchRows;                                           ///< \brief text fields of the rows of the last batch
+        TDecodedRow                 m_vLastRow;                                             ///< \brief text fields of the last row read, if it does not fit in the cache
+
+        //methods : indexing
+        wxUint64 IndexLines(wxUint64 uiStart, size_t uiMaxRows,
+                            wxVirtualMappedFileIndexer *pIndexer);                          ///< \brief index lines
+        bool    AppendRowStarts(const wxVector<wxUint64> &vStarts, wxUint64 uiEnd,
+                                bool bFinished);                                            ///< \brief append rows to the line index
+        size_t  GetIndexedRowCount(void) const;                                             ///< \brief get the amount of rows in the line index
+        void    PublishRowCount(void);                                                      ///< \brief publish the indexed rows to the GUI
+        void    StopIndexing(void);                                                         ///< \brief stop the background indexing
+
+        //methods : parsing
+        bool    GetRowRange(size_t uiRow, const char* &pBegin, const char* &pEnd) const;    ///< \brief get the bytes of a row
+        void    SplitLine(TDecodedRow &vFields, const char *pBegin, const char *pEnd,
+                          size_t uiMaxFields) const;                                        ///< \brief split a line in fields
+        void    DecodeRow(TDecodedRow &vFields, size_t uiRow) const;                        ///< \brief decode the text fields of a row
+        const TDecodedRow* GetDecodedRow(size_t uiRow);                                     ///< \brief get the text fields of a row, using the cache
+        void    GetFieldValue(wxVirtualValue &rValue, const TDecodedRow *pDecoded,
+                              size_t uiRow, size_t uiField) const;                          ///< \brief get the value of a field
+        bool    NeedsDecoding(size_t uiField) const;                                        ///< \brief check if a field is read from the decoded text fields
+        void    ResetFile(void);                                                            ///< \brief reset all the file data
+
+    private:
+        //forbidden
+        wxVirtualMappedFileListModel(const wxVirtualMappedFileListModel &rhs);              ///< \brief copy constructor (forbidden)
+        wxVirtualMappedFileListModel& operator=(const wxVirtualMappedFileListModel &rhs);   ///< \brief assignation operator (forbidden)
+};
+
+#endif
@@ -0,0 +1,191 @@
+/**********************************************************************/
+/** FILE    : VirtualPagingDataModel.h                               **/
+/** PROJECT : wxVirtualDataViewCtrl                                  **/
+/** LICENSE : wxWindows Library Licence                              **/
+/** PURPOSE : proxy data model loading a list by pages, with prefetch**/
+/**********************************************************************/
+
+
+#ifndef WX_VIRTUAL_PAGING_DATA_MODEL_H_
+#define WX_VIRTUAL_PAGING_DATA_MODEL_H_
+
+#include <wx/VirtualDataView/Models/VirtualIProxyDataModel.h>
+#include <wx/VirtualDataView/Models/VirtualPrefetchPolicy.h>
+#include <wx/VirtualDataView/LRUCache/LRUCache.h>
+#include <wx/vector.h>
+#if wxUSE_THREADS
+    #include <wx/thread.h>
+#endif // wxUSE_THREADS
+
+#define WX_VDV_PAGING_DEFAULT_CACHED_PAGES  256                                             ///< \brief default amount of pages kept in the cache
+
+class wxVirtualPagingWorker;
+
+/** \class wxVirtualPageIndexHash : hash functor for the page indices of the pages cache
+  */
+struct wxVirtualPageIndexHash
+{
+    size_t operator()(size_t uiPage) const {return(uiPage * 2654435761u);}
+};
+
+/** \class wxVirtualPagingDataModel : proxy data model reading a large list model by pages
+  * The main data of the rows is read by pages of consecutive rows (see wxVirtualPrefetchPolicy::
+  * SetPageSize()), with 1 GetItemDataBatch() call on the master model per page, and kept in a
+  * LRU cache of pages. Master models which are faster with ranged requests (database queries,
+  * blocks of a file, ...) reimplement GetItemDataBatch().
+  *
+  * The model renderer sends a viewport hint (OnViewportChanged()) each time the visible rows
+  * change. The prefetch policy converts it to a list of pages: the visible pages, the pages ahead
+  * of the scrolling direction (more of them when scrolling fast), and a few pages behind. If
+  * the master model is thread safe (IsThreadSafe()), the pages not in the cache are loaded by a
+  * background thread, in priority order: a new hint cancels the pages not loaded yet. Otherwise
+  * there is no prefetching: only the visible pages are loaded, in the GUI thread, when the hint
+  * is received.
+  * A visible row not in the cache is loaded immediately (its whole page).
+  *
+  * The bottom model must be a list model (AsListModel() not NULL), otherwise the calls are
+  * forwarded to the master model. The rows of a page are consecutive rows of the bottom model:
+  * this model should be the direct parent of it, below the sorting & filtering proxies.
+  * The view shows the rows in the order of the top-most model: while a parent model sorts or
+  * filters the rows (IsReorderingProxy()), the visible rows are spread over many pages, and
+  * loading whole pages for them would be wasteful. The paging and the prefetching are then
+  * disabled: the values are read from the master model, and the hints are ignored. The cached
+  * pages are used again when the sorting & filtering proxies are detached.
+  * The values are copied in the cache: strings are owned by the cache. Other kinds of data
+  * (attributes, flags, ...) are forwarded to the master model.
+  *
+  * The master model must not be modified while the background thread reads it: call
+  * StopPrefetching() before modifying it (the prefetching restarts on the next hint)
+  */
+class WXDLLIMPEXP_VDV wxVirtualPagingDataModel : public wxVirtualIProxyDataModel
+{
+    friend class wxVirtualPagingWorker;
+
+    public:
+        //constructors & destructor
+        wxVirtualPagingDataModel(wxVirtualPrefetchPolicy *pPolicy = WX_VDV_NULL_PTR);       ///< \brief constructor
+        virtual ~wxVirtualPagingDataModel(void);                                            ///< \brief destructor
+
+        //prefetch policy
+        wxVirtualPrefetchPolicy*    GetPrefetchPolicy(void);                                ///< \brief get the prefetch policy
+        void                        SetPrefetchPolicy(wxVirtualPrefetchPolicy *pPolicy);    ///< \brief set the prefetch policy, and takes ownership on it
+        void                        StopPrefetching(void);                                  ///< \brief cancel the prefetching and stop the background thread
+
+        //cache
+        size_t  GetCachedPageCount(void) const;                                             ///< \brief get the maximal amount of cached pages
+        void    SetCachedPageCount(size_t uiPages);                                         ///< \brief set the maximal amount of cached pages
+        void    ClearCache(void);                                                           ///< \brief clear the cached pages
+        bool    IsPageCached(size_t uiPage) const;                                          ///< \brief check if a page is in the cache
+        size_t  GetPrefetchedPageCount(void) const;                                         ///< \brief get the amount of pages loaded ahead of time
+        size_t  GetPageMisses(void) const;                                                  ///< \brief get the amount of pages loaded on demand
+
+        //interface : item data
+        virtual wxVariant GetItemData(const wxVirtualItemID &rID,
+                                      size_t uiField = 0,
+                                      EDataType eType = WX_ITEM_MAIN_DATA);                 ///< \brief get the item data
+        virtual void      GetItemValue(wxVirtualValue &rValue,
+                                       const wxVirtualItemID &rID,
+                                       size_t uiField = 0,
+                                       EDataType eType = WX_ITEM_MAIN_DATA);                ///< \brief get the item data without allocation
+        virtual void      GetItemDataBatch(wxVirtualValues &vValues,
+                                           const wxVirtualItemIDs &vIDs,
+                                           const TFieldIDs &vFields,
+                                           EDataType eType = WX_ITEM_MAIN_DATA);            ///< \brief get the data of several items & fields at once
+        virtual bool      SetItemData(const wxVirtualItemID &rID, size_t uiField,
+                                      const wxVariant &vValue,
+                                      EDataType eType = WX_ITEM_MAIN_DATA);                 ///< \brief set the item data
+
+        //multi-threading
+        virtual bool IsThreadSafe(void);                                                    ///< \brief check if GetItemData() & Compare() can be called from worker threads
+
+        //view hints
+        virtual void OnViewportChanged(const wxVirtualViewportHint &rHint);                 ///< \brief the rows shown by the view changed
+
+    protected:
+        /// \struct TPage : the values of consecutive rows
+        struct TPage
+        {
+            wxVirtualValues     m_vValues;                                                  ///< \brief the values, row by row
+            size_t              m_uiNbRows;                                                 ///< \brief amount of rows in the page
+            size_t              m_uiNbFields;                                               ///< \brief amount of fields per row
+        };
+
+        /// \struct TPageRequest : a page to load
+        struct TPageRequest
+        {
+            size_t              m_uiPage;                                                   ///< \brief index of the page
+            size_t              m_uiFirstRow;                                               ///< \brief 1st row of the page
+            size_t              m_uiNbRows;                                                 ///< \brief amount of rows in the page
+            size_t              m_uiNbFields;                                               ///< \brief amount of fields per row
+            wxVirtualIListDataModel* m_pListModel;                                          ///< \brief the bottom list model
+        };
+
+        /// \struct TLoadedPage : a page loaded by the background thread
+        struct TLoadedPage
+        {
+            size_t              m_uiPage;                                                   ///< \brief index of the page
+            size_t              m_uiGeneration;                                             ///< \brief generation of the cache when the page was requested
+            TPage*              m_pPage;                                                    ///< \brief the page (owned)
+        };
+
+        typedef LRUCache<size_t, TPage,
+                         wxVirtualPageIndexHash, LRUCacheEqual<size_t> >   TPagesCache;    ///< \brief pages cache
+
+        //data : cache (GUI thread)
+        wxVirtualPrefetchPolicy*    m_pPolicy;                                              ///< \brief the prefetch policy (owned)
+        size_t                      m_uiPageSize;                                           ///< \brief amount of rows per page of the cached pages
+        TPagesCache                 m_Pages;                                                ///< \brief the cached pages
+        size_t                      m_uiPageMisses;                                         ///< \brief amount of pages loaded on demand
+        size_t                      m_uiPrefetched;                                         ///< \brief amount of pages loaded ahead of time
+        wxVector<size_t>            m_vHintPages;                                           ///< \brief pages of the last hint
+
+        //data : background loading (protected by m_Mutex)
+        wxVector<TPageRequest>      m_vRequests;                                            ///< \brief pages to load, most urgent first
+        size_t                      m_uiNextRequest;                                        ///< \brief next page to load in m_vRequests
+        wxVector<TLoadedPage>       m_vLoaded;                                              ///< \brief pages loaded, not in the cache yet
+        size_t                      m_uiGeneration;                                         ///< \brief incremented each time the cache is reset
+        bool                        m_bStop;                                                ///< \brief true if the background thread must exit
+        wxVirtualPagingWorker*      m_pWorker;                                              ///< \brief the background thread
+#if wxUSE_THREADS
+        mutable wxMutex             m_Mutex;                                                ///< \brief protects the requests & the loaded pages
+        wxCondition                 m_Condition;                                            ///< \brief wakes up the background thread
+#endif // wxUSE_THREADS
+
+        //methods
+        wxVirtualIListDataModel* GetListModel(void);                                        ///< \brief get the bottom list model, if the paging is possible
+        wxVirtualIListDataModel* GetPagedListModel(void);                                   ///< \brief get the bottom list model, if the paging is enabled
+        bool    HasReorderingParent(void);                                                  ///< \brief check if a parent model sorts or filters the rows
+        void    CheckPageSize(void);                                                        ///< \brief reset the cache if the page size of the policy changed
+        TPage*  FindPage(wxVirtualIListDataModel *pListModel,
+                         size_t uiRow);                                                     ///< \brief get the page of a row, loading it if needed
+        bool    FindValue(wxVirtualValue &rValue, const wxVirtualItemID &rID,
+                          size_t uiField);                                                  ///< \brief get a value from its page
+        bool    MakeRequest(TPageRequest &rRequest, wxVirtualIListDataModel *pListModel,
+                            size_t uiPage);                                                 ///< \brief describe the rows of a page
+        void    LoadPage(TPage &rPage, const TPageRequest &rRequest);                       ///< \brief read the values of a page from the master model
+        void    StorePage(size_t uiPage, const TPage &rPage);                               ///< \brief store a page in the cache
+        void    StoreLoadedPages(void);                                                     ///< \brief store the pages loaded by the background thread
+        bool    StartWorker(void);                                                          ///< \brief start the background thread if needed
+        bool    PopRequest(TPageRequest &rRequest, size_t &uiGeneration);                   ///< \brief get the next page to load (background thread)
+        void    PushPage(const TPageRequest &rRequest, size_t uiGeneration, TPage *pPage);  ///< \brief store a loaded page (background thread)
+        void    CancelLoading(void);                                                        ///< \brief cancel the pages requested to the background thread
+        void    ResetPages(void);                                                           ///< \brief clear the cache, and cancel the loading
+
+        //reaction to the notifications of the master model
+        virtual void OnItemIDsShifted(wxVirtualIListDataModel *pListModel,
+                                      size_t uiFirst, size_t uiCount,
+                                      bool bInserted);                                      ///< \brief the rows of the bottom list model were shifted
+        virtual void OnMasterItemsRemoved(const wxVirtualItemID &rParent,
+                                          size_t uiFirst, size_t uiCount);                  ///< \brief some items were removed from the master model
+        virtual void OnMasterItemsChanged(const wxVirtualItemIDs &vIDs,
+                                          const TFieldIDs &vFields);                        ///< \brief the values of some items of the master model changed
+        virtual void OnMasterChildrenReset(const wxVirtualItemID &rParent);                 ///< \brief the children of an item of the master model changed
+        virtual void OnMasterModelReset(void);                                              ///< \brief the whole master model changed
+
+    private:
+        //forbidden
+        wxVirtualPagingDataModel(const wxVirtualPagingDataModel &rhs);                      ///< \brief copy constructor (forbidden)
+        wxVirtualPagingDataModel& operator=(const wxVirtualPagingDataModel &rhs);           ///< \brief assignation operator (forbidden)
+};
+
+#endif
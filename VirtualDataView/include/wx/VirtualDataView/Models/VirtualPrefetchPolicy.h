@@ -0,0 +1,64 @@
+/**********************************************************************/
+/** FILE    : VirtualPrefetchPolicy.h                                **/
+/** PROJECT : wxVirtualDataViewCtrl                                  **/
+/** LICENSE : wxWindows Library Licence                              **/
+/** PURPOSE : choose the pages of rows to load ahead of the scrolling**/
+/**********************************************************************/
+
+
+#ifndef WX_VIRTUAL_PREFETCH_POLICY_H_
+#define WX_VIRTUAL_PREFETCH_POLICY_H_
+
+#include <wx/VirtualDataView/VirtualDataViewDefs.h>
+#include <wx/VirtualDataView/Models/VirtualViewportHint.h>
+#include <wx/vector.h>
+
+#define WX_VDV_PREFETCH_DEFAULT_PAGE_SIZE   1024                                            ///< \brief default amount of rows per page
+
+/** \class wxVirtualPrefetchPolicy : choose the pages of rows to load for a viewport hint
+  * The rows are grouped in pages of a fixed size. For a viewport, the pages are given in
+  * priority order:
+  *     - the pages of the visible rows
+  *     - the pages ahead of the scrolling direction: a fixed amount (SetPagesAhead()), plus the
+  *       pages scrolled through during the look-ahead time at the current speed
+  *       (SetLookAheadTime()), up to a maximum (SetMaxPagesAhead())
+  *     - the pages behind the visible rows (SetPagesBehind())
+  *
+  * Reimplement GetPages() for other strategies. Used by wxVirtualPagingDataModel
+  */
+class WXDLLIMPEXP_VDV wxVirtualPrefetchPolicy
+{
+    public:
+        //constructors & destructor
+        wxVirtualPrefetchPolicy(size_t uiPageSize = WX_VDV_PREFETCH_DEFAULT_PAGE_SIZE);     ///< \brief constructor
+        virtual ~wxVirtualPrefetchPolicy(void);                                             ///< \brief destructor
+
+        //pages
+        size_t  GetPageSize(void) const;                                                    ///< \brief get the amount of rows per page
+        void    SetPageSize(size_t uiRows);                                                 ///< \brief set the amount of rows per page
+
+        //prefetching
+        size_t  GetPagesAhead(void) const;                                                  ///< \brief get the minimal amount of pages loaded ahead
+        void    SetPagesAhead(size_t uiPages);                                              ///< \brief set the minimal amount of pages loaded ahead
+        size_t  GetMaxPagesAhead(void) const;                                               ///< \brief get the maximal amount of pages loaded ahead
+        void    SetMaxPagesAhead(size_t uiPages);                                           ///< \brief set the maximal amount of pages loaded ahead
+        size_t  GetPagesBehind(void) const;                                                 ///< \brief get the amount of pages kept behind
+        void    SetPagesBehind(size_t uiPages);                                             ///< \brief set the amount of pages kept behind
+        long    GetLookAheadTime(void) const;                                               ///< \brief get the scrolling time covered by the prefetching
+        void    SetLookAheadTime(long lMilliseconds);                                       ///< \brief set the scrolling time covered by the prefetching
+
+        //interface
+        virtual void GetPages(wxVector<size_t> &vPages,
+                              size_t uiFirstRow, size_t uiNbRows,
+                              const wxVirtualViewportHint &rHint) const;                    ///< \brief get the pages to load, most urgent first
+
+    protected:
+        //data
+        size_t      m_uiPageSize;                                                           ///< \brief amount of rows per page
+        size_t      m_uiPagesAhead;                                                         ///< \brief minimal amount of pages loaded ahead
+        size_t      m_uiMaxPagesAhead;                                                      ///< \brief maximal amount of pages loaded ahead
+        size_t      m_uiPagesBehind;                                                        ///< \brief amount of pages kept behind
+        long        m_lLookAheadTime;                                                       ///< \brief scrolling time covered by the prefetching, in ms
+};
+
+#endif
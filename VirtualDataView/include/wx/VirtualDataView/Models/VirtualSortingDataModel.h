@@ -10,6 +10,7 @@
 #define WX_VIRTUAL_SORTING_DATA_MODEL_H_
 
 #include <wx/VirtualDataView/Models/VirtualIArrayProxyDataModel.h>
+#include <wx/VirtualDataView/Types/SortKeys.h>
 
 /** \class wxVirtualSortingDataModel : data model which provides sorting
   * A master data model is provided, and this model acts as a proxy on it.
@@ -23,6 +24,22 @@
   *  In case the amount of items to sort is large, the slow algorithm is even slower because of the O(N.Log(N)) calls to GetItemData().
   *  On the other hand, the memory is used only during the sorting process. Once sorted, the memory is freed (and the results potentially cached)
   *
+  * The fast algorithm first tries to convert all the sorted values to typed keys (see wxSortKeysBuilder), and sorts them
+  * with a stable radix sort: O(N) time, no call to Compare(). This is possible only if:
+  *     - all the values of a sorted field have the same type, which is "long", "bool", "double", "datetime", "string" or "wxBitmapText"
+  *     - the BASE data model does not reimplement Compare() for the sorted fields, and says so by reimplementing
+  *       HasCustomCompare() to return false (the default implementation returns true)
+  * Otherwise, the values are stored as variants and sorted with Compare().
+  *
+  * A parallel algorithm is also available (WX_E_SORTING_PARALLEL): a stable merge sort using several worker threads.
+  * It is used only if the amount of items to sort is large enough (see SetParallelSortingThreshold()). The workers never call
+  * the data models, unless they allow it:
+  *     - if the values can be converted to typed keys, the keys are extracted in the calling thread, and the workers only compare keys
+  *     - otherwise, if the BASE data model IsThreadSafe(), the workers call Compare() directly (same behaviour as the memory efficient sort)
+  *     - otherwise, if the BASE data model does not reimplement Compare() for the sorted fields, the values are read in the calling
+  *       thread (as the fast algorithm), and the workers compare the values without calling the data model
+  *     - otherwise, the fast algorithm is used
+  *
   * To get a custom comparison behaviour, reimplement the following methods in the BASE data model:
   *     virtual ECompareResult  Compare(const wxVirtualItemID &rID1,
   *                                     const wxVirtualItemID &rID2,
@@ -31,6 +48,8 @@
   *                                     const wxVariant &rValue1,
   *                                     const wxVirtualItemID &rID2,
   *                                     const wxVariant &rValue2);      //compare 2 items values
+  *     virtual bool            HasCustomCompare(size_t uiField);       //return true (default)
+  * Reimplement also "virtual bool IsThreadSafe(void);" to allow the parallel sort to call Compare() from worker threads
   */
 class WXDLLIMPEXP_VDV wxVirtualSortingDataModel : public wxVirtualIArrayProxyDataModel
 {
@@ -39,6 +58,14 @@ class WXDLLIMPEXP_VDV wxVirtualSortingDataModel : public wxVirtualIArrayProxyDat
         wxVirtualSortingDataModel(void);                                                    ///< \brief default constructor
         virtual ~wxVirtualSortingDataModel(void);                                           ///< \brief destructor
 
+        /// \enum ESortingMode : sorting algorithm
+        enum ESortingMode
+        {
+            WX_E_SORTING_FAST               = 0,                                            ///< \brief fast sorting, memory hungry
+            WX_E_SORTING_MEMORY_EFFICIENT   = 1,                                            ///< \brief slow sorting, memory efficient
+            WX_E_SORTING_PARALLEL           = 2                                             ///< \brief multi-threaded stable merge sort
+        };
+
         //interface : hierarchy
         virtual size_t          GetChildCount(const wxVirtualItemID &rID);                  ///< \brief get the amount of children
 
@@ -61,20 +88,52 @@ class WXDLLIMPEXP_VDV wxVirtualSortingDataModel : public wxVirtualIArrayProxyDat
         virtual void Sort(const TSortFilters &vSortFilters);                                ///< \brief sort the values
         virtual void ResetSorting(void);                                                    ///< \brief remove all sort filters
 
+        //sorting algorithm
+        void                SetSortingMode(ESortingMode eMode);                             ///< \brief set the sorting algorithm
+        ESortingMode        GetSortingMode(void) const;                                     ///< \brief get the sorting algorithm
+        void                SetWorkerCount(size_t uiWorkers);                               ///< \brief set the amount of threads for parallel sorting
+        size_t              GetWorkerCount(void) const;                                     ///< \brief get the amount of threads for parallel sorting
+        void                SetParallelSortingThreshold(size_t uiThreshold);                ///< \brief set the minimal amount of items for parallel sorting
+        size_t              GetParallelSortingThreshold(void) const;                        ///< \brief get the minimal amount of items for parallel sorting
+
         //methods
         virtual void        SortItems(wxVirtualItemIDs &vIDs);                              ///< \brief sort all the items according to the filter
 
     protected:
         //data
         TSortFilters        m_vSortFilters;                                                 ///< \brief list of sort filters
-        bool                m_bFastSorting;                                                 ///< \brief true for fast sorting, false for memory efficient sorting
+        ESortingMode        m_eSortingMode;                                                 ///< \brief sorting algorithm
+        size_t              m_uiWorkerCount;                                                ///< \brief amount of threads for parallel sorting. 0 = 1 per CPU
+        size_t              m_uiParallelThreshold;                                          ///< \brief minimal amount of items for parallel sorting
 
         //interface
         virtual void            DoGetChildren(wxVirtualItemIDs &vChildren,
                                               const wxVirtualItemID &rIDParent);            ///< \brief get all children
 
+        //partial updates
+        virtual bool            IsAffectedByFields(const TFieldIDs &vFields) const;         ///< \brief check if changing some fields can modify the children arrays
+        virtual bool            DoInsertChildren(wxVirtualItemIDs &vChildren,
+                                                 const wxVirtualItemID &rIDParent,
+                                                 const wxVirtualItemIDs &vNewIDs,
+                                                 TPositions &vPositions);                   ///< \brief insert new items in cached children
+        virtual bool            DoUpdateChildren(wxVirtualItemIDs &vChildren,
+                                                 const wxVirtualItemID &rIDParent,
+                                                 const wxVirtualItemIDs &vChangedIDs,
+                                                 TPositions &vRemoved,
+                                                 TPositions &vInserted);                    ///< \brief re-position changed items in cached children
+
         //methods
         virtual void FastSort(wxVirtualItemIDs &vIDs);                                      ///< \brief fast sorting of the items
+        virtual bool KeysSort(wxVirtualItemIDs &vIDs);                                      ///< \brief sorting of the items using typed keys
+        virtual void VariantsSort(wxVirtualItemIDs &vIDs,
+                                  size_t uiWorkers = 1);                                    ///< \brief sorting of the items using variants
+        virtual void ParallelSort(wxVirtualItemIDs &vIDs);                                  ///< \brief multi-threaded sorting of the items
+
+        //helpers
+        bool ExtractSortKeys(const wxVirtualItemIDs &vIDs,
+                             wxVector<TSortKeys> &vKeys);                                   ///< \brief convert all sorted values to typed keys
+        void ApplyPermutation(wxVirtualItemIDs &vIDs,
+                              const TSortPermutation &vPermutation);                        ///< \brief reorder the items and set their child index
         virtual void MemoryEfficientSort(wxVirtualItemIDs &vIDs);                           ///< \brief memory efficient sorting of the items
 
 
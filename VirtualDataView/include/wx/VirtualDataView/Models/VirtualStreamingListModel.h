@@ -0,0 +1,134 @@
+/**********************************************************************/
+/** FILE    : VirtualStreamingListModel.h                            **/
+/** PROJECT : wxVirtualDataViewCtrl                                  **/
+/** LICENSE : wxWindows Library Licence                              **/
+/** PURPOSE : append-only list data model for live data (logs, ...)  **/
+/**********************************************************************/
+
+
+#ifndef WX_VIRTUAL_STREAMING_LIST_MODEL_H_
+#define WX_VIRTUAL_STREAMING_LIST_MODEL_H_
+
+#include <wx/VirtualDataView/Models/VirtualIListDataModel.h>
+#include <wx/vector.h>
+#include <wx/arrstr.h>
+#if wxUSE_THREADS
+    #include <wx/thread.h>
+#endif // wxUSE_THREADS
+
+#define WX_VDV_STREAMING_CHUNK_ROWS     4096                                                ///< \brief amount of rows in 1 chunk of the storage
+
+class wxVirtualStreamingNotifier;
+
+/** \class wxVirtualStreamingListModel : a list model receiving a continuous flow of new rows
+  * Rows of text fields are appended at the end of the list, from any thread (AppendRow()). They
+  * are not visible immediately: the appended rows are kept in a pending buffer, and published
+  * in the GUI thread at most once per flush interval (default: 16 ms, 1 frame at 60 Hz). Each
+  * publication sends a single ItemsInserted() notification for the whole batch, so the cost of
+  * the proxy models and of the view does not depend on the amount of appends.
+  *
+  * An optional retention limit (SetMaxRowCount()) bounds the amount of rows: the oldest rows
+  * are removed when new ones are published (1 ItemsRemoved() notification per batch).
+  *
+  * The rows are stored in chunks of WX_VDV_STREAMING_CHUNK_ROWS rows: appending never moves the
+  * existing rows, and the chunks freed by the retention limit are recycled. With a retention
+  * limit, the memory used stays steady.
+  *
+  * The published rows are read and modified from the GUI thread only: Flush() and the retention
+  * limit modify the chunks without locking, so the model cannot be read from worker threads
+  * (IsThreadSafe() returns false).
+  * To follow the end of the list in the view, see wxVirtualTreeModelRenderer::SetFollowTail()
+  */
+class WXDLLIMPEXP_VDV wxVirtualStreamingListModel : public wxVirtualIListDataModel
+{
+    friend class wxVirtualStreamingNotifier;
+
+    public:
+        //constructors & destructor
+        wxVirtualStreamingListModel(size_t uiFieldCount = 1);                               ///< \brief constructor
+        virtual ~wxVirtualStreamingListModel(void);                                         ///< \brief destructor
+
+        //fields
+        size_t      GetColumnCount(void) const;                                             ///< \brief get the amount of fields
+        wxString    GetColumnName(size_t uiField) const;                                    ///< \brief get the name of a field
+        void        SetColumnName(size_t uiField, const wxString &sName);                   ///< \brief set the name of a field
+
+        //appending (any thread)
+        void        AppendRow(const wxString &sField);                                      ///< \brief append a row with 1 field
+        void        AppendRow(const wxArrayString &vFields);                                ///< \brief append a row
+        size_t      GetPendingRowCount(void) const;                                         ///< \brief get the amount of rows appended but not published yet
+
+        //publishing (GUI thread)
+        void        Flush(void);                                                            ///< \brief publish the pending rows now
+        void        SetFlushInterval(long lMilliseconds);                                   ///< \brief set the minimal delay between 2 publications
+        long        GetFlushInterval(void) const;                                           ///< \brief get the minimal delay between 2 publications
+        void        Clear(void);                                                            ///< \brief remove all rows
+
+        //retention (GUI thread)
+        void        SetMaxRowCount(size_t uiMaxRows);                                       ///< \brief set the maximal amount of rows kept
+        size_t      GetMaxRowCount(void) const;                                             ///< \brief get the maximal amount of rows kept
+        wxUint64    GetDroppedRowCount(void) const;                                         ///< \brief get the amount of rows removed by the retention limit
+
+        //direct access (GUI thread)
+        const wxString& GetString(size_t uiRow, size_t uiField) const;                      ///< \brief get a field of a published row
+
+        //wxVirtualIListDataModel interface
+        virtual size_t    GetItemCount(void);                                               ///< \brief get amount of items
+        virtual size_t    GetFieldCount(const wxVirtualItemID &rID);                        ///< \brief get the amount of fields in the item
+        virtual wxVariant GetListItemData(size_t uiItemID,
+                                          size_t uiField = 0,
+                                          EDataType eType = WX_ITEM_MAIN_DATA);             ///< \brief get the item data
+        virtual void      GetListItemValue(wxVirtualValue &rValue,
+                                           size_t uiItemID,
+                                           size_t uiField = 0,
+                                           EDataType eType = WX_ITEM_MAIN_DATA);            ///< \brief get the item data without allocation
+        virtual bool      SetListItemData(size_t uiItemID, size_t uiField,
+                                          const wxVariant &vValue,
+                                          EDataType eType = WX_ITEM_MAIN_DATA);             ///< \brief set the item data
+
+        //sorting
+        virtual bool      HasCustomCompare(size_t uiField);                                 ///< \brief check if Compare() is reimplemented for a field
+
+        //multi-threading
+        virtual bool IsThreadSafe(void);                                                    ///< \brief check if GetItemData() & Compare() can be called from worker threads
+
+    protected:
+        typedef wxVector<wxString>  TChunk;                                                 ///< \brief fields of WX_VDV_STREAMING_CHUNK_ROWS rows, row by row
+        typedef wxVector<TChunk*>   TChunks;                                                ///< \brief array of chunks
+
+        //data : fields
+        size_t                      m_uiFieldCount;                                         ///< \brief amount of fields per row
+        wxVector<wxString>          m_vColumnNames;                                         ///< \brief names of the fields
+
+        //data : published rows (GUI thread). Row i is in the chunk (m_uiHeadOffset + i) / WX_VDV_STREAMING_CHUNK_ROWS
+        TChunks                     m_vChunks;                                              ///< \brief the chunks, oldest first
+        TChunk*                     m_pSpareChunk;                                          ///< \brief a released chunk, kept for reuse
+        size_t                      m_uiHeadOffset;                                         ///< \brief index of the 1st row in the 1st chunk
+        size_t                      m_uiRowCount;                                           ///< \brief amount of published rows
+        size_t                      m_uiMaxRows;                                            ///< \brief retention limit (0 = unlimited)
+        wxUint64                    m_uiDroppedRows;                                        ///< \brief amount of rows removed by the retention limit
+
+        //data : pending rows (any thread)
+        wxVector<wxString>          m_vPending;                                             ///< \brief fields of the rows appended but not published
+        bool                        m_bFlushQueued;                                         ///< \brief true if a publication is already requested
+#if wxUSE_THREADS
+        mutable wxCriticalSection   m_PendingLock;                                          ///< \brief protects the pending rows
+#endif // wxUSE_THREADS
+        wxVirtualStreamingNotifier* m_pNotifier;                                            ///< \brief publishes the pending rows in the GUI thread
+
+        //methods
+        void    AppendFields(const wxString *pFields, size_t uiNbFields);                   ///< \brief append the fields of 1 row to the pending rows
+        void    StoreRows(const wxVector<wxString> &vFields, size_t uiFirstRow,
+                          size_t uiNbRows);                                                 ///< \brief store published rows at the end of the chunks
+        void    DropRows(size_t uiNbRows);                                                  ///< \brief remove published rows at the start of the chunks
+        TChunk* NewChunk(void);                                                             ///< \brief get an empty chunk
+        void    ReleaseChunk(TChunk *pChunk);                                               ///< \brief release a chunk which is not used anymore
+        void    ReleaseAllChunks(void);                                                     ///< \brief release all the chunks
+
+    private:
+        //forbidden
+        wxVirtualStreamingListModel(const wxVirtualStreamingListModel &rhs);                ///< \brief copy constructor (forbidden)
+        wxVirtualStreamingListModel& operator=(const wxVirtualStreamingListModel &rhs);     ///< \brief assignation operator (forbidden)
+};
+
+#endif
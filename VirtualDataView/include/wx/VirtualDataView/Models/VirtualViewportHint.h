@@ -0,0 +1,41 @@
+/**********************************************************************/
+/** FILE    : VirtualViewportHint.h                                  **/
+/** PROJECT : wxVirtualDataViewCtrl                                  **/
+/** LICENSE : wxWindows Library Licence                              **/
+/** PURPOSE : description of the rows shown by a view, for models    **/
+/**********************************************************************/
+
+
+#ifndef WX_VIRTUAL_VIEWPORT_HINT_H_
+#define WX_VIRTUAL_VIEWPORT_HINT_H_
+
+#include <wx/VirtualDataView/VirtualItemID.h>
+
+/** \class wxVirtualViewportHint : the rows shown by a view, and how fast it scrolls
+  * Sent by the model renderer to the data model (wxVirtualIDataModel::OnViewportChanged())
+  * each time the visible rows change. Models which are faster with ranged requests (pages
+  * of a database, blocks of a file, ...) use it to load the visible rows in 1 request, and
+  * to prefetch the rows ahead of the scrolling direction (see wxVirtualPrefetchPolicy)
+  *
+  * The ranks are positions in the view (visible items, root included if it is shown)
+  */
+struct wxVirtualViewportHint
+{
+    wxVirtualItemID m_FirstItem;                                                            ///< \brief the 1st visible item
+    size_t          m_uiFirstRank;                                                          ///< \brief rank of the 1st visible item
+    size_t          m_uiRowCount;                                                           ///< \brief amount of rows fitting in the view
+    size_t          m_uiTotalRows;                                                          ///< \brief amount of visible items in the view (scrolling range)
+    double          m_dVelocity;                                                            ///< \brief scrolling speed, in rows per second. Negative when scrolling up
+    int             m_iDirection;                                                           ///< \brief last scrolling direction : 1 down, -1 up, 0 unknown
+
+    wxVirtualViewportHint(void)
+        : m_FirstItem(),
+          m_uiFirstRank(0),
+          m_uiRowCount(0),
+          m_uiTotalRows(0),
+          m_dVelocity(0.0),
+          m_iDirection(0)
+    {}
+};
+
+#endif
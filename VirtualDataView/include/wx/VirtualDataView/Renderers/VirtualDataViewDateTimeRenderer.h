@@ -30,6 +30,11 @@ class WXDLLIMPEXP_VDV wxVirtualDataViewDateTimeRenderer: public wxVirtualDataVie
                             wxVirtualDataViewItemAttr *pAttr,
                             const wxVirtualDataViewItemState &rState,
                             const wxVariant& vValue);                               ///< \brief render the item
+        virtual void RenderValue(wxWindow *pWindow, const wxRect &rRect,
+                                 wxDC &rDC,
+                                 wxVirtualDataViewItemAttr *pAttr,
+                                 const wxVirtualDataViewItemState &rState,
+                                 const wxVirtualValue &rValue);                     ///< \brief render the item from a lightweight value
         virtual wxSize GetSize(wxWindow *pWindow,
                                wxVirtualDataViewItemAttr *pAttr,
                                const wxVirtualDataViewItemState &rState,
@@ -22,6 +22,7 @@ class WXDLLIMPEXP_CORE wxWindow;
 
 class WXDLLIMPEXP_VDV wxVirtualDataViewItemAttr;
 class WXDLLIMPEXP_VDV wxVirtualDataViewItemState;
+class WXDLLIMPEXP_VDV wxVirtualValue;
 
 /** \class wxVirtualDataViewRenderer : a renderer for the wxVirtualDataViewCtrl control
   */
@@ -73,6 +74,11 @@ class WXDLLIMPEXP_VDV wxVirtualDataViewRenderer
                             wxVirtualDataViewItemAttr *pAttr,
                             const wxVirtualDataViewItemState &rState,
                             const wxVariant& vValue)                     = 0;   ///< \brief render the item
+        virtual void RenderValue(wxWindow *pWindow, const wxRect &rRect,
+                                 wxDC &rDC,
+                                 wxVirtualDataViewItemAttr *pAttr,
+                                 const wxVirtualDataViewItemState &rState,
+                                 const wxVirtualValue &rValue);                 ///< \brief render the item from a lightweight value
         virtual wxSize GetSize(wxWindow *pWindow,
                                wxVirtualDataViewItemAttr *pAttr,
                                const wxVirtualDataViewItemState &rState,
@@ -10,6 +10,7 @@
 #define WX_VIRTUAL_DEFAULT_STATE_MODEL_H_
 
 #include <wx/VirtualDataView/StateModels/VirtualIStateModel.h>
+#include <wx/VirtualDataView/StateModels/VirtualVisibleRowIndex.h>
 #include <wx/hashmap.h>
 
 WX_DECLARE_HASH_MAP(wxVirtualItemID, int, wxVirtualItemIDHash, wxVirtualItemIDEqual, THashMapState);
@@ -26,6 +27,8 @@ class WXDLLIMPEXP_VDV wxVirtualDefaultStateModel : public wxVirtualIStateModel
         //parameters
         bool AllowRecursion(void) const;                                                    ///< \brief check if algorithms are allowed to run recursively
         void AllowRecursion(bool bAllow = true);                                            ///< \brief allow/forbid algorithms to run recursively
+        bool UsesVisibleRowIndex(void) const;                                               ///< \brief check if the visible row index is maintained
+        void UseVisibleRowIndex(bool bUse = true);                                          ///< \brief maintain or not the visible row index
 
         //interface
         virtual bool IsEnabled(const wxVirtualItemID &rID) ;                                ///< \brief check if the item is enabled / disabled
@@ -42,7 +45,16 @@ class WXDLLIMPEXP_VDV wxVirtualDefaultStateModel : public wxVirtualIStateModel
         virtual void GetState(wxVirtualDataViewItemState &rState,
                               const wxVirtualItemID &rID);                                  ///< \brief get all states at once
 
+        //visible rows index
+        virtual wxVirtualVisibleRowIndex* GetVisibleRowIndex(wxVirtualIDataModel *pDataModel);  ///< \brief get the visible row index, if any
+
         //callbacks
+        virtual void OnDataModelChanged(wxVirtualIDataModel* pDataModel);                   ///< \brief data model has changed
+        virtual void OnChildrenChanged(const wxVirtualItemID &rParent);                     ///< \brief the children of an item changed
+        virtual void OnItemsInserted(const wxVirtualItemID &rParent,
+                                     size_t uiFirst, size_t uiCount);                       ///< \brief list rows were inserted : shift the states
+        virtual void OnItemsRemoved(const wxVirtualItemID &rParent,
+                                    size_t uiFirst, size_t uiCount);                        ///< \brief list rows were removed : shift the states
         virtual bool DeleteItem(const wxVirtualItemID &rID);                                ///< \brief delete an item
         virtual bool Enable(const wxVirtualItemID &rID, bool bEnable, bool bRecursive);     ///< \brief enable / disable items
         virtual bool Select(const wxVirtualItemID &rID, bool bSelect, bool bRecursive);     ///< \brief select / deselect items
@@ -73,10 +85,13 @@ class WXDLLIMPEXP_VDV wxVirtualDefaultStateModel : public wxVirtualIStateModel
         EStateType                  m_eSelectionType;                                       ///< \brief kind of selection
         wxVirtualItemID             m_FocusedItem;                                          ///< \brief focused item
         bool                        m_bAllowRecursion;                                      ///< \brief allow recursion
+        wxVirtualVisibleRowIndex    m_VisibleRowIndex;                                      ///< \brief order statistic index of visible rows
+        bool                        m_bUseVisibleRowIndex;                                  ///< \brief maintain the visible row index
 
         //methods
         int  GetState(const wxVirtualItemID &rID) const;                                    ///< \brief get the state
         void SetState(const wxVirtualItemID &rID, int iState);                              ///< \brief set the state
+        void ShiftListRows(size_t uiFirst, size_t uiCount, bool bInserted);                 ///< \brief shift the states of list rows
 };
 
 #endif
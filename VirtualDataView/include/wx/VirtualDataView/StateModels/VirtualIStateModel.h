@@ -12,6 +12,7 @@
 #include <wx/VirtualDataView/VirtualItemID.h>
 
 class WXDLLIMPEXP_VDV wxVirtualDataViewItemState;
+class WXDLLIMPEXP_VDV wxVirtualVisibleRowIndex;
 
 /** \class wxVirtualIStateModel : a class for providing item states.
   * Each item has the following states:
@@ -46,6 +47,7 @@ class WXDLLIMPEXP_VDV wxVirtualIStateModel
         virtual size_t GetSelectedItems(wxVirtualItemIDs &vIDs)  = 0;                       ///< \brief get the list of selected items
 
         //get selected/unselected items
+        virtual size_t GetSelectedItemCount(void);                                          ///< \brief get the amount of selected items
         virtual wxVirtualItemID GetFirstSelectedItem(void);                                 ///< \brief get the first selected item
         virtual wxVirtualItemID GetFirstSelectedItem(wxVirtualIDataModel *pDataModel,
                                                      bool bSelected = true);                ///< \brief get the first selected / unselected item
@@ -92,8 +94,16 @@ class WXDLLIMPEXP_VDV wxVirtualIStateModel
         virtual void GetState(wxVirtualDataViewItemState &rState,
                               const wxVirtualItemID &rID);                                  ///< \brief get all states at once
 
+        //visible rows index
+        virtual wxVirtualVisibleRowIndex* GetVisibleRowIndex(wxVirtualIDataModel *pDataModel);  ///< \brief get the visible row index, if any
+
         //callbacks
         virtual void OnDataModelChanged(wxVirtualIDataModel* pDataModel);                   ///< \brief data model has changed
+        virtual void OnChildrenChanged(const wxVirtualItemID &rParent);                     ///< \brief the children of an item changed
+        virtual void OnItemsInserted(const wxVirtualItemID &rParent,
+                                     size_t uiFirst, size_t uiCount);                       ///< \brief rows were inserted in a list : the item IDs were shifted
+        virtual void OnItemsRemoved(const wxVirtualItemID &rParent,
+                                    size_t uiFirst, size_t uiCount);                        ///< \brief rows were removed from a list : the item IDs were shifted
         virtual bool DeleteItem(const wxVirtualItemID &rID);                                ///< \brief delete an item
         virtual bool Enable(const wxVirtualItemID &rID, bool bEnable, bool bRecursive);     ///< \brief enable / disable items
         virtual bool Select(const wxVirtualItemID &rID, bool bSelect, bool bRecursive);     ///< \brief select / deselect items
@@ -11,6 +11,7 @@
 
 #include <wx/VirtualDataView/StateModels/VirtualIStateModel.h>
 #include <wx/VirtualDataView/Types/SizeTHashMap.hpp>
+#include <wx/VirtualDataView/Types/IntervalSet.h>
 
 WX_DECLARE_HASH_MAP(size_t, int, wxSizeTHash, wxSizeTEqual, THashMapListState);
 
@@ -25,6 +26,11 @@ WX_DECLARE_HASH_MAP(size_t, int, wxSizeTHash, wxSizeTEqual, THashMapListState);
   * The state is stored using a hash-map, with key = row index in the list. More memory could be saved if
   * the state was stored in a flat array for example. This would however require explicit synchronisation between
   * data model and state model (for resizing array each time the amount of items change)
+  *
+  * The selection is not stored in the hash-map : it is stored as sorted intervals of row indices
+  * (see wxVirtualIntervalSet). Selecting or deselecting a range of rows costs at most O(k) time
+  * and 1 interval of memory, whatever the size of the range. IsSelected is O(log(k)), k being
+  * the amount of intervals
   */
 class WXDLLIMPEXP_VDV wxVirtualListStateModel : public wxVirtualIStateModel
 {
@@ -37,6 +43,9 @@ class WXDLLIMPEXP_VDV wxVirtualListStateModel : public wxVirtualIStateModel
         wxVirtualItemID GetItemID(size_t uiRowIndex) const;                                 ///< \brief compute an item ID from a row index
         size_t          GetRowIndex(const wxVirtualItemID &rID) const;                      ///< \brief compute the row index from the item ID
 
+        //selection
+        const wxVirtualIntervalSet& GetSelection(void) const;                               ///< \brief get the row indices of the selected items
+
         //interface
         virtual bool IsEnabled(const wxVirtualItemID &rID) ;                                ///< \brief check if the item is enabled / disabled
         virtual bool IsSelected(const wxVirtualItemID &rID);                                ///< \brief check if the item is selected / deselected
@@ -45,6 +54,7 @@ class WXDLLIMPEXP_VDV wxVirtualListStateModel : public wxVirtualIStateModel
         virtual ECheckState GetCheck(const wxVirtualItemID &rID);                           ///< \brief get the check state of the item
         virtual wxVirtualItemID GetFocusedItem(void);                                       ///< \brief get the focused item
         virtual size_t GetSelectedItems(wxVirtualItemIDs &vIDs);                            ///< \brief get the list of selected items
+        virtual size_t GetSelectedItemCount(void);                                          ///< \brief get the amount of selected items
 
         //interface with default implementation
         virtual bool SetState(const wxVirtualDataViewItemState &rState,
@@ -54,6 +64,10 @@ class WXDLLIMPEXP_VDV wxVirtualListStateModel : public wxVirtualIStateModel
 
         //callbacks
         virtual void OnDataModelChanged(wxVirtualIDataModel* pDataModel);                   ///< \brief data model has changed
+        virtual void OnItemsInserted(const wxVirtualItemID &rParent,
+                                     size_t uiFirst, size_t uiCount);                       ///< \brief rows were inserted : shift the states
+        virtual void OnItemsRemoved(const wxVirtualItemID &rParent,
+                                    size_t uiFirst, size_t uiCount);                        ///< \brief rows were removed : shift the states
         virtual bool DeleteItem(const wxVirtualItemID &rID);                                ///< \brief delete an item
         virtual bool Enable(const wxVirtualItemID &rID, bool bEnable, bool bRecursive);     ///< \brief enable / disable items
         virtual bool Select(const wxVirtualItemID &rID, bool bSelect, bool bRecursive);     ///< \brief select / deselect items
@@ -70,7 +84,8 @@ class WXDLLIMPEXP_VDV wxVirtualListStateModel : public wxVirtualIStateModel
     private:
         //data
         wxVirtualIDataModel*        m_pDataModel;                                           ///< \brief the data model
-        THashMapListState           m_MapOfStates;                                          ///< \brief map of states
+        THashMapListState           m_MapOfStates;                                          ///< \brief map of states (selection excluded)
+        wxVirtualIntervalSet        m_Selection;                                            ///< \brief row indices of the selected items
         wxVirtualItemID             m_FocusedItem;                                          ///< \brief focused item
 
         //methods
@@ -80,6 +95,8 @@ class WXDLLIMPEXP_VDV wxVirtualListStateModel : public wxVirtualIStateModel
         int  GetState(size_t uiRow) const;                                                  ///< \brief get the state
         void SetState(const wxVirtualItemID &rID, int iState);                              ///< \brief set the state
         void SetState(size_t uiRow, int iState);                                            ///< \brief set the state
+        size_t GetRowCount(void) const;                                                     ///< \brief get the amount of rows
+        void ShiftRows(size_t uiFirst, size_t uiCount, bool bInserted);                     ///< \brief shift the states after rows were inserted / removed
 };
 
 #endif
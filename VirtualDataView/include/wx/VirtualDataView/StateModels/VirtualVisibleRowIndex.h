@@ -0,0 +1,96 @@
+/**********************************************************************/
+/** FILE    : VirtualVisibleRowIndex.h                               **/
+/** PROJECT : wxVirtualDataViewCtrl                                  **/
+/** LICENSE : wxWindows Library Licence                              **/
+/** PURPOSE : order statistic index of visible rows                  **/
+/**********************************************************************/
+
+
+#ifndef WX_VIRTUAL_VISIBLE_ROW_INDEX_H_
+#define WX_VIRTUAL_VISIBLE_ROW_INDEX_H_
+
+#include <wx/VirtualDataView/VirtualItemID.h>
+#include <wx/hashmap.h>
+#include <wx/vector.h>
+
+class WXDLLIMPEXP_VDV wxVirtualIDataModel;
+class WXDLLIMPEXP_VDV wxVirtualIStateModel;
+struct wxVirtualVisibleRowNode;
+
+WX_DECLARE_HASH_MAP(wxVirtualItemID, wxVirtualVisibleRowNode*, wxVirtualItemIDHash,
+                    wxVirtualItemIDEqual, THashMapVisibleRowNodes);
+
+/** \class wxVirtualVisibleRowIndex : an order statistic index of the visible rows of a tree.
+  * For each expanded node, a Fenwick tree (binary indexed tree) stores the amount of visible
+  * rows contributed by each child (1 for a collapsed child, 1 + size of its visible sub-tree
+  * for an expanded child). This allows:
+  *     - GetSubTreeSize() : O(1) time once the node is indexed
+  *     - GetItemRank()    : O(d.log(k)) time (d = depth of the item, k = amount of siblings)
+  *     - FindItem()       : O(d.log(k)) time
+  *
+  * The index is built lazily: a node is indexed the first time it is needed, which costs
+  * O(k) time (k = amount of children). Afterwards, expanding or collapsing an item costs
+  * O(d.log(k)) time, because only the ancestors of the item are updated.
+  *
+  * An indexed node is always accurate, even if it is collapsed: its size is the amount of visible
+  * rows it would have if expanded. Invariant : if a node is indexed and one of its expanded child
+  * is not, then the child is indexed before being used.
+  *
+  * The index is owned by the state model, which must call:
+  *     - OnExpand() when an item is expanded / collapsed (after updating the state)
+  *     - Clear() when the expansion state changes in an unknown way (recursive expand, reset, ...)
+  *     - OnChildrenChanged() when children are inserted / removed / re-ordered
+  *     - SetDataModel() when the data model changes (this also clears the index)
+  *
+  * The index requires efficient GetChildIndex() and GetParent() methods in the data model.
+  * The default GetChildIndex() is O(k), but the child index is stored in most item IDs.
+  */
+class WXDLLIMPEXP_VDV wxVirtualVisibleRowIndex
+{
+    public:
+        //constructors & destructor
+        wxVirtualVisibleRowIndex(wxVirtualIStateModel *pStateModel);                        ///< \brief constructor
+        ~wxVirtualVisibleRowIndex(void);                                                    ///< \brief destructor
+
+        //models
+        wxVirtualIDataModel* GetDataModel(void) const;                                      ///< \brief get the indexed data model
+        void SetDataModel(wxVirtualIDataModel *pDataModel);                                 ///< \brief set the indexed data model
+        wxVirtualIStateModel* GetStateModel(void) const;                                    ///< \brief get the state model
+        void SetStateModel(wxVirtualIStateModel *pStateModel);                              ///< \brief set the state model
+
+        //maintenance
+        void Clear(void);                                                                   ///< \brief clear the index
+        bool IsEmpty(void) const;                                                           ///< \brief check if the index is empty
+        size_t GetIndexedNodesCount(void) const;                                            ///< \brief get the amount of indexed nodes
+        void OnExpand(const wxVirtualItemID &rID, bool bExpand);                            ///< \brief an item has been expanded / collapsed
+        void OnChildrenChanged(const wxVirtualItemID &rParent);                             ///< \brief the children of an item changed
+
+        //queries
+        size_t          GetSubTreeSize(const wxVirtualItemID &rID);                         ///< \brief get the amount of visible items in a sub-tree
+        bool            GetItemRank(const wxVirtualItemID &rID, size_t &uiRank);            ///< \brief get the rank of a visible item
+        wxVirtualItemID FindItem(size_t uiRank);                                            ///< \brief find a visible item from its rank
+
+    private:
+        //data
+        THashMapVisibleRowNodes m_MapOfNodes;                                               ///< \brief indexed nodes
+        wxVirtualIDataModel*    m_pDataModel;                                               ///< \brief indexed data model
+        wxVirtualIStateModel*   m_pStateModel;                                              ///< \brief state model giving expansion states
+
+        //methods
+        wxVirtualVisibleRowNode* FindNode(const wxVirtualItemID &rID) const;                ///< \brief get an indexed node, without building it
+        wxVirtualVisibleRowNode* GetNode(const wxVirtualItemID &rID);                       ///< \brief get an indexed node, build it if needed
+        wxVirtualVisibleRowNode* BuildNode(const wxVirtualItemID &rID);                     ///< \brief build an indexed node
+        void Propagate(const wxVirtualItemID &rID, size_t uiDelta, bool bIncrease);         ///< \brief propagate a size change to ancestors
+
+        //Fenwick tree helpers
+        static size_t PrefixSum(const wxVirtualVisibleRowNode *pNode, size_t uiCount);      ///< \brief sum of the uiCount first contributions
+        static void   Add(wxVirtualVisibleRowNode *pNode, size_t uiIndex,
+                          size_t uiDelta, bool bIncrease);                                  ///< \brief add / remove a value to one contribution
+        static size_t Search(const wxVirtualVisibleRowNode *pNode, size_t &uiRank);         ///< \brief find the child containing a rank
+
+        //forbidden
+        wxVirtualVisibleRowIndex(const wxVirtualVisibleRowIndex &rhs);                      ///< \brief copy constructor (forbidden)
+        wxVirtualVisibleRowIndex& operator=(const wxVirtualVisibleRowIndex &rhs);           ///< \brief assignation operator (forbidden)
+};
+
+#endif
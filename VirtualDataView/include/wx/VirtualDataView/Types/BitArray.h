@@ -0,0 +1,82 @@
+/**********************************************************************/
+/** FILE    : BitArray.h                                             **/
+/** PROJECT : wxVirtualDataViewCtrl                                  **/
+/** LICENSE : wxWindows Library Licence                              **/
+/** PURPOSE : a compact array of bits                                **/
+/**********************************************************************/
+
+
+#ifndef _VIRTUAL_DATA_VIEW_BIT_ARRAY_H_
+#define _VIRTUAL_DATA_VIEW_BIT_ARRAY_H_
+
+#include <wx/defs.h>
+#include <wx/VirtualDataView/VirtualDataViewDefs.h>
+#include <wx/vector.h>
+
+/** \class wxBitArray : a compact array of bits (1 bit per value)
+  * Used for storing boolean results for large arrays of items (filtering, ...)
+  */
+class WXDLLIMPEXP_VDV wxBitArray
+{
+    public:
+        //constructors & destructor
+        wxBitArray(size_t uiSize = 0, bool bValue = false);                 ///< \brief constructor
+        ~wxBitArray(void);                                                  ///< \brief destructor
+
+        //size
+        void    Resize(size_t uiSize, bool bValue = false);                 ///< \brief resize the array. All bits are reset
+        size_t  GetSize(void) const;                                        ///< \brief get the amount of bits
+        bool    IsEmpty(void) const;                                        ///< \brief check if the array is empty
+        void    Clear(void);                                                ///< \brief release the memory
+
+        //access
+        bool    Get(size_t uiIndex) const;                                  ///< \brief get a bit
+        void    Set(size_t uiIndex, bool bValue = true);                    ///< \brief set a bit
+        void    Reset(size_t uiIndex);                                      ///< \brief reset a bit
+        void    SetAll(bool bValue = true);                                 ///< \brief set all bits
+
+        //operations
+        void    And(const wxBitArray &rhs);                                 ///< \brief bitwise AND with another array of the same size
+        void    Or(const wxBitArray &rhs);                                  ///< \brief bitwise OR with another array of the same size
+        size_t  Count(void) const;                                          ///< \brief count the amount of bits set
+        size_t  FindNext(size_t uiStart) const;                             ///< \brief find the next bit set
+
+    private:
+        //data
+        wxVector<wxUint32>  m_vWords;                                       ///< \brief the bits, 32 per word
+        size_t              m_uiSize;                                       ///< \brief amount of bits
+
+        //methods
+        void    ClearUnusedBits(void);                                      ///< \brief reset the bits after the end of the array
+};
+
+//----------------- INLINE IMPLEMENTATION ---------------------------//
+/** Get a bit
+  * \param uiIndex [input]: the index of the bit. Must be < GetSize()
+  * \return the value of the bit
+  */
+WX_VDV_INLINE bool wxBitArray::Get(size_t uiIndex) const
+{
+    return((m_vWords[uiIndex >> 5] & (wxUint32(1) << (uiIndex & 31))) != 0);
+}
+
+/** Set a bit
+  * \param uiIndex [input]: the index of the bit. Must be < GetSize()
+  * \param bValue  [input]: the new value of the bit
+  */
+WX_VDV_INLINE void wxBitArray::Set(size_t uiIndex, bool bValue)
+{
+    wxUint32 uiMask = wxUint32(1) << (uiIndex & 31);
+    if (bValue) m_vWords[uiIndex >> 5] |= uiMask;
+    else        m_vWords[uiIndex >> 5] &= ~uiMask;
+}
+
+/** Reset a bit
+  * \param uiIndex [input]: the index of the bit. Must be < GetSize()
+  */
+WX_VDV_INLINE void wxBitArray::Reset(size_t uiIndex)
+{
+    m_vWords[uiIndex >> 5] &= ~(wxUint32(1) << (uiIndex & 31));
+}
+
+#endif // _VIRTUAL_DATA_VIEW_BIT_ARRAY_H_
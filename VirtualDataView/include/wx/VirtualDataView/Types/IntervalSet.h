@@ -0,0 +1,128 @@
+/**********************************************************************/
+/** FILE    : IntervalSet.h                                          **/
+/** PROJECT : wxVirtualDataViewCtrl                                  **/
+/** LICENSE : wxWindows Library Licence                              **/
+/** PURPOSE : a set of integers stored as sorted intervals           **/
+/**********************************************************************/
+
+
+#ifndef _VIRTUAL_DATA_VIEW_INTERVAL_SET_H_
+#define _VIRTUAL_DATA_VIEW_INTERVAL_SET_H_
+
+#include <wx/defs.h>
+#include <wx/VirtualDataView/VirtualDataViewDefs.h>
+#include <wx/vector.h>
+
+/** \class wxVirtualIntervalSet : a set of integers, stored as sorted disjoint intervals [first, last]
+  * Used for storing huge selections: selecting N contiguous values costs 1 interval, not N entries.
+  * Let k be the amount of intervals:
+  *     - Contains, FindNext                    : O(log(k))
+  *     - Add / Remove a range                  : O(k) : the intervals are stored in a vector, and the
+  *                                               following intervals are shifted when 1 is inserted or erased
+  *                                               (O(log(k)) when the range extends or shrinks an existing interval)
+  *     - GetCount                              : O(1)
+  *     - InsertRange / EraseRange              : O(k) : the following values are shifted
+  * The values are enumerated one by one with FindNext or with wxVirtualIntervalSet::Iterator,
+  * without building the full list of values
+  */
+class WXDLLIMPEXP_VDV wxVirtualIntervalSet
+{
+    public:
+        //constants
+        static const size_t s_uiNotFound;                                   ///< \brief returned when a value is not found
+
+        /// \struct TInterval : an interval of values, bounds included
+        struct TInterval
+        {
+            size_t  m_uiFirst;                                              ///< \brief first value of the interval
+            size_t  m_uiLast;                                               ///< \brief last value of the interval (included)
+        };
+
+        /// \class Iterator : enumerate the values of the set, in increasing order
+        class WXDLLIMPEXP_VDV Iterator
+        {
+            public:
+                Iterator(const wxVirtualIntervalSet &rSet);                 ///< \brief constructor : start at the first value
+                bool    IsOK(void) const;                                   ///< \brief check if the iterator points to a value
+                size_t  GetValue(void) const;                               ///< \brief get the current value
+                void    Next(void);                                         ///< \brief go to the next value
+
+            private:
+                const wxVirtualIntervalSet& m_rSet;                         ///< \brief the set to enumerate
+                size_t                      m_uiInterval;                   ///< \brief index of the current interval
+                size_t                      m_uiValue;                      ///< \brief the current value
+        };
+
+        //constructors & destructor
+        wxVirtualIntervalSet(void);                                         ///< \brief constructor
+        ~wxVirtualIntervalSet(void);                                        ///< \brief destructor
+
+        //size
+        size_t  GetCount(void) const;                                       ///< \brief get the amount of values in the set
+        bool    IsEmpty(void) const;                                        ///< \brief check if the set is empty
+        void    Clear(void);                                                ///< \brief remove all values & release memory
+
+        //intervals
+        size_t  GetIntervalCount(void) const;                               ///< \brief get the amount of intervals
+        const TInterval& GetInterval(size_t uiIndex) const;                 ///< \brief get an interval
+
+        //access
+        bool    Contains(size_t uiValue) const;                             ///< \brief check if a value is in the set
+        size_t  FindNext(size_t uiStart) const;                             ///< \brief find the first value >= uiStart
+        size_t  FindPrev(size_t uiStart) const;                             ///< \brief find the last value <= uiStart
+        size_t  GetFirst(void) const;                                       ///< \brief get the smallest value
+        size_t  GetLast(void) const;                                        ///< \brief get the largest value
+
+        //modifications
+        void    Add(size_t uiValue);                                        ///< \brief add a value
+        void    Add(size_t uiFirst, size_t uiLast);                         ///< \brief add a range of values
+        void    Remove(size_t uiValue);                                     ///< \brief remove a value
+        void    Remove(size_t uiFirst, size_t uiLast);                      ///< \brief remove a range of values
+        void    Set(size_t uiValue, bool bAdd);                             ///< \brief add or remove a value
+        void    InsertRange(size_t uiFirst, size_t uiCount);                ///< \brief insert values not in the set & shift the following ones
+        void    EraseRange(size_t uiFirst, size_t uiCount);                 ///< \brief erase values & shift the following ones
+
+    private:
+        //data
+        wxVector<TInterval>     m_vIntervals;                               ///< \brief sorted, disjoint & non adjacent intervals
+        size_t                  m_uiCount;                                  ///< \brief amount of values in the set
+
+        //methods
+        size_t  LowerBound(size_t uiValue) const;                           ///< \brief index of the 1st interval with m_uiLast >= uiValue
+};
+
+//----------------- INLINE IMPLEMENTATION ---------------------------//
+/** Get the amount of values in the set
+  * \return the amount of values in the set
+  */
+WX_VDV_INLINE size_t wxVirtualIntervalSet::GetCount(void) const
+{
+    return(m_uiCount);
+}
+
+/** Check if the set is empty
+  * \return true if the set is empty
+  */
+WX_VDV_INLINE bool wxVirtualIntervalSet::IsEmpty(void) const
+{
+    return(m_uiCount == 0);
+}
+
+/** Get the amount of intervals
+  * \return the amount of intervals
+  */
+WX_VDV_INLINE size_t wxVirtualIntervalSet::GetIntervalCount(void) const
+{
+    return(m_vIntervals.size());
+}
+
+/** Get an interval
+  * \param uiIndex [input]: the index of the interval. Must be < GetIntervalCount()
+  * \return the interval
+  */
+WX_VDV_INLINE const wxVirtualIntervalSet::TInterval& wxVirtualIntervalSet::GetInterval(size_t uiIndex) const
+{
+    return(m_vIntervals[uiIndex]);
+}
+
+#endif // _VIRTUAL_DATA_VIEW_INTERVAL_SET_H_
@@ -0,0 +1,117 @@
+/**********************************************************************/
+/** FILE    : SortKeys.h                                             **/
+/** PROJECT : wxVirtualDataViewCtrl                                  **/
+/** LICENSE : wxWindows Library Licence                              **/
+/** PURPOSE : typed sort keys & radix sorting                        **/
+/**********************************************************************/
+
+
+#ifndef _VIRTUAL_DATA_VIEW_SORT_KEYS_H_
+#define _VIRTUAL_DATA_VIEW_SORT_KEYS_H_
+
+#include <wx/defs.h>
+#include <wx/VirtualDataView/VirtualDataViewDefs.h>
+#include <wx/variant.h>
+#include <wx/hashmap.h>
+#include <wx/vector.h>
+
+typedef wxVector<wxUint64>  TSortKeys;                                      ///< \brief array of sort keys
+typedef wxVector<size_t>    TSortPermutation;                               ///< \brief permutation of indices
+
+WX_DECLARE_STRING_HASH_MAP(size_t, THashMapSortKeyStrings);
+
+class WXDLLIMPEXP_VDV wxVirtualValue;
+
+/** \class wxSortKeysBuilder : convert a column of variants to unsigned 64 bits sort keys.
+  * Comparing 2 keys as unsigned integers gives the same result as CompareVariants() on the
+  * original values:
+  *     - "long" & "bool"   : the sign bit is flipped
+  *     - "double"          : IEEE 754 order preserving transform. NaN cannot be converted
+  *     - "datetime"        : milliseconds since epoch, sign bit flipped. Invalid dates cannot be converted
+  *     - "string", "wxBitmapText" (and "wxDataViewIconText") : strings are interned, and the key is
+  *                           the rank of the string in the sorted list of unique strings
+  *
+  * All values of a column must have the same type. Any other type (or a mix of types) cannot be
+  * converted: in this case, Add() or Finish() return false and the caller should fall back to a
+  * comparison based sort.
+  * For descending order, the keys are complemented.
+  */
+class WXDLLIMPEXP_VDV wxSortKeysBuilder
+{
+    public:
+        /// \enum EKeyType : type of keys
+        enum EKeyType
+        {
+            WX_E_KEY_NONE       = 0,                                        ///< \brief no values yet
+            WX_E_KEY_INTEGER    = 1,                                        ///< \brief "long" or "bool"
+            WX_E_KEY_DOUBLE     = 2,                                        ///< \brief "double"
+            WX_E_KEY_DATETIME   = 3,                                        ///< \brief "datetime"
+            WX_E_KEY_STRING     = 4,                                        ///< \brief "string", "wxBitmapText", "wxDataViewIconText"
+            WX_E_KEY_INVALID    = 5                                         ///< \brief conversion failed
+        };
+
+        //constructors & destructor
+        wxSortKeysBuilder(void);                                            ///< \brief default constructor
+        ~wxSortKeysBuilder(void);                                           ///< \brief destructor
+
+        //building
+        void     Start(size_t uiCount, bool bDescending);                   ///< \brief start a new column
+        bool     Add(const wxVariant &rValue);                              ///< \brief add the next value of the column
+        bool     Add(const wxVirtualValue &rValue);                         ///< \brief add the next value of the column
+        bool     Finish(TSortKeys &vKeys);                                  ///< \brief get the keys of the column
+        EKeyType GetKeyType(void) const;                                    ///< \brief get the type of keys
+
+    private:
+        //data
+        TSortKeys               m_vKeys;                                    ///< \brief keys (for strings: index in m_vStrings)
+        wxVector<wxString>      m_vStrings;                                 ///< \brief unique strings
+        THashMapSortKeyStrings  m_MapOfStrings;                             ///< \brief string -> index in m_vStrings
+        size_t                  m_uiTypeID;                                 ///< \brief variant type ID of the column
+        EKeyType                m_eKeyType;                                 ///< \brief type of keys
+        bool                    m_bDescending;                              ///< \brief true for descending order
+
+        //methods
+        EKeyType GetKeyType(size_t uiTypeID) const;                         ///< \brief get the key type of a variant type
+        bool     CheckType(size_t uiTypeID);                                ///< \brief check the type of the next value
+        bool     AddString(const wxString &sValue);                         ///< \brief add a string value
+        void     RankStrings(void);                                         ///< \brief replace string indices by ranks
+};
+
+//--------------------- KEYS CONVERSION -----------------------------//
+wxUint64 wxGetSortKey(wxInt64 iValue);                                      ///< \brief convert a signed integer to an order preserving key
+wxUint64 wxGetSortKey(double dValue);                                       ///< \brief convert a double (not NaN) to an order preserving key
+
+//----------------------- RADIX SORT --------------------------------//
+void wxRadixSortPermutation(const TSortKeys &vKeys,
+                            TSortPermutation &vPermutation);                ///< \brief stable sort of a permutation by keys
+
+//------------------- KEYS COMPARISON -------------------------------//
+/** \struct wxSortKeysLess : compare 2 items by their keys, for several fields
+  * Only reads the keys: it can be used concurrently from several threads
+  */
+struct WXDLLIMPEXP_VDV wxSortKeysLess
+{
+    wxSortKeysLess(const wxVector<TSortKeys> &vKeys) : m_vKeys(vKeys) {}
+
+    /** Compare 2 items
+      * \param ui1 [input]: index of the 1st item
+      * \param ui2 [input]: index of the 2nd item
+      * \return true if item ui1 < item ui2, according to the keys of all fields (1st field first)
+      */
+    WX_VDV_INLINE bool operator()(size_t ui1, size_t ui2) const
+    {
+        size_t uiField, uiNbFields;
+        uiNbFields = m_vKeys.size();
+        for(uiField=0;uiField<uiNbFields;uiField++)
+        {
+            const TSortKeys &rKeys = m_vKeys[uiField];
+            if (rKeys[ui1] < rKeys[ui2]) return(true);
+            if (rKeys[ui1] > rKeys[ui2]) return(false);
+        }
+        return(false);
+    }
+
+    const wxVector<TSortKeys> &m_vKeys;                                     ///< \brief keys of all fields
+};
+
+#endif // _VIRTUAL_DATA_VIEW_SORT_KEYS_H_
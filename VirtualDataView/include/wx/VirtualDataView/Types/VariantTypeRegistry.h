@@ -0,0 +1,260 @@
+/**********************************************************************/
+/** FILE    : VariantTypeRegistry.h                                  **/
+/** PROJECT : wxVirtualDataViewCtrl                                  **/
+/** LICENSE : wxWindows Library Licence                              **/
+/** PURPOSE : integer IDs & functions for wxVariant types            **/
+/**********************************************************************/
+
+
+#ifndef _VIRTUAL_DATA_VIEW_VARIANT_TYPE_REGISTRY_H_
+#define _VIRTUAL_DATA_VIEW_VARIANT_TYPE_REGISTRY_H_
+
+#include <wx/defs.h>
+#include <wx/VirtualDataView/VirtualDataViewDefs.h>
+#include <wx/VirtualDataView/Types/VariantUtils.h>
+#include <wx/variant.h>
+#include <wx/vector.h>
+
+/// \enum EVariantTypeID : the IDs of the predefined types
+enum EVariantTypeID
+{
+    WX_VARIANT_TYPE_NULL                = 0,                                ///< \brief null variant (no data)
+    WX_VARIANT_TYPE_UNKNOWN             = 1,                                ///< \brief type not registered
+    WX_VARIANT_TYPE_STRING              = 2,                                ///< \brief "string"
+    WX_VARIANT_TYPE_LONG                = 3,                                ///< \brief "long"
+    WX_VARIANT_TYPE_DOUBLE              = 4,                                ///< \brief "double"
+    WX_VARIANT_TYPE_BOOL                = 5,                                ///< \brief "bool"
+    WX_VARIANT_TYPE_CHAR                = 6,                                ///< \brief "char"
+    WX_VARIANT_TYPE_DATETIME            = 7,                                ///< \brief "datetime"
+    WX_VARIANT_TYPE_LONGLONG            = 8,                                ///< \brief "longlong"
+    WX_VARIANT_TYPE_ULONGLONG           = 9,                                ///< \brief "ulonglong"
+    WX_VARIANT_TYPE_VOID_PTR            = 10,                               ///< \brief "void*"
+    WX_VARIANT_TYPE_LIST                = 11,                               ///< \brief "list"
+    WX_VARIANT_TYPE_ARRSTRING           = 12,                               ///< \brief "arrstring"
+    WX_VARIANT_TYPE_BITMAP_TEXT         = 13,                               ///< \brief "wxBitmapText"
+    WX_VARIANT_TYPE_DATAVIEW_ICON_TEXT  = 14,                               ///< \brief "wxDataViewIconText"
+    WX_VARIANT_TYPE_BITMAP              = 15,                               ///< \brief "wxBitmap"
+    WX_VARIANT_TYPE_ICON                = 16,                               ///< \brief "wxIcon"
+    WX_VARIANT_TYPE_IMAGE               = 17,                               ///< \brief "wxImage"
+    WX_VARIANT_TYPE_COLOUR              = 18,                               ///< \brief "wxColour"
+    WX_VARIANT_TYPE_FIRST_CUSTOM        = 19                                ///< \brief 1st ID given to custom types
+};
+
+/** \class wxVariantTypeRegistry : maps the wxVariant types to small integer IDs, and dispatches
+  * the comparison, string conversion, numeric conversion & hashing of the values through
+  * a table of functions indexed by these IDs.
+  *
+  * wxVariant::GetType() builds a wxString for each call, and the type names were compared as
+  * strings for each value. GetTypeID() calls GetType() only once per wxVariantData class:
+  * the class is identified by the virtual table pointer of the data (wxNO_RTTI forbids typeid),
+  * and the result is stored in a small cache.
+  *
+  * Custom types can be registered with RegisterType(), or have their functions replaced.
+  * Registration must be done from the main thread, before the values are used from worker threads.
+  * GetTypeID() can be called from any thread. The class cache is never modified once published:
+  * a miss builds a copy with the new class under the lock, and publishes it with a release store.
+  * The readers load the current copy with an acquire load, without lock.
+  */
+class WXDLLIMPEXP_VDV wxVariantTypeRegistry
+{
+    public:
+        //function types
+        typedef EVariantComparison (*TCompareFunction)(const wxVariant &rValue1,
+                                                       const wxVariant &rValue2);  ///< \brief compare 2 values of the type
+        typedef wxString (*TToStringFunction)(const wxVariant &rValue);             ///< \brief convert a value to a string
+        typedef bool (*TToDoubleFunction)(const wxVariant &rValue, double &rdResult);///< \brief convert a value to a number
+        typedef unsigned long (*THashFunction)(const wxVariant &rValue);            ///< \brief hash a value
+
+        /// \struct TTypeFunctions : the functions of 1 type. Each function can be NULL
+        struct TTypeFunctions
+        {
+            TCompareFunction    m_pCompare;                                 ///< \brief comparison. NULL : values cannot be compared
+            TToStringFunction   m_pToString;                                ///< \brief string conversion. NULL : wxVariant::GetString()
+            TToDoubleFunction   m_pToDouble;                                ///< \brief numeric conversion. NULL : the type is not numeric
+            THashFunction       m_pHash;                                    ///< \brief hashing. NULL : hash of the string conversion
+
+            TTypeFunctions(void)
+                : m_pCompare(WX_VDV_NULL_PTR), m_pToString(WX_VDV_NULL_PTR),
+                  m_pToDouble(WX_VDV_NULL_PTR), m_pHash(WX_VDV_NULL_PTR) {}
+        };
+
+        //type IDs
+        static size_t GetTypeID(const wxVariant &rValue);                   ///< \brief get the type ID of a value
+        static size_t GetTypeID(const wxString &sType);                     ///< \brief get the type ID of a type name
+        static wxString GetTypeName(size_t uiTypeID);                       ///< \brief get the name of a type
+        static size_t GetTypeCount(void);                                   ///< \brief get the amount of registered types
+
+        //registration
+        static size_t RegisterType(const wxString &sType,
+                                   const TTypeFunctions &rFunctions);       ///< \brief register a type or replace its functions
+        static const TTypeFunctions& GetTypeFunctions(size_t uiTypeID);     ///< \brief get the functions of a type
+
+        //dispatch
+        static bool IsNumeric(size_t uiTypeID);                             ///< \brief check if a type can be converted to a number
+        static EVariantComparison Compare(size_t uiTypeID,
+                                          const wxVariant &rValue1,
+                                          const wxVariant &rValue2);        ///< \brief compare 2 values
+        static wxString ToString(size_t uiTypeID, const wxVariant &rValue); ///< \brief convert a value to a string
+        static bool ToDouble(size_t uiTypeID, const wxVariant &rValue,
+                             double &rdResult);                             ///< \brief convert a value to a number
+        static unsigned long Hash(size_t uiTypeID, const wxVariant &rValue);///< \brief hash a value
+
+    private:
+        /// \struct TTypeEntry : a registered type
+        struct TTypeEntry
+        {
+            wxString        m_sName;                                        ///< \brief the type name (wxVariant::GetType())
+            TTypeFunctions  m_Functions;                                    ///< \brief the functions of the type
+        };
+
+        /// \struct TClassEntry : an entry of the class cache
+        struct TClassEntry
+        {
+            const void*     m_pClass;                                       ///< \brief the virtual table of a wxVariantData class
+            size_t          m_uiTypeID;                                     ///< \brief the type ID of this class
+        };
+
+        enum
+        {
+            WX_CLASS_CACHE_SIZE = 64                                        ///< \brief maximal amount of classes in the cache
+        };
+
+        /// \struct TClassTable : a published class cache. Never modified once published
+        struct TClassTable
+        {
+            size_t          m_uiCount;                                      ///< \brief amount of entries
+            TClassEntry     m_vEntries[WX_CLASS_CACHE_SIZE];                ///< \brief the entries
+        };
+
+        //data
+        static wxVector<TTypeEntry> ms_vTypes;                              ///< \brief registered types, indexed by ID
+        static TClassTable          ms_EmptyClasses;                        ///< \brief empty class cache
+        static TClassTable*         ms_pClasses;                            ///< \brief current class cache
+        static bool                 ms_bInitialized;                        ///< \brief true if the predefined types are registered
+
+        //methods
+        static void Initialize(void);                                       ///< \brief register the predefined types
+        static size_t FindTypeID(const wxString &sType);                    ///< \brief find a type by name
+        static size_t GetTypeIDSlow(const wxVariantData *pData,
+                                    const void *pClass);                    ///< \brief get a type ID & fill the class cache
+        static const void* GetClassKey(const wxVariantData *pData);         ///< \brief identify the class of the data
+        static const TClassTable* LoadClassTable(void);                     ///< \brief get the current class cache
+        static const TClassTable* LoadClassTableLocked(void);               ///< \brief get the current class cache, with lock
+        static void PublishClassTable(TClassTable *pTable);                 ///< \brief replace the current class cache
+        static void ReleaseClassTables(void);                               ///< \brief release all the class caches
+
+        friend class wxVariantTypeRegistryInitializer;
+};
+
+//----------------- INLINE IMPLEMENTATION ---------------------------//
+/** Identify the class of a variant data
+  * The 1st word of a polymorphic object is its virtual table pointer: it is shared by all the
+  * objects of the same class, and it differs between classes
+  * \param pData [input]: the data. Must not be NULL
+  * \return a key identifying the class
+  */
+WX_VDV_INLINE const void* wxVariantTypeRegistry::GetClassKey(const wxVariantData *pData)
+{
+    return(*reinterpret_cast<const void* const*>(pData));
+}
+
+/** Get the current class cache (acquire load)
+  * \return the current class cache. Never NULL
+  */
+WX_VDV_INLINE const wxVariantTypeRegistry::TClassTable* wxVariantTypeRegistry::LoadClassTable(void)
+{
+#if wxUSE_THREADS == 0
+    return(ms_pClasses);
+#elif defined(__clang__) || (defined(__GNUC__) && ((__GNUC__ > 4) || ((__GNUC__ == 4) && (__GNUC_MINOR__ >= 7))))
+    return(__atomic_load_n(&ms_pClasses, __ATOMIC_ACQUIRE));
+#elif defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
+    //volatile accesses have acquire / release semantics on x86 & x64 (/volatile:ms)
+    return(*static_cast<TClassTable* volatile*>(&ms_pClasses));
+#else
+    return(LoadClassTableLocked());
+#endif
+}
+
+/** Get the type ID of a value
+  * \param rValue [input]: the value
+  * \return the type ID. WX_VARIANT_TYPE_NULL for a null variant, WX_VARIANT_TYPE_UNKNOWN
+  *         if its type is not registered
+  */
+WX_VDV_INLINE size_t wxVariantTypeRegistry::GetTypeID(const wxVariant &rValue)
+{
+    const wxVariantData *pData = rValue.GetData();
+    if (!pData) return(WX_VARIANT_TYPE_NULL);
+
+    const void *pClass = GetClassKey(pData);
+    const TClassTable *pTable = LoadClassTable();
+    size_t i, uiCount;
+    uiCount = pTable->m_uiCount;
+    for(i=0;i<uiCount;i++)
+    {
+        if (pTable->m_vEntries[i].m_pClass == pClass) return(pTable->m_vEntries[i].m_uiTypeID);
+    }
+    return(GetTypeIDSlow(pData, pClass));
+}
+
+/** Get the functions of a type
+  * \param uiTypeID [input]: the type ID, from GetTypeID()
+  * \return the functions of the type
+  */
+WX_VDV_INLINE const wxVariantTypeRegistry::TTypeFunctions& wxVariantTypeRegistry::GetTypeFunctions(size_t uiTypeID)
+{
+    if (!ms_bInitialized) GetTypeCount();
+    if (uiTypeID >= ms_vTypes.size()) uiTypeID = WX_VARIANT_TYPE_UNKNOWN;
+    return(ms_vTypes[uiTypeID].m_Functions);
+}
+
+/** Check if a type can be converted to a number
+  * \param uiTypeID [input]: the type ID, from GetTypeID()
+  * \return true if the type is numeric
+  */
+WX_VDV_INLINE bool wxVariantTypeRegistry::IsNumeric(size_t uiTypeID)
+{
+    return(GetTypeFunctions(uiTypeID).m_pToDouble != WX_VDV_NULL_PTR);
+}
+
+/** Compare 2 values
+  * \param uiTypeID [input]: the type ID of the values, from GetTypeID()
+  * \param rValue1  [input]: the 1st value
+  * \param rValue2  [input]: the 2nd value
+  * \return the result of the comparison. WX_VARIANT_CANNOT_COMPARE if the type has no comparison function
+  */
+WX_VDV_INLINE EVariantComparison wxVariantTypeRegistry::Compare(size_t uiTypeID,
+                                                                const wxVariant &rValue1,
+                                                                const wxVariant &rValue2)
+{
+    TCompareFunction pCompare = GetTypeFunctions(uiTypeID).m_pCompare;
+    if (!pCompare) return(WX_VARIANT_CANNOT_COMPARE);
+    return(pCompare(rValue1, rValue2));
+}
+
+/** Convert a value to a string
+  * \param uiTypeID [input]: the type ID of the value, from GetTypeID()
+  * \param rValue   [input]: the value
+  * \return the value as a string
+  */
+WX_VDV_INLINE wxString wxVariantTypeRegistry::ToString(size_t uiTypeID, const wxVariant &rValue)
+{
+    TToStringFunction pToString = GetTypeFunctions(uiTypeID).m_pToString;
+    if (!pToString) return(rValue.GetString());
+    return(pToString(rValue));
+}
+
+/** Convert a value to a number
+  * \param uiTypeID [input] : the type ID of the value, from GetTypeID()
+  * \param rValue   [input] : the value
+  * \param rdResult [output]: the value as a number
+  * \return true on success, false if the type is not numeric
+  */
+WX_VDV_INLINE bool wxVariantTypeRegistry::ToDouble(size_t uiTypeID, const wxVariant &rValue,
+                                                   double &rdResult)
+{
+    TToDoubleFunction pToDouble = GetTypeFunctions(uiTypeID).m_pToDouble;
+    if (!pToDouble) return(false);
+    return(pToDouble(rValue, rdResult));
+}
+
+#endif //_VIRTUAL_DATA_VIEW_VARIANT_TYPE_REGISTRY_H_
@@ -17,6 +17,8 @@
 
 //----------------------- CONVERSION --------------------------------//
 wxString GetStringValue(const wxVariant &rvValue);                          ///< \brief convert a variant to string
+bool     IsNumericType(const wxVariant &rvValue);                           ///< \brief check if a variant can be converted to a number
+bool     IsNumericType(const wxString &sType);                              ///< \brief check if a variant type can be converted to a number
 
 template<typename T>
 T wxGetVariantValueAs(const wxVariant &rvValue);                            ///< \brief convert variant
@@ -38,11 +40,15 @@ int                 IsVariantLessThan(const wxVariant &vValue1,
                                       bool bAssumeSameType = true);          ///< \brief return true if vValue1 < vValue2
 
 //--------------------- HASHING -------------------------------------//
+unsigned long       GetVariantHash(const wxVariant &vValue);                ///< \brief hash a variant
+bool                AreVariantsEqual(const wxVariant &vValue1,
+                                     const wxVariant &vValue2);             ///< \brief return true if vValue1 == vValue2
+
 struct WXDLLIMPEXP_VDV wxVariantHash
 {
     wxVariantHash() { }
-    unsigned long operator()( wxVariant x ) const
-    { return wxStringHash::stringHash(GetStringValue(x).wx_str()); }
+    unsigned long operator()( const wxVariant &x ) const
+    { return GetVariantHash(x); }
 
     wxVariantHash& operator=(const wxVariantHash&) { return *this; }
 };
@@ -50,18 +56,8 @@ struct WXDLLIMPEXP_VDV wxVariantHash
 struct WXDLLIMPEXP_VDV wxVariantEqual
 {
     wxVariantEqual() { }
-    bool operator()( wxVariant a, wxVariant b ) const
-    {
-        EVariantComparison eRes = CompareVariants(a, b);
-        if (eRes == WX_VARIANT_CANNOT_COMPARE)
-        {
-            wxString s1 = GetStringValue(a);
-            wxString s2 = GetStringValue(b);
-            return(s1 == s2);
-        }
-        if (eRes == WX_VARIANT_EQUAL) return(true);
-        return(false);
-    }
+    bool operator()( const wxVariant &a, const wxVariant &b ) const
+    { return AreVariantsEqual(a, b); }
 
     wxVariantEqual& operator=(const wxVariantEqual&) { return *this; }
 };
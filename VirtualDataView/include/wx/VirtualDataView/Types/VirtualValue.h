@@ -0,0 +1,274 @@
+/**********************************************************************/
+/** FILE    : VirtualValue.h                                         **/
+/** PROJECT : wxVirtualDataViewCtrl                                  **/
+/** LICENSE : wxWindows Library Licence                              **/
+/** PURPOSE : a lightweight tagged value                             **/
+/**********************************************************************/
+
+
+#ifndef _VIRTUAL_DATA_VIEW_VALUE_H_
+#define _VIRTUAL_DATA_VIEW_VALUE_H_
+
+#include <wx/defs.h>
+#include <wx/VirtualDataView/VirtualDataViewDefs.h>
+#include <wx/VirtualDataView/Types/VariantUtils.h>
+#include <wx/variant.h>
+#include <wx/string.h>
+#include <wx/vector.h>
+#if wxUSE_DATETIME
+    #include <wx/datetime.h>
+#endif // wxUSE_DATETIME
+
+/** \class wxVirtualValue : a lightweight tagged value, for reading item data without heap allocation.
+  *
+  * wxVirtualIDataModel::GetItemData() returns a wxVariant, which allocates a wxVariantData for
+  * each value. wxVirtualIDataModel::GetItemValue() fills a wxVirtualValue instead:
+  *     - integers, doubles, booleans & date/times are stored inline
+  *     - strings are stored as a reference to a wxString owned by the model. The reference must
+  *       stay valid until the model is modified: it is not copied
+  *     - any other type is stored as a wxVariant
+  *
+  * The default wxVirtualIDataModel::GetItemValue() wraps the result of GetItemData() : models
+  * which do not reimplement it keep working unchanged.
+  */
+class WXDLLIMPEXP_VDV wxVirtualValue
+{
+    public:
+        /// \enum EType : the type of the value
+        enum EType
+        {
+            WX_VALUE_NULL       = 0,                                        ///< \brief no value
+            WX_VALUE_INT64      = 1,                                        ///< \brief signed 64 bits integer
+            WX_VALUE_DOUBLE     = 2,                                        ///< \brief double
+            WX_VALUE_BOOL       = 3,                                        ///< \brief boolean
+            WX_VALUE_DATETIME   = 4,                                        ///< \brief date/time (milliseconds since epoch)
+            WX_VALUE_STRING     = 5,                                        ///< \brief reference to a string owned by the model
+            WX_VALUE_VARIANT    = 6                                         ///< \brief any other type, stored in a wxVariant
+        };
+
+        //constructors & destructor
+        wxVirtualValue(void);                                               ///< \brief default constructor
+        ~wxVirtualValue(void);                                              ///< \brief destructor
+
+        //type
+        EType GetType(void) const;                                          ///< \brief get the type of the value
+        bool  IsNull(void) const;                                           ///< \brief check if there is no value
+        bool  IsVariant(void) const;                                        ///< \brief check if the value is stored in a wxVariant
+        bool  IsNumeric(void) const;                                        ///< \brief check if the value is an integer, a double or a boolean
+
+        //setters
+        void SetNull(void);                                                 ///< \brief clear the value
+        void SetInt64(wxInt64 iValue);                                      ///< \brief set an integer value
+        void SetDouble(double dValue);                                      ///< \brief set a double value
+        void SetBool(bool bValue);                                          ///< \brief set a boolean value
+#if wxUSE_DATETIME
+        void SetDateTime(const wxDateTime &rValue);                         ///< \brief set a date/time value
+#endif // wxUSE_DATETIME
+        void SetString(const wxString &rsValue);                            ///< \brief set a string value (by reference)
+        void SetVariant(const wxVariant &rvValue);                          ///< \brief set any other value
+
+        //getters
+        wxInt64          GetInt64(void) const;                              ///< \brief get the integer value
+        double           GetDouble(void) const;                             ///< \brief get the double value
+        bool             GetBool(void) const;                               ///< \brief get the boolean value
+#if wxUSE_DATETIME
+        wxDateTime       GetDateTime(void) const;                           ///< \brief get the date/time value
+#endif // wxUSE_DATETIME
+        const wxString&  GetStringRef(void) const;                          ///< \brief get the referenced string
+        const wxVariant& GetVariant(void) const;                            ///< \brief get the wxVariant value
+
+        //conversions
+        bool      ToInt64(wxInt64 &rResult) const;                          ///< \brief convert to an integer
+        bool      ToDouble(double &rResult) const;                          ///< \brief convert to a double
+        wxString  GetString(void) const;                                    ///< \brief convert to a string
+        wxVariant ToVariant(void) const;                                    ///< \brief convert to a wxVariant
+
+        //comparison
+        EVariantComparison Compare(const wxVirtualValue &rhs) const;        ///< \brief compare 2 values
+
+    private:
+        //data
+        EType               m_eType;                                        ///< \brief the type of the value
+        union
+        {
+            wxInt64         m_iValue;                                       ///< \brief integer & date/time values
+            double          m_dValue;                                       ///< \brief double value
+            bool            m_bValue;                                       ///< \brief boolean value
+            const wxString* m_pString;                                      ///< \brief string value (not owned)
+        };
+        wxVariant           m_vValue;                                       ///< \brief variant value
+};
+
+typedef wxVector<wxVirtualValue> wxVirtualValues;
+
+//----------------- INLINE IMPLEMENTATION ---------------------------//
+/** Default constructor
+  */
+WX_VDV_INLINE wxVirtualValue::wxVirtualValue(void)
+    : m_eType(WX_VALUE_NULL), m_iValue(0)
+{
+}
+
+/** Destructor
+  */
+WX_VDV_INLINE wxVirtualValue::~wxVirtualValue(void)
+{
+}
+
+/** Get the type of the value
+  * \return the type of the value
+  */
+WX_VDV_INLINE wxVirtualValue::EType wxVirtualValue::GetType(void) const
+{
+    return(m_eType);
+}
+
+/** Check if there is no value
+  * \return true if there is no value
+  */
+WX_VDV_INLINE bool wxVirtualValue::IsNull(void) const
+{
+    if (m_eType == WX_VALUE_NULL) return(true);
+    if (m_eType == WX_VALUE_VARIANT) return(m_vValue.IsNull());
+    return(false);
+}
+
+/** Check if the value is stored in a wxVariant
+  * \return true if the value is stored in a wxVariant
+  */
+WX_VDV_INLINE bool wxVirtualValue::IsVariant(void) const
+{
+    return(m_eType == WX_VALUE_VARIANT);
+}
+
+/** Check if the value is an integer, a double or a boolean
+  * \return true if the value is stored inline as a number
+  */
+WX_VDV_INLINE bool wxVirtualValue::IsNumeric(void) const
+{
+    switch(m_eType)
+    {
+        case WX_VALUE_INT64     :
+        case WX_VALUE_DOUBLE    :
+        case WX_VALUE_BOOL      : return(true);
+        default                 : break;
+    }
+    return(false);
+}
+
+/** Clear the value
+  */
+WX_VDV_INLINE void wxVirtualValue::SetNull(void)
+{
+    m_eType  = WX_VALUE_NULL;
+    m_iValue = 0;
+    if (!m_vValue.IsNull()) m_vValue.MakeNull();
+}
+
+/** Set an integer value
+  * \param iValue [input]: the new value
+  */
+WX_VDV_INLINE void wxVirtualValue::SetInt64(wxInt64 iValue)
+{
+    m_eType  = WX_VALUE_INT64;
+    m_iValue = iValue;
+}
+
+/** Set a double value
+  * \param dValue [input]: the new value
+  */
+WX_VDV_INLINE void wxVirtualValue::SetDouble(double dValue)
+{
+    m_eType  = WX_VALUE_DOUBLE;
+    m_dValue = dValue;
+}
+
+/** Set a boolean value
+  * \param bValue [input]: the new value
+  */
+WX_VDV_INLINE void wxVirtualValue::SetBool(bool bValue)
+{
+    m_eType  = WX_VALUE_BOOL;
+    m_bValue = bValue;
+}
+
+#if wxUSE_DATETIME
+/** Set a date/time value
+  * \param rValue [input]: the new value
+  */
+WX_VDV_INLINE void wxVirtualValue::SetDateTime(const wxDateTime &rValue)
+{
+    m_eType  = WX_VALUE_DATETIME;
+    m_iValue = rValue.GetValue().GetValue();
+}
+#endif // wxUSE_DATETIME
+
+/** Set a string value. The string is not copied
+  * \param rsValue [input]: the new value. It must stay valid as long as this object is used
+  */
+WX_VDV_INLINE void wxVirtualValue::SetString(const wxString &rsValue)
+{
+    m_eType   = WX_VALUE_STRING;
+    m_pString = &rsValue;
+}
+
+/** Set any other value
+  * \param rvValue [input]: the new value
+  */
+WX_VDV_INLINE void wxVirtualValue::SetVariant(const wxVariant &rvValue)
+{
+    m_eType  = WX_VALUE_VARIANT;
+    m_vValue = rvValue;
+}
+
+/** Get the integer value
+  * \return the integer value. Valid only for WX_VALUE_INT64
+  */
+WX_VDV_INLINE wxInt64 wxVirtualValue::GetInt64(void) const
+{
+    return(m_iValue);
+}
+
+/** Get the double value
+  * \return the double value. Valid only for WX_VALUE_DOUBLE
+  */
+WX_VDV_INLINE double wxVirtualValue::GetDouble(void) const
+{
+    return(m_dValue);
+}
+
+/** Get the boolean value
+  * \return the boolean value. Valid only for WX_VALUE_BOOL
+  */
+WX_VDV_INLINE bool wxVirtualValue::GetBool(void) const
+{
+    return(m_bValue);
+}
+
+#if wxUSE_DATETIME
+/** Get the date/time value
+  * \return the date/time value. Valid only for WX_VALUE_DATETIME
+  */
+WX_VDV_INLINE wxDateTime wxVirtualValue::GetDateTime(void) const
+{
+    return(wxDateTime(wxLongLong(m_iValue)));
+}
+#endif // wxUSE_DATETIME
+
+/** Get the referenced string
+  * \return the referenced string. Valid only for WX_VALUE_STRING
+  */
+WX_VDV_INLINE const wxString& wxVirtualValue::GetStringRef(void) const
+{
+    return(*m_pString);
+}
+
+/** Get the wxVariant value
+  * \return the wxVariant value. Valid only for WX_VALUE_VARIANT
+  */
+WX_VDV_INLINE const wxVariant& wxVirtualValue::GetVariant(void) const
+{
+    return(m_vValue);
+}
+
+#endif // _VIRTUAL_DATA_VIEW_VALUE_H_
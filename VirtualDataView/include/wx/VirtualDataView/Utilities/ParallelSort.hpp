@@ -0,0 +1,201 @@
+/**********************************************************************/
+/** FILE    : ParallelSort.hpp                                       **/
+/** PROJECT : wxVirtualDataViewCtrl                                  **/
+/** LICENSE : wxWindows Library Licence                              **/
+/** PURPOSE : stable parallel merge sort                             **/
+/**********************************************************************/
+
+
+#ifndef WX_VIRTUAL_PARALLEL_SORT_HPP_
+#define WX_VIRTUAL_PARALLEL_SORT_HPP_
+
+#include <wx/defs.h>
+#include <wx/VirtualDataView/VirtualDataViewDefs.h>
+#include <wx/vector.h>
+#if wxUSE_THREADS
+    #include <wx/thread.h>
+#endif // wxUSE_THREADS
+#include <algorithm>
+
+#define WX_PARALLEL_SORT_MIN_CHUNK      4096                        ///< \brief minimal amount of items sorted by 1 worker
+
+//---------------------- UTILITIES METHODS --------------------------//
+size_t wxGetParallelSortWorkerCount(size_t uiWorkers);              ///< \brief get the effective amount of workers
+
+template<typename T, typename TCompare>
+void wxParallelStableSort(T *pBegin, T *pEnd, TCompare oCmp,
+                          size_t uiWorkers);                        ///< \brief stable sort using several threads
+
+//------------------------- SORTING JOB -----------------------------//
+/** \class wxParallelSortJob : 1 chunk of work of wxParallelStableSort
+  * If m_pOutput is NULL, the range [m_pBegin, m_pEnd) is sorted in place (std::stable_sort)
+  * Otherwise, the sorted ranges [m_pBegin, m_pMiddle) and [m_pMiddle, m_pEnd) are merged
+  * into m_pOutput (std::merge, which is stable: on ties, the 1st range comes first)
+  *
+  * The job runs in a joinable thread, or in the calling thread if threads are not available
+  */
+template<typename T, typename TCompare>
+class wxParallelSortJob
+#if wxUSE_THREADS
+    : public wxThread
+#endif // wxUSE_THREADS
+{
+    public:
+        //constructor
+        wxParallelSortJob(T *pBegin, T *pMiddle, T *pEnd, T *pOutput, TCompare oCmp)
+#if wxUSE_THREADS
+            : wxThread(wxTHREAD_JOINABLE),
+              m_pBegin(pBegin),
+#else
+            : m_pBegin(pBegin),
+#endif // wxUSE_THREADS
+              m_pMiddle(pMiddle),
+              m_pEnd(pEnd),
+              m_pOutput(pOutput),
+              m_Cmp(oCmp)
+        {}
+
+        /** Do the job in the calling thread
+          */
+        void Execute(void)
+        {
+            if (!m_pOutput) std::stable_sort(m_pBegin, m_pEnd, m_Cmp);
+            else            std::merge(m_pBegin, m_pMiddle, m_pMiddle, m_pEnd, m_pOutput, m_Cmp);
+        }
+
+    protected:
+        //data
+        T*          m_pBegin;                                       ///< \brief start of the range
+        T*          m_pMiddle;                                      ///< \brief end of the 1st sorted range (merge only)
+        T*          m_pEnd;                                         ///< \brief end of the range
+        T*          m_pOutput;                                      ///< \brief merge output. NULL for sorting
+        TCompare    m_Cmp;                                          ///< \brief comparison functor
+
+#if wxUSE_THREADS
+        /** Thread entry point
+          */
+        virtual ExitCode Entry(void)
+        {
+            Execute();
+            return(0);
+        }
+#endif // wxUSE_THREADS
+};
+
+/** Run all jobs and wait for them. The 1st job is executed in the calling thread.
+  * If a thread cannot be started, its job is executed in the calling thread.
+  * \param vJobs [input]: the jobs to run. The jobs are deleted
+  */
+template<typename TJob>
+void wxRunParallelSortJobs(wxVector<TJob*> &vJobs)
+{
+    size_t i, uiSize;
+    uiSize = vJobs.size();
+    if (uiSize == 0) return;
+
+#if wxUSE_THREADS
+    wxVector<bool> vRunning(uiSize, false);
+    for(i=1;i<uiSize;i++)
+    {
+        if (vJobs[i]->Create() != wxTHREAD_NO_ERROR) continue;
+        if (vJobs[i]->Run() != wxTHREAD_NO_ERROR) continue;
+        vRunning[i] = true;
+    }
+
+    vJobs[0]->Execute();
+    for(i=1;i<uiSize;i++)
+    {
+        if (vRunning[i]) vJobs[i]->Wait();
+        else             vJobs[i]->Execute();
+    }
+#else
+    for(i=0;i<uiSize;i++) vJobs[i]->Execute();
+#endif // wxUSE_THREADS
+
+    for(i=0;i<uiSize;i++) delete(vJobs[i]);
+    vJobs.clear();
+}
+
+//----------------------- INLINE IMPLEMENTATION ---------------------//
+/** Get the effective amount of workers
+  * \param uiWorkers [input]: the requested amount of workers. 0 for 1 worker per CPU
+  * \return the amount of workers to use. Always >= 1. Always 1 if threads are not available
+  */
+WX_VDV_INLINE size_t wxGetParallelSortWorkerCount(size_t uiWorkers)
+{
+#if wxUSE_THREADS
+    if (uiWorkers > 0) return(uiWorkers);
+    int iCPUs = wxThread::GetCPUCount();
+    if (iCPUs > 1) return(iCPUs);
+#endif // wxUSE_THREADS
+    return(1);
+}
+
+/** Stable sort using several threads.
+  * The range is split in chunks which are sorted concurrently (std::stable_sort), then the chunks
+  * are merged 2 by 2, concurrently, until only one chunk remains.
+  * \param pBegin    [input / output]: start of the range to sort
+  * \param pEnd      [input / output]: end of the range to sort
+  * \param oCmp      [input]: the comparison functor. It is copied in each worker, and is called
+  *                           concurrently from several threads
+  * \param uiWorkers [input]: the maximal amount of threads (including the calling thread)
+  * O(n.log(n)/p) time with p workers, O(n) additional space.
+  */
+template<typename T, typename TCompare>
+void wxParallelStableSort(T *pBegin, T *pEnd, TCompare oCmp, size_t uiWorkers)
+{
+    typedef wxParallelSortJob<T, TCompare> TJob;
+
+    size_t uiSize = pEnd - pBegin;
+    size_t uiChunks = uiWorkers;
+    if (uiChunks > uiSize / WX_PARALLEL_SORT_MIN_CHUNK) uiChunks = uiSize / WX_PARALLEL_SORT_MIN_CHUNK;
+    if (uiChunks < 2)
+    {
+        std::stable_sort(pBegin, pEnd, oCmp);
+        return;
+    }
+
+    //sort the chunks
+    size_t i;
+    wxVector<size_t> vBounds;
+    vBounds.reserve(uiChunks + 1);
+    for(i=0;i<=uiChunks;i++) vBounds.push_back((uiSize * i) / uiChunks);
+
+    wxVector<TJob*> vJobs;
+    for(i=0;i<uiChunks;i++)
+    {
+        vJobs.push_back(new TJob(pBegin + vBounds[i], WX_VDV_NULL_PTR,
+                                 pBegin + vBounds[i + 1], WX_VDV_NULL_PTR, oCmp));
+    }
+    wxRunParallelSortJobs(vJobs);
+
+    //merge adjacent chunks, alternating between the range and a buffer
+    wxVector<T> vBuffer(uiSize, *pBegin);
+    T *pSrc = pBegin;
+    T *pDst = &vBuffer[0];
+    while (vBounds.size() > 2)
+    {
+        wxVector<size_t> vNewBounds;
+        size_t uiNbChunks = vBounds.size() - 1;
+        for(i=0;i<uiNbChunks;i+=2)
+        {
+            size_t uiStart  = vBounds[i];
+            size_t uiMiddle = vBounds[i + 1];
+            size_t uiEnd    = uiMiddle;
+            if (i + 1 < uiNbChunks) uiEnd = vBounds[i + 2];
+
+            vNewBounds.push_back(uiStart);
+            vJobs.push_back(new TJob(pSrc + uiStart, pSrc + uiMiddle, pSrc + uiEnd,
+                                     pDst + uiStart, oCmp));
+        }
+        vNewBounds.push_back(uiSize);
+        wxRunParallelSortJobs(vJobs);
+
+        std::swap(pSrc, pDst);
+        vBounds = vNewBounds;
+    }
+
+    if (pSrc != pBegin) std::copy(pSrc, pSrc + uiSize, pBegin);
+}
+
+#endif // WX_VIRTUAL_PARALLEL_SORT_HPP_
@@ -0,0 +1,207 @@
+/**********************************************************************/
+/** FILE    : PerfCounters.h                                         **/
+/** PROJECT : wxVirtualDataViewCtrl                                  **/
+/** LICENSE : wxWindows Library Licence                              **/
+/** PURPOSE : run-time switchable timers & performance counters      **/
+/**********************************************************************/
+
+
+#ifndef WX_VIRTUAL_PERF_COUNTERS_H_
+#define WX_VIRTUAL_PERF_COUNTERS_H_
+
+#include <wx/defs.h>
+#include <wx/VirtualDataView/VirtualDataViewDefs.h>
+#include <wx/longlong.h>
+
+/** \struct wxVirtualDataViewStats : summary of the performance counters
+  * Times are in milliseconds. Rates are 0 if nothing was measured
+  */
+struct WXDLLIMPEXP_VDV wxVirtualDataViewStats
+{
+    double  m_dLastPaintTime;                                           ///< \brief duration of the last PaintModel() call (ms)
+    double  m_dAveragePaintTime;                                        ///< \brief average duration of PaintModel() (ms)
+    size_t  m_uiPaintCount;                                             ///< \brief amount of PaintModel() calls
+    size_t  m_uiModelCallsPerFrame;                                     ///< \brief data model calls during the last PaintModel()
+    size_t  m_uiItemsDrawnPerFrame;                                     ///< \brief items drawn during the last PaintModel()
+    size_t  m_uiGDIObjectsPerFrame;                                     ///< \brief GDI objects created during the last PaintModel()
+    size_t  m_uiTextMeasuresPerFrame;                                   ///< \brief texts measured with the DC during the last PaintModel()
+    size_t  m_uiTextMeasures;                                           ///< \brief texts measured with the DC / window
+    size_t  m_uiTextCacheHits;                                          ///< \brief text measurements found in the cache
+    double  m_dDrawItemTime;                                            ///< \brief total time spent in DrawItem() (ms)
+    double  m_dComputeSizeTime;                                         ///< \brief total time spent in ComputeSize() (ms)
+    double  m_dSelectionTime;                                           ///< \brief total time spent in PerformSelection() (ms)
+    double  m_dGetAllValuesTime;                                        ///< \brief total time spent in GetAllValues() (ms)
+    size_t  m_uiCacheHits;                                              ///< \brief proxy models cache hits
+    size_t  m_uiCacheMisses;                                            ///< \brief proxy models cache misses
+    double  m_dCacheHitRate;                                            ///< \brief proxy models cache hit rate (0.0 -> 1.0)
+    size_t  m_uiItemsSorted;                                            ///< \brief amount of items sorted
+    double  m_dItemsSortedPerSecond;                                    ///< \brief sorting throughput
+    size_t  m_uiItemsFiltered;                                          ///< \brief amount of items filtered
+    double  m_dItemsFilteredPerSecond;                                  ///< \brief filtering throughput
+};
+
+/** \class wxVirtualPerfCounters : global timers & counters for the hot paths of the control
+  * Disabled by default. When disabled, each instrumentation point costs 1 test of a boolean.
+  * The whole instrumentation can be compiled out with WX_VDV_USE_PERF_COUNTERS = 0
+  * The counters are not thread-safe: they must be updated from the GUI thread only
+  */
+class WXDLLIMPEXP_VDV wxVirtualPerfCounters
+{
+    public:
+        /// \enum ETimer : the timers
+        enum ETimer
+        {
+            WX_PERF_PAINT_MODEL     = 0,                                ///< \brief PaintModel()
+            WX_PERF_DRAW_ITEM       = 1,                                ///< \brief DrawItem()
+            WX_PERF_COMPUTE_SIZE    = 2,                                ///< \brief ComputeSize()
+            WX_PERF_SORT            = 3,                                ///< \brief sorting of children
+            WX_PERF_FILTER          = 4,                                ///< \brief filtering of children
+            WX_PERF_GET_ALL_VALUES  = 5,                                ///< \brief GetAllValues()
+            WX_PERF_SELECTION       = 6,                                ///< \brief PerformSelection()
+            WX_PERF_TIMER_COUNT     = 7                                 ///< \brief amount of timers
+        };
+
+        /// \enum ECounter : the counters
+        enum ECounter
+        {
+            WX_PERF_MODEL_CALLS     = 0,                                ///< \brief data model calls from the renderer
+            WX_PERF_ITEMS_DRAWN     = 1,                                ///< \brief items drawn
+            WX_PERF_CACHE_HITS      = 2,                                ///< \brief proxy models cache hits
+            WX_PERF_CACHE_MISSES    = 3,                                ///< \brief proxy models cache misses
+            WX_PERF_ITEMS_SORTED    = 4,                                ///< \brief items sorted
+            WX_PERF_ITEMS_FILTERED  = 5,                                ///< \brief items filtered
+            WX_PERF_GDI_OBJECTS     = 6,                                ///< \brief GDI objects created while painting
+            WX_PERF_TEXT_MEASURES   = 7,                                ///< \brief texts measured with the DC / window
+            WX_PERF_TEXT_CACHE_HITS = 8,                                ///< \brief text measurements found in wxVirtualTextExtentCache
+            WX_PERF_COUNTER_COUNT   = 9                                 ///< \brief amount of counters
+        };
+
+        //run-time switch
+        static bool         IsEnabled(void);                            ///< \brief check if the counters are enabled
+        static void         Enable(bool bEnable = true);                ///< \brief enable / disable the counters
+        static void         Reset(void);                                ///< \brief reset all timers & counters
+
+        //update
+        static wxLongLong   Now(void);                                  ///< \brief get the current time in microseconds (monotonic clock)
+        static void         AddTime(ETimer eTimer,
+                                    wxLongLong llMicroSeconds);         ///< \brief add a measure to a timer
+        static void         Increment(ECounter eCounter,
+                                      size_t uiAmount = 1);             ///< \brief increment a counter
+        static void         BeginFrame(void);                           ///< \brief start a paint frame
+        static void         EndFrame(void);                             ///< \brief end a paint frame
+
+        //query
+        static wxLongLong   GetTotalTime(ETimer eTimer);                ///< \brief get the total time of a timer (microseconds)
+        static wxLongLong   GetLastTime(ETimer eTimer);                 ///< \brief get the last measure of a timer (microseconds)
+        static size_t       GetCalls(ETimer eTimer);                    ///< \brief get the amount of measures of a timer
+        static size_t       GetCount(ECounter eCounter);                ///< \brief get the value of a counter
+        static size_t       GetLastFrameCount(ECounter eCounter);       ///< \brief get the increment of a counter during the last frame
+        static void         GetStats(wxVirtualDataViewStats &rStats);   ///< \brief get a summary of the counters
+
+    private:
+        //data
+        static bool         ms_bEnabled;                                ///< \brief true if the counters are enabled
+        static wxLongLong   ms_vTotalTimes[WX_PERF_TIMER_COUNT];        ///< \brief total time of each timer
+        static wxLongLong   ms_vLastTimes[WX_PERF_TIMER_COUNT];         ///< \brief last measure of each timer
+        static size_t       ms_vCalls[WX_PERF_TIMER_COUNT];             ///< \brief amount of measures of each timer
+        static size_t       ms_vCounters[WX_PERF_COUNTER_COUNT];        ///< \brief counters
+        static size_t       ms_vFrameStart[WX_PERF_COUNTER_COUNT];      ///< \brief counters at the start of the current frame
+        static size_t       ms_vLastFrame[WX_PERF_COUNTER_COUNT];       ///< \brief counters increments during the last frame
+};
+
+/** \class wxVirtualPerfScopedTimer : measure the time spent in a scope
+  */
+class WXDLLIMPEXP_VDV wxVirtualPerfScopedTimer
+{
+    public:
+        //constructor & destructor
+        wxVirtualPerfScopedTimer(wxVirtualPerfCounters::ETimer eTimer); ///< \brief constructor : start the timer
+        ~wxVirtualPerfScopedTimer(void);                                ///< \brief destructor : stop the timer
+
+    private:
+        wxVirtualPerfCounters::ETimer   m_eTimer;                       ///< \brief the timer
+        bool                            m_bRunning;                     ///< \brief true if the counters were enabled at start
+        wxLongLong                      m_llStart;                      ///< \brief start time
+};
+
+/** \class wxVirtualPerfScopedFrame : measure a paint frame (timer WX_PERF_PAINT_MODEL & per-frame counters)
+  */
+class WXDLLIMPEXP_VDV wxVirtualPerfScopedFrame
+{
+    public:
+        //constructor & destructor
+        wxVirtualPerfScopedFrame(void);                                 ///< \brief constructor : start the frame
+        ~wxVirtualPerfScopedFrame(void);                                ///< \brief destructor : end the frame
+
+    private:
+        bool                            m_bRunning;                     ///< \brief true if the counters were enabled at start
+        wxLongLong                      m_llStart;                      ///< \brief start time
+};
+
+//-------------------- INSTRUMENTATION MACROS -----------------------//
+#if WX_VDV_USE_PERF_COUNTERS != 0
+    #define WX_VDV_PERF_TIMER(eTimer)           wxVirtualPerfScopedTimer oPerfTimer(wxVirtualPerfCounters::eTimer)
+    #define WX_VDV_PERF_FRAME()                 wxVirtualPerfScopedFrame oPerfFrame
+    #define WX_VDV_PERF_COUNT(eCounter, n)      do {if (wxVirtualPerfCounters::IsEnabled()) wxVirtualPerfCounters::Increment(wxVirtualPerfCounters::eCounter, n);} while(0)
+#else
+    #define WX_VDV_PERF_TIMER(eTimer)
+    #define WX_VDV_PERF_FRAME()
+    #define WX_VDV_PERF_COUNT(eCounter, n)
+#endif // WX_VDV_USE_PERF_COUNTERS
+
+//----------------- INLINE IMPLEMENTATION ---------------------------//
+/** Check if the counters are enabled
+  * \return true if the counters are enabled
+  */
+WX_VDV_INLINE bool wxVirtualPerfCounters::IsEnabled(void)
+{
+    return(ms_bEnabled);
+}
+
+/** Increment a counter
+  * \param eCounter [input]: the counter to increment
+  * \param uiAmount [input]: the increment
+  */
+WX_VDV_INLINE void wxVirtualPerfCounters::Increment(ECounter eCounter, size_t uiAmount)
+{
+    ms_vCounters[eCounter] += uiAmount;
+}
+
+/** Constructor : start the timer
+  * \param eTimer [input]: the timer to update
+  */
+WX_VDV_INLINE wxVirtualPerfScopedTimer::wxVirtualPerfScopedTimer(wxVirtualPerfCounters::ETimer eTimer)
+    : m_eTimer(eTimer),
+      m_bRunning(wxVirtualPerfCounters::IsEnabled())
+{
+    if (m_bRunning) m_llStart = wxVirtualPerfCounters::Now();
+}
+
+/** Destructor : stop the timer
+  */
+WX_VDV_INLINE wxVirtualPerfScopedTimer::~wxVirtualPerfScopedTimer(void)
+{
+    if (m_bRunning) wxVirtualPerfCounters::AddTime(m_eTimer, wxVirtualPerfCounters::Now() - m_llStart);
+}
+
+/** Constructor : start the frame
+  */
+WX_VDV_INLINE wxVirtualPerfScopedFrame::wxVirtualPerfScopedFrame(void)
+    : m_bRunning(wxVirtualPerfCounters::IsEnabled())
+{
+    if (!m_bRunning) return;
+    wxVirtualPerfCounters::BeginFrame();
+    m_llStart = wxVirtualPerfCounters::Now();
+}
+
+/** Destructor : end the frame
+  */
+WX_VDV_INLINE wxVirtualPerfScopedFrame::~wxVirtualPerfScopedFrame(void)
+{
+    if (!m_bRunning) return;
+    wxVirtualPerfCounters::AddTime(wxVirtualPerfCounters::WX_PERF_PAINT_MODEL,
+                                   wxVirtualPerfCounters::Now() - m_llStart);
+    wxVirtualPerfCounters::EndFrame();
+}
+
+#endif // WX_VIRTUAL_PERF_COUNTERS_H_
@@ -0,0 +1,56 @@
+/**********************************************************************/
+/** FILE    : VirtualMappedFile.h                                    **/
+/** PROJECT : wxVirtualDataViewCtrl                                  **/
+/** LICENSE : wxWindows Library Licence                              **/
+/** PURPOSE : read-only memory-mapped file                           **/
+/**********************************************************************/
+
+
+#ifndef WX_VIRTUAL_MAPPED_FILE_H_
+#define WX_VIRTUAL_MAPPED_FILE_H_
+
+#include <wx/defs.h>
+#include <wx/VirtualDataView/VirtualDataViewDefs.h>
+#include <wx/string.h>
+
+/** \class wxVirtualMappedFile : a file mapped in memory, in read-only mode
+  * The whole file is mapped at once: the pages are loaded by the OS on first access, and can be
+  * discarded by the OS at any time. Mapping a file is O(1), whatever its size.
+  *
+  * On 32 bits platforms, the size of the file is limited by the address space.
+  * The mapping is immutable: it can be read from several threads at once.
+  */
+class WXDLLIMPEXP_VDV wxVirtualMappedFile
+{
+    public:
+        //constructors & destructor
+        wxVirtualMappedFile(void);                                      ///< \brief default constructor
+        ~wxVirtualMappedFile(void);                                     ///< \brief destructor
+
+        //open / close
+        bool Open(const wxString &sFileName);                           ///< \brief map a file
+        void Close(void);                                               ///< \brief unmap the file
+        bool IsOpened(void) const;                                      ///< \brief check if a file is mapped
+
+        //access
+        const char* GetData(void) const;                                ///< \brief get the 1st byte of the file
+        wxUint64    GetSize(void) const;                                ///< \brief get the size of the file, in bytes
+        wxString    GetFileName(void) const;                            ///< \brief get the name of the mapped file
+
+    private:
+        //data
+        const char*     m_pData;                                        ///< \brief the mapped bytes
+        wxUint64        m_uiSize;                                       ///< \brief size of the file
+        wxString        m_sFileName;                                    ///< \brief name of the file
+        bool            m_bOpened;                                      ///< \brief true if a file is mapped
+#ifdef __WXMSW__
+        void*           m_hFile;                                        ///< \brief file handle
+        void*           m_hMapping;                                     ///< \brief file mapping handle
+#endif // __WXMSW__
+
+        //forbidden
+        wxVirtualMappedFile(const wxVirtualMappedFile &rhs);            ///< \brief copy constructor (forbidden)
+        wxVirtualMappedFile& operator=(const wxVirtualMappedFile &rhs); ///< \brief assignation operator (forbidden)
+};
+
+#endif
@@ -0,0 +1,74 @@
+/**********************************************************************/
+/** FILE    : VirtualTextExtentCache.h                               **/
+/** PROJECT : wxVirtualDataViewCtrl                                  **/
+/** LICENSE : wxWindows Library Licence                              **/
+/** PURPOSE : cache of text measurements                             **/
+/**********************************************************************/
+
+
+#ifndef WX_VIRTUAL_TEXT_EXTENT_CACHE_H_
+#define WX_VIRTUAL_TEXT_EXTENT_CACHE_H_
+
+#include <wx/defs.h>
+#include <wx/VirtualDataView/VirtualDataViewDefs.h>
+#include <wx/gdicmn.h>
+#include <wx/string.h>
+#include <wx/vector.h>
+
+class WXDLLIMPEXP_CORE wxWindow;
+class WXDLLIMPEXP_CORE wxDC;
+class WXDLLIMPEXP_CORE wxFont;
+struct wxVirtualTextExtentFont;
+
+/** \class wxVirtualTextExtentCache : a global cache of text measurements, shared by all renderers
+  * Measuring a text (wxDC::GetTextExtent, wxWindow::GetTextExtent) is slow on some platforms
+  * (a Pango layout on GTK). The cache stores the size of the strings already measured, for each font.
+  *
+  * Strings made only of digits & numeric punctuation (see IsNumeric()) are not stored: their size is
+  * computed from the width of each glyph, measured once per font.
+  *
+  * The memory is bounded: the cache is cleared when it holds too many strings or too many fonts.
+  * Long strings are never cached.
+  *
+  * The cache is not thread-safe: it must be used from the GUI thread only.
+  */
+class WXDLLIMPEXP_VDV wxVirtualTextExtentCache
+{
+    public:
+        //measurement
+        static wxSize GetTextExtent(wxWindow *pWindow, const wxString &rsText,
+                                    const wxFont &rFont);                       ///< \brief measure a text drawn in a window
+        static wxSize GetTextExtent(const wxDC &rDC, const wxString &rsText);   ///< \brief measure a text drawn with the current font of a DC
+
+        //settings
+        static bool   IsEnabled(void);                                          ///< \brief check if the cache is enabled
+        static void   Enable(bool bEnable = true);                              ///< \brief enable / disable the cache
+        static size_t GetMaxEntries(void);                                      ///< \brief get the maximal amount of cached strings
+        static void   SetMaxEntries(size_t uiMaxEntries);                       ///< \brief set the maximal amount of cached strings
+
+        //maintenance
+        static void   Clear(void);                                              ///< \brief clear the cache
+        static size_t GetEntriesCount(void);                                    ///< \brief get the amount of cached strings
+
+        //helpers
+        static bool   IsNumeric(const wxString &rsText);                        ///< \brief check if a string uses the numeric fast path
+
+    private:
+        //data
+        static bool                                 ms_bEnabled;                ///< \brief true if the cache is enabled
+        static size_t                               ms_uiMaxEntries;            ///< \brief maximal amount of cached strings
+        static size_t                               ms_uiEntries;               ///< \brief amount of cached strings
+        static wxVector<wxVirtualTextExtentFont*>   ms_vFonts;                  ///< \brief cached fonts
+
+        //methods
+        static wxVirtualTextExtentFont* GetFont(const wxFont &rFont,
+                                                const wxSize &rPPI);            ///< \brief get the cache of a font, create it if needed
+        static wxSize Measure(wxWindow *pWindow, const wxDC *pDC,
+                              const wxString &rsText, const wxFont &rFont);     ///< \brief really measure a text
+        static wxSize DoGetTextExtent(wxWindow *pWindow, const wxDC *pDC,
+                                      const wxString &rsText,
+                                      const wxFont &rFont,
+                                      const wxSize &rPPI);                      ///< \brief measure a text, using the cache
+};
+
+#endif
@@ -18,5 +18,8 @@
 
 #define WX_USE_COMPATIBILITY_LAYER_WITH_DVC     1
 
+//performance counters (see wxVirtualPerfCounters). Disabled at run-time by default
+#define WX_VDV_USE_PERF_COUNTERS                1
+
 #endif
 
@@ -387,6 +387,15 @@ wxVirtualIDataModel::ECompareResult wxVirtualDataViewModelCompat::Compare(const
     return(WX_E_EQUAL);
 }
 
+/** Check if Compare() is reimplemented for a field
+  * \param uiField [input]: the field to check
+  * \return true: the comparison is delegated to wxDataViewModel::Compare()
+  */
+bool wxVirtualDataViewModelCompat::HasCustomCompare(size_t uiField)
+{
+    return(true);
+}
+
 //------------------- INTERFACE : MISC ------------------------------//
 /** Return true if an item expander should be drawn for this item
   * \param rID       [input]: the ID of the item to check
@@ -16,6 +16,7 @@
 #include <wx/VirtualDataView/DataView/VirtualDataViewCtrl.h>
 #include <wx/VirtualDataView/Models/VirtualIDataModel.h>
 #include <wx/VirtualDataView/Models/VirtualIProxyDataModel.h>
+#include <wx/VirtualDataView/Models/VirtualIListDataModel.h>
 #include <wx/VirtualDataView/StateModels/VirtualDefaultStateModel.h>
 #include <wx/VirtualDataView/ModelRenderer/VirtualIModelRenderer.h>
 #include <wx/VirtualDataView/ModelRenderer/VirtualTreeModelRenderer.h>
@@ -122,9 +123,11 @@ void wxVirtualDataViewBase::Init(wxVirtualIDataModel *pDataModel,
 {
     m_pOwner            = WX_VDV_NULL_PTR;
     m_pDataModel        = pDataModel;
+    if (m_pDataModel) m_pDataModel->AddObserver(this);
 
     m_pStateModel       = pStateModel;
     if (!m_pStateModel) m_pStateModel = new wxVirtualDefaultStateModel();
+    m_pStateModel->OnDataModelChanged(m_pDataModel);
 
     m_pModelRenderer    = pModelRenderer;
     if (!m_pModelRenderer) m_pModelRenderer = new wxVirtualTreeModelRenderer(this, NULL);
@@ -143,6 +146,7 @@ void wxVirtualDataViewBase::Release(void)
   */
 void wxVirtualDataViewBase::ReleaseDataModel(void)
 {
+    if (m_pDataModel) m_pDataModel->RemoveObserver(this);
     if ((m_pDataModel) && (m_bOwnDataModel)) delete(m_pDataModel);
     m_pDataModel = WX_VDV_NULL_PTR;
 }
@@ -344,9 +348,11 @@ void wxVirtualDataViewBase::SetDataModel(wxVirtualIDataModel *pModel)
     DetachAllProxyModels();
     ReleaseDataModel();
     m_pDataModel = pModel;
+    if (m_pDataModel) m_pDataModel->AddObserver(this);
 
-    if (m_pModelRenderer) m_pModelRenderer->OnDataModelChanged();
+    //state model first : the renderer may use its index of visible rows
     if (m_pStateModel) m_pStateModel->OnDataModelChanged(m_pDataModel);
+    if (m_pModelRenderer) m_pModelRenderer->OnDataModelChanged();
     InvalidateBestSize();
     if (m_pOwner) m_pOwner->InvalidateBestSize();
 }
@@ -444,6 +450,8 @@ void wxVirtualDataViewBase::DetachProxyModel(wxVirtualIProxyDataModel *pModel)
                 //we now have : pPrevious -> pMasterModel
             }
             delete(pModel);
+
+            if (m_pStateModel) m_pStateModel->OnDataModelChanged(m_pDataModel);
             return;
         }
 
@@ -491,6 +499,7 @@ void wxVirtualDataViewBase::SetStateModel(wxVirtualIStateModel *pStateModel)
     if (m_pStateModel == pStateModel) return;
     ReleaseStateModel();
     m_pStateModel = pStateModel;
+    if (m_pStateModel) m_pStateModel->OnDataModelChanged(m_pDataModel);
 
     if (m_pModelRenderer) m_pModelRenderer->OnLayoutChanged();
 
@@ -585,7 +594,9 @@ void wxVirtualDataViewBase::OnPaintEvent(wxPaintEvent& WXUNUSED(rEvent))
 
     if (m_pModelRenderer)
     {
-        if (m_pModelRenderer->PaintModel(dc)) return;
+        //repaint only the invalidated area (for example the strip exposed by a scrolling)
+        wxRect rUpdateRect = GetUpdateRegion().GetBox();
+        if (m_pModelRenderer->PaintRect(dc, rUpdateRect)) return;
     }
 
     //failed somehow
@@ -772,19 +783,197 @@ bool wxVirtualDataViewBase::FinishEdition(bool bCancel)
   */
 void wxVirtualDataViewBase::OnDataModelChanged(void)
 {
-    if (m_pModelRenderer) m_pModelRenderer->OnDataModelChanged();
+    //state model first : the renderer may use its index of visible rows
     if (m_pStateModel) m_pStateModel->OnDataModelChanged(m_pDataModel);
+    if (m_pModelRenderer) m_pModelRenderer->OnDataModelChanged();
     InvalidateBestSize();
     if (m_pOwner) m_pOwner->InvalidateBestSize();
 }
 
 /** Called by the client to notify changes in layout
+  * The order of the items may have changed (sorting) : the visible row index is cleared
   */
 void wxVirtualDataViewBase::OnLayoutChanged(void)
 {
+    //state model first : the renderer may use its index of visible rows
+    if (m_pStateModel)
+    {
+        wxVirtualVisibleRowIndex *pRowIndex = m_pStateModel->GetVisibleRowIndex(m_pDataModel);
+        if (pRowIndex) pRowIndex->Clear();
+    }
     if (m_pModelRenderer) m_pModelRenderer->OnLayoutChanged();
 }
 
+//------------- DATA MODEL CHANGE NOTIFICATIONS ---------------------//
+/** The children of an item were inserted / removed / re-ordered
+  * \param rParent [input]: the item whose children changed
+  * Only the indices of rParent are updated, instead of the whole indices
+  */
+void wxVirtualDataViewBase::OnChildrenChanged(const wxVirtualItemID &rParent)
+{
+    //state model first : the renderer may use its index of visible rows
+    if (m_pStateModel) m_pStateModel->OnChildrenChanged(rParent);
+    if (m_pModelRenderer) m_pModelRenderer->OnChildrenChanged(rParent);
+    OnChildrenLayoutChanged(true);
+}
+
+/** Some children of an item were inserted / removed
+  * \param rParent   [input]: the parent of the inserted / removed items
+  * \param uiFirst   [input]: the child index of the 1st inserted / removed item
+  * \param uiCount   [input]: the amount of inserted / removed items
+  * \param bInserted [input]: true if the items were inserted, false if they were removed
+  * The renderer may update the display itself (only the rows which changed on screen are repainted)
+  * Top-level items appended at the end do not restart the background measurement of the columns
+  */
+void wxVirtualDataViewBase::OnRowsShifted(const wxVirtualItemID &rParent,
+                                          size_t uiFirst, size_t uiCount,
+                                          bool bInserted)
+{
+    //state model first : the renderer may use its index of visible rows
+    if (m_pStateModel) m_pStateModel->OnChildrenChanged(rParent);
+
+    bool bDisplayUpdated = false;
+    if (m_pModelRenderer)
+    {
+        if (bInserted) bDisplayUpdated = m_pModelRenderer->OnItemsInserted(rParent, uiFirst, uiCount);
+        else           bDisplayUpdated = m_pModelRenderer->OnItemsRemoved(rParent, uiFirst, uiCount);
+    }
+
+    //appended top-level items : only the new rows need to be measured
+    wxVirtualItemID idFirstNew;
+    if ((bInserted) && (uiCount > 0) && (m_pDataModel) && (m_pDataModel->IsRootItem(rParent))
+        && (uiFirst + uiCount == m_pDataModel->GetChildCount(rParent)))
+    {
+        idFirstNew = m_pDataModel->GetChild(rParent, uiFirst);
+    }
+    OnChildrenLayoutChanged(!bDisplayUpdated, idFirstNew);
+}
+
+/** Update the sizes after a change of the children of an item
+  * \param bRefresh   [input]: true for repainting the whole client area
+  * \param rFirstNew  [input]: the 1st top-level item appended at the end, if the change is an append.
+  *                            Invalid otherwise : the cached best widths are forgotten
+  */
+void wxVirtualDataViewBase::OnChildrenLayoutChanged(bool bRefresh, const wxVirtualItemID &rFirstNew)
+{
+    InvalidateBestSize();
+    if (m_pOwner)
+    {
+        m_pOwner->InvalidateBestSize();
+        if (rFirstNew.IsOK()) m_pOwner->ExtendAutoSizeMeasures(rFirstNew);
+        else                  m_pOwner->InvalidateAutoSizeCache();
+    }
+
+    RefreshHeaders();
+    if (bRefresh) Refresh(true, WX_VDV_NULL_PTR);
+}
+
+/** Some items were inserted
+  * \param pModel  [input]: the model sending the notification
+  * \param rParent [input]: the parent of the new items
+  * \param uiFirst [input]: the child index of the 1st new item
+  * \param uiCount [input]: the amount of new items
+  */
+void wxVirtualDataViewBase::OnItemsInserted(wxVirtualIDataModel *pModel,
+                                            const wxVirtualItemID &rParent,
+                                            size_t uiFirst, size_t uiCount)
+{
+    OnRowsShifted(rParent, uiFirst, uiCount, true);
+}
+
+/** Some items were removed
+  * \param pModel  [input]: the model sending the notification
+  * \param rParent [input]: the parent of the removed items
+  * \param uiFirst [input]: the child index of the 1st removed item
+  * \param uiCount [input]: the amount of removed items
+  */
+void wxVirtualDataViewBase::OnItemsRemoved(wxVirtualIDataModel *pModel,
+                                           const wxVirtualItemID &rParent,
+                                           size_t uiFirst, size_t uiCount)
+{
+    OnRowsShifted(rParent, uiFirst, uiCount, false);
+}
+
+/** The item IDs of a list model were shifted by an insertion or a removal
+  * \param pModel     [input]: the model sending the notification
+  * \param pListModel [input]: the list model in which rows were inserted / removed
+  * \param uiFirst    [input]: the row index of the 1st inserted / removed row in pListModel
+  * \param uiCount    [input]: the amount of inserted / removed rows
+  * \param bInserted  [input]: true if the rows were inserted, false if they were removed
+  * The state model keys the items by ID : its states are shifted here. OnRowsShifted() cannot
+  * do it, because it receives the positions in the top-most model (after sorting / filtering)
+  */
+void wxVirtualDataViewBase::OnItemIDsShifted(wxVirtualIDataModel *pModel,
+                                             wxVirtualIListDataModel *pListModel,
+                                             size_t uiFirst, size_t uiCount,
+                                             bool bInserted)
+{
+    if (!m_pStateModel) return;
+    wxVirtualItemID idParent = pListModel->GetRootItem();
+    if (bInserted) m_pStateModel->OnItemsInserted(idParent, uiFirst, uiCount);
+    else           m_pStateModel->OnItemsRemoved(idParent, uiFirst, uiCount);
+}
+
+/** The values of some items changed
+  * \param pModel  [input]: the model sending the notification
+  * \param vIDs    [input]: the items which changed
+  * \param vFields [input]: the fields which changed. Empty for all fields
+  * Only the visible rows of these items are repainted. The best widths of the changed fields
+  * are measured again
+  */
+void wxVirtualDataViewBase::OnItemsChanged(wxVirtualIDataModel *pModel,
+                                           const wxVirtualItemIDs &vIDs,
+                                           const TFieldIDs &vFields)
+{
+    if (m_pOwner) m_pOwner->InvalidateAutoSizeCache(vFields);
+    if (m_pModelRenderer) m_pModelRenderer->OnItemsChanged(vIDs);
+}
+
+/** Some items must be repainted, but their values did not change
+  * \param pModel [input]: the model sending the notification
+  * \param vIDs   [input]: the items to repaint
+  * Only the visible rows of these items are repainted. The cached best widths are kept
+  */
+void wxVirtualDataViewBase::OnItemsRefreshed(wxVirtualIDataModel *pModel,
+                                             const wxVirtualItemIDs &vIDs)
+{
+    if (m_pModelRenderer) m_pModelRenderer->OnItemsChanged(vIDs);
+}
+
+/** Some items were moved
+  * \param pModel        [input]: the model sending the notification
+  * \param rParent       [input]: the parent of the moved items
+  * \param uiFirst       [input]: the child index of the 1st moved item, before the move
+  * \param uiCount       [input]: the amount of moved items
+  * \param uiDestination [input]: the items were moved before this child index (index before the move)
+  */
+void wxVirtualDataViewBase::OnItemsMoved(wxVirtualIDataModel *pModel,
+                                         const wxVirtualItemID &rParent,
+                                         size_t uiFirst, size_t uiCount,
+                                         size_t uiDestination)
+{
+    OnChildrenChanged(rParent);
+}
+
+/** The children of an item changed in an unspecified way
+  * \param pModel  [input]: the model sending the notification
+  * \param rParent [input]: the item whose children changed
+  */
+void wxVirtualDataViewBase::OnChildrenReset(wxVirtualIDataModel *pModel,
+                                            const wxVirtualItemID &rParent)
+{
+    OnChildrenChanged(rParent);
+}
+
+/** The whole model changed
+  * \param pModel [input]: the model sending the notification
+  */
+void wxVirtualDataViewBase::OnModelReset(wxVirtualIDataModel *pModel)
+{
+    if (m_pOwner) m_pOwner->OnDataModelChanged();
+    else          OnDataModelChanged();
+}
+
 //----------------- SENDING EVENTS ----------------------------------//
 /** Print a log message
   * \param sMsg [input]: the message to print
@@ -993,80 +1182,37 @@ bool wxVirtualDataViewBase::SendScrollEvent(wxScrollWinEvent &rEvent)
 }
 
 /** Send a selection changing event
-  * \param vOld [input / output]: the old selection. Array is moved to the event object
-  * \param vNew [input / output]: the new selection. Array is moved to the event object
-  * \return true if the event has been accepted (selection changed allowed)
-  *         false if the event has been rejected (selection changed forbidden)
-  */
-bool wxVirtualDataViewBase::SendSelectionChangingEvent(wxVirtualItemIDs &vOld,
-                                                       wxVirtualItemIDs &vNew)
-{
-    PRINT_MSG(wxString::Format("Selection changing event"));
-
-    wxVirtualDataViewEvent e(wxEVT_VDV_SELECTION_CHANGING);
-    wxVirtualItemID id;
-    InitEvent(e, id, 0, 0);
-    e.AssignDeselectedItems(vOld);
-    e.AssignSelectedItems(vNew);
-    if (!SendEvent(e)) return(true); //not processed or not vetoed
-    return(e.IsAllowed());
-}
-
-/** Send a selection changed event
-  * \param vOld [input / output]: the old selection. Array is moved to the event object
-  * \param vNew [input / output]: the new selection. Array is moved to the event object
-  * \return true if the event has been processed (no further processing)
-  *         false if the event has not been processed
-  */
-bool wxVirtualDataViewBase::SendSelectionChangedEvent(wxVirtualItemIDs &vOld,
-                                                      wxVirtualItemIDs &vNew)
-{
-    PRINT_MSG(wxString::Format("Selection changed event"));
-
-    wxVirtualDataViewEvent e(wxEVT_VDV_SELECTION_CHANGED);
-    wxVirtualItemID id;
-    InitEvent(e, id, 0, 0);
-    e.AssignDeselectedItems(vOld);
-    e.AssignSelectedItems(vNew);
-    return(SendEvent(e));
-}
-
-/** Send a selection changing event
-  * \param vOld [input]: the old selection. Array is copied to the event object
-  * \param vNew [input]: the new selection. Array is copied to the event object
+  * \param rDelta [input]: the change of selection. It is copied to the event object
   * \return true if the event has been accepted (selection changed allowed)
   *         false if the event has been rejected (selection changed forbidden)
   */
-bool wxVirtualDataViewBase::SendSelectionChangingEventByCopy(const wxVirtualItemIDs &vOld,
-                                                             const wxVirtualItemIDs &vNew)
+bool wxVirtualDataViewBase::SendSelectionChangingEvent(const wxVirtualSelectionDelta &rDelta)
 {
     PRINT_MSG(wxString::Format("Selection changing event"));
 
     wxVirtualDataViewEvent e(wxEVT_VDV_SELECTION_CHANGING);
     wxVirtualItemID id;
     InitEvent(e, id, 0, 0);
-    e.SetDeselectedItems(vOld);
-    e.SetSelectedItems(vNew);
+    e.SetSelectionDelta(rDelta);
+    e.SetStateModel(GetStateModel());
     if (!SendEvent(e)) return(true); //not processed or not vetoed
     return(e.IsAllowed());
 }
 
 /** Send a selection changed event
-  * \param vOld [input]: the old selection. Array is copied to the event object
-  * \param vNew [input]: the new selection. Array is copied to the event object
+  * \param rDelta [input / output]: the change of selection. It is moved to the event object
   * \return true if the event has been processed (no further processing)
   *         false if the event has not been processed
   */
-bool wxVirtualDataViewBase::SendSelectionChangedEventByCopy(const wxVirtualItemIDs &vOld,
-                                                            const wxVirtualItemIDs &vNew)
+bool wxVirtualDataViewBase::SendSelectionChangedEvent(wxVirtualSelectionDelta &rDelta)
 {
     PRINT_MSG(wxString::Format("Selection changed event"));
 
     wxVirtualDataViewEvent e(wxEVT_VDV_SELECTION_CHANGED);
     wxVirtualItemID id;
     InitEvent(e, id, 0, 0);
-    e.SetDeselectedItems(vOld);
-    e.SetSelectedItems(vNew);
+    e.AssignSelectionDelta(rDelta);
+    e.SetStateModel(GetStateModel());
     return(SendEvent(e));
 }
 
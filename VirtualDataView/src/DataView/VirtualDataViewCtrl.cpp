@@ -25,6 +25,7 @@
 #include <wx/VirtualDataView/CellAttrs/VirtualDataViewCellAttr.h>
 #include <wx/VirtualDataView/FilterEditors/VirtualDataViewIFilterEditor.h>
 #include <wx/VirtualDataView/Filters/VirtualDataViewFilter.h>
+#include <wx/VirtualDataView/Utilities/PerfCounters.h>
 
 //includes for compatibility layer
 #if WX_USE_COMPATIBILITY_LAYER_WITH_DVC != 0
@@ -39,7 +40,12 @@
 #include <wx/dcbuffer.h>
 //#include <wx/log.h>
 #include <wx/stack.h>
-#include <wx/hashset.h>
+
+//column auto-sizing : default amount of rows sampled by WX_AUTOSIZE_SAMPLED
+static const size_t s_uiAutoSizeDefaultSampleSize = 1000;
+
+//column auto-sizing : amount of rows measured per idle event by WX_AUTOSIZE_BACKGROUND
+static const size_t s_uiAutoSizeRowsPerIdle = 2000;
 
 //--------------------- CONSTRUCTORS & DESTRUCTOR -------------------//
 
@@ -106,6 +112,11 @@ void wxVirtualDataViewCtrl::InitDataView(void)
     m_pCornerHeaderWindow = WX_VDV_NULL_PTR;
     m_pSortingModel       = WX_VDV_NULL_PTR;
     m_pFilteringModel     = WX_VDV_NULL_PTR;
+
+    m_eAutoSizeMode        = wxVirtualIModelRenderer::WX_AUTOSIZE_ALL_ROWS;
+    m_uiAutoSizeSampleSize = s_uiAutoSizeDefaultSampleSize;
+    m_vAutoSizeCache.clear();
+    m_vAutoSizeJobs.clear();
 }
 
 /** Really creates the control and sets the initial number of items in it
@@ -205,6 +216,9 @@ bool wxVirtualDataViewCtrl::Create(wxWindow *pParent, wxWindowID id, const wxPoi
     Bind(wxEVT_SCROLLWIN_THUMBTRACK  , &wxVirtualDataViewCtrl::OnScrollEvent, this);
     Bind(wxEVT_SCROLLWIN_THUMBRELEASE, &wxVirtualDataViewCtrl::OnScrollEvent, this);
 
+    //background column measurements
+    Bind(wxEVT_IDLE                  , &wxVirtualDataViewCtrl::OnIdleEvent  , this);
+
     //column header
     if (m_pColumnHeaderWindow)
     {
@@ -597,6 +611,7 @@ void wxVirtualDataViewCtrl::ReleaseModelRendererOwnership(void)
   */
 void wxVirtualDataViewCtrl::OnModelItemCountChanged(void)
 {
+    InvalidateAutoSizeCache();
     if (m_pClientArea) m_pClientArea->OnDataModelChanged();
     if (m_pColumnHeaderWindow) m_pColumnHeaderWindow->SetOwner(this);
     if (m_pRowHeaderWindow)    m_pRowHeaderWindow->SetOwner(this);
@@ -695,6 +710,7 @@ void wxVirtualDataViewCtrl::SetColumnMinWidth(size_t uiColumn, int iMinWidth)
 }
 
 /** Resize the column so it fits its content
+  * The best width is computed according to the auto-sizing strategy (see SetAutoSizeMode())
   * \param uiColumn     [input]: the column index
   */
 void wxVirtualDataViewCtrl::AutoSizeColumn(size_t uiColumn)
@@ -708,28 +724,15 @@ void wxVirtualDataViewCtrl::AutoSizeColumn(size_t uiColumn)
     wxVirtualDataViewColumn *pCol = m_vColumns.GetColumn(uiColumn);
     if (!pCol) return;
 
-    //compute best size
-    int iNewSize = pModelRenderer->GetBestSize(uiColumn).GetWidth();
-    //wxLogMessage("new size = %d", iNewSize);
-
-    //clamp new size to minimal size
-    if (iNewSize < pCol->GetMinWidth()) iNewSize = pCol->GetMinWidth();
-
-    //resize column
-    pCol->SetWidth(iNewSize);
-
-    //adjust scrollbars
-    wxSize sVirtualSize = m_pClientArea->GetVirtualSize();
-    sVirtualSize.SetWidth(m_vColumns.GetTotalWidth());
-    m_pClientArea->SetVirtualSize(sVirtualSize);
-    m_pClientArea->SendSizeEvent();
+    //compute best size & resize column
+    ApplyColumnBestWidth(pCol, GetColumnBestWidth(pModelRenderer, uiColumn));
 
-    //redraw
-    Refresh(true, WX_VDV_NULL_PTR);
-    Update();
+    //adjust scrollbars & redraw
+    UpdateColumnsLayout();
 }
 
 /** Resize all the columns so it fits the content
+  * The best widths are computed according to the auto-sizing strategy (see SetAutoSizeMode())
   */
 void wxVirtualDataViewCtrl::AutoSizeAllColumns(void)
 {
@@ -747,16 +750,88 @@ void wxVirtualDataViewCtrl::AutoSizeAllColumns(void)
         wxVirtualDataViewColumn *pCol = m_vColumns.GetColumn(uiCol);
         if (!pCol) continue;
 
-        //compute best size
-        int iNewSize = pModelRenderer->GetBestSize(uiCol).GetWidth();
+        //compute best size & resize column
+        ApplyColumnBestWidth(pCol, GetColumnBestWidth(pModelRenderer, uiCol));
+    }
+
+    //adjust scrollbars & redraw
+    UpdateColumnsLayout();
+}
+
+/** Get the best width of a column
+  * The width is taken from the cache if it was already computed. Otherwise it is computed
+  * with the current auto-sizing strategy and stored in the cache.
+  * With WX_AUTOSIZE_VISIBLE_ROWS, the width depends on the shown rows : it is never cached.
+  * With WX_AUTOSIZE_BACKGROUND, the width of the shown rows is returned, and a background
+  * measurement of all the rows is started : its result is cached & applied when it is done.
+  * \param pModelRenderer [input]: the model renderer
+  * \param uiColumn       [input]: the column index
+  * \return the best width of the column
+  */
+int wxVirtualDataViewCtrl::GetColumnBestWidth(wxVirtualIModelRenderer *pModelRenderer,
+                                              size_t uiColumn)
+{
+    wxVirtualDataViewColumn *pCol = m_vColumns.GetColumn(uiColumn);
+    if (!pCol) return(0);
+    size_t uiField = pCol->GetModelColumn();
 
-        //clamp new size to minimal size
-        if (iNewSize < pCol->GetMinWidth()) iNewSize = pCol->GetMinWidth();
+    //cached value
+    if ((uiField < m_vAutoSizeCache.size()) && (m_vAutoSizeCache[uiField] >= 0))
+    {
+        return(m_vAutoSizeCache[uiField]);
+    }
 
-        //resize column
-        pCol->SetWidth(iNewSize);
+    //compute
+    int iWidth = pModelRenderer->GetBestSize(uiColumn, m_eAutoSizeMode,
+                                             m_uiAutoSizeSampleSize).GetWidth();
+    if (m_eAutoSizeMode == wxVirtualIModelRenderer::WX_AUTOSIZE_BACKGROUND)
+    {
+        //start a background measurement, if not already running
+        size_t uiJob;
+        size_t uiNbJobs = m_vAutoSizeJobs.size();
+        for(uiJob = 0; uiJob < uiNbJobs; uiJob++)
+        {
+            if (m_vAutoSizeJobs[uiJob].m_uiField == uiField) return(iWidth);
+        }
+
+        wxVirtualIModelRenderer::TColumnMeasure oJob;
+        oJob.m_uiColID  = uiColumn;
+        oJob.m_uiField  = uiField;
+        oJob.m_uiLevel  = 0;
+        oJob.m_bStarted = false;
+        oJob.m_iWidth   = 0;
+        m_vAutoSizeJobs.push_back(oJob);
+        return(iWidth);
     }
 
+    //store in cache
+    if (m_eAutoSizeMode == wxVirtualIModelRenderer::WX_AUTOSIZE_VISIBLE_ROWS) return(iWidth);
+    while (m_vAutoSizeCache.size() <= uiField) m_vAutoSizeCache.push_back(-1);
+    m_vAutoSizeCache[uiField] = iWidth;
+    return(iWidth);
+}
+
+/** Resize a column to its best width
+  * \param pCol   [input]: the column to resize
+  * \param iWidth [input]: the best width of the column
+  */
+void wxVirtualDataViewCtrl::ApplyColumnBestWidth(wxVirtualDataViewColumn *pCol, int iWidth)
+{
+    if (!pCol) return;
+
+    //clamp new size to minimal size
+    if (iWidth < pCol->GetMinWidth()) iWidth = pCol->GetMinWidth();
+
+    //resize column
+    pCol->SetWidth(iWidth);
+}
+
+/** Update scrollbars & redraw after column widths changed
+  */
+void wxVirtualDataViewCtrl::UpdateColumnsLayout(void)
+{
+    if (!m_pClientArea) return;
+
     //adjust scrollbars
     wxSize sVirtualSize = m_pClientArea->GetVirtualSize();
     sVirtualSize.SetWidth(m_vColumns.GetTotalWidth());
@@ -768,6 +843,136 @@ void wxVirtualDataViewCtrl::AutoSizeAllColumns(void)
     Update();
 }
 
+//---------------------- COLUMN AUTO-SIZING -------------------------//
+/** Get the column auto-sizing strategy
+  * \return the column auto-sizing strategy
+  */
+wxVirtualIModelRenderer::EAutoSizeMode wxVirtualDataViewCtrl::GetAutoSizeMode(void) const
+{
+    return(m_eAutoSizeMode);
+}
+
+/** Set the column auto-sizing strategy
+  * The cached best widths are discarded
+  * \param eMode [input]: the new column auto-sizing strategy
+  */
+void wxVirtualDataViewCtrl::SetAutoSizeMode(wxVirtualIModelRenderer::EAutoSizeMode eMode)
+{
+    if (m_eAutoSizeMode == eMode) return;
+    m_eAutoSizeMode = eMode;
+    InvalidateAutoSizeCache();
+}
+
+/** Get the amount of rows sampled by WX_AUTOSIZE_SAMPLED
+  * \return the amount of rows sampled
+  */
+size_t wxVirtualDataViewCtrl::GetAutoSizeSampleSize(void) const
+{
+    return(m_uiAutoSizeSampleSize);
+}
+
+/** Set the amount of rows sampled by WX_AUTOSIZE_SAMPLED
+  * The cached best widths are discarded
+  * \param uiSampleSize [input]: the new amount of rows sampled
+  */
+void wxVirtualDataViewCtrl::SetAutoSizeSampleSize(size_t uiSampleSize)
+{
+    if (m_uiAutoSizeSampleSize == uiSampleSize) return;
+    m_uiAutoSizeSampleSize = uiSampleSize;
+    InvalidateAutoSizeCache();
+}
+
+/** Forget the cached best widths & stop background measurements
+  * This is done automatically when the data model changes, when items are expanded / collapsed,
+  * when the filters are applied, and when scrolling with WX_AUTOSIZE_VISIBLE_ROWS
+  */
+void wxVirtualDataViewCtrl::InvalidateAutoSizeCache(void)
+{
+    m_vAutoSizeCache.clear();
+    m_vAutoSizeJobs.clear();
+}
+
+/** Measure rows appended after the last top-level row
+  * This is done automatically when top-level items are appended to the model.
+  * With WX_AUTOSIZE_BACKGROUND, the running measurements are kept (they reach the new rows
+  * by themselves), and the cached widths are completed by measuring only the new rows. The cached
+  * width stays in use until the new rows are measured.
+  * With the other strategies, the cache is simply invalidated
+  * \param rFirstNew [input]: the 1st appended top-level item
+  */
+void wxVirtualDataViewCtrl::ExtendAutoSizeMeasures(const wxVirtualItemID &rFirstNew)
+{
+    if ((m_eAutoSizeMode != wxVirtualIModelRenderer::WX_AUTOSIZE_BACKGROUND) || (rFirstNew.IsInvalid()))
+    {
+        InvalidateAutoSizeCache();
+        return;
+    }
+
+    size_t uiCol, uiJob;
+    size_t uiNbCols = m_vColumns.GetColumnsCount();
+    for(uiCol = 0; uiCol < uiNbCols; uiCol++)
+    {
+        wxVirtualDataViewColumn *pCol = m_vColumns.GetColumn(uiCol);
+        if (!pCol) continue;
+        size_t uiField = pCol->GetModelColumn();
+        if ((uiField >= m_vAutoSizeCache.size()) || (m_vAutoSizeCache[uiField] < 0)) continue;
+
+        //a running measurement already reaches the new rows
+        size_t uiNbJobs = m_vAutoSizeJobs.size();
+        for(uiJob = 0; uiJob < uiNbJobs; uiJob++)
+        {
+            if (m_vAutoSizeJobs[uiJob].m_uiField == uiField) break;
+        }
+        if (uiJob < uiNbJobs) continue;
+
+        //measure the new rows only, starting from the cached width
+        wxVirtualIModelRenderer::TColumnMeasure oJob;
+        oJob.m_uiColID  = uiCol;
+        oJob.m_uiField  = uiField;
+        oJob.m_ID       = rFirstNew;
+        oJob.m_uiLevel  = 1;
+        oJob.m_bStarted = true;
+        oJob.m_iWidth   = m_vAutoSizeCache[uiField];
+        m_vAutoSizeJobs.push_back(oJob);
+    }
+}
+
+/** Forget the cached best widths of some model columns & stop their background measurements
+  * This is done automatically when the values of some items change
+  * \param vFields [input]: the model columns whose values changed. Empty for all columns
+  */
+void wxVirtualDataViewCtrl::InvalidateAutoSizeCache(const wxVector<size_t> &vFields)
+{
+    if (vFields.empty())
+    {
+        InvalidateAutoSizeCache();
+        return;
+    }
+
+    size_t i, uiField, uiNbFields;
+    uiNbFields = vFields.size();
+    for(i = 0; i < uiNbFields; i++)
+    {
+        uiField = vFields[i];
+        if (uiField < m_vAutoSizeCache.size()) m_vAutoSizeCache[uiField] = -1;
+
+        size_t uiJob = 0;
+        while (uiJob < m_vAutoSizeJobs.size())
+        {
+            if (m_vAutoSizeJobs[uiJob].m_uiField == uiField) m_vAutoSizeJobs.erase(m_vAutoSizeJobs.begin() + uiJob);
+            else                                             uiJob++;
+        }
+    }
+}
+
+/** Check if columns are measured in background
+  * \return true if at least one background measurement is in progress
+  */
+bool wxVirtualDataViewCtrl::IsAutoSizing(void) const
+{
+    return(!m_vAutoSizeJobs.empty());
+}
+
 /** Show / hide a column
   * \param uiColumn [input]: the column index
   * \param bShow    [input]: true for showing the column, false for hiding it
@@ -910,15 +1115,65 @@ void wxVirtualDataViewCtrl::OnScrollEvent(wxScrollWinEvent &rEvent)
 //    wxScrollWinEvent *pEvent = new wxScrollWinEvent(event);
 //    QueueEvent(pEvent);
 
-    //process scroll event and redraw main client area
+    //process scroll event : the model renderer scrolls & redraws the main client area
+    bool bScrolled = false;
     if (m_pClientArea)
     {
         wxVirtualIModelRenderer *pModelRenderer = m_pClientArea->GetModelRenderer();
-        if (pModelRenderer) pModelRenderer->ScrollEvent(rEvent);
+        if (pModelRenderer) bScrolled = pModelRenderer->ScrollEvent(rEvent);
     }
 
-    RefreshAll();
+    if (bScrolled) RefreshHeaders();
+    else           RefreshAll();
+
+    //the shown rows changed
+    if (m_eAutoSizeMode == wxVirtualIModelRenderer::WX_AUTOSIZE_VISIBLE_ROWS) InvalidateAutoSizeCache();
+    rEvent.Skip();
+}
+
+/** Idle event handler : measure a chunk of rows for the background column auto-sizing
+  * When a column is completely measured, its best width is cached & applied
+  * \param rEvent [input]: the event
+  */
+void wxVirtualDataViewCtrl::OnIdleEvent(wxIdleEvent &rEvent)
+{
     rEvent.Skip();
+    if (m_vAutoSizeJobs.empty()) return;
+
+    //get model renderer
+    wxVirtualIModelRenderer *pModelRenderer = WX_VDV_NULL_PTR;
+    if (m_pClientArea) pModelRenderer = m_pClientArea->GetModelRenderer();
+    if (!pModelRenderer)
+    {
+        m_vAutoSizeJobs.clear();
+        return;
+    }
+
+    //measure the next rows of the 1st column
+    wxVirtualIModelRenderer::TColumnMeasure &rJob = m_vAutoSizeJobs[0];
+    if (!pModelRenderer->MeasureColumn(rJob, s_uiAutoSizeRowsPerIdle))
+    {
+        rEvent.RequestMore();
+        return;
+    }
+
+    //finished : store in cache
+    size_t uiField = rJob.m_uiField;
+    int    iWidth  = rJob.m_iWidth;
+    size_t uiCol   = rJob.m_uiColID;
+    m_vAutoSizeJobs.erase(m_vAutoSizeJobs.begin());
+    while (m_vAutoSizeCache.size() <= uiField) m_vAutoSizeCache.push_back(-1);
+    m_vAutoSizeCache[uiField] = iWidth;
+
+    //apply
+    wxVirtualDataViewColumn *pCol = m_vColumns.GetColumn(uiCol);
+    if ((pCol) && (pCol->GetModelColumn() == uiField))
+    {
+        ApplyColumnBestWidth(pCol, iWidth);
+        UpdateColumnsLayout();
+    }
+
+    if (!m_vAutoSizeJobs.empty()) rEvent.RequestMore();
 }
 
 //---------------------- COLUMN RESIZING ----------------------------//
@@ -1104,6 +1359,9 @@ void wxVirtualDataViewCtrl::OnColHeaderStartReorder(wxVirtualHeaderCtrlEvent &rE
   */
 void wxVirtualDataViewCtrl::OnColHeaderReorder(wxVirtualHeaderCtrlEvent &rEvent)
 {
+    //background measurements refer to view columns : stop them
+    m_vAutoSizeJobs.clear();
+
     size_t uiDraggedCol = rEvent.GetItemID();
     size_t uiNewColPos  = rEvent.GetNewOrder();
 
@@ -1678,6 +1936,17 @@ size_t wxVirtualDataViewCtrl::GetSelectedItems(wxVirtualItemIDs &vIDs) const
     return(vIDs.size());
 }
 
+/** Get the amount of selected items
+  * \return the amount of selected items. Depending on the state model, this does not
+  *         require building the list of selected items
+  */
+size_t wxVirtualDataViewCtrl::GetSelectedItemCount(void) const
+{
+    wxVirtualIStateModel *pStateModel = DoGetStateModel();
+    if (!pStateModel) return(0);
+    return(pStateModel->GetSelectedItemCount());
+}
+
 /** Get the 1st selected item
   * \return the first selected item
   */
@@ -1752,41 +2021,6 @@ wxVirtualItemID wxVirtualDataViewCtrl::GetPrevUnselectedItem(const wxVirtualItem
     return(pStateModel->GetPrevSelectedItem(rID, pDataModel, false));
 }
 
-WX_DECLARE_HASH_SET(wxVirtualItemID, wxVirtualItemIDHash, wxVirtualItemIDEqual, TSetOfIDs);
-
-/** Helper: convert an array to a hash set
-  * \param oSetOfIDs [output]: the set of item IDs
-  * \param vIDs      [input] : the array of item IDs
-  */
-WX_VDV_INLINE void VectorToHashSet(TSetOfIDs &oSetOfIDs, const wxVirtualItemIDs &vIDs,
-                                   wxVirtualIDataModel *pDataModel)
-{
-    size_t i, uiCount;
-    uiCount = vIDs.size();
-    for(i = 0; i < uiCount; i++)
-    {
-        if (!pDataModel->IsSelectable(vIDs[i])) continue;
-        oSetOfIDs.insert(vIDs[i]);
-    }
-}
-
-/** Helper : convert a hash set to an array
-  * \param vIDs      [output]: the array of item IDs
-  * \param oSetOfIDs [input] : the set of item IDs
-  */
-WX_VDV_INLINE void HashSetToVector(wxVirtualItemIDs &vIDs, const TSetOfIDs &oSetOfIDs)
-{
-    vIDs.clear();
-    vIDs.reserve(oSetOfIDs.size() + vIDs.size());
-    TSetOfIDs::const_iterator it    = oSetOfIDs.begin();
-    TSetOfIDs::const_iterator itEnd = oSetOfIDs.end();
-    while (it != itEnd)
-    {
-        vIDs.push_back(*it);
-        ++it;
-    }
-}
-
 /** Select one item and optionally its children
   * \param rID [input]: the item to select/deselect
   * \param bSelect    [input]: true for selecting, false for deselecting
@@ -1802,30 +2036,23 @@ void wxVirtualDataViewCtrl::SelectItem(const wxVirtualItemID &rID, bool bSelect,
     wxVirtualIStateModel *pStateModel = DoGetStateModel();
     if (!pStateModel) return;
 
-    wxVirtualItemIDs vOlds;
-    wxVirtualItemIDs vNews;
+    wxVirtualSelectionDelta oDelta;
     if (bSendEvent)
     {
-        //get old selection
-        TSetOfIDs oSetOfIDs;
-        pStateModel->GetSelectedItems(vOlds);
-        VectorToHashSet(oSetOfIDs, vOlds, pDataModel);
-
-        //add the items to the new selection
-        if (bRecursive) GetAllChildren(vNews, rID, bRecursive);
-        vNews.push_back(rID);
-        VectorToHashSet(oSetOfIDs, vNews, pDataModel);
-        HashSetToVector(vNews, oSetOfIDs);
+        //describe the change : the item & its descendants
+        if (bRecursive) GetAllChildren(oDelta.SelectedItems(), rID, bRecursive);
+        oDelta.SelectedItems().push_back(rID);
+        if (!bSelect) oDelta.SelectedItems().swap(oDelta.DeselectedItems());
 
         //send event selection changed. Can be vetoed
-        if (!m_pClientArea->SendSelectionChangingEvent(vOlds, vNews)) return;
+        if (!m_pClientArea->SendSelectionChangingEvent(oDelta)) return;
     }
 
     //performs selection
     pStateModel->Select(rID, bSelect, bRecursive);
 
     //send selection changed event
-    if (bSendEvent) m_pClientArea->SendSelectionChangedEvent(vOlds, vNews);
+    if (bSendEvent) m_pClientArea->SendSelectionChangedEvent(oDelta);
 }
 
 /** Deselect one item and optionally its children
@@ -1863,24 +2090,18 @@ void wxVirtualDataViewCtrl::ToggleSelectedState(const wxVirtualItemID &rID,
     size_t uiItem, uiNbItems;
     uiNbItems = vItems.size();
 
-    //get old & new selection
-    wxVirtualItemIDs vOlds;
-    wxVirtualItemIDs vNews;
+    //describe the change
+    wxVirtualSelectionDelta oDelta;
     if (bSendEvent)
     {
-        TSetOfIDs oSetOfIDs;
-        pStateModel->GetSelectedItems(vOlds);
-        VectorToHashSet(oSetOfIDs, vOlds, pDataModel);
-
         for(uiItem=0; uiItem<uiNbItems; uiItem++)
         {
             wxVirtualItemID &id = vItems[uiItem];
-            if (pStateModel->IsSelected(id)) oSetOfIDs.erase(id);
-            else if (pDataModel->IsSelectable(id)) oSetOfIDs.insert(id);
+            if (pStateModel->IsSelected(id)) oDelta.AddItem(id, false);
+            else if (pDataModel->IsSelectable(id)) oDelta.AddItem(id, true);
         }
-        HashSetToVector(vNews, oSetOfIDs);
 
-        if (!m_pClientArea->SendSelectionChangingEvent(vOlds, vNews)) return; //vetoed
+        if (!m_pClientArea->SendSelectionChangingEvent(oDelta)) return; //vetoed
     }
 
     //perform state change
@@ -1896,7 +2117,7 @@ void wxVirtualDataViewCtrl::ToggleSelectedState(const wxVirtualItemID &rID,
     }
 
     //send selection changed event
-    if (bSendEvent) m_pClientArea->SendSelectionChangedEvent(vOlds, vNews);
+    if (bSendEvent) m_pClientArea->SendSelectionChangedEvent(oDelta);
 }
 
 /** Select/deselect all items
@@ -1909,22 +2130,19 @@ void wxVirtualDataViewCtrl::SelectAll(bool bSelect, bool bSendEvent)
     wxVirtualIStateModel *pStateModel = DoGetStateModel();
     if (!pStateModel) return;
 
-    //selection changing event
-    wxVirtualItemIDs vOldSelection;
-    wxVirtualItemIDs vIDs;
+    //selection changing event : O(1), the items are not listed
+    wxVirtualSelectionDelta oDelta;
+    oDelta.SetSelectAll();
     if (bSendEvent)
     {
-        GetSelectedItems(vOldSelection);
-        wxVirtualItemID idRoot = GetRootItem();
-        GetAllChildren(vIDs, idRoot, true);
-        if (!m_pClientArea->SendSelectionChangingEventByCopy(vOldSelection, vIDs)) return; //vetoed
+        if (!m_pClientArea->SendSelectionChangingEvent(oDelta)) return; //vetoed
     }
 
     //select
     pStateModel->SelectAll();
 
     //send selection changed event
-    if (bSendEvent) m_pClientArea->SendSelectionChangedEvent(vOldSelection, vIDs);
+    if (bSendEvent) m_pClientArea->SendSelectionChangedEvent(oDelta);
 
 }
 
@@ -1938,20 +2156,19 @@ void wxVirtualDataViewCtrl::DeselectAll(bool bSendEvent)
     wxVirtualIStateModel *pStateModel = DoGetStateModel();
     if (!pStateModel) return;
 
-    //selection changing event
-    wxVirtualItemIDs vOldSelection;
-    wxVirtualItemIDs vIDs;
+    //selection changing event : O(1), the items are not listed
+    wxVirtualSelectionDelta oDelta;
+    oDelta.SetDeselectAll();
     if (bSendEvent)
     {
-        GetSelectedItems(vOldSelection);
-        if (!m_pClientArea->SendSelectionChangingEventByCopy(vOldSelection, vIDs)) return; //vetoed
+        if (!m_pClientArea->SendSelectionChangingEvent(oDelta)) return; //vetoed
     }
 
     //deselect
     pStateModel->DeselectAll();
 
     //send selection changed event
-    if (bSendEvent) m_pClientArea->SendSelectionChangedEvent(vOldSelection, vIDs);
+    if (bSendEvent) m_pClientArea->SendSelectionChangedEvent(oDelta);
 }
 
 /** Select one or more items
@@ -1965,19 +2182,18 @@ void wxVirtualDataViewCtrl::SelectItems(const wxVirtualItemIDs &vIDs, bool bSend
     if (!pStateModel) return;
 
     //selection changing event
-    wxVirtualItemIDs vOldSelection;
-    wxVirtualItemIDs vIDsCopy; //to move to the event
+    wxVirtualSelectionDelta oDelta;
     if (bSendEvent)
     {
-        GetSelectedItems(vOldSelection);
-        if (!m_pClientArea->SendSelectionChangingEventByCopy(vOldSelection, vIDs)) return; //vetoed
+        oDelta.AddItems(vIDs, true);
+        if (!m_pClientArea->SendSelectionChangingEvent(oDelta)) return; //vetoed
     }
 
     //perform state change
     pStateModel->SelectList(vIDs, true);
 
     //send selection changed event
-    if (bSendEvent) m_pClientArea->SendSelectionChangedEventByCopy(vOldSelection, vIDs);
+    if (bSendEvent) m_pClientArea->SendSelectionChangedEvent(oDelta);
 }
 
 /** Check if an item is selected
@@ -3353,15 +3569,17 @@ void wxVirtualDataViewCtrl::SortItems(void)
   */
 void wxVirtualDataViewCtrl::ClearSortFilters(void)
 {
-    if (!m_pSortingModel) return;
-
     //clear the sorting filters & refresh
 
     //remove the sorting proxy model if any
-    DetachProxyModel(m_pSortingModel);
-    m_pSortingModel = WX_VDV_NULL_PTR;
+    if (m_pSortingModel)
+    {
+        DetachProxyModel(m_pSortingModel);
+        m_pSortingModel = WX_VDV_NULL_PTR;
+    }
 
     //bottom data model: notify to remove sorting filters
+    //it may have sorted on its own (CanSort()), without a sorting proxy
     wxVirtualIDataModel *pDataModel = GetBaseDataModel();
     if (pDataModel) pDataModel->ResetSorting();
 
@@ -3369,6 +3587,7 @@ void wxVirtualDataViewCtrl::ClearSortFilters(void)
     if (m_pFilteringModel) m_pFilteringModel->ClearCache();
 
     //refresh
+    if (!m_pClientArea) return;
     m_pClientArea->OnLayoutChanged();
     RefreshDataView();
 }
@@ -3431,6 +3650,7 @@ void wxVirtualDataViewCtrl::ClearAllFilters(void)
     m_pFilteringModel = WX_VDV_NULL_PTR;
     if (m_pSortingModel) m_pSortingModel->ClearCache();
 
+    InvalidateAutoSizeCache();
     m_pClientArea->OnLayoutChanged();
     RefreshDataView();
 }
@@ -3493,6 +3713,7 @@ void wxVirtualDataViewCtrl::ApplyFilters(void)
     }
 
     //refresh
+    InvalidateAutoSizeCache();
     m_pClientArea->OnDataModelChanged();
     RefreshDataView();
 }
@@ -3626,6 +3847,41 @@ bool wxVirtualDataViewCtrl::IsFiltering(void)
     return(false);
 }
 
+//-------------------- PERFORMANCE COUNTERS -------------------------//
+/** Enable / disable the performance counters
+  * \param bEnable [input]: true for enabling the counters, false for disabling them
+  * The counters are global : they are shared by all the controls
+  * They are available only if WX_VDV_USE_PERF_COUNTERS is not 0
+  */
+void wxVirtualDataViewCtrl::EnablePerformanceCounters(bool bEnable)
+{
+    wxVirtualPerfCounters::Enable(bEnable);
+}
+
+/** Check if the performance counters are enabled
+  * \return true if the performance counters are enabled
+  */
+bool wxVirtualDataViewCtrl::ArePerformanceCountersEnabled(void)
+{
+    return(wxVirtualPerfCounters::IsEnabled());
+}
+
+/** Get the performance counters
+  * \param rStats [output]: the frame time, model calls per frame, cache hit rate,
+  *                         sort / filter throughput, ...
+  */
+void wxVirtualDataViewCtrl::GetStatistics(wxVirtualDataViewStats &rStats) const
+{
+    wxVirtualPerfCounters::GetStats(rStats);
+}
+
+/** Reset the performance counters
+  */
+void wxVirtualDataViewCtrl::ResetStatistics(void)
+{
+    wxVirtualPerfCounters::Reset();
+}
+
 //----------------- COMPATIBILITY LAYER WITH WXDATAVIEWCTRL ---------//
 #if WX_USE_COMPATIBILITY_LAYER_WITH_DVC != 0
 /** Associate a new data model
@@ -12,6 +12,7 @@
 #endif
 
 #include <wx/VirtualDataView/DataView/VirtualDataViewEvent.h>
+#include <wx/VirtualDataView/StateModels/VirtualIStateModel.h>
 
 //----------------- MACRO IMPLEMENTATIONS ---------------------------//
 wxIMPLEMENT_DYNAMIC_CLASS(wxVirtualDataViewEvent, wxNotifyEvent);
@@ -107,8 +108,8 @@ wxVirtualDataViewEvent::wxVirtualDataViewEvent(wxEventType eType,
       m_uiHitTestFlags(0),
       m_ptRelativePos(-1, -1),
       m_KeyEvent(),
-      m_vDeselectedItems(),
-      m_vSelectedItems()
+      m_SelectionDelta(),
+      m_pStateModel(WX_VDV_NULL_PTR)
 #if wxUSE_DRAG_AND_DROP
         , m_pDataObject(WX_VDV_NULL_PTR),
         m_DataFormat(),
@@ -138,8 +139,8 @@ wxVirtualDataViewEvent::wxVirtualDataViewEvent(const wxVirtualDataViewEvent &rhs
       m_uiHitTestFlags(rhs.m_uiHitTestFlags),
       m_ptRelativePos(rhs.m_ptRelativePos),
       m_KeyEvent(rhs.m_KeyEvent),
-      m_vDeselectedItems(rhs.m_vDeselectedItems),
-      m_vSelectedItems(rhs.m_vSelectedItems)
+      m_SelectionDelta(rhs.m_SelectionDelta),
+      m_pStateModel(rhs.m_pStateModel)
 #if wxUSE_DRAG_AND_DROP
         , m_pDataObject(rhs.m_pDataObject),
         m_DataFormat(rhs.m_DataFormat),
@@ -202,58 +203,120 @@ size_t wxVirtualDataViewEvent::GetFieldIndex(void) const
 
 
 //-------------- SELECTION CHANGED / CHANGING -----------------------//
-/** Set the de-selected items (copy performed).
+/** Set the change of selection (copy performed)
+  * Valid only for wxEVT_VDV_SELECTION_CHANGING and wxEVT_VDV_SELECTION_CHANGED
+  * \param rDelta [input]: the description of the change. A copy is performed
+  */
+void wxVirtualDataViewEvent::SetSelectionDelta(const wxVirtualSelectionDelta &rDelta)
+{
+    m_SelectionDelta = rDelta;
+}
+
+/** Set the change of selection (move performed)
+  * Valid only for wxEVT_VDV_SELECTION_CHANGING and wxEVT_VDV_SELECTION_CHANGED
+  * \param rDelta [input]: the description of the change. A swap is performed
+  */
+void wxVirtualDataViewEvent::AssignSelectionDelta(wxVirtualSelectionDelta &rDelta)
+{
+    m_SelectionDelta.Swap(rDelta);
+}
+
+/** Get the change of selection
+  * Valid only for wxEVT_VDV_SELECTION_CHANGING and wxEVT_VDV_SELECTION_CHANGED
+  * \return the description of the change: global changes (select all / deselect all),
+  *         ranges and items which are selected or deselected
+  */
+const wxVirtualSelectionDelta& wxVirtualDataViewEvent::GetSelectionDelta(void) const
+{
+    return(m_SelectionDelta);
+}
+
+/** Set the items which are deselected (copy performed).
   * Valid only for wxEVT_VDV_SELECTION_CHANGING and wxEVT_VDV_SELECTION_CHANGED
   * \param vIDs [input]: the list of de-selected items. A copy is performed
   */
 void wxVirtualDataViewEvent::SetDeselectedItems(const wxVirtualItemIDs &vIDs)
 {
-    m_vDeselectedItems = vIDs;
+    m_SelectionDelta.DeselectedItems() = vIDs;
 }
 
-/** Set the de-selected items (move performed)
+/** Set the items which are deselected (move performed)
   * Valid only for wxEVT_VDV_SELECTION_CHANGING and wxEVT_VDV_SELECTION_CHANGED
   * \param vIDs [input]: the list of de-selected items. A swap is performed
   */
 void wxVirtualDataViewEvent::AssignDeselectedItems(wxVirtualItemIDs &vIDs)
 {
-    m_vDeselectedItems.swap(vIDs);
+    m_SelectionDelta.DeselectedItems().swap(vIDs);
 }
 
-/** Get the de-selected items
+/** Get the items which are deselected
   * Valid only for wxEVT_VDV_SELECTION_CHANGING and wxEVT_VDV_SELECTION_CHANGED
+  * Ranges and global changes are not included: see GetSelectionDelta()
   * \return the list of de-selected items
   */
 const wxVirtualItemIDs& wxVirtualDataViewEvent::GetDeselectedItems(void) const
 {
-    return(m_vDeselectedItems);
+    return(m_SelectionDelta.GetDeselectedItems());
 }
 
-/** Set the selected items (copy performed).
+/** Set the items which are selected (copy performed).
   * Valid only for wxEVT_VDV_SELECTION_CHANGING and wxEVT_VDV_SELECTION_CHANGED
   * \param vIDs [input]: the list of selected items. A copy is performed
   */
 void wxVirtualDataViewEvent::SetSelectedItems(const wxVirtualItemIDs &vIDs)
 {
-    m_vSelectedItems = vIDs;
+    m_SelectionDelta.SelectedItems() = vIDs;
 }
 
-/** Set the selected items (move performed)
+/** Set the items which are selected (move performed)
   * Valid only for wxEVT_VDV_SELECTION_CHANGING and wxEVT_VDV_SELECTION_CHANGED
   * \param vIDs [input]: the list of selected items. A swap is performed
   */
 void wxVirtualDataViewEvent::AssignSelectedItems(wxVirtualItemIDs &vIDs)
 {
-    m_vSelectedItems.swap(vIDs);
+    m_SelectionDelta.SelectedItems().swap(vIDs);
 }
 
-/** Get the selected items
+/** Get the items which are selected
   * Valid only for wxEVT_VDV_SELECTION_CHANGING and wxEVT_VDV_SELECTION_CHANGED
+  * Ranges and global changes are not included: see GetSelectionDelta()
   * \return the list of selected items
   */
 const wxVirtualItemIDs& wxVirtualDataViewEvent::GetSelectedItems(void) const
 {
-    return(m_vSelectedItems);
+    return(m_SelectionDelta.GetSelectedItems());
+}
+
+/** Set the state model holding the selection
+  * \param pStateModel [input]: the state model. Ownership is not taken
+  */
+void wxVirtualDataViewEvent::SetStateModel(wxVirtualIStateModel *pStateModel)
+{
+    m_pStateModel = pStateModel;
+}
+
+/** Get the full selection. It is computed only when this method is called
+  * Valid only for wxEVT_VDV_SELECTION_CHANGING (selection before the change)
+  * and wxEVT_VDV_SELECTION_CHANGED (selection after the change)
+  * \param vIDs [output]: the selected items. Previous content is lost
+  * \return the amount of selected items
+  */
+size_t wxVirtualDataViewEvent::GetCurrentSelection(wxVirtualItemIDs &vIDs) const
+{
+    vIDs.clear();
+    if (m_pStateModel) m_pStateModel->GetSelectedItems(vIDs);
+    return(vIDs.size());
+}
+
+/** Get the amount of selected items. It is computed only when this method is called
+  * Valid only for wxEVT_VDV_SELECTION_CHANGING (selection before the change)
+  * and wxEVT_VDV_SELECTION_CHANGED (selection after the change)
+  * \return the amount of selected items
+  */
+size_t wxVirtualDataViewEvent::GetCurrentSelectionCount(void) const
+{
+    if (!m_pStateModel) return(0);
+    return(m_pStateModel->GetSelectedItemCount());
 }
 
 //--------------------------- COLUMN --------------------------------//
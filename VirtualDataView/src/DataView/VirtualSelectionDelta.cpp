@@ -0,0 +1,212 @@
+/**********************************************************************/
+/** FILE    : VirtualSelectionDelta.cpp                              **/
+/** PROJECT : wxVirtualDataViewCtrl                                  **/
+/** LICENSE : wxWindows Library Licence                              **/
+/** PURPOSE : description of a change of selection                   **/
+/**********************************************************************/
+
+#include <wx/VirtualDataView/DataView/VirtualSelectionDelta.h>
+
+//-------------- CONSTRUCTORS & DESTRUCTOR --------------------------//
+/** Constructor
+  */
+wxVirtualSelectionDelta::wxVirtualSelectionDelta(void)
+    : m_bDeselectAll(false),
+      m_bSelectAll(false)
+{
+}
+
+/** Destructor
+  */
+wxVirtualSelectionDelta::~wxVirtualSelectionDelta(void)
+{
+}
+
+//------------------------- GENERAL ---------------------------------//
+/** Clear the description
+  */
+void wxVirtualSelectionDelta::Clear(void)
+{
+    m_bDeselectAll = false;
+    m_bSelectAll   = false;
+    m_vSelectedItems.clear();
+    m_vDeselectedItems.clear();
+    m_vSelectedRanges.clear();
+    m_vDeselectedRanges.clear();
+}
+
+/** Check if no change is described
+  * \return true if no change is described
+  */
+bool wxVirtualSelectionDelta::IsEmpty(void) const
+{
+    if (m_bDeselectAll) return(false);
+    if (m_bSelectAll) return(false);
+    if (m_vSelectedItems.size() > 0) return(false);
+    if (m_vDeselectedItems.size() > 0) return(false);
+    if (m_vSelectedRanges.size() > 0) return(false);
+    if (m_vDeselectedRanges.size() > 0) return(false);
+    return(true);
+}
+
+/** Swap the content with another object
+  * \param rhs [input/output]: the object to swap with
+  */
+void wxVirtualSelectionDelta::Swap(wxVirtualSelectionDelta &rhs)
+{
+    bool bTemp = m_bDeselectAll;
+    m_bDeselectAll = rhs.m_bDeselectAll;
+    rhs.m_bDeselectAll = bTemp;
+
+    bTemp = m_bSelectAll;
+    m_bSelectAll = rhs.m_bSelectAll;
+    rhs.m_bSelectAll = bTemp;
+
+    m_vSelectedItems.swap(rhs.m_vSelectedItems);
+    m_vDeselectedItems.swap(rhs.m_vDeselectedItems);
+    m_vSelectedRanges.swap(rhs.m_vSelectedRanges);
+    m_vDeselectedRanges.swap(rhs.m_vDeselectedRanges);
+}
+
+//---------------------- GLOBAL CHANGES -----------------------------//
+/** Set if all items are deselected first
+  * \param bDeselectAll [input]: true if all the items are deselected before the other changes
+  */
+void wxVirtualSelectionDelta::SetDeselectAll(bool bDeselectAll)
+{
+    m_bDeselectAll = bDeselectAll;
+}
+
+/** Check if all items are deselected first
+  * \return true if all the items are deselected before the other changes
+  */
+bool wxVirtualSelectionDelta::IsDeselectAll(void) const
+{
+    return(m_bDeselectAll);
+}
+
+/** Set if all items are selected
+  * \param bSelectAll [input]: true if all the items are selected
+  */
+void wxVirtualSelectionDelta::SetSelectAll(bool bSelectAll)
+{
+    m_bSelectAll = bSelectAll;
+}
+
+/** Check if all items are selected
+  * \return true if all the items are selected
+  */
+bool wxVirtualSelectionDelta::IsSelectAll(void) const
+{
+    return(m_bSelectAll);
+}
+
+//--------------------------- ITEMS ---------------------------------//
+/** Add a selected / deselected item
+  * \param rID     [input]: the item
+  * \param bSelect [input]: true if the item is selected, false if it is deselected
+  */
+void wxVirtualSelectionDelta::AddItem(const wxVirtualItemID &rID, bool bSelect)
+{
+    if (bSelect) m_vSelectedItems.push_back(rID);
+    else         m_vDeselectedItems.push_back(rID);
+}
+
+/** Add a list of selected / deselected items
+  * \param vIDs    [input]: the items
+  * \param bSelect [input]: true if the items are selected, false if they are deselected
+  */
+void wxVirtualSelectionDelta::AddItems(const wxVirtualItemIDs &vIDs, bool bSelect)
+{
+    wxVirtualItemIDs &rItems = bSelect ? m_vSelectedItems : m_vDeselectedItems;
+    size_t i, uiCount;
+    uiCount = vIDs.size();
+    rItems.reserve(rItems.size() + uiCount);
+    for(i=0;i<uiCount;i++) rItems.push_back(vIDs[i]);
+}
+
+/** Get the selected items
+  * \return the list of items which are selected
+  */
+const wxVirtualItemIDs& wxVirtualSelectionDelta::GetSelectedItems(void) const
+{
+    return(m_vSelectedItems);
+}
+
+/** Get the deselected items
+  * \return the list of items which are deselected
+  */
+const wxVirtualItemIDs& wxVirtualSelectionDelta::GetDeselectedItems(void) const
+{
+    return(m_vDeselectedItems);
+}
+
+/** Get the selected items (read/write)
+  * \return the list of items which are selected
+  */
+wxVirtualItemIDs& wxVirtualSelectionDelta::SelectedItems(void)
+{
+    return(m_vSelectedItems);
+}
+
+/** Get the deselected items (read/write)
+  * \return the list of items which are deselected
+  */
+wxVirtualItemIDs& wxVirtualSelectionDelta::DeselectedItems(void)
+{
+    return(m_vDeselectedItems);
+}
+
+//--------------------------- RANGES --------------------------------//
+/** Add a selected / deselected range
+  * \param rFirst  [input]: the first item of the range
+  * \param rLast   [input]: the last item of the range (included)
+  * \param bSelect [input]: true if the range is selected, false if it is deselected
+  */
+void wxVirtualSelectionDelta::AddRange(const wxVirtualItemID &rFirst,
+                                       const wxVirtualItemID &rLast, bool bSelect)
+{
+    wxVirtualItemIDs &rRanges = bSelect ? m_vSelectedRanges : m_vDeselectedRanges;
+    rRanges.push_back(rFirst);
+    rRanges.push_back(rLast);
+}
+
+/** Get the amount of selected ranges
+  * \return the amount of selected ranges
+  */
+size_t wxVirtualSelectionDelta::GetSelectedRangeCount(void) const
+{
+    return(m_vSelectedRanges.size() / 2);
+}
+
+/** Get a selected range
+  * \param uiRange [input] : the index of the range. Must be < GetSelectedRangeCount()
+  * \param rFirst  [output]: the first item of the range
+  * \param rLast   [output]: the last item of the range (included)
+  */
+void wxVirtualSelectionDelta::GetSelectedRange(size_t uiRange, wxVirtualItemID &rFirst,
+                                               wxVirtualItemID &rLast) const
+{
+    rFirst = m_vSelectedRanges[2 * uiRange];
+    rLast  = m_vSelectedRanges[2 * uiRange + 1];
+}
+
+/** Get the amount of deselected ranges
+  * \return the amount of deselected ranges
+  */
+size_t wxVirtualSelectionDelta::GetDeselectedRangeCount(void) const
+{
+    return(m_vDeselectedRanges.size() / 2);
+}
+
+/** Get a deselected range
+  * \param uiRange [input] : the index of the range. Must be < GetDeselectedRangeCount()
+  * \param rFirst  [output]: the first item of the range
+  * \param rLast   [output]: the last item of the range (included)
+  */
+void wxVirtualSelectionDelta::GetDeselectedRange(size_t uiRange, wxVirtualItemID &rFirst,
+                                                 wxVirtualItemID &rLast) const
+{
+    rFirst = m_vDeselectedRanges[2 * uiRange];
+    rLast  = m_vDeselectedRanges[2 * uiRange + 1];
+}
@@ -6,15 +6,20 @@
 /**********************************************************************/
 
 #include <wx/VirtualDataView/Filters/VirtualDataViewFilter.h>
+#include <wx/VirtualDataView/Types/VirtualValue.h>
+
+//last revision given to a filter
+static size_t s_uiLastFilterRevision = 0;
 
 //---------------- CONSTRUCTORS & DESTRUCTOR ------------------------//
 /** Constructor
   */
 wxVirtualDataViewFilter::wxVirtualDataViewFilter(void)
     : m_bIsActive(false),
-      m_bIsRecursive(true)
+      m_bIsRecursive(true),
+      m_uiRevision(0)
 {
-
+    OnFilterChanged();
 }
 
 /** Destructor
@@ -24,6 +29,45 @@ wxVirtualDataViewFilter::~wxVirtualDataViewFilter(void)
 
 }
 
+//------------------------ INTERFACE --------------------------------//
+/** Accept or reject a value, as returned by wxVirtualIDataModel::GetItemValue()
+  * \param rValue [input]: the value to test
+  * \return true if the value is accepted (it will be displayed)
+  *         false if the value is rejected (it will be hidden)
+  *
+  * The default implementation converts the value to a wxVariant and calls AcceptValue().
+  * Reimplement it for testing inline values directly
+  */
+bool wxVirtualDataViewFilter::AcceptItemValue(const wxVirtualValue &rValue)
+{
+    if (rValue.IsVariant()) return(AcceptValue(rValue.GetVariant()));
+    return(AcceptValue(rValue.ToVariant()));
+}
+
+/** Get the type of the filter
+  * \return the type of the filter. Filters of the same type can be compared by IsRefinementOf()
+  *         The default implementation returns an empty string (unknown type)
+  */
+wxString wxVirtualDataViewFilter::GetFilterType(void) const
+{
+    return(wxEmptyString);
+}
+
+/** Check if the filter accepts a subset of another filter
+  * \param rOther [input]: the other filter
+  * \return true if all values accepted by this filter are also accepted by rOther.
+  *         false if it is not the case, or if it cannot be determined
+  *
+  * This is used for incremental filtering: when a filter is replaced by a refinement of it
+  * (for example, when a character is added to a searched string), only the items accepted by
+  * the old filter need to be evaluated by the new one.
+  * The default implementation returns false (no incremental filtering)
+  */
+bool wxVirtualDataViewFilter::IsRefinementOf(const wxVirtualDataViewFilter &rOther) const
+{
+    return(false);
+}
+
 //--------------------- INTERNAL METHODS ----------------------------//
 /** Copy base object
   */
@@ -31,6 +75,16 @@ void wxVirtualDataViewFilter::CopyBase(const wxVirtualDataViewFilter &rhs)
 {
     m_bIsActive     = rhs.m_bIsActive;
     m_bIsRecursive  = rhs.m_bIsRecursive;
+    OnFilterChanged();
+}
+
+/** The filter criteria changed : get a new revision
+  * Must be called by derived classes each time AcceptValue() may give different results
+  */
+void wxVirtualDataViewFilter::OnFilterChanged(void)
+{
+    s_uiLastFilterRevision++;
+    m_uiRevision = s_uiLastFilterRevision;
 }
 
 //------------------------ INFORMATION ------------------------------//
@@ -97,3 +151,18 @@ void wxVirtualDataViewFilter::SetRecursive(bool bRecursive)
 {
     m_bIsRecursive = bRecursive;
 }
+
+//---------------------- REVISION -----------------------------------//
+/** Get the revision of the filter criteria
+  * \return the revision of the filter criteria
+  *
+  * The revision changes each time the criteria of the filter change (AcceptValue() may give
+  * different results). It is unique among all filters: 2 filters objects never share the same
+  * revision, even if one is allocated at the address of a deleted one.
+  * It is used to keep the results of a filter (see wxVirtualDataViewFiltersList)
+  * The activation state and the recursivity do not change the revision
+  */
+size_t wxVirtualDataViewFilter::GetRevision(void) const
+{
+    return(m_uiRevision);
+}
@@ -8,12 +8,20 @@
 #include <wx/VirtualDataView/Filters/VirtualDataViewFiltersList.h>
 #include <wx/VirtualDataView/Filters/VirtualDataViewFilter.h>
 #include <wx/VirtualDataView/Models/VirtualIDataModel.h>
+#include <wx/VirtualDataView/Types/VirtualValue.h>
+#include <wx/VirtualDataView/Utilities/PerfCounters.h>
+
+//amount of items fetched by 1 call to GetItemDataBatch()
+static const size_t s_uiBatchSize = 1024;
 
 //---------------- CONSTRUCTORS & DESTRUCTOR ------------------------//
 /** Constructor
   */
 wxVirtualDataViewFiltersList::wxVirtualDataViewFiltersList(void)
-    : m_vFilters()
+    : m_vFilters(),
+      m_bColumnarEvaluation(true),
+      m_pCachedDataModel(WX_VDV_NULL_PTR),
+      m_pAcceptanceDataModel(WX_VDV_NULL_PTR)
 {
 
 }
@@ -22,7 +30,7 @@ wxVirtualDataViewFiltersList::wxVirtualDataViewFiltersList(void)
   */
 wxVirtualDataViewFiltersList::~wxVirtualDataViewFiltersList(void)
 {
-
+    ClearCachedResults();
 }
 
 //-------------------- LIST MANAGEMENT ------------------------------//
@@ -222,6 +230,20 @@ bool wxVirtualDataViewFiltersList::AcceptValue(const wxVariant& rvValue, size_t
 bool wxVirtualDataViewFiltersList::IsAccepted(const wxVirtualItemID &rID,
                                               wxVirtualIDataModel *pDataModel)
 {
+    ValidateAcceptanceCache(pDataModel);
+    return(DoIsAccepted(rID, pDataModel));
+}
+
+
+/** Accept or reject an item from a wxVirtualIDataModel
+  * The recursivity of the filters is ignored.
+  * \param rID          [input]: the ID of the item to check
+  * \param pDataModel   [input]: the data model to which the ID belongs
+  */
+bool wxVirtualDataViewFiltersList::IsAcceptedNonRecursive(const wxVirtualItemID &rID,
+                                                          wxVirtualIDataModel *pDataModel)
+{
+    wxVirtualValue oValue;
     TFilters::const_iterator it     = m_vFilters.begin();
     TFilters::const_iterator itEnd  = m_vFilters.end();
     while (it != itEnd)
@@ -231,25 +253,9 @@ bool wxVirtualDataViewFiltersList::IsAccepted(const wxVirtualItemID &rID,
         {
             if (rFilter.m_pFilter->IsActive())
             {
-                wxVariant vValue = pDataModel->GetItemData(rID, rFilter.m_uiField,
-                                                           wxVirtualIDataModel::WX_ITEM_MAIN_DATA);
-                if (!rFilter.m_pFilter->AcceptValue(vValue))
-                {
-                    bool bRecursive = rFilter.m_pFilter->IsRecursive();
-                    if (!bRecursive) return(false);
-
-                    //scan children
-                    wxVirtualItemIDs vChildren;
-                    pDataModel->GetAllChildren(vChildren, rID);
-                    size_t uiNbChildren = vChildren.size();
-                    size_t uiChild;
-                    for(uiChild = 0; uiChild < uiNbChildren; uiChild++)
-                    {
-                        wxVirtualItemID &rIDChild = vChildren[uiChild];
-                        if (IsAccepted(rIDChild, pDataModel)) return(true);
-                    }
-                    return(false);
-                }
+                pDataModel->GetItemValue(oValue, rID, rFilter.m_uiField,
+                                         wxVirtualIDataModel::WX_ITEM_MAIN_DATA);
+                if (!rFilter.m_pFilter->AcceptItemValue(oValue)) return(false);
             }
         }
 
@@ -258,15 +264,78 @@ bool wxVirtualDataViewFiltersList::IsAccepted(const wxVirtualItemID &rID,
     return(true);
 }
 
+/** Filter a list of items from a wxVirtualIDataModel
+  * \param vFilteredIDs     [output]: the list of filtered item IDs
+  * \param vUnfilteredIDs   [input] : the list of item IDs to test. Order is preserved in output
+  * \param pDataModel       [input]: the data model to which the ID belong
+  */
+void wxVirtualDataViewFiltersList::FilterItems(wxVirtualItemIDs &vFilteredIDs,
+                                               const wxVirtualItemIDs &vUnfilteredIDs,
+                                               wxVirtualIDataModel *pDataModel)
+{
+    WX_VDV_PERF_TIMER(WX_PERF_FILTER);
+    WX_VDV_PERF_COUNT(WX_PERF_ITEMS_FILTERED, vUnfilteredIDs.size());
+
+    if (m_bColumnarEvaluation)
+    {
+        FilterItemsColumnar(vFilteredIDs, vUnfilteredIDs, pDataModel);
+        return;
+    }
 
-/** Accept or reject an item from a wxVirtualIDataModel
-  * The recursivity of the filters is ignored.
+    vFilteredIDs.clear();
+
+    size_t uiSize = vUnfilteredIDs.size();
+    if (uiSize == 0) return;
+
+    ValidateAcceptanceCache(pDataModel);
+
+    size_t i, uiChildIndex;
+    uiChildIndex = 0;
+    for(i = 0; i < uiSize; i++)
+    {
+        const wxVirtualItemID &rID = vUnfilteredIDs[i];
+        if (DoIsAccepted(rID, pDataModel))
+        {
+            vFilteredIDs.push_back(rID);
+            vFilteredIDs[uiChildIndex].SetChildIndex(uiChildIndex);
+            uiChildIndex++;
+        }
+    }
+}
+
+//-------------------- RECURSIVE FILTERS ----------------------------//
+/** Accept or reject an item, using the memorized results
+  * ValidateAcceptanceCache() must have been called before
   * \param rID          [input]: the ID of the item to check
   * \param pDataModel   [input]: the data model to which the ID belongs
+  * \return true if the item is accepted
   */
-bool wxVirtualDataViewFiltersList::IsAcceptedNonRecursive(const wxVirtualItemID &rID,
-                                                          wxVirtualIDataModel *pDataModel)
+bool wxVirtualDataViewFiltersList::DoIsAccepted(const wxVirtualItemID &rID,
+                                                wxVirtualIDataModel *pDataModel)
+{
+    THashMapAcceptance::iterator it = m_MapOfAcceptance.find(rID);
+    if (it != m_MapOfAcceptance.end()) return(it->second);
+
+    bool bRecursive = false;
+    if (IsAcceptedByItself(rID, pDataModel, bRecursive)) return(true);
+    if (!bRecursive) return(false);
+
+    //scan children
+    return(IsAcceptedByChildren(rID, pDataModel));
+}
+
+/** Accept or reject an item, without looking at its children
+  * \param rID          [input] : the ID of the item to check
+  * \param pDataModel   [input] : the data model to which the ID belongs
+  * \param bRecursive   [output]: if the item is rejected, true if the 1st filter rejecting it
+  *                               is recursive. In this case, the children must be examined
+  * \return true if the item is accepted by all active filters
+  */
+bool wxVirtualDataViewFiltersList::IsAcceptedByItself(const wxVirtualItemID &rID,
+                                                      wxVirtualIDataModel *pDataModel,
+                                                      bool &bRecursive)
 {
+    wxVirtualValue oValue;
     TFilters::const_iterator it     = m_vFilters.begin();
     TFilters::const_iterator itEnd  = m_vFilters.end();
     while (it != itEnd)
@@ -276,9 +345,13 @@ bool wxVirtualDataViewFiltersList::IsAcceptedNonRecursive(const wxVirtualItemID
         {
             if (rFilter.m_pFilter->IsActive())
             {
-                wxVariant vValue = pDataModel->GetItemData(rID, rFilter.m_uiField,
-                                                           wxVirtualIDataModel::WX_ITEM_MAIN_DATA);
-                if (!rFilter.m_pFilter->AcceptValue(vValue)) return(false);
+                pDataModel->GetItemValue(oValue, rID, rFilter.m_uiField,
+                                         wxVirtualIDataModel::WX_ITEM_MAIN_DATA);
+                if (!rFilter.m_pFilter->AcceptItemValue(oValue))
+                {
+                    bRecursive = rFilter.m_pFilter->IsRecursive();
+                    return(false);
+                }
             }
         }
 
@@ -287,28 +360,353 @@ bool wxVirtualDataViewFiltersList::IsAcceptedNonRecursive(const wxVirtualItemID
     return(true);
 }
 
-/** Filter a list of items from a wxVirtualIDataModel
+/** Check if at least 1 child of an item is accepted
+  * \param rID          [input]: the parent item
+  * \param pDataModel   [input]: the data model to which the ID belongs
+  * \return true if at least 1 child is accepted (recursively)
+  *
+  * The sub-tree is scanned in post-order with an explicit stack. The result of each item which
+  * needed a scan of its children is memorized: an item is evaluated at most once until the filters
+  * or the data change. The scan of the children of an item stops at the 1st accepted child.
+  */
+bool wxVirtualDataViewFiltersList::IsAcceptedByChildren(const wxVirtualItemID &rID,
+                                                        wxVirtualIDataModel *pDataModel)
+{
+    THashMapAcceptance::iterator it = m_MapOfAcceptance.find(rID);
+    if (it != m_MapOfAcceptance.end()) return(it->second);
+
+    std::vector<TAcceptanceFrame> vStack;
+    vStack.push_back(TAcceptanceFrame());
+    vStack.back().m_ID          = rID;
+    vStack.back().m_uiNextChild = 0;
+    vStack.back().m_bAccepted   = false;
+    pDataModel->GetAllChildren(vStack.back().m_vChildren, rID);
+
+    bool bAccepted = false;
+    while (!vStack.empty())
+    {
+        TAcceptanceFrame &rFrame = vStack.back();
+
+        //all children examined, or 1 accepted child found : the item is done
+        if ((rFrame.m_bAccepted) || (rFrame.m_uiNextChild >= rFrame.m_vChildren.size()))
+        {
+            bAccepted = rFrame.m_bAccepted;
+            m_MapOfAcceptance[rFrame.m_ID] = bAccepted;
+            vStack.pop_back();
+            if ((bAccepted) && (!vStack.empty())) vStack.back().m_bAccepted = true;
+            continue;
+        }
+
+        //examine the next child
+        wxVirtualItemID idChild = rFrame.m_vChildren[rFrame.m_uiNextChild];
+        rFrame.m_uiNextChild++;
+
+        it = m_MapOfAcceptance.find(idChild);
+        if (it != m_MapOfAcceptance.end())
+        {
+            if (it->second) rFrame.m_bAccepted = true;
+            continue;
+        }
+
+        bool bRecursive = false;
+        if (IsAcceptedByItself(idChild, pDataModel, bRecursive))
+        {
+            rFrame.m_bAccepted = true;
+            continue;
+        }
+        if (!bRecursive) continue;
+
+        //the child depends on its own children
+        vStack.push_back(TAcceptanceFrame());
+        vStack.back().m_ID          = idChild;
+        vStack.back().m_uiNextChild = 0;
+        vStack.back().m_bAccepted   = false;
+        pDataModel->GetAllChildren(vStack.back().m_vChildren, idChild);
+    }
+    return(bAccepted);
+}
+
+/** Drop the memorized acceptance if the filters changed
+  * \param pDataModel [input]: the data model to which the items belong
+  */
+void wxVirtualDataViewFiltersList::ValidateAcceptanceCache(wxVirtualIDataModel *pDataModel)
+{
+    //compare the current filters with the memorized states
+    bool bChanged = (pDataModel != m_pAcceptanceDataModel);
+    size_t uiIndex = 0;
+    size_t uiNbStates = m_vAcceptanceStates.size();
+    TFilters::const_iterator it     = m_vFilters.begin();
+    TFilters::const_iterator itEnd  = m_vFilters.end();
+    while ((it != itEnd) && (!bChanged))
+    {
+        const TFilter &rFilter = *it;
+        ++it;
+        if (!rFilter.m_pFilter) continue;
+        if (uiIndex >= uiNbStates) {bChanged = true; break;}
+
+        const TFilterState &rState = m_vAcceptanceStates[uiIndex];
+        if (rState.m_uiField    != rFilter.m_uiField)                   bChanged = true;
+        if (rState.m_uiRevision != rFilter.m_pFilter->GetRevision())    bChanged = true;
+        if (rState.m_bActive    != rFilter.m_pFilter->IsActive())       bChanged = true;
+        if (rState.m_bRecursive != rFilter.m_pFilter->IsRecursive())    bChanged = true;
+        uiIndex++;
+    }
+    if (uiIndex != uiNbStates) bChanged = true;
+    if (!bChanged) return;
+
+    //memorize the new states
+    m_MapOfAcceptance.clear();
+    m_vAcceptanceStates.clear();
+    m_pAcceptanceDataModel = pDataModel;
+    it = m_vFilters.begin();
+    while (it != itEnd)
+    {
+        const TFilter &rFilter = *it;
+        ++it;
+        if (!rFilter.m_pFilter) continue;
+
+        TFilterState t;
+        t.m_uiField     = rFilter.m_uiField;
+        t.m_uiRevision  = rFilter.m_pFilter->GetRevision();
+        t.m_bActive     = rFilter.m_pFilter->IsActive();
+        t.m_bRecursive  = rFilter.m_pFilter->IsRecursive();
+        m_vAcceptanceStates.push_back(t);
+    }
+}
+
+//---------------------- COLUMNAR EVALUATION ------------------------//
+/** Check if the filters are evaluated column by column
+  * \return true if the filters are evaluated column by column
+  *         false if they are evaluated item by item
+  */
+bool wxVirtualDataViewFiltersList::UsesColumnarEvaluation(void) const
+{
+    return(m_bColumnarEvaluation);
+}
+
+/** Evaluate the filters column by column, or item by item
+  * \param bColumnar [input]: true for columnar evaluation, false for item by item evaluation
+  */
+void wxVirtualDataViewFiltersList::UseColumnarEvaluation(bool bColumnar)
+{
+    m_bColumnarEvaluation = bColumnar;
+    if (!bColumnar) ClearCachedResults();
+}
+
+/** Clear the results kept for each filter
+  * Must be called when the values of the items changed
+  */
+void wxVirtualDataViewFiltersList::ClearCachedResults(void)
+{
+    DeleteCachedFilters();
+    m_vCachedResults.clear();
+    m_pCachedDataModel  = WX_VDV_NULL_PTR;
+    m_vCachedIDs.clear();
+
+    m_MapOfAcceptance.clear();
+    m_vAcceptanceStates.clear();
+    m_pAcceptanceDataModel = WX_VDV_NULL_PTR;
+}
+
+/** Delete the copies of the filters kept in m_vCachedResults
+  */
+void wxVirtualDataViewFiltersList::DeleteCachedFilters(void)
+{
+    TFilterResults::iterator it    = m_vCachedResults.begin();
+    TFilterResults::iterator itEnd = m_vCachedResults.end();
+    while (it != itEnd)
+    {
+        if (it->m_pFilter) delete(it->m_pFilter);
+        it->m_pFilter = WX_VDV_NULL_PTR;
+        ++it;
+    }
+}
+
+/** Find kept results of a filter refined by rFilter
+  * \param rFilter [input]: the new filter
+  * \return the kept results of a filter on the same field, which accepts a superset of the
+  *         values accepted by rFilter. NULL if there are none
+  */
+wxVirtualDataViewFiltersList::TFilterResult* wxVirtualDataViewFiltersList::FindRefinedResult(const TFilter &rFilter)
+{
+    TFilterResults::iterator it    = m_vCachedResults.begin();
+    TFilterResults::iterator itEnd = m_vCachedResults.end();
+    while (it != itEnd)
+    {
+        TFilterResult &rResult = *it;
+        ++it;
+        if (rResult.m_uiField != rFilter.m_uiField) continue;
+        if (!rResult.m_pFilter) continue;
+        if (rFilter.m_pFilter->IsRefinementOf(*rResult.m_pFilter)) return(&rResult);
+    }
+    return(WX_VDV_NULL_PTR);
+}
+
+/** Evaluate 1 filter for a list of items
+  * \param rResult      [output]: the results of the filter
+  * \param rFilter      [input] : the filter to evaluate
+  * \param vIDs         [input] : the items to evaluate
+  * \param pDataModel   [input] : the data model to which the items belong
+  * \param pCandidates  [input] : if not NULL, only the items whose bit is set are evaluated.
+  *                               The other items are rejected
+  */
+void wxVirtualDataViewFiltersList::EvaluateFilter(TFilterResult &rResult, const TFilter &rFilter,
+                                                  const wxVirtualItemIDs &vIDs,
+                                                  wxVirtualIDataModel *pDataModel,
+                                                  const wxBitArray *pCandidates)
+{
+    size_t uiSize = vIDs.size();
+    size_t uiField = rFilter.m_uiField;
+    wxVirtualDataViewFilter *pFilter = rFilter.m_pFilter;
+
+    rResult.m_uiField    = uiField;
+    rResult.m_uiRevision = pFilter->GetRevision();
+    rResult.m_pFilter    = pFilter->Clone();
+    rResult.m_vAccepted.Resize(uiSize, false);
+
+    //the values are fetched by chunks of items
+    wxVirtualIDataModel::TFieldIDs vFields(1, uiField);
+    wxVirtualItemIDs vChunk;
+    wxVector<size_t> vIndices;
+    wxVirtualValues vValues;
+    vChunk.reserve(s_uiBatchSize);
+    vIndices.reserve(s_uiBatchSize);
+
+    size_t i, j, uiChunkSize;
+    i = 0;
+    if (pCandidates) i = pCandidates->FindNext(0);
+    while (i < uiSize)
+    {
+        vChunk.clear();
+        vIndices.clear();
+        while ((i < uiSize) && (vChunk.size() < s_uiBatchSize))
+        {
+            vChunk.push_back(vIDs[i]);
+            vIndices.push_back(i);
+            if (pCandidates) i = pCandidates->FindNext(i + 1);
+            else             i++;
+        }
+
+        pDataModel->GetItemDataBatch(vValues, vChunk, vFields,
+                                     wxVirtualIDataModel::WX_ITEM_MAIN_DATA);
+
+        uiChunkSize = vChunk.size();
+        for(j = 0; j < uiChunkSize; j++)
+        {
+            if (pFilter->AcceptItemValue(vValues[j])) rResult.m_vAccepted.Set(vIndices[j]);
+        }
+    }
+}
+
+/** Filter a list of items from a wxVirtualIDataModel, column by column
   * \param vFilteredIDs     [output]: the list of filtered item IDs
   * \param vUnfilteredIDs   [input] : the list of item IDs to test. Order is preserved in output
   * \param pDataModel       [input]: the data model to which the ID belong
+  *
+  * Each active filter is evaluated on all items (1 call to GetItemDataBatch per chunk of items & filter),
+  * unless its results for the same list of items are still available.
+  * If the filter is a refinement of a kept filter, only the items accepted by the kept filter
+  * are evaluated.
+  * Items rejected by a recursive filter are then checked item by item (children scan).
   */
-void wxVirtualDataViewFiltersList::FilterItems(wxVirtualItemIDs &vFilteredIDs,
-                                               const wxVirtualItemIDs &vUnfilteredIDs,
-                                               wxVirtualIDataModel *pDataModel)
+void wxVirtualDataViewFiltersList::FilterItemsColumnar(wxVirtualItemIDs &vFilteredIDs,
+                                                       const wxVirtualItemIDs &vUnfilteredIDs,
+                                                       wxVirtualIDataModel *pDataModel)
 {
     vFilteredIDs.clear();
 
     size_t uiSize = vUnfilteredIDs.size();
     if (uiSize == 0) return;
 
-    size_t i, uiChildIndex;
-    uiChildIndex = 0;
+    ValidateAcceptanceCache(pDataModel);
+
+    //the kept results are valid only for the same list of items
+    size_t i;
+    bool bSameItems = ((pDataModel == m_pCachedDataModel) && (uiSize == m_vCachedIDs.size()));
+    for(i = 0; (bSameItems) && (i < uiSize); i++)
+    {
+        if (vUnfilteredIDs[i] != m_vCachedIDs[i]) bSameItems = false;
+    }
+    if (!bSameItems)
+    {
+        DeleteCachedFilters();
+        m_vCachedResults.clear();
+        m_pCachedDataModel  = pDataModel;
+        m_vCachedIDs        = vUnfilteredIDs;
+    }
+
+    //get the results of each active filter. Results of removed filters are dropped
+    std::vector<const TFilter*> vActiveFilters;
+    TFilterResults vResults;
+    bool bHasRecursiveFilter = false;
+    TFilters::const_iterator it     = m_vFilters.begin();
+    TFilters::const_iterator itEnd  = m_vFilters.end();
+    while (it != itEnd)
+    {
+        const TFilter &rFilter = *it;
+        ++it;
+        if (!rFilter.m_pFilter) continue;
+        if (!rFilter.m_pFilter->IsActive()) continue;
+
+        vActiveFilters.push_back(&rFilter);
+        if (rFilter.m_pFilter->IsRecursive()) bHasRecursiveFilter = true;
+
+        vResults.push_back(TFilterResult());
+        TFilterResult &rResult = vResults.back();
+        rResult.m_pFilter = WX_VDV_NULL_PTR;
+
+        size_t uiRevision = rFilter.m_pFilter->GetRevision();
+        TFilterResults::iterator itCached    = m_vCachedResults.begin();
+        TFilterResults::iterator itCachedEnd = m_vCachedResults.end();
+        while (itCached != itCachedEnd)
+        {
+            if ((itCached->m_uiField == rFilter.m_uiField) && (itCached->m_uiRevision == uiRevision)) break;
+            ++itCached;
+        }
+
+        if (itCached != itCachedEnd)
+        {
+            //unchanged filter : reuse the results, and take ownership of the copy of the filter
+            rResult = *itCached;
+            itCached->m_pFilter = WX_VDV_NULL_PTR;
+            continue;
+        }
+
+        //more restrictive filter : evaluate only the items accepted by the previous one
+        TFilterResult *pRefined = FindRefinedResult(rFilter);
+        if (pRefined) EvaluateFilter(rResult, rFilter, vUnfilteredIDs, pDataModel, &pRefined->m_vAccepted);
+        else          EvaluateFilter(rResult, rFilter, vUnfilteredIDs, pDataModel, WX_VDV_NULL_PTR);
+    }
+    DeleteCachedFilters();
+    m_vCachedResults = vResults;
+
+    //combine the results
+    size_t uiNbFilters = vResults.size();
+    size_t uiFilter;
+    wxBitArray vAccepted(uiSize, true);
+    for(uiFilter = 0; uiFilter < uiNbFilters; uiFilter++) vAccepted.And(vResults[uiFilter].m_vAccepted);
+
+    //compact
+    size_t uiChildIndex = 0;
     for(i = 0; i < uiSize; i++)
     {
-        const wxVirtualItemID &rID = vUnfilteredIDs[i];
-        if (IsAccepted(rID, pDataModel))
+        bool bAccepted = vAccepted.Get(i);
+        if ((!bAccepted) && (bHasRecursiveFilter))
         {
-            vFilteredIDs.push_back(rID);
+            //same rule as IsAccepted(): the 1st rejecting filter decides
+            for(uiFilter = 0; uiFilter < uiNbFilters; uiFilter++)
+            {
+                if (!vResults[uiFilter].m_vAccepted.Get(i)) break;
+            }
+            if (vActiveFilters[uiFilter]->m_pFilter->IsRecursive())
+            {
+                bAccepted = IsAcceptedByChildren(vUnfilteredIDs[i], pDataModel);
+            }
+        }
+
+        if (bAccepted)
+        {
+            vFilteredIDs.push_back(vUnfilteredIDs[i]);
             vFilteredIDs[uiChildIndex].SetChildIndex(uiChildIndex);
             uiChildIndex++;
         }
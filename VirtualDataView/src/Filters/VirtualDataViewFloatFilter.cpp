@@ -6,6 +6,7 @@
 /**********************************************************************/
 
 #include <wx/VirtualDataView/Filters/VirtualDataViewFloatFilter.h>
+#include <wx/VirtualDataView/Types/VirtualValue.h>
 
 //---------------- CONSTRUCTORS & DESTRUCTOR ------------------------//
 /** Constructor
@@ -31,6 +32,28 @@ void wxVirtualDataViewFloatFilter::CopyFloat(const wxVirtualDataViewFloatFilter
     CopyNumeric(rhs);
 }
 
+/** Accept or reject a floating point value, with the comparison operator
+  * \param fValue [input]: the value to test
+  * \return true if the value is accepted (it will be displayed)
+  *         false if the value is rejected (it will be hidden)
+  */
+bool wxVirtualDataViewFloatFilter::AcceptDouble(double fValue) const
+{
+    double fRefValue = m_vReferenceValue.GetDouble();
+
+    switch(m_eOperator)
+    {
+        case WX_E_EQUAL                     : return(fValue == fRefValue);
+        case WX_E_NOT_EQUAL                 : return(fValue != fRefValue);
+        case WX_E_GREATER_THAN              : return(fValue >  fRefValue);
+        case WX_E_GREATER_THAN_OR_EQUAL     : return(fValue >= fRefValue);
+        case WX_E_LESS_THAN                 : return(fValue <  fRefValue);
+        case WX_E_LESS_THAN_OR_EQUAL        : return(fValue <= fRefValue);
+        default                             : break;
+    }
+    return(true);
+}
+
 //--------------------- INTERFACE -----------------------------------//
 /** Clone the filter
   * \return a copy of this filter, allocated with "new"
@@ -50,20 +73,26 @@ wxVirtualDataViewFilter* wxVirtualDataViewFloatFilter::Clone(void) const
 bool wxVirtualDataViewFloatFilter::AcceptValue(const wxVariant& rvValue)
 {
     if (m_bUseStringMatching) return(AcceptString(rvValue));
+    return(AcceptDouble(rvValue.GetDouble()));
+}
 
-    double fRefValue = m_vReferenceValue.GetDouble();
-    double fValue    = rvValue.GetDouble();
-
-    switch(m_eOperator)
-    {
-        case WX_E_EQUAL                     : return(fValue == fRefValue);
-        case WX_E_NOT_EQUAL                 : return(fValue != fRefValue);
-        case WX_E_GREATER_THAN              : return(fValue >  fRefValue);
-        case WX_E_GREATER_THAN_OR_EQUAL     : return(fValue >= fRefValue);
-        case WX_E_LESS_THAN                 : return(fValue <  fRefValue);
-        case WX_E_LESS_THAN_OR_EQUAL        : return(fValue <= fRefValue);
-        default                             : break;
-    }
-    return(true);
+/** Accept or reject a value, as returned by wxVirtualIDataModel::GetItemValue()
+  * Inline numbers are compared directly, without creating a wxVariant
+  * \param rValue [input]: the value to test
+  * \return true if the value is accepted (it will be displayed)
+  *         false if the value is rejected (it will be hidden)
+  */
+bool wxVirtualDataViewFloatFilter::AcceptItemValue(const wxVirtualValue &rValue)
+{
+    double fValue;
+    if ((!m_bUseStringMatching) && (rValue.IsNumeric()) && (rValue.ToDouble(fValue))) return(AcceptDouble(fValue));
+    return(wxVirtualDataViewNumericFilter::AcceptItemValue(rValue));
 }
 
+/** Get the type of the filter
+  * \return "float"
+  */
+wxString wxVirtualDataViewFloatFilter::GetFilterType(void) const
+{
+    return("float");
+}
@@ -6,6 +6,7 @@
 /**********************************************************************/
 
 #include <wx/VirtualDataView/Filters/VirtualDataViewIntegerFilter.h>
+#include <wx/VirtualDataView/Types/VirtualValue.h>
 
 //---------------- CONSTRUCTORS & DESTRUCTOR ------------------------//
 /** Constructor
@@ -31,28 +32,29 @@ void wxVirtualDataViewIntegerFilter::CopyInteger(const wxVirtualDataViewIntegerF
     CopyNumeric(rhs);
 }
 
-//--------------------- INTERFACE -----------------------------------//
-/** Clone the filter
-  * \return a copy of this filter, allocated with "new"
+/** Compare the reference value to another value
+  * \param rvValue [input]: the value to compare with
+  * \return < 0 if the reference value is smaller than rvValue
+  *         0   if both values are equal
+  *         > 0 if the reference value is greater than rvValue
   */
-wxVirtualDataViewFilter* wxVirtualDataViewIntegerFilter::Clone(void) const
+int wxVirtualDataViewIntegerFilter::CompareReferenceValue(const wxVariant &rvValue) const
 {
-    wxVirtualDataViewIntegerFilter *pFilter = new wxVirtualDataViewIntegerFilter;
-    pFilter->CopyInteger(*this);
-    return(pFilter);
+    wxLongLong lRefValue = m_vReferenceValue.GetLongLong();
+    wxLongLong lValue    = rvValue.GetLongLong();
+    if (lRefValue < lValue) return(-1);
+    if (lRefValue > lValue) return(1);
+    return(0);
 }
 
-/** Accept or reject a value
-  * \param rvValue [input]: the value to test
+/** Accept or reject an integer, with the comparison operator
+  * \param lValue [input]: the value to test
   * \return true if the value is accepted (it will be displayed)
   *         false if the value is rejected (it will be hidden)
   */
-bool wxVirtualDataViewIntegerFilter::AcceptValue(const wxVariant& rvValue)
+bool wxVirtualDataViewIntegerFilter::AcceptLongLong(const wxLongLong &lValue) const
 {
-    if (m_bUseStringMatching) return(AcceptString(rvValue));
-
     wxLongLong lRefValue = m_vReferenceValue.GetLongLong();
-    wxLongLong lValue    = rvValue.GetLongLong();
 
     switch(m_eOperator)
     {
@@ -67,3 +69,46 @@ bool wxVirtualDataViewIntegerFilter::AcceptValue(const wxVariant& rvValue)
     return(true);
 }
 
+//--------------------- INTERFACE -----------------------------------//
+/** Clone the filter
+  * \return a copy of this filter, allocated with "new"
+  */
+wxVirtualDataViewFilter* wxVirtualDataViewIntegerFilter::Clone(void) const
+{
+    wxVirtualDataViewIntegerFilter *pFilter = new wxVirtualDataViewIntegerFilter;
+    pFilter->CopyInteger(*this);
+    return(pFilter);
+}
+
+/** Accept or reject a value
+  * \param rvValue [input]: the value to test
+  * \return true if the value is accepted (it will be displayed)
+  *         false if the value is rejected (it will be hidden)
+  */
+bool wxVirtualDataViewIntegerFilter::AcceptValue(const wxVariant& rvValue)
+{
+    if (m_bUseStringMatching) return(AcceptString(rvValue));
+    return(AcceptLongLong(rvValue.GetLongLong()));
+}
+
+/** Accept or reject a value, as returned by wxVirtualIDataModel::GetItemValue()
+  * Inline integers are compared directly, without creating a wxVariant
+  * \param rValue [input]: the value to test
+  * \return true if the value is accepted (it will be displayed)
+  *         false if the value is rejected (it will be hidden)
+  */
+bool wxVirtualDataViewIntegerFilter::AcceptItemValue(const wxVirtualValue &rValue)
+{
+    wxInt64 iValue;
+    if ((!m_bUseStringMatching) && (rValue.ToInt64(iValue))) return(AcceptLongLong(wxLongLong(iValue)));
+    return(wxVirtualDataViewNumericFilter::AcceptItemValue(rValue));
+}
+
+/** Get the type of the filter
+  * \return "integer"
+  */
+wxString wxVirtualDataViewIntegerFilter::GetFilterType(void) const
+{
+    return("integer");
+}
+
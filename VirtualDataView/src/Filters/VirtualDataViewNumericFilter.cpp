@@ -6,6 +6,7 @@
 /**********************************************************************/
 
 #include <wx/VirtualDataView/Filters/VirtualDataViewNumericFilter.h>
+#include <wx/VirtualDataView/Types/VirtualValue.h>
 
 //---------------- CONSTRUCTORS & DESTRUCTOR ------------------------//
 /** Constructor
@@ -35,6 +36,83 @@ void wxVirtualDataViewNumericFilter::CopyNumeric(const wxVirtualDataViewNumericF
     m_bUseStringMatching    = rhs.m_bUseStringMatching;
 }
 
+/** Compare the reference value to another value
+  * \param rvValue [input]: the value to compare with
+  * \return < 0 if the reference value is smaller than rvValue
+  *         0   if both values are equal
+  *         > 0 if the reference value is greater than rvValue
+  * The default implementation compares the values as floating point numbers
+  */
+int wxVirtualDataViewNumericFilter::CompareReferenceValue(const wxVariant &rvValue) const
+{
+    double fRefValue = m_vReferenceValue.GetDouble();
+    double fValue    = rvValue.GetDouble();
+    if (fRefValue < fValue) return(-1);
+    if (fRefValue > fValue) return(1);
+    return(0);
+}
+
+//--------------------- INTERFACE -----------------------------------//
+/** Accept or reject a value, as returned by wxVirtualIDataModel::GetItemValue()
+  * With string matching, the value is tested as wxVirtualDataViewStringFilter does.
+  * With numeric matching, the value is converted to a wxVariant and given to AcceptValue()
+  * \param rValue [input]: the value to test
+  * \return true if the value is accepted (it will be displayed)
+  *         false if the value is rejected (it will be hidden)
+  */
+bool wxVirtualDataViewNumericFilter::AcceptItemValue(const wxVirtualValue &rValue)
+{
+    if (m_bUseStringMatching) return(AcceptString(rValue));
+    return(wxVirtualDataViewFilter::AcceptItemValue(rValue));
+}
+
+/** Check if the filter accepts a subset of another filter
+  * \param rOther [input]: the other filter
+  * \return true if all values accepted by this filter are also accepted by rOther.
+  *         With numeric matching, the filters must have the same type, and:
+  *             - "==" and "!=" : same operator and same reference value
+  *             - ">" and ">="  : the lower bound is raised (or unchanged)
+  *             - "<" and "<="  : the upper bound is lowered (or unchanged)
+  *         With string matching, see wxVirtualDataViewStringFilter::IsRefinementOf
+  */
+bool wxVirtualDataViewNumericFilter::IsRefinementOf(const wxVirtualDataViewFilter &rOther) const
+{
+    if (rOther.GetFilterType() != GetFilterType()) return(false);
+    const wxVirtualDataViewNumericFilter &rOtherNumeric = (const wxVirtualDataViewNumericFilter &) rOther;
+
+    if (m_bUseStringMatching != rOtherNumeric.m_bUseStringMatching) return(false);
+    if (m_bUseStringMatching) return(IsStringRefinementOf(rOtherNumeric));
+
+    //compare the bounds : iCmp > 0 if this reference value is greater than the other one
+    int iCmp = CompareReferenceValue(rOtherNumeric.m_vReferenceValue);
+    EOperator eOther = rOtherNumeric.m_eOperator;
+    switch(m_eOperator)
+    {
+        case WX_E_EQUAL                     :
+        case WX_E_NOT_EQUAL                 :
+            return((eOther == m_eOperator) && (iCmp == 0));
+
+        case WX_E_GREATER_THAN              :
+        case WX_E_GREATER_THAN_OR_EQUAL     :
+            if ((eOther != WX_E_GREATER_THAN) && (eOther != WX_E_GREATER_THAN_OR_EQUAL)) return(false);
+            if (iCmp > 0) return(true);
+            if (iCmp < 0) return(false);
+            //same bound : "x >= a" is not a refinement of "x > a"
+            return((m_eOperator == WX_E_GREATER_THAN) || (eOther == WX_E_GREATER_THAN_OR_EQUAL));
+
+        case WX_E_LESS_THAN                 :
+        case WX_E_LESS_THAN_OR_EQUAL        :
+            if ((eOther != WX_E_LESS_THAN) && (eOther != WX_E_LESS_THAN_OR_EQUAL)) return(false);
+            if (iCmp < 0) return(true);
+            if (iCmp > 0) return(false);
+            //same bound : "x <= a" is not a refinement of "x < a"
+            return((m_eOperator == WX_E_LESS_THAN) || (eOther == WX_E_LESS_THAN_OR_EQUAL));
+
+        default                             : break;
+    }
+    return(false);
+}
+
 //--------------------------- OPERATOR ------------------------------//
 /** Get the comparison operator
   * \return the comparison operator
@@ -50,6 +128,7 @@ wxVirtualDataViewNumericFilter::EOperator wxVirtualDataViewNumericFilter::GetCom
 void wxVirtualDataViewNumericFilter::SetComparisonOperator(EOperator eOperator)
 {
     m_eOperator = eOperator;
+    OnFilterChanged();
 }
 
 //----------------- STRING MATCHING & NUMERIC MATCHING --------------//
@@ -78,6 +157,7 @@ bool wxVirtualDataViewNumericFilter::IsNumericMatchingUsed(void) const
 void wxVirtualDataViewNumericFilter::UseStringMatch(bool bUseStringMatching)
 {
     m_bUseStringMatching = bUseStringMatching;
+    OnFilterChanged();
 }
 
 /** Toggle the use of numeric matching / string matching
@@ -87,4 +167,5 @@ void wxVirtualDataViewNumericFilter::UseStringMatch(bool bUseStringMatching)
 void wxVirtualDataViewNumericFilter::UseNumericMatching(bool bUseNumericMatching)
 {
     m_bUseStringMatching = !bUseNumericMatching;
+    OnFilterChanged();
 }
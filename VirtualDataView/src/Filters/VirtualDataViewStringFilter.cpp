@@ -7,6 +7,7 @@
 
 #include <wx/VirtualDataView/Filters/VirtualDataViewStringFilter.h>
 #include <wx/VirtualDataView/Types/VariantUtils.h>
+#include <wx/VirtualDataView/Types/VirtualValue.h>
 #include <wx/variant.h>
 #include <wx/dc.h>
 #include <wx/app.h>
@@ -53,6 +54,8 @@ void wxVirtualDataViewStringFilter::CopyString(const wxVirtualDataViewStringFilt
   */
 void wxVirtualDataViewStringFilter::CompileRegEx(void)
 {
+    OnFilterChanged();
+
     //not RegEx search : copy the string(s), and put them in upper case
     //for case insensitive search
     //The reference value can contains more than 1 string
@@ -101,11 +104,41 @@ void wxVirtualDataViewStringFilter::CompileRegEx(void)
   */
 bool wxVirtualDataViewStringFilter::AcceptString(const wxVariant& rvValue)
 {
-    //get value
-    wxString sValue = GetStringValue(rvValue);
+    return(AcceptText(GetStringValue(rvValue)));
+}
 
-    //capitalize if needed
-    if (!m_bCaseSensitive) sValue.MakeLower();
+/** Accept or reject a value based on its string representation
+  * \param rValue [input]: the value to test
+  * \return true if the value is accepted (it will be displayed)
+  *         false if the value is rejected (it will be hidden)
+  */
+bool wxVirtualDataViewStringFilter::AcceptString(const wxVirtualValue &rValue)
+{
+    switch(rValue.GetType())
+    {
+        case wxVirtualValue::WX_VALUE_STRING    : return(AcceptText(rValue.GetStringRef()));
+        case wxVirtualValue::WX_VALUE_VARIANT   : return(AcceptString(rValue.GetVariant()));
+        default                                 : break;
+    }
+    return(AcceptText(rValue.GetString()));
+}
+
+/** Accept or reject a string
+  * \param rsValue [input]: the string to test
+  * \return true if the string is accepted (it will be displayed)
+  *         false if the string is rejected (it will be hidden)
+  */
+bool wxVirtualDataViewStringFilter::AcceptText(const wxString &rsValue)
+{
+    //capitalize if needed : the string is copied only in this case
+    wxString sLowerValue;
+    const wxString *pValue = &rsValue;
+    if (!m_bCaseSensitive)
+    {
+        sLowerValue = rsValue.Lower();
+        pValue = &sLowerValue;
+    }
+    const wxString &sValue = *pValue;
 
     //match
     if (m_bRegEx)
@@ -173,6 +206,76 @@ bool wxVirtualDataViewStringFilter::AcceptValue(const wxVariant& rvValue)
     return(AcceptString(rvValue));
 }
 
+/** Accept or reject a value, as returned by wxVirtualIDataModel::GetItemValue()
+  * \param rValue [input]: the value to test
+  * \return true if the value is accepted (it will be displayed)
+  *         false if the value is rejected (it will be hidden)
+  */
+bool wxVirtualDataViewStringFilter::AcceptItemValue(const wxVirtualValue &rValue)
+{
+    return(AcceptString(rValue));
+}
+
+/** Get the type of the filter
+  * \return "string"
+  */
+wxString wxVirtualDataViewStringFilter::GetFilterType(void) const
+{
+    return("string");
+}
+
+/** Check if the filter accepts a subset of another filter
+  * \param rOther [input]: the other filter
+  * \return true if all values accepted by this filter are also accepted by rOther.
+  */
+bool wxVirtualDataViewStringFilter::IsRefinementOf(const wxVirtualDataViewFilter &rOther) const
+{
+    if (rOther.GetFilterType() != GetFilterType()) return(false);
+    const wxVirtualDataViewStringFilter &rOtherString = (const wxVirtualDataViewStringFilter &) rOther;
+    return(IsStringRefinementOf(rOtherString));
+}
+
+/** Check if the string matching accepts a subset of another filter
+  * \param rOther [input]: the other filter
+  * \return true if all values accepted by this filter are also accepted by rOther.
+  *         Regular expressions are never considered as refinements
+  *         Partial match: each searched string must contain one of the strings searched by rOther
+  *                        ("error" is a refinement of "err")
+  *         Full match   : each searched string must be searched by rOther
+  *                        (the set of values is reduced)
+  */
+bool wxVirtualDataViewStringFilter::IsStringRefinementOf(const wxVirtualDataViewStringFilter &rOther) const
+{
+    if ((m_bRegEx) || (rOther.m_bRegEx)) return(false);
+    if (m_bCaseSensitive != rOther.m_bCaseSensitive) return(false);
+    if (m_bFullMatch != rOther.m_bFullMatch) return(false);
+
+    size_t uiNbStrings = m_sSearchedString.Count();
+    size_t uiNbOtherStrings = rOther.m_sSearchedString.Count();
+    size_t uiString, uiOtherString;
+    for(uiString = 0; uiString < uiNbStrings; uiString++)
+    {
+        const wxString &rsSearchedString = m_sSearchedString[uiString];
+        if (m_bFullMatch)
+        {
+            if (rOther.m_SetOfStrings.find(rsSearchedString) == rOther.m_SetOfStrings.end()) return(false);
+            continue;
+        }
+
+        bool bFound = false;
+        for(uiOtherString = 0; uiOtherString < uiNbOtherStrings; uiOtherString++)
+        {
+            if (rsSearchedString.Find(rOther.m_sSearchedString[uiOtherString]) != wxNOT_FOUND)
+            {
+                bFound = true;
+                break;
+            }
+        }
+        if (!bFound) return(false);
+    }
+    return(true);
+}
+
 //---------------------------- PATTERN ------------------------------//
 /** Get the string pattern
   * \return the string pattern
@@ -308,6 +411,7 @@ bool wxVirtualDataViewStringFilter::IsPartialMatchAllowed(void) const
 void wxVirtualDataViewStringFilter::UseFullMatchOnly(bool bFullMatchOnly)
 {
     m_bFullMatch = bFullMatchOnly;
+    OnFilterChanged();
 }
 
 /** Switch partial match ON/OFF
@@ -317,4 +421,5 @@ void wxVirtualDataViewStringFilter::UseFullMatchOnly(bool bFullMatchOnly)
 void wxVirtualDataViewStringFilter::UsePartialMatch(bool bPartialMatch)
 {
     m_bFullMatch = !bPartialMatch;
+    OnFilterChanged();
 }
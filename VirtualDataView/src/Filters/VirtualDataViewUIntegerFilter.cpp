@@ -31,6 +31,21 @@ void wxVirtualDataViewUIntegerFilter::CopyUInteger(const wxVirtualDataViewUInteg
     CopyNumeric(rhs);
 }
 
+/** Compare the reference value to another value
+  * \param rvValue [input]: the value to compare with
+  * \return < 0 if the reference value is smaller than rvValue
+  *         0   if both values are equal
+  *         > 0 if the reference value is greater than rvValue
+  */
+int wxVirtualDataViewUIntegerFilter::CompareReferenceValue(const wxVariant &rvValue) const
+{
+    wxULongLong lRefValue = m_vReferenceValue.GetULongLong();
+    wxULongLong lValue    = rvValue.GetULongLong();
+    if (lRefValue < lValue) return(-1);
+    if (lRefValue > lValue) return(1);
+    return(0);
+}
+
 //--------------------- INTERFACE -----------------------------------//
 /** Clone the filter
   * \return a copy of this filter, allocated with "new"
@@ -67,3 +82,11 @@ bool wxVirtualDataViewUIntegerFilter::AcceptValue(const wxVariant& rvValue)
     return(true);
 }
 
+/** Get the type of the filter
+  * \return "uinteger"
+  */
+wxString wxVirtualDataViewUIntegerFilter::GetFilterType(void) const
+{
+    return("uinteger");
+}
+
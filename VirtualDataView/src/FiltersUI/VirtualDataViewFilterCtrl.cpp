@@ -19,6 +19,7 @@
 #include <wx/VirtualDataView/StateModels/VirtualListStateModel.h>
 #include <wx/VirtualDataView/ModelRenderer/VirtualListModelRenderer.h>
 #include <wx/VirtualDataView/Types/VariantUtils.h>
+#include <wx/VirtualDataView/Utilities/PerfCounters.h>
 #include <wx/hashset.h>
 #include <wx/log.h>
 
@@ -176,6 +177,7 @@ void wxVirtualDataViewFilterCtrl::InitFilter(wxVirtualIDataModel *pSrcModel, siz
 
     if (pSrcModel)
     {
+        WX_VDV_PERF_TIMER(WX_PERF_GET_ALL_VALUES);
         pSrcModel->GetAllValues(vValues, uiField, pStateModel);
     }
 
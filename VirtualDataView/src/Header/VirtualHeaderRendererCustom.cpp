@@ -6,6 +6,7 @@
 /**********************************************************************/
 
 #include <wx/VirtualDataView/Header/VirtualHeaderRendererCustom.h>
+#include <wx/VirtualDataView/Utilities/VirtualTextExtentCache.h>
 #include <wx/settings.h>
 #include <wx/window.h>
 
@@ -348,7 +349,9 @@ wxSize wxVirtualHeaderRendererCustom::GetHeaderButtonSize(const THeaderData &rDa
 
         wxFont f = m_Settings[eSettings].m_Font;
         if (!f.IsOk()) f = m_pWindow->GetFont();
-        m_pWindow->GetTextExtent(rData.m_sLabel, &w, &h, WX_VDV_NULL_PTR, WX_VDV_NULL_PTR, &f);
+        wxSize sTextSize = wxVirtualTextExtentCache::GetTextExtent(m_pWindow, rData.m_sLabel, f);
+        w = sTextSize.GetWidth();
+        h = sTextSize.GetHeight();
 
         w += 2 * m_iMarginX;
         h += 2 * m_iMarginY;
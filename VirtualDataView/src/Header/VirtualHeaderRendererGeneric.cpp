@@ -6,6 +6,7 @@
 /**********************************************************************/
 
 #include <wx/VirtualDataView/Header/VirtualHeaderRendererGeneric.h>
+#include <wx/VirtualDataView/Utilities/VirtualTextExtentCache.h>
 #include <wx/dcclient.h>
 #include <wx/window.h>
 
@@ -66,7 +67,7 @@ WX_VDV_INLINE wxSize DoGetHeaderButtonSize(wxWindow *pWin,
     int iMargin    = GetRenderer().GetHeaderButtonMargin(pWin);
 
     //text width
-    wxSize sTextSize = rDC.GetTextExtent(rData.m_sLabel);
+    wxSize sTextSize = wxVirtualTextExtentCache::GetTextExtent(rDC, rData.m_sLabel);
     int iTextWidth = sTextSize.GetWidth();
     if ((iTextWidth > iWidth) || (iWidth <= iMargin)) iWidth = iTextWidth + iMargin;
 
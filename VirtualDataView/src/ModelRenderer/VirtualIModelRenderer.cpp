@@ -10,6 +10,7 @@
 #include <wx/VirtualDataView/Models/VirtualIDataModel.h>
 #include <wx/dcclient.h>
 #include <wx/dcbuffer.h>
+#include <wx/hashset.h>
 
 //-------------------- CONSTRUCTORS & DESTRUCTOR --------------------//
 /** Constructor
@@ -75,6 +76,18 @@ void wxVirtualIModelRenderer::SetScrollerWindow(wxWindow* pScroller)
 }
 
 //--------------------- INTERFACE -----------------------------------//
+/** Paint only a part of the model
+  * The default implementation paints the whole model
+  * \param rDC         [input]: the device context to use
+  * \param rUpdateRect [input]: the area to repaint, in client coordinates.
+  *                            An empty rectangle means the whole client area
+  * \return true on success, false on failure (painting incomplete or not done at all)
+  */
+bool wxVirtualIModelRenderer::PaintRect(wxDC &rDC, const wxRect &WXUNUSED(rUpdateRect))
+{
+    return(PaintModel(rDC));
+}
+
 /** Refresh the display
   */
 void wxVirtualIModelRenderer::Refresh(void)
@@ -98,6 +111,35 @@ wxSize wxVirtualIModelRenderer::GetBestSize(size_t uiColID) const
     return(GetBestSize());
 }
 
+/** Get the best size of a column, with a measuring strategy
+  * The default implementation ignores the strategy and measures the whole column
+  * \param uiColID      [input] : the column ID to measure (view coord)
+  * \param eMode        [input] : the measuring strategy
+  * \param uiSampleSize [input] : for WX_AUTOSIZE_SAMPLED, the amount of rows to sample
+  * \return the best size of the column
+  */
+wxSize wxVirtualIModelRenderer::GetBestSize(size_t uiColID, EAutoSizeMode eMode,
+                                            size_t uiSampleSize) const
+{
+    return(GetBestSize(uiColID));
+}
+
+/** Measure the next items of a column
+  * This allows measuring a large column in several steps, for example during idle time.
+  * The default implementation measures the whole column in one step
+  * \param rMeasure   [input/output]: the state of the measurement. Initialize m_uiColID,
+  *                                   m_uiField, and set m_bStarted to false before the 1st call.
+  *                                   m_iWidth contains the best width found so far
+  * \param uiMaxItems [input]       : the maximal amount of items to measure in this step
+  * \return true if the measurement is finished, false if more items remain
+  */
+bool wxVirtualIModelRenderer::MeasureColumn(TColumnMeasure &rMeasure, size_t uiMaxItems) const
+{
+    rMeasure.m_bStarted = true;
+    rMeasure.m_iWidth   = GetBestSize(rMeasure.m_uiColID).GetWidth();
+    return(true);
+}
+
 /** Get the 1st visible item
   * \return the 1st visible item
   */
@@ -197,3 +239,71 @@ size_t wxVirtualIModelRenderer::GetAllVisibleItems(wxVirtualItemIDs &vIDs) const
 
     return(vIDs.size());
 }
+
+//--------------------- CALLBACKS -----------------------------------//
+/** Called by the client to notify that the children of an item changed
+  * \param rParent [input]: the item whose children were inserted / removed / re-ordered
+  * The default implementation calls OnDataModelChanged()
+  */
+void wxVirtualIModelRenderer::OnChildrenChanged(const wxVirtualItemID &rParent)
+{
+    OnDataModelChanged();
+}
+
+/** Called by the client to notify that some items were inserted
+  * \param rParent [input]: the parent of the new items
+  * \param uiFirst [input]: the child index of the 1st new item
+  * \param uiCount [input]: the amount of new items
+  * \return true if the renderer updated the display itself, false if the client must be repainted
+  * The default implementation calls OnChildrenChanged() and returns false
+  */
+bool wxVirtualIModelRenderer::OnItemsInserted(const wxVirtualItemID &rParent,
+                                              size_t uiFirst, size_t uiCount)
+{
+    OnChildrenChanged(rParent);
+    return(false);
+}
+
+/** Called by the client to notify that some items were removed
+  * \param rParent [input]: the parent of the removed items
+  * \param uiFirst [input]: the child index of the 1st removed item
+  * \param uiCount [input]: the amount of removed items
+  * \return true if the renderer updated the display itself, false if the client must be repainted
+  * The default implementation calls OnChildrenChanged() and returns false
+  */
+bool wxVirtualIModelRenderer::OnItemsRemoved(const wxVirtualItemID &rParent,
+                                             size_t uiFirst, size_t uiCount)
+{
+    OnChildrenChanged(rParent);
+    return(false);
+}
+
+WX_DECLARE_HASH_SET(wxVirtualItemID, wxVirtualItemIDHash, wxVirtualItemIDEqual, TSetOfVisibleIDs);
+
+/** Called by the client to notify that the values of some items changed
+  * \param vIDs [input]: the items which changed
+  * Only the rows of the visible items which changed are refreshed
+  */
+void wxVirtualIModelRenderer::OnItemsChanged(const wxVirtualItemIDs &vIDs)
+{
+    if (!m_pClient) return;
+
+    wxVirtualItemIDs vVisibleIDs;
+    size_t i, uiNbVisible;
+    uiNbVisible = GetAllVisibleItems(vVisibleIDs);
+    if (uiNbVisible == 0) return;
+
+    TSetOfVisibleIDs setVisible;
+    for(i = 0; i < uiNbVisible; i++) setVisible.insert(vVisibleIDs[i]);
+
+    int iClientWidth = m_pClient->GetClientSize().GetWidth();
+    size_t uiNbItems = vIDs.size();
+    for(i = 0; i < uiNbItems; i++)
+    {
+        if (setVisible.find(vIDs[i]) == setVisible.end()) continue;
+
+        wxRect r;
+        if (!GetItemRect(r, vIDs[i], 0, true)) continue;
+        m_pClient->RefreshRect(wxRect(0, r.y, iClientWidth, r.height), false);
+    }
+}
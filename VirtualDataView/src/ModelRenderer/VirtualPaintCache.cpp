@@ -0,0 +1,253 @@
+/**********************************************************************/
+/** FILE    : VirtualPaintCache.cpp                                  **/
+/** PROJECT : wxVirtualDataViewCtrl                                  **/
+/** LICENSE : wxWindows Library Licence                              **/
+/** PURPOSE : GDI objects & attributes reused while painting         **/
+/**********************************************************************/
+
+#include <wx/VirtualDataView/ModelRenderer/VirtualPaintCache.h>
+#include <wx/VirtualDataView/Utilities/PerfCounters.h>
+
+//maximal sizes of the lists
+static const size_t s_uiMaxGDIObjects = 64;         ///< \brief maximal amount of brushes, pens, fonts
+static const size_t s_uiMaxAttributes = 256;        ///< \brief maximal amount of resolved attributes
+static const size_t s_uiAttrBuckets   = 512;        ///< \brief amount of hash buckets of the resolved attributes (power of 2)
+
+//key of an invalid colour : outside of the 32 bits RGBA values
+static const wxUint64 s_uiInvalidColour = wxUint64(1) << 32;
+
+//---------------- CONSTRUCTORS & DESTRUCTOR ------------------------//
+/** Constructor
+  */
+wxVirtualPaintCache::wxVirtualPaintCache(void)
+{
+    ClearAttributes();
+}
+
+/** Destructor
+  */
+wxVirtualPaintCache::~wxVirtualPaintCache(void)
+{
+}
+
+//---------------------------- GENERAL ------------------------------//
+/** Start a new paint
+  * The resolved attributes are forgotten: the attributes are owned by the models,
+  * and they can change between 2 paints. The GDI objects are kept
+  * \param rDefaultFont [input]: the font of the window, used when the attributes do not define one
+  */
+void wxVirtualPaintCache::BeginPaint(const wxFont &rDefaultFont)
+{
+    ClearAttributes();
+    if (m_DefaultFont != rDefaultFont)
+    {
+        m_DefaultFont = rDefaultFont;
+        m_vFonts.clear();
+    }
+}
+
+/** Release all the objects
+  */
+void wxVirtualPaintCache::Clear(void)
+{
+    m_vBrushes.clear();
+    m_vPens.clear();
+    m_vFonts.clear();
+    ClearAttributes();
+    m_DefaultFont = wxNullFont;
+}
+
+//-------------------------- GDI OBJECTS ----------------------------//
+/** Get a solid brush
+  * \param rColour [input]: the colour of the brush
+  * \return the brush. The reference is valid until the next call to GetBrush()
+  */
+const wxBrush& wxVirtualPaintCache::GetBrush(const wxColour &rColour)
+{
+    wxUint64 uiColour = ToRGBA(rColour);
+    size_t i, uiCount;
+    uiCount = m_vBrushes.size();
+    for(i=0;i<uiCount;i++)
+    {
+        if (m_vBrushes[i].m_uiColour == uiColour) return(m_vBrushes[i].m_Brush);
+    }
+
+    if (uiCount >= s_uiMaxGDIObjects) m_vBrushes.clear();
+
+    TBrush oBrush;
+    oBrush.m_uiColour = uiColour;
+    oBrush.m_Brush    = wxBrush(rColour, wxBRUSHSTYLE_SOLID);
+    m_vBrushes.push_back(oBrush);
+    WX_VDV_PERF_COUNT(WX_PERF_GDI_OBJECTS, 1);
+    return(m_vBrushes.back().m_Brush);
+}
+
+/** Get a pen
+  * \param rColour [input]: the colour of the pen
+  * \param iWidth  [input]: the width of the pen
+  * \param eStyle  [input]: the style of the pen
+  * \return the pen. The reference is valid until the next call to GetPen()
+  */
+const wxPen& wxVirtualPaintCache::GetPen(const wxColour &rColour, int iWidth, wxPenStyle eStyle)
+{
+    wxUint64 uiColour = ToRGBA(rColour);
+    size_t i, uiCount;
+    uiCount = m_vPens.size();
+    for(i=0;i<uiCount;i++)
+    {
+        const TPen &rPen = m_vPens[i];
+        if (rPen.m_uiColour != uiColour) continue;
+        if (rPen.m_iWidth != iWidth)     continue;
+        if (rPen.m_eStyle != eStyle)     continue;
+        return(rPen.m_Pen);
+    }
+
+    if (uiCount >= s_uiMaxGDIObjects) m_vPens.clear();
+
+    TPen oPen;
+    oPen.m_uiColour = uiColour;
+    oPen.m_iWidth   = iWidth;
+    oPen.m_eStyle   = eStyle;
+    oPen.m_Pen      = wxPen(rColour, iWidth, eStyle);
+    m_vPens.push_back(oPen);
+    WX_VDV_PERF_COUNT(WX_PERF_GDI_OBJECTS, 1);
+    return(m_vPens.back().m_Pen);
+}
+
+/** Get a font with bold / italic applied
+  * \param rFont   [input]: the base font
+  * \param bBold   [input]: true for making the font bold
+  * \param bItalic [input]: true for making the font italic
+  * \return the font. The reference is valid until the next call to GetFont()
+  */
+const wxFont& wxVirtualPaintCache::GetFont(const wxFont &rFont, bool bBold, bool bItalic)
+{
+    size_t i, uiCount;
+    uiCount = m_vFonts.size();
+    for(i=0;i<uiCount;i++)
+    {
+        const TFont &rEntry = m_vFonts[i];
+        if (rEntry.m_bBold != bBold)     continue;
+        if (rEntry.m_bItalic != bItalic) continue;
+        if (rEntry.m_BaseFont != rFont)  continue;
+        return(rEntry.m_Font);
+    }
+
+    if (uiCount >= s_uiMaxGDIObjects) m_vFonts.clear();
+
+    TFont oFont;
+    oFont.m_BaseFont = rFont;
+    oFont.m_bBold    = bBold;
+    oFont.m_bItalic  = bItalic;
+    oFont.m_Font     = rFont;
+    if (bBold)   oFont.m_Font.MakeBold();
+    if (bItalic) oFont.m_Font.MakeItalic();
+    m_vFonts.push_back(oFont);
+    WX_VDV_PERF_COUNT(WX_PERF_GDI_OBJECTS, 1);
+    return(m_vFonts.back().m_Font);
+}
+
+//-------------------------- ATTRIBUTES -----------------------------//
+/** Combine 2 attributes & resolve the font
+  * The item attribute takes precedence over the column attribute.
+  * The font of the result is the effective font: the bold / italic flags are already applied
+  * and reset, so wxVirtualDataViewItemAttr::GetEffectiveFont() does not create a new font.
+  * Results are identified by the pointers of the 2 attributes. Since a model can return the
+  * same object with a different content for each item, the content of the item attribute
+  * is compared too
+  * \param pItemAttr [input]: the attribute of the item, from the data model. Can be NULL
+  * \param pColAttr  [input]: the attribute of the column. Can be NULL
+  * \return the resolved attribute. It is valid until the next call to ResolveAttribute() or BeginPaint()
+  *         NULL if both attributes are NULL
+  */
+wxVirtualDataViewItemAttr* wxVirtualPaintCache::ResolveAttribute(wxVirtualDataViewItemAttr *pItemAttr,
+                                                                 wxVirtualDataViewItemAttr *pColAttr)
+{
+    if ((!pItemAttr) && (!pColAttr)) return(WX_VDV_NULL_PTR);
+
+    //look for an existing result
+    size_t uiBucket = GetAttributeBucket(pItemAttr, pColAttr);
+    size_t i = m_vAttrBuckets[uiBucket];
+    while (i != size_t(-1))
+    {
+        TAttr &rEntry = m_vAttrs[i];
+        i = rEntry.m_uiNext;
+        if (rEntry.m_pItemAttr != pItemAttr) continue;
+        if (rEntry.m_pColAttr != pColAttr)   continue;
+        if ((pItemAttr) && (!rEntry.m_Source.IsSame(*pItemAttr))) continue;
+        return(&rEntry.m_Resolved);
+    }
+
+    if (m_vAttrs.size() >= s_uiMaxAttributes) ClearAttributes();
+
+    //combine
+    TAttr oAttr;
+    oAttr.m_pItemAttr = pItemAttr;
+    oAttr.m_pColAttr  = pColAttr;
+    oAttr.m_uiNext    = m_vAttrBuckets[uiBucket];
+    if (pItemAttr)
+    {
+        oAttr.m_Source   = *pItemAttr;
+        oAttr.m_Resolved = *pItemAttr;
+        oAttr.m_Resolved.Combine(pColAttr);
+    }
+    else
+    {
+        oAttr.m_Resolved = *pColAttr;
+    }
+
+    //resolve font
+    wxVirtualDataViewItemAttr &rResolved = oAttr.m_Resolved;
+    if ((rResolved.GetBold()) || (rResolved.GetItalic()))
+    {
+        wxFont oBaseFont = rResolved.GetFont();
+        if (!oBaseFont.IsOk()) oBaseFont = m_DefaultFont;
+        rResolved.SetFont(GetFont(oBaseFont, rResolved.GetBold(), rResolved.GetItalic()));
+        rResolved.SetBold(false);
+        rResolved.SetItalic(false);
+    }
+
+    m_vAttrBuckets[uiBucket] = m_vAttrs.size();
+    m_vAttrs.push_back(oAttr);
+    return(&m_vAttrs.back().m_Resolved);
+}
+
+//----------------------- INTERNAL METHODS --------------------------//
+/** Convert a colour to a key
+  * \param rColour [input]: the colour to convert
+  * \return the RGBA components packed in the 32 lower bits. An invalid colour has its own key,
+  *         different from all the RGBA values (including the fully transparent black)
+  */
+wxUint64 wxVirtualPaintCache::ToRGBA(const wxColour &rColour)
+{
+    if (!rColour.IsOk()) return(s_uiInvalidColour);
+    wxUint64 uiResult = rColour.Red();
+    uiResult |= ((wxUint64) rColour.Green()) << 8;
+    uiResult |= ((wxUint64) rColour.Blue())  << 16;
+    uiResult |= ((wxUint64) rColour.Alpha()) << 24;
+    return(uiResult);
+}
+
+/** Forget the resolved attributes
+  */
+void wxVirtualPaintCache::ClearAttributes(void)
+{
+    m_vAttrs.clear();
+    m_vAttrBuckets.resize(s_uiAttrBuckets);
+    size_t i;
+    for(i=0;i<s_uiAttrBuckets;i++) m_vAttrBuckets[i] = size_t(-1);
+}
+
+/** Get the hash bucket of 2 attributes
+  * \param pItemAttr [input]: the attribute of the item. Can be NULL
+  * \param pColAttr  [input]: the attribute of the column. Can be NULL
+  * \return the index of the bucket in m_vAttrBuckets
+  */
+size_t wxVirtualPaintCache::GetAttributeBucket(wxVirtualDataViewItemAttr *pItemAttr,
+                                               wxVirtualDataViewItemAttr *pColAttr) const
+{
+    size_t uiHash = ((size_t) pItemAttr) >> 4;
+    uiHash = uiHash * 31 + (((size_t) pColAttr) >> 4);
+    uiHash ^= uiHash >> 9;
+    return(uiHash & (s_uiAttrBuckets - 1));
+}
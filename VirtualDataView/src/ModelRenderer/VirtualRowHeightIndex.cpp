@@ -0,0 +1,520 @@
+/**********************************************************************/
+/** FILE    : VirtualRowHeightIndex.cpp                              **/
+/** PROJECT : wxVirtualDataViewCtrl                                  **/
+/** LICENSE : wxWindows Library Licence                              **/
+/** PURPOSE : prefix sum index of variable row heights               **/
+/**********************************************************************/
+
+#include <wx/VirtualDataView/ModelRenderer/VirtualRowHeightIndex.h>
+#include <wx/VirtualDataView/ModelRenderer/VirtualTreeModelRenderer.h>
+#include <wx/VirtualDataView/StateModels/VirtualIStateModel.h>
+#include <wx/VirtualDataView/Models/VirtualIDataModel.h>
+
+//------------------------ NODE DEFINITION --------------------------//
+/** \struct wxVirtualRowHeightNode : data of one indexed node
+  * The Fenwick tree is 1-based : m_vTree[0] is unused
+  * The contribution of child i is the height of its row if the child is collapsed,
+  * the height of its row + the height of its visible sub-tree if it is expanded
+  */
+struct wxVirtualRowHeightNode
+{
+    wxVector<wxInt64>   m_vTree;                                                            ///< \brief Fenwick tree of children contributions
+    wxVector<int>       m_vHeights;                                                         ///< \brief height of each child row
+    wxInt64             m_iSize;                                                            ///< \brief height of the visible descendants (node excluded)
+    size_t              m_uiHighestBit;                                                     ///< \brief highest power of 2 <= amount of children
+};
+
+//----------------------- CONSTRUCTORS & DESTRUCTOR -----------------//
+/** Constructor
+  * \param pRenderer [input]: the renderer measuring the rows
+  */
+wxVirtualRowHeightIndex::wxVirtualRowHeightIndex(wxVirtualTreeModelRenderer *pRenderer)
+    : m_pRenderer(pRenderer), m_pDataModel(WX_VDV_NULL_PTR), m_pStateModel(WX_VDV_NULL_PTR),
+      m_iEstimatedHeight(0), m_iRootHeight(-1)
+{
+
+}
+
+/** Destructor
+  */
+wxVirtualRowHeightIndex::~wxVirtualRowHeightIndex(void)
+{
+    Clear();
+}
+
+//------------------------ MODELS -----------------------------------//
+/** Get the indexed data model
+  * \return the indexed data model
+  */
+wxVirtualIDataModel* wxVirtualRowHeightIndex::GetDataModel(void) const
+{
+    return(m_pDataModel);
+}
+
+/** Get the state model
+  * \return the state model giving the expansion states
+  */
+wxVirtualIStateModel* wxVirtualRowHeightIndex::GetStateModel(void) const
+{
+    return(m_pStateModel);
+}
+
+/** Set the data & state models
+  * \param pDataModel  [input]: the data model to index
+  * \param pStateModel [input]: the state model giving the expansion states
+  * The index is cleared only if one of the models has changed
+  */
+void wxVirtualRowHeightIndex::SetModels(wxVirtualIDataModel *pDataModel,
+                                        wxVirtualIStateModel *pStateModel)
+{
+    if ((pDataModel == m_pDataModel) && (pStateModel == m_pStateModel)) return;
+    Clear();
+    m_pDataModel  = pDataModel;
+    m_pStateModel = pStateModel;
+}
+
+//------------------------ ESTIMATED HEIGHT -------------------------//
+/** Get the estimated row height
+  * \return the estimated row height, with margins. 0 if the rows are measured when indexed
+  */
+int wxVirtualRowHeightIndex::GetEstimatedHeight(void) const
+{
+    return(m_iEstimatedHeight);
+}
+
+/** Set the estimated row height
+  * \param iHeight [input]: the estimated row height, with margins.
+  *                         0 or less for measuring the rows when they are indexed
+  * The index is cleared
+  */
+void wxVirtualRowHeightIndex::SetEstimatedHeight(int iHeight)
+{
+    if (iHeight < 0) iHeight = 0;
+    Clear();
+    m_iEstimatedHeight = iHeight;
+}
+
+//------------------------ MAINTENANCE ------------------------------//
+/** Clear the index
+  * The index will be rebuilt lazily
+  */
+void wxVirtualRowHeightIndex::Clear(void)
+{
+    THashMapRowHeightNodes::iterator it    = m_MapOfNodes.begin();
+    THashMapRowHeightNodes::iterator itEnd = m_MapOfNodes.end();
+    while (it != itEnd)
+    {
+        delete(it->second);
+        ++it;
+    }
+    m_MapOfNodes.clear();
+    m_iRootHeight = -1;
+}
+
+/** Check if the index is empty
+  * \return true if no nodes are indexed
+  */
+bool wxVirtualRowHeightIndex::IsEmpty(void) const
+{
+    return(m_MapOfNodes.empty());
+}
+
+/** Get the amount of indexed nodes
+  * \return the amount of indexed nodes
+  */
+size_t wxVirtualRowHeightIndex::GetIndexedNodesCount(void) const
+{
+    return(m_MapOfNodes.size());
+}
+
+/** An item has been expanded / collapsed
+  * \param rID     [input]: the item which has been expanded / collapsed
+  * \param bExpand [input]: true if the item has been expanded, false if it has been collapsed
+  * This must be called after the state of the item has been changed, and only if the state
+  * has actually changed.
+  * O(k + d.log(k)) time for expanding a non-indexed node, O(d.log(k)) otherwise
+  */
+void wxVirtualRowHeightIndex::OnExpand(const wxVirtualItemID &rID, bool bExpand)
+{
+    //nothing indexed yet : nothing to update
+    if (m_MapOfNodes.empty()) return;
+    if ((!m_pDataModel) || (!m_pStateModel)) return;
+
+    wxVirtualRowHeightNode *pNode = WX_VDV_NULL_PTR;
+    if (bExpand)
+    {
+        //the node stays accurate when collapsed: build it only if it was never indexed
+        pNode = GetNode(rID);
+    }
+    else
+    {
+        //if the node is not indexed, then none of its ancestors counts its sub-tree
+        pNode = FindNode(rID);
+    }
+    if (!pNode) return;
+    if (pNode->m_iSize == 0) return;
+
+    if (bExpand) Propagate(rID, pNode->m_iSize);
+    else         Propagate(rID, -pNode->m_iSize);
+}
+
+/** The children of an item changed
+  * \param rParent [input]: the item whose children were inserted / removed / re-ordered
+  * Only the node of rParent is rebuilt (its indexed expanded children are kept), and the
+  * height change is propagated to its ancestors.
+  * O(k + d.log(k)) time, and k row height measurements if there is no estimated height
+  */
+void wxVirtualRowHeightIndex::OnChildrenChanged(const wxVirtualItemID &rParent)
+{
+    if ((!m_pDataModel) || (!m_pStateModel)) return;
+
+    //not indexed : none of its ancestors counts its children
+    THashMapRowHeightNodes::iterator it = m_MapOfNodes.find(rParent);
+    if (it == m_MapOfNodes.end()) return;
+
+    wxVirtualRowHeightNode *pNode = it->second;
+    wxInt64 iOldSize = pNode->m_iSize;
+    m_MapOfNodes.erase(it);
+    delete(pNode);
+
+    pNode = BuildNode(rParent);
+    if (!pNode) return;
+    if (pNode->m_iSize == iOldSize) return;
+
+    //a collapsed item contributes its row only, whatever its size
+    if ((!m_pDataModel->IsRootItem(rParent)) && (!m_pStateModel->IsExpanded(rParent))) return;
+    Propagate(rParent, pNode->m_iSize - iOldSize);
+}
+
+/** Set the measured height of 1 row
+  * \param rID     [input]: the item which has been measured
+  * \param iHeight [input]: the height of its row, with margins
+  * \return true if the index has been modified, false if the height was already known
+  *         or if the row is not indexed yet (it will be measured when indexed)
+  * O(d.log(k)) time if the height has changed, O(1) otherwise
+  */
+bool wxVirtualRowHeightIndex::SetRowHeight(const wxVirtualItemID &rID, int iHeight)
+{
+    if ((!m_pDataModel) || (!m_pStateModel)) return(false);
+    if (m_pDataModel->IsRootItem(rID))
+    {
+        if ((m_iRootHeight < 0) || (m_iRootHeight == iHeight)) return(false);
+        m_iRootHeight = iHeight;
+        return(true);
+    }
+
+    wxVirtualItemID idParent = m_pDataModel->GetParent(rID);
+    if (idParent == rID) return(false);
+
+    wxVirtualRowHeightNode *pNode = FindNode(idParent);
+    if (!pNode) return(false);
+
+    size_t uiChildIndex = m_pDataModel->GetChildIndex(idParent, rID);
+    if (uiChildIndex >= pNode->m_vHeights.size())
+    {
+        //inconsistent with the data model : rebuild everything later
+        Clear();
+        return(true);
+    }
+
+    int iDelta = iHeight - pNode->m_vHeights[uiChildIndex];
+    if (iDelta == 0) return(false);
+
+    pNode->m_vHeights[uiChildIndex] = iHeight;
+    Propagate(rID, iDelta);
+    return(true);
+}
+
+//------------------------ QUERIES ----------------------------------//
+/** Get the height of all the visible rows
+  * \return the sum of the heights of the visible rows, root row included
+  */
+wxInt64 wxVirtualRowHeightIndex::GetTotalHeight(void)
+{
+    if ((!m_pDataModel) || (!m_pStateModel)) return(0);
+
+    wxInt64 iResult = GetRootHeight();
+    wxVirtualItemID idRoot = m_pDataModel->GetRootItem();
+    if (!m_pStateModel->IsExpanded(idRoot)) return(iResult);
+
+    wxVirtualRowHeightNode *pNode = GetNode(idRoot);
+    if (pNode) iResult += pNode->m_iSize;
+    return(iResult);
+}
+
+/** Get the vertical position of a visible item
+  * \param rID [input] : the item to query
+  * \param y   [output]: the top of the item row. The root row starts at 0
+  * \return true if the position was found
+  *         false if the item is not visible (one of its ancestors is collapsed)
+  * O(d.log(k)) time
+  */
+bool wxVirtualRowHeightIndex::GetItemPosition(const wxVirtualItemID &rID, wxInt64 &y)
+{
+    y = 0;
+    if ((!m_pDataModel) || (!m_pStateModel)) return(false);
+
+    wxVirtualItemID id = rID;
+    bool bAncestor = false;
+    while (!m_pDataModel->IsRootItem(id))
+    {
+        if (id.IsInvalid()) return(false);
+
+        //parent
+        wxVirtualItemID idParent = m_pDataModel->GetParent(id);
+        if (idParent == id) return(false);
+        if (!m_pStateModel->IsExpanded(idParent)) return(false);
+
+        wxVirtualRowHeightNode *pNode = GetNode(idParent);
+        if (!pNode) return(false);
+
+        size_t uiChildIndex = m_pDataModel->GetChildIndex(idParent, id);
+        if (uiChildIndex >= pNode->m_vHeights.size()) return(false);
+
+        //all the previous siblings with their sub-trees
+        y += PrefixSum(pNode, uiChildIndex);
+
+        //the rows of the ancestors are above the item
+        if (bAncestor) y += pNode->m_vHeights[uiChildIndex];
+        bAncestor = true;
+        id = idParent;
+    }
+
+    if (bAncestor) y += GetRootHeight();
+    return(true);
+}
+
+/** Find the visible item at a vertical position
+  * \param y     [input] : the vertical position. The root row starts at 0
+  * \param yItem [output]: the top of the row of the found item
+  * \return the item, or an invalid item if the position is out of range
+  * O(d.log(k)) time
+  */
+wxVirtualItemID wxVirtualRowHeightIndex::FindItem(wxInt64 y, wxInt64 &yItem)
+{
+    yItem = 0;
+    if ((!m_pDataModel) || (!m_pStateModel)) return(wxVirtualItemID());
+    if (y < 0) return(wxVirtualItemID());
+
+    wxVirtualItemID id = m_pDataModel->GetRootItem();
+    wxInt64 iRemaining = y;
+    int iHeight = GetRootHeight();
+    while (!id.IsInvalid())
+    {
+        //the row of the node itself
+        if (iRemaining < iHeight)
+        {
+            yItem = y - iRemaining;
+            return(id);
+        }
+        iRemaining -= iHeight;
+
+        //find the child which contains the position
+        if (!m_pStateModel->IsExpanded(id)) break;
+
+        wxVirtualRowHeightNode *pNode = GetNode(id);
+        if (!pNode) break;
+        if (iRemaining >= pNode->m_iSize) break;
+
+        size_t uiChild = Search(pNode, iRemaining);
+        if (uiChild >= pNode->m_vHeights.size()) break;
+        iHeight = pNode->m_vHeights[uiChild];
+        id = m_pDataModel->GetChild(id, uiChild);
+    }
+
+    return(wxVirtualItemID());
+}
+
+//------------------------ INTERNAL METHODS -------------------------//
+/** Get an indexed node, without building it
+  * \param rID [input]: the node to find
+  * \return the node if it is indexed, NULL otherwise
+  */
+wxVirtualRowHeightNode* wxVirtualRowHeightIndex::FindNode(const wxVirtualItemID &rID) const
+{
+    THashMapRowHeightNodes::const_iterator it = m_MapOfNodes.find(rID);
+    if (it == m_MapOfNodes.end()) return(WX_VDV_NULL_PTR);
+    return(it->second);
+}
+
+/** Get an indexed node, build it if needed
+  * \param rID [input]: the node to find
+  * \return the indexed node
+  */
+wxVirtualRowHeightNode* wxVirtualRowHeightIndex::GetNode(const wxVirtualItemID &rID)
+{
+    wxVirtualRowHeightNode *pNode = FindNode(rID);
+    if (pNode) return(pNode);
+    return(BuildNode(rID));
+}
+
+/** Build an indexed node
+  * \param rID [input]: the node to build
+  * \return the indexed node
+  * The expanded children are indexed recursively.
+  * O(k) time (k = amount of children) + the time needed to index the expanded children
+  */
+wxVirtualRowHeightNode* wxVirtualRowHeightIndex::BuildNode(const wxVirtualItemID &rID)
+{
+    if ((!m_pDataModel) || (!m_pStateModel)) return(WX_VDV_NULL_PTR);
+
+    wxVirtualRowHeightNode *pNode = new wxVirtualRowHeightNode;
+    pNode->m_iSize = 0;
+    pNode->m_uiHighestBit = 0;
+
+    size_t uiNbChildren = m_pDataModel->GetChildCount(rID);
+    pNode->m_vTree.assign(uiNbChildren + 1, 0);
+    pNode->m_vHeights.assign(uiNbChildren, 0);
+
+    //contributions of children
+    size_t i;
+    for(i = 0; i < uiNbChildren; i++)
+    {
+        wxVirtualItemID idChild = m_pDataModel->GetChild(rID, i);
+        int iHeight = MeasureRow(idChild);
+        wxInt64 iContribution = iHeight;
+        if (m_pStateModel->IsExpanded(idChild))
+        {
+            wxVirtualRowHeightNode *pChild = GetNode(idChild);
+            if (pChild) iContribution += pChild->m_iSize;
+        }
+        pNode->m_vHeights[i] = iHeight;
+        pNode->m_vTree[i + 1] = iContribution;
+        pNode->m_iSize += iContribution;
+    }
+
+    //linear construction of the Fenwick tree
+    for(i = 1; i <= uiNbChildren; i++)
+    {
+        size_t j = i + (i & (~i + 1));
+        if (j <= uiNbChildren) pNode->m_vTree[j] += pNode->m_vTree[i];
+    }
+
+    //highest bit, for searching
+    size_t uiBit = 1;
+    while ((uiBit << 1) <= uiNbChildren) uiBit <<= 1;
+    if (uiNbChildren > 0) pNode->m_uiHighestBit = uiBit;
+
+    m_MapOfNodes[rID] = pNode;
+    return(pNode);
+}
+
+/** Get the height of the root row
+  * \return the height of the root row. The root row is always measured
+  */
+int wxVirtualRowHeightIndex::GetRootHeight(void)
+{
+    if (m_iRootHeight >= 0) return(m_iRootHeight);
+    if ((!m_pRenderer) || (!m_pDataModel)) return(0);
+
+    m_iRootHeight = m_pRenderer->GetRowHeight(m_pDataModel->GetRootItem());
+    if (m_iRootHeight < 0) m_iRootHeight = 0;
+    return(m_iRootHeight);
+}
+
+/** Get the height of a row being indexed
+  * \param rID [input]: the item
+  * \return the estimated height if any, the measured height otherwise
+  */
+int wxVirtualRowHeightIndex::MeasureRow(const wxVirtualItemID &rID) const
+{
+    if (m_iEstimatedHeight > 0) return(m_iEstimatedHeight);
+    if (!m_pRenderer) return(0);
+
+    int iHeight = m_pRenderer->GetRowHeight(rID);
+    if (iHeight < 0) iHeight = 0;
+    return(iHeight);
+}
+
+/** Propagate a height change to ancestors
+  * \param rID    [input]: the item whose contribution has changed
+  * \param iDelta [input]: the height added (> 0) or removed (< 0)
+  * The propagation stops at the 1st ancestor which is collapsed or not indexed
+  */
+void wxVirtualRowHeightIndex::Propagate(const wxVirtualItemID &rID, wxInt64 iDelta)
+{
+    wxVirtualItemID id = rID;
+    while (!m_pDataModel->IsRootItem(id))
+    {
+        if (id.IsInvalid()) return;
+
+        wxVirtualItemID idParent = m_pDataModel->GetParent(id);
+        if (idParent == id) return;
+
+        wxVirtualRowHeightNode *pNode = FindNode(idParent);
+        if (!pNode) return;
+
+        size_t uiChildIndex = m_pDataModel->GetChildIndex(idParent, id);
+        if (uiChildIndex >= pNode->m_vHeights.size())
+        {
+            //inconsistent with the data model : rebuild everything later
+            Clear();
+            return;
+        }
+
+        Add(pNode, uiChildIndex, iDelta);
+        pNode->m_iSize += iDelta;
+
+        //a collapsed parent contributes its row only, whatever its size
+        if (!m_pStateModel->IsExpanded(idParent)) return;
+        id = idParent;
+    }
+}
+
+//------------------------ FENWICK TREE HELPERS ---------------------//
+/** Sum of the uiCount first contributions
+  * \param pNode   [input]: the node
+  * \param uiCount [input]: the amount of children to sum
+  * \return the sum of contributions of children [0, uiCount[
+  */
+wxInt64 wxVirtualRowHeightIndex::PrefixSum(const wxVirtualRowHeightNode *pNode, size_t uiCount)
+{
+    wxInt64 iResult = 0;
+    size_t i = uiCount;
+    while (i > 0)
+    {
+        iResult += pNode->m_vTree[i];
+        i &= i - 1;
+    }
+    return(iResult);
+}
+
+/** Add a value to one contribution
+  * \param pNode   [input]: the node
+  * \param uiIndex [input]: the child index
+  * \param iDelta  [input]: the value to add (can be negative)
+  */
+void wxVirtualRowHeightIndex::Add(wxVirtualRowHeightNode *pNode, size_t uiIndex, wxInt64 iDelta)
+{
+    size_t uiSize = pNode->m_vTree.size();
+    size_t i = uiIndex + 1;
+    while (i < uiSize)
+    {
+        pNode->m_vTree[i] += iDelta;
+        i += i & (~i + 1);
+    }
+}
+
+/** Find the child containing a position
+  * \param pNode [input]       : the node
+  * \param y     [input/output]: on input, the position relative to the top of the 1st child
+  *                              on output, the position relative to the top of the found child
+  * \return the index of the child containing the position
+  */
+size_t wxVirtualRowHeightIndex::Search(const wxVirtualRowHeightNode *pNode, wxInt64 &y)
+{
+    size_t uiPos  = 0;
+    size_t uiSize = pNode->m_vTree.size();
+    size_t uiBit  = pNode->m_uiHighestBit;
+    while (uiBit > 0)
+    {
+        size_t uiNext = uiPos + uiBit;
+        if ((uiNext < uiSize) && (pNode->m_vTree[uiNext] <= y))
+        {
+            uiPos = uiNext;
+            y    -= pNode->m_vTree[uiNext];
+        }
+        uiBit >>= 1;
+    }
+    return(uiPos);
+}
@@ -7,6 +7,7 @@
 
 #include <wx/VirtualDataView/ModelRenderer/VirtualTreeModelRenderer.h>
 #include <wx/VirtualDataView/Models/VirtualIDataModel.h>
+#include <wx/VirtualDataView/Models/VirtualViewportHint.h>
 #include <wx/VirtualDataView/StateModels/VirtualIStateModel.h>
 #include <wx/VirtualDataView/StateModels/VirtualDataViewItemState.h>
 #include <wx/VirtualDataView/DataView/VirtualDataViewBase.h>
@@ -16,8 +17,9 @@
 #include <wx/VirtualDataView/CellAttrs/VirtualDataViewCellAttr.h>
 #include <wx/VirtualDataView/CellAttrs/VirtualDataViewItemAttr.h>
 #include <wx/VirtualDataView/Columns/VirtualDataViewColumnsList.h>
+#include <wx/VirtualDataView/Utilities/PerfCounters.h>
+#include <wx/VirtualDataView/Types/VirtualValue.h>
 #include <wx/stack.h>
-#include <wx/hashset.h>
 #include <wx/settings.h>
 #include <wx/log.h>
 #include <wx/renderer.h>
@@ -32,19 +34,11 @@
     #define PRINT_SCROLLBAR(x)
 #endif // LOG_SCROLLBAR
 
-#define LOG_PAINT_TIMER     0
-#if LOG_PAINT_TIMER != 0
+//sampled column auto-sizing : amount of longest values which are really measured
+static const size_t s_uiAutoSizeLongestValues = 32;
 
-    #include <windows.h>
-    static DWORD dwTicks[15];
-
-    #define LOG_PAINT_TIME(iTimer)  dwTicks[iTimer] = ::GetTickCount();
-    #define LOG_PAINT_TIME_PRINT(i1, i2, sMsg)  wxLogMessage("Time %s = %d ms", sMsg, dwTicks[i2] - dwTicks[i1]);
-
-#else
-    #define LOG_PAINT_TIME(iTimer)
-    #define LOG_PAINT_TIME_PRINT(i1, i2, sMsg)
-#endif
+//viewport hints : pause after which the scrolling speed is measured again from scratch, in ms
+static const long s_lHintIdleTime = 250;
 
 //-------------------- CONSTRUCTORS & DESTRUCTOR --------------------//
 /** Constructor
@@ -53,7 +47,8 @@
   */
 wxVirtualTreeModelRenderer::wxVirtualTreeModelRenderer(wxVirtualDataViewBase* pClient,
                                                        wxVirtualDataViewCtrl* pScroller)
-    : wxVirtualIModelRenderer(pClient, pScroller)
+    : wxVirtualIModelRenderer(pClient, pScroller),
+      m_RowHeightIndex(this)
 {
     Init();
 }
@@ -71,6 +66,19 @@ wxVirtualTreeModelRenderer::~wxVirtualTreeModelRenderer(void)
   * \return true on success, false on failure (painting incomplete or not done at all)
   */
 bool wxVirtualTreeModelRenderer::PaintModel(wxDC &rDC)
+{
+    return(PaintRect(rDC, wxRect()));
+}
+
+/** Paint only a part of the model
+  * Only the rows intersecting the update rectangle are drawn. The rows above it are
+  * skipped, and the drawing stops after its bottom edge
+  * \param rDC         [input]: the device context to use
+  * \param rUpdateRect [input]: the area to repaint, in client coordinates.
+  *                            An empty rectangle means the whole client area
+  * \return true on success, false on failure (painting incomplete or not done at all)
+  */
+bool wxVirtualTreeModelRenderer::PaintRect(wxDC &rDC, const wxRect &rUpdateRect)
 {
     //information : measuring items size and drawing them are both
     //              time consuming
@@ -84,7 +92,7 @@ bool wxVirtualTreeModelRenderer::PaintModel(wxDC &rDC)
     //                     update it at each scrolling / insertion / deletion / expand / collapse
     //                     Drawing can now start quickly without scanning from root node
 
-    LOG_PAINT_TIME(0);
+    WX_VDV_PERF_FRAME();
 
     //check & init
     if (!m_pClient) return(false);
@@ -92,7 +100,7 @@ bool wxVirtualTreeModelRenderer::PaintModel(wxDC &rDC)
     //background
     ComputeBackgroundColours();
     DrawBackground(rDC);
-    LOG_PAINT_TIME(1);
+    m_PaintCache.BeginPaint(m_pClient->GetFont());
 
     //get models
     wxVirtualIDataModel *pDataModel = m_pClient->GetDataModel();
@@ -111,6 +119,13 @@ bool wxVirtualTreeModelRenderer::PaintModel(wxDC &rDC)
     wxCoord xMax = w;
     wxCoord wMax = w - m_iMarginLeft - m_iMarginRight;
 
+    //area to repaint
+    wxRect rClient(0, 0, w, h);
+    m_rPaintRect = rClient;
+    if (!rUpdateRect.IsEmpty()) m_rPaintRect.Intersect(rUpdateRect);
+    wxCoord yMin = m_rPaintRect.GetTop();
+    wxCoord yMax = m_rPaintRect.GetBottom() + 1;
+
     //compute vertical margin
     int iVerticalMargin = m_iMarginTop + m_iMarginBottom;
     int iPenWidth       = m_HorizontalRulesPen.GetWidth();
@@ -155,23 +170,41 @@ bool wxVirtualTreeModelRenderer::PaintModel(wxDC &rDC)
     //horizontal scroll bar
     if (!m_pScroller) return(false);
     int x0 = m_pScroller->GetScrollPos(wxHORIZONTAL);
-    LOG_PAINT_TIME(2);
 
-    //draw items
+    //the screen now displays the current scroll positions
+    m_iPaintedFirstLine = m_iFirstVisibleLine;
+    m_iPaintedHorzPos   = x0;
+
+    //variable row heights : the measured heights refine the estimated ones
+    if (!m_bUniformRowHeight) m_RowHeightIndex.SetModels(pDataModel, pStateModel);
+
+    //collect the items in the area to repaint
+    m_vPaintRows.clear();
+    m_vPaintIDs.clear();
     size_t uiCount = 0;
     size_t uiRank = m_pScroller->GetScrollPos(wxVERTICAL);
-    while (y < h)
+    while (y < yMax)
     {
         if (!id.IsOK()) break;
 
-        //state
-        if (pStateModel) pStateModel->GetState(oState, id);
-
-        //paint the item
-        if (!m_bUniformRowHeight) iHeight = GetItemSize(id).GetHeight();
-        wxRect r(x   + m_iMarginLeft - x0, y + m_iMarginTop,
-                 wMax + x0, iHeight);
-        DrawItem(rDC, r, id, oState, pDataModel, uiLevel, uiRank, uiCount);
+        //keep the item, if it is in the area to repaint
+        if (!m_bUniformRowHeight)
+        {
+            iHeight = GetItemSize(id).GetHeight();
+            m_RowHeightIndex.SetRowHeight(id, iHeight + iVerticalSize);
+        }
+        if (y + iHeight + iVerticalSize > yMin)
+        {
+            TPaintRow oRow;
+            oRow.m_ID       = id;
+            oRow.m_uiLevel  = uiLevel;
+            oRow.m_uiRank   = uiRank;
+            oRow.m_uiCount  = uiCount;
+            oRow.m_y        = y;
+            oRow.m_iHeight  = iHeight;
+            m_vPaintRows.push_back(oRow);
+            m_vPaintIDs.push_back(id);
+        }
 
         //next
         uiRank++;
@@ -181,8 +214,32 @@ bool wxVirtualTreeModelRenderer::PaintModel(wxDC &rDC)
 
         //next item
         id = pDataModel->NextItem(id, uiLevel, uiLevel, pStateModel);
+        WX_VDV_PERF_COUNT(WX_PERF_MODEL_CALLS, 1);
+    }
+
+    //tell the data model which rows are shown, before reading them
+    PublishViewport(pDataModel, idStart, m_pScroller->GetScrollPos(wxVERTICAL), uiCount);
+
+    //get the values of all visible cells at once
+    FetchPaintValues(pDataModel, x0);
+
+    //draw items
+    size_t uiRow, uiNbRows, uiNbFields;
+    uiNbRows   = m_vPaintRows.size();
+    uiNbFields = m_vPaintFields.size();
+    for(uiRow = 0; uiRow < uiNbRows; uiRow++)
+    {
+        const TPaintRow &rRow = m_vPaintRows[uiRow];
+        if (pStateModel) pStateModel->GetState(oState, rRow.m_ID);
+
+        const wxVirtualValue *pValues = WX_VDV_NULL_PTR;
+        if (uiNbFields > 0) pValues = &m_vPaintValues[uiRow * uiNbFields];
+
+        wxRect r(x   + m_iMarginLeft - x0, rRow.m_y + m_iMarginTop,
+                 wMax + x0, rRow.m_iHeight);
+        DrawItem(rDC, r, rRow.m_ID, oState, pDataModel,
+                 rRow.m_uiLevel, rRow.m_uiRank, rRow.m_uiCount, pValues);
     }
-    LOG_PAINT_TIME(3);
 
     //draw horizontal grid lines
     if (m_bDrawHoritontalRules)
@@ -195,7 +252,7 @@ bool wxVirtualTreeModelRenderer::PaintModel(wxDC &rDC)
 
         rDC.SetPen(m_HorizontalRulesPen);
 
-        while(y < h)
+        while(y < yMax)
         {
             if (!id.IsOK()) break;
 
@@ -214,7 +271,6 @@ bool wxVirtualTreeModelRenderer::PaintModel(wxDC &rDC)
             id = pDataModel->NextItem(id, uiLevel, uiLevel, pStateModel);
         }
     }
-    LOG_PAINT_TIME(4);
 
     //draw vertical grid lines
     if (m_bDrawVerticalRules)
@@ -237,7 +293,6 @@ bool wxVirtualTreeModelRenderer::PaintModel(wxDC &rDC)
             rDC.DrawLine(x, 0, x, h);
         }
     }
-    LOG_PAINT_TIME(5);
 
     //tree lines, tree buttons, checkboxes : clip to the expander column
     int iStartExpanderCol = 0;
@@ -265,7 +320,7 @@ bool wxVirtualTreeModelRenderer::PaintModel(wxDC &rDC)
 
         rDC.SetPen(m_TreeLinesPen);
 
-        while(y < h)
+        while(y < yMax)
         {
             if (!id.IsOK()) break;
 
@@ -286,7 +341,6 @@ bool wxVirtualTreeModelRenderer::PaintModel(wxDC &rDC)
             id = pDataModel->NextItem(id, uiLevel, uiLevel, pStateModel);
         }
     }
-    LOG_PAINT_TIME(6);
 
     //draw tree buttons
     if (m_bDrawTreeButtons)
@@ -295,7 +349,7 @@ bool wxVirtualTreeModelRenderer::PaintModel(wxDC &rDC)
         id      = idStart;
         uiLevel = uiStartLevel;
 
-        while(y < h)
+        while(y < yMax)
         {
             if (!id.IsOK()) break;
 
@@ -321,7 +375,6 @@ bool wxVirtualTreeModelRenderer::PaintModel(wxDC &rDC)
             id = pDataModel->NextItem(id, uiLevel, uiLevel, pStateModel);
         }
     }
-    LOG_PAINT_TIME(7);
 
     //draw check boxes
     if (m_bDrawCheckbox)
@@ -330,7 +383,7 @@ bool wxVirtualTreeModelRenderer::PaintModel(wxDC &rDC)
         id      = idStart;
         uiLevel = uiStartLevel;
 
-        while(y < h)
+        while(y < yMax)
         {
             if (!id.IsOK()) break;
 
@@ -356,16 +409,6 @@ bool wxVirtualTreeModelRenderer::PaintModel(wxDC &rDC)
             id = pDataModel->NextItem(id, uiLevel, uiLevel, pStateModel);
         }
     }
-    LOG_PAINT_TIME(8);
-    LOG_PAINT_TIME_PRINT(0, 1, "background");
-    LOG_PAINT_TIME_PRINT(1, 2, "setup");
-    LOG_PAINT_TIME_PRINT(2, 3, "items");
-    LOG_PAINT_TIME_PRINT(3, 4, "horizontal lines");
-    LOG_PAINT_TIME_PRINT(4, 5, "vertical lines");
-    LOG_PAINT_TIME_PRINT(5, 6, "tree lines");
-    LOG_PAINT_TIME_PRINT(6, 7, "tree buttons");
-    LOG_PAINT_TIME_PRINT(7, 8, "checkboxes");
-    LOG_PAINT_TIME_PRINT(0, 8, "total");
     return(true);
 }
 
@@ -492,6 +535,7 @@ bool wxVirtualTreeModelRenderer::ScrollEvent(wxScrollWinEvent &rEvent)
         PRINT_SCROLLBAR(wxLogMessage("position = %d", iPosition));
     }
 
+    ScrollDisplay();
     ScrollEditorWindow();
     return(true);
 }
@@ -541,7 +585,8 @@ bool wxVirtualTreeModelRenderer::MouseEvent(wxMouseEvent &rEvent)
             m_pClient->SendScrollEvent(event);
         }
 
-        Refresh();
+        ScrollDisplay();
+        m_pClient->RefreshHeaders();
         return(true);
     }
 
@@ -1129,6 +1174,180 @@ wxSize wxVirtualTreeModelRenderer::GetBestSize(size_t uiColID) const
     return(sResult);
 }
 
+/** Get the best size of a column, with a measuring strategy
+  * \param uiColID      [input] : the column ID to measure (view coord)
+  * \param eMode        [input] : the measuring strategy
+  * \param uiSampleSize [input] : for WX_AUTOSIZE_SAMPLED, the amount of rows to sample
+  * \return the best size of the column. For WX_AUTOSIZE_BACKGROUND, this is the best size
+  *         of the shown rows : the caller completes it with MeasureColumn()
+  */
+wxSize wxVirtualTreeModelRenderer::GetBestSize(size_t uiColID, EAutoSizeMode eMode,
+                                               size_t uiSampleSize) const
+{
+    switch(eMode)
+    {
+        case WX_AUTOSIZE_VISIBLE_ROWS   :
+        case WX_AUTOSIZE_BACKGROUND     : return(GetBestSizeOfVisibleRows(uiColID));
+        case WX_AUTOSIZE_SAMPLED        : return(GetBestSizeOfSample(uiColID, uiSampleSize));
+        case WX_AUTOSIZE_ALL_ROWS       :
+        default                         : break;
+    }
+    return(GetBestSize(uiColID));
+}
+
+/** Measure the next items of a column
+  * The expanded items are measured in the same order as they are displayed
+  * \param rMeasure   [input/output]: the state of the measurement
+  * \param uiMaxItems [input]       : the maximal amount of items to measure in this step
+  * \return true if the measurement is finished, false if more items remain
+  */
+bool wxVirtualTreeModelRenderer::MeasureColumn(TColumnMeasure &rMeasure, size_t uiMaxItems) const
+{
+    //check
+    if (!m_pClient) return(true);
+    wxVirtualIDataModel *pDataModel = m_pClient->GetDataModel();
+    if (!pDataModel) return(true);
+    wxVirtualIStateModel *pStateModel = m_pClient->GetStateModel();
+    if (!pStateModel) return(true);
+
+    //1st step : start at root
+    if (!rMeasure.m_bStarted)
+    {
+        rMeasure.m_ID       = pDataModel->GetRootItem();
+        rMeasure.m_uiLevel  = 0;
+        rMeasure.m_iWidth   = 0;
+        rMeasure.m_bStarted = true;
+    }
+
+    //measure
+    size_t uiItem;
+    for(uiItem = 0; uiItem < uiMaxItems; uiItem++)
+    {
+        if (rMeasure.m_ID.IsInvalid()) return(true);
+
+        int iWidth = GetCellBestWidth(rMeasure.m_ID, rMeasure.m_uiColID);
+        if (iWidth > rMeasure.m_iWidth) rMeasure.m_iWidth = iWidth;
+
+        rMeasure.m_ID = pDataModel->NextItem(rMeasure.m_ID, rMeasure.m_uiLevel,
+                                             rMeasure.m_uiLevel, pStateModel, 1);
+    }
+
+    return(rMeasure.m_ID.IsInvalid());
+}
+
+//--------------------- COLUMN AUTO-SIZING --------------------------//
+/** Get the best width of 1 cell, with margins
+  * \param rID     [input]: the item to measure
+  * \param uiColID [input]: the column to measure (view coord)
+  * \return the best width of the cell. 0 for the hidden root item
+  */
+int wxVirtualTreeModelRenderer::GetCellBestWidth(const wxVirtualItemID &rID, size_t uiColID) const
+{
+    wxVirtualIDataModel *pDataModel = m_pClient->GetDataModel();
+    if (pDataModel->IsRootItem(rID))
+    {
+        if (m_bHideRootItem) return(0);
+        return(GetItemSize(rID, uiColID).GetWidth());
+    }
+    return(GetItemSize(rID, uiColID).GetWidth() + m_iMarginLeft + m_iMarginRight);
+}
+
+/** Get the best size of a column, from the shown rows
+  * \param uiColID [input] : the column ID to measure (view coord)
+  * \return the best size of the rows currently shown in the client area
+  */
+wxSize wxVirtualTreeModelRenderer::GetBestSizeOfVisibleRows(size_t uiColID) const
+{
+    wxSize sResult(0, 0);
+    if (!m_pClient) return(sResult);
+    if (!m_pClient->GetDataModel()) return(sResult);
+
+    wxVirtualItemIDs vIDs;
+    size_t uiNbItems = GetAllVisibleItems(vIDs);
+    size_t uiItem;
+    for(uiItem = 0; uiItem < uiNbItems; uiItem++)
+    {
+        int iWidth = GetCellBestWidth(vIDs[uiItem], uiColID);
+        if (iWidth > sResult.x) sResult.x = iWidth;
+    }
+
+    return(sResult);
+}
+
+/** Get the best size of a column, from a sample of rows
+  * The shown rows are measured. In addition, uiSampleSize rows evenly spread over the whole tree
+  * are read, and the s_uiAutoSizeLongestValues longest ones (in characters) are measured.
+  * Reading a value is much cheaper than measuring its rendered size, so this gives a good
+  * estimate for large models, in O(uiSampleSize) time when the data model ranks items quickly
+  * \param uiColID      [input] : the column ID to measure (view coord)
+  * \param uiSampleSize [input] : the amount of rows to read
+  * \return the estimated best size of the column
+  */
+wxSize wxVirtualTreeModelRenderer::GetBestSizeOfSample(size_t uiColID, size_t uiSampleSize) const
+{
+    //the shown rows are always measured
+    wxSize sResult = GetBestSizeOfVisibleRows(uiColID);
+
+    //check
+    if (!m_pClient) return(sResult);
+    wxVirtualIDataModel *pDataModel = m_pClient->GetDataModel();
+    if (!pDataModel) return(sResult);
+    wxVirtualIStateModel *pStateModel = m_pClient->GetStateModel();
+    if (!pStateModel) return(sResult);
+    wxVirtualDataViewColumn *pCol = Columns().GetColumn(uiColID);
+    if (!pCol) return(sResult);
+    size_t uiField = pCol->GetModelColumn();
+
+    //amount of rows, root excluded
+    size_t uiNbRows = pDataModel->GetSubTreeSize(pDataModel->GetRootItem(), pStateModel);
+    if (uiNbRows <= 1) return(sResult);
+    uiNbRows--;
+    if (uiSampleSize > uiNbRows) uiSampleSize = uiNbRows;
+
+    //read the sample, keep the longest values
+    wxVector<size_t> vLengths;
+    wxVirtualItemIDs vLongest;
+    wxVirtualValue oValue;
+    size_t uiSample;
+    for(uiSample = 0; uiSample < uiSampleSize; uiSample++)
+    {
+        size_t uiRank = 1 + (size_t) (((double) uiSample) * uiNbRows / uiSampleSize);
+        wxVirtualItemID id = pDataModel->FindItem(uiRank, pStateModel);
+        if (id.IsInvalid()) continue;
+
+        pDataModel->GetItemValue(oValue, id, uiField);
+        size_t uiLength;
+        if (oValue.GetType() == wxVirtualValue::WX_VALUE_STRING) uiLength = oValue.GetStringRef().Length();
+        else                                                     uiLength = oValue.GetString().Length();
+
+        if (vLengths.size() < s_uiAutoSizeLongestValues)
+        {
+            vLengths.push_back(uiLength);
+            vLongest.push_back(id);
+            continue;
+        }
+
+        //replace the shortest kept value
+        size_t i, uiShortest = 0;
+        for(i = 1; i < s_uiAutoSizeLongestValues; i++)
+        {
+            if (vLengths[i] < vLengths[uiShortest]) uiShortest = i;
+        }
+        if (uiLength <= vLengths[uiShortest]) continue;
+        vLengths[uiShortest] = uiLength;
+        vLongest[uiShortest] = id;
+    }
+
+    //measure the longest values
+    size_t uiNbLongest = vLongest.size();
+    for(uiSample = 0; uiSample < uiNbLongest; uiSample++)
+    {
+        int iWidth = GetCellBestWidth(vLongest[uiSample], uiColID);
+        if (iWidth > sResult.x) sResult.x = iWidth;
+    }
+
+    return(sResult);
+}
 
 /** Performs a hit test
   * \param rResult         [output]: the result of the hit test
@@ -1224,6 +1443,21 @@ bool wxVirtualTreeModelRenderer::HitTest(THitTest &rResult, wxCoord x, wxCoord y
         rResult.m_uiRank++;
     }
 
+    //variable row heights on the whole tree : jump to the item instead of scanning from root
+    if ((!bClientAreaOnly) && (!m_bUniformRowHeight) && (pStateModel))
+    {
+        wxInt64 yItem = 0;
+        m_RowHeightIndex.SetModels(pDataModel, pStateModel);
+        id = m_RowHeightIndex.FindItem(y, yItem);
+        if (id.IsOK())
+        {
+            yy      = (wxCoord) yItem;
+            uiLevel = pDataModel->GetDepth(id);
+            if ((m_bHideRootItem) && (uiLevel > 0)) uiLevel--;
+            rResult.m_uiRank = pDataModel->GetItemRank(id, pStateModel);
+        }
+    }
+
     //scan horizontally : compute column
     int x0 = 0;
     if ((bClientAreaOnly) && (m_pScroller)) x0 = m_pScroller->GetScrollPos(wxHORIZONTAL);
@@ -1410,48 +1644,22 @@ bool wxVirtualTreeModelRenderer::GetItemRect(wxRect &rRect,
     }
     else
     {
-        //non-uniform row height : scan from root
-        size_t uiLevel = pDataModel->GetDepth(rID);
-        int iHeight = 0;
-        int y = 0;
-        wxVirtualItemID id = pDataModel->GetRootItem();
-
-        bool bFoundFirstVisibleItem = false;
-        m_FirstVisibleItem.SetDataModel(pDataModel);
-        wxVirtualItemID idFirstVisible = m_FirstVisibleItem.Get();
-
-        while (id != rID)
-        {
-            if (id == idFirstVisible)
-            {
-                bFoundFirstVisibleItem = true;
-                iYOffset = y;
-            }
-            iHeight = GetItemSize(id).GetHeight();
-            iHeight = GetRowHeightWithMargins(iHeight);
-            y += iHeight;
-
-            id = pDataModel->NextItem(id, uiLevel, uiLevel, pStateModel, 1);
-            if (id.IsInvalid()) return(false);
-        }
-
-        //found
-        iHeight = GetItemSize(rID).GetHeight();
-        rRect.y = y;
-        rRect.height = GetRowHeightWithMargins(iHeight);
+        //non-uniform row height : prefix sums of the row heights
+        m_RowHeightIndex.SetModels(pDataModel, pStateModel);
+        wxInt64 y = 0;
+        if (!m_RowHeightIndex.GetItemPosition(rID, y)) return(false);
+        rRect.y = (int) y;
+        rRect.height = GetRowHeight(rID);
 
         //offset of 1st visible item
-        if ((!bFoundFirstVisibleItem) && (bClientCoordinates))
+        if (bClientCoordinates)
         {
-            iYOffset = y;
-            while(id != idFirstVisible)
+            m_FirstVisibleItem.SetDataModel(pDataModel);
+            wxVirtualItemID idFirstVisible = m_FirstVisibleItem.Get();
+            wxInt64 yFirstVisible = 0;
+            if (m_RowHeightIndex.GetItemPosition(idFirstVisible, yFirstVisible))
             {
-                iHeight = GetItemSize(id).GetHeight();
-                iHeight = GetRowHeightWithMargins(iHeight);
-                iYOffset += iHeight;
-
-                id = pDataModel->NextItem(id, uiLevel, uiLevel, pStateModel, 1);
-                if (id.IsInvalid()) break;
+                iYOffset = (int) yFirstVisible;
             }
         }
     }
@@ -1624,6 +1832,8 @@ bool wxVirtualTreeModelRenderer::CollapseOrExpand(const wxVirtualItemID &rID,
             }
         }
 
+        //a whole sub-tree may have changed : re-index the row heights lazily
+        m_RowHeightIndex.Clear();
 
         if (bUpdateScrollbars)
         {
@@ -1658,6 +1868,11 @@ bool wxVirtualTreeModelRenderer::CollapseOrExpand(const wxVirtualItemID &rID,
             }
 
             pStateModel->Expand(rID, bExpand, false);
+            if (!bUniform)
+            {
+                m_RowHeightIndex.SetModels(pDataModel, pStateModel);
+                m_RowHeightIndex.OnExpand(rID, bExpand);
+            }
 
             if ((bUpdateScrollbars) && (bUniform))
             {
@@ -1696,6 +1911,10 @@ bool wxVirtualTreeModelRenderer::CollapseOrExpand(const wxVirtualItemID &rID,
         }
     }
 
+    //the expanded rows changed : the best widths of the columns must be measured again
+    wxVirtualDataViewCtrl *pOwner = m_pClient->GetOwner();
+    if (pOwner) pOwner->InvalidateAutoSizeCache();
+
     //effect on focused item:
     //  1 : if the expanded/collapsed item is located after or is the focused item,
     //      there is no effect : m_uiRankFocusedItem <= uiRank
@@ -1758,6 +1977,8 @@ void wxVirtualTreeModelRenderer::SetFocusedField(int iField)
   */
 void wxVirtualTreeModelRenderer::OnDataModelChanged(void)
 {
+    m_RowHeightIndex.Clear();
+    m_pHintModel = WX_VDV_NULL_PTR;
     InvalidateFirstVisibleItem();
     InvalidateCurrentSize();
     InvalidateVirtualSize();
@@ -1770,6 +1991,22 @@ void wxVirtualTreeModelRenderer::OnDataModelChanged(void)
 void wxVirtualTreeModelRenderer::OnLayoutChanged(void)
 {
     //InvalidateFirstVisibleItem();
+    m_RowHeightIndex.Clear();
+    ComputeFirstVisibleItem(m_iFirstVisibleLine);
+    InvalidateCurrentSize();
+    InvalidateVirtualSize();
+    UpdateScrollbars();
+    UpdateFocusedItemRank();
+}
+
+/** Called by the client to notify that the children of an item changed
+  * \param rParent [input]: the item whose children were inserted / removed / re-ordered
+  * Only the node of rParent is rebuilt in the row height index.
+  * The state model must have been notified before
+  */
+void wxVirtualTreeModelRenderer::OnChildrenChanged(const wxVirtualItemID &rParent)
+{
+    m_RowHeightIndex.OnChildrenChanged(rParent);
     ComputeFirstVisibleItem(m_iFirstVisibleLine);
     InvalidateCurrentSize();
     InvalidateVirtualSize();
@@ -1777,6 +2014,30 @@ void wxVirtualTreeModelRenderer::OnLayoutChanged(void)
     UpdateFocusedItemRank();
 }
 
+/** Called by the client to notify that some items were inserted
+  * \param rParent [input]: the parent of the new items
+  * \param uiFirst [input]: the child index of the 1st new item
+  * \param uiCount [input]: the amount of new items
+  * \return true if the display was updated, false if the client must be repainted
+  */
+bool wxVirtualTreeModelRenderer::OnItemsInserted(const wxVirtualItemID &rParent,
+                                                 size_t uiFirst, size_t uiCount)
+{
+    return(UpdateShiftedRows(rParent, uiFirst, uiCount, true));
+}
+
+/** Called by the client to notify that some items were removed
+  * \param rParent [input]: the parent of the removed items
+  * \param uiFirst [input]: the child index of the 1st removed item
+  * \param uiCount [input]: the amount of removed items
+  * \return true if the display was updated, false if the client must be repainted
+  */
+bool wxVirtualTreeModelRenderer::OnItemsRemoved(const wxVirtualItemID &rParent,
+                                                size_t uiFirst, size_t uiCount)
+{
+    return(UpdateShiftedRows(rParent, uiFirst, uiCount, false));
+}
+
 //-------------- PROTECTED INTERFACE IMPLEMENTATION -----------------//
 /** Draw the background
   * \param rDC [input] : the device context to use
@@ -1940,13 +2201,19 @@ void wxVirtualTreeModelRenderer::ComputeBackgroundColours(void)
   * \param lLevel [input]: the hierarchy level of the item
   * \param uiRank [input]: the rank of the current item
   * \param uiCount [input]: how many items were drawn before this one
+  * \param pValues [input]: the values of the item, from FetchPaintValues(). Can be NULL: the values
+  *                         are then queried 1 by 1
   */
 void wxVirtualTreeModelRenderer::DrawItem(wxDC &rDC, wxRect &rRect,
                                           const wxVirtualItemID &rID,
                                           const wxVirtualDataViewItemState &rState,
                                           wxVirtualIDataModel *pModel,
-                                          long lLevel, size_t uiRank, size_t uiCount)
+                                          long lLevel, size_t uiRank, size_t uiCount,
+                                          const wxVirtualValue *pValues)
 {
+    WX_VDV_PERF_TIMER(WX_PERF_DRAW_ITEM);
+    WX_VDV_PERF_COUNT(WX_PERF_ITEMS_DRAWN, 1);
+
     //indent
     wxRect r = rRect;
     int lIndentation = lLevel * m_iIndentation + m_iTreeButtonTotalWidth;
@@ -1985,10 +2252,8 @@ void wxVirtualTreeModelRenderer::DrawItem(wxDC &rDC, wxRect &rRect,
             r2.height += iHeightPen;
         }
 
-        wxBrush oBrush(c, wxBRUSHSTYLE_SOLID);
-        wxPen oPen(c, 1, wxPENSTYLE_SOLID);
-        rDC.SetBrush(oBrush);
-        rDC.SetPen(oPen);
+        rDC.SetBrush(m_PaintCache.GetBrush(c));
+        rDC.SetPen(m_PaintCache.GetPen(c));
         rDC.DrawRectangle(r2);
     }
 
@@ -2005,10 +2270,8 @@ void wxVirtualTreeModelRenderer::DrawItem(wxDC &rDC, wxRect &rRect,
 
         if (m_cSelectedItemsColour.IsOk())
         {
-            wxBrush oBrush(m_cSelectedItemsColour, wxBRUSHSTYLE_SOLID);
-            wxPen   oPen(m_cSelectedItemsColour, 1, wxPENSTYLE_SOLID);
-            rDC.SetBrush(oBrush);
-            rDC.SetPen(oPen);
+            rDC.SetBrush(m_PaintCache.GetBrush(m_cSelectedItemsColour));
+            rDC.SetPen(m_PaintCache.GetPen(m_cSelectedItemsColour));
             rDC.DrawRectangle(r2);
         }
         else
@@ -2020,13 +2283,11 @@ void wxVirtualTreeModelRenderer::DrawItem(wxDC &rDC, wxRect &rRect,
         oState.Select(false);
     }
 
-    //temp graphic attributes
-    wxVirtualDataViewItemAttr oTempAttr;
-
     //draw each columns
     wxVirtualDataViewColumnsList &rvColumns = Columns();
     size_t uiNbCols = rvColumns.GetColumnsCount();
     size_t uiCol;
+    wxVirtualValue oValue;
     for(uiCol = 0; uiCol < uiNbCols; uiCol++)
     {
         //get column
@@ -2053,9 +2314,10 @@ void wxVirtualTreeModelRenderer::DrawItem(wxDC &rDC, wxRect &rRect,
         //clip
         int iXLeft = r.x;
         int iXRight = r.x + r.width;
-        if ((iXRight < rRect.x) || (iXLeft > rRect.x + rRect.width))
+        if (  (iXRight < rRect.x) || (iXLeft > rRect.x + rRect.width)
+            ||(iXRight < m_rPaintRect.x) || (iXLeft > m_rPaintRect.GetRight()))
         {
-            //column is scrolled out
+            //column is scrolled out, or outside of the area to repaint
             r.x -= lIndent;
             r.x += iWidth + m_iMarginLeft;
             continue;
@@ -2074,21 +2336,9 @@ void wxVirtualTreeModelRenderer::DrawItem(wxDC &rDC, wxRect &rRect,
         //get item attributes
         wxVirtualDataViewItemAttr *pItemAttr = pModel->GetItemAttribute(rID, uiModelCol, rState);
 
-        //combine attributes
-        wxVirtualDataViewItemAttr *pEffectiveAttr = pItemAttr;
-        if (pItemAttr)
-        {
-            if (pAttr)
-            {
-                oTempAttr = *pItemAttr;
-                oTempAttr.Combine(pAttr->GetGraphicAttributes());
-                pEffectiveAttr = &oTempAttr;
-            }
-        }
-        else if (pAttr)
-        {
-            pEffectiveAttr = pAttr->GetGraphicAttributes();
-        }
+        //combine attributes (resolved once per paint)
+        wxVirtualDataViewItemAttr *pEffectiveAttr = m_PaintCache.ResolveAttribute(pItemAttr,
+                                                                    pAttr->GetGraphicAttributes());
 
         //get renderer
         wxVirtualDataViewRenderer *pRenderer = pAttr->GetRenderer();
@@ -2100,15 +2350,25 @@ void wxVirtualTreeModelRenderer::DrawItem(wxDC &rDC, wxRect &rRect,
         }
 
         //get data
-        wxVariant vValue = pModel->GetItemData(rID, uiModelCol,
-                                               wxVirtualIDataModel::WX_ITEM_MAIN_DATA
-                                              );
+        const wxVirtualValue *pValue = &oValue;
+        if ((pValues) && (uiCol < m_vPaintColumns.size()) && (m_vPaintColumns[uiCol] != size_t(-1)))
+        {
+            pValue = pValues + m_vPaintColumns[uiCol];
+            WX_VDV_PERF_COUNT(WX_PERF_MODEL_CALLS, 1); //GetItemAttribute
+        }
+        else
+        {
+            pModel->GetItemValue(oValue, rID, uiModelCol,
+                                 wxVirtualIDataModel::WX_ITEM_MAIN_DATA
+                                );
+            WX_VDV_PERF_COUNT(WX_PERF_MODEL_CALLS, 2); //GetItemAttribute + GetItemValue
+        }
 
         //clip
         wxDCClipper oDCClipper(rDC, r);
 
         //draw
-        pRenderer->Render(m_pClient, r, rDC, pEffectiveAttr, oState, vValue);
+        pRenderer->RenderValue(m_pClient, r, rDC, pEffectiveAttr, oState, *pValue);
 
         //next
         if (uiNbFields == size_t(-1)) break;
@@ -2123,6 +2383,123 @@ void wxVirtualTreeModelRenderer::DrawItem(wxDC &rDC, wxRect &rRect,
     }
 }
 
+/** Get the values of the visible cells
+  * The fields of the columns intersecting the area to repaint are fetched for all the items
+  * of m_vPaintIDs, with 1 call to wxVirtualIDataModel::GetItemDataBatch(), inside a
+  * wxVirtualIDataModel::OnPaintFetch() scope
+  * \param pDataModel [input]: the data model of the items
+  * \param x0         [input]: the horizontal scroll position
+  */
+void wxVirtualTreeModelRenderer::FetchPaintValues(wxVirtualIDataModel *pDataModel, int x0)
+{
+    m_vPaintFields.clear();
+    m_vPaintColumns.clear();
+
+    //select the columns
+    wxVirtualDataViewColumnsList &rvColumns = Columns();
+    size_t uiNbCols = rvColumns.GetColumnsCount();
+    m_vPaintColumns.resize(uiNbCols, size_t(-1));
+
+    int iLeft, iRight;
+    iRight = m_iMarginLeft - x0;
+    size_t uiCol;
+    for(uiCol = 0; uiCol < uiNbCols; uiCol++)
+    {
+        wxVirtualDataViewColumn *pCol = rvColumns.GetColumn(uiCol);
+        if (!pCol) continue;
+        if (pCol->IsHidden()) continue;
+
+        //horizontal position (margins included)
+        iLeft   = iRight - m_iMarginLeft;
+        iRight += pCol->GetWidth();
+        if ((iRight + m_iMarginRight < m_rPaintRect.x) || (iLeft > m_rPaintRect.GetRight())) continue;
+
+        //the column must be drawable
+        wxVirtualDataViewCellAttr *pAttr = pCol->GetAttribute();
+        if (!pAttr) continue;
+        if (!pAttr->GetRenderer()) continue;
+
+        m_vPaintColumns[uiCol] = m_vPaintFields.size();
+        m_vPaintFields.push_back(pCol->GetModelColumn());
+    }
+
+    //fetch
+    if ((m_vPaintFields.empty()) || (m_vPaintIDs.empty()))
+    {
+        m_vPaintValues.clear();
+        return;
+    }
+    pDataModel->OnPaintFetch(true);
+    pDataModel->GetItemDataBatch(m_vPaintValues, m_vPaintIDs, m_vPaintFields,
+                                 wxVirtualIDataModel::WX_ITEM_MAIN_DATA);
+    pDataModel->OnPaintFetch(false);
+    WX_VDV_PERF_COUNT(WX_PERF_MODEL_CALLS, 1);
+}
+
+/** Send the viewport to the data model if it changed
+  * The scrolling speed is measured between 2 viewports, and smoothed
+  * \param pDataModel  [input]: the data model
+  * \param rFirstID    [input]: the 1st visible item
+  * \param uiFirstRank [input]: the rank of the 1st visible item
+  * \param uiCount     [input]: the amount of items walked by the paint
+  */
+void wxVirtualTreeModelRenderer::PublishViewport(wxVirtualIDataModel *pDataModel,
+                                                 const wxVirtualItemID &rFirstID,
+                                                 size_t uiFirstRank, size_t uiCount)
+{
+    if ((!m_bViewportHints) || (!pDataModel) || (!m_pScroller)) return;
+
+    //amount of rows fitting in the view
+    size_t uiRowCount = uiCount;
+    int iPageSize = m_pScroller->GetScrollThumb(wxVERTICAL);
+    if (iPageSize > 0) uiRowCount = iPageSize;
+
+    //unchanged
+    bool bSameModel = (pDataModel == m_pHintModel);
+    if ((bSameModel) && (uiFirstRank == m_uiHintFirstRank) && (uiRowCount == m_uiHintRowCount)) return;
+
+    //scrolling speed & direction
+    long lElapsed = m_HintStopWatch.Time();
+    m_HintStopWatch.Start();
+    if ((bSameModel) && (uiFirstRank != m_uiHintFirstRank))
+    {
+        double dDelta;
+        if (uiFirstRank > m_uiHintFirstRank)
+        {
+            dDelta = (double) (uiFirstRank - m_uiHintFirstRank);
+            m_iHintDirection = 1;
+        }
+        else
+        {
+            dDelta = -((double) (m_uiHintFirstRank - uiFirstRank));
+            m_iHintDirection = -1;
+        }
+
+        if (lElapsed < 1) lElapsed = 1;
+        double dVelocity = dDelta * 1000.0 / ((double) lElapsed);
+        if (lElapsed > s_lHintIdleTime) m_dHintVelocity = dVelocity;
+        else                            m_dHintVelocity = (m_dHintVelocity + dVelocity) * 0.5;
+    }
+    else if (!bSameModel)
+    {
+        m_dHintVelocity  = 0.0;
+        m_iHintDirection = 0;
+    }
+
+    m_pHintModel      = pDataModel;
+    m_uiHintFirstRank = uiFirstRank;
+    m_uiHintRowCount  = uiRowCount;
+
+    wxVirtualViewportHint oHint;
+    oHint.m_FirstItem   = rFirstID;
+    oHint.m_uiFirstRank = uiFirstRank;
+    oHint.m_uiRowCount  = uiRowCount;
+    if (m_iNbVisiblesItems > 0) oHint.m_uiTotalRows = m_iNbVisiblesItems;
+    oHint.m_dVelocity   = m_dHintVelocity;
+    oHint.m_iDirection  = m_iHintDirection;
+    pDataModel->OnViewportChanged(oHint);
+}
+
 /** Check if the column is the expander column
   * \param uiViewCol [input]: the column index (view index) of the column to check
   * \return true if the column is the expander column
@@ -2337,6 +2714,8 @@ void wxVirtualTreeModelRenderer::InvalidateVirtualSize(void)
   */
 wxSize wxVirtualTreeModelRenderer::ComputeSize(size_t &uiNbItemsVisible) const
 {
+    WX_VDV_PERF_TIMER(WX_PERF_COMPUTE_SIZE);
+
     //check & init
     uiNbItemsVisible = 0;
     if (!m_pClient) return(wxSize(1, 1));
@@ -2348,7 +2727,6 @@ wxSize wxVirtualTreeModelRenderer::ComputeSize(size_t &uiNbItemsVisible) const
     if (!pStateModel) return(wxSize(1, 1));
 
     //get margins
-    int iHorizMargin = m_iMarginLeft + m_iMarginRight;
     int iVertMargin  = m_iMarginTop + m_iMarginBottom;
     if (m_bDrawHoritontalRules) iVertMargin += m_VerticalRulesPen.GetWidth();
 
@@ -2378,7 +2756,6 @@ wxSize wxVirtualTreeModelRenderer::ComputeSize(size_t &uiNbItemsVisible) const
     wxSize sResult(0, 0);
     if (bRecomputeVSize)
     {
-        long lChild, lNbChildren;
         wxVirtualItemID idRoot = pDataModel->GetRootItem();
         if (bUniformHeight)
         {
@@ -2389,40 +2766,11 @@ wxSize wxVirtualTreeModelRenderer::ComputeSize(size_t &uiNbItemsVisible) const
         }
         else
         {
-            //non - uniform case - brute force calculation unavoidable
-            wxStack<wxVirtualItemID> StackOfNodes;
-            StackOfNodes.push(idRoot);
-
-            while(StackOfNodes.size() > 0)
-            {
-                //get item
-                wxVirtualItemID id = StackOfNodes.top();
-                StackOfNodes.pop();
-
-                //compute size
-                wxSize s = GetItemSize(id);
-
-                //add margins
-                if ((id.IsOK()) || ((pDataModel->IsRootItem(id)) && (!m_bHideRootItem)))
-                {
-                    s.x += iHorizMargin;
-                    s.y += iVertMargin;
-                    uiNbItemsVisible++;
-                }
-
-                //accumulate (max value horizontal + accumulate vertically)
-                //if (s.x > sResult.x) sResult.x += s.x;
-                sResult.y += s.y;
-
-                //recurse
-                if (!pStateModel->IsExpanded(id)) continue;
-                lNbChildren = pDataModel->GetChildCount(id);
-                for(lChild = lNbChildren - 1; lChild >= 0; lChild--)
-                {
-                    wxVirtualItemID idChild = pDataModel->GetChild(id, lChild);
-                    StackOfNodes.push(idChild);
-                }
-            }
+            //non - uniform case : prefix sums of the row heights
+            m_RowHeightIndex.SetModels(pDataModel, pStateModel);
+            uiNbItemsVisible = pDataModel->GetSubTreeSize(idRoot, pStateModel);
+            if (m_bHideRootItem) uiNbItemsVisible--;
+            sResult.SetHeight((int) m_RowHeightIndex.GetTotalHeight());
         }
     }
     else
@@ -2659,10 +3007,14 @@ wxVirtualTreePath wxVirtualTreeModelRenderer::ConvertRowToTreePath(int iLine) co
 
     //it seems to be faster to compute the item using next/previous than absolute calculation,
     //even for big differences
+    //exception : if the state model maintains an index of visible rows, the absolute calculation is O(log(n))
+    bool bHasIndex = false;
+    if ((pDataModel) && (pStateModel) && (pStateModel->GetVisibleRowIndex(pDataModel))) bHasIndex = true;
+
     int iDiff = iLine - m_iFirstVisibleLine; //m_iFirstVisibleLine == -1 has a special meaning : not initialized
     if (iDiff < 0) iDiff = -iDiff; //abs
     const int uiDiffThreshold = 10000000;
-    if ((iDiff > uiDiffThreshold) && (m_iFirstVisibleLine >= 0))
+    if (((iDiff > uiDiffThreshold) && (m_iFirstVisibleLine >= 0)) || (bHasIndex))
     {
         //METHOD 1 : can be slow if number of direct children of an item is big (> 10000)
         //root has rank 0, and is hidden
@@ -2734,6 +3086,7 @@ void wxVirtualTreeModelRenderer::ShiftFirstVisibleItem(int iDiff)
     if (m_iFirstVisibleLine >= 0) m_iFirstVisibleLine += iDiff;
     if (m_iFirstVisibleLine < -1) m_iFirstVisibleLine  = -1; //protection against out of bound
     //no need to re-compute the m_FirstVisibleItem because it is rank independent
+    m_iPaintedFirstLine = -1; //the pixels on screen cannot be scrolled anymore
 }
 
 /** Recompute the 1st visible item
@@ -2768,6 +3121,7 @@ void wxVirtualTreeModelRenderer::RecomputeFirstVisibleItem(void)
     //recompute rank
     m_iFirstVisibleLine = pDataModel->GetItemRank(idFirst, pStateModel);
     if ((m_bHideRootItem) && (m_iFirstVisibleLine > 0)) m_iFirstVisibleLine--;
+    m_iPaintedFirstLine = -1; //the pixels on screen cannot be scrolled anymore
 }
 
 /** Invalidate the 1st visible item
@@ -2775,9 +3129,164 @@ void wxVirtualTreeModelRenderer::RecomputeFirstVisibleItem(void)
 void wxVirtualTreeModelRenderer::InvalidateFirstVisibleItem(void)
 {
     m_iFirstVisibleLine = -1;
+    m_iPaintedFirstLine = -1;
     ComputeFirstVisibleItem(0);
 }
 
+/** Scroll the displayed pixels & repaint the exposed area
+  * The pixels already on screen are moved by the scrolling amount, and only the strip
+  * of rows / columns which becomes visible is repainted.
+  * A full repaint is done instead when the old pixels cannot be reused:
+  *     - rows have different heights
+  *     - the scrolling amount is bigger than the client area
+  *     - the alternating background colours are fixed relative to the top visible row,
+  *       and an odd amount of rows is scrolled
+  */
+void wxVirtualTreeModelRenderer::ScrollDisplay(void)
+{
+    if (!m_pClient)   return;
+    if (!m_pScroller) return;
+
+    //nothing changed since last paint
+    int iFirstLine = m_iFirstVisibleLine;
+    int iHorzPos   = m_pScroller->GetScrollPos(wxHORIZONTAL);
+    if ((iFirstLine == m_iPaintedFirstLine) && (iHorzPos == m_iPaintedHorzPos)) return;
+
+    //client size
+    int w = 0;
+    int h = 0;
+    m_pClient->GetClientSize(&w, &h);
+
+    //check if the old pixels can be reused
+    int iRows = m_iPaintedFirstLine - iFirstLine;
+    bool bBlit = m_bUniformRowHeight;
+    if ((iFirstLine < 0) || (m_iPaintedFirstLine < 0)) bBlit = false;
+    if ((m_bAlternatingBackColour) && (m_bFixedAlternatingBackColour) && (iRows % 2 != 0)) bBlit = false;
+
+    //scrolling amount
+    int dx = m_iPaintedHorzPos - iHorzPos;
+    int dy = 0;
+    if (bBlit)
+    {
+        int iVerticalSize = m_iMarginTop + m_iMarginBottom;
+        if (m_bDrawHoritontalRules) iVerticalSize += m_HorizontalRulesPen.GetWidth();
+        dy = iRows * (GetUniformRowHeight() + iVerticalSize);
+        if ((dx >= w) || (-dx >= w)) bBlit = false;
+        if ((dy >= h) || (-dy >= h)) bBlit = false;
+    }
+
+    //scroll : the exposed area is invalidated by ScrollWindow, and repainted by PaintRect
+    if (bBlit)
+    {
+        wxRect rClient(0, 0, w, h);
+        m_pClient->ScrollWindow(dx, dy, &rClient);
+    }
+    else
+    {
+        m_pClient->Refresh(false, WX_VDV_NULL_PTR);
+    }
+    m_iPaintedFirstLine = iFirstLine;
+    m_iPaintedHorzPos   = iHorzPos;
+    m_pClient->Update();
+}
+
+/** Update the display after inserting / removing rows
+  * For the children of the root item of a list with uniform row heights, the rows already on screen
+  * are kept: the rows above the screen shift the 1st visible line, and only the rows which changed
+  * on screen are repainted. When following the tail, the view is scrolled to the new end of the list
+  * if it was showing the end before the change (the new rows are blitted in).
+  * Otherwise the indices are updated as for OnChildrenChanged(), and the client must be repainted
+  * \param rParent   [input]: the parent of the inserted / removed items
+  * \param uiFirst   [input]: the child index of the 1st inserted / removed item
+  * \param uiCount   [input]: the amount of inserted / removed items
+  * \param bInserted [input]: true if the items were inserted, false if they were removed
+  * \return true if the display was updated, false if the client must be repainted
+  */
+bool wxVirtualTreeModelRenderer::UpdateShiftedRows(const wxVirtualItemID &rParent,
+                                                   size_t uiFirst, size_t uiCount,
+                                                   bool bInserted)
+{
+    if ((!m_pClient) || (!m_pScroller))
+    {
+        OnChildrenChanged(rParent);
+        return(false);
+    }
+
+    //state before the change
+    bool bAtTail     = IsShowingTail();
+    int iFirstLine   = m_iFirstVisibleLine;
+    int iPaintedLine = m_iPaintedFirstLine;
+    int iOldNbItems  = m_iNbVisiblesItems;
+
+    //update the indices & the scrollbars
+    OnChildrenChanged(rParent);
+
+    //only the rows of a flat list are tracked
+    wxVirtualIDataModel *pDataModel = m_pClient->GetDataModel();
+    if (!pDataModel) return(false);
+    wxVirtualIDataModel *pBottomModel = pDataModel->GetBottomModel();
+    if ((!pBottomModel) || (!(pBottomModel->GetModelClass() & wxVirtualIDataModel::WX_MODEL_CLASS_LIST))) return(false);
+    if (!pDataModel->IsRootItem(rParent)) return(false);
+    if (!m_bUniformRowHeight) return(false);
+    if ((iFirstLine < 0) || (iOldNbItems < 0) || (m_iNbVisiblesItems < 0)) return(false);
+
+    int iCount = (int) uiCount;
+    if (!bInserted) iCount = -iCount;
+    if (m_iNbVisiblesItems - iOldNbItems != iCount) return(false);
+
+    //line of the 1st changed row
+    int iLine = (int) uiFirst;
+    if (!m_bHideRootItem) iLine++;
+
+    //rows changed above the screen : the rows on screen keep their pixels
+    if (iLine < iFirstLine)
+    {
+        if ((!bInserted) && (iLine + (int) uiCount > iFirstLine))
+        {
+            //the top rows on screen were removed
+            iFirstLine   = iLine;
+            iPaintedLine = -1;
+        }
+        else
+        {
+            iFirstLine += iCount;
+            if (iPaintedLine >= 0) iPaintedLine += iCount;
+        }
+    }
+
+    //clamp to the new range, or follow the tail
+    int iPageSize = m_pScroller->GetScrollThumb(wxVERTICAL);
+    int iLastFirstLine = 0;
+    if (iPageSize > 0) iLastFirstLine = m_iNbVisiblesItems - iPageSize;
+    if (iLastFirstLine < 0) iLastFirstLine = 0;
+    if ((m_bFollowTail) && (bAtTail)) iFirstLine = iLastFirstLine;
+    if (iFirstLine > iLastFirstLine) iFirstLine = iLastFirstLine;
+    if (iFirstLine < 0) iFirstLine = 0;
+    if (iPaintedLine < 0) iPaintedLine = -1;
+
+    //scroll : the pixels of the rows still on screen are moved
+    m_pScroller->SetScrollPos(wxVERTICAL, iFirstLine, true);
+    ComputeFirstVisibleItem(iFirstLine);
+    m_iPaintedFirstLine = iPaintedLine;
+    ScrollDisplay();
+    ScrollEditorWindow();
+
+    //repaint the rows which changed on screen : from the 1st changed row to the bottom
+    int w = 0;
+    int h = 0;
+    m_pClient->GetClientSize(&w, &h);
+    int iRowHeight = GetRowHeightWithMargins(GetUniformRowHeight());
+    if (iRowHeight <= 0) iRowHeight = 1;
+    int iLastLine = iFirstLine + h / iRowHeight + 1;
+    if (iLine < iFirstLine) return(true);
+    if (iLine > iLastLine) return(true);
+
+    int y = (iLine - iFirstLine) * iRowHeight;
+    wxRect r(0, y, w, h - y);
+    m_pClient->RefreshRect(r, false);
+    return(true);
+}
+
 /** Scroll the editor window
   */
 void wxVirtualTreeModelRenderer::ScrollEditorWindow(void)
@@ -3217,6 +3726,57 @@ bool wxVirtualTreeModelRenderer::MoveTo(const wxVirtualItemID &rID, size_t uiRan
     return(true);
 }
 
+//------------------------- LIVE DATA -------------------------------//
+/** Check if the view follows the end of the list
+  * \return true if the view follows the end of the list
+  */
+bool wxVirtualTreeModelRenderer::IsFollowingTail(void) const
+{
+    return(m_bFollowTail);
+}
+
+/** Follow the end of the list when rows are appended
+  * When the last row is visible and rows are inserted at the root item of a list, the view is
+  * scrolled to show the new last row. Only the rows which become visible are repainted.
+  * Scrolling away from the end pauses the following, until the end is visible again
+  * \param bFollow [input]: true for following the end of the list
+  */
+void wxVirtualTreeModelRenderer::SetFollowTail(bool bFollow)
+{
+    m_bFollowTail = bFollow;
+}
+
+/** Check if the last row is visible
+  * \return true if the last row is visible, or if all the rows fit in the client area
+  */
+bool wxVirtualTreeModelRenderer::IsShowingTail(void) const
+{
+    if (!m_pScroller) return(true);
+    int iPageSize = m_pScroller->GetScrollThumb(wxVERTICAL);
+    if ((iPageSize <= 0) || (m_iNbVisiblesItems <= 0)) return(true);
+    return(m_pScroller->GetScrollPos(wxVERTICAL) + iPageSize >= m_iNbVisiblesItems);
+}
+
+//------------------------- VIEW HINTS ------------------------------//
+/** Check if the viewport is sent to the data model
+  * \return true if the data model is notified when the visible rows change
+  */
+bool wxVirtualTreeModelRenderer::AreViewportHintsEnabled(void) const
+{
+    return(m_bViewportHints);
+}
+
+/** Send the viewport to the data model when it changes
+  * When enabled, wxVirtualIDataModel::OnViewportChanged() is called before painting, each time
+  * the 1st visible row or the amount of visible rows changed. See wxVirtualViewportHint
+  * \param bEnable [input]: true for sending the viewport hints
+  */
+void wxVirtualTreeModelRenderer::EnableViewportHints(bool bEnable)
+{
+    m_bViewportHints = bEnable;
+    m_pHintModel     = WX_VDV_NULL_PTR;
+}
+
 //-------------- RESIZING COLUMNS -----------------------------------//
 
 /** Check and perform columns resizing when needed
@@ -3365,10 +3925,21 @@ void wxVirtualTreeModelRenderer::Init(void)
     m_bIsEditing = false;
     m_pEditor    = WX_VDV_NULL_PTR;
 
+    m_iPaintedFirstLine = -1;
+    m_iPaintedHorzPos   = 0;
+
     if (m_pClient) m_sCurrentClientSize = m_pClient->GetClientSize();
     else           m_sCurrentClientSize.Set(0, 0);
 
     m_bDraggingColumn = false;
+    m_bFollowTail     = false;
+
+    m_bViewportHints  = true;
+    m_pHintModel      = WX_VDV_NULL_PTR;
+    m_uiHintFirstRank = 0;
+    m_uiHintRowCount  = 0;
+    m_dHintVelocity   = 0.0;
+    m_iHintDirection  = 0;
 }
 
 /** Create the tree lines pen
@@ -3596,6 +4167,7 @@ bool wxVirtualTreeModelRenderer::HideRootItem(void) const
 void wxVirtualTreeModelRenderer::HideRootItem(bool bHide)
 {
     m_bHideRootItem = bHide;
+    m_RowHeightIndex.Clear();
 }
 
 /** Show root item
@@ -3603,6 +4175,7 @@ void wxVirtualTreeModelRenderer::HideRootItem(bool bHide)
 void wxVirtualTreeModelRenderer::ShowRootItem(void)
 {
     m_bHideRootItem = false;
+    m_RowHeightIndex.Clear();
 }
 
 /** Get the pen used to draw lines connecting nodes
@@ -3923,6 +4496,7 @@ bool wxVirtualTreeModelRenderer::HasUniformRowHeight(void) const
 void wxVirtualTreeModelRenderer::SetUniformRowHeight(bool bHasUniformRowHeight)
 {
     m_bUniformRowHeight = bHasUniformRowHeight;
+    m_RowHeightIndex.Clear();
 }
 
 /** Unset uniform row heights
@@ -3930,6 +4504,7 @@ void wxVirtualTreeModelRenderer::SetUniformRowHeight(bool bHasUniformRowHeight)
 void wxVirtualTreeModelRenderer::SetVariableRowHeight(void)
 {
     m_bUniformRowHeight = false;
+    m_RowHeightIndex.Clear();
 }
 
 /** Set the uniform row height value (without margins)
@@ -3980,6 +4555,42 @@ int wxVirtualTreeModelRenderer::GetRowHeightWithMargins(int iHeightWithoutMargin
     return(iResult);
 }
 
+//-------------------- VARIABLE ROW HEIGHTS -------------------------//
+/** Get the height of 1 row, with margins
+  * \param rID [input]: the item
+  * \return the height of the row of the item, with margins and grid lines width.
+  *         0 for the hidden root item
+  */
+int wxVirtualTreeModelRenderer::GetRowHeight(const wxVirtualItemID &rID) const
+{
+    if ((m_bHideRootItem) && (m_pClient))
+    {
+        wxVirtualIDataModel *pDataModel = m_pClient->GetDataModel();
+        if ((pDataModel) && (pDataModel->IsRootItem(rID))) return(0);
+    }
+    return(GetRowHeightWithMargins(GetItemSize(rID).GetHeight()));
+}
+
+/** Get the estimated height of the rows not measured yet
+  * \return the estimated row height, with margins. 0 if all rows are measured
+  */
+int wxVirtualTreeModelRenderer::GetEstimatedRowHeight(void) const
+{
+    return(m_RowHeightIndex.GetEstimatedHeight());
+}
+
+/** Set the estimated height of the rows not measured yet
+  * With variable row heights, the first layout measures all the visible rows. With an estimate,
+  * only the painted rows are measured, and the scroll extent is refined as they are painted
+  * \param iHeight [input]: the estimated row height, with margins.
+  *                         0 for measuring all the rows (exact layout)
+  */
+void wxVirtualTreeModelRenderer::SetEstimatedRowHeight(int iHeight)
+{
+    m_RowHeightIndex.SetEstimatedHeight(iHeight);
+    OnLayoutChanged();
+}
+
 //-------------------- UNIFORM COLUMN WIDTHS ------------------------//
 /** Return true if the tree has uniform column widths
   * \return true if the tree has uniform column widths
@@ -4081,62 +4692,6 @@ const wxVirtualDataViewColumnsList& wxVirtualTreeModelRenderer::Columns(void) co
 }
 
 //---------------------- SELECTION ----------------------------------//
-WX_DECLARE_HASH_SET(wxVirtualItemID, wxVirtualItemIDHash, wxVirtualItemIDEqual, TSetOfIDs);
-
-/** Helper: convert an array to a hash set
-  * \param oSetOfIDs [output]: the set of item IDs
-  * \param vIDs      [input] : the array of item IDs
-  */
-WX_VDV_INLINE void VectorToHashSet(TSetOfIDs &oSetOfIDs, const wxVirtualItemIDs &vIDs)
-{
-    oSetOfIDs.clear();
-    size_t i, uiCount;
-    uiCount = vIDs.size();
-    for(i = 0; i < uiCount; i++)
-    {
-        oSetOfIDs.insert(vIDs[i]);
-    }
-}
-
-/** Helper : convert a hash set to an array
-  * \param vIDs      [output]: the array of item IDs
-  * \param oSetOfIDs [input] : the set of item IDs
-  */
-WX_VDV_INLINE void HashSetToVector(wxVirtualItemIDs &vIDs, const TSetOfIDs &oSetOfIDs)
-{
-    vIDs.clear();
-    vIDs.reserve(oSetOfIDs.size());
-    TSetOfIDs::const_iterator it    = oSetOfIDs.begin();
-    TSetOfIDs::const_iterator itEnd = oSetOfIDs.end();
-    while (it != itEnd)
-    {
-        vIDs.push_back(*it);
-        ++it;
-    }
-}
-
-/** Helper : get a range of selected items
-  */
-WX_VDV_INLINE void GetRangeOfItem(wxVirtualItemIDs &vIDs, wxVirtualIStateModel *pStateModel,
-                           const wxVirtualItemID &rID1, const wxVirtualItemID &rID2)
-{
-    vIDs.clear();
-
-    if (!pStateModel) return;
-    wxVirtualIDataModel *pDataModel = rID1.GetTopModel();
-    if (!pDataModel) return;
-
-    wxVirtualItemID id = rID1;
-    size_t uiLevel = 1;
-    do
-    {
-        if (!id.IsOK()) return;
-        vIDs.push_back(id);
-        id = pDataModel->NextItem(id, uiLevel, uiLevel, pStateModel, 1);
-
-    } while(id != rID2);
-}
-
 /** Do the selection
   * \param rID              [input]: ID of the item to select / deselect
   * \param uiField          [input]: the field of the item receiving the focus (model coord)
@@ -4158,32 +4713,30 @@ bool wxVirtualTreeModelRenderer::PerformSelection(const wxVirtualItemID &rID,
                                                   bool bSendEvent,
                                                   bool bSelect)
 {
+    WX_VDV_PERF_TIMER(WX_PERF_SELECTION);
+
     //get state model
     if (!m_pClient) return(false);
     wxVirtualIStateModel *pStateModel = m_pClient->GetStateModel();
     if (!pStateModel) return(false);
 
-    //get old selection
-    wxVirtualItemIDs vIDsOld;
-    TSetOfIDs oSetOfIDs;
-    if (bSendEvent) pStateModel->GetSelectedItems(vIDsOld);
-
-    //compute new selection
-    wxVirtualItemIDs vIDsNew;
+    //the change of selection is described as a delta : its size does not depend on the amount of selected items
+    wxVirtualSelectionDelta oDelta;
 
     bool bChanged = false;
     if ((!rID.IsOK()) || (rID.IsInvalid()))
     {
         //send message
+        oDelta.SetDeselectAll();
         if (bSendEvent)
         {
-            if (!m_pClient->SendSelectionChangingEventByCopy(vIDsOld, vIDsNew)) return(true);
+            if (!m_pClient->SendSelectionChangingEvent(oDelta)) return(true);
         }
 
         //deselect all
         pStateModel->DeselectAll();
 
-        if (bSendEvent) m_pClient->SendSelectionChangedEvent(vIDsOld, vIDsNew);
+        if (bSendEvent) m_pClient->SendSelectionChangedEvent(oDelta);
         bChanged = true;
 
         //set focus item (here it is set to an invalid item. This is not a mistake. This
@@ -4200,18 +4753,15 @@ bool wxVirtualTreeModelRenderer::PerformSelection(const wxVirtualItemID &rID,
         bool bIsSelected = pStateModel->IsSelected(rID);
 
         //send message
+        oDelta.AddItem(rID, !bIsSelected);
         if (bSendEvent)
         {
-            VectorToHashSet(oSetOfIDs, vIDsOld);
-            if (bIsSelected) oSetOfIDs.erase(rID); else oSetOfIDs.insert(rID);
-            HashSetToVector(vIDsNew, oSetOfIDs);
-
-            if (!m_pClient->SendSelectionChangingEventByCopy(vIDsOld, vIDsNew)) return(true);
+            if (!m_pClient->SendSelectionChangingEvent(oDelta)) return(true);
         }
 
         //set selection and send message
         if (pStateModel->Select(rID, !bIsSelected, false)) bChanged = true;
-        if (bSendEvent) m_pClient->SendSelectionChangedEvent(vIDsOld, vIDsNew);
+        if (bSendEvent) m_pClient->SendSelectionChangedEvent(oDelta);
 
         //set focus item
         SetItemFocus(rID, uiField, uiCol, uiRank, bSendEvent);
@@ -4220,33 +4770,29 @@ bool wxVirtualTreeModelRenderer::PerformSelection(const wxVirtualItemID &rID,
     {
         //change range of selected elements
         wxVirtualItemID idFocused = pStateModel->GetFocusedItem();
-        pStateModel->DeselectAll();
         if (idFocused.IsOK())
         {
             //change the range of selected element but do not change the list of selected item
             size_t uiRankFocused = m_uiRankFocusedItem; //idFocused.GetModel()->GetItemRank(idFocused, pStateModel);
             if ((m_bHideRootItem) && (uiRankFocused > 0)) uiRankFocused--;
-            if (uiRankFocused <= uiRank)
+            wxVirtualItemID idFirst = idFocused;
+            wxVirtualItemID idLast  = rID;
+            if (uiRankFocused > uiRank)
             {
-                if (bSendEvent)
-                {
-                    GetRangeOfItem(vIDsNew, pStateModel, idFocused, rID);
-                    if (!m_pClient->SendSelectionChangingEventByCopy(vIDsOld, vIDsNew)) return(true);
-                }
-
-                pStateModel->SelectRange(idFocused, rID, bSelect);
-                if (bSendEvent) m_pClient->SendSelectionChangedEvent(vIDsOld, vIDsNew);
+                idFirst = rID;
+                idLast  = idFocused;
             }
-            else
-            {
-                if (bSendEvent)
-                {
-                    GetRangeOfItem(vIDsNew, pStateModel, rID, idFocused);
-                    if (!m_pClient->SendSelectionChangingEventByCopy(vIDsOld, vIDsNew)) return(true);
-                }
 
-                pStateModel->SelectRange(rID, idFocused, bSelect);
+            oDelta.SetDeselectAll();
+            oDelta.AddRange(idFirst, idLast, bSelect);
+            if (bSendEvent)
+            {
+                if (!m_pClient->SendSelectionChangingEvent(oDelta)) return(true);
             }
+
+            pStateModel->DeselectAll();
+            pStateModel->SelectRange(idFirst, idLast, bSelect);
+            if (bSendEvent) m_pClient->SendSelectionChangedEvent(oDelta);
             bChanged = true;
         }
         else
@@ -4254,15 +4800,17 @@ bool wxVirtualTreeModelRenderer::PerformSelection(const wxVirtualItemID &rID,
             //select the item and focus it
 
             //send selection changing event
+            oDelta.SetDeselectAll();
+            oDelta.AddItem(rID, bSelect);
             if (bSendEvent)
             {
-                vIDsNew.push_back(rID);
-                if (!m_pClient->SendSelectionChangingEventByCopy(vIDsOld, vIDsNew)) return(true);
+                if (!m_pClient->SendSelectionChangingEvent(oDelta)) return(true);
             }
 
             //select and send event
+            pStateModel->DeselectAll();
             if (pStateModel->Select(rID, bSelect, false)) bChanged = true;
-            if (bSendEvent) m_pClient->SendSelectionChangedEvent(vIDsOld, vIDsNew);
+            if (bSendEvent) m_pClient->SendSelectionChangedEvent(oDelta);
 
             //set focus item
             SetItemFocus(rID, uiField, uiCol, uiRank, bSendEvent);
@@ -4273,16 +4821,17 @@ bool wxVirtualTreeModelRenderer::PerformSelection(const wxVirtualItemID &rID,
         //set new selection
 
         //send selection changing event
+        oDelta.SetDeselectAll();
+        oDelta.AddItem(rID, bSelect);
         if (bSendEvent)
         {
-            vIDsNew.push_back(rID);
-            if (!m_pClient->SendSelectionChangingEventByCopy(vIDsOld, vIDsNew)) return(true);
+            if (!m_pClient->SendSelectionChangingEvent(oDelta)) return(true);
         }
 
         //set new selection and send event
         if (pStateModel->DeselectAll()) bChanged = true;
         if (pStateModel->Select(rID, bSelect, false)) bChanged = true; //select this item
-        if (bSendEvent) m_pClient->SendSelectionChangedEvent(vIDsOld, vIDsNew);
+        if (bSendEvent) m_pClient->SendSelectionChangedEvent(oDelta);
 
         //set focus item
         SetItemFocus(rID, uiField, uiCol, uiRank, bSendEvent);
@@ -0,0 +1,877 @@
+/**********************************************************************/
+/** FILE    : VirtualAsyncDataModel.cpp                              **/
+/** PROJECT : wxVirtualDataViewCtrl                                  **/
+/** LICENSE : wxWindows Library Licence                              **/
+/** PURPOSE : proxy data model fetching the values in worker threads **/
+/**********************************************************************/
+
+#include <wx/VirtualDataView/Models/VirtualAsyncDataModel.h>
+#include <wx/VirtualDataView/Models/VirtualIListDataModel.h>
+#include <wx/VirtualDataView/Models/VirtualIArrayProxyDataModel.h>
+#include <wx/VirtualDataView/Types/VirtualValue.h>
+#include <wx/VirtualDataView/Utilities/ParallelSort.hpp>
+#include <wx/event.h>
+
+/** Check if a cell is concerned by a change notification
+  * \param rKey    [input]: the cell
+  * \param setIDs  [input]: the items which changed
+  * \param vFields [input]: the fields which changed. Empty for all fields
+  * \return true if the cell changed
+  */
+static bool IsChangedCell(const wxVirtualAsyncCellKey &rKey, const TSetOfItemIDs &setIDs,
+                          const wxVirtualIDataModel::TFieldIDs &vFields)
+{
+    if (setIDs.find(rKey.m_ID) == setIDs.end()) return(false);
+
+    size_t i, uiNbFields;
+    uiNbFields = vFields.size();
+    if (uiNbFields == 0) return(true);
+    for(i = 0; i < uiNbFields; i++)
+    {
+        if (vFields[i] == rKey.m_uiField) return(true);
+    }
+    return(false);
+}
+
+#if wxUSE_THREADS
+//------------------------------ WORKER -----------------------------//
+/** \class wxVirtualAsyncWorker : fetches the requested cells from the master model
+  */
+class wxVirtualAsyncWorker : public wxThread
+{
+    public:
+        //constructor
+        wxVirtualAsyncWorker(wxVirtualAsyncDataModel *pModel)
+            : wxThread(wxTHREAD_JOINABLE),
+              m_pModel(pModel)
+        {}
+
+    protected:
+        //data
+        wxVirtualAsyncDataModel*    m_pModel;                       ///< \brief the model owning the worker
+
+        /** Thread entry point : fetch the requests until the model stops the workers
+          */
+        virtual ExitCode Entry(void)
+        {
+            wxVirtualAsyncDataModel::TRequest oRequest;
+            wxVirtualIDataModel *pMaster;
+            while (m_pModel->PopRequest(oRequest, pMaster))
+            {
+                wxVariant vValue = pMaster->GetItemData(oRequest.m_Key.m_ID,
+                                                        oRequest.m_Key.m_uiField,
+                                                        wxVirtualIDataModel::WX_ITEM_MAIN_DATA);
+                m_pModel->PushResult(oRequest, vValue);
+            }
+            return(0);
+        }
+};
+
+//------------------------------ NOTIFIER ---------------------------//
+/** \class wxVirtualAsyncNotifier : delivers the fetched values in the GUI thread
+  * The workers queue 1 event per batch of results
+  */
+class wxVirtualAsyncNotifier : public wxEvtHandler
+{
+    public:
+        //constructor
+        wxVirtualAsyncNotifier(wxVirtualAsyncDataModel *pModel)
+            : wxEvtHandler(),
+              m_pModel(pModel)
+        {
+            Bind(wxEVT_THREAD, &wxVirtualAsyncNotifier::OnResultsEvent, this);
+        }
+
+    protected:
+        //data
+        wxVirtualAsyncDataModel*    m_pModel;                       ///< \brief the notified model
+
+        /** Some values were fetched
+          * \param rEvent [input]: the event information
+          */
+        void OnResultsEvent(wxThreadEvent &rEvent)
+        {
+            m_pModel->DeliverResults();
+        }
+};
+
+/** Lock the requests & the results in the current scope
+  */
+#define WX_VDV_LOCK_REQUESTS()      wxMutexLocker oRequestsLocker(m_Mutex)
+#else
+#define WX_VDV_LOCK_REQUESTS()
+#endif // wxUSE_THREADS
+
+//----------------------- CONSTRUCTORS & DESTRUCTOR -----------------//
+/** Default constructor
+  */
+wxVirtualAsyncDataModel::wxVirtualAsyncDataModel(void)
+    : wxVirtualIProxyDataModel(),
+      m_Cache(WX_VDV_ASYNC_DEFAULT_CACHE_SIZE),
+      m_uiMisses(0),
+      m_bPaintFetch(false),
+      m_bWindowMoved(false),
+      m_uiGeneration(0),
+      m_uiMaxRequests(WX_VDV_ASYNC_DEFAULT_MAX_REQUESTS),
+      m_uiCancelled(0),
+      m_bDeliveryQueued(false),
+      m_bStop(false),
+      m_uiWorkerCount(0)
+#if wxUSE_THREADS
+      , m_Mutex(),
+      m_Condition(m_Mutex),
+      m_pNotifier(WX_VDV_NULL_PTR)
+#endif // wxUSE_THREADS
+{
+#if wxUSE_THREADS
+    m_pNotifier = new wxVirtualAsyncNotifier(this);
+#endif // wxUSE_THREADS
+}
+
+/** Destructor
+  */
+wxVirtualAsyncDataModel::~wxVirtualAsyncDataModel(void)
+{
+    StopWorkers();
+#if wxUSE_THREADS
+    if (m_pNotifier)
+    {
+        m_pNotifier->DeletePendingEvents();
+        delete(m_pNotifier);
+    }
+    m_pNotifier = WX_VDV_NULL_PTR;
+#endif // wxUSE_THREADS
+}
+
+//--------------------------- PLACEHOLDER ---------------------------//
+/** Get the value shown while a cell is fetched
+  * \return the placeholder value
+  */
+const wxVariant& wxVirtualAsyncDataModel::GetPlaceholder(void) const
+{
+    return(m_vPlaceholder);
+}
+
+/** Set the value shown while a cell is fetched
+  * \param rvPlaceholder [input]: the placeholder value. Null (default) for an empty cell
+  */
+void wxVirtualAsyncDataModel::SetPlaceholder(const wxVariant &rvPlaceholder)
+{
+    m_vPlaceholder = rvPlaceholder;
+}
+
+//------------------------------ CACHE ------------------------------//
+/** Get the maximal amount of cached cells
+  * \return the maximal amount of cells in the values cache
+  */
+size_t wxVirtualAsyncDataModel::GetCacheSize(void) const
+{
+    return(m_Cache.GetCacheSize());
+}
+
+/** Set the maximal amount of cached cells
+  * \param uiCells [input]: the maximal amount of cells in the values cache.
+  *                         Should be larger than the amount of cells visible on screen
+  */
+void wxVirtualAsyncDataModel::SetCacheSize(size_t uiCells)
+{
+    if (uiCells == 0) uiCells = 1;
+    m_Cache.SetCacheSize(uiCells);
+}
+
+/** Clear the cached values & cancel the requests
+  * The values are fetched again when they are displayed. No notification is sent
+  */
+void wxVirtualAsyncDataModel::ClearCache(void)
+{
+    ResetCache();
+}
+
+/** Check if a cell is in the cache
+  * \param rID     [input]: the item
+  * \param uiField [input]: the field
+  * \return true if the value of the cell is in the cache
+  */
+bool wxVirtualAsyncDataModel::IsCached(const wxVirtualItemID &rID, size_t uiField) const
+{
+    wxVirtualAsyncCellKey oKey;
+    oKey.m_ID      = rID;
+    oKey.m_uiField = uiField;
+    return(m_Cache.HasKey(oKey));
+}
+
+/** Get the amount of cells served from the cache
+  * \return the amount of cache hits
+  */
+size_t wxVirtualAsyncDataModel::GetCacheHits(void) const
+{
+    return(m_Cache.GetHits());
+}
+
+/** Get the amount of cells served as placeholder
+  * \return the amount of cells which were not in the cache, and were requested to the workers
+  */
+size_t wxVirtualAsyncDataModel::GetCacheMisses(void) const
+{
+    return(m_uiMisses);
+}
+
+//----------------------------- WORKERS -----------------------------//
+/** Get the requested amount of workers
+  * \return the requested amount of workers. 0 for 1 worker per CPU
+  */
+size_t wxVirtualAsyncDataModel::GetWorkerCount(void) const
+{
+    return(m_uiWorkerCount);
+}
+
+/** Set the amount of workers
+  * \param uiWorkers [input]: the amount of worker threads. 0 (default) for 1 worker per CPU
+  * The running workers are stopped: the new amount is used on the next cache miss
+  */
+void wxVirtualAsyncDataModel::SetWorkerCount(size_t uiWorkers)
+{
+    if (uiWorkers == m_uiWorkerCount) return;
+    StopWorkers();
+    m_uiWorkerCount = uiWorkers;
+}
+
+/** Cancel the requests and stop the workers
+  * Wait until the workers have finished their current request. The values already fetched
+  * are discarded. The workers are started again on the next cache miss
+  */
+void wxVirtualAsyncDataModel::StopWorkers(void)
+{
+#if wxUSE_THREADS
+    if (m_vWorkers.empty()) return;
+
+    {
+        WX_VDV_LOCK_REQUESTS();
+        m_uiCancelled += m_dqRequests.size();
+        m_dqRequests.clear();
+        m_setPending.clear();
+        m_setStale.clear();
+        m_uiGeneration++;
+        m_bStop = true;
+        m_Condition.Broadcast();
+    }
+
+    size_t i, uiSize;
+    uiSize = m_vWorkers.size();
+    for(i = 0; i < uiSize; i++)
+    {
+        m_vWorkers[i]->Wait();
+        delete(m_vWorkers[i]);
+    }
+    m_vWorkers.clear();
+
+    WX_VDV_LOCK_REQUESTS();
+    m_vResults.clear();
+    m_bStop = false;
+#endif // wxUSE_THREADS
+}
+
+/** Start the workers if needed
+  * \return true if the workers are running, false if the values must be read synchronously
+  */
+bool wxVirtualAsyncDataModel::StartWorkers(void)
+{
+#if wxUSE_THREADS
+    if (!m_vWorkers.empty()) return(true);
+    if (!m_pDataModel) return(false);
+    if (!m_pDataModel->IsThreadSafe()) return(false);
+
+    size_t i, uiNbWorkers;
+    uiNbWorkers = wxGetParallelSortWorkerCount(m_uiWorkerCount);
+    for(i = 0; i < uiNbWorkers; i++)
+    {
+        wxVirtualAsyncWorker *pWorker = new wxVirtualAsyncWorker(this);
+        if ((pWorker->Create() != wxTHREAD_NO_ERROR) || (pWorker->Run() != wxTHREAD_NO_ERROR))
+        {
+            delete(pWorker);
+            break;
+        }
+        m_vWorkers.push_back(pWorker);
+    }
+    return(!m_vWorkers.empty());
+#else
+    return(false);
+#endif // wxUSE_THREADS
+}
+
+/** Get the next request (worker threads)
+  * Block until a request is available, or until the workers are stopped
+  * \param rRequest [output]: the request to fetch
+  * \param pMaster  [output]: the master model to read
+  * \return true if a request was returned, false if the worker must exit
+  */
+bool wxVirtualAsyncDataModel::PopRequest(TRequest &rRequest, wxVirtualIDataModel* &pMaster)
+{
+#if wxUSE_THREADS
+    WX_VDV_LOCK_REQUESTS();
+    while ((!m_bStop) && (m_dqRequests.empty())) m_Condition.Wait();
+    if (m_bStop) return(false);
+
+    rRequest = m_dqRequests.front();
+    m_dqRequests.pop_front();
+    pMaster = m_pDataModel;
+    return(pMaster != WX_VDV_NULL_PTR);
+#else
+    return(false);
+#endif // wxUSE_THREADS
+}
+
+/** Store a result (worker threads)
+  * \param rRequest [input]: the fetched request
+  * \param rvValue  [input]: the fetched value. It is set to null: the reference count of the
+  *                          variant data is changed under the lock only
+  * If the cell changed while it was fetched, the value is discarded and the cell is queued again
+  */
+void wxVirtualAsyncDataModel::PushResult(const TRequest &rRequest, wxVariant &rvValue)
+{
+#if wxUSE_THREADS
+    bool bNotify = false;
+    {
+        WX_VDV_LOCK_REQUESTS();
+        if ((rRequest.m_uiGeneration == m_uiGeneration) && (m_setStale.erase(rRequest.m_Key) > 0))
+        {
+            m_dqRequests.push_front(rRequest);
+            m_Condition.Signal();
+        }
+        else if (rRequest.m_uiGeneration == m_uiGeneration)
+        {
+            TResult oResult;
+            oResult.m_Key          = rRequest.m_Key;
+            oResult.m_vValue       = rvValue;
+            oResult.m_uiGeneration = rRequest.m_uiGeneration;
+            m_vResults.push_back(oResult);
+
+            if (!m_bDeliveryQueued)
+            {
+                m_bDeliveryQueued = true;
+                bNotify = true;
+            }
+        }
+        rvValue.MakeNull();
+    }
+
+    if (bNotify) wxQueueEvent(m_pNotifier, new wxThreadEvent(wxEVT_THREAD));
+#endif // wxUSE_THREADS
+}
+
+//----------------------------- REQUESTS ----------------------------//
+/** Get the maximal amount of queued requests
+  * \return the maximal amount of requests waiting for a worker
+  */
+size_t wxVirtualAsyncDataModel::GetMaxPendingRequests(void) const
+{
+    return(m_uiMaxRequests);
+}
+
+/** Set the maximal amount of queued requests
+  * \param uiMaxRequests [input]: the maximal amount of requests waiting for a worker.
+  *                               A few screens of cells: the older requests are cancelled
+  */
+void wxVirtualAsyncDataModel::SetMaxPendingRequests(size_t uiMaxRequests)
+{
+    if (uiMaxRequests == 0) uiMaxRequests = 1;
+    WX_VDV_LOCK_REQUESTS();
+    m_uiMaxRequests = uiMaxRequests;
+}
+
+/** Get the amount of queued requests
+  * \return the amount of requests waiting for a worker
+  */
+size_t wxVirtualAsyncDataModel::GetPendingRequestCount(void) const
+{
+    WX_VDV_LOCK_REQUESTS();
+    return(m_dqRequests.size());
+}
+
+/** Get the amount of requests cancelled
+  * \return the amount of requests cancelled before being fetched
+  */
+size_t wxVirtualAsyncDataModel::GetCancelledRequestCount(void) const
+{
+    WX_VDV_LOCK_REQUESTS();
+    return(m_uiCancelled);
+}
+
+/** Cancel all the requests not started yet
+  * The cancelled cells are requested again if they are displayed again
+  */
+void wxVirtualAsyncDataModel::CancelPendingRequests(void)
+{
+    WX_VDV_LOCK_REQUESTS();
+    size_t i, uiSize;
+    uiSize = m_dqRequests.size();
+    for(i = 0; i < uiSize; i++) m_setPending.erase(m_dqRequests[i].m_Key);
+    m_uiCancelled += uiSize;
+    m_dqRequests.clear();
+}
+
+/** Queue requests in front of the queue
+  * \param pKeys      [input]: the cells to fetch, most urgent first
+  * \param uiNbKeys   [input]: the amount of cells
+  * \param bNewWindow [input]: true if the cells are the 1st batch painted since the visible rows changed.
+  *                           The queued requests which are not in the batch are cancelled, and their
+  *                           items are repainted : the ones still on screen are requested again
+  * The cells already queued, being fetched or not delivered yet are skipped.
+  * If the queue is full, the oldest requests (at the back of the queue) are cancelled
+  */
+void wxVirtualAsyncDataModel::RequestCells(const wxVirtualAsyncCellKey *pKeys, size_t uiNbKeys,
+                                           bool bNewWindow)
+{
+#if wxUSE_THREADS
+    if ((uiNbKeys == 0) && (!bNewWindow)) return;
+
+    bool bNotify = false;
+    {
+        WX_VDV_LOCK_REQUESTS();
+        size_t i, uiSize, uiNbNew;
+
+        //cancel the requests of the previous visible window
+        if ((bNewWindow) && (!m_dqRequests.empty()))
+        {
+            TSetOfAsyncCells setWindow;
+            for(i = 0; i < uiNbKeys; i++) setWindow.insert(pKeys[i]);
+
+            TRequests dqKept;
+            uiSize = m_dqRequests.size();
+            for(i = 0; i < uiSize; i++)
+            {
+                const TRequest &rRequest = m_dqRequests[i];
+                if (setWindow.find(rRequest.m_Key) != setWindow.end())
+                {
+                    dqKept.push_back(rRequest);
+                    continue;
+                }
+                m_setPending.erase(rRequest.m_Key);
+                m_vCancelledIDs.push_back(rRequest.m_Key.m_ID);
+                m_uiCancelled++;
+            }
+            m_dqRequests.swap(dqKept);
+
+            if ((!m_vCancelledIDs.empty()) && (!m_bDeliveryQueued))
+            {
+                m_bDeliveryQueued = true;
+                bNotify = true;
+            }
+        }
+
+        //insert in reverse order at the front : the 1st cell is fetched first
+        TRequest oRequest;
+        oRequest.m_uiGeneration = m_uiGeneration;
+        uiNbNew = 0;
+        i = uiNbKeys;
+        while (i > 0)
+        {
+            i--;
+            if (!m_setPending.insert(pKeys[i]).second) continue;
+            oRequest.m_Key = pKeys[i];
+            m_dqRequests.push_front(oRequest);
+            uiNbNew++;
+        }
+
+        if (uiNbNew > 0)
+        {
+            //cancel the oldest requests
+            while (m_dqRequests.size() > m_uiMaxRequests)
+            {
+                m_setPending.erase(m_dqRequests.back().m_Key);
+                m_dqRequests.pop_back();
+                m_uiCancelled++;
+            }
+
+            if (uiNbNew == 1) m_Condition.Signal();
+            else              m_Condition.Broadcast();
+        }
+    }
+
+    if (bNotify) wxQueueEvent(m_pNotifier, new wxThreadEvent(wxEVT_THREAD));
+#endif // wxUSE_THREADS
+}
+
+/** Deliver the resolved values now
+  * The values are stored in the cache, and 1 ItemsRefreshed() notification is sent for all the
+  * items delivered, and for the items whose requests were cancelled when the visible rows
+  * changed: only the view repaints them. The sorting / filtering proxies above did not see
+  * the placeholders, so they have nothing to update. Called automatically in the GUI thread when the workers have new values
+  */
+void wxVirtualAsyncDataModel::DeliverResults(void)
+{
+    TResults vResults;
+    wxVirtualItemIDs vCancelledIDs;
+    size_t uiGeneration;
+    {
+        WX_VDV_LOCK_REQUESTS();
+        vResults.swap(m_vResults);
+        vCancelledIDs.swap(m_vCancelledIDs);
+        m_bDeliveryQueued = false;
+        uiGeneration = m_uiGeneration;
+
+        size_t i, uiSize;
+        uiSize = vResults.size();
+        for(i = 0; i < uiSize; i++)
+        {
+            if (vResults[i].m_uiGeneration == uiGeneration) m_setPending.erase(vResults[i].m_Key);
+        }
+    }
+
+    wxVirtualItemIDs vIDs;
+    TSetOfItemIDs setIDs;
+
+    size_t i, uiSize;
+    uiSize = vResults.size();
+    for(i = 0; i < uiSize; i++)
+    {
+        TResult &rResult = vResults[i];
+        if (rResult.m_uiGeneration != uiGeneration) continue;
+        m_Cache.Insert(rResult.m_Key, rResult.m_vValue);
+
+        if (setIDs.insert(rResult.m_Key.m_ID).second) vIDs.push_back(rResult.m_Key.m_ID);
+    }
+
+    //cancelled requests : the cells still on screen are requested again when they are repainted
+    uiSize = vCancelledIDs.size();
+    for(i = 0; i < uiSize; i++)
+    {
+        if (setIDs.insert(vCancelledIDs[i]).second) vIDs.push_back(vCancelledIDs[i]);
+    }
+
+    if (!vIDs.empty()) ItemsRefreshed(vIDs);
+}
+
+/** Clear the cache, and cancel the requests
+  * The values being fetched are discarded when they are delivered
+  */
+void wxVirtualAsyncDataModel::ResetCache(void)
+{
+    m_Cache.ClearCache();
+
+    WX_VDV_LOCK_REQUESTS();
+    m_uiCancelled += m_dqRequests.size();
+    m_dqRequests.clear();
+    m_setPending.clear();
+    m_setStale.clear();
+    m_vResults.clear();
+    m_vCancelledIDs.clear();
+    m_uiGeneration++;
+}
+
+/** Get a value from the cache, or the placeholder
+  * \param rvValue [output]: the cached value, or the placeholder
+  * \param rKey    [input] : the cell
+  * \return true if rvValue is the value of the cell, false if it is the placeholder.
+  *         In that case, the cell is appended to m_vMissedCells
+  */
+bool wxVirtualAsyncDataModel::FindValue(wxVariant &rvValue, const wxVirtualAsyncCellKey &rKey)
+{
+    wxVariant *pValue = m_Cache.Find(rKey);
+    if (pValue)
+    {
+        rvValue = *pValue;
+        return(true);
+    }
+
+    if (!StartWorkers())
+    {
+        rvValue = m_pDataModel->GetItemData(rKey.m_ID, rKey.m_uiField, WX_ITEM_MAIN_DATA);
+        m_Cache.Insert(rKey, rvValue);
+        return(true);
+    }
+
+    m_uiMisses++;
+    rvValue = m_vPlaceholder;
+    m_vMissedCells.push_back(rKey);
+    return(false);
+}
+
+//-------------------------- INTERFACE : ITEM DATA ------------------//
+/** Get the item data
+  * \param rID     [input]: the ID of the item to query
+  * \param uiField [input]: the field index of the item to query
+  * \param eType   [input]: the kind of data to get
+  * \return the cached main data, or the main data read synchronously from the master model
+  *         if it is not cached. Never the placeholder: the proxy models sorting or filtering
+  *         above this model need the real values.
+  *         Other kinds of data are read from the master model
+  */
+wxVariant wxVirtualAsyncDataModel::GetItemData(const wxVirtualItemID &rID,
+                                               size_t uiField, EDataType eType)
+{
+    if ((eType != WX_ITEM_MAIN_DATA) || (!m_pDataModel))
+    {
+        return(wxVirtualIProxyDataModel::GetItemData(rID, uiField, eType));
+    }
+
+    wxVirtualAsyncCellKey oKey;
+    oKey.m_ID      = rID;
+    oKey.m_uiField = uiField;
+
+    wxVariant *pValue = m_Cache.Find(oKey);
+    if (pValue) return(*pValue);
+    return(m_pDataModel->GetItemData(rID, uiField, eType));
+}
+
+/** Get the item data without allocation
+  * \param rValue  [output]: the cached main data, or the main data read synchronously from the
+  *                          master model if it is not cached
+  * \param rID     [input] : the ID of the item to query
+  * \param uiField [input] : the field index of the item to query
+  * \param eType   [input] : the kind of data to get
+  */
+void wxVirtualAsyncDataModel::GetItemValue(wxVirtualValue &rValue, const wxVirtualItemID &rID,
+                                           size_t uiField, EDataType eType)
+{
+    if ((eType != WX_ITEM_MAIN_DATA) || (!m_pDataModel))
+    {
+        ForwardItemValue(rValue, rID, uiField, eType);
+        return;
+    }
+
+    rValue.SetVariant(GetItemData(rID, uiField, eType));
+}
+
+/** Get the data of several items & fields at once
+  * \param vValues [output]: the values, row by row. See wxVirtualIDataModel::GetItemDataBatch()
+  * \param vIDs    [input] : the items to query
+  * \param vFields [input] : the fields to query
+  * \param eType   [input] : the kind of data to get
+  * Inside an OnPaintFetch() scope, the batch is considered as the visible window: the missing
+  * cells get the placeholder, and are fetched before all the cells requested earlier, in the
+  * order of the batch. Outside of it (sorting, filtering, ...), the batch is forwarded to the
+  * master model
+  */
+void wxVirtualAsyncDataModel::GetItemDataBatch(wxVirtualValues &vValues, const wxVirtualItemIDs &vIDs,
+                                               const TFieldIDs &vFields, EDataType eType)
+{
+    if ((eType != WX_ITEM_MAIN_DATA) || (!m_pDataModel) || (!m_bPaintFetch))
+    {
+        ForwardItemDataBatch(vValues, vIDs, vFields, eType);
+        return;
+    }
+
+    size_t uiNbIDs    = vIDs.size();
+    size_t uiNbFields = vFields.size();
+    vValues.resize(uiNbIDs * uiNbFields);
+
+    wxVirtualAsyncCellKey oKey;
+    wxVariant vValue;
+    m_vMissedCells.clear();
+
+    size_t i, j, k;
+    k = 0;
+    for(i = 0; i < uiNbIDs; i++)
+    {
+        oKey.m_ID = vIDs[i];
+        for(j = 0; j < uiNbFields; j++)
+        {
+            oKey.m_uiField = vFields[j];
+            FindValue(vValue, oKey);
+            vValues[k].SetVariant(vValue);
+            k++;
+        }
+    }
+
+    //1st batch painted since the visible rows changed : it replaces the previous visible window
+    bool bNewWindow = m_bWindowMoved;
+    m_bWindowMoved = false;
+    if (m_vMissedCells.empty()) RequestCells(WX_VDV_NULL_PTR, 0, bNewWindow);
+    else                        RequestCells(&(m_vMissedCells[0]), m_vMissedCells.size(), bNewWindow);
+}
+
+/** Set the item data
+  * \param rID     [input]: the ID of the item to modify
+  * \param uiField [input]: the field index of the item to modify
+  * \param vValue  [input]: the new value
+  * \param eType   [input]: the kind of data to modify
+  * \return true if the data was modified in the master model
+  */
+bool wxVirtualAsyncDataModel::SetItemData(const wxVirtualItemID &rID, size_t uiField,
+                                          const wxVariant &vValue, EDataType eType)
+{
+    bool bResult = wxVirtualIProxyDataModel::SetItemData(rID, uiField, vValue, eType);
+    if ((bResult) && (eType == WX_ITEM_MAIN_DATA))
+    {
+        wxVirtualAsyncCellKey oKey;
+        oKey.m_ID      = rID;
+        oKey.m_uiField = uiField;
+        m_Cache.Remove(oKey);
+    }
+    return(bResult);
+}
+
+//--------------------------- MULTI-THREADING -----------------------//
+/** Check if GetItemData() & Compare() can be called from worker threads
+  * \return false : reading the values modifies the cache
+  */
+bool wxVirtualAsyncDataModel::IsThreadSafe(void)
+{
+    return(false);
+}
+
+//----------------------------- VIEW HINTS --------------------------//
+/** The view starts / stops reading the values of the painted cells
+  * \param bStart [input]: true before the values are read, false after
+  * Only the batches read in this scope may get placeholders. The hint is forwarded to the
+  * master model
+  */
+void wxVirtualAsyncDataModel::OnPaintFetch(bool bStart)
+{
+    m_bPaintFetch = bStart;
+    wxVirtualIProxyDataModel::OnPaintFetch(bStart);
+}
+
+/** The rows shown by the view changed
+  * \param rHint [input]: the visible rows, and the scrolling speed & direction
+  * The next painted batch replaces the visible window: the requests queued for the previous
+  * one are cancelled (see RequestCells()). The hint is forwarded to the master model
+  */
+void wxVirtualAsyncDataModel::OnViewportChanged(const wxVirtualViewportHint &rHint)
+{
+    m_bWindowMoved = true;
+    wxVirtualIProxyDataModel::OnViewportChanged(rHint);
+}
+
+//------------------ PARTIAL UPDATES : NOTIFICATIONS ----------------//
+/** The rows of the bottom list model were shifted
+  * \param pListModel [input]: the bottom list model
+  * \param uiFirst    [input]: the 1st inserted / removed row
+  * \param uiCount    [input]: the amount of inserted / removed rows
+  * \param bInserted  [input]: true if the rows were inserted, false if they were removed
+  * The item IDs of the following rows changed: the cache is cleared, unless the rows were
+  * appended at the end of the list (live data)
+  */
+void wxVirtualAsyncDataModel::OnItemIDsShifted(wxVirtualIListDataModel *pListModel,
+                                               size_t uiFirst, size_t uiCount,
+                                               bool bInserted)
+{
+    if ((!bInserted) || (uiFirst + uiCount < pListModel->GetItemCount())) ResetCache();
+    wxVirtualIProxyDataModel::OnItemIDsShifted(pListModel, uiFirst, uiCount, bInserted);
+}
+
+/** The values of some items of the master model changed
+  * \param vIDs    [input]: the items which changed
+  * \param vFields [input]: the fields which changed. Empty for all fields
+  * The cached values of these cells are removed. Only the requests of these cells are affected:
+  * the queued ones and the results not delivered yet are cancelled, and the ones being fetched
+  * are fetched again (their value may be outdated)
+  */
+void wxVirtualAsyncDataModel::OnMasterItemsChanged(const wxVirtualItemIDs &vIDs,
+                                                   const TFieldIDs &vFields)
+{
+    {
+        WX_VDV_LOCK_REQUESTS();
+        if (!m_setPending.empty())
+        {
+            TSetOfItemIDs setIDs;
+            size_t i, uiSize;
+            uiSize = vIDs.size();
+            for(i = 0; i < uiSize; i++) setIDs.insert(vIDs[i]);
+
+            //queued requests
+            TRequests dqKept;
+            uiSize = m_dqRequests.size();
+            for(i = 0; i < uiSize; i++)
+            {
+                const TRequest &rRequest = m_dqRequests[i];
+                if (IsChangedCell(rRequest.m_Key, setIDs, vFields))
+                {
+                    m_setPending.erase(rRequest.m_Key);
+                    m_uiCancelled++;
+                }
+                else
+                {
+                    dqKept.push_back(rRequest);
+                }
+            }
+            m_dqRequests.swap(dqKept);
+
+            //results not delivered yet
+            TResults vKept;
+            uiSize = m_vResults.size();
+            for(i = 0; i < uiSize; i++)
+            {
+                TResult &rResult = m_vResults[i];
+                if ((rResult.m_uiGeneration == m_uiGeneration) &&
+                    (IsChangedCell(rResult.m_Key, setIDs, vFields)))
+                {
+                    m_setPending.erase(rResult.m_Key);
+                }
+                else
+                {
+                    vKept.push_back(rResult);
+                }
+            }
+            m_vResults.swap(vKept);
+
+            //the remaining pending cells are being fetched
+            TSetOfAsyncCells::iterator it    = m_setPending.begin();
+            TSetOfAsyncCells::iterator itEnd = m_setPending.end();
+            while(it != itEnd)
+            {
+                if (IsChangedCell(*it, setIDs, vFields)) m_setStale.insert(*it);
+                ++it;
+            }
+        }
+    }
+
+    wxVirtualAsyncCellKey oKey;
+    size_t i, j, uiNbIDs, uiNbFields;
+    uiNbIDs = vIDs.size();
+    for(i = 0; i < uiNbIDs; i++)
+    {
+        oKey.m_ID = vIDs[i];
+        if (vFields.empty())
+        {
+            uiNbFields = m_pDataModel->GetFieldCount(vIDs[i]);
+            for(j = 0; j < uiNbFields; j++)
+            {
+                oKey.m_uiField = j;
+                m_Cache.Remove(oKey);
+            }
+        }
+        else
+        {
+            uiNbFields = vFields.size();
+            for(j = 0; j < uiNbFields; j++)
+            {
+                oKey.m_uiField = vFields[j];
+                m_Cache.Remove(oKey);
+            }
+        }
+    }
+
+    wxVirtualIProxyDataModel::OnMasterItemsChanged(vIDs, vFields);
+}
+
+/** Some items were removed from the master model
+  * \param rParent [input]: the parent of the removed items
+  * \param uiFirst [input]: the child index of the 1st removed item in the master model
+  * \param uiCount [input]: the amount of removed items
+  * The IDs of the removed items may be reused by new items: the cache is cleared
+  */
+void wxVirtualAsyncDataModel::OnMasterItemsRemoved(const wxVirtualItemID &rParent,
+                                                   size_t uiFirst, size_t uiCount)
+{
+    ResetCache();
+    wxVirtualIProxyDataModel::OnMasterItemsRemoved(rParent, uiFirst, uiCount);
+}
+
+/** The children of an item of the master model changed
+  * \param rParent [input]: the item whose children changed
+  */
+void wxVirtualAsyncDataModel::OnMasterChildrenReset(const wxVirtualItemID &rParent)
+{
+    ResetCache();
+    wxVirtualIProxyDataModel::OnMasterChildrenReset(rParent);
+}
+
+/** The whole master model changed
+  */
+void wxVirtualAsyncDataModel::OnMasterModelReset(void)
+{
+    ResetCache();
+    wxVirtualIProxyDataModel::OnMasterModelReset();
+}
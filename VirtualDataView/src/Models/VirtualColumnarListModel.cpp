@@ -0,0 +1,816 @@
+/**********************************************************************/
+/** FILE    : VirtualColumnarListModel.cpp                           **/
+/** PROJECT : wxVirtualDataViewCtrl                                  **/
+/** LICENSE : wxWindows Library Licence                              **/
+/** PURPOSE : in-memory list data model storing typed columns        **/
+/**********************************************************************/
+
+#include <wx/VirtualDataView/Models/VirtualColumnarListModel.h>
+#include <wx/VirtualDataView/Types/VirtualValue.h>
+#include <wx/VirtualDataView/Types/VariantUtils.h>
+#include <wx/VirtualDataView/Types/BitArray.h>
+#include <algorithm>
+
+/** String comparison functor, for sorting dictionary codes
+  */
+struct TColumnarStringLess
+{
+    TColumnarStringLess(const wxVector<wxString> &vStrings) : m_vStrings(vStrings) {}
+
+    WX_VDV_INLINE bool operator()(size_t ui1, size_t ui2) const
+    {
+        return(m_vStrings[ui1].Cmp(m_vStrings[ui2]) < 0);
+    }
+
+    const wxVector<wxString> &m_vStrings;
+};
+
+/** Check if a double is NaN
+  * \param dValue [input]: the value to check
+  * \return true if the value is NaN
+  */
+WX_VDV_INLINE bool IsNaN(double dValue)
+{
+    return(dValue != dValue);
+}
+
+/** Compare 2 values
+  * \param v1 [input]: the 1st value
+  * \param v2 [input]: the 2nd value
+  * \return the comparison result
+  */
+template<typename T>
+WX_VDV_INLINE wxVirtualIDataModel::ECompareResult CompareValues(const T &v1, const T &v2)
+{
+    if (v1 < v2) return(wxVirtualIDataModel::WX_E_LESS_THAN);
+    if (v2 < v1) return(wxVirtualIDataModel::WX_E_GREATER_THAN);
+    return(wxVirtualIDataModel::WX_E_EQUAL);
+}
+
+//------------------ CONSTRUCTORS & DESTRUCTOR ----------------------//
+/** Default constructor
+  */
+wxVirtualColumnarListModel::wxVirtualColumnarListModel(void)
+    : wxVirtualIListDataModel(),
+      m_uiRowCount(0)
+{
+
+}
+
+/** Destructor
+  */
+wxVirtualColumnarListModel::~wxVirtualColumnarListModel(void)
+{
+    size_t i, uiNbColumns;
+    uiNbColumns = m_vColumns.size();
+    for(i = 0; i < uiNbColumns; i++) delete(m_vColumns[i]);
+    m_vColumns.clear();
+}
+
+//---------------------------- COLUMNS ------------------------------//
+/** Add a column
+  * The existing rows get the default value of the type (0, false, epoch, empty string)
+  * \param eType [input]: the type of the values of the column
+  * \param sName [input]: the name of the column
+  * \return the field index of the new column
+  */
+size_t wxVirtualColumnarListModel::AddColumn(EColumnType eType, const wxString &sName)
+{
+    TColumn *pColumn = new TColumn;
+    pColumn->m_eType = eType;
+    pColumn->m_sName = sName;
+    if (eType == WX_COLUMN_STRING) GetStringCode(pColumn, wxEmptyString);
+    ResizeColumn(pColumn, m_uiRowCount);
+
+    m_vColumns.push_back(pColumn);
+    return(m_vColumns.size() - 1);
+}
+
+/** Get the amount of columns
+  * \return the amount of columns
+  */
+size_t wxVirtualColumnarListModel::GetColumnCount(void) const
+{
+    return(m_vColumns.size());
+}
+
+/** Get the type of a column
+  * \param uiField [input]: the field index of the column
+  * \return the type of the column
+  */
+wxVirtualColumnarListModel::EColumnType wxVirtualColumnarListModel::GetColumnType(size_t uiField) const
+{
+    return(m_vColumns[uiField]->m_eType);
+}
+
+/** Get the name of a column
+  * \param uiField [input]: the field index of the column
+  * \return the name of the column
+  */
+wxString wxVirtualColumnarListModel::GetColumnName(size_t uiField) const
+{
+    return(m_vColumns[uiField]->m_sName);
+}
+
+//----------------------------- ROWS --------------------------------//
+/** Get the amount of rows
+  * \return the amount of rows
+  */
+size_t wxVirtualColumnarListModel::GetRowCount(void) const
+{
+    return(m_uiRowCount);
+}
+
+/** Reserve memory for rows
+  * \param uiRowCount [input]: the total amount of rows expected
+  */
+void wxVirtualColumnarListModel::Reserve(size_t uiRowCount)
+{
+    size_t i, uiNbColumns;
+    uiNbColumns = m_vColumns.size();
+    for(i = 0; i < uiNbColumns; i++)
+    {
+        TColumn *pColumn = m_vColumns[i];
+        switch(pColumn->m_eType)
+        {
+            case WX_COLUMN_INT64    :
+            case WX_COLUMN_DATETIME : pColumn->m_vInt64s.reserve(uiRowCount); break;
+            case WX_COLUMN_DOUBLE   : pColumn->m_vDoubles.reserve(uiRowCount); break;
+            case WX_COLUMN_BOOL     : pColumn->m_vBools.reserve(uiRowCount); break;
+            case WX_COLUMN_STRING   : pColumn->m_vCodes.reserve(uiRowCount); break;
+            default                 : break;
+        }
+    }
+}
+
+/** Append a row with default values
+  * If the model is sorted, the new row is displayed at the end
+  * \return the row index of the new row
+  */
+size_t wxVirtualColumnarListModel::AppendRow(void)
+{
+    size_t i, uiNbColumns;
+    uiNbColumns = m_vColumns.size();
+    for(i = 0; i < uiNbColumns; i++) ResizeColumn(m_vColumns[i], m_uiRowCount + 1);
+
+    if (!m_vOrder.empty()) m_vOrder.push_back(m_uiRowCount);
+    m_uiRowCount++;
+    return(m_uiRowCount - 1);
+}
+
+/** Add or remove rows at the end of the storage
+  * The sorting order is reset
+  * \param uiRowCount [input]: the new amount of rows. New rows have default values
+  */
+void wxVirtualColumnarListModel::SetRowCount(size_t uiRowCount)
+{
+    size_t i, uiNbColumns;
+    uiNbColumns = m_vColumns.size();
+    for(i = 0; i < uiNbColumns; i++) ResizeColumn(m_vColumns[i], uiRowCount);
+
+    m_vOrder.clear();
+    m_uiRowCount = uiRowCount;
+}
+
+/** Remove all rows. The columns are kept, and their dictionaries are emptied
+  */
+void wxVirtualColumnarListModel::Clear(void)
+{
+    size_t i, uiNbColumns;
+    uiNbColumns = m_vColumns.size();
+    for(i = 0; i < uiNbColumns; i++)
+    {
+        TColumn *pColumn = m_vColumns[i];
+        pColumn->m_vInt64s.clear();
+        pColumn->m_vDoubles.clear();
+        pColumn->m_vBools.clear();
+        pColumn->m_vCodes.clear();
+        pColumn->m_vStrings.clear();
+        pColumn->m_MapOfCodes.clear();
+        if (pColumn->m_eType == WX_COLUMN_STRING) GetStringCode(pColumn, wxEmptyString);
+    }
+
+    m_vOrder.clear();
+    m_uiRowCount = 0;
+}
+
+//------------------------- TYPED GETTERS ---------------------------//
+/** Get a value of a WX_COLUMN_INT64 column
+  * \param uiRow   [input]: the row index
+  * \param uiField [input]: the field index
+  * \return the value
+  */
+wxInt64 wxVirtualColumnarListModel::GetInt64(size_t uiRow, size_t uiField) const
+{
+    return(m_vColumns[uiField]->m_vInt64s[GetStorageRow(uiRow)]);
+}
+
+/** Get a value of a WX_COLUMN_DOUBLE column
+  * \param uiRow   [input]: the row index
+  * \param uiField [input]: the field index
+  * \return the value
+  */
+double wxVirtualColumnarListModel::GetDouble(size_t uiRow, size_t uiField) const
+{
+    return(m_vColumns[uiField]->m_vDoubles[GetStorageRow(uiRow)]);
+}
+
+/** Get a value of a WX_COLUMN_BOOL column
+  * \param uiRow   [input]: the row index
+  * \param uiField [input]: the field index
+  * \return the value
+  */
+bool wxVirtualColumnarListModel::GetBool(size_t uiRow, size_t uiField) const
+{
+    return(m_vColumns[uiField]->m_vBools[GetStorageRow(uiRow)] != 0);
+}
+
+#if wxUSE_DATETIME
+/** Get a value of a WX_COLUMN_DATETIME column
+  * \param uiRow   [input]: the row index
+  * \param uiField [input]: the field index
+  * \return the value
+  */
+wxDateTime wxVirtualColumnarListModel::GetDateTime(size_t uiRow, size_t uiField) const
+{
+    return(wxDateTime(wxLongLong(m_vColumns[uiField]->m_vInt64s[GetStorageRow(uiRow)])));
+}
+#endif // wxUSE_DATETIME
+
+/** Get a value of a WX_COLUMN_STRING column
+  * \param uiRow   [input]: the row index
+  * \param uiField [input]: the field index
+  * \return the value. The reference stays valid until the model is modified
+  */
+const wxString& wxVirtualColumnarListModel::GetString(size_t uiRow, size_t uiField) const
+{
+    const TColumn *pColumn = m_vColumns[uiField];
+    return(pColumn->m_vStrings[pColumn->m_vCodes[GetStorageRow(uiRow)]]);
+}
+
+//------------------------- TYPED SETTERS ---------------------------//
+/** Set a value of a WX_COLUMN_INT64 column
+  * \param uiRow   [input]: the row index
+  * \param uiField [input]: the field index
+  * \param iValue  [input]: the new value
+  */
+void wxVirtualColumnarListModel::SetInt64(size_t uiRow, size_t uiField, wxInt64 iValue)
+{
+    m_vColumns[uiField]->m_vInt64s[GetStorageRow(uiRow)] = iValue;
+}
+
+/** Set a value of a WX_COLUMN_DOUBLE column
+  * \param uiRow   [input]: the row index
+  * \param uiField [input]: the field index
+  * \param dValue  [input]: the new value
+  */
+void wxVirtualColumnarListModel::SetDouble(size_t uiRow, size_t uiField, double dValue)
+{
+    m_vColumns[uiField]->m_vDoubles[GetStorageRow(uiRow)] = dValue;
+}
+
+/** Set a value of a WX_COLUMN_BOOL column
+  * \param uiRow   [input]: the row index
+  * \param uiField [input]: the field index
+  * \param bValue  [input]: the new value
+  */
+void wxVirtualColumnarListModel::SetBool(size_t uiRow, size_t uiField, bool bValue)
+{
+    m_vColumns[uiField]->m_vBools[GetStorageRow(uiRow)] = bValue ? 1 : 0;
+}
+
+#if wxUSE_DATETIME
+/** Set a value of a WX_COLUMN_DATETIME column
+  * \param uiRow   [input]: the row index
+  * \param uiField [input]: the field index
+  * \param rValue  [input]: the new value
+  */
+void wxVirtualColumnarListModel::SetDateTime(size_t uiRow, size_t uiField, const wxDateTime &rValue)
+{
+    m_vColumns[uiField]->m_vInt64s[GetStorageRow(uiRow)] = rValue.GetValue().GetValue();
+}
+#endif // wxUSE_DATETIME
+
+/** Set a value of a WX_COLUMN_STRING column
+  * The string is added to the dictionary of the column if needed
+  * \param uiRow   [input]: the row index
+  * \param uiField [input]: the field index
+  * \param rsValue [input]: the new value
+  */
+void wxVirtualColumnarListModel::SetString(size_t uiRow, size_t uiField, const wxString &rsValue)
+{
+    TColumn *pColumn = m_vColumns[uiField];
+    pColumn->m_vCodes[GetStorageRow(uiRow)] = GetStringCode(pColumn, rsValue);
+}
+
+//--------------------------- DICTIONARY ----------------------------//
+/** Get the amount of strings in the dictionary of a column
+  * Strings which are not used anymore are kept in the dictionary until Clear() is called
+  * \param uiField [input]: the field index
+  * \return the amount of strings in the dictionary. 0 for non-string columns
+  */
+size_t wxVirtualColumnarListModel::GetDictionarySize(size_t uiField) const
+{
+    return(m_vColumns[uiField]->m_vStrings.size());
+}
+
+//--------------- WXVIRTUALILISTDATAMODEL INTERFACE -----------------//
+/** Get amount of items
+  * \return the amount of rows
+  */
+size_t wxVirtualColumnarListModel::GetItemCount(void)
+{
+    return(m_uiRowCount);
+}
+
+/** Get the amount of fields in the item
+  * \param rID [input]: the item to query
+  * \return the amount of columns
+  */
+size_t wxVirtualColumnarListModel::GetFieldCount(const wxVirtualItemID &rID)
+{
+    return(m_vColumns.size());
+}
+
+/** Get the item data
+  * \param uiItemID [input]: the row index of the item
+  * \param uiField  [input]: the field index
+  * \param eType    [input]: the kind of data to get. Only WX_ITEM_MAIN_DATA is stored
+  * \return the data of the item
+  */
+wxVariant wxVirtualColumnarListModel::GetListItemData(size_t uiItemID, size_t uiField, EDataType eType)
+{
+    wxVirtualValue oValue;
+    GetListItemValue(oValue, uiItemID, uiField, eType);
+    return(oValue.ToVariant());
+}
+
+/** Get the item data without allocation
+  * \param rValue   [output]: the data of the item. Strings are references to the dictionary
+  * \param uiItemID [input] : the row index of the item
+  * \param uiField  [input] : the field index
+  * \param eType    [input] : the kind of data to get. Only WX_ITEM_MAIN_DATA is stored
+  */
+void wxVirtualColumnarListModel::GetListItemValue(wxVirtualValue &rValue, size_t uiItemID,
+                                                  size_t uiField, EDataType eType)
+{
+    if ((eType != WX_ITEM_MAIN_DATA) || (uiField >= m_vColumns.size()) || (uiItemID >= m_uiRowCount))
+    {
+        rValue.SetNull();
+        return;
+    }
+    GetStorageValue(rValue, m_vColumns[uiField], GetStorageRow(uiItemID));
+}
+
+/** Get the data of several rows & fields at once
+  * The arrays are read column by column
+  * \param vValues [output]: the values, row by row. vValues[i * vFields.size() + j] is the value
+  *                          of the field vFields[j] of the row vRows[i]
+  * \param vRows   [input] : the row indices to query. size_t(-1) for an invalid item (null values)
+  * \param vFields [input] : the fields to query
+  * \param eType   [input] : the kind of data to get. Only WX_ITEM_MAIN_DATA is stored
+  */
+void wxVirtualColumnarListModel::GetListItemDataBatch(wxVirtualValues &vValues, const TRowIndices &vRows,
+                                                      const TFieldIDs &vFields, EDataType eType)
+{
+    size_t uiNbRows   = vRows.size();
+    size_t uiNbFields = vFields.size();
+    vValues.resize(uiNbRows * uiNbFields);
+
+    //storage indices
+    TRowIndices vStorageRows;
+    vStorageRows.reserve(uiNbRows);
+    size_t i, j;
+    for(i=0;i<uiNbRows;i++)
+    {
+        size_t uiRow = vRows[i];
+        if (uiRow < m_uiRowCount) vStorageRows.push_back(GetStorageRow(uiRow));
+        else                      vStorageRows.push_back(size_t(-1));
+    }
+
+    //1 column at a time
+    for(j=0;j<uiNbFields;j++)
+    {
+        size_t uiField = vFields[j];
+        const TColumn *pColumn = WX_VDV_NULL_PTR;
+        if ((eType == WX_ITEM_MAIN_DATA) && (uiField < m_vColumns.size())) pColumn = m_vColumns[uiField];
+
+        wxVirtualValue *pValue = &vValues[j];
+        for(i=0;i<uiNbRows;i++)
+        {
+            size_t uiStorageRow = vStorageRows[i];
+            if ((!pColumn) || (uiStorageRow == size_t(-1))) pValue->SetNull();
+            else                                            GetStorageValue(*pValue, pColumn, uiStorageRow);
+            pValue += uiNbFields;
+        }
+    }
+}
+
+/** Set the item data
+  * The value is converted to the type of the column
+  * \param uiItemID [input]: the row index of the item
+  * \param uiField  [input]: the field index
+  * \param vValue   [input]: the new value
+  * \param eType    [input]: the kind of data to set. Only WX_ITEM_MAIN_DATA is stored
+  * \return true if the value was set, false otherwise
+  */
+bool wxVirtualColumnarListModel::SetListItemData(size_t uiItemID, size_t uiField,
+                                                 const wxVariant &vValue, EDataType eType)
+{
+    if ((eType != WX_ITEM_MAIN_DATA) || (uiField >= m_vColumns.size()) || (uiItemID >= m_uiRowCount)) return(false);
+
+    switch(m_vColumns[uiField]->m_eType)
+    {
+        case WX_COLUMN_INT64    :
+            {
+                wxLongLong llValue;
+                if (!vValue.Convert(&llValue)) return(false);
+                SetInt64(uiItemID, uiField, llValue.GetValue());
+                return(true);
+            }
+
+        case WX_COLUMN_DOUBLE   :
+            {
+                double dValue;
+                if (!vValue.Convert(&dValue)) return(false);
+                SetDouble(uiItemID, uiField, dValue);
+                return(true);
+            }
+
+        case WX_COLUMN_BOOL     :
+            {
+                bool bValue;
+                if (!vValue.Convert(&bValue)) return(false);
+                SetBool(uiItemID, uiField, bValue);
+                return(true);
+            }
+
+#if wxUSE_DATETIME
+        case WX_COLUMN_DATETIME :
+            {
+                wxDateTime dtValue;
+                if (!vValue.Convert(&dtValue)) return(false);
+                SetDateTime(uiItemID, uiField, dtValue);
+                return(true);
+            }
+#endif // wxUSE_DATETIME
+
+        case WX_COLUMN_STRING   :
+            SetString(uiItemID, uiField, GetStringValue(vValue));
+            return(true);
+
+        default                 : break;
+    }
+    return(false);
+}
+
+//---------------------------- SORTING ------------------------------//
+/** Check if the fields can be sorted by the data model
+  * \param vSortFilters [input]: the sort filters to apply
+  * \return true if all the sorted fields are columns of the model
+  */
+bool wxVirtualColumnarListModel::CanSort(const TSortFilters &vSortFilters) const
+{
+    size_t i, uiNbFilters;
+    uiNbFilters = vSortFilters.size();
+    for(i = 0; i < uiNbFilters; i++)
+    {
+        if (vSortFilters[i].m_uiSortedField >= m_vColumns.size()) return(false);
+    }
+    return(true);
+}
+
+/** Sort the values
+  * The sort keys of each sorted column are built from the arrays, and the rows are radix sorted
+  * from the last filter to the first one. The sort is stable: rows with equal values keep
+  * their storage order
+  * \param vSortFilters [input]: the sort filters to apply. If empty, the storage order is restored
+  */
+void wxVirtualColumnarListModel::Sort(const TSortFilters &vSortFilters)
+{
+    m_vOrder.clear();
+    if (!CanSort(vSortFilters)) return;
+
+    size_t i, uiFilter;
+    TSortPermutation vOrder;
+    TSortKeys vKeys;
+    uiFilter = vSortFilters.size();
+    while (uiFilter > 0)
+    {
+        uiFilter--;
+        const TSort &rSort = vSortFilters[uiFilter];
+        if (rSort.m_eSortOrder == WX_E_SORT_NOT_SORTING) continue;
+
+        if (vOrder.empty())
+        {
+            vOrder.reserve(m_uiRowCount);
+            for(i = 0; i < m_uiRowCount; i++) vOrder.push_back(i);
+        }
+
+        GetSortKeys(vKeys, m_vColumns[rSort.m_uiSortedField],
+                    rSort.m_eSortOrder == WX_E_SORT_DESCENDING);
+        wxRadixSortPermutation(vKeys, vOrder);
+    }
+
+    m_vOrder.swap(vOrder);
+}
+
+/** Remove all sort filters : the storage order is restored
+  */
+void wxVirtualColumnarListModel::ResetSorting(void)
+{
+    TSortPermutation vEmpty;
+    m_vOrder.swap(vEmpty);
+}
+
+/** Compare 2 items
+  * \param rID1    [input]: the 1st item
+  * \param rID2    [input]: the 2nd item
+  * \param uiField [input]: the field to compare
+  * \return the comparison result
+  */
+wxVirtualIDataModel::ECompareResult wxVirtualColumnarListModel::Compare(const wxVirtualItemID &rID1,
+                                                                        const wxVirtualItemID &rID2,
+                                                                        size_t uiField)
+{
+    size_t uiRow1 = GetRowIndex(rID1);
+    size_t uiRow2 = GetRowIndex(rID2);
+    if ((uiField >= m_vColumns.size()) || (uiRow1 >= m_uiRowCount) || (uiRow2 >= m_uiRowCount))
+    {
+        return(wxVirtualIListDataModel::Compare(rID1, rID2, uiField));
+    }
+
+    const TColumn *pColumn = m_vColumns[uiField];
+    uiRow1 = GetStorageRow(uiRow1);
+    uiRow2 = GetStorageRow(uiRow2);
+    switch(pColumn->m_eType)
+    {
+        case WX_COLUMN_INT64    :
+        case WX_COLUMN_DATETIME : return(CompareValues(pColumn->m_vInt64s[uiRow1], pColumn->m_vInt64s[uiRow2]));
+        case WX_COLUMN_DOUBLE   : return(CompareValues(pColumn->m_vDoubles[uiRow1], pColumn->m_vDoubles[uiRow2]));
+        case WX_COLUMN_BOOL     : return(CompareValues(pColumn->m_vBools[uiRow1], pColumn->m_vBools[uiRow2]));
+        case WX_COLUMN_STRING   :
+            {
+                wxUint32 uiCode1 = pColumn->m_vCodes[uiRow1];
+                wxUint32 uiCode2 = pColumn->m_vCodes[uiRow2];
+                if (uiCode1 == uiCode2) return(WX_E_EQUAL);
+                int iResult = pColumn->m_vStrings[uiCode1].Cmp(pColumn->m_vStrings[uiCode2]);
+                if (iResult < 0) return(WX_E_LESS_THAN);
+                if (iResult > 0) return(WX_E_GREATER_THAN);
+                return(WX_E_EQUAL);
+            }
+        default                 : break;
+    }
+    return(WX_E_EQUAL);
+}
+
+//--------------------------- FILTERING -----------------------------//
+/** Get all the distinct values of a field, as strings
+  * \param rvStrings   [output]: the distinct values, sorted. Previous content is lost
+  * \param uiField     [input] : the field to scan
+  * \param pStateModel [input] : the state model. Not used: a list has no collapsed items
+  */
+void wxVirtualColumnarListModel::GetAllValues(wxArrayString &rvStrings, size_t uiField,
+                                              wxVirtualIStateModel *pStateModel)
+{
+    rvStrings.Clear();
+    if (uiField >= m_vColumns.size()) return;
+
+    wxVector<wxVariant> vVariants;
+    GetDistinctValues(vVariants, m_vColumns[uiField]);
+
+    size_t i, uiSize;
+    uiSize = vVariants.size();
+    rvStrings.reserve(uiSize);
+    for(i = 0; i < uiSize; i++) rvStrings.Add(GetStringValue(vVariants[i]));
+}
+
+/** Get all the distinct values of a field, as variants
+  * \param rvVariants  [output]: the distinct values, sorted. Previous content is lost
+  * \param uiField     [input] : the field to scan
+  * \param pStateModel [input] : the state model. Not used: a list has no collapsed items
+  */
+void wxVirtualColumnarListModel::GetAllValues(wxVector<wxVariant> &rvVariants, size_t uiField,
+                                              wxVirtualIStateModel *pStateModel)
+{
+    rvVariants.clear();
+    if (uiField >= m_vColumns.size()) return;
+    GetDistinctValues(rvVariants, m_vColumns[uiField]);
+}
+
+//------------------------ MULTI-THREADING --------------------------//
+/** Check if GetItemData() & Compare() can be called from worker threads
+  * \return true : reading the model does not modify it
+  */
+bool wxVirtualColumnarListModel::IsThreadSafe(void)
+{
+    return(true);
+}
+
+//----------------------- INTERNAL METHODS --------------------------//
+/** Convert a row index to a storage index
+  * \param uiRow [input]: the row index (displayed order)
+  * \return the index of the row in the arrays
+  */
+size_t wxVirtualColumnarListModel::GetStorageRow(size_t uiRow) const
+{
+    if (m_vOrder.empty()) return(uiRow);
+    return(m_vOrder[uiRow]);
+}
+
+/** Get a value from its storage index
+  * \param rValue       [output]: the value
+  * \param pColumn      [input] : the column
+  * \param uiStorageRow [input] : the index of the row in the arrays
+  */
+void wxVirtualColumnarListModel::GetStorageValue(wxVirtualValue &rValue, const TColumn *pColumn,
+                                                 size_t uiStorageRow) const
+{
+    switch(pColumn->m_eType)
+    {
+        case WX_COLUMN_INT64    : rValue.SetInt64(pColumn->m_vInt64s[uiStorageRow]); break;
+        case WX_COLUMN_DOUBLE   : rValue.SetDouble(pColumn->m_vDoubles[uiStorageRow]); break;
+        case WX_COLUMN_BOOL     : rValue.SetBool(pColumn->m_vBools[uiStorageRow] != 0); break;
+#if wxUSE_DATETIME
+        case WX_COLUMN_DATETIME : rValue.SetDateTime(wxDateTime(wxLongLong(pColumn->m_vInt64s[uiStorageRow]))); break;
+#endif // wxUSE_DATETIME
+        case WX_COLUMN_STRING   : rValue.SetString(pColumn->m_vStrings[pColumn->m_vCodes[uiStorageRow]]); break;
+        default                 : rValue.SetNull(); break;
+    }
+}
+
+/** Get the dictionary code of a string, add it if needed
+  * \param pColumn [input]: the column
+  * \param rsValue [input]: the string
+  * \return the index of the string in the dictionary
+  */
+wxUint32 wxVirtualColumnarListModel::GetStringCode(TColumn *pColumn, const wxString &rsValue)
+{
+    THashMapColumnarStrings::iterator it = pColumn->m_MapOfCodes.find(rsValue);
+    if (it != pColumn->m_MapOfCodes.end()) return(it->second);
+
+    wxUint32 uiCode = (wxUint32) pColumn->m_vStrings.size();
+    pColumn->m_vStrings.push_back(rsValue);
+    pColumn->m_MapOfCodes[rsValue] = uiCode;
+    return(uiCode);
+}
+
+/** Resize the storage of a column
+  * \param pColumn    [input]: the column
+  * \param uiRowCount [input]: the new amount of rows. New rows have default values
+  */
+void wxVirtualColumnarListModel::ResizeColumn(TColumn *pColumn, size_t uiRowCount)
+{
+    switch(pColumn->m_eType)
+    {
+        case WX_COLUMN_INT64    :
+        case WX_COLUMN_DATETIME : pColumn->m_vInt64s.resize(uiRowCount, 0); break;
+        case WX_COLUMN_DOUBLE   : pColumn->m_vDoubles.resize(uiRowCount, 0.0); break;
+        case WX_COLUMN_BOOL     : pColumn->m_vBools.resize(uiRowCount, 0); break;
+        case WX_COLUMN_STRING   : pColumn->m_vCodes.resize(uiRowCount, 0); break; //code 0 is the empty string
+        default                 : break;
+    }
+}
+
+/** Get the sort keys of all the rows of a column
+  * Strings : the dictionary is sorted once, and the key of a row is the rank of its string
+  * NaN doubles are sorted first
+  * \param vKeys       [output]: the keys, indexed by storage row
+  * \param pColumn     [input] : the column
+  * \param bDescending [input] : true for descending order (the keys are complemented)
+  */
+void wxVirtualColumnarListModel::GetSortKeys(TSortKeys &vKeys, const TColumn *pColumn,
+                                             bool bDescending) const
+{
+    size_t i;
+    vKeys.clear();
+    vKeys.reserve(m_uiRowCount);
+    switch(pColumn->m_eType)
+    {
+        case WX_COLUMN_INT64    :
+        case WX_COLUMN_DATETIME :
+            for(i = 0; i < m_uiRowCount; i++) vKeys.push_back(wxGetSortKey(pColumn->m_vInt64s[i]));
+            break;
+
+        case WX_COLUMN_DOUBLE   :
+            for(i = 0; i < m_uiRowCount; i++)
+            {
+                double dValue = pColumn->m_vDoubles[i];
+                if (IsNaN(dValue)) vKeys.push_back(0);
+                else               vKeys.push_back(wxGetSortKey(dValue));
+            }
+            break;
+
+        case WX_COLUMN_BOOL     :
+            for(i = 0; i < m_uiRowCount; i++) vKeys.push_back(pColumn->m_vBools[i]);
+            break;
+
+        case WX_COLUMN_STRING   :
+            {
+                size_t uiNbStrings = pColumn->m_vStrings.size();
+                TSortPermutation vCodes;
+                vCodes.reserve(uiNbStrings);
+                for(i = 0; i < uiNbStrings; i++) vCodes.push_back(i);
+                std::sort(vCodes.begin(), vCodes.end(), TColumnarStringLess(pColumn->m_vStrings));
+
+                TSortKeys vRanks(uiNbStrings, 0);
+                for(i = 0; i < uiNbStrings; i++) vRanks[vCodes[i]] = i;
+                for(i = 0; i < m_uiRowCount; i++) vKeys.push_back(vRanks[pColumn->m_vCodes[i]]);
+            }
+            break;
+
+        default                 :
+            vKeys.resize(m_uiRowCount, 0);
+            break;
+    }
+
+    if (bDescending)
+    {
+        for(i = 0; i < m_uiRowCount; i++) vKeys[i] = ~vKeys[i];
+    }
+}
+
+/** Get the sorted distinct values of a column
+  *     - strings  : the dictionary entries used by at least 1 row, O(n + u.log(u)) time
+  *     - booleans : O(n) time
+  *     - others   : a copy of the column is sorted, O(n.log(n)) time. NaN doubles are ignored
+  * \param rvVariants [output]: the distinct values, in ascending order
+  * \param pColumn    [input] : the column
+  */
+void wxVirtualColumnarListModel::GetDistinctValues(wxVector<wxVariant> &rvVariants,
+                                                   const TColumn *pColumn) const
+{
+    size_t i, uiSize;
+    rvVariants.clear();
+    wxVirtualValue oValue;
+    switch(pColumn->m_eType)
+    {
+        case WX_COLUMN_INT64    :
+        case WX_COLUMN_DATETIME :
+            {
+                wxVector<wxInt64> vValues(pColumn->m_vInt64s);
+                std::sort(vValues.begin(), vValues.end());
+                uiSize = std::unique(vValues.begin(), vValues.end()) - vValues.begin();
+                rvVariants.reserve(uiSize);
+                for(i = 0; i < uiSize; i++)
+                {
+#if wxUSE_DATETIME
+                    if (pColumn->m_eType == WX_COLUMN_DATETIME) oValue.SetDateTime(wxDateTime(wxLongLong(vValues[i])));
+                    else                                        oValue.SetInt64(vValues[i]);
+#else
+                    oValue.SetInt64(vValues[i]);
+#endif // wxUSE_DATETIME
+                    rvVariants.push_back(oValue.ToVariant());
+                }
+            }
+            break;
+
+        case WX_COLUMN_DOUBLE   :
+            {
+                wxVector<double> vValues;
+                vValues.reserve(m_uiRowCount);
+                for(i = 0; i < m_uiRowCount; i++)
+                {
+                    if (!IsNaN(pColumn->m_vDoubles[i])) vValues.push_back(pColumn->m_vDoubles[i]);
+                }
+                std::sort(vValues.begin(), vValues.end());
+                uiSize = std::unique(vValues.begin(), vValues.end()) - vValues.begin();
+                rvVariants.reserve(uiSize);
+                for(i = 0; i < uiSize; i++) rvVariants.push_back(wxVariant(vValues[i]));
+            }
+            break;
+
+        case WX_COLUMN_BOOL     :
+            {
+                bool bHasFalse = false;
+                bool bHasTrue  = false;
+                for(i = 0; (i < m_uiRowCount) && ((!bHasFalse) || (!bHasTrue)); i++)
+                {
+                    if (pColumn->m_vBools[i]) bHasTrue  = true;
+                    else                      bHasFalse = true;
+                }
+                if (bHasFalse) rvVariants.push_back(wxVariant(false));
+                if (bHasTrue)  rvVariants.push_back(wxVariant(true));
+            }
+            break;
+
+        case WX_COLUMN_STRING   :
+            {
+                size_t uiNbStrings = pColumn->m_vStrings.size();
+                wxBitArray vUsed(uiNbStrings, false);
+                for(i = 0; i < m_uiRowCount; i++) vUsed.Set(pColumn->m_vCodes[i]);
+
+                TSortPermutation vCodes;
+                vCodes.reserve(uiNbStrings);
+                for(i = vUsed.FindNext(0); i < uiNbStrings; i = vUsed.FindNext(i + 1)) vCodes.push_back(i);
+                std::sort(vCodes.begin(), vCodes.end(), TColumnarStringLess(pColumn->m_vStrings));
+
+                uiSize = vCodes.size();
+                rvVariants.reserve(uiSize);
+                for(i = 0; i < uiSize; i++) rvVariants.push_back(wxVariant(pColumn->m_vStrings[vCodes[i]]));
+            }
+            break;
+
+        default                 : break;
+    }
+}
@@ -6,8 +6,10 @@
 /**********************************************************************/
 
 #include <wx/VirtualDataView/Models/VirtualFilteringDataModel.h>
+#include <wx/VirtualDataView/Models/VirtualIListDataModel.h>
 #include <wx/VirtualDataView/Filters/VirtualDataViewFilter.h>
 #include <wx/VirtualDataView/Types/HashSetDefs.h>
+#include <algorithm>
 
 //--------------- CONSTRUCTORS & DESTRUCTOR -------------------------//
 /** Default constructor
@@ -30,7 +32,7 @@ wxVirtualFilteringDataModel::~wxVirtualFilteringDataModel(void)
   */
 void wxVirtualFilteringDataModel::ClearFilters(void)
 {
-    if (m_vFilters.ClearFilters()) ClearCache();
+    if (m_vFilters.ClearFilters()) wxVirtualIArrayProxyDataModel::ClearCache();
 }
 
 /** Push filter
@@ -43,7 +45,7 @@ void wxVirtualFilteringDataModel::PushFilter(size_t uiField, wxVirtualDataViewFi
 {
     if (m_vFilters.PushFilter(uiField, pFilter))
     {
-        ClearCache();
+        wxVirtualIArrayProxyDataModel::ClearCache();
     }
 }
 
@@ -52,14 +54,14 @@ void wxVirtualFilteringDataModel::PushFilter(size_t uiField, wxVirtualDataViewFi
   */
 void wxVirtualFilteringDataModel::PopFilter(size_t uiField)
 {
-    if (m_vFilters.PopFilter(uiField)) ClearCache();
+    if (m_vFilters.PopFilter(uiField)) wxVirtualIArrayProxyDataModel::ClearCache();
 }
 
 /** Pop the last filter
   */
 void wxVirtualFilteringDataModel::PopFilter(void)
 {
-    if (m_vFilters.PopFilter()) ClearCache();
+    if (m_vFilters.PopFilter()) wxVirtualIArrayProxyDataModel::ClearCache();
 }
 
 /** Check if a field is filtering
@@ -93,7 +95,7 @@ wxVirtualDataViewFilter* wxVirtualFilteringDataModel::GetFilter(size_t uiField)
   */
 wxVirtualDataViewFiltersList& wxVirtualFilteringDataModel::Filters(void)
 {
-    ClearCache();
+    wxVirtualIArrayProxyDataModel::ClearCache();
     return(m_vFilters);
 }
 
@@ -105,6 +107,19 @@ const wxVirtualDataViewFiltersList& wxVirtualFilteringDataModel::Filters(void) c
     return(m_vFilters);
 }
 
+//------------------------- CACHE -----------------------------------//
+/** Clear the cached results
+  * The results of each filter are cleared as well: the values or the order of the items
+  * may have changed.
+  * Adding / removing filters only clears the filtered children: the results of the
+  * filters which did not change are kept
+  */
+void wxVirtualFilteringDataModel::ClearCache(void)
+{
+    wxVirtualIArrayProxyDataModel::ClearCache();
+    m_vFilters.ClearCachedResults();
+}
+
 //----------------------- INTERFACE ---------------------------------//
 /** Get all children
   * \param rIDParent [input]: the parent item
@@ -116,6 +131,201 @@ void wxVirtualFilteringDataModel::DoGetChildren(wxVirtualItemIDs &vChildren, con
     ApplyFilters(vChildren, m_vTempArray);
 }
 
+//----------------------- PARTIAL UPDATES ---------------------------//
+/** \class TRowCompareFunctor : compare items by row index in a list model
+  */
+class TRowCompareFunctor
+{
+    public:
+        TRowCompareFunctor(wxVirtualIListDataModel *pListModel)
+            : m_pListModel(pListModel)
+        {}
+
+        bool operator()(const wxVirtualItemID &rID1, const wxVirtualItemID &rID2) const
+        {
+            return(m_pListModel->GetRowIndex(rID1) < m_pListModel->GetRowIndex(rID2));
+        }
+
+    protected:
+        wxVirtualIListDataModel*    m_pListModel;
+};
+
+/** Get the master model if it is the bottom list model
+  * \return the master model if it is a list model: the filtered children are in row order
+  *         NULL otherwise
+  */
+wxVirtualIListDataModel* wxVirtualFilteringDataModel::GetMasterListModel(void)
+{
+    wxVirtualIListDataModel *pListModel = GetBottomListModel();
+    if (!pListModel) return(WX_VDV_NULL_PTR);
+    if (m_pDataModel != pListModel) return(WX_VDV_NULL_PTR);
+    return(pListModel);
+}
+
+/** The rows of the bottom list model were shifted
+  * \param pListModel [input]: the bottom list model
+  * \param uiFirst    [input]: the 1st inserted / removed row
+  * \param uiCount    [input]: the amount of inserted / removed rows
+  * \param bInserted  [input]: true if the rows were inserted, false if they were removed
+  * The results kept by the filters are indexed by row: they are dropped
+  */
+void wxVirtualFilteringDataModel::OnItemIDsShifted(wxVirtualIListDataModel *pListModel,
+                                                   size_t uiFirst, size_t uiCount,
+                                                   bool bInserted)
+{
+    m_vFilters.ClearCachedResults();
+    wxVirtualIArrayProxyDataModel::OnItemIDsShifted(pListModel, uiFirst, uiCount, bInserted);
+}
+
+/** The values of some items of the master model changed
+  * \param vIDs    [input]: the items which changed
+  * \param vFields [input]: the fields which changed. Empty for all fields
+  * If a filtered field changed, the results kept by the filters are dropped before the cached
+  * children are updated or reset: the memorized acceptance of the ancestors of the changed
+  * items (recursive filters) is dropped with them
+  */
+void wxVirtualFilteringDataModel::OnMasterItemsChanged(const wxVirtualItemIDs &vIDs,
+                                                       const TFieldIDs &vFields)
+{
+    if (IsAffectedByFields(vFields)) m_vFilters.ClearCachedResults();
+    wxVirtualIArrayProxyDataModel::OnMasterItemsChanged(vIDs, vFields);
+}
+
+/** Some items of the master model were moved
+  * \param rParent       [input]: the parent of the moved items
+  * \param uiFirst       [input]: the child index of the 1st moved item, before the move
+  * \param uiCount       [input]: the amount of moved items
+  * \param uiDestination [input]: the items were moved before this child index (index before the move)
+  * The results kept by the filters are indexed by position: they are dropped
+  */
+void wxVirtualFilteringDataModel::OnMasterItemsMoved(const wxVirtualItemID &rParent,
+                                                     size_t uiFirst, size_t uiCount,
+                                                     size_t uiDestination)
+{
+    m_vFilters.ClearCachedResults();
+    wxVirtualIArrayProxyDataModel::OnMasterItemsMoved(rParent, uiFirst, uiCount, uiDestination);
+}
+
+/** The children of an item of the master model changed
+  * \param rParent [input]: the item whose children changed
+  * The results kept by the filters, and the memorized acceptance of rParent and its
+  * ancestors (recursive filters), are not valid anymore: they are dropped
+  */
+void wxVirtualFilteringDataModel::OnMasterChildrenReset(const wxVirtualItemID &rParent)
+{
+    m_vFilters.ClearCachedResults();
+    wxVirtualIArrayProxyDataModel::OnMasterChildrenReset(rParent);
+}
+
+/** Check if changing some fields can modify the children arrays
+  * \param vFields [input]: the fields which changed. Empty for all fields
+  * \return true if one of the fields is filtered
+  */
+bool wxVirtualFilteringDataModel::IsAffectedByFields(const TFieldIDs &vFields) const
+{
+    if (vFields.empty()) return(IsFiltering());
+
+    size_t i, uiSize;
+    uiSize = vFields.size();
+    for(i = 0; i < uiSize; i++)
+    {
+        if (IsFiltering(vFields[i])) return(true);
+    }
+    return(false);
+}
+
+/** Insert new items in cached children
+  * \param vChildren  [input/output]: the cached children of rIDParent
+  * \param rIDParent  [input]       : the parent item
+  * \param vNewIDs    [input]       : the new items, in the order of the master model
+  * \param vPositions [output]      : the child indices of the inserted items, in ascending order
+  * \return true if the items were inserted, false if the children must be recomputed
+  * Only the new items are evaluated by the filters. Supported only on top of a list model
+  */
+bool wxVirtualFilteringDataModel::DoInsertChildren(wxVirtualItemIDs &vChildren,
+                                                   const wxVirtualItemID &rIDParent,
+                                                   const wxVirtualItemIDs &vNewIDs,
+                                                   TPositions &vPositions)
+{
+    wxVirtualIListDataModel *pListModel = GetMasterListModel();
+    if (!pListModel) return(false);
+
+    TRowCompareFunctor cmp(pListModel);
+    wxVirtualItemIDs vAccepted;
+    TPositions vInsertBefore;
+    size_t i, uiSize;
+    uiSize = vNewIDs.size();
+    for(i = 0; i < uiSize; i++)
+    {
+        const wxVirtualItemID &rID = vNewIDs[i];
+        if (!IsAccepted(rID)) continue;
+
+        wxVirtualItemIDs::iterator it = std::lower_bound(vChildren.begin(), vChildren.end(), rID, cmp);
+        vAccepted.push_back(rID);
+        vInsertBefore.push_back(it - vChildren.begin());
+    }
+
+    MergeChildren(vChildren, vAccepted, vInsertBefore, vPositions);
+    return(true);
+}
+
+/** Re-position changed items in cached children
+  * \param vChildren   [input/output]: the cached children of rIDParent
+  * \param rIDParent   [input]       : the parent item
+  * \param vChangedIDs [input]       : the changed children of rIDParent
+  * \param vRemoved    [output]      : the child indices of the removed items (before removal), in ascending order
+  * \param vInserted   [output]      : the child indices of the inserted items (after insertion), in ascending order
+  * \return true if the children were updated, false if they must be recomputed
+  * Only the changed items are evaluated again: they are removed if they are not accepted anymore,
+  * and inserted if they are now accepted. Supported only on top of a list model
+  */
+bool wxVirtualFilteringDataModel::DoUpdateChildren(wxVirtualItemIDs &vChildren,
+                                                   const wxVirtualItemID &rIDParent,
+                                                   const wxVirtualItemIDs &vChangedIDs,
+                                                   TPositions &vRemoved,
+                                                   TPositions &vInserted)
+{
+    wxVirtualIListDataModel *pListModel = GetMasterListModel();
+    if (!pListModel) return(false);
+
+    //the values changed : the kept results of the filters are not valid anymore
+    m_vFilters.ClearCachedResults();
+
+    //find the items not accepted anymore, and the items newly accepted
+    TRowCompareFunctor cmp(pListModel);
+    wxVirtualItemIDs vNewIDs;
+    TPositions vRejected;
+    size_t i, uiSize;
+    uiSize = vChangedIDs.size();
+    for(i = 0; i < uiSize; i++)
+    {
+        const wxVirtualItemID &rID = vChangedIDs[i];
+        wxVirtualItemIDs::iterator it = std::lower_bound(vChildren.begin(), vChildren.end(), rID, cmp);
+        bool bPresent  = ((it != vChildren.end()) && (*it == rID));
+        bool bAccepted = IsAccepted(rID);
+        if ((bPresent) && (!bAccepted))      vRejected.push_back(it - vChildren.begin());
+        else if ((!bPresent) && (bAccepted)) vNewIDs.push_back(rID);
+    }
+
+    //remove the rejected items : once the binary searches are done
+    uiSize = vRejected.size();
+    for(i = 0; i < uiSize; i++) vChildren[vRejected[i]] = CreateInvalidItemID();
+    if (uiSize > 0) EraseInvalidChildren(vChildren, vRemoved);
+
+    //insert the accepted items
+    std::sort(vNewIDs.begin(), vNewIDs.end(), cmp);
+    TPositions vInsertBefore;
+    uiSize = vNewIDs.size();
+    vInsertBefore.reserve(uiSize);
+    for(i = 0; i < uiSize; i++)
+    {
+        wxVirtualItemIDs::iterator it = std::lower_bound(vChildren.begin(), vChildren.end(), vNewIDs[i], cmp);
+        vInsertBefore.push_back(it - vChildren.begin());
+    }
+    MergeChildren(vChildren, vNewIDs, vInsertBefore, vInserted);
+    return(true);
+}
+
 //--------------------- APPLY FILTERS -------------------------------//
 /** Check if an item is accepted
   * \param rID [input]: the item to check
@@ -6,19 +6,25 @@
 /**********************************************************************/
 
 #include <wx/VirtualDataView/Models/VirtualIArrayProxyDataModel.h>
+#include <wx/VirtualDataView/Models/VirtualIListDataModel.h>
 #include <wx/VirtualDataView/StateModels/VirtualIStateModel.h>
+#include <wx/VirtualDataView/Utilities/PerfCounters.h>
 #include <wx/stack.h>
 
+//above this amount of ranges of children, a single ChildrenReset() is sent instead
+static const size_t s_uiMaxNotifiedRanges = 16;
+
 //--------------- CONSTRUCTORS & DESTRUCTOR -------------------------//
 /** Default constructor
   */
 wxVirtualIArrayProxyDataModel::wxVirtualIArrayProxyDataModel(void)
     : wxVirtualIProxyDataModel(),
-      m_CachedResult(1000),
+      m_CachedResult(size_t(-1)),
       m_uiMinAmountOfChildrenForCaching(5),
       m_uiMaxAmountOfChildrenForCaching(size_t(-1)),
       m_CachedChildrenIndices(1000)
 {
+    m_CachedResult.SetMemoryLimit(WX_VDV_DEFAULT_CHILDREN_CACHE_MEMORY);
 }
 
 /** Destructor
@@ -38,8 +44,9 @@ void wxVirtualIArrayProxyDataModel::ClearCache(void)
 }
 
 /** Set the cache size
-  * \param uiMaxAmountOfItemsInCache [input]: max cache size.
+  * \param uiMaxAmountOfItemsInCache [input]: max cache size (amount of items).
   *                                           a size of 0 disables the cache
+  *                                           size_t(-1) for no limit (the memory limit still applies)
   */
 void wxVirtualIArrayProxyDataModel::SetCacheSize(size_t uiMaxAmountOfItemsInCache)
 {
@@ -54,6 +61,44 @@ size_t wxVirtualIArrayProxyDataModel::GetCacheSize(void) const
     return(m_CachedResult.GetCacheSize());
 }
 
+/** Set the maximal amount of bytes used by the cache
+  * \param uiMaxBytes [input]: the maximal amount of bytes used by the cached children arrays.
+  *                            size_t(-1) for no limit
+  */
+void wxVirtualIArrayProxyDataModel::SetCacheMemoryLimit(size_t uiMaxBytes)
+{
+    m_CachedResult.SetMemoryLimit(uiMaxBytes);
+}
+
+/** Get the maximal amount of bytes used by the cache
+  * \return the maximal amount of bytes used by the cached children arrays
+  */
+size_t wxVirtualIArrayProxyDataModel::GetCacheMemoryLimit(void) const
+{
+    return(m_CachedResult.GetMemoryLimit());
+}
+
+/** Get the amount of bytes used by the cache
+  * \return the amount of bytes currently used by the cached children arrays
+  */
+size_t wxVirtualIArrayProxyDataModel::GetCacheMemoryUsage(void) const
+{
+    return(m_CachedResult.GetMemoryUsage());
+}
+
+/** Get the hits, misses & evictions of the cache
+  * \param uiHits      [output]: amount of children arrays found in the cache
+  * \param uiMisses    [output]: amount of children arrays not found in the cache
+  * \param uiEvictions [output]: amount of children arrays removed to make room
+  */
+void wxVirtualIArrayProxyDataModel::GetCacheStatistics(size_t &uiHits, size_t &uiMisses,
+                                                       size_t &uiEvictions) const
+{
+    uiHits      = m_CachedResult.GetHits();
+    uiMisses    = m_CachedResult.GetMisses();
+    uiEvictions = m_CachedResult.GetEvictions();
+}
+
 /** Get the minimal amount of children for caching the result
   * \return the minimal amount of children for caching the result
   *         Items with strictly less items than this value will not be cached.
@@ -102,10 +147,13 @@ void wxVirtualIArrayProxyDataModel::SetMaxAmountOfChildrenForCaching(size_t uiMa
 const wxVirtualItemIDs& wxVirtualIArrayProxyDataModel::GetAllChildren(const wxVirtualItemID &rIDParent)
 {
     //is it in cache ?
-    if (m_CachedResult.HasKey(rIDParent))
+    const wxVirtualItemIDs *pCachedChildren = m_CachedResult.Find(rIDParent);
+    if (pCachedChildren)
     {
-        return(m_CachedResult.GetValue(rIDParent));
+        WX_VDV_PERF_COUNT(WX_PERF_CACHE_HITS, 1);
+        return(*pCachedChildren);
     }
+    WX_VDV_PERF_COUNT(WX_PERF_CACHE_MISSES, 1);
 
     //special case
     if (!m_pDataModel)
@@ -217,11 +265,14 @@ size_t wxVirtualIArrayProxyDataModel::GetChildIndex(const wxVirtualItemID &rChil
     //see comment in wxVirtualIArrayProxyDataModel::NextItem
 
     //is it cached ?
-    if (m_CachedChildrenIndices.HasKey(rChild))
+    const size_t *pCachedIndex = m_CachedChildrenIndices.Find(rChild);
+    if (pCachedIndex)
     {
         //yes: return the cached value
-        return(m_CachedChildrenIndices.GetValue(rChild));
+        WX_VDV_PERF_COUNT(WX_PERF_CACHE_HITS, 1);
+        return(*pCachedIndex);
     }
+    WX_VDV_PERF_COUNT(WX_PERF_CACHE_MISSES, 1);
 
     //no: compute it, and then cache it
     size_t uiChildIndex = wxVirtualIDataModel::GetChildIndex(rChild);
@@ -241,11 +292,14 @@ size_t wxVirtualIArrayProxyDataModel::GetChildIndex(const wxVirtualItemID &rPare
     //see comment in wxVirtualIArrayProxyDataModel::NextItem
 
     //is it cached ?
-    if (m_CachedChildrenIndices.HasKey(rChild))
+    const size_t *pCachedIndex = m_CachedChildrenIndices.Find(rChild);
+    if (pCachedIndex)
     {
         //yes: return the cached value
-        return(m_CachedChildrenIndices.GetValue(rChild));
+        WX_VDV_PERF_COUNT(WX_PERF_CACHE_HITS, 1);
+        return(*pCachedIndex);
     }
+    WX_VDV_PERF_COUNT(WX_PERF_CACHE_MISSES, 1);
 
     //no: compute it, and then cache it
     size_t uiChildIndex = wxVirtualIDataModel::GetChildIndex(rParent, rChild);
@@ -526,3 +580,426 @@ wxVirtualItemID wxVirtualIArrayProxyDataModel::PrevItem(const wxVirtualItemID &r
     size_t uiLevel = 1;
     return(PrevItem(rID, uiLevel, uiLevel, pStateModel, uiNbItems));
 }
+
+//------------------------ INTERFACE : ITEM DATA -------------------//
+/** Get the item data without allocation
+  * Reordering / filtering does not change the values : the master model is queried directly
+  * \param rValue  [output]: the data of the item. Null if no data is associated
+  * \param rID     [input] : the ID of the item to query
+  * \param uiField [input] : the field index of the item to query
+  * \param eType   [input] : the kind of data to get
+  */
+void wxVirtualIArrayProxyDataModel::GetItemValue(wxVirtualValue &rValue, const wxVirtualItemID &rID,
+                                                 size_t uiField, EDataType eType)
+{
+    ForwardItemValue(rValue, rID, uiField, eType);
+}
+
+/** Get the data of several items & fields at once
+  * Reordering / filtering does not change the values : the master model is queried directly
+  * \param vValues [output]: the values, row by row. See wxVirtualIDataModel::GetItemDataBatch()
+  * \param vIDs    [input] : the items to query
+  * \param vFields [input] : the fields to query
+  * \param eType   [input] : the kind of data to get
+  */
+void wxVirtualIArrayProxyDataModel::GetItemDataBatch(wxVirtualValues &vValues, const wxVirtualItemIDs &vIDs,
+                                                     const TFieldIDs &vFields, EDataType eType)
+{
+    ForwardItemDataBatch(vValues, vIDs, vFields, eType);
+}
+
+//------------------------ PROXY DATA MODEL -------------------------//
+/** Return true if the model changes the order or the set of the children of its master model
+  * \return true : the cached children are sorted or filtered by the derived classes
+  */
+bool wxVirtualIArrayProxyDataModel::IsReorderingProxy(void) const
+{
+    return(true);
+}
+
+//------------------ PARTIAL UPDATES : NEW INTERFACE ----------------//
+/** Check if changing some fields can modify the children arrays
+  * \param vFields [input]: the fields which changed. Empty for all fields
+  * \return true if the cached children may have to be updated
+  *         false if only the values displayed changed
+  * The default implementation returns true
+  */
+bool wxVirtualIArrayProxyDataModel::IsAffectedByFields(const TFieldIDs &vFields) const
+{
+    return(true);
+}
+
+/** Insert new items in cached children
+  * \param vChildren  [input/output]: the cached children of rIDParent
+  * \param rIDParent  [input]       : the parent item
+  * \param vNewIDs    [input]       : the new items, in the order of the master model
+  * \param vPositions [output]      : the child indices of the inserted items, in ascending order
+  * \return true if the items were inserted, false if the children must be recomputed
+  * The child indices of the items in vChildren must be kept up to date.
+  * The default implementation returns false
+  */
+bool wxVirtualIArrayProxyDataModel::DoInsertChildren(wxVirtualItemIDs &vChildren,
+                                                     const wxVirtualItemID &rIDParent,
+                                                     const wxVirtualItemIDs &vNewIDs,
+                                                     TPositions &vPositions)
+{
+    return(false);
+}
+
+/** Re-position changed items in cached children
+  * \param vChildren   [input/output]: the cached children of rIDParent
+  * \param rIDParent   [input]       : the parent item
+  * \param vChangedIDs [input]       : the changed children of rIDParent
+  * \param vRemoved    [output]      : the child indices of the removed items (before removal), in ascending order
+  * \param vInserted   [output]      : the child indices of the inserted items (after insertion), in ascending order
+  * \return true if the children were updated, false if they must be recomputed
+  * A re-positioned item is both removed and inserted.
+  * The child indices of the items in vChildren must be kept up to date.
+  * The default implementation returns false
+  */
+bool wxVirtualIArrayProxyDataModel::DoUpdateChildren(wxVirtualItemIDs &vChildren,
+                                                     const wxVirtualItemID &rIDParent,
+                                                     const wxVirtualItemIDs &vChangedIDs,
+                                                     TPositions &vRemoved,
+                                                     TPositions &vInserted)
+{
+    return(false);
+}
+
+//------------------ PARTIAL UPDATES : NOTIFICATIONS ----------------//
+/** The rows of the bottom list model were shifted
+  * \param pListModel [input]: the bottom list model
+  * \param uiFirst    [input]: the 1st inserted / removed row
+  * \param uiCount    [input]: the amount of inserted / removed rows
+  * \param bInserted  [input]: true if the rows were inserted, false if they were removed
+  * The cached children are remapped: the following rows get their new ID, and the removed
+  * rows are marked as invalid (they are erased by OnMasterItemsRemoved()). O(n) time.
+  * List models have no hierarchy: only the children of the root item are cached
+  */
+void wxVirtualIArrayProxyDataModel::OnItemIDsShifted(wxVirtualIListDataModel *pListModel,
+                                                     size_t uiFirst, size_t uiCount,
+                                                     bool bInserted)
+{
+    m_vChildren.clear();
+    m_CachedChildrenIndices.ClearCache();
+
+    wxVirtualItemIDs *pChildren = m_CachedResult.Find(GetRootItem());
+    if (pChildren)
+    {
+        size_t i, uiSize, uiRow, uiChildIndex;
+        uiSize = pChildren->size();
+        for(i = 0; i < uiSize; i++)
+        {
+            wxVirtualItemID &rID = (*pChildren)[i];
+            uiRow = pListModel->GetRowIndex(rID);
+            if (uiRow < uiFirst) continue;
+
+            uiChildIndex = rID.GetChildIndex();
+            if (bInserted)                      rID = pListModel->GetItemID(uiRow + uiCount);
+            else if (uiRow >= uiFirst + uiCount) rID = pListModel->GetItemID(uiRow - uiCount);
+            else                                rID = CreateInvalidItemID();
+            rID.SetChildIndex(uiChildIndex);
+        }
+    }
+
+    wxVirtualIProxyDataModel::OnItemIDsShifted(pListModel, uiFirst, uiCount, bInserted);
+}
+
+/** Some items were inserted in the master model
+  * \param rParent [input]: the parent of the new items
+  * \param uiFirst [input]: the child index of the 1st new item in the master model
+  * \param uiCount [input]: the amount of new items
+  */
+void wxVirtualIArrayProxyDataModel::OnMasterItemsInserted(const wxVirtualItemID &rParent,
+                                                          size_t uiFirst, size_t uiCount)
+{
+    m_vChildren.clear();
+    m_CachedChildrenIndices.ClearCache();
+
+    //not cached : nothing to update
+    wxVirtualItemIDs *pChildren = m_CachedResult.Find(rParent);
+    if ((!pChildren) || (!m_pDataModel))
+    {
+        ChildrenReset(rParent);
+        return;
+    }
+
+    //get the new items
+    wxVirtualItemIDs vNewIDs;
+    vNewIDs.reserve(uiCount);
+    size_t i;
+    for(i = 0; i < uiCount; i++) vNewIDs.push_back(m_pDataModel->GetChild(rParent, uiFirst + i));
+
+    //insert them
+    TPositions vRemoved, vInserted;
+    if (!DoInsertChildren(*pChildren, rParent, vNewIDs, vInserted))
+    {
+        m_CachedResult.Remove(rParent);
+        ChildrenReset(rParent);
+        return;
+    }
+    m_CachedResult.UpdateCost(rParent);
+    NotifyChildrenUpdated(rParent, vRemoved, vInserted);
+}
+
+/** Some items were removed from the master model
+  * \param rParent [input]: the parent of the removed items
+  * \param uiFirst [input]: the child index of the 1st removed item in the master model
+  * \param uiCount [input]: the amount of removed items
+  */
+void wxVirtualIArrayProxyDataModel::OnMasterItemsRemoved(const wxVirtualItemID &rParent,
+                                                         size_t uiFirst, size_t uiCount)
+{
+    m_vChildren.clear();
+    m_CachedChildrenIndices.ClearCache();
+
+    //the removed items are known only for list models (marked by OnItemIDsShifted())
+    wxVirtualItemIDs *pChildren = m_CachedResult.Find(rParent);
+    if ((!pChildren) || (!GetBottomListModel()))
+    {
+        m_CachedResult.Remove(rParent);
+        ChildrenReset(rParent);
+        return;
+    }
+
+    TPositions vRemoved, vInserted;
+    EraseInvalidChildren(*pChildren, vRemoved);
+    m_CachedResult.UpdateCost(rParent);
+    NotifyChildrenUpdated(rParent, vRemoved, vInserted);
+}
+
+/** The values of some items of the master model changed
+  * \param vIDs    [input]: the items which changed
+  * \param vFields [input]: the fields which changed. Empty for all fields
+  * Only the cached children of the parents of the changed items are updated
+  */
+void wxVirtualIArrayProxyDataModel::OnMasterItemsChanged(const wxVirtualItemIDs &vIDs,
+                                                         const TFieldIDs &vFields)
+{
+    if ((!m_pDataModel) || (!IsAffectedByFields(vFields)))
+    {
+        ItemsChanged(vIDs, vFields);
+        return;
+    }
+
+    m_vChildren.clear();
+    m_CachedChildrenIndices.ClearCache();
+
+    //group the changed items by parent. They usually share the same parent
+    wxVirtualItemIDs vParents;
+    wxVector<wxVirtualItemIDs> vGroups;
+    size_t i, j, uiNbItems, uiNbParents;
+    uiNbItems = vIDs.size();
+    for(i = 0; i < uiNbItems; i++)
+    {
+        wxVirtualItemID idParent = m_pDataModel->GetParent(vIDs[i]);
+        uiNbParents = vParents.size();
+        for(j = 0; j < uiNbParents; j++)
+        {
+            if (vParents[j] == idParent) break;
+        }
+        if (j == uiNbParents)
+        {
+            vParents.push_back(idParent);
+            vGroups.push_back(wxVirtualItemIDs());
+        }
+        vGroups[j].push_back(vIDs[i]);
+    }
+
+    //update each parent
+    uiNbParents = vParents.size();
+    for(j = 0; j < uiNbParents; j++)
+    {
+        const wxVirtualItemID &rParent = vParents[j];
+        wxVirtualItemIDs *pChildren = m_CachedResult.Find(rParent);
+        if (!pChildren)
+        {
+            ChildrenReset(rParent);
+            continue;
+        }
+
+        TPositions vRemoved, vInserted;
+        if (!DoUpdateChildren(*pChildren, rParent, vGroups[j], vRemoved, vInserted))
+        {
+            m_CachedResult.Remove(rParent);
+            ChildrenReset(rParent);
+            continue;
+        }
+        m_CachedResult.UpdateCost(rParent);
+
+        //re-positioned at the same place : the layout did not change
+        if (vRemoved == vInserted) continue;
+        NotifyChildrenUpdated(rParent, vRemoved, vInserted);
+    }
+
+    //the values themselves
+    ItemsChanged(vIDs, vFields);
+}
+
+/** Some items of the master model were moved
+  * \param rParent       [input]: the parent of the moved items
+  * \param uiFirst       [input]: the child index of the 1st moved item, before the move
+  * \param uiCount       [input]: the amount of moved items
+  * \param uiDestination [input]: the items were moved before this child index (index before the move)
+  * The cached children of rParent are dropped
+  */
+void wxVirtualIArrayProxyDataModel::OnMasterItemsMoved(const wxVirtualItemID &rParent,
+                                                       size_t uiFirst, size_t uiCount,
+                                                       size_t uiDestination)
+{
+    OnMasterChildrenReset(rParent);
+}
+
+/** The children of an item of the master model changed
+  * \param rParent [input]: the item whose children changed
+  * The cached children of rParent are dropped
+  */
+void wxVirtualIArrayProxyDataModel::OnMasterChildrenReset(const wxVirtualItemID &rParent)
+{
+    m_vChildren.clear();
+    m_CachedResult.Remove(rParent);
+    m_CachedChildrenIndices.ClearCache();
+    ChildrenReset(rParent);
+}
+
+/** The whole master model changed
+  * All the cached children are dropped
+  */
+void wxVirtualIArrayProxyDataModel::OnMasterModelReset(void)
+{
+    ClearCache();
+    ModelReset();
+}
+
+//------------------ PARTIAL UPDATES : HELPERS ----------------------//
+/** Get the bottom model if it is a list model
+  * \return the bottom model if it is a list model (its item IDs are row indices)
+  *         NULL otherwise
+  */
+wxVirtualIListDataModel* wxVirtualIArrayProxyDataModel::GetBottomListModel(void)
+{
+    wxVirtualIDataModel *pBottomModel = GetBottomModel();
+    if (!pBottomModel) return(WX_VDV_NULL_PTR);
+    return(pBottomModel->AsListModel());
+}
+
+/** Insert ordered items at known positions
+  * \param vChildren     [input/output]: the children. The child indices are updated
+  * \param vNewIDs       [input]       : the items to insert, in their final order
+  * \param vInsertBefore [input]       : for each new item, the index in vChildren (before insertion)
+  *                                      before which it is inserted. Must be in ascending order
+  * \param vPositions    [output]      : the child indices of the inserted items
+  * O(n + m) time : the array is merged in place, from the end
+  */
+void wxVirtualIArrayProxyDataModel::MergeChildren(wxVirtualItemIDs &vChildren,
+                                                  const wxVirtualItemIDs &vNewIDs,
+                                                  const TPositions &vInsertBefore,
+                                                  TPositions &vPositions)
+{
+    size_t uiNbOld = vChildren.size();
+    size_t uiNbNew = vNewIDs.size();
+    vPositions.assign(uiNbNew, 0);
+    if (uiNbNew == 0) return;
+    vChildren.resize(uiNbOld + uiNbNew);
+
+    size_t i = uiNbOld;
+    size_t j = uiNbNew;
+    size_t k = uiNbOld + uiNbNew;
+    while (j > 0)
+    {
+        //old items after the insertion point of the next new item
+        while (i > vInsertBefore[j - 1])
+        {
+            k--;
+            i--;
+            vChildren[k] = vChildren[i];
+        }
+
+        k--;
+        j--;
+        vChildren[k] = vNewIDs[j];
+        vPositions[j] = k;
+    }
+
+    //the items before the 1st insertion did not move
+    size_t uiSize = vChildren.size();
+    for(k = vPositions[0]; k < uiSize; k++) vChildren[k].SetChildIndex(k);
+}
+
+/** Remove the items marked as invalid
+  * \param vChildren [input/output]: the children. The child indices are updated
+  * \param vRemoved  [output]      : the child indices of the removed items (before removal)
+  * O(n) time
+  */
+void wxVirtualIArrayProxyDataModel::EraseInvalidChildren(wxVirtualItemIDs &vChildren,
+                                                         TPositions &vRemoved)
+{
+    size_t i, j, uiSize;
+    uiSize = vChildren.size();
+    j = 0;
+    for(i = 0; i < uiSize; i++)
+    {
+        if (!vChildren[i].IsOK())
+        {
+            vRemoved.push_back(i);
+            continue;
+        }
+
+        if (i != j) vChildren[j] = vChildren[i];
+        vChildren[j].SetChildIndex(j);
+        j++;
+    }
+    if (j < uiSize) vChildren.erase(vChildren.begin() + j, vChildren.end());
+}
+
+/** Send the notifications for removed & inserted children
+  * \param rParent   [input]: the parent item
+  * \param vRemoved  [input]: the child indices of the removed items (before removal), in ascending order
+  * \param vInserted [input]: the child indices of the inserted items (after insertion), in ascending order
+  * Contiguous items are notified at once. The removed items are notified from the last one, so that
+  * the indices stay valid. If there are too many ranges, a single ChildrenReset() is sent.
+  */
+void wxVirtualIArrayProxyDataModel::NotifyChildrenUpdated(const wxVirtualItemID &rParent,
+                                                          const TPositions &vRemoved,
+                                                          const TPositions &vInserted)
+{
+    //count the ranges
+    size_t i, uiNbRanges, uiNbRemoved, uiNbInserted;
+    uiNbRemoved  = vRemoved.size();
+    uiNbInserted = vInserted.size();
+    uiNbRanges   = 0;
+    for(i = 0; i < uiNbRemoved; i++)
+    {
+        if ((i == 0) || (vRemoved[i] != vRemoved[i - 1] + 1)) uiNbRanges++;
+    }
+    for(i = 0; i < uiNbInserted; i++)
+    {
+        if ((i == 0) || (vInserted[i] != vInserted[i - 1] + 1)) uiNbRanges++;
+    }
+    if (uiNbRanges == 0) return;
+    if (uiNbRanges > s_uiMaxNotifiedRanges)
+    {
+        ChildrenReset(rParent);
+        return;
+    }
+
+    //removed items : from the last range
+    size_t uiEnd = uiNbRemoved;
+    while (uiEnd > 0)
+    {
+        size_t uiStart = uiEnd - 1;
+        while ((uiStart > 0) && (vRemoved[uiStart - 1] + 1 == vRemoved[uiStart])) uiStart--;
+        ItemsRemoved(rParent, vRemoved[uiStart], uiEnd - uiStart);
+        uiEnd = uiStart;
+    }
+
+    //inserted items : from the 1st range
+    size_t uiStart = 0;
+    while (uiStart < uiNbInserted)
+    {
+        uiEnd = uiStart + 1;
+        while ((uiEnd < uiNbInserted) && (vInserted[uiEnd - 1] + 1 == vInserted[uiEnd])) uiEnd++;
+        ItemsInserted(rParent, vInserted[uiStart], uiEnd - uiStart);
+        uiStart = uiEnd;
+    }
+}
@@ -7,9 +7,13 @@
 
 #include <wx/VirtualDataView/Models/VirtualIDataModel.h>
 #include <wx/VirtualDataView/Models/VirtualIProxyDataModel.h>
+#include <wx/VirtualDataView/Models/VirtualIListDataModel.h>
+#include <wx/VirtualDataView/Models/VirtualIDataModelObserver.h>
 #include <wx/VirtualDataView/StateModels/VirtualIStateModel.h>
+#include <wx/VirtualDataView/StateModels/VirtualVisibleRowIndex.h>
 #include <wx/VirtualDataView/Types/BitmapText.h>
 #include <wx/VirtualDataView/Types/HashSetDefs.h>
+#include <wx/VirtualDataView/Types/VirtualValue.h>
 #include <wx/stack.h>
 #include <wx/regex.h>
 
@@ -44,6 +48,16 @@ int wxVirtualIDataModel::GetModelClass(void) const
     return(WX_MODEL_CLASS_BASE);
 }
 
+/** Get this model as a wxVirtualIListDataModel
+  * This is an alternative to RTTI and dynamic_cast. WX_MODEL_CLASS_LIST is not enough:
+  * some models report a flat list without deriving from wxVirtualIListDataModel
+  * \return this model if it derives from wxVirtualIListDataModel, NULL otherwise
+  */
+wxVirtualIListDataModel* wxVirtualIDataModel::AsListModel(void)
+{
+    return(WX_VDV_NULL_PTR);
+}
+
 //--------------------- INTERFACE: HIERARCHY ------------------------//
 /** Get all children at once
   * \param vIDs      [output]: the list of children item. Previous content is erased
@@ -98,6 +112,53 @@ wxVariant wxVirtualIDataModel::GetItemData(const wxVirtualItemID &rID,
     return(wxVariant());
 }
 
+/** Get the item data without allocation
+  * \param rValue  [output]: the data of the item. Null if no data is associated
+  * \param rID     [input] : the ID of the item to query
+  * \param uiField [input] : the field index of the item to query
+  * \param eType   [input] : the kind of data to get
+  *
+  * Used for painting, sorting & filtering. Default implementation wraps GetItemData().
+  * Reimplement it if the data can be returned as an integer, a double, a boolean,
+  * a date/time or a reference to a string owned by the model: no wxVariantData is allocated
+  */
+void wxVirtualIDataModel::GetItemValue(wxVirtualValue &rValue, const wxVirtualItemID &rID,
+                                       size_t uiField, EDataType eType)
+{
+    rValue.SetVariant(GetItemData(rID, uiField, eType));
+}
+
+/** Get the data of several items & fields at once
+  * \param vValues [output]: the values, row by row. vValues[i * vFields.size() + j] is the value
+  *                          of the field vFields[j] of the item vIDs[i]
+  * \param vIDs    [input] : the items to query
+  * \param vFields [input] : the fields to query
+  * \param eType   [input] : the kind of data to get
+  *
+  * Used for painting the visible rows, and by the sorting & filtering proxies for chunks of items.
+  * Default implementation calls GetItemValue() for each item & field.
+  * Reimplement it if a block of values can be produced in 1 call (columnar arrays, database pages...)
+  * The strings referenced by the values must stay valid until the model is modified
+  */
+void wxVirtualIDataModel::GetItemDataBatch(wxVirtualValues &vValues, const wxVirtualItemIDs &vIDs,
+                                           const TFieldIDs &vFields, EDataType eType)
+{
+    size_t uiNbIDs    = vIDs.size();
+    size_t uiNbFields = vFields.size();
+    vValues.resize(uiNbIDs * uiNbFields);
+
+    size_t i, j, k;
+    k = 0;
+    for(i=0;i<uiNbIDs;i++)
+    {
+        for(j=0;j<uiNbFields;j++)
+        {
+            GetItemValue(vValues[k], vIDs[i], vFields[j], eType);
+            k++;
+        }
+    }
+}
+
 /** Get the item graphic attributes
   * \param rID [input] : the ID of the item to query
   * \param uiField [input]: the field index of the item to query
@@ -417,12 +478,20 @@ size_t wxVirtualIDataModel::GetDepth(const wxVirtualItemID &rID)
   *
   * Default implementation use a wxStack internally
   * O(n) time, O(n) space (worst cases, generally O(log(n)) time and space)
+  * If the state model maintains a visible row index, it is used instead : O(1) time
   *
   * Used by FindItem when start item is the root item
   */
 size_t wxVirtualIDataModel::GetSubTreeSize(const wxVirtualItemID &rID,
                                            wxVirtualIStateModel *pStateModel)
 {
+    //use the index of visible rows if available
+    if (pStateModel)
+    {
+        wxVirtualVisibleRowIndex *pIndex = pStateModel->GetVisibleRowIndex(this);
+        if (pIndex) return(pIndex->GetSubTreeSize(rID));
+    }
+
     size_t uiResult = 0;
     long lChild, lNbChildren;
     wxStack<wxVirtualItemID> StackOfNodes;
@@ -496,6 +565,9 @@ size_t wxVirtualIDataModel::GetSubTreeSize(const wxVirtualItemID &rID,
   *     NextItem()       : O(n) time, O(1) space
   *     PrevItem()       : O(n) time, O(1) space
   *
+  * If the state model maintains a visible row index, it is used instead : O(d.log(k)) time
+  * (d = depth of the item, k = amount of siblings). The start point is not needed in that case
+  *
   * Reimplementation recommended if better performances can be expected.
   * Default implementation was tested with millions of items without too much problems.
   */
@@ -507,6 +579,18 @@ wxVirtualItemID wxVirtualIDataModel::FindItem(size_t uiRank,
     //special cases
     if (uiRank == uiStartRank) return(rStart);
 
+    //use the index of visible rows if available
+    if (pStateModel)
+    {
+        wxVirtualVisibleRowIndex *pIndex = pStateModel->GetVisibleRowIndex(this);
+        if (pIndex)
+        {
+            wxVirtualItemID id = pIndex->FindItem(uiRank);
+            if (id.IsInvalid()) return(CreateInvalidItemID());
+            return(id);
+        }
+    }
+
     //case where uiStartRank = 0 (starting at root)
     if (uiStartRank == 0)
     {
@@ -572,6 +656,8 @@ wxVirtualItemID wxVirtualIDataModel::FindItem(size_t uiRank,
   * \return the rank of the item. Root item has rank 0
   *
   * The default implementation use NextItem and runs in O(n) time and O(1) space
+  * If the state model maintains a visible row index, it is used instead : O(d.log(k)) time
+  * (d = depth of the item, k = amount of siblings)
   */
 size_t wxVirtualIDataModel::GetItemRank(const wxVirtualItemID &rID,
                                         wxVirtualIStateModel *pStateModel)
@@ -579,6 +665,17 @@ size_t wxVirtualIDataModel::GetItemRank(const wxVirtualItemID &rID,
     size_t uiResult = 0;
     if (!rID.IsOK()) return(uiResult);
 
+    //use the index of visible rows if available
+    if (pStateModel)
+    {
+        wxVirtualVisibleRowIndex *pIndex = pStateModel->GetVisibleRowIndex(this);
+        if (pIndex)
+        {
+            if (pIndex->GetItemRank(rID, uiResult)) return(uiResult);
+            return(0);
+        }
+    }
+
     wxVirtualItemID id = GetRootItem();
     size_t uiLevel = 1;
     while(id != rID)
@@ -1336,10 +1433,12 @@ wxVirtualIDataModel::ECompareResult wxVirtualIDataModel::Compare(const wxVirtual
                                                                  const wxVirtualItemID &rID2,
                                                                  size_t uiField)
 {
-    wxVariant vValue1 = GetItemData(rID1, uiField);
-    wxVariant vValue2 = GetItemData(rID2, uiField);
+    wxVirtualValue oValue1, oValue2;
+    GetItemValue(oValue1, rID1, uiField);
+    GetItemValue(oValue2, rID2, uiField);
 
-    int iRes = CompareItems(rID1, vValue1, rID2, vValue2);
+    int iRes = oValue1.Compare(oValue2);
+    if (iRes == WX_VARIANT_CANNOT_COMPARE) iRes = CompareItemID(rID1, rID2);
     return((ECompareResult) iRes);
 }
 
@@ -1363,6 +1462,20 @@ wxVirtualIDataModel::ECompareResult wxVirtualIDataModel::Compare(const wxVirtual
     return((ECompareResult) iRes);
 }
 
+/** Check if Compare() is reimplemented for a field
+  * \param uiField [input]: the field to check
+  * \return true if Compare() does not follow the default comparison of the values.
+  *         false if the default comparison is used (CompareVariants())
+  * If false, wxVirtualSortingDataModel can sort the field using typed keys, without calling Compare().
+  * Reimplement this method to return false if Compare() is not reimplemented for the field.
+  * The default implementation returns true, so that existing models reimplementing Compare()
+  * keep their order: the typed keys sorting is opt-in.
+  */
+bool wxVirtualIDataModel::HasCustomCompare(size_t uiField)
+{
+    return(true);
+}
+
 //--------------------- FILTERING HELPERS ---------------------------//
 template<typename TSet, typename T>
 WX_VDV_INLINE void AddVariantToSet(TSet &rSet, const wxVariant &v)
@@ -1777,6 +1890,47 @@ void wxVirtualIDataModel::GetAllValues(wxVector<wxVariant> &rvVariants, size_t u
     }
 }
 
+//------------------------ MULTI-THREADING --------------------------//
+/** Check if GetItemData() & Compare() can be called from worker threads
+  * \return true if GetItemData() and Compare() can be called concurrently from several
+  *         threads, while the main thread is waiting for them (the model is not modified meanwhile)
+  *         false otherwise
+  * If true, wxVirtualSortingDataModel may call these methods from worker threads in its parallel
+  * sorting mode. The returned wxVariant must not share data with other variants (the reference
+  * counting of wxVariant is not thread-safe).
+  * Reimplement this method to return true if the model allows it.
+  * The default implementation returns false.
+  */
+bool wxVirtualIDataModel::IsThreadSafe(void)
+{
+    return(false);
+}
+
+//--------------------------- VIEW HINTS ----------------------------//
+/** The rows shown by the view changed
+  * \param rHint [input]: the visible rows, and the scrolling speed & direction
+  * Called by the model renderer on the top-most model, before getting the values of the
+  * visible rows. This is only a hint: the values are still requested on demand.
+  * Models which are faster with ranged requests can use it for loading the visible rows
+  * in 1 request, and for prefetching the next rows (see wxVirtualPrefetchPolicy)
+  * The default implementation does nothing
+  */
+void wxVirtualIDataModel::OnViewportChanged(const wxVirtualViewportHint &rHint)
+{
+}
+
+/** The view starts / stops reading the values of the painted cells
+  * \param bStart [input]: true before the values are read, false after
+  * Called by the model renderer on the top-most model around the GetItemDataBatch() call
+  * fetching the visible cells. All other reads (sorting, filtering, searching, ...) are made
+  * outside of this scope. Models which can return temporary values (see wxVirtualAsyncDataModel)
+  * may do it only for these reads.
+  * The default implementation does nothing
+  */
+void wxVirtualIDataModel::OnPaintFetch(bool bStart)
+{
+}
+
 //------------------------ PROXY DATA MODEL -------------------------//
 /** Return true if the model is a proxy data model
   * \return true for proxy model, false for base model
@@ -1786,6 +1940,15 @@ bool wxVirtualIDataModel::IsProxyDataModel(void) const
     return(false);
 }
 
+/** Return true if the model changes the order or the set of the children of its master model
+  * \return true for sorting / filtering proxy models, false otherwise
+  * The child indices of such a model are not the ones of its master model
+  */
+bool wxVirtualIDataModel::IsReorderingProxy(void) const
+{
+    return(false);
+}
+
 /** Get the parent model
   * \return the parent model. May be NULL if it is already the top-most model
   */
@@ -1801,6 +1964,22 @@ wxVirtualIDataModel* wxVirtualIDataModel::GetParentModel(void)
   */
 void wxVirtualIDataModel::SetParentModel(wxVirtualIDataModel *pParentModel)
 {
+    //the observers are held by the top-most model of the chain
+    if (pParentModel)
+    {
+        //attached below a new model : it becomes the owner of the observers
+        wxVirtualIDataModel *pTopModel = pParentModel->GetTopModel();
+        size_t i, uiNbObservers;
+        uiNbObservers = m_vObservers.size();
+        for(i = 0; i < uiNbObservers; i++) pTopModel->m_vObservers.push_back(m_vObservers[i]);
+        m_vObservers.clear();
+    }
+    else if ((m_pParentModel) && (!m_pParentModel->m_pParentModel))
+    {
+        //detached from the top-most model : this one becomes the top-most model
+        m_vObservers.swap(m_pParentModel->m_vObservers);
+    }
+
     m_pParentModel = pParentModel;
 }
 
@@ -1833,6 +2012,284 @@ wxVirtualIDataModel* wxVirtualIDataModel::GetBottomModel(void)
     return(pDataModel);
 }
 
+//------------------------ CHANGE NOTIFICATIONS ---------------------//
+/** Register an observer of the changes
+  * \param pObserver [input]: the observer to register. Ownership is not taken
+  * The observer is registered in the top-most model of the chain, and follows it when
+  * proxy models are attached or detached.
+  */
+void wxVirtualIDataModel::AddObserver(wxVirtualIDataModelObserver *pObserver)
+{
+    if (!pObserver) return;
+    TObservers &vObservers = GetTopModel()->m_vObservers;
+    TObservers::iterator it    = vObservers.begin();
+    TObservers::iterator itEnd = vObservers.end();
+    while (it != itEnd)
+    {
+        if (*it == pObserver) return;
+        ++it;
+    }
+    vObservers.push_back(pObserver);
+}
+
+/** Unregister an observer of the changes
+  * \param pObserver [input]: the observer to unregister. It is not deleted
+  */
+void wxVirtualIDataModel::RemoveObserver(wxVirtualIDataModelObserver *pObserver)
+{
+    TObservers &vObservers = GetTopModel()->m_vObservers;
+    TObservers::iterator it    = vObservers.begin();
+    TObservers::iterator itEnd = vObservers.end();
+    while (it != itEnd)
+    {
+        if (*it == pObserver)
+        {
+            vObservers.erase(it);
+            return;
+        }
+        ++it;
+    }
+}
+
+/** Notify that some items were inserted
+  * \param rParent [input]: the parent of the new items
+  * \param uiFirst [input]: the child index of the 1st new item
+  * \param uiCount [input]: the amount of new items
+  * Must be called after the insertion, in the GUI thread
+  */
+void wxVirtualIDataModel::ItemsInserted(const wxVirtualItemID &rParent,
+                                        size_t uiFirst, size_t uiCount)
+{
+    if (uiCount == 0) return;
+
+    //the IDs of the following rows changed : remap them in all the chain first
+    wxVirtualIListDataModel *pListModel = AsListModel();
+    if (pListModel) wxVirtualIDataModel::OnItemIDsShifted(pListModel, uiFirst, uiCount, true);
+
+    if (m_pParentModel)
+    {
+        m_pParentModel->OnMasterItemsInserted(rParent, uiFirst, uiCount);
+        return;
+    }
+
+    size_t i, uiNbObservers;
+    uiNbObservers = m_vObservers.size();
+    for(i = 0; i < uiNbObservers; i++) m_vObservers[i]->OnItemsInserted(this, rParent, uiFirst, uiCount);
+}
+
+/** Notify that some items were removed
+  * \param rParent [input]: the parent of the removed items
+  * \param uiFirst [input]: the child index of the 1st removed item, before the removal
+  * \param uiCount [input]: the amount of removed items
+  * Must be called after the removal, in the GUI thread
+  */
+void wxVirtualIDataModel::ItemsRemoved(const wxVirtualItemID &rParent,
+                                       size_t uiFirst, size_t uiCount)
+{
+    if (uiCount == 0) return;
+
+    //the IDs of the following rows changed : remap them in all the chain first
+    wxVirtualIListDataModel *pListModel = AsListModel();
+    if (pListModel) wxVirtualIDataModel::OnItemIDsShifted(pListModel, uiFirst, uiCount, false);
+
+    if (m_pParentModel)
+    {
+        m_pParentModel->OnMasterItemsRemoved(rParent, uiFirst, uiCount);
+        return;
+    }
+
+    size_t i, uiNbObservers;
+    uiNbObservers = m_vObservers.size();
+    for(i = 0; i < uiNbObservers; i++) m_vObservers[i]->OnItemsRemoved(this, rParent, uiFirst, uiCount);
+}
+
+/** Notify that the values of some items changed
+  * \param vIDs    [input]: the items which changed
+  * \param vFields [input]: the fields which changed. Empty for all fields
+  * Must be called after the change, in the GUI thread
+  */
+void wxVirtualIDataModel::ItemsChanged(const wxVirtualItemIDs &vIDs,
+                                       const TFieldIDs &vFields)
+{
+    if (vIDs.empty()) return;
+    if (m_pParentModel)
+    {
+        m_pParentModel->OnMasterItemsChanged(vIDs, vFields);
+        return;
+    }
+
+    size_t i, uiNbObservers;
+    uiNbObservers = m_vObservers.size();
+    for(i = 0; i < uiNbObservers; i++) m_vObservers[i]->OnItemsChanged(this, vIDs, vFields);
+}
+
+/** Notify that some items were moved
+  * \param rParent       [input]: the parent of the moved items
+  * \param uiFirst       [input]: the child index of the 1st moved item, before the move
+  * \param uiCount       [input]: the amount of moved items
+  * \param uiDestination [input]: the items were moved before this child index (index before the move)
+  * Must be called after the move, in the GUI thread
+  */
+void wxVirtualIDataModel::ItemsMoved(const wxVirtualItemID &rParent,
+                                     size_t uiFirst, size_t uiCount,
+                                     size_t uiDestination)
+{
+    if (uiCount == 0) return;
+    if (m_pParentModel)
+    {
+        m_pParentModel->OnMasterItemsMoved(rParent, uiFirst, uiCount, uiDestination);
+        return;
+    }
+
+    size_t i, uiNbObservers;
+    uiNbObservers = m_vObservers.size();
+    for(i = 0; i < uiNbObservers; i++) m_vObservers[i]->OnItemsMoved(this, rParent, uiFirst, uiCount, uiDestination);
+}
+
+/** Notify that some items must be repainted, but their values did not change
+  * \param vIDs [input]: the items to repaint
+  * For example, values which were being fetched in background are now available.
+  * The proxy models are not notified (their caches do not depend on the display):
+  * the notification goes straight to the observers of the top-most model.
+  * Must be called in the GUI thread
+  */
+void wxVirtualIDataModel::ItemsRefreshed(const wxVirtualItemIDs &vIDs)
+{
+    if (vIDs.empty()) return;
+    if (m_pParentModel)
+    {
+        m_pParentModel->ItemsRefreshed(vIDs);
+        return;
+    }
+
+    size_t i, uiNbObservers;
+    uiNbObservers = m_vObservers.size();
+    for(i = 0; i < uiNbObservers; i++) m_vObservers[i]->OnItemsRefreshed(this, vIDs);
+}
+
+/** Notify that the children of an item changed in an unspecified way
+  * \param rParent [input]: the item whose children changed
+  * Must be called after the change, in the GUI thread
+  */
+void wxVirtualIDataModel::ChildrenReset(const wxVirtualItemID &rParent)
+{
+    if (m_pParentModel)
+    {
+        m_pParentModel->OnMasterChildrenReset(rParent);
+        return;
+    }
+
+    size_t i, uiNbObservers;
+    uiNbObservers = m_vObservers.size();
+    for(i = 0; i < uiNbObservers; i++) m_vObservers[i]->OnChildrenReset(this, rParent);
+}
+
+/** Notify that the whole model changed
+  * Must be called after the change, in the GUI thread
+  */
+void wxVirtualIDataModel::ModelReset(void)
+{
+    if (m_pParentModel)
+    {
+        m_pParentModel->OnMasterModelReset();
+        return;
+    }
+
+    size_t i, uiNbObservers;
+    uiNbObservers = m_vObservers.size();
+    for(i = 0; i < uiNbObservers; i++) m_vObservers[i]->OnModelReset(this);
+}
+
+/** The rows of the bottom list model were shifted
+  * \param pListModel [input]: the bottom list model
+  * \param uiFirst    [input]: the 1st inserted / removed row
+  * \param uiCount    [input]: the amount of inserted / removed rows
+  * \param bInserted  [input]: true if the rows were inserted, false if they were removed
+  * Called on all the models of the chain, before the notification itself.
+  * The default implementation keeps no item IDs, and forwards to the parent model.
+  * The top-most model forwards to its observers
+  */
+void wxVirtualIDataModel::OnItemIDsShifted(wxVirtualIListDataModel *pListModel,
+                                           size_t uiFirst, size_t uiCount,
+                                           bool bInserted)
+{
+    if (m_pParentModel)
+    {
+        m_pParentModel->OnItemIDsShifted(pListModel, uiFirst, uiCount, bInserted);
+        return;
+    }
+
+    size_t i, uiNbObservers;
+    uiNbObservers = m_vObservers.size();
+    for(i = 0; i < uiNbObservers; i++) m_vObservers[i]->OnItemIDsShifted(this, pListModel, uiFirst, uiCount, bInserted);
+}
+
+/** Some items were inserted in the master model
+  * \param rParent [input]: the parent of the new items
+  * \param uiFirst [input]: the child index of the 1st new item in the master model
+  * \param uiCount [input]: the amount of new items
+  * The default implementation forwards the notification unchanged
+  */
+void wxVirtualIDataModel::OnMasterItemsInserted(const wxVirtualItemID &rParent,
+                                                size_t uiFirst, size_t uiCount)
+{
+    ItemsInserted(rParent, uiFirst, uiCount);
+}
+
+/** Some items were removed from the master model
+  * \param rParent [input]: the parent of the removed items
+  * \param uiFirst [input]: the child index of the 1st removed item in the master model
+  * \param uiCount [input]: the amount of removed items
+  * The default implementation forwards the notification unchanged
+  */
+void wxVirtualIDataModel::OnMasterItemsRemoved(const wxVirtualItemID &rParent,
+                                               size_t uiFirst, size_t uiCount)
+{
+    ItemsRemoved(rParent, uiFirst, uiCount);
+}
+
+/** The values of some items of the master model changed
+  * \param vIDs    [input]: the items which changed
+  * \param vFields [input]: the fields which changed. Empty for all fields
+  * The default implementation forwards the notification unchanged
+  */
+void wxVirtualIDataModel::OnMasterItemsChanged(const wxVirtualItemIDs &vIDs,
+                                               const TFieldIDs &vFields)
+{
+    ItemsChanged(vIDs, vFields);
+}
+
+/** Some items of the master model were moved
+  * \param rParent       [input]: the parent of the moved items
+  * \param uiFirst       [input]: the child index of the 1st moved item, before the move
+  * \param uiCount       [input]: the amount of moved items
+  * \param uiDestination [input]: the items were moved before this child index (index before the move)
+  * The default implementation forwards the notification unchanged
+  */
+void wxVirtualIDataModel::OnMasterItemsMoved(const wxVirtualItemID &rParent,
+                                             size_t uiFirst, size_t uiCount,
+                                             size_t uiDestination)
+{
+    ItemsMoved(rParent, uiFirst, uiCount, uiDestination);
+}
+
+/** The children of an item of the master model changed
+  * \param rParent [input]: the item whose children changed
+  * The default implementation forwards the notification unchanged
+  */
+void wxVirtualIDataModel::OnMasterChildrenReset(const wxVirtualItemID &rParent)
+{
+    ChildrenReset(rParent);
+}
+
+/** The whole master model changed
+  * The default implementation forwards the notification unchanged
+  */
+void wxVirtualIDataModel::OnMasterModelReset(void)
+{
+    ModelReset();
+}
+
 //-------------------- INDEX CREATION METHODS -----------------------//
 /** Create an item ID from a void pointer
   * \param pID   [input]: the ID of the model item ID
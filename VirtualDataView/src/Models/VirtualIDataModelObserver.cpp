@@ -0,0 +1,50 @@
+/**********************************************************************/
+/** FILE    : VirtualIDataModelObserver.cpp                          **/
+/** PROJECT : wxVirtualDataViewCtrl                                  **/
+/** LICENSE : wxWindows Library Licence                              **/
+/** PURPOSE : interface for receiving data model change notifications**/
+/**********************************************************************/
+
+#include <wx/VirtualDataView/Models/VirtualIDataModelObserver.h>
+
+//----------------------- CONSTRUCTORS & DESTRUCTOR -----------------//
+/** Default constructor
+  */
+wxVirtualIDataModelObserver::wxVirtualIDataModelObserver(void)
+{
+}
+
+/** Destructor
+  */
+wxVirtualIDataModelObserver::~wxVirtualIDataModelObserver(void)
+{
+
+}
+
+//-------------- INTERFACE WITH DEFAULT IMPLEMENTATION --------------//
+/** The item IDs of a list model were shifted by an insertion or a removal
+  * \param pModel     [input]: the top-most model sending the notification
+  * \param pListModel [input]: the list model in which rows were inserted / removed
+  * \param uiFirst    [input]: the row index of the 1st inserted / removed row in pListModel
+  * \param uiCount    [input]: the amount of inserted / removed rows
+  * \param bInserted  [input]: true if the rows were inserted, false if they were removed
+  * The default implementation does nothing
+  */
+void wxVirtualIDataModelObserver::OnItemIDsShifted(wxVirtualIDataModel *pModel,
+                                                   wxVirtualIListDataModel *pListModel,
+                                                   size_t uiFirst, size_t uiCount,
+                                                   bool bInserted)
+{
+
+}
+
+/** Some items must be repainted, but their values did not change
+  * \param pModel [input]: the top-most model sending the notification
+  * \param vIDs   [input]: the items to repaint
+  * The default implementation handles it as a change of all the fields (OnItemsChanged())
+  */
+void wxVirtualIDataModelObserver::OnItemsRefreshed(wxVirtualIDataModel *pModel,
+                                                   const wxVirtualItemIDs &vIDs)
+{
+    OnItemsChanged(pModel, vIDs, TFieldIDs());
+}
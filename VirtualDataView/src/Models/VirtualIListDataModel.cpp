@@ -6,6 +6,7 @@
 /**********************************************************************/
 
 #include <wx/VirtualDataView/Models/VirtualIListDataModel.h>
+#include <wx/VirtualDataView/Types/VirtualValue.h>
 
 //--------------- CONSTRUCTORS & DESTRUCTOR -------------------------//
 /** Default constructor
@@ -71,6 +72,14 @@ int wxVirtualIListDataModel::GetModelClass(void) const
     return(WX_MODEL_CLASS_BASE | WX_MODEL_CLASS_LIST);
 }
 
+/** Get this model as a wxVirtualIListDataModel
+  * \return this
+  */
+wxVirtualIListDataModel* wxVirtualIListDataModel::AsListModel(void)
+{
+    return(this);
+}
+
 //---------------- NEW INTERFACE : ITEM DATA ------------------------//
 /** Get the item data
   * \param uiItemID [input]: row index of the item
@@ -86,6 +95,52 @@ wxVariant wxVirtualIListDataModel::GetListItemData(size_t uiItemID, size_t uiFie
     return(wxVariant());
 }
 
+/** Get the item data without allocation
+  * \param rValue   [output]: the data of the item. Null if no data is associated
+  * \param uiItemID [input] : row index of the item
+  * \param uiField  [input] : the field index of the item to query
+  * \param eType    [input] : the kind of data to get
+  *
+  * Default implementation wraps GetListItemData().
+  * See wxVirtualIDataModel::GetItemValue()
+  */
+void wxVirtualIListDataModel::GetListItemValue(wxVirtualValue &rValue, size_t uiItemID,
+                                               size_t uiField, EDataType eType)
+{
+    rValue.SetVariant(GetListItemData(uiItemID, uiField, eType));
+}
+
+/** Get the data of several rows & fields at once
+  * \param vValues [output]: the values, row by row. vValues[i * vFields.size() + j] is the value
+  *                          of the field vFields[j] of the row vRows[i]
+  * \param vRows   [input] : the row indices to query. size_t(-1) for an invalid item (null values)
+  * \param vFields [input] : the fields to query
+  * \param eType   [input] : the kind of data to get
+  *
+  * Default implementation calls GetListItemValue() for each row & field.
+  * See wxVirtualIDataModel::GetItemDataBatch()
+  */
+void wxVirtualIListDataModel::GetListItemDataBatch(wxVirtualValues &vValues, const TRowIndices &vRows,
+                                                   const TFieldIDs &vFields, EDataType eType)
+{
+    size_t uiNbRows   = vRows.size();
+    size_t uiNbFields = vFields.size();
+    vValues.resize(uiNbRows * uiNbFields);
+
+    size_t i, j, k;
+    k = 0;
+    for(i=0;i<uiNbRows;i++)
+    {
+        size_t uiRow = vRows[i];
+        for(j=0;j<uiNbFields;j++)
+        {
+            if (uiRow == size_t(-1)) vValues[k].SetNull();
+            else                     GetListItemValue(vValues[k], uiRow, vFields[j], eType);
+            k++;
+        }
+    }
+}
+
 
 /** Get the item graphic attributes
   * \param uiItemID [input]: row index of the item
@@ -220,6 +275,40 @@ wxVariant wxVirtualIListDataModel::GetItemData(const wxVirtualItemID &rID, size_
     return(GetListItemData(DoGetRowIndex(rID), uiField, eType));
 }
 
+/** Get the item data without allocation
+  * \param rValue  [output]: the data of the item. Null if no data is associated
+  * \param rID     [input] : the ID of the item to query
+  * \param uiField [input] : the field index of the item to query
+  * \param eType   [input] : the kind of data to get
+  */
+void wxVirtualIListDataModel::GetItemValue(wxVirtualValue &rValue, const wxVirtualItemID &rID,
+                                           size_t uiField, EDataType eType)
+{
+    if (!rID.IsOK()) rValue.SetNull();
+    else             GetListItemValue(rValue, DoGetRowIndex(rID), uiField, eType);
+}
+
+/** Get the data of several items & fields at once
+  * The item IDs are converted to row indices, and GetListItemDataBatch() is called
+  * \param vValues [output]: the values, row by row. See wxVirtualIDataModel::GetItemDataBatch()
+  * \param vIDs    [input] : the items to query
+  * \param vFields [input] : the fields to query
+  * \param eType   [input] : the kind of data to get
+  */
+void wxVirtualIListDataModel::GetItemDataBatch(wxVirtualValues &vValues, const wxVirtualItemIDs &vIDs,
+                                               const TFieldIDs &vFields, EDataType eType)
+{
+    size_t i, uiNbIDs;
+    uiNbIDs = vIDs.size();
+    TRowIndices vRows(uiNbIDs);
+    for(i=0;i<uiNbIDs;i++)
+    {
+        if (vIDs[i].IsOK()) vRows[i] = DoGetRowIndex(vIDs[i]);
+        else                vRows[i] = size_t(-1);
+    }
+    GetListItemDataBatch(vValues, vRows, vFields, eType);
+}
+
 /** Get the item graphic attributes
   * \param rID [input] : the ID of the item to query
   * \param uiField [input]: the field index of the item to query
@@ -7,6 +7,8 @@
 
 #include <wx/VirtualDataView/Models/VirtualIProxyDataModel.h>
 #include <wx/VirtualDataView/StateModels/VirtualIStateModel.h>
+#include <wx/VirtualDataView/StateModels/VirtualVisibleRowIndex.h>
+#include <wx/VirtualDataView/Types/VirtualValue.h>
 
 //we need to reimplement all the virtual methods and forward them to the shadowed data model
 //This is necessary even for virtual methods with common implementation.
@@ -150,6 +152,62 @@ wxVariant wxVirtualIProxyDataModel::GetItemData(const wxVirtualItemID &rID,
     return(wxVariant());
 }
 
+/** Get the item data without allocation
+  * The default implementation calls GetItemData() of this model, so that a proxy which
+  * transforms the values by overriding GetItemData() only is still honoured.
+  * Proxies which do not transform the values can forward to the master model instead
+  * \param rValue  [output]: the data of the item. Null if no data is associated
+  * \param rID     [input] : the ID of the item to query
+  * \param uiField [input] : the field index of the item to query
+  * \param eType   [input] : the kind of data to get
+  */
+void wxVirtualIProxyDataModel::GetItemValue(wxVirtualValue &rValue, const wxVirtualItemID &rID,
+                                            size_t uiField, EDataType eType)
+{
+    wxVirtualIDataModel::GetItemValue(rValue, rID, uiField, eType);
+}
+
+/** Get the data of several items & fields at once
+  * The default implementation calls GetItemValue() of this model for each value
+  * \param vValues [output]: the values, row by row. See wxVirtualIDataModel::GetItemDataBatch()
+  * \param vIDs    [input] : the items to query
+  * \param vFields [input] : the fields to query
+  * \param eType   [input] : the kind of data to get
+  */
+void wxVirtualIProxyDataModel::GetItemDataBatch(wxVirtualValues &vValues, const wxVirtualItemIDs &vIDs,
+                                                const TFieldIDs &vFields, EDataType eType)
+{
+    wxVirtualIDataModel::GetItemDataBatch(vValues, vIDs, vFields, eType);
+}
+
+/** Get the item data from the master model, bypassing GetItemData() of this model
+  * For proxies which do not transform the values
+  * \param rValue  [output]: the data of the item. Null if no data is associated
+  * \param rID     [input] : the ID of the item to query
+  * \param uiField [input] : the field index of the item to query
+  * \param eType   [input] : the kind of data to get
+  */
+void wxVirtualIProxyDataModel::ForwardItemValue(wxVirtualValue &rValue, const wxVirtualItemID &rID,
+                                                size_t uiField, EDataType eType)
+{
+    if (m_pDataModel) m_pDataModel->GetItemValue(rValue, rID, uiField, eType);
+    else              rValue.SetNull();
+}
+
+/** Get the data of several items & fields from the master model, bypassing GetItemData() of this model
+  * For proxies which do not transform the values
+  * \param vValues [output]: the values, row by row. See wxVirtualIDataModel::GetItemDataBatch()
+  * \param vIDs    [input] : the items to query
+  * \param vFields [input] : the fields to query
+  * \param eType   [input] : the kind of data to get
+  */
+void wxVirtualIProxyDataModel::ForwardItemDataBatch(wxVirtualValues &vValues, const wxVirtualItemIDs &vIDs,
+                                                    const TFieldIDs &vFields, EDataType eType)
+{
+    if (m_pDataModel) m_pDataModel->GetItemDataBatch(vValues, vIDs, vFields, eType);
+    else              wxVirtualIDataModel::GetItemDataBatch(vValues, vIDs, vFields, eType);
+}
+
 /** Get the item graphic attributes
   * \param rID [input] : the ID of the item to query
   * \param uiField [input]: the field index of the item to query
@@ -388,6 +446,11 @@ size_t wxVirtualIProxyDataModel::GetDepth(const wxVirtualItemID &rID)
 size_t wxVirtualIProxyDataModel::GetSubTreeSize(const wxVirtualItemID &rID,
                                                 wxVirtualIStateModel *pStateModel)
 {
+    //the index of visible rows is built on the top model, not on the shadowed one
+    if ((pStateModel) && (pStateModel->GetVisibleRowIndex(this)))
+    {
+        return(wxVirtualIDataModel::GetSubTreeSize(rID, pStateModel));
+    }
     if (m_pDataModel) return(m_pDataModel->GetSubTreeSize(rID, pStateModel));
     return(0);
 }
@@ -459,6 +522,11 @@ wxVirtualItemID wxVirtualIProxyDataModel::FindItem(size_t uiRank,
                                                    const wxVirtualItemID &rStart,
                                                    size_t uiStartRank)
 {
+    //the index of visible rows is built on the top model, not on the shadowed one
+    if ((pStateModel) && (pStateModel->GetVisibleRowIndex(this)))
+    {
+        return(wxVirtualIDataModel::FindItem(uiRank, pStateModel, rStart, uiStartRank));
+    }
     if (m_pDataModel) return(m_pDataModel->FindItem(uiRank, pStateModel, rStart, uiStartRank));
     return(CreateInvalidItemID());
 }
@@ -472,6 +540,11 @@ wxVirtualItemID wxVirtualIProxyDataModel::FindItem(size_t uiRank,
 size_t wxVirtualIProxyDataModel::GetItemRank(const wxVirtualItemID &rID,
                                              wxVirtualIStateModel *pStateModel)
 {
+    //the index of visible rows is built on the top model, not on the shadowed one
+    if ((pStateModel) && (pStateModel->GetVisibleRowIndex(this)))
+    {
+        return(wxVirtualIDataModel::GetItemRank(rID, pStateModel));
+    }
     if (m_pDataModel) return(m_pDataModel->GetItemRank(rID, pStateModel));
     return(0);
 }
@@ -809,6 +882,16 @@ wxVirtualIDataModel::ECompareResult wxVirtualIProxyDataModel::Compare(const wxVi
     return(WX_E_EQUAL);
 }
 
+/** Check if Compare() is reimplemented for a field
+  * \param uiField [input]: the field to check
+  * \return true if Compare() does not follow the default comparison of the values
+  */
+bool wxVirtualIProxyDataModel::HasCustomCompare(size_t uiField)
+{
+    if (m_pDataModel) return(m_pDataModel->HasCustomCompare(uiField));
+    return(false);
+}
+
 //------- FILTERING - GET ALL VALUES AS STRINGS ---------------------//
 /** Get all the values of a field
   * \param rvStrings [output]: an array of string. Previous content is lost
@@ -1138,6 +1221,36 @@ void wxVirtualIProxyDataModel::GetAllValues(wxVector<wxVariant> &rvVariants, siz
 }
 
 
+//------------------------ MULTI-THREADING --------------------------//
+/** Check if GetItemData() & Compare() can be called from worker threads
+  * \return true if GetItemData() and Compare() can be called concurrently from several threads
+  * The proxy forwards these calls, so the answer is given by the base model
+  */
+bool wxVirtualIProxyDataModel::IsThreadSafe(void)
+{
+    if (m_pDataModel) return(m_pDataModel->IsThreadSafe());
+    return(false);
+}
+
+//--------------------------- VIEW HINTS ----------------------------//
+/** The rows shown by the view changed
+  * \param rHint [input]: the visible rows, and the scrolling speed & direction
+  * The proxy forwards the hint to the master model
+  */
+void wxVirtualIProxyDataModel::OnViewportChanged(const wxVirtualViewportHint &rHint)
+{
+    if (m_pDataModel) m_pDataModel->OnViewportChanged(rHint);
+}
+
+/** The view starts / stops reading the values of the painted cells
+  * \param bStart [input]: true before the values are read, false after
+  * The proxy forwards the hint to the master model
+  */
+void wxVirtualIProxyDataModel::OnPaintFetch(bool bStart)
+{
+    if (m_pDataModel) m_pDataModel->OnPaintFetch(bStart);
+}
+
 //------------------------ PROXY DATA MODEL -------------------------//
 /** Return true if the model is a proxy data model
   * \return true for proxy model, false for base model
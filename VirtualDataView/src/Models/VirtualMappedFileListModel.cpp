@@ -0,0 +1,1005 @@
+/**********************************************************************/
+/** FILE    : VirtualMappedFileListModel.cpp                         **/
+/** PROJECT : wxVirtualDataViewCtrl                                  **/
+/** LICENSE : wxWindows Library Licence                              **/
+/** PURPOSE : list data model reading a memory-mapped file           **/
+/**********************************************************************/
+
+#include <wx/VirtualDataView/Models/VirtualMappedFileListModel.h>
+#include <wx/VirtualDataView/Types/VirtualValue.h>
+#include <wx/event.h>
+#include <wx/stopwatch.h>
+#include <string.h>
+
+//amount of rows indexed synchronously when a delimited file is opened
+static const size_t s_uiInitialRows = 4096;
+
+//amount of rows found by the indexing thread before publishing them
+static const size_t s_uiIndexerBatchRows = 65536;
+
+//minimal delay between 2 notifications of the row count, in ms
+static const long s_lNotificationDelay = 250;
+
+//default limits of the decoded rows cache
+static const size_t s_uiDefaultCacheRows  = 4096;
+static const size_t s_uiDefaultCacheBytes = 16 * 1024 * 1024;
+
+//-------------------- INDEXING THREAD & NOTIFIER -------------------//
+#if wxUSE_THREADS
+/** \class wxVirtualMappedFileIndexer : the thread indexing the lines of a delimited file
+  */
+class wxVirtualMappedFileIndexer : public wxThread
+{
+    public:
+        //constructor
+        wxVirtualMappedFileIndexer(wxVirtualMappedFileListModel *pModel, wxUint64 uiStart)
+            : wxThread(wxTHREAD_JOINABLE),
+              m_pModel(pModel),
+              m_uiStart(uiStart)
+        {}
+
+        /** Notify the GUI thread that new rows were indexed
+          */
+        void Notify(void)
+        {
+            wxQueueEvent(m_pModel->m_pNotifier, new wxThreadEvent(wxEVT_THREAD));
+        }
+
+    protected:
+        //data
+        wxVirtualMappedFileListModel*   m_pModel;                   ///< \brief the model to index
+        wxUint64                        m_uiStart;                  ///< \brief offset of the 1st line to index
+
+        /** Thread entry point
+          */
+        virtual ExitCode Entry(void)
+        {
+            m_pModel->IndexLines(m_uiStart, size_t(-1), this);
+            Notify();
+            return(0);
+        }
+};
+
+/** \class wxVirtualMappedFileNotifier : receives the progress of the indexing thread in the GUI thread
+  */
+class wxVirtualMappedFileNotifier : public wxEvtHandler
+{
+    public:
+        //constructor
+        wxVirtualMappedFileNotifier(wxVirtualMappedFileListModel *pModel)
+            : wxEvtHandler(),
+              m_pModel(pModel)
+        {
+            Bind(wxEVT_THREAD, &wxVirtualMappedFileNotifier::OnIndexerEvent, this);
+        }
+
+    protected:
+        //data
+        wxVirtualMappedFileListModel*   m_pModel;                   ///< \brief the notified model
+
+        /** New rows were indexed
+          * \param rEvent [input]: the event information
+          */
+        void OnIndexerEvent(wxThreadEvent &rEvent)
+        {
+            m_pModel->PublishRowCount();
+        }
+};
+#endif // wxUSE_THREADS
+
+/** Lock the line index in the current scope
+  */
+#if wxUSE_THREADS
+    #define WX_VDV_LOCK_INDEX()     wxCriticalSectionLocker oIndexLock(m_IndexLock)
+#else
+    #define WX_VDV_LOCK_INDEX()
+#endif // wxUSE_THREADS
+
+/** Convert bytes from the file to a string
+  * The bytes are decoded as UTF-8, or as ISO-8859-1 if they are not valid UTF-8
+  * \param pBegin [input]: the 1st byte
+  * \param pEnd   [input]: the end of the bytes
+  * \return the string
+  */
+static wxString DecodeText(const char *pBegin, const char *pEnd)
+{
+    size_t uiLen = pEnd - pBegin;
+    if (uiLen == 0) return(wxEmptyString);
+
+    wxString sResult = wxString::FromUTF8(pBegin, uiLen);
+    if (sResult.IsEmpty()) sResult = wxString(pBegin, wxConvISO8859_1, uiLen);
+    return(sResult);
+}
+
+//------------------ CONSTRUCTORS & DESTRUCTOR ----------------------//
+/** Default constructor
+  */
+wxVirtualMappedFileListModel::wxVirtualMappedFileListModel(void)
+    : wxVirtualIListDataModel(),
+      m_eFormat(WX_FORMAT_NONE),
+      m_uiRowCount(0),
+      m_cSeparator(','),
+      m_cQuote('"'),
+      m_uiDataStart(0),
+      m_uiRecordSize(0),
+      m_uiIndexEnd(0),
+      m_bIndexError(false),
+      m_bIndexing(false),
+#if wxUSE_THREADS
+      m_pIndexer(WX_VDV_NULL_PTR),
+      m_pNotifier(WX_VDV_NULL_PTR),
+#endif // wxUSE_THREADS
+      m_DecodedRows(s_uiDefaultCacheRows)
+{
+#if wxUSE_THREADS
+    m_pNotifier = new wxVirtualMappedFileNotifier(this);
+#endif // wxUSE_THREADS
+    m_DecodedRows.SetMemoryLimit(s_uiDefaultCacheBytes);
+}
+
+/** Destructor
+  */
+wxVirtualMappedFileListModel::~wxVirtualMappedFileListModel(void)
+{
+    Close();
+#if wxUSE_THREADS
+    delete(m_pNotifier);
+#endif // wxUSE_THREADS
+}
+
+//-------------------------- OPEN / CLOSE ---------------------------//
+/** Open a delimited text file
+  * The 1st rows are indexed immediately, and the rest of the file is indexed in the background.
+  * ModelReset() is sent on success
+  * \param sFileName  [input]: the name of the file
+  * \param cSeparator [input]: the fields separator (ASCII)
+  * \param bHasHeader [input]: true if the 1st line contains the names of the fields
+  * \param cQuote     [input]: the quote character (ASCII). 0 if the fields are never quoted
+  * \return true on success, false on failure
+  */
+bool wxVirtualMappedFileListModel::OpenDelimitedFile(const wxString &sFileName, wxChar cSeparator,
+                                                     bool bHasHeader, wxChar cQuote)
+{
+    Close();
+    if (!m_File.Open(sFileName)) return(false);
+
+    m_eFormat    = WX_FORMAT_DELIMITED;
+    m_cSeparator = (char) cSeparator;
+    m_cQuote     = (char) cQuote;
+
+    //skip the UTF-8 BOM
+    const char *pData = m_File.GetData();
+    wxUint64 uiSize   = m_File.GetSize();
+    wxUint64 uiStart  = 0;
+    if ((uiSize >= 3) && (memcmp(pData, "\xEF\xBB\xBF", 3) == 0)) uiStart = 3;
+
+    //the 1st line gives the fields
+    wxUint64 uiFirstLineEnd = uiSize;
+    if (uiStart < uiSize)
+    {
+        const char *pNewLine = (const char *) memchr(pData + uiStart, '\n', size_t(uiSize - uiStart));
+        if (pNewLine) uiFirstLineEnd = pNewLine - pData;
+    }
+
+    TDecodedRow vNames;
+    const char *pLineEnd = pData + uiFirstLineEnd;
+    if ((pLineEnd > pData + uiStart) && (*(pLineEnd - 1) == '\r')) pLineEnd--;
+    if (uiStart < uiSize) SplitLine(vNames, pData + uiStart, pLineEnd, 0);
+
+    size_t i, uiNbFields;
+    uiNbFields = vNames.size();
+    m_vFields.reserve(uiNbFields);
+    for(i = 0; i < uiNbFields; i++)
+    {
+        TField oField;
+        oField.m_eType    = WX_FIELD_TEXT;
+        oField.m_uiOffset = 0;
+        oField.m_uiSize   = 0;
+        if (bHasHeader) oField.m_sName = vNames[i];
+        m_vFields.push_back(oField);
+    }
+
+    if (bHasHeader)
+    {
+        uiStart = uiFirstLineEnd;
+        if (uiStart < uiSize) uiStart++;
+    }
+
+    //index the 1st rows, for displaying them immediately
+    m_uiDataStart = uiStart;
+    m_uiIndexEnd  = uiStart;
+    m_bIndexing   = true;
+    wxUint64 uiNext = IndexLines(uiStart, s_uiInitialRows, WX_VDV_NULL_PTR);
+
+#if wxUSE_THREADS
+    if (m_bIndexing)
+    {
+        m_pIndexer = new wxVirtualMappedFileIndexer(this, uiNext);
+        if ((m_pIndexer->Create() != wxTHREAD_NO_ERROR) || (m_pIndexer->Run() != wxTHREAD_NO_ERROR))
+        {
+            delete(m_pIndexer);
+            m_pIndexer = WX_VDV_NULL_PTR;
+            IndexLines(uiNext, size_t(-1), WX_VDV_NULL_PTR);
+        }
+    }
+#else
+    if (m_bIndexing) IndexLines(uiNext, size_t(-1), WX_VDV_NULL_PTR);
+#endif // wxUSE_THREADS
+
+    m_uiRowCount = GetIndexedRowCount();
+    ModelReset();
+    return(true);
+}
+
+/** Open a file of fixed-size binary records
+  * The fields must be described with AddRecordField().
+  * ModelReset() is sent on success
+  * \param sFileName    [input]: the name of the file
+  * \param uiRecordSize [input]: the size of 1 record, in bytes
+  * \param uiHeaderSize [input]: the amount of bytes to skip at the beginning of the file
+  * \return true on success, false on failure
+  */
+bool wxVirtualMappedFileListModel::OpenRecordsFile(const wxString &sFileName, size_t uiRecordSize,
+                                                   wxUint64 uiHeaderSize)
+{
+    Close();
+    if (uiRecordSize == 0) return(false);
+    if (!m_File.Open(sFileName)) return(false);
+
+    m_eFormat      = WX_FORMAT_RECORDS;
+    m_uiRecordSize = uiRecordSize;
+    m_uiDataStart  = uiHeaderSize;
+
+    wxUint64 uiSize = m_File.GetSize();
+    if (uiSize > uiHeaderSize) m_uiRowCount = size_t((uiSize - uiHeaderSize) / uiRecordSize);
+    m_uiIndexEnd = uiSize;
+    ModelReset();
+    return(true);
+}
+
+/** Close the file
+  * The background indexing is stopped, and the fields are removed.
+  * Call wxVirtualDataViewCtrl::OnDataModelChanged() after closing the file
+  */
+void wxVirtualMappedFileListModel::Close(void)
+{
+    StopIndexing();
+#if wxUSE_THREADS
+    m_pNotifier->DeletePendingEvents();
+#endif // wxUSE_THREADS
+    m_File.Close();
+    ResetFile();
+}
+
+/** Check if a file is opened
+  * \return true if a file is opened
+  */
+bool wxVirtualMappedFileListModel::IsOpened(void) const
+{
+    return(m_eFormat != WX_FORMAT_NONE);
+}
+
+/** Get the format of the file
+  * \return the format of the file
+  */
+wxVirtualMappedFileListModel::EFormat wxVirtualMappedFileListModel::GetFormat(void) const
+{
+    return(m_eFormat);
+}
+
+/** Get the name of the file
+  * \return the name of the file
+  */
+wxString wxVirtualMappedFileListModel::GetFileName(void) const
+{
+    return(m_File.GetFileName());
+}
+
+/** Get the size of the file
+  * \return the size of the file, in bytes
+  */
+wxUint64 wxVirtualMappedFileListModel::GetFileSize(void) const
+{
+    return(m_File.GetSize());
+}
+
+//----------------------------- FIELDS ------------------------------//
+/** Describe a field of the records
+  * \param eType    [input]: the type of the field
+  * \param uiOffset [input]: the offset of the field in the record, in bytes
+  * \param uiSize   [input]: the size of a WX_FIELD_TEXT field, in bytes. The text ends at the 1st
+  *                          null byte. Ignored for other types
+  * \param sName    [input]: the name of the field
+  * \return the index of the new field. size_t(-1) if the file is not a records file,
+  *         or if the field does not fit in the record
+  */
+size_t wxVirtualMappedFileListModel::AddRecordField(EFieldType eType, size_t uiOffset, size_t uiSize,
+                                                    const wxString &sName)
+{
+    if (m_eFormat != WX_FORMAT_RECORDS) return(size_t(-1));
+
+    switch(eType)
+    {
+        case WX_FIELD_INT8      :
+        case WX_FIELD_UINT8     : uiSize = 1; break;
+        case WX_FIELD_INT16     :
+        case WX_FIELD_UINT16    : uiSize = 2; break;
+        case WX_FIELD_INT32     :
+        case WX_FIELD_UINT32    :
+        case WX_FIELD_FLOAT     : uiSize = 4; break;
+        case WX_FIELD_INT64     :
+        case WX_FIELD_UINT64    :
+        case WX_FIELD_DOUBLE    : uiSize = 8; break;
+        default                 : break;
+    }
+    if ((uiOffset > m_uiRecordSize) || (uiSize > m_uiRecordSize - uiOffset)) return(size_t(-1));
+
+    TField oField;
+    oField.m_eType    = eType;
+    oField.m_uiOffset = uiOffset;
+    oField.m_uiSize   = uiSize;
+    oField.m_sName    = sName;
+    m_vFields.push_back(oField);
+    m_DecodedRows.ClearCache();
+    return(m_vFields.size() - 1);
+}
+
+/** Get the amount of fields
+  * \return the amount of fields
+  */
+size_t wxVirtualMappedFileListModel::GetColumnCount(void) const
+{
+    return(m_vFields.size());
+}
+
+/** Get the name of a field
+  * \param uiField [input]: the index of the field
+  * \return the name of the field (from the header line of a delimited file)
+  */
+wxString wxVirtualMappedFileListModel::GetColumnName(size_t uiField) const
+{
+    if (uiField >= m_vFields.size()) return(wxEmptyString);
+    return(m_vFields[uiField].m_sName);
+}
+
+/** Set the name of a field
+  * \param uiField [input]: the index of the field
+  * \param sName   [input]: the new name of the field
+  */
+void wxVirtualMappedFileListModel::SetColumnName(size_t uiField, const wxString &sName)
+{
+    if (uiField >= m_vFields.size()) return;
+    m_vFields[uiField].m_sName = sName;
+}
+
+/** Get the type of a field
+  * \param uiField [input]: the index of the field
+  * \return the type of the field
+  */
+wxVirtualMappedFileListModel::EFieldType wxVirtualMappedFileListModel::GetFieldType(size_t uiField) const
+{
+    if (uiField >= m_vFields.size()) return(WX_FIELD_TEXT);
+    return(m_vFields[uiField].m_eType);
+}
+
+/** Set the type of a field of a delimited file
+  * The text of the field is converted to a number when it is read. Texts which cannot be converted
+  * are returned unchanged
+  * \param uiField [input]: the index of the field
+  * \param eType   [input]: the new type of the field
+  */
+void wxVirtualMappedFileListModel::SetFieldType(size_t uiField, EFieldType eType)
+{
+    if ((m_eFormat != WX_FORMAT_DELIMITED) || (uiField >= m_vFields.size())) return;
+    m_vFields[uiField].m_eType = eType;
+}
+
+//---------------------------- INDEXING -----------------------------//
+/** Check if the background indexing is running
+  * \return true if the file is not completely indexed yet
+  */
+bool wxVirtualMappedFileListModel::IsIndexing(void) const
+{
+    WX_VDV_LOCK_INDEX();
+    return(m_bIndexing);
+}
+
+/** Get the fraction of the file already indexed
+  * \return the fraction of the file already indexed, between 0 and 1
+  */
+double wxVirtualMappedFileListModel::GetIndexingProgress(void) const
+{
+    wxUint64 uiSize = m_File.GetSize();
+    if (uiSize == 0) return(1.0);
+
+    WX_VDV_LOCK_INDEX();
+    return(double(m_uiIndexEnd) / double(uiSize));
+}
+
+/** Wait until the whole file is indexed
+  * The new row count is published to the GUI
+  */
+void wxVirtualMappedFileListModel::WaitForIndex(void)
+{
+#if wxUSE_THREADS
+    if (m_pIndexer) m_pIndexer->Wait();
+#endif // wxUSE_THREADS
+    PublishRowCount();
+}
+
+/** Check if the indexing stopped on an error
+  * The indexing stops when a block of WX_VDV_MAPPED_FILE_BLOCK_ROWS lines is larger than 4 GB.
+  * The rows indexed before the error are available
+  * \return true if the indexing stopped on an error
+  */
+bool wxVirtualMappedFileListModel::HasIndexError(void) const
+{
+    WX_VDV_LOCK_INDEX();
+    return(m_bIndexError);
+}
+
+//----------------------- DECODED ROWS CACHE ------------------------//
+/** Set the maximal amount of decoded rows in the cache
+  * \param uiRows [input]: the maximal amount of decoded rows in the cache
+  */
+void wxVirtualMappedFileListModel::SetCacheSize(size_t uiRows)
+{
+    m_DecodedRows.SetCacheSize(uiRows);
+}
+
+/** Get the maximal amount of decoded rows in the cache
+  * \return the maximal amount of decoded rows in the cache
+  */
+size_t wxVirtualMappedFileListModel::GetCacheSize(void) const
+{
+    return(m_DecodedRows.GetCacheSize());
+}
+
+/** Set the maximal amount of bytes used by the cache
+  * \param uiBytes [input]: the maximal amount of bytes used by the cache
+  */
+void wxVirtualMappedFileListModel::SetCacheMemoryLimit(size_t uiBytes)
+{
+    m_DecodedRows.SetMemoryLimit(uiBytes);
+}
+
+/** Get the maximal amount of bytes used by the cache
+  * \return the maximal amount of bytes used by the cache
+  */
+size_t wxVirtualMappedFileListModel::GetCacheMemoryLimit(void) const
+{
+    return(m_DecodedRows.GetMemoryLimit());
+}
+
+/** Clear the decoded rows cache
+  */
+void wxVirtualMappedFileListModel::ClearCache(void)
+{
+    m_DecodedRows.ClearCache();
+}
+
+//--------------- WXVIRTUALILISTDATAMODEL INTERFACE -----------------//
+/** Get amount of items
+  * \return the amount of rows published to the GUI
+  */
+size_t wxVirtualMappedFileListModel::GetItemCount(void)
+{
+    return(m_uiRowCount);
+}
+
+/** Get the amount of fields in the item
+  * \param rID [input]: the item to query
+  * \return the amount of fields
+  */
+size_t wxVirtualMappedFileListModel::GetFieldCount(const wxVirtualItemID &rID)
+{
+    return(m_vFields.size());
+}
+
+/** Get the item data
+  * \param uiItemID [input]: the row index of the item
+  * \param uiField  [input]: the field index
+  * \param eType    [input]: the kind of data to get. Only WX_ITEM_MAIN_DATA is available
+  * \return the data of the item
+  */
+wxVariant wxVirtualMappedFileListModel::GetListItemData(size_t uiItemID, size_t uiField, EDataType eType)
+{
+    wxVirtualValue oValue;
+    GetListItemValue(oValue, uiItemID, uiField, eType);
+    return(oValue.ToVariant());
+}
+
+/** Get the item data without allocation
+  * Text values are copied: the decoded row may be evicted from the cache (or m_vLastRow reused)
+  * by the next read, and callers like Compare() hold 2 values at once. Only GetListItemDataBatch()
+  * returns references, to the rows it keeps in m_vBatchRows
+  * \param rValue   [output]: the data of the item
+  * \param uiItemID [input] : the row index of the item
+  * \param uiField  [input] : the field index
+  * \param eType    [input] : the kind of data to get. Only WX_ITEM_MAIN_DATA is available
+  */
+void wxVirtualMappedFileListModel::GetListItemValue(wxVirtualValue &rValue, size_t uiItemID,
+                                                    size_t uiField, EDataType eType)
+{
+    if ((eType != WX_ITEM_MAIN_DATA) || (uiField >= m_vFields.size()) || (uiItemID >= m_uiRowCount))
+    {
+        rValue.SetNull();
+        return;
+    }
+
+    const TDecodedRow *pDecoded = WX_VDV_NULL_PTR;
+    if (NeedsDecoding(uiField)) pDecoded = GetDecodedRow(uiItemID);
+    GetFieldValue(rValue, pDecoded, uiItemID, uiField);
+
+    //the referenced string belongs to the decoded rows cache : copy it
+    if (rValue.GetType() == wxVirtualValue::WX_VALUE_STRING)
+    {
+        rValue.SetVariant(wxVariant(rValue.GetStringRef()));
+    }
+}
+
+/** Get the data of several rows & fields at once
+  * The rows are decoded once for all the fields, without going through the decoded rows cache
+  * (scanning many rows would evict the visible rows). Text values stay valid until the next call
+  * \param vValues [output]: the values, row by row. vValues[i * vFields.size() + j] is the value
+  *                          of the field vFields[j] of the row vRows[i]
+  * \param vRows   [input] : the row indices to query. size_t(-1) for an invalid item (null values)
+  * \param vFields [input] : the fields to query
+  * \param eType   [input] : the kind of data to get. Only WX_ITEM_MAIN_DATA is available
+  */
+void wxVirtualMappedFileListModel::GetListItemDataBatch(wxVirtualValues &vValues, const TRowIndices &vRows,
+                                                        const TFieldIDs &vFields, EDataType eType)
+{
+    size_t uiNbRows   = vRows.size();
+    size_t uiNbFields = vFields.size();
+    vValues.resize(uiNbRows * uiNbFields);
+
+    size_t i, j;
+    bool bDecode = false;
+    for(j = 0; j < uiNbFields; j++)
+    {
+        if ((vFields[j] < m_vFields.size()) && (NeedsDecoding(vFields[j]))) bDecode = true;
+    }
+    if (bDecode) m_vBatchRows.resize(uiNbRows);
+
+    wxVirtualValue *pValue = vValues.empty() ? WX_VDV_NULL_PTR : &vValues[0];
+    for(i = 0; i < uiNbRows; i++)
+    {
+        size_t uiRow = vRows[i];
+        bool bValidRow = ((eType == WX_ITEM_MAIN_DATA) && (uiRow < m_uiRowCount));
+
+        const TDecodedRow *pDecoded = WX_VDV_NULL_PTR;
+        if ((bValidRow) && (bDecode))
+        {
+            DecodeRow(m_vBatchRows[i], uiRow);
+            pDecoded = &m_vBatchRows[i];
+        }
+
+        for(j = 0; j < uiNbFields; j++)
+        {
+            size_t uiField = vFields[j];
+            if ((bValidRow) && (uiField < m_vFields.size())) GetFieldValue(*pValue, pDecoded, uiRow, uiField);
+            else                                             pValue->SetNull();
+            pValue++;
+        }
+    }
+}
+
+/** Get the item flags
+  * \param uiItemID [input]: the row index of the item
+  * \param uiField  [input]: the field index
+  * \return the flags of the item. The file is read-only: the items are not editable
+  */
+wxVirtualIDataModel::EFlags wxVirtualMappedFileListModel::GetListItemFlags(size_t uiItemID, size_t uiField)
+{
+    int iFlags = WX_ITEM_FLAGS_ALL & (~WX_ITEM_FLAGS_EDITABLE);
+    return((EFlags) iFlags);
+}
+
+/** Check if Compare() is reimplemented for a field
+  * \param uiField [input]: the field to check
+  * \return false : the default comparison is used, the fields can be sorted with typed keys
+  */
+bool wxVirtualMappedFileListModel::HasCustomCompare(size_t uiField)
+{
+    return(false);
+}
+
+//--------------------- INTERNAL METHODS : INDEXING -----------------//
+/** Index the lines of a delimited file
+  * The rows are appended to the line index by batches
+  * \param uiStart   [input]: offset of the 1st line to index
+  * \param uiMaxRows [input]: maximal amount of lines to index
+  * \param pIndexer  [input]: the indexing thread, which is notified after each batch & can be
+  *                           cancelled. NULL if called from the GUI thread
+  * \return the offset of the 1st line not indexed
+  */
+wxUint64 wxVirtualMappedFileListModel::IndexLines(wxUint64 uiStart, size_t uiMaxRows,
+                                                  wxVirtualMappedFileIndexer *pIndexer)
+{
+    const char *pData = m_File.GetData();
+    wxUint64 uiSize   = m_File.GetSize();
+    wxUint64 uiLine   = uiStart;
+    size_t   uiRows   = 0;
+
+    wxVector<wxUint64> vStarts;
+    vStarts.reserve(s_uiIndexerBatchRows);
+#if wxUSE_THREADS
+    wxStopWatch oWatch;
+#endif // wxUSE_THREADS
+
+    while ((uiLine < uiSize) && (uiRows < uiMaxRows))
+    {
+        const char *pNewLine = (const char *) memchr(pData + uiLine, '\n', size_t(uiSize - uiLine));
+        if (!pNewLine) break;
+
+        vStarts.push_back(uiLine);
+        uiRows++;
+        uiLine = (pNewLine - pData) + 1;
+
+        if (vStarts.size() < s_uiIndexerBatchRows) continue;
+        if (!AppendRowStarts(vStarts, uiLine, false)) return(uiLine);
+        vStarts.clear();
+
+#if wxUSE_THREADS
+        if (!pIndexer) continue;
+        if (pIndexer->TestDestroy()) return(uiLine);
+        if (oWatch.Time() >= s_lNotificationDelay)
+        {
+            pIndexer->Notify();
+            oWatch.Start();
+        }
+#endif // wxUSE_THREADS
+    }
+
+    //the last line may not end with a line break
+    bool bFinished = (uiRows < uiMaxRows) || (uiLine >= uiSize);
+    if ((bFinished) && (uiLine < uiSize))
+    {
+        vStarts.push_back(uiLine);
+        uiLine = uiSize;
+    }
+
+    AppendRowStarts(vStarts, uiLine, bFinished);
+    return(uiLine);
+}
+
+/** Append rows to the line index
+  * \param vStarts   [input]: the offsets of the new rows
+  * \param uiEnd     [input]: the end of the last new row
+  * \param bFinished [input]: true if the whole file is indexed
+  * \return true on success, false if the indexing must stop (a block of rows is too large)
+  */
+bool wxVirtualMappedFileListModel::AppendRowStarts(const wxVector<wxUint64> &vStarts, wxUint64 uiEnd,
+                                                   bool bFinished)
+{
+    WX_VDV_LOCK_INDEX();
+
+    size_t i, uiSize;
+    uiSize = vStarts.size();
+    for(i = 0; i < uiSize; i++)
+    {
+        wxUint64 uiStart = vStarts[i];
+        if ((m_vRowOffsets.size() % WX_VDV_MAPPED_FILE_BLOCK_ROWS) == 0) m_vBlockStarts.push_back(uiStart);
+
+        wxUint64 uiOffset = uiStart - m_vBlockStarts.back();
+        if (uiOffset > 0xFFFFFFFFu)
+        {
+            m_uiIndexEnd  = uiStart;
+            m_bIndexError = true;
+            m_bIndexing   = false;
+            return(false);
+        }
+        m_vRowOffsets.push_back(wxUint32(uiOffset));
+    }
+
+    m_uiIndexEnd = uiEnd;
+    if (bFinished) m_bIndexing = false;
+    return(true);
+}
+
+/** Get the amount of rows in the line index
+  * \return the amount of rows indexed so far. It can be larger than GetItemCount()
+  */
+size_t wxVirtualMappedFileListModel::GetIndexedRowCount(void) const
+{
+    WX_VDV_LOCK_INDEX();
+    return(m_vRowOffsets.size());
+}
+
+/** Publish the indexed rows to the GUI
+  * Called in the GUI thread. The new rows are notified with ItemsInserted()
+  */
+void wxVirtualMappedFileListModel::PublishRowCount(void)
+{
+    if (m_eFormat != WX_FORMAT_DELIMITED) return;
+
+    size_t uiRowCount;
+    bool bIndexing;
+    {
+        WX_VDV_LOCK_INDEX();
+        uiRowCount = m_vRowOffsets.size();
+        bIndexing  = m_bIndexing;
+    }
+
+#if wxUSE_THREADS
+    if ((!bIndexing) && (m_pIndexer))
+    {
+        m_pIndexer->Wait();
+        delete(m_pIndexer);
+        m_pIndexer = WX_VDV_NULL_PTR;
+    }
+#endif // wxUSE_THREADS
+
+    if (uiRowCount <= m_uiRowCount) return;
+    size_t uiFirst = m_uiRowCount;
+    m_uiRowCount = uiRowCount;
+    ItemsInserted(GetRootItem(), uiFirst, uiRowCount - uiFirst);
+}
+
+/** Stop the background indexing
+  */
+void wxVirtualMappedFileListModel::StopIndexing(void)
+{
+#if wxUSE_THREADS
+    if (!m_pIndexer) return;
+    m_pIndexer->Delete();
+    delete(m_pIndexer);
+    m_pIndexer = WX_VDV_NULL_PTR;
+#endif // wxUSE_THREADS
+}
+
+//--------------------- INTERNAL METHODS : PARSING ------------------//
+/** Get the bytes of a row
+  * \param uiRow  [input] : the row index
+  * \param pBegin [output]: the 1st byte of the row
+  * \param pEnd   [output]: the end of the row (line break excluded)
+  * \return true if the row exists, false otherwise
+  */
+bool wxVirtualMappedFileListModel::GetRowRange(size_t uiRow, const char* &pBegin, const char* &pEnd) const
+{
+    const char *pData = m_File.GetData();
+    if (!pData) return(false);
+
+    if (m_eFormat == WX_FORMAT_RECORDS)
+    {
+        wxUint64 uiStart = m_uiDataStart + wxUint64(uiRow) * m_uiRecordSize;
+        if (uiStart + m_uiRecordSize > m_File.GetSize()) return(false);
+        pBegin = pData + uiStart;
+        pEnd   = pBegin + m_uiRecordSize;
+        return(true);
+    }
+
+    wxUint64 uiStart, uiEnd;
+    {
+        WX_VDV_LOCK_INDEX();
+        size_t uiNbRows = m_vRowOffsets.size();
+        if (uiRow >= uiNbRows) return(false);
+
+        uiStart = m_vBlockStarts[uiRow / WX_VDV_MAPPED_FILE_BLOCK_ROWS] + m_vRowOffsets[uiRow];
+        if (uiRow + 1 < uiNbRows) uiEnd = m_vBlockStarts[(uiRow + 1) / WX_VDV_MAPPED_FILE_BLOCK_ROWS]
+                                        + m_vRowOffsets[uiRow + 1];
+        else                      uiEnd = m_uiIndexEnd;
+    }
+
+    pBegin = pData + uiStart;
+    pEnd   = pData + uiEnd;
+    if ((pEnd > pBegin) && (*(pEnd - 1) == '\n')) pEnd--;
+    if ((pEnd > pBegin) && (*(pEnd - 1) == '\r')) pEnd--;
+    return(true);
+}
+
+/** Split a line in fields
+  * \param vFields     [output]: the fields. Previous content is lost
+  * \param pBegin      [input] : the 1st byte of the line
+  * \param pEnd        [input] : the end of the line (line break excluded)
+  * \param uiMaxFields [input] : the amount of fields to return. Extra fields are ignored, and missing
+  *                              fields are empty. 0 for returning all the fields of the line
+  */
+void wxVirtualMappedFileListModel::SplitLine(TDecodedRow &vFields, const char *pBegin, const char *pEnd,
+                                             size_t uiMaxFields) const
+{
+    vFields.clear();
+    if (uiMaxFields > 0) vFields.reserve(uiMaxFields);
+
+    const char *p = pBegin;
+    while ((uiMaxFields == 0) || (vFields.size() < uiMaxFields))
+    {
+        if ((m_cQuote != 0) && (p < pEnd) && (*p == m_cQuote))
+        {
+            //quoted field : a doubled quote is an escaped quote
+            wxString sField;
+            p++;
+            while (p < pEnd)
+            {
+                const char *pQuote = (const char *) memchr(p, m_cQuote, pEnd - p);
+                if (!pQuote) pQuote = pEnd;
+                sField += DecodeText(p, pQuote);
+                p = pQuote;
+                if (p >= pEnd) break;
+
+                p++;
+                if ((p < pEnd) && (*p == m_cQuote))
+                {
+                    sField += wxChar(m_cQuote);
+                    p++;
+                    continue;
+                }
+                break;
+            }
+            vFields.push_back(sField);
+
+            //ignore the characters between the closing quote & the separator
+            const char *pSeparator = (const char *) memchr(p, m_cSeparator, pEnd - p);
+            if (!pSeparator) break;
+            p = pSeparator + 1;
+        }
+        else
+        {
+            const char *pSeparator = (const char *) memchr(p, m_cSeparator, pEnd - p);
+            if (!pSeparator)
+            {
+                vFields.push_back(DecodeText(p, pEnd));
+                break;
+            }
+            vFields.push_back(DecodeText(p, pSeparator));
+            p = pSeparator + 1;
+        }
+    }
+
+    if (uiMaxFields > 0) vFields.resize(uiMaxFields);
+}
+
+/** Decode the text fields of a row
+  * Delimited files : all the fields are decoded. Records : only the WX_FIELD_TEXT fields are decoded
+  * \param vFields [output]: the decoded fields. 1 item per field
+  * \param uiRow   [input] : the row index
+  */
+void wxVirtualMappedFileListModel::DecodeRow(TDecodedRow &vFields, size_t uiRow) const
+{
+    size_t uiNbFields = m_vFields.size();
+    const char *pBegin, *pEnd;
+    if (!GetRowRange(uiRow, pBegin, pEnd))
+    {
+        vFields.clear();
+        vFields.resize(uiNbFields);
+        return;
+    }
+
+    if (m_eFormat == WX_FORMAT_DELIMITED)
+    {
+        SplitLine(vFields, pBegin, pEnd, uiNbFields);
+        return;
+    }
+
+    size_t i;
+    vFields.resize(uiNbFields);
+    for(i = 0; i < uiNbFields; i++)
+    {
+        const TField &rField = m_vFields[i];
+        if (rField.m_eType != WX_FIELD_TEXT) continue;
+
+        const char *pText = pBegin + rField.m_uiOffset;
+        const char *pTextEnd = (const char *) memchr(pText, 0, rField.m_uiSize);
+        if (!pTextEnd) pTextEnd = pText + rField.m_uiSize;
+        vFields[i] = DecodeText(pText, pTextEnd);
+    }
+}
+
+/** Get the text fields of a row, using the cache
+  * \param uiRow [input]: the row index
+  * \return the decoded row
+  */
+const wxVirtualMappedFileListModel::TDecodedRow* wxVirtualMappedFileListModel::GetDecodedRow(size_t uiRow)
+{
+    TDecodedRow *pDecoded = m_DecodedRows.Find(uiRow);
+    if (pDecoded) return(pDecoded);
+
+    DecodeRow(m_vLastRow, uiRow);
+    m_DecodedRows.Insert(uiRow, m_vLastRow);
+
+    //the row may be larger than the memory limit of the cache
+    pDecoded = m_DecodedRows.Find(uiRow);
+    if (pDecoded) return(pDecoded);
+    return(&m_vLastRow);
+}
+
+/** Get the value of a field
+  * \param rValue   [output]: the value
+  * \param pDecoded [input] : the decoded row, if NeedsDecoding(uiField) is true
+  * \param uiRow    [input] : the row index
+  * \param uiField  [input] : the field index
+  */
+void wxVirtualMappedFileListModel::GetFieldValue(wxVirtualValue &rValue, const TDecodedRow *pDecoded,
+                                                 size_t uiRow, size_t uiField) const
+{
+    const TField &rField = m_vFields[uiField];
+
+    //delimited files & text fields : convert the text
+    if (NeedsDecoding(uiField))
+    {
+        if (!pDecoded)
+        {
+            rValue.SetNull();
+            return;
+        }
+
+        const wxString &rsText = (*pDecoded)[uiField];
+        if ((rField.m_eType == WX_FIELD_TEXT) || (rsText.IsEmpty()))
+        {
+            rValue.SetString(rsText);
+            return;
+        }
+
+        wxLongLong_t llValue;
+        wxULongLong_t ullValue;
+        double dValue;
+        switch(rField.m_eType)
+        {
+            case WX_FIELD_FLOAT     :
+            case WX_FIELD_DOUBLE    :
+                if (rsText.ToCDouble(&dValue)) {rValue.SetDouble(dValue); return;}
+                break;
+
+            default                 :
+                if (rsText.ToLongLong(&llValue)) {rValue.SetInt64(llValue); return;}
+                if (rsText.ToULongLong(&ullValue)) {rValue.SetInt64(wxInt64(ullValue)); return;}
+                break;
+        }
+        rValue.SetString(rsText);
+        return;
+    }
+
+    //records : read the bytes
+    const char *pBegin, *pEnd;
+    if (!GetRowRange(uiRow, pBegin, pEnd))
+    {
+        rValue.SetNull();
+        return;
+    }
+
+    const char *pField = pBegin + rField.m_uiOffset;
+    switch(rField.m_eType)
+    {
+        case WX_FIELD_INT8      : {wxInt8   v; memcpy(&v, pField, sizeof(v)); rValue.SetInt64(v);} break;
+        case WX_FIELD_INT16     : {wxInt16  v; memcpy(&v, pField, sizeof(v)); rValue.SetInt64(v);} break;
+        case WX_FIELD_INT32     : {wxInt32  v; memcpy(&v, pField, sizeof(v)); rValue.SetInt64(v);} break;
+        case WX_FIELD_INT64     : {wxInt64  v; memcpy(&v, pField, sizeof(v)); rValue.SetInt64(v);} break;
+        case WX_FIELD_UINT8     : {wxUint8  v; memcpy(&v, pField, sizeof(v)); rValue.SetInt64(v);} break;
+        case WX_FIELD_UINT16    : {wxUint16 v; memcpy(&v, pField, sizeof(v)); rValue.SetInt64(v);} break;
+        case WX_FIELD_UINT32    : {wxUint32 v; memcpy(&v, pField, sizeof(v)); rValue.SetInt64(v);} break;
+        case WX_FIELD_UINT64    : {wxUint64 v; memcpy(&v, pField, sizeof(v)); rValue.SetInt64(wxInt64(v));} break;
+        case WX_FIELD_FLOAT     : {float    v; memcpy(&v, pField, sizeof(v)); rValue.SetDouble(v);} break;
+        case WX_FIELD_DOUBLE    : {double   v; memcpy(&v, pField, sizeof(v)); rValue.SetDouble(v);} break;
+        default                 : rValue.SetNull(); break;
+    }
+}
+
+/** Check if a field is read from the decoded text fields
+  * \param uiField [input]: the field index
+  * \return true for all the fields of a delimited file, and for the text fields of a records file
+  */
+bool wxVirtualMappedFileListModel::NeedsDecoding(size_t uiField) const
+{
+    if (m_eFormat == WX_FORMAT_DELIMITED) return(true);
+    return(m_vFields[uiField].m_eType == WX_FIELD_TEXT);
+}
+
+/** Reset all the file data
+  */
+void wxVirtualMappedFileListModel::ResetFile(void)
+{
+    m_eFormat       = WX_FORMAT_NONE;
+    m_uiRowCount    = 0;
+    m_uiDataStart   = 0;
+    m_uiRecordSize  = 0;
+    m_uiIndexEnd    = 0;
+    m_bIndexError   = false;
+    m_bIndexing     = false;
+    m_vFields.clear();
+    m_vBlockStarts.clear();
+    m_vRowOffsets.clear();
+    m_DecodedRows.ClearCache();
+    m_vBatchRows.clear();
+    m_vLastRow.clear();
+}
@@ -0,0 +1,723 @@
+/**********************************************************************/
+/** FILE    : VirtualPagingDataModel.cpp                             **/
+/** PROJECT : wxVirtualDataViewCtrl                                  **/
+/** LICENSE : wxWindows Library Licence                              **/
+/** PURPOSE : proxy data model loading a list by pages, with prefetch**/
+/**********************************************************************/
+
+#include <wx/VirtualDataView/Models/VirtualPagingDataModel.h>
+#include <wx/VirtualDataView/Models/VirtualIListDataModel.h>
+#include <wx/VirtualDataView/Types/VirtualValue.h>
+
+#if wxUSE_THREADS
+//------------------------------ WORKER -----------------------------//
+/** \class wxVirtualPagingWorker : loads the requested pages in the background
+  */
+class wxVirtualPagingWorker : public wxThread
+{
+    public:
+        //constructor
+        wxVirtualPagingWorker(wxVirtualPagingDataModel *pModel)
+            : wxThread(wxTHREAD_JOINABLE),
+              m_pModel(pModel)
+        {}
+
+    protected:
+        //data
+        wxVirtualPagingDataModel*   m_pModel;                       ///< \brief the model owning the thread
+
+        /** Thread entry point : load the requested pages until the model stops the thread
+          */
+        virtual ExitCode Entry(void)
+        {
+            wxVirtualPagingDataModel::TPageRequest oRequest;
+            size_t uiGeneration;
+            while (m_pModel->PopRequest(oRequest, uiGeneration))
+            {
+                wxVirtualPagingDataModel::TPage *pPage = new wxVirtualPagingDataModel::TPage;
+                m_pModel->LoadPage(*pPage, oRequest);
+                m_pModel->PushPage(oRequest, uiGeneration, pPage);
+            }
+            return(0);
+        }
+};
+
+/** Lock the requests & the loaded pages in the current scope
+  */
+#define WX_VDV_LOCK_PAGES()     wxMutexLocker oPagesLocker(m_Mutex)
+#else
+#define WX_VDV_LOCK_PAGES()
+#endif // wxUSE_THREADS
+
+//----------------------- CONSTRUCTORS & DESTRUCTOR -----------------//
+/** Constructor
+  * \param pPolicy [input]: the prefetch policy. The model takes ownership of it.
+  *                         NULL for a default wxVirtualPrefetchPolicy
+  */
+wxVirtualPagingDataModel::wxVirtualPagingDataModel(wxVirtualPrefetchPolicy *pPolicy)
+    : wxVirtualIProxyDataModel(),
+      m_pPolicy(pPolicy),
+      m_uiPageSize(0),
+      m_Pages(WX_VDV_PAGING_DEFAULT_CACHED_PAGES),
+      m_uiPageMisses(0),
+      m_uiPrefetched(0),
+      m_uiNextRequest(0),
+      m_uiGeneration(0),
+      m_bStop(false),
+      m_pWorker(WX_VDV_NULL_PTR)
+#if wxUSE_THREADS
+      , m_Mutex(),
+      m_Condition(m_Mutex)
+#endif // wxUSE_THREADS
+{
+    if (!m_pPolicy) m_pPolicy = new wxVirtualPrefetchPolicy;
+    m_uiPageSize = m_pPolicy->GetPageSize();
+}
+
+/** Destructor
+  */
+wxVirtualPagingDataModel::~wxVirtualPagingDataModel(void)
+{
+    StopPrefetching();
+    CancelLoading();
+    if (m_pPolicy) delete(m_pPolicy);
+    m_pPolicy = WX_VDV_NULL_PTR;
+}
+
+//-------------------------- PREFETCH POLICY ------------------------//
+/** Get the prefetch policy
+  * \return the prefetch policy. Changing its page size clears the cache
+  */
+wxVirtualPrefetchPolicy* wxVirtualPagingDataModel::GetPrefetchPolicy(void)
+{
+    return(m_pPolicy);
+}
+
+/** Set the prefetch policy, and takes ownership on it
+  * \param pPolicy [input]: the new prefetch policy. NULL for a default wxVirtualPrefetchPolicy
+  *                         The previous policy is deleted, and the cache is cleared
+  */
+void wxVirtualPagingDataModel::SetPrefetchPolicy(wxVirtualPrefetchPolicy *pPolicy)
+{
+    if (pPolicy == m_pPolicy) return;
+    StopPrefetching();
+    if (m_pPolicy) delete(m_pPolicy);
+    m_pPolicy = pPolicy;
+    if (!m_pPolicy) m_pPolicy = new wxVirtualPrefetchPolicy;
+
+    ResetPages();
+    m_uiPageSize = m_pPolicy->GetPageSize();
+}
+
+/** Cancel the prefetching and stop the background thread
+  * Wait until the page being loaded is finished. The thread is started again on the next hint
+  */
+void wxVirtualPagingDataModel::StopPrefetching(void)
+{
+#if wxUSE_THREADS
+    if (!m_pWorker) return;
+
+    {
+        WX_VDV_LOCK_PAGES();
+        m_vRequests.clear();
+        m_uiNextRequest = 0;
+        m_bStop = true;
+        m_Condition.Broadcast();
+    }
+
+    m_pWorker->Wait();
+    delete(m_pWorker);
+    m_pWorker = WX_VDV_NULL_PTR;
+
+    WX_VDV_LOCK_PAGES();
+    m_bStop = false;
+#endif // wxUSE_THREADS
+}
+
+//------------------------------ CACHE ------------------------------//
+/** Get the maximal amount of cached pages
+  * \return the maximal amount of pages in the cache
+  */
+size_t wxVirtualPagingDataModel::GetCachedPageCount(void) const
+{
+    return(m_Pages.GetCacheSize());
+}
+
+/** Set the maximal amount of cached pages
+  * \param uiPages [input]: the maximal amount of pages in the cache. Should be larger than the
+  *                         amount of pages requested by the prefetch policy for 1 hint
+  */
+void wxVirtualPagingDataModel::SetCachedPageCount(size_t uiPages)
+{
+    if (uiPages == 0) uiPages = 1;
+    m_Pages.SetCacheSize(uiPages);
+}
+
+/** Clear the cached pages
+  * The pages are loaded again when they are needed. No notification is sent
+  */
+void wxVirtualPagingDataModel::ClearCache(void)
+{
+    ResetPages();
+}
+
+/** Check if a page is in the cache
+  * \param uiPage [input]: the index of the page
+  * \return true if the page is in the cache. The pages loaded by the background thread are
+  *         stored in the cache on the next access
+  */
+bool wxVirtualPagingDataModel::IsPageCached(size_t uiPage) const
+{
+    return(m_Pages.HasKey(uiPage));
+}
+
+/** Get the amount of pages loaded ahead of time
+  * \return the amount of pages loaded by the prefetching
+  */
+size_t wxVirtualPagingDataModel::GetPrefetchedPageCount(void) const
+{
+    return(m_uiPrefetched);
+}
+
+/** Get the amount of pages loaded on demand
+  * \return the amount of pages which were not prefetched, and were loaded when a row was displayed
+  */
+size_t wxVirtualPagingDataModel::GetPageMisses(void) const
+{
+    return(m_uiPageMisses);
+}
+
+//--------------------------- PAGES ---------------------------------//
+/** Get the bottom list model, if the paging is possible
+  * \return the bottom model if it is a list model, NULL otherwise
+  */
+wxVirtualIListDataModel* wxVirtualPagingDataModel::GetListModel(void)
+{
+    if (!m_pDataModel) return(WX_VDV_NULL_PTR);
+    wxVirtualIDataModel *pBottomModel = GetBottomModel();
+    if (!pBottomModel) return(WX_VDV_NULL_PTR);
+    return(pBottomModel->AsListModel());
+}
+
+/** Get the bottom list model, if the paging is enabled
+  * \return the bottom model if it is a list model, and if no parent model reorders the rows.
+  *         NULL otherwise: the values must be read from the master model
+  */
+wxVirtualIListDataModel* wxVirtualPagingDataModel::GetPagedListModel(void)
+{
+    if (HasReorderingParent()) return(WX_VDV_NULL_PTR);
+    return(GetListModel());
+}
+
+/** Check if a parent model sorts or filters the rows
+  * \return true if one of the parent models is a reordering proxy (IsReorderingProxy()):
+  *         the view order is not the order of the pages
+  */
+bool wxVirtualPagingDataModel::HasReorderingParent(void)
+{
+    wxVirtualIDataModel *pParentModel = m_pParentModel;
+    while (pParentModel)
+    {
+        if (pParentModel->IsReorderingProxy()) return(true);
+        pParentModel = pParentModel->GetParentModel();
+    }
+    return(false);
+}
+
+/** Reset the cache if the page size of the policy changed
+  */
+void wxVirtualPagingDataModel::CheckPageSize(void)
+{
+    if (m_pPolicy->GetPageSize() == m_uiPageSize) return;
+    StopPrefetching();
+    ResetPages();
+    m_uiPageSize = m_pPolicy->GetPageSize();
+}
+
+/** Describe the rows of a page
+  * \param rRequest   [output]: the description of the page
+  * \param pListModel [input] : the bottom list model
+  * \param uiPage     [input] : the index of the page
+  * \return true if the page contains rows, false otherwise
+  */
+bool wxVirtualPagingDataModel::MakeRequest(TPageRequest &rRequest, wxVirtualIListDataModel *pListModel,
+                                           size_t uiPage)
+{
+    size_t uiNbRows = pListModel->GetItemCount();
+    size_t uiFirstRow = uiPage * m_uiPageSize;
+    if (uiFirstRow >= uiNbRows) return(false);
+
+    rRequest.m_uiPage       = uiPage;
+    rRequest.m_uiFirstRow   = uiFirstRow;
+    rRequest.m_uiNbRows     = uiNbRows - uiFirstRow;
+    if (rRequest.m_uiNbRows > m_uiPageSize) rRequest.m_uiNbRows = m_uiPageSize;
+    rRequest.m_uiNbFields   = m_pDataModel->GetFieldCount(pListModel->GetItemID(uiFirstRow));
+    rRequest.m_pListModel   = pListModel;
+    return(true);
+}
+
+/** Read the values of a page from the master model
+  * Called from the GUI thread and from the background thread
+  * \param rPage    [output]: the page
+  * \param rRequest [input] : the description of the page
+  */
+void wxVirtualPagingDataModel::LoadPage(TPage &rPage, const TPageRequest &rRequest)
+{
+    rPage.m_uiNbRows   = rRequest.m_uiNbRows;
+    rPage.m_uiNbFields = rRequest.m_uiNbFields;
+    rPage.m_vValues.clear();
+    if ((rRequest.m_uiNbRows == 0) || (rRequest.m_uiNbFields == 0)) return;
+
+    size_t i;
+    wxVirtualItemIDs vIDs;
+    vIDs.reserve(rRequest.m_uiNbRows);
+    for(i = 0; i < rRequest.m_uiNbRows; i++)
+    {
+        vIDs.push_back(rRequest.m_pListModel->GetItemID(rRequest.m_uiFirstRow + i));
+    }
+
+    TFieldIDs vFields;
+    vFields.reserve(rRequest.m_uiNbFields);
+    for(i = 0; i < rRequest.m_uiNbFields; i++) vFields.push_back(i);
+
+    //1 ranged request
+    m_pDataModel->GetItemDataBatch(rPage.m_vValues, vIDs, vFields, WX_ITEM_MAIN_DATA);
+
+    //the strings referenced by the values are owned by the master model : copy them
+    size_t uiSize = rPage.m_vValues.size();
+    for(i = 0; i < uiSize; i++)
+    {
+        wxVirtualValue &rValue = rPage.m_vValues[i];
+        if (rValue.GetType() == wxVirtualValue::WX_VALUE_STRING)
+        {
+            rValue.SetVariant(wxVariant(rValue.GetStringRef()));
+        }
+    }
+}
+
+/** Store a page in the cache
+  * \param uiPage [input]: the index of the page
+  * \param rPage  [input]: the page
+  */
+void wxVirtualPagingDataModel::StorePage(size_t uiPage, const TPage &rPage)
+{
+    m_Pages.Insert(uiPage, rPage);
+}
+
+/** Store the pages loaded by the background thread in the cache
+  */
+void wxVirtualPagingDataModel::StoreLoadedPages(void)
+{
+#if wxUSE_THREADS
+    wxVector<TLoadedPage> vLoaded;
+    size_t uiGeneration;
+    {
+        WX_VDV_LOCK_PAGES();
+        if (m_vLoaded.empty()) return;
+        vLoaded.swap(m_vLoaded);
+        uiGeneration = m_uiGeneration;
+    }
+
+    size_t i, uiSize;
+    uiSize = vLoaded.size();
+    for(i = 0; i < uiSize; i++)
+    {
+        TLoadedPage &rLoaded = vLoaded[i];
+        if (rLoaded.m_uiGeneration == uiGeneration)
+        {
+            StorePage(rLoaded.m_uiPage, *rLoaded.m_pPage);
+            m_uiPrefetched++;
+        }
+        delete(rLoaded.m_pPage);
+    }
+#endif // wxUSE_THREADS
+}
+
+/** Get the page of a row, loading it if needed
+  * \param pListModel [input]: the bottom list model
+  * \param uiRow      [input]: the row
+  * \return the page containing the row. NULL if the row does not exist
+  */
+wxVirtualPagingDataModel::TPage* wxVirtualPagingDataModel::FindPage(wxVirtualIListDataModel *pListModel,
+                                                                    size_t uiRow)
+{
+    size_t uiPage   = uiRow / m_uiPageSize;
+    size_t uiOffset = uiRow - uiPage * m_uiPageSize;
+
+    //in the cache. The last page may have been loaded before rows were appended
+    TPage *pPage = m_Pages.Find(uiPage);
+    if ((pPage) && (uiOffset < pPage->m_uiNbRows)) return(pPage);
+
+    //loaded by the background thread
+    StoreLoadedPages();
+    pPage = m_Pages.Find(uiPage);
+    if ((pPage) && (uiOffset < pPage->m_uiNbRows)) return(pPage);
+
+    //load it now
+    TPageRequest oRequest;
+    if (!MakeRequest(oRequest, pListModel, uiPage)) return(WX_VDV_NULL_PTR);
+
+    TPage oPage;
+    LoadPage(oPage, oRequest);
+    StorePage(uiPage, oPage);
+    m_uiPageMisses++;
+
+    pPage = m_Pages.Find(uiPage);
+    if ((pPage) && (uiOffset < pPage->m_uiNbRows)) return(pPage);
+    return(WX_VDV_NULL_PTR);
+}
+
+/** Get a value from its page
+  * \param rValue  [output]: the value
+  * \param rID     [input] : the item
+  * \param uiField [input] : the field
+  * \return true if the value was found in a page, false if the master model must be queried
+  */
+bool wxVirtualPagingDataModel::FindValue(wxVirtualValue &rValue, const wxVirtualItemID &rID,
+                                         size_t uiField)
+{
+    if ((!rID.IsOK()) || (rID.IsRootItem())) return(false);
+    wxVirtualIListDataModel *pListModel = GetPagedListModel();
+    if (!pListModel) return(false);
+
+    CheckPageSize();
+    size_t uiRow = pListModel->GetRowIndex(rID);
+    if (uiRow >= pListModel->GetItemCount()) return(false);
+
+    TPage *pPage = FindPage(pListModel, uiRow);
+    if (!pPage) return(false);
+    if (uiField >= pPage->m_uiNbFields) return(false);
+
+    size_t uiOffset = uiRow - (uiRow / m_uiPageSize) * m_uiPageSize;
+    rValue = pPage->m_vValues[uiOffset * pPage->m_uiNbFields + uiField];
+    return(true);
+}
+
+//------------------------- BACKGROUND LOADING ----------------------//
+/** Start the background thread if needed
+  * \return true if the background thread is running, false if the pages must be loaded in the GUI thread
+  */
+bool wxVirtualPagingDataModel::StartWorker(void)
+{
+#if wxUSE_THREADS
+    if (m_pWorker) return(true);
+    if (!m_pDataModel) return(false);
+    if (!m_pDataModel->IsThreadSafe()) return(false);
+
+    wxVirtualPagingWorker *pWorker = new wxVirtualPagingWorker(this);
+    if ((pWorker->Create() != wxTHREAD_NO_ERROR) || (pWorker->Run() != wxTHREAD_NO_ERROR))
+    {
+        delete(pWorker);
+        return(false);
+    }
+    m_pWorker = pWorker;
+    return(true);
+#else
+    return(false);
+#endif // wxUSE_THREADS
+}
+
+/** Get the next page to load (background thread)
+  * Block until a page is requested, or until the thread is stopped
+  * \param rRequest     [output]: the page to load
+  * \param uiGeneration [output]: the generation of the cache
+  * \return true if a page was returned, false if the thread must exit
+  */
+bool wxVirtualPagingDataModel::PopRequest(TPageRequest &rRequest, size_t &uiGeneration)
+{
+#if wxUSE_THREADS
+    WX_VDV_LOCK_PAGES();
+    while ((!m_bStop) && (m_uiNextRequest >= m_vRequests.size())) m_Condition.Wait();
+    if (m_bStop) return(false);
+
+    rRequest = m_vRequests[m_uiNextRequest];
+    m_uiNextRequest++;
+    uiGeneration = m_uiGeneration;
+    return(true);
+#else
+    return(false);
+#endif // wxUSE_THREADS
+}
+
+/** Store a loaded page (background thread)
+  * \param rRequest     [input]: the loaded page
+  * \param uiGeneration [input]: the generation of the cache when the page was requested
+  * \param pPage        [input]: the page. It is owned by the model
+  */
+void wxVirtualPagingDataModel::PushPage(const TPageRequest &rRequest, size_t uiGeneration, TPage *pPage)
+{
+#if wxUSE_THREADS
+    {
+        WX_VDV_LOCK_PAGES();
+        if (uiGeneration == m_uiGeneration)
+        {
+            TLoadedPage oLoaded;
+            oLoaded.m_uiPage       = rRequest.m_uiPage;
+            oLoaded.m_uiGeneration = uiGeneration;
+            oLoaded.m_pPage        = pPage;
+            m_vLoaded.push_back(oLoaded);
+            return;
+        }
+    }
+#endif // wxUSE_THREADS
+    delete(pPage);
+}
+
+/** Cancel the pages requested to the background thread
+  * The pages being loaded are discarded
+  */
+void wxVirtualPagingDataModel::CancelLoading(void)
+{
+    wxVector<TLoadedPage> vLoaded;
+    {
+        WX_VDV_LOCK_PAGES();
+        m_vRequests.clear();
+        m_uiNextRequest = 0;
+        vLoaded.swap(m_vLoaded);
+        m_uiGeneration++;
+    }
+
+    size_t i, uiSize;
+    uiSize = vLoaded.size();
+    for(i = 0; i < uiSize; i++) delete(vLoaded[i].m_pPage);
+}
+
+/** Clear the cache, and cancel the loading
+  */
+void wxVirtualPagingDataModel::ResetPages(void)
+{
+    CancelLoading();
+    m_Pages.ClearCache();
+}
+
+//-------------------------- INTERFACE : ITEM DATA ------------------//
+/** Get the item data
+  * \param rID     [input]: the ID of the item to query
+  * \param uiField [input]: the field index of the item to query
+  * \param eType   [input]: the kind of data to get
+  * \return the data of the item. The main data is read from the page of the item
+  */
+wxVariant wxVirtualPagingDataModel::GetItemData(const wxVirtualItemID &rID,
+                                                size_t uiField, EDataType eType)
+{
+    if (eType == WX_ITEM_MAIN_DATA)
+    {
+        wxVirtualValue oValue;
+        if (FindValue(oValue, rID, uiField)) return(oValue.ToVariant());
+    }
+    return(wxVirtualIProxyDataModel::GetItemData(rID, uiField, eType));
+}
+
+/** Get the item data without allocation
+  * \param rValue  [output]: the data of the item. The main data is read from the page of the item
+  * \param rID     [input] : the ID of the item to query
+  * \param uiField [input] : the field index of the item to query
+  * \param eType   [input] : the kind of data to get
+  */
+void wxVirtualPagingDataModel::GetItemValue(wxVirtualValue &rValue, const wxVirtualItemID &rID,
+                                            size_t uiField, EDataType eType)
+{
+    if ((eType == WX_ITEM_MAIN_DATA) && (FindValue(rValue, rID, uiField))) return;
+    ForwardItemValue(rValue, rID, uiField, eType);
+}
+
+/** Get the data of several items & fields at once
+  * \param vValues [output]: the values, row by row. See wxVirtualIDataModel::GetItemDataBatch()
+  * \param vIDs    [input] : the items to query
+  * \param vFields [input] : the fields to query
+  * \param eType   [input] : the kind of data to get
+  * The main data is read from the pages of the items: 1 request per missing page
+  */
+void wxVirtualPagingDataModel::GetItemDataBatch(wxVirtualValues &vValues, const wxVirtualItemIDs &vIDs,
+                                                const TFieldIDs &vFields, EDataType eType)
+{
+    if ((eType == WX_ITEM_MAIN_DATA) && (GetPagedListModel()))
+    {
+        wxVirtualIDataModel::GetItemDataBatch(vValues, vIDs, vFields, eType);
+        return;
+    }
+    ForwardItemDataBatch(vValues, vIDs, vFields, eType);
+}
+
+/** Set the item data
+  * \param rID     [input]: the ID of the item to modify
+  * \param uiField [input]: the field index of the item to modify
+  * \param vValue  [input]: the new value
+  * \param eType   [input]: the kind of data to modify
+  * \return true if the data was modified in the master model
+  */
+bool wxVirtualPagingDataModel::SetItemData(const wxVirtualItemID &rID, size_t uiField,
+                                           const wxVariant &vValue, EDataType eType)
+{
+    bool bResult = wxVirtualIProxyDataModel::SetItemData(rID, uiField, vValue, eType);
+    wxVirtualIListDataModel *pListModel = GetListModel();
+    if ((bResult) && (eType == WX_ITEM_MAIN_DATA) && (pListModel) && (!rID.IsRootItem()))
+    {
+        CancelLoading();
+        m_Pages.Remove(pListModel->GetRowIndex(rID) / m_uiPageSize);
+    }
+    return(bResult);
+}
+
+//--------------------------- MULTI-THREADING -----------------------//
+/** Check if GetItemData() & Compare() can be called from worker threads
+  * \return false : reading the values modifies the cache
+  */
+bool wxVirtualPagingDataModel::IsThreadSafe(void)
+{
+    return(false);
+}
+
+//--------------------------- VIEW HINTS ----------------------------//
+/** The rows shown by the view changed
+  * \param rHint [input]: the visible rows, and the scrolling speed & direction
+  * The missing visible pages are loaded now. The other pages chosen by the prefetch policy
+  * replace the previous requests of the background thread. If the master model is not thread
+  * safe, there is no background thread: they are not loaded (loading them in the GUI thread
+  * would block it for up to 1 page per prefetched page at each scroll step).
+  * The hint is ignored while a parent model sorts or filters the rows: the requests of the
+  * background thread are cancelled
+  */
+void wxVirtualPagingDataModel::OnViewportChanged(const wxVirtualViewportHint &rHint)
+{
+    wxVirtualIProxyDataModel::OnViewportChanged(rHint);
+
+    if (HasReorderingParent())
+    {
+        if (m_pWorker) CancelLoading();
+        return;
+    }
+
+    wxVirtualIListDataModel *pListModel = GetListModel();
+    if (!pListModel) return;
+    CheckPageSize();
+    StoreLoadedPages();
+
+    size_t uiNbRows = pListModel->GetItemCount();
+    if (uiNbRows == 0) return;
+    size_t uiFirstRow = 0;
+    if ((rHint.m_FirstItem.IsOK()) && (!rHint.m_FirstItem.IsRootItem()))
+    {
+        uiFirstRow = pListModel->GetRowIndex(rHint.m_FirstItem);
+        if (uiFirstRow >= uiNbRows) uiFirstRow = uiNbRows - 1;
+    }
+    size_t uiLastRow = uiFirstRow;
+    if (rHint.m_uiRowCount > 0) uiLastRow += rHint.m_uiRowCount - 1;
+    if (uiLastRow >= uiNbRows) uiLastRow = uiNbRows - 1;
+    size_t uiFirstVisiblePage = uiFirstRow / m_uiPageSize;
+    size_t uiLastVisiblePage  = uiLastRow / m_uiPageSize;
+
+    m_pPolicy->GetPages(m_vHintPages, uiFirstRow, uiNbRows, rHint);
+
+    //mark the pages as recently used, the most urgent last
+    size_t i = m_vHintPages.size();
+    while (i > 0)
+    {
+        i--;
+        m_Pages.Find(m_vHintPages[i]);
+    }
+
+    //visible pages now, other pages in the background
+    bool bBackground = StartWorker();
+    wxVector<TPageRequest> vRequests;
+    TPageRequest oRequest;
+    TPage oPage;
+    size_t uiPage, uiSize;
+    uiSize = m_vHintPages.size();
+    for(i = 0; i < uiSize; i++)
+    {
+        uiPage = m_vHintPages[i];
+        if (m_Pages.HasKey(uiPage)) continue;
+        if (!MakeRequest(oRequest, pListModel, uiPage)) continue;
+
+        bool bVisible = (uiPage >= uiFirstVisiblePage) && (uiPage <= uiLastVisiblePage);
+        if (!bVisible)
+        {
+            if (bBackground) vRequests.push_back(oRequest);
+            continue;
+        }
+
+        LoadPage(oPage, oRequest);
+        StorePage(uiPage, oPage);
+        m_uiPageMisses++;
+    }
+
+    if (!bBackground) return;
+
+#if wxUSE_THREADS
+    WX_VDV_LOCK_PAGES();
+    m_vRequests.swap(vRequests);
+    m_uiNextRequest = 0;
+    if (!m_vRequests.empty()) m_Condition.Signal();
+#endif // wxUSE_THREADS
+}
+
+//------------------ PARTIAL UPDATES : NOTIFICATIONS ----------------//
+/** The rows of the bottom list model were shifted
+  * \param pListModel [input]: the bottom list model
+  * \param uiFirst    [input]: the 1st inserted / removed row
+  * \param uiCount    [input]: the amount of inserted / removed rows
+  * \param bInserted  [input]: true if the rows were inserted, false if they were removed
+  * The pages of the following rows changed: the cache is cleared, unless the rows were
+  * appended at the end of the list (the last page is completed when it is read)
+  */
+void wxVirtualPagingDataModel::OnItemIDsShifted(wxVirtualIListDataModel *pListModel,
+                                                size_t uiFirst, size_t uiCount,
+                                                bool bInserted)
+{
+    if ((!bInserted) || (uiFirst + uiCount < pListModel->GetItemCount())) ResetPages();
+    wxVirtualIProxyDataModel::OnItemIDsShifted(pListModel, uiFirst, uiCount, bInserted);
+}
+
+/** Some items were removed from the master model
+  * \param rParent [input]: the parent of the removed items
+  * \param uiFirst [input]: the child index of the 1st removed item in the master model
+  * \param uiCount [input]: the amount of removed items
+  */
+void wxVirtualPagingDataModel::OnMasterItemsRemoved(const wxVirtualItemID &rParent,
+                                                    size_t uiFirst, size_t uiCount)
+{
+    ResetPages();
+    wxVirtualIProxyDataModel::OnMasterItemsRemoved(rParent, uiFirst, uiCount);
+}
+
+/** The values of some items of the master model changed
+  * \param vIDs    [input]: the items which changed
+  * \param vFields [input]: the fields which changed. Empty for all fields
+  * The pages of these items are removed from the cache, and the loading is cancelled
+  */
+void wxVirtualPagingDataModel::OnMasterItemsChanged(const wxVirtualItemIDs &vIDs,
+                                                    const TFieldIDs &vFields)
+{
+    CancelLoading();
+    wxVirtualIListDataModel *pListModel = GetListModel();
+    if (pListModel)
+    {
+        size_t i, uiSize;
+        uiSize = vIDs.size();
+        for(i = 0; i < uiSize; i++)
+        {
+            if (vIDs[i].IsRootItem()) continue;
+            m_Pages.Remove(pListModel->GetRowIndex(vIDs[i]) / m_uiPageSize);
+        }
+    }
+
+    wxVirtualIProxyDataModel::OnMasterItemsChanged(vIDs, vFields);
+}
+
+/** The children of an item of the master model changed
+  * \param rParent [input]: the item whose children changed
+  */
+void wxVirtualPagingDataModel::OnMasterChildrenReset(const wxVirtualItemID &rParent)
+{
+    ResetPages();
+    wxVirtualIProxyDataModel::OnMasterChildrenReset(rParent);
+}
+
+/** The whole master model changed
+  */
+void wxVirtualPagingDataModel::OnMasterModelReset(void)
+{
+    ResetPages();
+    wxVirtualIProxyDataModel::OnMasterModelReset();
+}
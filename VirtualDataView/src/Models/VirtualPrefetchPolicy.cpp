@@ -0,0 +1,174 @@
+/**********************************************************************/
+/** FILE    : VirtualPrefetchPolicy.cpp                              **/
+/** PROJECT : wxVirtualDataViewCtrl                                  **/
+/** LICENSE : wxWindows Library Licence                              **/
+/** PURPOSE : choose the pages of rows to load ahead of the scrolling**/
+/**********************************************************************/
+
+#include <wx/VirtualDataView/Models/VirtualPrefetchPolicy.h>
+
+//default amount of pages loaded ahead of the scrolling direction (minimum & maximum), and kept behind
+static const size_t s_uiDefaultPagesAhead       = 2;
+static const size_t s_uiDefaultMaxPagesAhead    = 32;
+static const size_t s_uiDefaultPagesBehind      = 1;
+
+//default scrolling time covered by the prefetching, in ms
+static const long s_lDefaultLookAheadTime       = 500;
+
+//----------------------- CONSTRUCTORS & DESTRUCTOR -----------------//
+/** Constructor
+  * \param uiPageSize [input]: the amount of rows per page
+  */
+wxVirtualPrefetchPolicy::wxVirtualPrefetchPolicy(size_t uiPageSize)
+    : m_uiPageSize(uiPageSize),
+      m_uiPagesAhead(s_uiDefaultPagesAhead),
+      m_uiMaxPagesAhead(s_uiDefaultMaxPagesAhead),
+      m_uiPagesBehind(s_uiDefaultPagesBehind),
+      m_lLookAheadTime(s_lDefaultLookAheadTime)
+{
+    if (m_uiPageSize == 0) m_uiPageSize = 1;
+}
+
+/** Destructor
+  */
+wxVirtualPrefetchPolicy::~wxVirtualPrefetchPolicy(void)
+{
+}
+
+//------------------------------ PAGES ------------------------------//
+/** Get the amount of rows per page
+  * \return the amount of rows per page
+  */
+size_t wxVirtualPrefetchPolicy::GetPageSize(void) const
+{
+    return(m_uiPageSize);
+}
+
+/** Set the amount of rows per page
+  * \param uiRows [input]: the amount of rows per page. The best size is the natural block of
+  *                        the data source (database page, file block, ...)
+  */
+void wxVirtualPrefetchPolicy::SetPageSize(size_t uiRows)
+{
+    if (uiRows == 0) uiRows = 1;
+    m_uiPageSize = uiRows;
+}
+
+//--------------------------- PREFETCHING ---------------------------//
+/** Get the minimal amount of pages loaded ahead
+  * \return the amount of pages loaded ahead of the scrolling direction, even without scrolling
+  */
+size_t wxVirtualPrefetchPolicy::GetPagesAhead(void) const
+{
+    return(m_uiPagesAhead);
+}
+
+/** Set the minimal amount of pages loaded ahead
+  * \param uiPages [input]: the amount of pages loaded ahead of the scrolling direction, even without scrolling
+  */
+void wxVirtualPrefetchPolicy::SetPagesAhead(size_t uiPages)
+{
+    m_uiPagesAhead = uiPages;
+    if (m_uiMaxPagesAhead < m_uiPagesAhead) m_uiMaxPagesAhead = m_uiPagesAhead;
+}
+
+/** Get the maximal amount of pages loaded ahead
+  * \return the maximal amount of pages loaded ahead of the scrolling direction
+  */
+size_t wxVirtualPrefetchPolicy::GetMaxPagesAhead(void) const
+{
+    return(m_uiMaxPagesAhead);
+}
+
+/** Set the maximal amount of pages loaded ahead
+  * \param uiPages [input]: the maximal amount of pages loaded ahead of the scrolling direction
+  */
+void wxVirtualPrefetchPolicy::SetMaxPagesAhead(size_t uiPages)
+{
+    m_uiMaxPagesAhead = uiPages;
+    if (m_uiPagesAhead > m_uiMaxPagesAhead) m_uiPagesAhead = m_uiMaxPagesAhead;
+}
+
+/** Get the amount of pages kept behind
+  * \return the amount of pages loaded behind the visible rows
+  */
+size_t wxVirtualPrefetchPolicy::GetPagesBehind(void) const
+{
+    return(m_uiPagesBehind);
+}
+
+/** Set the amount of pages kept behind
+  * \param uiPages [input]: the amount of pages loaded behind the visible rows
+  */
+void wxVirtualPrefetchPolicy::SetPagesBehind(size_t uiPages)
+{
+    m_uiPagesBehind = uiPages;
+}
+
+/** Get the scrolling time covered by the prefetching
+  * \return the time in milliseconds
+  */
+long wxVirtualPrefetchPolicy::GetLookAheadTime(void) const
+{
+    return(m_lLookAheadTime);
+}
+
+/** Set the scrolling time covered by the prefetching
+  * \param lMilliseconds [input]: at the current scrolling speed, the rows reached during this
+  *                               time are loaded ahead. Should cover the loading time of the pages
+  */
+void wxVirtualPrefetchPolicy::SetLookAheadTime(long lMilliseconds)
+{
+    if (lMilliseconds < 0) lMilliseconds = 0;
+    m_lLookAheadTime = lMilliseconds;
+}
+
+//----------------------------- INTERFACE ---------------------------//
+/** Get the pages to load, most urgent first
+  * \param vPages     [output]: the indices of the pages to load. Page i contains the rows
+  *                             [i * GetPageSize(), (i + 1) * GetPageSize()[
+  * \param uiFirstRow [input] : the 1st visible row
+  * \param uiNbRows   [input] : the amount of rows of the model
+  * \param rHint      [input] : the viewport (amount of visible rows, scrolling speed & direction)
+  */
+void wxVirtualPrefetchPolicy::GetPages(wxVector<size_t> &vPages,
+                                       size_t uiFirstRow, size_t uiNbRows,
+                                       const wxVirtualViewportHint &rHint) const
+{
+    vPages.clear();
+    if (uiNbRows == 0) return;
+    if (uiFirstRow >= uiNbRows) uiFirstRow = uiNbRows - 1;
+
+    //visible pages
+    size_t uiVisible = rHint.m_uiRowCount;
+    if (uiVisible == 0) uiVisible = 1;
+    size_t uiLastRow = uiNbRows - 1;
+    if (uiVisible - 1 < uiLastRow - uiFirstRow) uiLastRow = uiFirstRow + uiVisible - 1;
+
+    size_t uiNbPages    = (uiNbRows - 1) / m_uiPageSize + 1;
+    size_t uiFirstPage  = uiFirstRow / m_uiPageSize;
+    size_t uiLastPage   = uiLastRow / m_uiPageSize;
+    size_t uiPage;
+    for(uiPage = uiFirstPage; uiPage <= uiLastPage; uiPage++) vPages.push_back(uiPage);
+
+    //pages ahead : scrolled through during the look-ahead time
+    double dSpeed = rHint.m_dVelocity;
+    if (dSpeed < 0.0) dSpeed = -dSpeed;
+    double dPages = dSpeed * ((double) m_lLookAheadTime) / (1000.0 * ((double) m_uiPageSize));
+    size_t uiAhead = m_uiPagesAhead;
+    if (dPages >= (double) m_uiMaxPagesAhead)                   uiAhead = m_uiMaxPagesAhead;
+    else if ((dPages > 0.0) && ((size_t) dPages >= uiAhead))    uiAhead = (size_t) dPages + 1;
+
+    //scrolling up : the pages ahead are above the visible rows
+    size_t i;
+    if (rHint.m_iDirection < 0)
+    {
+        for(i = 1; (i <= uiAhead) && (i <= uiFirstPage); i++) vPages.push_back(uiFirstPage - i);
+        for(i = 1; (i <= m_uiPagesBehind) && (uiLastPage + i < uiNbPages); i++) vPages.push_back(uiLastPage + i);
+    }
+    else
+    {
+        for(i = 1; (i <= uiAhead) && (uiLastPage + i < uiNbPages); i++) vPages.push_back(uiLastPage + i);
+        for(i = 1; (i <= m_uiPagesBehind) && (i <= uiFirstPage); i++) vPages.push_back(uiFirstPage - i);
+    }
+}
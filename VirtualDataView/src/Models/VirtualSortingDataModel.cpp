@@ -6,15 +6,26 @@
 /**********************************************************************/
 
 #include <wx/VirtualDataView/Models/VirtualSortingDataModel.h>
+#include <wx/VirtualDataView/Models/VirtualIListDataModel.h>
 #include <wx/VirtualDataView/Types/VariantUtils.h>
+#include <wx/VirtualDataView/Types/VirtualValue.h>
+#include <wx/VirtualDataView/Utilities/ParallelSort.hpp>
+#include <wx/VirtualDataView/Utilities/PerfCounters.h>
+#include <wx/VirtualDataView/StateModels/VirtualIStateModel.h>
+#include <wx/VirtualDataView/StateModels/VirtualVisibleRowIndex.h>
 //#include <wx/log.h>
 
+//amount of items fetched by 1 call to GetItemDataBatch()
+static const size_t s_uiBatchSize = 1024;
+
 //--------------- CONSTRUCTORS & DESTRUCTOR -------------------------//
 /** Default constructor
   */
 wxVirtualSortingDataModel::wxVirtualSortingDataModel(void)
     : wxVirtualIArrayProxyDataModel(),
-      m_bFastSorting(true)
+      m_eSortingMode(WX_E_SORTING_FAST),
+      m_uiWorkerCount(0),
+      m_uiParallelThreshold(100000)
 {
     SetMinAmountOfChildrenForCaching(5);
     SetCacheSize(10000);
@@ -58,6 +69,13 @@ size_t wxVirtualSortingDataModel::GetChildCount(const wxVirtualItemID &rIDParent
 size_t wxVirtualSortingDataModel::GetSubTreeSize(const wxVirtualItemID &rID,
                                            wxVirtualIStateModel *pStateModel)
 {
+    //the index of visible rows is built on the top model : O(1)
+    if (pStateModel)
+    {
+        wxVirtualVisibleRowIndex *pIndex = pStateModel->GetVisibleRowIndex(this);
+        if (pIndex) return(pIndex->GetSubTreeSize(rID));
+    }
+
     //the sub tree size will not be affected by sorting, so simply forward
     //to the potentially optimized model
     return(m_pDataModel->GetSubTreeSize(rID, pStateModel));
@@ -235,6 +253,57 @@ const wxVirtualSortingDataModel::TSortFilters& wxVirtualSortingDataModel::SortFi
     return(m_vSortFilters);
 }
 
+//---------------------- SORTING ALGORITHM --------------------------//
+/** Set the sorting algorithm
+  * \param eMode [input]: the new sorting algorithm
+  */
+void wxVirtualSortingDataModel::SetSortingMode(ESortingMode eMode)
+{
+    m_eSortingMode = eMode;
+}
+
+/** Get the sorting algorithm
+  * \return the sorting algorithm
+  */
+wxVirtualSortingDataModel::ESortingMode wxVirtualSortingDataModel::GetSortingMode(void) const
+{
+    return(m_eSortingMode);
+}
+
+/** Set the amount of threads for parallel sorting
+  * \param uiWorkers [input]: the amount of threads, including the calling thread.
+  *                           0 for 1 thread per CPU (default)
+  */
+void wxVirtualSortingDataModel::SetWorkerCount(size_t uiWorkers)
+{
+    m_uiWorkerCount = uiWorkers;
+}
+
+/** Get the amount of threads for parallel sorting
+  * \return the amount of threads, including the calling thread. 0 for 1 thread per CPU
+  */
+size_t wxVirtualSortingDataModel::GetWorkerCount(void) const
+{
+    return(m_uiWorkerCount);
+}
+
+/** Set the minimal amount of items for parallel sorting
+  * \param uiThreshold [input]: below this amount of items, the fast sorting is used
+  *                             even in WX_E_SORTING_PARALLEL mode. Default to 100000
+  */
+void wxVirtualSortingDataModel::SetParallelSortingThreshold(size_t uiThreshold)
+{
+    m_uiParallelThreshold = uiThreshold;
+}
+
+/** Get the minimal amount of items for parallel sorting
+  * \return the minimal amount of items for parallel sorting
+  */
+size_t wxVirtualSortingDataModel::GetParallelSortingThreshold(void) const
+{
+    return(m_uiParallelThreshold);
+}
+
 //---------------------- SLOW SORTING (MEMORY EFFICIENT) ------------//
 class TCompareFunctor
 {
@@ -286,6 +355,34 @@ class TCompareFunctor
         wxVirtualIDataModel*                     m_pDataModel;
 };
 
+//---------------------- PARTIAL UPDATES COMPARISON -----------------//
+/** \class TInsertCompareFunctor : compare items for inserting them in sorted children
+  * Items with equal sort keys are ordered by row index in the bottom list model (if any),
+  * which is the order of the unsorted children
+  */
+class TInsertCompareFunctor
+{
+    public:
+        TInsertCompareFunctor(const wxVirtualSortingDataModel::TSortFilters &rSortFilters,
+                              wxVirtualIDataModel *pDataModel,
+                              wxVirtualIListDataModel *pListModel)
+            : m_Compare(rSortFilters, pDataModel),
+              m_pListModel(pListModel)
+        {}
+
+        bool operator()(const wxVirtualItemID &rID1, const wxVirtualItemID &rID2)
+        {
+            if (m_Compare(rID1, rID2)) return(true);
+            if (m_Compare(rID2, rID1)) return(false);
+            if (!m_pListModel) return(false);
+            return(m_pListModel->GetRowIndex(rID1) < m_pListModel->GetRowIndex(rID2));
+        }
+
+    protected:
+        TCompareFunctor             m_Compare;
+        wxVirtualIListDataModel*    m_pListModel;
+};
+
 /** Memory efficient sorting of the items
   * \param vIDs     [input / output]: on input, the array to sort
   *                                   on output, the sorted array
@@ -334,7 +431,7 @@ struct TVariant
 
     void PushBack(const wxVariant &v)
     {
-        m_Variant.push_back(GetStringValue(v));
+        m_Variant.push_back(v);
     }
 };
 
@@ -394,11 +491,86 @@ class wxComparisonFunctor
         wxVector<wxVirtualSortingDataModel::TSort>      m_SortOrder;        //sort order
 };
 
+/** \class TVariantsPermutationLess : compare 2 items by their values, for sorting a permutation
+  * Only for fields which are not reimplemented by the data model (HasCustomCompare() returns false):
+  * the default comparison of wxVirtualIDataModel does not use the data model, and the values are
+  * only read. It can be used concurrently from several threads
+  */
+class TVariantsPermutationLess
+{
+    public:
+        TVariantsPermutationLess(const std::vector<TVariant> &rVariants, wxVirtualIDataModel *pDataModel,
+                                 const wxVector<wxVirtualSortingDataModel::TSort> &rSortOrder)
+            : m_rVariants(rVariants),
+              m_pDataModel(pDataModel),
+              m_rSortOrder(rSortOrder)
+        {}
+
+        bool operator()(size_t ui1, size_t ui2) const
+        {
+            const TVariant &v1 = m_rVariants[ui1];
+            const TVariant &v2 = m_rVariants[ui2];
+            size_t i, uiSize;
+            uiSize = m_rSortOrder.size();
+            for(i=0;i<uiSize;i++)
+            {
+                int iRes = wxVirtualSortingDataModel::WX_E_EQUAL;
+                const wxVirtualSortingDataModel::TSort &rSort = m_rSortOrder[i];
+                switch(rSort.m_eSortOrder)
+                {
+                    case wxVirtualSortingDataModel::WX_E_SORT_ASCENDING  :
+                        iRes = m_pDataModel->wxVirtualIDataModel::Compare(v1.m_id, v1.m_Variant[i],
+                                                                          v2.m_id, v2.m_Variant[i],
+                                                                          rSort.m_uiSortedField);
+                        break;
+
+                    case wxVirtualSortingDataModel::WX_E_SORT_DESCENDING :
+                        iRes = m_pDataModel->wxVirtualIDataModel::Compare(v2.m_id, v2.m_Variant[i],
+                                                                          v1.m_id, v1.m_Variant[i],
+                                                                          rSort.m_uiSortedField);
+                        break;
+
+                    case wxVirtualSortingDataModel::WX_E_SORT_NOT_SORTING:
+                    default                                              : continue;
+                }
+
+                switch(iRes)
+                {
+                    case wxVirtualSortingDataModel::WX_E_LESS_THAN   : return(true);
+                    case wxVirtualSortingDataModel::WX_E_GREATER_THAN: return(false);
+                    default                                          : break;
+                }
+            }
+            return(false);
+        }
+
+    protected:
+        const std::vector<TVariant>&                        m_rVariants;        //values of the items
+        wxVirtualIDataModel*                                m_pDataModel;       //BASE data model
+        const wxVector<wxVirtualSortingDataModel::TSort>&   m_rSortOrder;       //sort order
+};
+
 /** Fast sorting of the items
   * \param vIDs     [input / output]: on input, the array to sort
   *                                   on output, the sorted array
+  * Typed keys are used if possible, the variants otherwise
   */
 void wxVirtualSortingDataModel::FastSort(wxVirtualItemIDs &vIDs)
+{
+    if (!m_pDataModel) return;
+    if (KeysSort(vIDs)) return;
+    VariantsSort(vIDs);
+}
+
+/** Sorting of the items using variants & Compare()
+  * \param vIDs      [input / output]: on input, the array to sort
+  *                                    on output, the sorted array
+  * \param uiWorkers [input]         : the amount of worker threads. If more than 1, the values are
+  *                                    read in the calling thread and compared by the workers without
+  *                                    calling the data model: the sorted fields must not have a custom
+  *                                    comparison (HasCustomCompare())
+  */
+void wxVirtualSortingDataModel::VariantsSort(wxVirtualItemIDs &vIDs, size_t uiWorkers)
 {
     if (!m_pDataModel) return;
     size_t uiSize = vIDs.size();
@@ -408,28 +580,44 @@ void wxVirtualSortingDataModel::FastSort(wxVirtualItemIDs &vIDs)
     size_t uiNbFields = m_vSortFilters.size();
     tv.Reserve(uiNbFields);
 
-    //fill the temporary array with all variants values
+    //sorted fields
+    TFieldIDs vFields;
+    vFields.reserve(uiNbFields);
+    TSortFilters::const_iterator itField    = m_vSortFilters.begin();
+    TSortFilters::const_iterator itFieldEnd = m_vSortFilters.end();
+    while(itField != itFieldEnd)
+    {
+        vFields.push_back(itField->m_uiSortedField);
+        ++itField;
+    }
+
+    //fill the temporary array with all variants values, by chunks of items
     std::vector<TVariant> vVariants;
     vVariants.reserve(uiSize);
-    for(i=0;i<uiSize;i++)
+    wxVirtualItemIDs vChunk;
+    wxVirtualValues vValues;
+    size_t uiStart, uiEnd, j, k;
+    for(uiStart = 0; uiStart < uiSize; uiStart = uiEnd)
     {
-        tv.Clear();
-        tv.m_id = vIDs[i];
-
-        TSortFilters::const_iterator it    = m_vSortFilters.begin();
-        TSortFilters::const_iterator itEnd = m_vSortFilters.end();
-        while(it != itEnd)
+        uiEnd = uiStart + s_uiBatchSize;
+        if (uiEnd > uiSize) uiEnd = uiSize;
+        vChunk.clear();
+        for(i=uiStart;i<uiEnd;i++) vChunk.push_back(vIDs[i]);
+        GetItemDataBatch(vValues, vChunk, vFields);
+
+        k = 0;
+        for(i=uiStart;i<uiEnd;i++)
         {
-            const TSort &rSort = *it;
-            size_t uiField = rSort.m_uiSortedField;
-
-            wxVariant v = GetItemData(vIDs[i], uiField);
-            tv.PushBack(v);
-
-            ++it;
+            tv.Clear();
+            tv.m_id = vIDs[i];
+            for(j=0;j<uiNbFields;j++)
+            {
+                const wxVirtualValue &rValue = vValues[k++];
+                if (rValue.IsVariant()) tv.PushBack(rValue.GetVariant());
+                else                    tv.PushBack(rValue.ToVariant());
+            }
+            vVariants.push_back(tv);
         }
-
-        vVariants.push_back(tv);
     }
 
     //initialize the comparison functor
@@ -443,6 +631,23 @@ void wxVirtualSortingDataModel::FastSort(wxVirtualItemIDs &vIDs)
         ++it;
     }
 
+    //workers : stable sort of a permutation, the values are not copied between threads
+    if ((uiWorkers > 1) && (uiSize > 0))
+    {
+        TSortPermutation vPermutation;
+        vPermutation.reserve(uiSize);
+        for(i=0;i<uiSize;i++) vPermutation.push_back(i);
+
+        TVariantsPermutationLess oLess(vVariants, m_pDataModel, vSortOrder);
+        wxParallelStableSort(&vPermutation[0], &vPermutation[0] + uiSize, oLess, uiWorkers);
+
+        vIDs.clear();
+        vIDs.reserve(uiSize);
+        for(i=0;i<uiSize;i++) vIDs.push_back(vVariants[vPermutation[i]].m_id);
+        for(i=0;i<uiSize;i++) vIDs[i].SetChildIndex(i);
+        return;
+    }
+
     wxComparisonFunctor oCmp(m_pDataModel, uiNbFields, vSortOrder);
 
     //sort the temporary array
@@ -458,6 +663,187 @@ void wxVirtualSortingDataModel::FastSort(wxVirtualItemIDs &vIDs)
     }
 }
 
+//--------------------- TYPED KEYS SORTING --------------------------//
+/** Convert all sorted values to typed keys
+  * \param vIDs  [input]: the items to sort
+  * \param vKeys [output]: the keys of each sorted field, in the order of the sort filters
+  * \return true on success
+  *         false if at least one sorted field cannot be converted to keys
+  */
+bool wxVirtualSortingDataModel::ExtractSortKeys(const wxVirtualItemIDs &vIDs,
+                                                wxVector<TSortKeys> &vKeys)
+{
+    vKeys.clear();
+    if (!m_pDataModel) return(false);
+
+    size_t uiSize = vIDs.size();
+    size_t i;
+
+    wxSortKeysBuilder oBuilder;
+    TFieldIDs vFields(1);
+    wxVirtualItemIDs vChunk;
+    wxVirtualValues vValues;
+    size_t uiStart, uiEnd;
+    TSortFilters::const_iterator it    = m_vSortFilters.begin();
+    TSortFilters::const_iterator itEnd = m_vSortFilters.end();
+    while(it != itEnd)
+    {
+        const TSort &rSort = *it;
+        size_t uiField = rSort.m_uiSortedField;
+        ++it;
+
+        bool bDescending;
+        switch(rSort.m_eSortOrder)
+        {
+            case WX_E_SORT_ASCENDING    : bDescending = false; break;
+            case WX_E_SORT_DESCENDING   : bDescending = true;  break;
+            case WX_E_SORT_NOT_SORTING  :
+            default                     : continue;
+        }
+
+        //a custom comparison cannot be converted to keys
+        if (m_pDataModel->HasCustomCompare(uiField)) return(false);
+
+        //fetch the values by chunks of items
+        oBuilder.Start(uiSize, bDescending);
+        vFields[0] = uiField;
+        for(uiStart = 0; uiStart < uiSize; uiStart = uiEnd)
+        {
+            uiEnd = uiStart + s_uiBatchSize;
+            if (uiEnd > uiSize) uiEnd = uiSize;
+            vChunk.clear();
+            for(i=uiStart;i<uiEnd;i++) vChunk.push_back(vIDs[i]);
+            GetItemDataBatch(vValues, vChunk, vFields);
+
+            for(i=0;i<uiEnd-uiStart;i++)
+            {
+                if (!oBuilder.Add(vValues[i])) return(false);
+            }
+        }
+
+        vKeys.push_back(TSortKeys());
+        if (!oBuilder.Finish(vKeys.back())) return(false);
+    }
+
+    return(!vKeys.empty());
+}
+
+/** Reorder the items and set their child index
+  * \param vIDs         [input / output]: the items to reorder
+  * \param vPermutation [input]: vPermutation[i] is the index in vIDs of the i-th sorted item
+  */
+void wxVirtualSortingDataModel::ApplyPermutation(wxVirtualItemIDs &vIDs,
+                                                 const TSortPermutation &vPermutation)
+{
+    size_t i, uiSize;
+    uiSize = vIDs.size();
+
+    wxVirtualItemIDs vUnsorted(vIDs);
+    for(i=0;i<uiSize;i++)
+    {
+        vIDs[i] = vUnsorted[vPermutation[i]];
+        vIDs[i].SetChildIndex(i);
+    }
+}
+
+/** Sorting of the items using typed keys
+  * \param vIDs     [input / output]: on input, the array to sort
+  *                                   on output, the sorted array
+  * \return true if the items were sorted
+  *         false if at least one sorted field cannot be converted to keys. vIDs is not modified
+  * All the values of the sorted fields are converted to keys (O(N) memory per field).
+  * Then a stable radix sort is performed for each field, from the last one to the first one
+  */
+bool wxVirtualSortingDataModel::KeysSort(wxVirtualItemIDs &vIDs)
+{
+    wxVector<TSortKeys> vKeys;
+    if (!ExtractSortKeys(vIDs, vKeys)) return(false);
+
+    //sort : least significant field first
+    size_t i, uiSize;
+    uiSize = vIDs.size();
+    TSortPermutation vPermutation;
+    vPermutation.reserve(uiSize);
+    for(i=0;i<uiSize;i++) vPermutation.push_back(i);
+
+    size_t uiField = vKeys.size();
+    while (uiField > 0)
+    {
+        uiField--;
+        wxRadixSortPermutation(vKeys[uiField], vPermutation);
+    }
+
+    ApplyPermutation(vIDs, vPermutation);
+    return(true);
+}
+
+//---------------------- PARALLEL SORTING ---------------------------//
+/** Multi-threaded sorting of the items (stable merge sort)
+  * \param vIDs     [input / output]: on input, the array to sort
+  *                                   on output, the sorted array
+  * The worker threads call the data model only if it IsThreadSafe(). Otherwise the
+  * values are read in the calling thread first, and converted to keys if possible.
+  * The fast sorting is used only for custom comparisons of models which are not thread safe
+  */
+void wxVirtualSortingDataModel::ParallelSort(wxVirtualItemIDs &vIDs)
+{
+    if (!m_pDataModel) return;
+    size_t uiSize = vIDs.size();
+    size_t uiWorkers = wxGetParallelSortWorkerCount(m_uiWorkerCount);
+    if ((uiWorkers < 2) || (uiSize < m_uiParallelThreshold))
+    {
+        FastSort(vIDs);
+        return;
+    }
+
+    //1st choice : keys extracted in this thread, workers compare only keys
+    size_t i;
+    wxVector<TSortKeys> vKeys;
+    if (ExtractSortKeys(vIDs, vKeys))
+    {
+        TSortPermutation vPermutation;
+        vPermutation.reserve(uiSize);
+        for(i=0;i<uiSize;i++) vPermutation.push_back(i);
+
+        wxSortKeysLess oLess(vKeys);
+        wxParallelStableSort(&vPermutation[0], &vPermutation[0] + uiSize, oLess, uiWorkers);
+        ApplyPermutation(vIDs, vPermutation);
+        return;
+    }
+    vKeys.clear();
+
+    //2nd choice : workers call Compare() directly
+    if (m_pDataModel->IsThreadSafe())
+    {
+        TCompareFunctor cmp(m_vSortFilters, m_pDataModel);
+        wxParallelStableSort(&vIDs[0], &vIDs[0] + uiSize, cmp, uiWorkers);
+        for(i=0;i<uiSize;i++) vIDs[i].SetChildIndex(i);
+        return;
+    }
+
+    //3rd choice : values read in this thread, workers compare the values with the default comparison
+    bool bCustomCompare = false;
+    TSortFilters::const_iterator it    = m_vSortFilters.begin();
+    TSortFilters::const_iterator itEnd = m_vSortFilters.end();
+    while(it != itEnd)
+    {
+        if ((it->m_eSortOrder != WX_E_SORT_NOT_SORTING) && (m_pDataModel->HasCustomCompare(it->m_uiSortedField)))
+        {
+            bCustomCompare = true;
+            break;
+        }
+        ++it;
+    }
+    if (!bCustomCompare)
+    {
+        VariantsSort(vIDs, uiWorkers);
+        return;
+    }
+
+    //custom comparison, and the model cannot be used from worker threads
+    VariantsSort(vIDs);
+}
+
 //---------------------- DO THE SORTING -----------------------------//
 
 /** Sort all the items according to the filter
@@ -469,9 +855,17 @@ void wxVirtualSortingDataModel::SortItems(wxVirtualItemIDs &vIDs)
     if (!IsSorting()) return;
     if (vIDs.size() < 2) return;
 
+    WX_VDV_PERF_TIMER(WX_PERF_SORT);
+    WX_VDV_PERF_COUNT(WX_PERF_ITEMS_SORTED, vIDs.size());
+
 //    wxLogMessage("Sorting children = %d", vIDs.size());
-    if (m_bFastSorting) FastSort(vIDs);
-    else                MemoryEfficientSort(vIDs);
+    switch(m_eSortingMode)
+    {
+        case WX_E_SORTING_MEMORY_EFFICIENT  : MemoryEfficientSort(vIDs);    break;
+        case WX_E_SORTING_PARALLEL          : ParallelSort(vIDs);           break;
+        case WX_E_SORTING_FAST              :
+        default                             : FastSort(vIDs);               break;
+    }
 //    wxLogMessage("Sorted children = %d", vIDs.size());
 }
 
@@ -485,3 +879,97 @@ void wxVirtualSortingDataModel::DoGetChildren(wxVirtualItemIDs &vChildren, const
     m_pDataModel->GetAllChildren(vChildren, rIDParent);
     SortItems(vChildren);
 }
+
+//----------------------- PARTIAL UPDATES ---------------------------//
+/** Check if changing some fields can modify the children arrays
+  * \param vFields [input]: the fields which changed. Empty for all fields
+  * \return true if one of the fields is sorted
+  */
+bool wxVirtualSortingDataModel::IsAffectedByFields(const TFieldIDs &vFields) const
+{
+    if (vFields.empty()) return(IsSorting());
+
+    size_t i, uiSize;
+    uiSize = vFields.size();
+    for(i = 0; i < uiSize; i++)
+    {
+        if (IsSorting(vFields[i])) return(true);
+    }
+    return(false);
+}
+
+/** Insert new items in cached children
+  * \param vChildren  [input/output]: the cached children of rIDParent
+  * \param rIDParent  [input]       : the parent item
+  * \param vNewIDs    [input]       : the new items, in the order of the master model
+  * \param vPositions [output]      : the child indices of the inserted items, in ascending order
+  * \return true if the items were inserted, false if the children must be recomputed
+  * The new items are sorted, and their positions are found by binary search:
+  * O(m log m + m log n) comparisons, instead of sorting the n + m items again
+  */
+bool wxVirtualSortingDataModel::DoInsertChildren(wxVirtualItemIDs &vChildren,
+                                                 const wxVirtualItemID &rIDParent,
+                                                 const wxVirtualItemIDs &vNewIDs,
+                                                 TPositions &vPositions)
+{
+    //without sorting and without row indices, the unsorted order is unknown
+    wxVirtualIListDataModel *pListModel = GetBottomListModel();
+    if ((!pListModel) && (!IsSorting())) return(false);
+
+    TInsertCompareFunctor cmp(m_vSortFilters, m_pDataModel, pListModel);
+    wxVirtualItemIDs vSortedIDs(vNewIDs);
+    std::stable_sort(vSortedIDs.begin(), vSortedIDs.end(), cmp);
+
+    size_t i, uiSize;
+    uiSize = vSortedIDs.size();
+    TPositions vInsertBefore;
+    vInsertBefore.reserve(uiSize);
+    for(i = 0; i < uiSize; i++)
+    {
+        wxVirtualItemIDs::iterator it = std::upper_bound(vChildren.begin(), vChildren.end(),
+                                                         vSortedIDs[i], cmp);
+        vInsertBefore.push_back(it - vChildren.begin());
+    }
+
+    MergeChildren(vChildren, vSortedIDs, vInsertBefore, vPositions);
+    return(true);
+}
+
+/** Re-position changed items in cached children
+  * \param vChildren   [input/output]: the cached children of rIDParent
+  * \param rIDParent   [input]       : the parent item
+  * \param vChangedIDs [input]       : the changed children of rIDParent
+  * \param vRemoved    [output]      : the child indices of the removed items (before removal), in ascending order
+  * \param vInserted   [output]      : the child indices of the inserted items (after insertion), in ascending order
+  * \return true if the children were updated, false if they must be recomputed
+  * The changed items are removed, and inserted again at their new position
+  */
+bool wxVirtualSortingDataModel::DoUpdateChildren(wxVirtualItemIDs &vChildren,
+                                                 const wxVirtualItemID &rIDParent,
+                                                 const wxVirtualItemIDs &vChangedIDs,
+                                                 TPositions &vRemoved,
+                                                 TPositions &vInserted)
+{
+    wxVirtualIListDataModel *pListModel = GetBottomListModel();
+    if ((!pListModel) && (!IsSorting())) return(false);
+
+    //remove the changed items
+    TSetOfItemIDs setChanged;
+    size_t i, uiSize;
+    uiSize = vChangedIDs.size();
+    for(i = 0; i < uiSize; i++) setChanged.insert(vChangedIDs[i]);
+
+    wxVirtualItemIDs vPresentIDs;
+    uiSize = vChildren.size();
+    for(i = 0; i < uiSize; i++)
+    {
+        wxVirtualItemID &rID = vChildren[i];
+        if (setChanged.find(rID) == setChanged.end()) continue;
+        vPresentIDs.push_back(rID);
+        rID = CreateInvalidItemID();
+    }
+    EraseInvalidChildren(vChildren, vRemoved);
+
+    //insert them again
+    return(DoInsertChildren(vChildren, rIDParent, vPresentIDs, vInserted));
+}
@@ -0,0 +1,513 @@
+/**********************************************************************/
+/** FILE    : VirtualStreamingListModel.cpp                          **/
+/** PROJECT : wxVirtualDataViewCtrl                                  **/
+/** LICENSE : wxWindows Library Licence                              **/
+/** PURPOSE : append-only list data model for live data (logs, ...)  **/
+/**********************************************************************/
+
+#include <wx/VirtualDataView/Models/VirtualStreamingListModel.h>
+#include <wx/VirtualDataView/Types/VirtualValue.h>
+#include <wx/event.h>
+#include <wx/timer.h>
+#include <wx/stopwatch.h>
+
+//default minimal delay between 2 publications of the pending rows, in ms
+static const long s_lDefaultFlushInterval = 16;
+
+//------------------------------ NOTIFIER ---------------------------//
+/** \class wxVirtualStreamingNotifier : publishes the pending rows in the GUI thread
+  * The appending threads queue 1 event per batch. The publications are throttled to 1 per
+  * flush interval: an event arriving too early starts a one-shot timer for the remaining delay
+  */
+class wxVirtualStreamingNotifier : public wxEvtHandler
+{
+    public:
+        //constructor
+        wxVirtualStreamingNotifier(wxVirtualStreamingListModel *pModel)
+            : wxEvtHandler(),
+              m_pModel(pModel),
+              m_Timer(this),
+              m_lInterval(s_lDefaultFlushInterval)
+        {
+            Bind(wxEVT_THREAD, &wxVirtualStreamingNotifier::OnAppendEvent, this);
+            Bind(wxEVT_TIMER, &wxVirtualStreamingNotifier::OnTimer, this);
+            m_StopWatch.Start(m_lInterval);
+        }
+
+        /** Stop the pending publications
+          */
+        void Stop(void)
+        {
+            m_Timer.Stop();
+            DeletePendingEvents();
+        }
+
+        /** A publication was done
+          */
+        void OnFlushed(void)
+        {
+            m_Timer.Stop();
+            m_StopWatch.Start();
+        }
+
+        //data
+        wxVirtualStreamingListModel*    m_pModel;                   ///< \brief the notified model
+        wxTimer                         m_Timer;                    ///< \brief delays the publication until the end of the interval
+        wxStopWatch                     m_StopWatch;                ///< \brief time since the last publication
+        long                            m_lInterval;                ///< \brief minimal delay between 2 publications, in ms
+
+    protected:
+        /** Rows were appended
+          * \param rEvent [input]: the event information
+          */
+        void OnAppendEvent(wxThreadEvent &rEvent)
+        {
+            if (m_Timer.IsRunning()) return;
+            long lElapsed = m_StopWatch.Time();
+            if (lElapsed >= m_lInterval) m_pModel->Flush();
+            else                         m_Timer.StartOnce(m_lInterval - lElapsed);
+        }
+
+        /** The interval elapsed
+          * \param rEvent [input]: the event information
+          */
+        void OnTimer(wxTimerEvent &rEvent)
+        {
+            m_pModel->Flush();
+        }
+};
+
+/** Lock the pending rows in the current scope
+  */
+#if wxUSE_THREADS
+    #define WX_VDV_LOCK_PENDING()   wxCriticalSectionLocker oPendingLock(m_PendingLock)
+#else
+    #define WX_VDV_LOCK_PENDING()
+#endif // wxUSE_THREADS
+
+//------------------ CONSTRUCTORS & DESTRUCTOR ----------------------//
+/** Constructor
+  * \param uiFieldCount [input]: the amount of fields of each row (at least 1)
+  */
+wxVirtualStreamingListModel::wxVirtualStreamingListModel(size_t uiFieldCount)
+    : wxVirtualIListDataModel(),
+      m_uiFieldCount(uiFieldCount),
+      m_pSpareChunk(WX_VDV_NULL_PTR),
+      m_uiHeadOffset(0),
+      m_uiRowCount(0),
+      m_uiMaxRows(0),
+      m_uiDroppedRows(0),
+      m_bFlushQueued(false),
+      m_pNotifier(WX_VDV_NULL_PTR)
+{
+    if (m_uiFieldCount == 0) m_uiFieldCount = 1;
+    m_vColumnNames.resize(m_uiFieldCount);
+    m_pNotifier = new wxVirtualStreamingNotifier(this);
+}
+
+/** Destructor
+  * No thread may append rows anymore
+  */
+wxVirtualStreamingListModel::~wxVirtualStreamingListModel(void)
+{
+    m_pNotifier->Stop();
+    delete(m_pNotifier);
+    ReleaseAllChunks();
+    delete(m_pSpareChunk);
+}
+
+//----------------------------- FIELDS ------------------------------//
+/** Get the amount of fields
+  * \return the amount of fields of each row
+  */
+size_t wxVirtualStreamingListModel::GetColumnCount(void) const
+{
+    return(m_uiFieldCount);
+}
+
+/** Get the name of a field
+  * \param uiField [input]: the index of the field
+  * \return the name of the field. Empty if it was not set
+  */
+wxString wxVirtualStreamingListModel::GetColumnName(size_t uiField) const
+{
+    if (uiField >= m_uiFieldCount) return(wxEmptyString);
+    return(m_vColumnNames[uiField]);
+}
+
+/** Set the name of a field
+  * \param uiField [input]: the index of the field
+  * \param sName   [input]: the new name of the field
+  */
+void wxVirtualStreamingListModel::SetColumnName(size_t uiField, const wxString &sName)
+{
+    if (uiField >= m_uiFieldCount) return;
+    m_vColumnNames[uiField] = sName;
+}
+
+//---------------------------- APPENDING ----------------------------//
+/** Append a row with 1 field
+  * Can be called from any thread. The other fields of the row are empty.
+  * The row is visible after the next publication
+  * \param sField [input]: the 1st field of the row
+  */
+void wxVirtualStreamingListModel::AppendRow(const wxString &sField)
+{
+    AppendFields(&sField, 1);
+}
+
+/** Append a row
+  * Can be called from any thread. Missing fields are empty, extra fields are ignored.
+  * The row is visible after the next publication
+  * \param vFields [input]: the fields of the row
+  */
+void wxVirtualStreamingListModel::AppendRow(const wxArrayString &vFields)
+{
+    if (vFields.IsEmpty())
+    {
+        wxString sEmpty;
+        AppendFields(&sEmpty, 1);
+        return;
+    }
+    AppendFields(&vFields[0], vFields.GetCount());
+}
+
+/** Get the amount of rows appended but not published yet
+  * \return the amount of pending rows
+  */
+size_t wxVirtualStreamingListModel::GetPendingRowCount(void) const
+{
+    WX_VDV_LOCK_PENDING();
+    return(m_vPending.size() / m_uiFieldCount);
+}
+
+/** Append the fields of 1 row to the pending rows
+  * The 1st append of a batch requests a publication in the GUI thread
+  * \param pFields    [input]: the fields of the row
+  * \param uiNbFields [input]: the amount of fields in pFields
+  */
+void wxVirtualStreamingListModel::AppendFields(const wxString *pFields, size_t uiNbFields)
+{
+    size_t i;
+    {
+        WX_VDV_LOCK_PENDING();
+        for(i = 0; i < m_uiFieldCount; i++)
+        {
+            if (i < uiNbFields) m_vPending.push_back(pFields[i]);
+            else                m_vPending.push_back(wxEmptyString);
+        }
+        if (m_bFlushQueued) return;
+        m_bFlushQueued = true;
+    }
+
+    wxQueueEvent(m_pNotifier, new wxThreadEvent(wxEVT_THREAD));
+}
+
+//---------------------------- PUBLISHING ---------------------------//
+/** Publish the pending rows now
+  * Must be called in the GUI thread. It is called automatically at most once per flush interval.
+  * The rows removed by the retention limit are notified with 1 ItemsRemoved(), then the new rows
+  * with 1 ItemsInserted()
+  */
+void wxVirtualStreamingListModel::Flush(void)
+{
+    wxVector<wxString> vFields;
+    {
+        WX_VDV_LOCK_PENDING();
+        vFields.swap(m_vPending);
+        m_bFlushQueued = false;
+    }
+    m_pNotifier->OnFlushed();
+
+    size_t uiNbNewRows = vFields.size() / m_uiFieldCount;
+    if (uiNbNewRows == 0) return;
+
+    //rows over the retention limit : the oldest published rows first, then the oldest new rows
+    size_t uiDropOld = 0;
+    size_t uiDropNew = 0;
+    if ((m_uiMaxRows > 0) && (m_uiRowCount + uiNbNewRows > m_uiMaxRows))
+    {
+        size_t uiExcess = m_uiRowCount + uiNbNewRows - m_uiMaxRows;
+        uiDropOld = uiExcess;
+        if (uiDropOld > m_uiRowCount) uiDropOld = m_uiRowCount;
+        uiDropNew = uiExcess - uiDropOld;
+        m_uiDroppedRows += uiExcess;
+    }
+
+    if (uiDropOld > 0)
+    {
+        DropRows(uiDropOld);
+        ItemsRemoved(GetRootItem(), 0, uiDropOld);
+    }
+
+    size_t uiFirst = m_uiRowCount;
+    size_t uiCount = uiNbNewRows - uiDropNew;
+    StoreRows(vFields, uiDropNew, uiCount);
+    ItemsInserted(GetRootItem(), uiFirst, uiCount);
+}
+
+/** Set the minimal delay between 2 publications
+  * \param lMilliseconds [input]: the new delay, in ms. 0 for publishing each batch as soon as possible
+  */
+void wxVirtualStreamingListModel::SetFlushInterval(long lMilliseconds)
+{
+    if (lMilliseconds < 0) lMilliseconds = 0;
+    m_pNotifier->m_lInterval = lMilliseconds;
+}
+
+/** Get the minimal delay between 2 publications
+  * \return the delay, in ms
+  */
+long wxVirtualStreamingListModel::GetFlushInterval(void) const
+{
+    return(m_pNotifier->m_lInterval);
+}
+
+/** Remove all rows
+  * Must be called in the GUI thread. The pending rows are discarded. ModelReset() is sent.
+  * The queued publications are cancelled before the pending rows are cleared: an append made
+  * in between sees m_bFlushQueued set, and its publication event must survive
+  */
+void wxVirtualStreamingListModel::Clear(void)
+{
+    m_pNotifier->Stop();
+    {
+        WX_VDV_LOCK_PENDING();
+        m_vPending.clear();
+        m_bFlushQueued = false;
+    }
+
+    ReleaseAllChunks();
+    m_uiHeadOffset = 0;
+    m_uiRowCount   = 0;
+    ModelReset();
+}
+
+//----------------------------- RETENTION ---------------------------//
+/** Set the maximal amount of rows kept
+  * Must be called in the GUI thread. The oldest rows over the limit are removed at the next
+  * publication
+  * \param uiMaxRows [input]: the maximal amount of rows. 0 for no limit
+  */
+void wxVirtualStreamingListModel::SetMaxRowCount(size_t uiMaxRows)
+{
+    m_uiMaxRows = uiMaxRows;
+}
+
+/** Get the maximal amount of rows kept
+  * \return the maximal amount of rows. 0 if there is no limit
+  */
+size_t wxVirtualStreamingListModel::GetMaxRowCount(void) const
+{
+    return(m_uiMaxRows);
+}
+
+/** Get the amount of rows removed by the retention limit
+  * \return the amount of rows removed since the creation of the model
+  */
+wxUint64 wxVirtualStreamingListModel::GetDroppedRowCount(void) const
+{
+    return(m_uiDroppedRows);
+}
+
+//--------------------------- DIRECT ACCESS -------------------------//
+/** Get a field of a published row
+  * \param uiRow   [input]: the row index
+  * \param uiField [input]: the field index
+  * \return a reference to the field. It stays valid until the row is removed.
+  *         An empty string if the row or the field does not exist
+  */
+const wxString& wxVirtualStreamingListModel::GetString(size_t uiRow, size_t uiField) const
+{
+    static const wxString s_sEmpty;
+    if ((uiRow >= m_uiRowCount) || (uiField >= m_uiFieldCount)) return(s_sEmpty);
+
+    size_t uiPos = m_uiHeadOffset + uiRow;
+    const TChunk *pChunk = m_vChunks[uiPos / WX_VDV_STREAMING_CHUNK_ROWS];
+    return((*pChunk)[(uiPos % WX_VDV_STREAMING_CHUNK_ROWS) * m_uiFieldCount + uiField]);
+}
+
+//------------------ wxVirtualIListDataModel INTERFACE --------------//
+/** Get amount of items
+  * \return the amount of published rows
+  */
+size_t wxVirtualStreamingListModel::GetItemCount(void)
+{
+    return(m_uiRowCount);
+}
+
+/** Get the amount of fields in the item
+  * \param rID [input]: the item to query
+  * \return the amount of fields
+  */
+size_t wxVirtualStreamingListModel::GetFieldCount(const wxVirtualItemID &rID)
+{
+    return(m_uiFieldCount);
+}
+
+/** Get the item data
+  * \param uiItemID [input]: the row index of the item
+  * \param uiField  [input]: the field index
+  * \param eType    [input]: the kind of data to get. Only WX_ITEM_MAIN_DATA is available
+  * \return the data of the item
+  */
+wxVariant wxVirtualStreamingListModel::GetListItemData(size_t uiItemID, size_t uiField, EDataType eType)
+{
+    if ((eType != WX_ITEM_MAIN_DATA) || (uiItemID >= m_uiRowCount) || (uiField >= m_uiFieldCount))
+    {
+        return(wxVariant());
+    }
+    return(wxVariant(GetString(uiItemID, uiField)));
+}
+
+/** Get the item data without allocation
+  * Text values are references to the stored rows: they stay valid until the row is removed
+  * \param rValue   [output]: the data of the item
+  * \param uiItemID [input] : the row index of the item
+  * \param uiField  [input] : the field index
+  * \param eType    [input] : the kind of data to get. Only WX_ITEM_MAIN_DATA is available
+  */
+void wxVirtualStreamingListModel::GetListItemValue(wxVirtualValue &rValue, size_t uiItemID,
+                                                   size_t uiField, EDataType eType)
+{
+    if ((eType != WX_ITEM_MAIN_DATA) || (uiItemID >= m_uiRowCount) || (uiField >= m_uiFieldCount))
+    {
+        rValue.SetNull();
+        return;
+    }
+    rValue.SetString(GetString(uiItemID, uiField));
+}
+
+/** Set the item data
+  * The change is notified with ItemsChanged()
+  * \param uiItemID [input]: the row index of the item
+  * \param uiField  [input]: the field index
+  * \param vValue   [input]: the new value, converted to a string
+  * \param eType    [input]: the kind of data to set. Only WX_ITEM_MAIN_DATA is available
+  * \return true if the data was modified, false otherwise
+  */
+bool wxVirtualStreamingListModel::SetListItemData(size_t uiItemID, size_t uiField,
+                                                  const wxVariant &vValue, EDataType eType)
+{
+    if ((eType != WX_ITEM_MAIN_DATA) || (uiItemID >= m_uiRowCount) || (uiField >= m_uiFieldCount))
+    {
+        return(false);
+    }
+
+    size_t uiPos = m_uiHeadOffset + uiItemID;
+    TChunk *pChunk = m_vChunks[uiPos / WX_VDV_STREAMING_CHUNK_ROWS];
+    (*pChunk)[(uiPos % WX_VDV_STREAMING_CHUNK_ROWS) * m_uiFieldCount + uiField] = vValue.MakeString();
+
+    wxVirtualItemIDs vIDs;
+    TFieldIDs vChangedFields;
+    vIDs.push_back(GetItemID(uiItemID));
+    vChangedFields.push_back(uiField);
+    ItemsChanged(vIDs, vChangedFields);
+    return(true);
+}
+
+//------------------------------ SORTING ----------------------------//
+/** Check if Compare() is reimplemented for a field
+  * \param uiField [input]: the field to check
+  * \return false : the default comparison is used, the fields can be sorted with typed keys
+  */
+bool wxVirtualStreamingListModel::HasCustomCompare(size_t uiField)
+{
+    return(false);
+}
+
+//------------------------ MULTI-THREADING --------------------------//
+/** Check if GetItemData() & Compare() can be called from worker threads
+  * \return false : Flush() modifies the chunks in the GUI thread without locking, a worker
+  *         thread reading the rows at the same time would race with it
+  */
+bool wxVirtualStreamingListModel::IsThreadSafe(void)
+{
+    return(false);
+}
+
+//----------------------- INTERNAL METHODS --------------------------//
+/** Store published rows at the end of the chunks
+  * \param vFields    [input]: the fields of the rows, row by row
+  * \param uiFirstRow [input]: the 1st row of vFields to store
+  * \param uiNbRows   [input]: the amount of rows to store
+  */
+void wxVirtualStreamingListModel::StoreRows(const wxVector<wxString> &vFields, size_t uiFirstRow,
+                                            size_t uiNbRows)
+{
+    size_t uiSrc = uiFirstRow * m_uiFieldCount;
+    size_t uiEnd = (uiFirstRow + uiNbRows) * m_uiFieldCount;
+    size_t uiChunkSize = WX_VDV_STREAMING_CHUNK_ROWS * m_uiFieldCount;
+    while (uiSrc < uiEnd)
+    {
+        if ((m_vChunks.empty()) || (m_vChunks.back()->size() >= uiChunkSize))
+        {
+            m_vChunks.push_back(NewChunk());
+        }
+
+        TChunk *pChunk = m_vChunks.back();
+        size_t uiNb = uiChunkSize - pChunk->size();
+        if (uiNb > uiEnd - uiSrc) uiNb = uiEnd - uiSrc;
+        for(; uiNb > 0; uiNb--) pChunk->push_back(vFields[uiSrc++]);
+    }
+    m_uiRowCount += uiNbRows;
+}
+
+/** Remove published rows at the start of the chunks
+  * The chunks containing only removed rows are released
+  * \param uiNbRows [input]: the amount of rows to remove
+  */
+void wxVirtualStreamingListModel::DropRows(size_t uiNbRows)
+{
+    if (uiNbRows > m_uiRowCount) uiNbRows = m_uiRowCount;
+    m_uiRowCount   -= uiNbRows;
+    m_uiHeadOffset += uiNbRows;
+
+    size_t uiNbChunks = m_uiHeadOffset / WX_VDV_STREAMING_CHUNK_ROWS;
+    if (uiNbChunks == 0) return;
+    if (m_uiRowCount == 0) uiNbChunks = m_vChunks.size();
+
+    size_t i;
+    for(i = 0; i < uiNbChunks; i++) ReleaseChunk(m_vChunks[i]);
+    m_vChunks.erase(m_vChunks.begin(), m_vChunks.begin() + uiNbChunks);
+    if (m_uiRowCount == 0) m_uiHeadOffset = 0;
+    else                   m_uiHeadOffset -= uiNbChunks * WX_VDV_STREAMING_CHUNK_ROWS;
+}
+
+/** Get an empty chunk
+  * \return the spare chunk if there is one, a new chunk otherwise
+  */
+wxVirtualStreamingListModel::TChunk* wxVirtualStreamingListModel::NewChunk(void)
+{
+    TChunk *pChunk = m_pSpareChunk;
+    m_pSpareChunk = WX_VDV_NULL_PTR;
+    if (!pChunk) pChunk = new TChunk;
+    pChunk->reserve(WX_VDV_STREAMING_CHUNK_ROWS * m_uiFieldCount);
+    return(pChunk);
+}
+
+/** Release a chunk which is not used anymore
+  * 1 chunk is kept for reuse: with a retention limit, a chunk is released each time a chunk
+  * is filled, and the memory stays steady
+  * \param pChunk [input]: the chunk to release
+  */
+void wxVirtualStreamingListModel::ReleaseChunk(TChunk *pChunk)
+{
+    if (m_pSpareChunk)
+    {
+        delete(pChunk);
+        return;
+    }
+    pChunk->clear();
+    m_pSpareChunk = pChunk;
+}
+
+/** Release all the chunks
+  */
+void wxVirtualStreamingListModel::ReleaseAllChunks(void)
+{
+    size_t i, uiNbChunks;
+    uiNbChunks = m_vChunks.size();
+    for(i = 0; i < uiNbChunks; i++) ReleaseChunk(m_vChunks[i]);
+    m_vChunks.clear();
+}
@@ -7,6 +7,7 @@
 
 #include <wx/VirtualDataView/Renderers/VirtualDataViewBitmapRenderer.h>
 #include <wx/VirtualDataView/CellAttrs/VirtualDataViewItemAttr.h>
+#include <wx/VirtualDataView/Types/VariantTypeRegistry.h>
 #include <wx/dc.h>
 #include <wx/image.h>
 #include <wx/icon.h>
@@ -60,7 +61,8 @@ void wxVirtualDataViewBitmapRenderer::Render(wxWindow *pWindow, const wxRect &rR
     wxPoint pt = rRect.GetLeftTop();
     pt.x += 1;
     pt.y += 1;
-    if (vValue.GetType() == "wxImage")
+    size_t uiTypeID = wxVariantTypeRegistry::GetTypeID(vValue);
+    if (uiTypeID == WX_VARIANT_TYPE_IMAGE)
     {
         wxImage img;
         img << vValue;
@@ -69,13 +71,13 @@ void wxVirtualDataViewBitmapRenderer::Render(wxWindow *pWindow, const wxRect &rR
         rDC.DrawBitmap(bmp, pt, true);
 
     }
-    else if (vValue.GetType() == "wxIcon")
+    else if (uiTypeID == WX_VARIANT_TYPE_ICON)
     {
         wxBitmap bmp;
         bmp << vValue;
         rDC.DrawBitmap(bmp, pt, true);
     }
-    else if (vValue.GetType() == "wxBitmap")
+    else if (uiTypeID == WX_VARIANT_TYPE_BITMAP)
     {
         wxIcon oIcon;
         oIcon << vValue;
@@ -96,19 +98,20 @@ wxSize wxVirtualDataViewBitmapRenderer::GetSize(wxWindow *pWindow,
                                                 const wxVariant& vValue) const
 {
     wxSize s(0, 0);
-    if (vValue.GetType() == "wxImage")
+    size_t uiTypeID = wxVariantTypeRegistry::GetTypeID(vValue);
+    if (uiTypeID == WX_VARIANT_TYPE_IMAGE)
     {
         wxImage img;
         img << vValue;
         s = img.GetSize();
     }
-    else if (vValue.GetType() == "wxIcon")
+    else if (uiTypeID == WX_VARIANT_TYPE_ICON)
     {
         wxBitmap bmp;
         bmp << vValue;
         s = bmp.GetSize();
     }
-    else if (vValue.GetType() == "wxBitmap")
+    else if (uiTypeID == WX_VARIANT_TYPE_BITMAP)
     {
         wxIcon oIcon;
         oIcon << vValue;
@@ -7,6 +7,7 @@
 
 #include <wx/VirtualDataView/Renderers/VirtualDataViewBitmapTextRenderer.h>
 #include <wx/VirtualDataView/Types/BitmapText.h>
+#include <wx/VirtualDataView/Types/VariantTypeRegistry.h>
 #include <wx/VirtualDataView/CellAttrs/VirtualDataViewItemAttr.h>
 #include <wx/dc.h>
 
@@ -65,10 +66,11 @@ void wxVirtualDataViewBitmapTextRenderer::Render(wxWindow *pWindow, const wxRect
     //background
     RenderBackground(pWindow, rRect, rDC, pAttr);
 
+    size_t uiTypeID = wxVariantTypeRegistry::GetTypeID(vValue);
 #if WX_USE_COMPATIBILITY_LAYER_WITH_DVC != 0
-    if ((vValue.GetType() != "wxBitmapText") && (vValue.GetType() != "wxDataViewIconText"))
+    if ((uiTypeID != WX_VARIANT_TYPE_BITMAP_TEXT) && (uiTypeID != WX_VARIANT_TYPE_DATAVIEW_ICON_TEXT))
 #else
-    if (vValue.GetType() != "wxBitmapText")
+    if (uiTypeID != WX_VARIANT_TYPE_BITMAP_TEXT)
 #endif // WX_USE_COMPATIBILITY_LAYER_WITH_DVC
     {
         wxString sValue = vValue.GetString();
@@ -131,7 +133,7 @@ wxSize wxVirtualDataViewBitmapTextRenderer::GetSize(wxWindow *pWindow,
 {
     //get information
     wxBitmapText oValue;
-    if (vValue.GetType() != "wxBitmapText")
+    if (wxVariantTypeRegistry::GetTypeID(vValue) != WX_VARIANT_TYPE_BITMAP_TEXT)
     {
         oValue.SetText(vValue.GetString());
         if (oValue.GetText() == "") oValue.SetText("AgMf0");
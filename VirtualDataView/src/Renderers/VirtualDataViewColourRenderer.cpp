@@ -6,6 +6,7 @@
 /**********************************************************************/
 
 #include <wx/VirtualDataView/Renderers/VirtualDataViewColourRenderer.h>
+#include <wx/VirtualDataView/Types/VariantTypeRegistry.h>
 #include <wx/dc.h>
 
 //------------------ CONSTRUCTORS & DESTRUCTOR ----------------------//
@@ -50,7 +51,7 @@ void wxVirtualDataViewColourRenderer::Render(wxWindow *pWindow, const wxRect &rR
                                              const wxVirtualDataViewItemState &rState,
                                              const wxVariant& vValue)
 {
-    if (vValue.GetType() != "wxColour") return;
+    if (wxVariantTypeRegistry::GetTypeID(vValue) != WX_VARIANT_TYPE_COLOUR) return;
     wxColour c;
     c << vValue;
 
@@ -90,6 +90,24 @@ void wxVirtualDataViewDateRenderer::Render(wxWindow *pWindow, const wxRect &rRec
                m_eEllipsizeMode);
 }
 
+/** Render the item from a lightweight value
+  * The value is always given to Render(), which converts it to a date
+  * \param pWindow [input]: the window where the rendering occurs
+  * \param rRect   [input]: the clipping rectangle
+  * \param rDC     [input]: the device context to use for drawing
+  * \param pAttr   [input]: the item attributes
+  * \param rState  [input]: the item state
+  * \param rValue  [input]: the value of the item
+  */
+void wxVirtualDataViewDateRenderer::RenderValue(wxWindow *pWindow, const wxRect &rRect,
+                                                wxDC &rDC,
+                                                wxVirtualDataViewItemAttr *pAttr,
+                                                const wxVirtualDataViewItemState &rState,
+                                                const wxVirtualValue &rValue)
+{
+    wxVirtualDataViewRenderer::RenderValue(pWindow, rRect, rDC, pAttr, rState, rValue);
+}
+
 /** Return the size of the item
   * \param pWindow [input]: the window used for measuring
   * \param pAttr   [input]: the item attributes
@@ -8,6 +8,8 @@
 #include <wx/VirtualDataView/Renderers/VirtualDataViewRenderer.h>
 #include <wx/VirtualDataView/CellAttrs/VirtualDataViewItemAttr.h>
 #include <wx/VirtualDataView/StateModels/VirtualDataViewItemState.h>
+#include <wx/VirtualDataView/Types/VirtualValue.h>
+#include <wx/VirtualDataView/Utilities/VirtualTextExtentCache.h>
 #include <wx/window.h>
 #include <wx/renderer.h>
 #include <wx/dc.h>
@@ -28,6 +30,26 @@ wxVirtualDataViewRenderer::~wxVirtualDataViewRenderer(void)
 
 }
 
+//--------------------------- INTERFACE -----------------------------//
+/** Render the item from a lightweight value
+  * The default implementation converts the value to a wxVariant and calls Render()
+  * \param pWindow [input]: the window where the rendering occurs
+  * \param rRect   [input]: the clipping rectangle
+  * \param rDC     [input]: the device context to use for drawing
+  * \param pAttr   [input]: the item attributes
+  * \param rState  [input]: the item state
+  * \param rValue  [input]: the value of the item, from wxVirtualIDataModel::GetItemValue()
+  */
+void wxVirtualDataViewRenderer::RenderValue(wxWindow *pWindow, const wxRect &rRect,
+                                            wxDC &rDC,
+                                            wxVirtualDataViewItemAttr *pAttr,
+                                            const wxVirtualDataViewItemState &rState,
+                                            const wxVirtualValue &rValue)
+{
+    if (rValue.IsVariant()) Render(pWindow, rRect, rDC, pAttr, rState, rValue.GetVariant());
+    else                    Render(pWindow, rRect, rDC, pAttr, rState, rValue.ToVariant());
+}
+
 //---------------------- INTERNAL METHODS ---------------------------//
 /** Get the renderer
   * \return the renderer
@@ -252,9 +274,10 @@ void wxVirtualDataViewRenderer::RenderText(wxWindow *pWindow,
         oChangeFont.Set(fFont);
     }
 
-    //draw
+    //draw : ellipsize only if the text does not fit (the measurement is cached)
     wxString sText;
-    if (eEllipsization != WX_ELLIPSIZE_NONE)
+    if ((eEllipsization != WX_ELLIPSIZE_NONE) &&
+        (wxVirtualTextExtentCache::GetTextExtent(rDC, rsText).GetWidth() > rRect.width))
         sText = wxControl::Ellipsize(rsText, rDC, (wxEllipsizeMode) eEllipsization, rRect.width, wxELLIPSIZE_FLAGS_NONE);
     else
         sText = rsText;
@@ -407,8 +430,5 @@ wxSize wxVirtualDataViewRenderer::GetTextExtent(wxWindow *pWindow, const wxStrin
     wxFont oFont(pWindow->GetFont());
     if (pAttr) pAttr->GetEffectiveFont(oFont);
 
-    int x, y;
-    pWindow->GetTextExtent(rsText, &x, &y,
-                           WX_VDV_NULL_PTR, WX_VDV_NULL_PTR, &oFont);
-    return(wxSize(x, y));
+    return(wxVirtualTextExtentCache::GetTextExtent(pWindow, rsText, oFont));
 }
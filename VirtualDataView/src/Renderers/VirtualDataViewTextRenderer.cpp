@@ -8,6 +8,7 @@
 #include <wx/VirtualDataView/Renderers/VirtualDataViewTextRenderer.h>
 #include <wx/VirtualDataView/CellAttrs/VirtualDataViewItemAttr.h>
 #include <wx/VirtualDataView/Types/VariantUtils.h>
+#include <wx/VirtualDataView/Types/VirtualValue.h>
 #include <wx/dc.h>
 
 //------------------ CONSTRUCTORS & DESTRUCTOR ----------------------//
@@ -76,6 +77,39 @@ void wxVirtualDataViewTextRenderer::Render(wxWindow *pWindow, const wxRect &rRec
                m_eEllipsizeMode);
 }
 
+/** Render the item from a lightweight value
+  * Strings are drawn directly from the model storage, without copy
+  * \param pWindow [input]: the window where the rendering occurs
+  * \param rRect   [input]: the clipping rectangle
+  * \param rDC     [input]: the device context to use for drawing
+  * \param pAttr   [input]: the item attributes
+  * \param rState  [input]: the item state
+  * \param rValue  [input]: the value of the item
+  */
+void wxVirtualDataViewTextRenderer::RenderValue(wxWindow *pWindow, const wxRect &rRect,
+                                                wxDC &rDC,
+                                                wxVirtualDataViewItemAttr *pAttr,
+                                                const wxVirtualDataViewItemState &rState,
+                                                const wxVirtualValue &rValue)
+{
+    if (rValue.GetType() != wxVirtualValue::WX_VALUE_STRING)
+    {
+        wxVirtualDataViewRenderer::RenderValue(pWindow, rRect, rDC, pAttr, rState, rValue);
+        return;
+    }
+
+    //background
+    RenderBackground(pWindow, rRect, rDC, pAttr);
+
+    //text
+    RenderText(pWindow, rRect, rDC, rValue.GetStringRef(),
+               0, 0,
+               pAttr, rState,
+               m_eHorizontalAlignment,
+               m_eVerticalAlignment,
+               m_eEllipsizeMode);
+}
+
 /** Return the size of the item
   * \param pWindow [input]: the window used for measuring
   * \param pAttr   [input]: the item attributes
@@ -268,7 +268,8 @@ class JobDeleteItem : public JobBase
 /** Default constructor
   */
 wxVirtualDefaultStateModel::wxVirtualDefaultStateModel(void)
-    : wxVirtualIStateModel(), m_bAllowRecursion(true)
+    : wxVirtualIStateModel(), m_bAllowRecursion(true),
+      m_VisibleRowIndex(this), m_bUseVisibleRowIndex(true)
 {
     m_eSelectionType = WX_STATE_DEFAULT;
 }
@@ -346,6 +347,27 @@ void wxVirtualDefaultStateModel::AllowRecursion(bool bAllow)
     m_bAllowRecursion = bAllow;
 }
 
+/** Check if the visible row index is maintained
+  * \return true if the visible row index is maintained on expand / collapse. It is then used by
+  *         the data models for computing item ranks, sub-tree sizes and finding items from ranks
+  *         in O(log(n)) time instead of O(n) time
+  *         false otherwise
+  */
+bool wxVirtualDefaultStateModel::UsesVisibleRowIndex(void) const
+{
+    return(m_bUseVisibleRowIndex);
+}
+
+/** Maintain or not the visible row index
+  * \param bUse [input]: true for maintaining the visible row index
+  *                      false otherwise. The index memory is released
+  */
+void wxVirtualDefaultStateModel::UseVisibleRowIndex(bool bUse)
+{
+    m_bUseVisibleRowIndex = bUse;
+    m_VisibleRowIndex.Clear();
+}
+
 //------ wxVirtualIStateModeL INTERFACE IMPLEMENTATION --------------//
 /** Check if the item is enabled / disabled
   * \param rID [input]: the item to check
@@ -460,8 +482,15 @@ bool wxVirtualDefaultStateModel::SetState(const wxVirtualDataViewItemState &rSta
 
     WX_SET_CHECKSTATE(iState, rState.GetCheckState());
 
+    bool bWasExpanded = WX_IS_EXPANDED(GetState(rID));
     SetState(rID, iState);
 
+    //update the index of visible rows
+    if ((m_bUseVisibleRowIndex) && (bWasExpanded != rState.IsExpanded()))
+    {
+        m_VisibleRowIndex.OnExpand(rID, rState.IsExpanded());
+    }
+
     return(bResult);
 }
 
@@ -482,13 +511,117 @@ void wxVirtualDefaultStateModel::GetState(wxVirtualDataViewItemState &rState,
     else                      rState.SetFocused(false);
 }
 
+//------------------ VISIBLE ROWS INDEX -----------------------------//
+/** Get the visible row index
+  * \param pDataModel [input]: the data model which will use the index
+  * \return the visible row index, if it is maintained and valid for pDataModel
+  *         NULL otherwise
+  */
+wxVirtualVisibleRowIndex* wxVirtualDefaultStateModel::GetVisibleRowIndex(wxVirtualIDataModel *pDataModel)
+{
+    if (!m_bUseVisibleRowIndex) return(WX_VDV_NULL_PTR);
+    if (!pDataModel) return(WX_VDV_NULL_PTR);
+    if (m_VisibleRowIndex.GetDataModel() != pDataModel) return(WX_VDV_NULL_PTR);
+    return(&m_VisibleRowIndex);
+}
+
 //------------------ CALLBACKS --------------------------------------//
+/** Data model has changed
+  * \param pDataModel [input]: the new data model
+  * The visible row index is cleared and will be rebuilt lazily
+  */
+void wxVirtualDefaultStateModel::OnDataModelChanged(wxVirtualIDataModel* pDataModel)
+{
+    m_VisibleRowIndex.SetDataModel(pDataModel);
+}
+
+/** The children of an item changed (inserted / removed / re-ordered)
+  * \param rParent [input]: the item whose children changed
+  * Only the node of rParent is rebuilt in the visible row index
+  */
+void wxVirtualDefaultStateModel::OnChildrenChanged(const wxVirtualItemID &rParent)
+{
+    m_VisibleRowIndex.OnChildrenChanged(rParent);
+}
+
+/** List rows were inserted : the states of the following rows are shifted
+  * \param rParent [input]: the parent of the new rows (root item of the list model)
+  * \param uiFirst [input]: the row index of the 1st new row
+  * \param uiCount [input]: the amount of new rows
+  * The visible row index is updated by OnChildrenChanged()
+  */
+void wxVirtualDefaultStateModel::OnItemsInserted(const wxVirtualItemID &rParent,
+                                                 size_t uiFirst, size_t uiCount)
+{
+    ShiftListRows(uiFirst, uiCount, true);
+}
+
+/** List rows were removed : the states of the removed rows are dropped, and the following rows are shifted
+  * \param rParent [input]: the parent of the removed rows (root item of the list model)
+  * \param uiFirst [input]: the row index of the 1st removed row, before the removal
+  * \param uiCount [input]: the amount of removed rows
+  * The visible row index is updated by OnChildrenChanged()
+  */
+void wxVirtualDefaultStateModel::OnItemsRemoved(const wxVirtualItemID &rParent,
+                                                size_t uiFirst, size_t uiCount)
+{
+    ShiftListRows(uiFirst, uiCount, false);
+}
+
+/** Shift the states of list rows
+  * \param uiFirst   [input]: the row index of the 1st inserted / removed row
+  * \param uiCount   [input]: the amount of inserted / removed rows
+  * \param bInserted [input]: true if the rows were inserted, false if they were removed
+  * List models use the item ID "row index + 1"
+  */
+void wxVirtualDefaultStateModel::ShiftListRows(size_t uiFirst, size_t uiCount, bool bInserted)
+{
+    if (uiCount == 0) return;
+    size_t uiEnd = uiFirst + uiCount;
+
+    //states
+    if (!m_MapOfStates.empty())
+    {
+        THashMapState oShifted;
+        THashMapState::iterator it    = m_MapOfStates.begin();
+        THashMapState::iterator itEnd = m_MapOfStates.end();
+        while(it != itEnd)
+        {
+            wxVirtualItemID id = it->first;
+            size_t uiRow = id.GetInt64() - 1;
+            if ((id.IsRootOrInvalid()) || (uiRow < uiFirst))
+            {
+                oShifted[id] = it->second;
+            }
+            else if ((bInserted) || (uiRow >= uiEnd))
+            {
+                if (bInserted) id.SetInt64(uiRow + uiCount + 1);
+                else           id.SetInt64(uiRow - uiCount + 1);
+                oShifted[id] = it->second;
+            }
+            ++it;
+        }
+        m_MapOfStates = oShifted;
+    }
+
+    //focus
+    if ((m_FocusedItem.IsOK()) && (!m_FocusedItem.IsRootItem()))
+    {
+        size_t uiRow = m_FocusedItem.GetInt64() - 1;
+        if (uiRow < uiFirst) return;
+        if (bInserted)          m_FocusedItem.SetInt64(uiRow + uiCount + 1);
+        else if (uiRow < uiEnd) m_FocusedItem = wxVirtualItemID();
+        else                    m_FocusedItem.SetInt64(uiRow - uiCount + 1);
+    }
+}
+
 /** Delete an item
   * \param rID [input]: the item to delete
   * \return true if the item was deleted, false otherwise
   */
 bool wxVirtualDefaultStateModel::DeleteItem(const wxVirtualItemID &rID)
 {
+    m_VisibleRowIndex.Clear();
     JobDeleteItem j(*this);
     if (m_bAllowRecursion) return(TraverseTreeRecurse(rID, j));
     return(TraverseTreeNoRecurse(rID, j));
@@ -636,6 +769,8 @@ bool wxVirtualDefaultStateModel::Expand(const wxVirtualItemID &rID, bool bExpand
 {
     if (bRecursive)
     {
+        //the whole sub-tree changes : the index is rebuilt lazily
+        m_VisibleRowIndex.Clear();
         if (bExpand)
         {
             JobExpand j(*this);
@@ -651,8 +786,12 @@ bool wxVirtualDefaultStateModel::Expand(const wxVirtualItemID &rID, bool bExpand
     }
 
     int iState = GetState(rID);
+    bool bWasExpanded = WX_IS_EXPANDED(iState);
     if (bExpand) WX_EXPAND(iState); else WX_COLLAPSE(iState);
     SetState(rID, iState);
+
+    //update the index of visible rows
+    if ((m_bUseVisibleRowIndex) && (bWasExpanded != bExpand)) m_VisibleRowIndex.OnExpand(rID, bExpand);
     return(true);
 }
 
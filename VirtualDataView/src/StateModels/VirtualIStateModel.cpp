@@ -108,6 +108,17 @@ wxVirtualItemID FindPrevItemWithState(wxVirtualIStateModel *pStateModel, wxVirtu
 }
 
 //------------------------ GET SELECTED/UNSELECTED ITEMS ------------//
+/** Get the amount of selected items
+  * The default implementation builds the list of selected items. Override it if
+  * the amount can be known without enumerating the items
+  * \return the amount of selected items
+  */
+size_t wxVirtualIStateModel::GetSelectedItemCount(void)
+{
+    wxVirtualItemIDs vIDs;
+    return(GetSelectedItems(vIDs));
+}
+
 /** Get the first selected item
   * \return the 1st selected item
   */
@@ -349,6 +360,19 @@ void wxVirtualIStateModel::GetState(wxVirtualDataViewItemState &rState,
     rState.SetCheckState(GetCheck(rID));
 }
 
+//------------------ VISIBLE ROWS INDEX -----------------------------//
+/** Get the visible row index
+  * \param pDataModel [input]: the data model which will use the index
+  * \return an order statistic index of visible rows, valid for pDataModel
+  *         NULL if the state model does not maintain such an index, or if it was built for
+  *         another data model. In that case, the data model must compute ranks itself
+  * The default implementation returns NULL
+  */
+wxVirtualVisibleRowIndex* wxVirtualIStateModel::GetVisibleRowIndex(wxVirtualIDataModel *pDataModel)
+{
+    return(WX_VDV_NULL_PTR);
+}
+
 //------------------ CALLBACKS --------------------------------------//
 /** Data model has changed
   * \param pDataModel [input]: the new data model
@@ -359,6 +383,42 @@ void wxVirtualIStateModel::OnDataModelChanged(wxVirtualIDataModel* pDataModel)
 
 }
 
+/** The children of an item changed (inserted / removed / re-ordered)
+  * \param rParent [input]: the item whose children changed
+  * The default implementation does nothing
+  */
+void wxVirtualIStateModel::OnChildrenChanged(const wxVirtualItemID &rParent)
+{
+
+}
+
+/** Rows were inserted in a list model : the item IDs of the following rows were shifted
+  * \param rParent [input]: the parent of the new rows (root item of the list)
+  * \param uiFirst [input]: the row index of the 1st new row
+  * \param uiCount [input]: the amount of new rows
+  * The states of the rows >= uiFirst must be moved to the row + uiCount.
+  * Called before OnChildrenChanged(). The default implementation does nothing
+  */
+void wxVirtualIStateModel::OnItemsInserted(const wxVirtualItemID &rParent,
+                                           size_t uiFirst, size_t uiCount)
+{
+
+}
+
+/** Rows were removed from a list model : the item IDs of the following rows were shifted
+  * \param rParent [input]: the parent of the removed rows (root item of the list)
+  * \param uiFirst [input]: the row index of the 1st removed row, before the removal
+  * \param uiCount [input]: the amount of removed rows
+  * The states of the removed rows must be dropped, and the states of the rows >= uiFirst + uiCount
+  * moved to the row - uiCount.
+  * Called before OnChildrenChanged(). The default implementation does nothing
+  */
+void wxVirtualIStateModel::OnItemsRemoved(const wxVirtualItemID &rParent,
+                                          size_t uiFirst, size_t uiCount)
+{
+
+}
+
 /** Delete an item
   * \param rID [input]: the item to delete
   * \return true if the item was deleted, false otherwise
@@ -12,7 +12,7 @@
 //store state on 1 int (actually 5 bits per item are enough)
 //default state : enabled, unselected, unchecked, EXPANDED : value = 0
 //enabled : bit 0 unset disabled : bit 0 set
-//selected : bit 1 set
+//selected : bit 1 set (not stored in the hash map : the selection is stored in m_Selection)
 //collapsed : bit 2 set (this is the reversed default state from wxVirtualDefaultStateModel. Watch out !)
 //check state : bits 3 & 4
 
@@ -85,7 +85,26 @@ size_t wxVirtualListStateModel::GetRowIndex(const wxVirtualItemID &rID) const
     return(DoGetRowIndex(rID));
 }
 
+//------------------------ SELECTION --------------------------------//
+/** Get the row indices of the selected items
+  * \return the set of the row indices of the selected items.
+  *         Use wxVirtualIntervalSet::Iterator for enumerating them one by one
+  */
+const wxVirtualIntervalSet& wxVirtualListStateModel::GetSelection(void) const
+{
+    return(m_Selection);
+}
+
 //-------------------- INTERNAL METHODS -----------------------------//
+/** Get the amount of rows
+  * \return the amount of rows in the data model
+  */
+size_t wxVirtualListStateModel::GetRowCount(void) const
+{
+    if (!m_pDataModel) return(0);
+    return(m_pDataModel->GetChildCount(m_pDataModel->GetRootItem()));
+}
+
 /** Get the state
   * \param rID [input]: the item to query
   * \return the state of the item
@@ -107,6 +126,7 @@ WX_VDV_INLINE int wxVirtualListStateModel::GetState(size_t uiRow) const
 
     int iState = 0;
     if (it != m_MapOfStates.end()) iState = it->second;
+    if (m_Selection.Contains(uiRow)) WX_SELECT(iState);
     return(iState);
 }
 
@@ -126,6 +146,8 @@ WX_VDV_INLINE void wxVirtualListStateModel::SetState(const wxVirtualItemID &rID,
   */
 WX_VDV_INLINE void wxVirtualListStateModel::SetState(size_t uiRow, int iState)
 {
+    m_Selection.Set(uiRow, WX_IS_SELECTED(iState) != 0);
+    WX_DESELECT(iState);
     if (iState == 0)
     {
         m_MapOfStates.erase(uiRow);
@@ -135,6 +157,48 @@ WX_VDV_INLINE void wxVirtualListStateModel::SetState(size_t uiRow, int iState)
     m_MapOfStates[uiRow] = iState;
 }
 
+/** Shift the states after rows were inserted or removed
+  * \param uiFirst   [input]: the row index of the 1st inserted / removed row
+  * \param uiCount   [input]: the amount of inserted / removed rows
+  * \param bInserted [input]: true if the rows were inserted, false if they were removed
+  */
+void wxVirtualListStateModel::ShiftRows(size_t uiFirst, size_t uiCount, bool bInserted)
+{
+    if (uiCount == 0) return;
+    size_t uiEnd = uiFirst + uiCount;
+
+    //selection
+    if (bInserted) m_Selection.InsertRange(uiFirst, uiCount);
+    else           m_Selection.EraseRange(uiFirst, uiCount);
+
+    //other states
+    if (!m_MapOfStates.empty())
+    {
+        THashMapListState oShifted;
+        THashMapListState::iterator it    = m_MapOfStates.begin();
+        THashMapListState::iterator itEnd = m_MapOfStates.end();
+        while(it != itEnd)
+        {
+            size_t uiRow = it->first;
+            if (uiRow < uiFirst)        oShifted[uiRow]           = it->second;
+            else if (bInserted)         oShifted[uiRow + uiCount] = it->second;
+            else if (uiRow >= uiEnd)    oShifted[uiRow - uiCount] = it->second;
+            ++it;
+        }
+        m_MapOfStates = oShifted;
+    }
+
+    //focus
+    if ((m_FocusedItem.IsOK()) && (!m_FocusedItem.IsRootItem()))
+    {
+        size_t uiRow = DoGetRowIndex(m_FocusedItem);
+        if (uiRow < uiFirst) return;
+        if (bInserted)          m_FocusedItem = DoGetItemID(uiRow + uiCount);
+        else if (uiRow < uiEnd) m_FocusedItem = wxVirtualItemID();
+        else                    m_FocusedItem = DoGetItemID(uiRow - uiCount);
+    }
+}
+
 //------ wxVirtualIStateModeL INTERFACE IMPLEMENTATION --------------//
 /** Check if the item is enabled / disabled
   * \param rID [input]: the item to check
@@ -156,8 +220,7 @@ bool wxVirtualListStateModel::IsSelected(const wxVirtualItemID &rID)
 {
     if (rID.IsRootItem()) return(false); //root always deselected
 
-    int iState = GetState(rID);
-    return(WX_IS_SELECTED(iState));
+    return(m_Selection.Contains(DoGetRowIndex(rID)));
 }
 
 /** Check if the item has the focus
@@ -209,22 +272,27 @@ wxVirtualItemID wxVirtualListStateModel::GetFocusedItem(void)
 size_t wxVirtualListStateModel::GetSelectedItems(wxVirtualItemIDs &vIDs)
 {
     vIDs.clear();
-    vIDs.reserve(m_MapOfStates.size());
     if (!m_pDataModel) return(vIDs.size());
+    vIDs.reserve(m_Selection.GetCount());
 
-    int iState;
-    THashMapListState::iterator it    = m_MapOfStates.begin();
-    THashMapListState::iterator itEnd = m_MapOfStates.end();
-    while(it != itEnd)
+    wxVirtualIntervalSet::Iterator it(m_Selection);
+    while(it.IsOK())
     {
-        iState = it->second;
-        if (WX_IS_SELECTED(iState)) vIDs.push_back(DoGetItemID(it->first));
-        ++it;
+        vIDs.push_back(DoGetItemID(it.GetValue()));
+        it.Next();
     }
 
     return(vIDs.size());
 }
 
+/** Get the amount of selected items
+  * \return the amount of currently selected items. O(1)
+  */
+size_t wxVirtualListStateModel::GetSelectedItemCount(void)
+{
+    return(m_Selection.GetCount());
+}
+
 //---------- INTERFACE WITH DEFAULT IMPLEMENTATION ------------------//
 /** Set all states at once
   * \param rState   [input] : the state to set
@@ -280,6 +348,28 @@ void wxVirtualListStateModel::OnDataModelChanged(wxVirtualIDataModel* pDataModel
     m_pDataModel = pDataModel;
 }
 
+/** Rows were inserted : the states of the following rows are shifted
+  * \param rParent [input]: the parent of the new rows
+  * \param uiFirst [input]: the row index of the 1st new row
+  * \param uiCount [input]: the amount of new rows
+  */
+void wxVirtualListStateModel::OnItemsInserted(const wxVirtualItemID &rParent,
+                                              size_t uiFirst, size_t uiCount)
+{
+    ShiftRows(uiFirst, uiCount, true);
+}
+
+/** Rows were removed : the states of the removed rows are dropped, and the following rows are shifted
+  * \param rParent [input]: the parent of the removed rows
+  * \param uiFirst [input]: the row index of the 1st removed row, before the removal
+  * \param uiCount [input]: the amount of removed rows
+  */
+void wxVirtualListStateModel::OnItemsRemoved(const wxVirtualItemID &rParent,
+                                             size_t uiFirst, size_t uiCount)
+{
+    ShiftRows(uiFirst, uiCount, false);
+}
+
 /** Delete an item
   * \param rID [input]: the item to delete
   * \return true if the item was deleted, false otherwise
@@ -288,6 +378,7 @@ bool wxVirtualListStateModel::DeleteItem(const wxVirtualItemID &rID)
 {
     size_t uiRow = DoGetRowIndex(rID);
     m_MapOfStates.erase(uiRow);
+    m_Selection.Remove(uiRow);
     return(true);
 }
 
@@ -346,8 +437,10 @@ bool wxVirtualListStateModel::Enable(const wxVirtualItemID &rID, bool bEnable, b
   */
 bool wxVirtualListStateModel::Select(const wxVirtualItemID &rID, bool bSelect, bool bRecursive)
 {
-    if ((bRecursive) && (rID.IsRootItem()))
+    if (rID.IsRootItem())
     {
+        if (!bRecursive) return(true);
+
         wxVirtualIDataModel *pDataModel = rID.GetTopModel();
         if (!pDataModel)
         {
@@ -357,31 +450,12 @@ bool wxVirtualListStateModel::Select(const wxVirtualItemID &rID, bool bSelect, b
 
         wxVirtualItemID rRoot = pDataModel->GetRootItem();
         size_t uiNbChildren = pDataModel->GetChildCount(rRoot);
-        size_t uiChild;
-        if (bSelect)
-        {
-            for(uiChild = 0; uiChild < uiNbChildren; uiChild++)
-            {
-                int iStateChild = GetState(uiChild);
-                WX_SELECT(iStateChild);
-                SetState(rID, iStateChild);
-            }
-        }
-        else
-        {
-            for(uiChild = 0; uiChild < uiNbChildren; uiChild++)
-            {
-                int iStateChild = GetState(uiChild);
-                WX_DESELECT(iStateChild);
-                SetState(rID, iStateChild);
-            }
-        }
+        m_Selection.Clear();
+        if ((bSelect) && (uiNbChildren > 0)) m_Selection.Add(0, uiNbChildren - 1);
         return(true);
     }
 
-    int iState = GetState(rID);
-    if (bSelect) WX_SELECT(iState); else WX_DESELECT(iState);
-    SetState(rID, iState);
+    m_Selection.Set(DoGetRowIndex(rID), bSelect);
     return(true);
 }
 
@@ -402,25 +476,9 @@ bool wxVirtualListStateModel::SelectRange(const wxVirtualItemID &rID1, const wxV
         uiRow2 = uiSwap;
     };
 
-    size_t uiRow;
-    if (bSelect)
-    {
-        for(uiRow = uiRow1; uiRow <= uiRow2; uiRow++)
-        {
-            int iState = GetState(uiRow);
-            WX_SELECT(iState);
-            SetState(uiRow, iState);
-        }
-    }
-    else
-    {
-        for(uiRow = uiRow1; uiRow <= uiRow2; uiRow++)
-        {
-            int iState = GetState(uiRow);
-            WX_DESELECT(iState);
-            SetState(uiRow, iState);
-        }
-    }
+    //O(k) at most : only the intervals are updated, not the rows
+    if (bSelect) m_Selection.Add(uiRow1, uiRow2);
+    else         m_Selection.Remove(uiRow1, uiRow2);
 
     return(true);
 }
@@ -434,26 +492,10 @@ bool wxVirtualListStateModel::SelectList(const wxVirtualItemIDs &vIDs, bool bSel
 {
     size_t i, uiCount;
     uiCount = vIDs.size();
-
-    if (bSelect)
-    {
-        for(i=0;i<uiCount;i++)
-        {
-            size_t uiRow = DoGetRowIndex(vIDs[i]);
-            int iState = GetState(uiRow);
-            WX_SELECT(iState);
-            SetState(uiRow, iState);
-        }
-    }
-    else
+    for(i=0;i<uiCount;i++)
     {
-        for(i=0;i<uiCount;i++)
-        {
-            size_t uiRow = DoGetRowIndex(vIDs[i]);
-            int iState = GetState(uiRow);
-            WX_DESELECT(iState);
-            SetState(uiRow, iState);
-        }
+        if (vIDs[i].IsRootItem()) continue;
+        m_Selection.Set(DoGetRowIndex(vIDs[i]), bSelect);
     }
 
     return(true);
@@ -464,20 +506,12 @@ bool wxVirtualListStateModel::SelectList(const wxVirtualItemIDs &vIDs, bool bSel
   */
 bool wxVirtualListStateModel::SelectAll(void)
 {
-    wxVirtualIDataModel *pDataModel = m_pDataModel;
-    if (!pDataModel) return(false);
-
-    wxVirtualItemID rIDRoot = pDataModel->GetRootItem();
-    size_t uiChildCount = pDataModel->GetChildCount(rIDRoot);
-
-    size_t uiChild;
-    for(uiChild = 0; uiChild < uiChildCount; uiChild++)
-    {
-        int iState = GetState(uiChild);
-        WX_SELECT(iState);
-        SetState(uiChild, iState);
-    }
+    if (!m_pDataModel) return(false);
 
+    //1 single interval
+    size_t uiRowCount = GetRowCount();
+    m_Selection.Clear();
+    if (uiRowCount > 0) m_Selection.Add(0, uiRowCount - 1);
     return(true);
 }
 
@@ -486,13 +520,7 @@ bool wxVirtualListStateModel::SelectAll(void)
   */
 bool wxVirtualListStateModel::DeselectAll(void)
 {
-    THashMapListState::iterator it      = m_MapOfStates.begin();
-    THashMapListState::iterator itEnd   = m_MapOfStates.end();
-    while (it != itEnd)
-    {
-        WX_DESELECT(it->second);
-        ++it;
-    }
+    m_Selection.Clear();
     return(true);
 }
 
@@ -0,0 +1,425 @@
+/**********************************************************************/
+/** FILE    : VirtualVisibleRowIndex.cpp                             **/
+/** PROJECT : wxVirtualDataViewCtrl                                  **/
+/** LICENSE : wxWindows Library Licence                              **/
+/** PURPOSE : order statistic index of visible rows                  **/
+/**********************************************************************/
+
+#include <wx/VirtualDataView/StateModels/VirtualVisibleRowIndex.h>
+#include <wx/VirtualDataView/StateModels/VirtualIStateModel.h>
+#include <wx/VirtualDataView/Models/VirtualIDataModel.h>
+
+//------------------------ NODE DEFINITION --------------------------//
+/** \struct wxVirtualVisibleRowNode : data of one indexed node
+  * The Fenwick tree is 1-based : m_vTree[0] is unused
+  * The contribution of child i is 1 if the child is collapsed,
+  * 1 + size of its visible sub-tree if it is expanded
+  */
+struct wxVirtualVisibleRowNode
+{
+    wxVector<size_t>    m_vTree;                                                            ///< \brief Fenwick tree of children contributions
+    size_t              m_uiSize;                                                           ///< \brief amount of visible descendants (node excluded)
+    size_t              m_uiHighestBit;                                                     ///< \brief highest power of 2 <= amount of children
+};
+
+//----------------------- CONSTRUCTORS & DESTRUCTOR -----------------//
+/** Constructor
+  * \param pStateModel [input]: the state model giving the expansion states
+  */
+wxVirtualVisibleRowIndex::wxVirtualVisibleRowIndex(wxVirtualIStateModel *pStateModel)
+    : m_pDataModel(WX_VDV_NULL_PTR), m_pStateModel(pStateModel)
+{
+
+}
+
+/** Destructor
+  */
+wxVirtualVisibleRowIndex::~wxVirtualVisibleRowIndex(void)
+{
+    Clear();
+}
+
+//------------------------ MODELS -----------------------------------//
+/** Get the indexed data model
+  * \return the indexed data model
+  */
+wxVirtualIDataModel* wxVirtualVisibleRowIndex::GetDataModel(void) const
+{
+    return(m_pDataModel);
+}
+
+/** Set the indexed data model
+  * \param pDataModel [input]: the new data model. The index is cleared
+  */
+void wxVirtualVisibleRowIndex::SetDataModel(wxVirtualIDataModel *pDataModel)
+{
+    Clear();
+    m_pDataModel = pDataModel;
+}
+
+/** Get the state model
+  * \return the state model giving the expansion states
+  */
+wxVirtualIStateModel* wxVirtualVisibleRowIndex::GetStateModel(void) const
+{
+    return(m_pStateModel);
+}
+
+/** Set the state model
+  * \param pStateModel [input]: the new state model. The index is cleared
+  */
+void wxVirtualVisibleRowIndex::SetStateModel(wxVirtualIStateModel *pStateModel)
+{
+    Clear();
+    m_pStateModel = pStateModel;
+}
+
+//------------------------ MAINTENANCE ------------------------------//
+/** Clear the index
+  * The index will be rebuilt lazily
+  */
+void wxVirtualVisibleRowIndex::Clear(void)
+{
+    THashMapVisibleRowNodes::iterator it    = m_MapOfNodes.begin();
+    THashMapVisibleRowNodes::iterator itEnd = m_MapOfNodes.end();
+    while (it != itEnd)
+    {
+        delete(it->second);
+        ++it;
+    }
+    m_MapOfNodes.clear();
+}
+
+/** Check if the index is empty
+  * \return true if no nodes are indexed
+  */
+bool wxVirtualVisibleRowIndex::IsEmpty(void) const
+{
+    return(m_MapOfNodes.empty());
+}
+
+/** Get the amount of indexed nodes
+  * \return the amount of indexed nodes
+  */
+size_t wxVirtualVisibleRowIndex::GetIndexedNodesCount(void) const
+{
+    return(m_MapOfNodes.size());
+}
+
+/** An item has been expanded / collapsed
+  * \param rID     [input]: the item which has been expanded / collapsed
+  * \param bExpand [input]: true if the item has been expanded, false if it has been collapsed
+  * This must be called after the state of the item has been changed, and only if the state
+  * has actually changed.
+  * O(k + d.log(k)) time for expanding a non-indexed node, O(d.log(k)) otherwise
+  */
+void wxVirtualVisibleRowIndex::OnExpand(const wxVirtualItemID &rID, bool bExpand)
+{
+    //nothing indexed yet : nothing to update
+    if (m_MapOfNodes.empty()) return;
+    if (!m_pDataModel) return;
+
+    wxVirtualVisibleRowNode *pNode = WX_VDV_NULL_PTR;
+    if (bExpand)
+    {
+        //the node stays accurate when collapsed: build it only if it was never indexed
+        pNode = GetNode(rID);
+    }
+    else
+    {
+        //if the node is not indexed, then none of its ancestors counts its sub-tree
+        pNode = FindNode(rID);
+    }
+    if (!pNode) return;
+    if (pNode->m_uiSize == 0) return;
+
+    Propagate(rID, pNode->m_uiSize, bExpand);
+}
+
+/** The children of an item changed
+  * \param rParent [input]: the item whose children were inserted / removed / re-ordered
+  * Only the node of rParent is rebuilt (its indexed expanded children are kept), and the
+  * size change is propagated to its ancestors.
+  * O(k + d.log(k)) time
+  */
+void wxVirtualVisibleRowIndex::OnChildrenChanged(const wxVirtualItemID &rParent)
+{
+    if (!m_pDataModel) return;
+
+    //not indexed : none of its ancestors counts its children
+    THashMapVisibleRowNodes::iterator it = m_MapOfNodes.find(rParent);
+    if (it == m_MapOfNodes.end()) return;
+
+    wxVirtualVisibleRowNode *pNode = it->second;
+    size_t uiOldSize = pNode->m_uiSize;
+    m_MapOfNodes.erase(it);
+    delete(pNode);
+
+    pNode = BuildNode(rParent);
+    if (!pNode) return;
+    if (pNode->m_uiSize == uiOldSize) return;
+
+    //a collapsed item contributes 1 row to its parent, whatever its size
+    if ((!m_pDataModel->IsRootItem(rParent)) && (!m_pStateModel->IsExpanded(rParent))) return;
+    if (pNode->m_uiSize > uiOldSize) Propagate(rParent, pNode->m_uiSize - uiOldSize, true);
+    else                             Propagate(rParent, uiOldSize - pNode->m_uiSize, false);
+}
+
+//------------------------ QUERIES ----------------------------------//
+/** Get the amount of visible items in a sub-tree
+  * \param rID [input]: the root of the sub-tree
+  * \return the amount of visible items in the sub-tree, including rID. Always >= 1
+  */
+size_t wxVirtualVisibleRowIndex::GetSubTreeSize(const wxVirtualItemID &rID)
+{
+    if (!m_pStateModel) return(1);
+    if (!m_pStateModel->IsExpanded(rID)) return(1);
+
+    wxVirtualVisibleRowNode *pNode = GetNode(rID);
+    if (!pNode) return(1);
+    return(pNode->m_uiSize + 1);
+}
+
+/** Get the rank of a visible item
+  * \param rID    [input] : the item to query
+  * \param uiRank [output]: the rank of the item. Root item has rank 0
+  * \return true if the rank was found
+  *         false if the item is not visible (one of its ancestors is collapsed)
+  * O(d.log(k)) time
+  */
+bool wxVirtualVisibleRowIndex::GetItemRank(const wxVirtualItemID &rID, size_t &uiRank)
+{
+    uiRank = 0;
+    if ((!m_pDataModel) || (!m_pStateModel)) return(false);
+
+    wxVirtualItemID id = rID;
+    while (!m_pDataModel->IsRootItem(id))
+    {
+        if (id.IsInvalid()) return(false);
+
+        //parent
+        wxVirtualItemID idParent = m_pDataModel->GetParent(id);
+        if (idParent == id) return(false);
+        if (!m_pStateModel->IsExpanded(idParent)) return(false);
+
+        wxVirtualVisibleRowNode *pNode = GetNode(idParent);
+        if (!pNode) return(false);
+
+        size_t uiChildIndex = m_pDataModel->GetChildIndex(idParent, id);
+        if (uiChildIndex >= pNode->m_vTree.size()) return(false);
+
+        //the parent itself + all the previous siblings with their sub-trees
+        uiRank += PrefixSum(pNode, uiChildIndex) + 1;
+        id = idParent;
+    }
+
+    return(true);
+}
+
+/** Find a visible item from its rank
+  * \param uiRank [input]: the rank of the item. Root item has rank 0
+  * \return the item, or an invalid item if the rank is out of range
+  * O(d.log(k)) time
+  */
+wxVirtualItemID wxVirtualVisibleRowIndex::FindItem(size_t uiRank)
+{
+    if ((!m_pDataModel) || (!m_pStateModel)) return(wxVirtualItemID());
+
+    wxVirtualItemID id = m_pDataModel->GetRootItem();
+    size_t uiRemaining = uiRank;
+    while (uiRemaining > 0)
+    {
+        if (!m_pStateModel->IsExpanded(id)) return(wxVirtualItemID());
+
+        wxVirtualVisibleRowNode *pNode = GetNode(id);
+        if (!pNode) return(wxVirtualItemID());
+        if (uiRemaining > pNode->m_uiSize) return(wxVirtualItemID());
+
+        //skip the node itself, then find the child which contains the rank
+        uiRemaining--;
+        size_t uiChild = Search(pNode, uiRemaining);
+        id = m_pDataModel->GetChild(id, uiChild);
+    }
+
+    return(id);
+}
+
+//------------------------ INTERNAL METHODS -------------------------//
+/** Get an indexed node, without building it
+  * \param rID [input]: the node to find
+  * \return the node if it is indexed, NULL otherwise
+  */
+wxVirtualVisibleRowNode* wxVirtualVisibleRowIndex::FindNode(const wxVirtualItemID &rID) const
+{
+    THashMapVisibleRowNodes::const_iterator it = m_MapOfNodes.find(rID);
+    if (it == m_MapOfNodes.end()) return(WX_VDV_NULL_PTR);
+    return(it->second);
+}
+
+/** Get an indexed node, build it if needed
+  * \param rID [input]: the node to find
+  * \return the indexed node
+  */
+wxVirtualVisibleRowNode* wxVirtualVisibleRowIndex::GetNode(const wxVirtualItemID &rID)
+{
+    wxVirtualVisibleRowNode *pNode = FindNode(rID);
+    if (pNode) return(pNode);
+    return(BuildNode(rID));
+}
+
+/** Build an indexed node
+  * \param rID [input]: the node to build
+  * \return the indexed node
+  * The expanded children are indexed recursively.
+  * O(k) time (k = amount of children) + the time needed to index the expanded children
+  */
+wxVirtualVisibleRowNode* wxVirtualVisibleRowIndex::BuildNode(const wxVirtualItemID &rID)
+{
+    if ((!m_pDataModel) || (!m_pStateModel)) return(WX_VDV_NULL_PTR);
+
+    wxVirtualVisibleRowNode *pNode = new wxVirtualVisibleRowNode;
+    pNode->m_uiSize = 0;
+    pNode->m_uiHighestBit = 0;
+
+    size_t uiNbChildren = m_pDataModel->GetChildCount(rID);
+    pNode->m_vTree.assign(uiNbChildren + 1, 0);
+
+    //root of a list: every child contributes 1 row, the Fenwick tree is known without querying the model
+    size_t i;
+    wxVirtualIDataModel *pBottomModel = m_pDataModel->GetBottomModel();
+    if ((m_pDataModel->IsRootItem(rID)) && (pBottomModel)
+        && (pBottomModel->GetModelClass() & wxVirtualIDataModel::WX_MODEL_CLASS_LIST))
+    {
+        for(i = 1; i <= uiNbChildren; i++) pNode->m_vTree[i] = i & (~i + 1);
+        pNode->m_uiSize = uiNbChildren;
+    }
+    else
+    {
+        //contributions of children
+        for(i = 0; i < uiNbChildren; i++)
+        {
+            size_t uiContribution = 1;
+            wxVirtualItemID idChild = m_pDataModel->GetChild(rID, i);
+            if (m_pStateModel->IsExpanded(idChild))
+            {
+                wxVirtualVisibleRowNode *pChild = GetNode(idChild);
+                if (pChild) uiContribution += pChild->m_uiSize;
+            }
+            pNode->m_vTree[i + 1] = uiContribution;
+            pNode->m_uiSize += uiContribution;
+        }
+
+        //linear construction of the Fenwick tree
+        for(i = 1; i <= uiNbChildren; i++)
+        {
+            size_t j = i + (i & (~i + 1));
+            if (j <= uiNbChildren) pNode->m_vTree[j] += pNode->m_vTree[i];
+        }
+    }
+
+    //highest bit, for searching
+    size_t uiBit = 1;
+    while ((uiBit << 1) <= uiNbChildren) uiBit <<= 1;
+    if (uiNbChildren > 0) pNode->m_uiHighestBit = uiBit;
+
+    m_MapOfNodes[rID] = pNode;
+    return(pNode);
+}
+
+/** Propagate a size change to ancestors
+  * \param rID       [input]: the item whose contribution has changed
+  * \param uiDelta   [input]: the amount of rows added / removed
+  * \param bIncrease [input]: true if rows were added, false if rows were removed
+  * The propagation stops at the 1st ancestor which is collapsed or not indexed
+  */
+void wxVirtualVisibleRowIndex::Propagate(const wxVirtualItemID &rID, size_t uiDelta, bool bIncrease)
+{
+    wxVirtualItemID id = rID;
+    while (!m_pDataModel->IsRootItem(id))
+    {
+        if (id.IsInvalid()) return;
+
+        wxVirtualItemID idParent = m_pDataModel->GetParent(id);
+        if (idParent == id) return;
+
+        wxVirtualVisibleRowNode *pNode = FindNode(idParent);
+        if (!pNode) return;
+
+        size_t uiChildIndex = m_pDataModel->GetChildIndex(idParent, id);
+        if (uiChildIndex >= pNode->m_vTree.size())
+        {
+            //inconsistent with the data model : rebuild everything later
+            Clear();
+            return;
+        }
+
+        Add(pNode, uiChildIndex, uiDelta, bIncrease);
+        if (bIncrease) pNode->m_uiSize += uiDelta;
+        else           pNode->m_uiSize -= uiDelta;
+
+        //a collapsed parent contributes 1 row, whatever its size
+        if (!m_pStateModel->IsExpanded(idParent)) return;
+        id = idParent;
+    }
+}
+
+//------------------------ FENWICK TREE HELPERS ---------------------//
+/** Sum of the uiCount first contributions
+  * \param pNode   [input]: the node
+  * \param uiCount [input]: the amount of children to sum
+  * \return the sum of contributions of children [0, uiCount[
+  */
+size_t wxVirtualVisibleRowIndex::PrefixSum(const wxVirtualVisibleRowNode *pNode, size_t uiCount)
+{
+    size_t uiResult = 0;
+    size_t i = uiCount;
+    while (i > 0)
+    {
+        uiResult += pNode->m_vTree[i];
+        i &= i - 1;
+    }
+    return(uiResult);
+}
+
+/** Add / remove a value to one contribution
+  * \param pNode     [input]: the node
+  * \param uiIndex   [input]: the child index
+  * \param uiDelta   [input]: the value to add / remove
+  * \param bIncrease [input]: true for adding, false for removing
+  */
+void wxVirtualVisibleRowIndex::Add(wxVirtualVisibleRowNode *pNode, size_t uiIndex,
+                                   size_t uiDelta, bool bIncrease)
+{
+    size_t uiSize = pNode->m_vTree.size();
+    size_t i = uiIndex + 1;
+    while (i < uiSize)
+    {
+        if (bIncrease) pNode->m_vTree[i] += uiDelta;
+        else           pNode->m_vTree[i] -= uiDelta;
+        i += i & (~i + 1);
+    }
+}
+
+/** Find the child containing a rank
+  * \param pNode  [input]       : the node
+  * \param uiRank [input/output]: on input, the rank relative to the 1st child (0 = 1st child)
+  *                               on output, the rank relative to the found child (0 = the child itself)
+  * \return the index of the child containing the rank
+  */
+size_t wxVirtualVisibleRowIndex::Search(const wxVirtualVisibleRowNode *pNode, size_t &uiRank)
+{
+    size_t uiPos  = 0;
+    size_t uiSize = pNode->m_vTree.size();
+    size_t uiBit  = pNode->m_uiHighestBit;
+    while (uiBit > 0)
+    {
+        size_t uiNext = uiPos + uiBit;
+        if ((uiNext < uiSize) && (pNode->m_vTree[uiNext] <= uiRank))
+        {
+            uiPos   = uiNext;
+            uiRank -= pNode->m_vTree[uiNext];
+        }
+        uiBit >>= 1;
+    }
+    return(uiPos);
+}
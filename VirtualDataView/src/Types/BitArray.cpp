@@ -0,0 +1,159 @@
+/**********************************************************************/
+/** FILE    : BitArray.cpp                                           **/
+/** PROJECT : wxVirtualDataViewCtrl                                  **/
+/** LICENSE : wxWindows Library Licence                              **/
+/** PURPOSE : a compact array of bits                                **/
+/**********************************************************************/
+
+#include <wx/VirtualDataView/Types/BitArray.h>
+
+//---------------- CONSTRUCTORS & DESTRUCTOR ------------------------//
+/** Constructor
+  * \param uiSize [input]: the amount of bits
+  * \param bValue [input]: the initial value of all bits
+  */
+wxBitArray::wxBitArray(size_t uiSize, bool bValue)
+    : m_uiSize(0)
+{
+    Resize(uiSize, bValue);
+}
+
+/** Destructor
+  */
+wxBitArray::~wxBitArray(void)
+{
+}
+
+//----------------------------- SIZE --------------------------------//
+/** Resize the array. All bits are reset
+  * \param uiSize [input]: the new amount of bits
+  * \param bValue [input]: the value of all bits
+  */
+void wxBitArray::Resize(size_t uiSize, bool bValue)
+{
+    m_uiSize = uiSize;
+    m_vWords.clear();
+    m_vWords.resize((uiSize + 31) >> 5, bValue ? ~wxUint32(0) : 0);
+    ClearUnusedBits();
+}
+
+/** Get the amount of bits
+  * \return the amount of bits
+  */
+size_t wxBitArray::GetSize(void) const
+{
+    return(m_uiSize);
+}
+
+/** Check if the array is empty
+  * \return true if the array has no bits
+  */
+bool wxBitArray::IsEmpty(void) const
+{
+    return(m_uiSize == 0);
+}
+
+/** Release the memory
+  */
+void wxBitArray::Clear(void)
+{
+    m_vWords.clear();
+    m_uiSize = 0;
+}
+
+//---------------------------- ACCESS -------------------------------//
+/** Set all bits
+  * \param bValue [input]: the new value of all bits
+  */
+void wxBitArray::SetAll(bool bValue)
+{
+    wxUint32 uiWord = 0;
+    if (bValue) uiWord = ~wxUint32(0);
+
+    size_t i, uiNbWords;
+    uiNbWords = m_vWords.size();
+    for(i=0;i<uiNbWords;i++) m_vWords[i] = uiWord;
+    ClearUnusedBits();
+}
+
+//------------------------ OPERATIONS -------------------------------//
+/** Bitwise AND with another array of the same size
+  * \param rhs [input]: the other array
+  */
+void wxBitArray::And(const wxBitArray &rhs)
+{
+    size_t i, uiNbWords;
+    uiNbWords = m_vWords.size();
+    if (rhs.m_vWords.size() < uiNbWords) uiNbWords = rhs.m_vWords.size();
+    for(i=0;i<uiNbWords;i++) m_vWords[i] &= rhs.m_vWords[i];
+}
+
+/** Bitwise OR with another array of the same size
+  * \param rhs [input]: the other array
+  */
+void wxBitArray::Or(const wxBitArray &rhs)
+{
+    size_t i, uiNbWords;
+    uiNbWords = m_vWords.size();
+    if (rhs.m_vWords.size() < uiNbWords) uiNbWords = rhs.m_vWords.size();
+    for(i=0;i<uiNbWords;i++) m_vWords[i] |= rhs.m_vWords[i];
+}
+
+/** Count the amount of bits set
+  * \return the amount of bits set
+  */
+size_t wxBitArray::Count(void) const
+{
+    size_t uiCount = 0;
+    size_t i, uiNbWords;
+    uiNbWords = m_vWords.size();
+    for(i=0;i<uiNbWords;i++)
+    {
+        wxUint32 uiWord = m_vWords[i];
+        while (uiWord)
+        {
+            uiWord &= uiWord - 1;
+            uiCount++;
+        }
+    }
+    return(uiCount);
+}
+
+/** Find the next bit set
+  * \param uiStart [input]: the index of the 1st bit to check
+  * \return the index of the 1st bit set, at or after uiStart
+  *         GetSize() if there are no more bits set
+  * Words with no bits set are skipped at once
+  */
+size_t wxBitArray::FindNext(size_t uiStart) const
+{
+    if (uiStart >= m_uiSize) return(m_uiSize);
+
+    size_t uiNbWords = m_vWords.size();
+    size_t uiWordIndex = uiStart >> 5;
+    wxUint32 uiWord = m_vWords[uiWordIndex] & (~wxUint32(0) << (uiStart & 31));
+    while (uiWord == 0)
+    {
+        uiWordIndex++;
+        if (uiWordIndex >= uiNbWords) return(m_uiSize);
+        uiWord = m_vWords[uiWordIndex];
+    }
+
+    size_t uiIndex = uiWordIndex << 5;
+    while (!(uiWord & 1))
+    {
+        uiWord >>= 1;
+        uiIndex++;
+    }
+    return(uiIndex);
+}
+
+//-------------------------- METHODS --------------------------------//
+/** Reset the bits after the end of the array
+  */
+void wxBitArray::ClearUnusedBits(void)
+{
+    size_t uiUsed = m_uiSize & 31;
+    if (uiUsed == 0) return;
+    m_vWords.back() &= (wxUint32(1) << uiUsed) - 1;
+}
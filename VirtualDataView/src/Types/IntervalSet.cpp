@@ -0,0 +1,346 @@
+/**********************************************************************/
+/** FILE    : IntervalSet.cpp                                        **/
+/** PROJECT : wxVirtualDataViewCtrl                                  **/
+/** LICENSE : wxWindows Library Licence                              **/
+/** PURPOSE : a set of integers stored as sorted intervals           **/
+/**********************************************************************/
+
+#include <wx/VirtualDataView/Types/IntervalSet.h>
+
+const size_t wxVirtualIntervalSet::s_uiNotFound = size_t(-1);
+
+//---------------- CONSTRUCTORS & DESTRUCTOR ------------------------//
+/** Constructor
+  */
+wxVirtualIntervalSet::wxVirtualIntervalSet(void)
+    : m_uiCount(0)
+{
+}
+
+/** Destructor
+  */
+wxVirtualIntervalSet::~wxVirtualIntervalSet(void)
+{
+}
+
+//----------------------------- SIZE --------------------------------//
+/** Remove all values & release memory
+  */
+void wxVirtualIntervalSet::Clear(void)
+{
+    m_vIntervals.clear();
+    m_uiCount = 0;
+}
+
+//------------------------ INTERNAL METHODS -------------------------//
+/** Find the first interval which ends at or after a value (binary search)
+  * \param uiValue [input]: the value to look for
+  * \return the index of the 1st interval with m_uiLast >= uiValue
+  *         GetIntervalCount() if there is no such interval
+  */
+size_t wxVirtualIntervalSet::LowerBound(size_t uiValue) const
+{
+    size_t uiLow  = 0;
+    size_t uiHigh = m_vIntervals.size();
+    while(uiLow < uiHigh)
+    {
+        size_t uiMid = uiLow + (uiHigh - uiLow) / 2;
+        if (m_vIntervals[uiMid].m_uiLast < uiValue) uiLow  = uiMid + 1;
+        else                                        uiHigh = uiMid;
+    }
+    return(uiLow);
+}
+
+//---------------------------- ACCESS -------------------------------//
+/** Check if a value is in the set
+  * \param uiValue [input]: the value to check
+  * \return true if the value is in the set
+  */
+bool wxVirtualIntervalSet::Contains(size_t uiValue) const
+{
+    size_t i = LowerBound(uiValue);
+    if (i >= m_vIntervals.size()) return(false);
+    return(m_vIntervals[i].m_uiFirst <= uiValue);
+}
+
+/** Find the first value >= uiStart
+  * \param uiStart [input]: the start value. It is included in the search
+  * \return the first value of the set >= uiStart
+  *         s_uiNotFound if there is no such value
+  */
+size_t wxVirtualIntervalSet::FindNext(size_t uiStart) const
+{
+    size_t i = LowerBound(uiStart);
+    if (i >= m_vIntervals.size()) return(s_uiNotFound);
+    if (m_vIntervals[i].m_uiFirst > uiStart) return(m_vIntervals[i].m_uiFirst);
+    return(uiStart);
+}
+
+/** Find the last value <= uiStart
+  * \param uiStart [input]: the start value. It is included in the search
+  * \return the last value of the set <= uiStart
+  *         s_uiNotFound if there is no such value
+  */
+size_t wxVirtualIntervalSet::FindPrev(size_t uiStart) const
+{
+    size_t i = LowerBound(uiStart);
+    if ((i < m_vIntervals.size()) && (m_vIntervals[i].m_uiFirst <= uiStart)) return(uiStart);
+    if (i == 0) return(s_uiNotFound);
+    return(m_vIntervals[i - 1].m_uiLast);
+}
+
+/** Get the smallest value
+  * \return the smallest value of the set, or s_uiNotFound if the set is empty
+  */
+size_t wxVirtualIntervalSet::GetFirst(void) const
+{
+    if (m_vIntervals.size() == 0) return(s_uiNotFound);
+    return(m_vIntervals[0].m_uiFirst);
+}
+
+/** Get the largest value
+  * \return the largest value of the set, or s_uiNotFound if the set is empty
+  */
+size_t wxVirtualIntervalSet::GetLast(void) const
+{
+    size_t uiSize = m_vIntervals.size();
+    if (uiSize == 0) return(s_uiNotFound);
+    return(m_vIntervals[uiSize - 1].m_uiLast);
+}
+
+//------------------------- MODIFICATIONS ---------------------------//
+/** Add a value
+  * \param uiValue [input]: the value to add
+  */
+void wxVirtualIntervalSet::Add(size_t uiValue)
+{
+    Add(uiValue, uiValue);
+}
+
+/** Add a range of values. Overlapping and adjacent intervals are merged
+  * \param uiFirst [input]: the first value of the range
+  * \param uiLast  [input]: the last value of the range (included)
+  */
+void wxVirtualIntervalSet::Add(size_t uiFirst, size_t uiLast)
+{
+    if (uiFirst > uiLast)
+    {
+        size_t uiSwap = uiFirst;
+        uiFirst = uiLast;
+        uiLast  = uiSwap;
+    }
+
+    //1st interval which overlaps or touches [uiFirst, uiLast]
+    size_t i = 0;
+    if (uiFirst > 0) i = LowerBound(uiFirst - 1);
+    else             i = LowerBound(0);
+
+    //merge all the intervals which overlap or touch the range
+    size_t uiSize    = m_vIntervals.size();
+    size_t uiRemoved = 0;
+    size_t j         = i;
+    TInterval oNew;
+    oNew.m_uiFirst   = uiFirst;
+    oNew.m_uiLast    = uiLast;
+    while(j < uiSize)
+    {
+        const TInterval &rInterval = m_vIntervals[j];
+        if ((rInterval.m_uiFirst > uiLast) && (rInterval.m_uiFirst - 1 != uiLast)) break;
+
+        if (rInterval.m_uiFirst < oNew.m_uiFirst) oNew.m_uiFirst = rInterval.m_uiFirst;
+        if (rInterval.m_uiLast  > oNew.m_uiLast)  oNew.m_uiLast  = rInterval.m_uiLast;
+        uiRemoved += rInterval.m_uiLast - rInterval.m_uiFirst + 1;
+        j++;
+    }
+
+    if (j == i)
+    {
+        m_vIntervals.insert(m_vIntervals.begin() + i, oNew);
+    }
+    else
+    {
+        m_vIntervals[i] = oNew;
+        if (j > i + 1) m_vIntervals.erase(m_vIntervals.begin() + i + 1, m_vIntervals.begin() + j);
+    }
+    m_uiCount += (oNew.m_uiLast - oNew.m_uiFirst + 1) - uiRemoved;
+}
+
+/** Remove a value
+  * \param uiValue [input]: the value to remove
+  */
+void wxVirtualIntervalSet::Remove(size_t uiValue)
+{
+    Remove(uiValue, uiValue);
+}
+
+/** Remove a range of values. Intervals are split if needed
+  * \param uiFirst [input]: the first value of the range
+  * \param uiLast  [input]: the last value of the range (included)
+  */
+void wxVirtualIntervalSet::Remove(size_t uiFirst, size_t uiLast)
+{
+    if (uiFirst > uiLast)
+    {
+        size_t uiSwap = uiFirst;
+        uiFirst = uiLast;
+        uiLast  = uiSwap;
+    }
+
+    size_t uiSize = m_vIntervals.size();
+    size_t i = LowerBound(uiFirst);
+    if (i >= uiSize) return;
+
+    //interval starting before the range : keep its left part
+    TInterval &rFirst = m_vIntervals[i];
+    if ((rFirst.m_uiFirst < uiFirst) && (rFirst.m_uiFirst <= uiLast))
+    {
+        if (rFirst.m_uiLast > uiLast)
+        {
+            //split in 2
+            TInterval oRight;
+            oRight.m_uiFirst = uiLast + 1;
+            oRight.m_uiLast  = rFirst.m_uiLast;
+            rFirst.m_uiLast  = uiFirst - 1;
+            m_uiCount -= uiLast - uiFirst + 1;
+            m_vIntervals.insert(m_vIntervals.begin() + i + 1, oRight);
+            return;
+        }
+
+        m_uiCount -= rFirst.m_uiLast - uiFirst + 1;
+        rFirst.m_uiLast = uiFirst - 1;
+        i++;
+    }
+
+    //intervals fully covered by the range
+    size_t j = i;
+    while(j < uiSize)
+    {
+        TInterval &rInterval = m_vIntervals[j];
+        if (rInterval.m_uiFirst > uiLast) break;
+        if (rInterval.m_uiLast > uiLast)
+        {
+            //interval ending after the range : keep its right part
+            m_uiCount -= uiLast - rInterval.m_uiFirst + 1;
+            rInterval.m_uiFirst = uiLast + 1;
+            break;
+        }
+        m_uiCount -= rInterval.m_uiLast - rInterval.m_uiFirst + 1;
+        j++;
+    }
+
+    if (j > i) m_vIntervals.erase(m_vIntervals.begin() + i, m_vIntervals.begin() + j);
+}
+
+/** Add or remove a value
+  * \param uiValue [input]: the value to add / remove
+  * \param bAdd    [input]: true for adding the value, false for removing it
+  */
+void wxVirtualIntervalSet::Set(size_t uiValue, bool bAdd)
+{
+    if (bAdd) Add(uiValue, uiValue);
+    else      Remove(uiValue, uiValue);
+}
+
+/** Insert values which are not in the set, and shift the following values
+  * Used when rows are inserted : the values >= uiFirst are increased by uiCount.
+  * An interval containing uiFirst is split
+  * \param uiFirst [input]: the first inserted value
+  * \param uiCount [input]: the amount of inserted values
+  */
+void wxVirtualIntervalSet::InsertRange(size_t uiFirst, size_t uiCount)
+{
+    if (uiCount == 0) return;
+
+    size_t uiSize = m_vIntervals.size();
+    size_t i = LowerBound(uiFirst);
+    if (i >= uiSize) return;
+
+    //interval containing uiFirst : split it
+    if (m_vIntervals[i].m_uiFirst < uiFirst)
+    {
+        TInterval oRight;
+        oRight.m_uiFirst = uiFirst;
+        oRight.m_uiLast  = m_vIntervals[i].m_uiLast;
+        m_vIntervals[i].m_uiLast = uiFirst - 1;
+        m_vIntervals.insert(m_vIntervals.begin() + i + 1, oRight);
+        uiSize++;
+        i++;
+    }
+
+    //shift
+    for(; i < uiSize; i++)
+    {
+        m_vIntervals[i].m_uiFirst += uiCount;
+        m_vIntervals[i].m_uiLast  += uiCount;
+    }
+}
+
+/** Erase values, and shift the following values
+  * Used when rows are removed : the values in [uiFirst, uiFirst + uiCount[ are removed, and the
+  * values >= uiFirst + uiCount are decreased by uiCount
+  * \param uiFirst [input]: the first erased value
+  * \param uiCount [input]: the amount of erased values
+  */
+void wxVirtualIntervalSet::EraseRange(size_t uiFirst, size_t uiCount)
+{
+    if (uiCount == 0) return;
+
+    Remove(uiFirst, uiFirst + uiCount - 1);
+
+    //shift : all the intervals from i start after the erased values
+    size_t uiSize = m_vIntervals.size();
+    size_t i = LowerBound(uiFirst);
+    size_t j;
+    for(j = i; j < uiSize; j++)
+    {
+        m_vIntervals[j].m_uiFirst -= uiCount;
+        m_vIntervals[j].m_uiLast  -= uiCount;
+    }
+
+    //the intervals around the erased values may be adjacent now
+    if ((i > 0) && (i < uiSize) && (m_vIntervals[i - 1].m_uiLast + 1 == m_vIntervals[i].m_uiFirst))
+    {
+        m_vIntervals[i - 1].m_uiLast = m_vIntervals[i].m_uiLast;
+        m_vIntervals.erase(m_vIntervals.begin() + i);
+    }
+}
+
+//--------------------------- ITERATOR ------------------------------//
+/** Constructor : start at the first value
+  * \param rSet [input]: the set to enumerate. It must not be modified during the enumeration
+  */
+wxVirtualIntervalSet::Iterator::Iterator(const wxVirtualIntervalSet &rSet)
+    : m_rSet(rSet), m_uiInterval(0), m_uiValue(0)
+{
+    if (m_rSet.GetIntervalCount() > 0) m_uiValue = m_rSet.GetInterval(0).m_uiFirst;
+}
+
+/** Check if the iterator points to a value
+  * \return true if GetValue() can be called, false if the enumeration is finished
+  */
+bool wxVirtualIntervalSet::Iterator::IsOK(void) const
+{
+    return(m_uiInterval < m_rSet.GetIntervalCount());
+}
+
+/** Get the current value
+  * \return the current value
+  */
+size_t wxVirtualIntervalSet::Iterator::GetValue(void) const
+{
+    return(m_uiValue);
+}
+
+/** Go to the next value
+  */
+void wxVirtualIntervalSet::Iterator::Next(void)
+{
+    if (m_uiValue < m_rSet.GetInterval(m_uiInterval).m_uiLast)
+    {
+        m_uiValue++;
+        return;
+    }
+
+    m_uiInterval++;
+    if (m_uiInterval < m_rSet.GetIntervalCount()) m_uiValue = m_rSet.GetInterval(m_uiInterval).m_uiFirst;
+}
@@ -0,0 +1,422 @@
+/**********************************************************************/
+/** FILE    : SortKeys.cpp                                           **/
+/** PROJECT : wxVirtualDataViewCtrl                                  **/
+/** LICENSE : wxWindows Library Licence                              **/
+/** PURPOSE : typed sort keys & radix sorting                        **/
+/**********************************************************************/
+
+
+#include <wx/VirtualDataView/Types/SortKeys.h>
+#include <wx/VirtualDataView/Types/VariantUtils.h>
+#include <wx/VirtualDataView/Types/VariantTypeRegistry.h>
+#include <wx/VirtualDataView/Types/VirtualValue.h>
+#include <string.h>
+#include <algorithm>
+
+#define WX_SORT_KEY_SIGN_BIT        wxULL(0x8000000000000000)
+#define WX_RADIX_BITS               8
+#define WX_RADIX_SIZE               256
+#define WX_RADIX_PASSES             8
+
+//--------------------- KEYS CONVERSION -----------------------------//
+/** Convert a signed integer to an order preserving unsigned key
+  * \param iValue [input]: the value to convert
+  * \return the key
+  */
+WX_VDV_INLINE wxUint64 GetIntegerKey(wxInt64 iValue)
+{
+    return(((wxUint64) iValue) ^ WX_SORT_KEY_SIGN_BIT);
+}
+
+/** Convert a double to an order preserving unsigned key
+  * \param dValue [input]: the value to convert. Must not be NaN
+  * \return the key
+  */
+WX_VDV_INLINE wxUint64 GetDoubleKey(double dValue)
+{
+    if (dValue == 0.0) dValue = 0.0; //-0.0 == +0.0
+
+    wxUint64 uiBits;
+    memcpy(&uiBits, &dValue, sizeof(wxUint64));
+
+    //negative values : reverse the order. Positive values : set the sign bit
+    if (uiBits & WX_SORT_KEY_SIGN_BIT) return(~uiBits);
+    return(uiBits ^ WX_SORT_KEY_SIGN_BIT);
+}
+
+/** Convert a signed integer to an order preserving unsigned key
+  * Comparing 2 keys as unsigned integers gives the same result as comparing the values
+  * \param iValue [input]: the value to convert
+  * \return the key
+  */
+wxUint64 wxGetSortKey(wxInt64 iValue)
+{
+    return(GetIntegerKey(iValue));
+}
+
+/** Convert a double to an order preserving unsigned key
+  * Comparing 2 keys as unsigned integers gives the same result as comparing the values
+  * \param dValue [input]: the value to convert. Must not be NaN
+  * \return the key
+  */
+wxUint64 wxGetSortKey(double dValue)
+{
+    return(GetDoubleKey(dValue));
+}
+
+/** String comparison functor, for ranking interned strings
+  */
+struct TSortKeyStringLess
+{
+    TSortKeyStringLess(const wxVector<wxString> &vStrings) : m_vStrings(vStrings) {}
+
+    WX_VDV_INLINE bool operator()(size_t ui1, size_t ui2) const
+    {
+        return(m_vStrings[ui1].Cmp(m_vStrings[ui2]) < 0);
+    }
+
+    const wxVector<wxString> &m_vStrings;
+};
+
+//--------------------- CONSTRUCTORS & DESTRUCTOR -------------------//
+/** Default constructor
+  */
+wxSortKeysBuilder::wxSortKeysBuilder(void)
+    : m_uiTypeID(WX_VARIANT_TYPE_NULL),
+      m_eKeyType(WX_E_KEY_NONE),
+      m_bDescending(false)
+{
+}
+
+/** Destructor
+  */
+wxSortKeysBuilder::~wxSortKeysBuilder(void)
+{
+}
+
+//------------------------- BUILDING --------------------------------//
+/** Start a new column. Previous values are lost
+  * \param uiCount     [input]: the amount of values which will be added
+  * \param bDescending [input]: true for descending order, false for ascending order
+  */
+void wxSortKeysBuilder::Start(size_t uiCount, bool bDescending)
+{
+    m_vKeys.clear();
+    m_vKeys.reserve(uiCount);
+    m_vStrings.clear();
+    m_MapOfStrings.clear();
+    m_uiTypeID    = WX_VARIANT_TYPE_NULL;
+    m_eKeyType    = WX_E_KEY_NONE;
+    m_bDescending = bDescending;
+}
+
+/** Add the next value of the column
+  * \param rValue [input]: the value to add
+  * \return true on success, false if the value cannot be converted to a key
+  *         In this case, the column cannot be sorted by keys
+  */
+bool wxSortKeysBuilder::Add(const wxVariant &rValue)
+{
+    if (m_eKeyType == WX_E_KEY_INVALID) return(false);
+
+    size_t uiTypeID = wxVariantTypeRegistry::GetTypeID(rValue);
+    if (!CheckType(uiTypeID)) return(false);
+
+    switch(m_eKeyType)
+    {
+        case WX_E_KEY_INTEGER   :
+            if (uiTypeID == WX_VARIANT_TYPE_BOOL) m_vKeys.push_back(rValue.GetBool() ? 1 : 0);
+            else                                  m_vKeys.push_back(GetIntegerKey(rValue.GetLong()));
+            return(true);
+
+        case WX_E_KEY_DOUBLE    :
+            {
+                double dValue = rValue.GetDouble();
+                if (dValue != dValue) break; //NaN : not ordered
+                m_vKeys.push_back(GetDoubleKey(dValue));
+                return(true);
+            }
+
+#if wxUSE_DATETIME
+        case WX_E_KEY_DATETIME  :
+            {
+                wxDateTime dt = rValue.GetDateTime();
+                if (!dt.IsValid()) break;
+                m_vKeys.push_back(GetIntegerKey(dt.GetValue().GetValue()));
+                return(true);
+            }
+#endif // wxUSE_DATETIME
+
+        case WX_E_KEY_STRING    : return(AddString(wxVariantTypeRegistry::ToString(uiTypeID, rValue)));
+
+        case WX_E_KEY_NONE      :
+        case WX_E_KEY_INVALID   :
+        default                 : break;
+    }
+
+    m_eKeyType = WX_E_KEY_INVALID;
+    return(false);
+}
+
+/** Add the next value of the column
+  * Inline values have the key type of the equivalent variant: an integer
+  * is a "long", a string is a "string", ...
+  * \param rValue [input]: the value to add
+  * \return true on success, false if the value cannot be converted to a key
+  *         In this case, the column cannot be sorted by keys
+  */
+bool wxSortKeysBuilder::Add(const wxVirtualValue &rValue)
+{
+    if (m_eKeyType == WX_E_KEY_INVALID) return(false);
+
+    size_t uiTypeID;
+    switch(rValue.GetType())
+    {
+        case wxVirtualValue::WX_VALUE_VARIANT   : return(Add(rValue.GetVariant()));
+        case wxVirtualValue::WX_VALUE_INT64     : uiTypeID = WX_VARIANT_TYPE_LONG;      break;
+        case wxVirtualValue::WX_VALUE_DOUBLE    : uiTypeID = WX_VARIANT_TYPE_DOUBLE;    break;
+        case wxVirtualValue::WX_VALUE_BOOL      : uiTypeID = WX_VARIANT_TYPE_BOOL;      break;
+        case wxVirtualValue::WX_VALUE_DATETIME  : uiTypeID = WX_VARIANT_TYPE_DATETIME;  break;
+        case wxVirtualValue::WX_VALUE_STRING    : uiTypeID = WX_VARIANT_TYPE_STRING;    break;
+        case wxVirtualValue::WX_VALUE_NULL      :
+        default                                 : uiTypeID = WX_VARIANT_TYPE_NULL;      break;
+    }
+    if (!CheckType(uiTypeID)) return(false);
+
+    switch(m_eKeyType)
+    {
+        case WX_E_KEY_INTEGER   :
+            if (uiTypeID == WX_VARIANT_TYPE_BOOL) m_vKeys.push_back(rValue.GetBool() ? 1 : 0);
+            else                                  m_vKeys.push_back(GetIntegerKey(rValue.GetInt64()));
+            return(true);
+
+        case WX_E_KEY_DOUBLE    :
+            {
+                double dValue = rValue.GetDouble();
+                if (dValue != dValue) break; //NaN : not ordered
+                m_vKeys.push_back(GetDoubleKey(dValue));
+                return(true);
+            }
+
+#if wxUSE_DATETIME
+        case WX_E_KEY_DATETIME  :
+            {
+                wxDateTime dt = rValue.GetDateTime();
+                if (!dt.IsValid()) break;
+                m_vKeys.push_back(GetIntegerKey(dt.GetValue().GetValue()));
+                return(true);
+            }
+#endif // wxUSE_DATETIME
+
+        case WX_E_KEY_STRING    : return(AddString(rValue.GetStringRef()));
+
+        case WX_E_KEY_NONE      :
+        case WX_E_KEY_INVALID   :
+        default                 : break;
+    }
+
+    m_eKeyType = WX_E_KEY_INVALID;
+    return(false);
+}
+
+/** Get the keys of the column
+  * \param vKeys [output]: the keys, in the order of the values. Previous content is lost
+  * \return true on success, false if the column cannot be sorted by keys
+  */
+bool wxSortKeysBuilder::Finish(TSortKeys &vKeys)
+{
+    vKeys.clear();
+    if (m_eKeyType == WX_E_KEY_INVALID) return(false);
+    if (m_eKeyType == WX_E_KEY_STRING) RankStrings();
+
+    size_t i, uiSize;
+    uiSize = m_vKeys.size();
+    vKeys.reserve(uiSize);
+    if (m_bDescending)
+    {
+        for(i=0;i<uiSize;i++) vKeys.push_back(~m_vKeys[i]);
+    }
+    else
+    {
+        for(i=0;i<uiSize;i++) vKeys.push_back(m_vKeys[i]);
+    }
+
+    m_vKeys.clear();
+    m_vStrings.clear();
+    m_MapOfStrings.clear();
+    return(true);
+}
+
+/** Get the type of keys
+  * \return the type of keys of the current column
+  */
+wxSortKeysBuilder::EKeyType wxSortKeysBuilder::GetKeyType(void) const
+{
+    return(m_eKeyType);
+}
+
+//--------------------------- METHODS -------------------------------//
+/** Get the key type of a variant type
+  * \param uiTypeID [input]: the variant type ID, from wxVariantTypeRegistry::GetTypeID()
+  * \return the key type. WX_E_KEY_INVALID if the variant type is not supported
+  */
+wxSortKeysBuilder::EKeyType wxSortKeysBuilder::GetKeyType(size_t uiTypeID) const
+{
+    switch(uiTypeID)
+    {
+        case WX_VARIANT_TYPE_LONG               : return(WX_E_KEY_INTEGER);
+        case WX_VARIANT_TYPE_BOOL               : return(WX_E_KEY_INTEGER);
+        case WX_VARIANT_TYPE_DOUBLE             : return(WX_E_KEY_DOUBLE);
+#if wxUSE_DATETIME
+        case WX_VARIANT_TYPE_DATETIME           : return(WX_E_KEY_DATETIME);
+#endif // wxUSE_DATETIME
+        case WX_VARIANT_TYPE_STRING             : return(WX_E_KEY_STRING);
+        case WX_VARIANT_TYPE_BITMAP_TEXT        : return(WX_E_KEY_STRING);
+#if WX_USE_COMPATIBILITY_LAYER_WITH_DVC != 0
+        case WX_VARIANT_TYPE_DATAVIEW_ICON_TEXT : return(WX_E_KEY_STRING);
+#endif // WX_USE_COMPATIBILITY_LAYER_WITH_DVC
+        default                                 : break;
+    }
+    return(WX_E_KEY_INVALID);
+}
+
+/** Check the type of the next value
+  * The type of the 1st value is the type of the column
+  * \param uiTypeID [input]: the variant type ID of the value
+  * \return true if the value can be added, false if the column cannot be sorted by keys
+  */
+bool wxSortKeysBuilder::CheckType(size_t uiTypeID)
+{
+    if (m_eKeyType == WX_E_KEY_NONE)
+    {
+        m_uiTypeID = uiTypeID;
+        m_eKeyType = GetKeyType(uiTypeID);
+        if (m_eKeyType == WX_E_KEY_INVALID) return(false);
+    }
+    else if (uiTypeID != m_uiTypeID)
+    {
+        m_eKeyType = WX_E_KEY_INVALID;
+        return(false);
+    }
+    return(true);
+}
+
+/** Add a string value
+  * \param sValue [input]: the value to add
+  * \return true
+  */
+bool wxSortKeysBuilder::AddString(const wxString &sValue)
+{
+    THashMapSortKeyStrings::iterator it = m_MapOfStrings.find(sValue);
+    if (it != m_MapOfStrings.end())
+    {
+        m_vKeys.push_back(it->second);
+        return(true);
+    }
+
+    size_t uiIndex = m_vStrings.size();
+    m_vStrings.push_back(sValue);
+    m_MapOfStrings[sValue] = uiIndex;
+    m_vKeys.push_back(uiIndex);
+    return(true);
+}
+
+/** Replace string indices by ranks.
+  * Only the unique strings are sorted: O(u.log(u)) string comparisons, u = amount of unique strings
+  */
+void wxSortKeysBuilder::RankStrings(void)
+{
+    size_t i, uiSize;
+    uiSize = m_vStrings.size();
+
+    TSortPermutation vOrder;
+    vOrder.reserve(uiSize);
+    for(i=0;i<uiSize;i++) vOrder.push_back(i);
+
+    TSortKeyStringLess oLess(m_vStrings);
+    std::sort(vOrder.begin(), vOrder.end(), oLess);
+
+    //equal strings are interned once, so the ranks are unique
+    TSortKeys vRanks(uiSize, 0);
+    for(i=0;i<uiSize;i++) vRanks[vOrder[i]] = i;
+
+    uiSize = m_vKeys.size();
+    for(i=0;i<uiSize;i++) m_vKeys[i] = vRanks[(size_t) m_vKeys[i]];
+}
+
+//----------------------- RADIX SORT --------------------------------//
+/** Stable sort of a permutation by keys (LSD radix sort, 8 bits digits)
+  * \param vKeys        [input]: the keys. vKeys[i] is the key of the item i
+  * \param vPermutation [input / output]: on input, the current order of the items
+  *                                       on output, the items sorted by ascending keys.
+  *                                       Items with equal keys keep their input order
+  * O(n) time, O(n) space. Passes on which all items have the same digit are skipped.
+  * Sorting on several keys is done by calling this method once per key, from the least
+  * significant key to the most significant one
+  */
+void wxRadixSortPermutation(const TSortKeys &vKeys, TSortPermutation &vPermutation)
+{
+    size_t uiSize = vPermutation.size();
+    if (uiSize < 2) return;
+
+    size_t i, uiPass;
+    TSortKeys        vKeys1, vKeys2(uiSize, 0);
+    TSortPermutation vPerm2(uiSize, 0);
+    vKeys1.reserve(uiSize);
+    for(i=0;i<uiSize;i++) vKeys1.push_back(vKeys[vPermutation[i]]);
+
+    //all histograms in 1 pass
+    size_t vCounts[WX_RADIX_PASSES][WX_RADIX_SIZE];
+    memset(vCounts, 0, sizeof(vCounts));
+    for(i=0;i<uiSize;i++)
+    {
+        wxUint64 uiKey = vKeys1[i];
+        for(uiPass=0;uiPass<WX_RADIX_PASSES;uiPass++)
+        {
+            vCounts[uiPass][uiKey & (WX_RADIX_SIZE - 1)]++;
+            uiKey >>= WX_RADIX_BITS;
+        }
+    }
+
+    wxUint64 *pKeysSrc = &vKeys1[0];
+    wxUint64 *pKeysDst = &vKeys2[0];
+    size_t   *pPermSrc = &vPermutation[0];
+    size_t   *pPermDst = &vPerm2[0];
+    for(uiPass=0;uiPass<WX_RADIX_PASSES;uiPass++)
+    {
+        size_t uiShift = uiPass * WX_RADIX_BITS;
+        size_t *pCounts = vCounts[uiPass];
+
+        //all items have the same digit : nothing to do
+        size_t uiFirstDigit = (size_t) ((pKeysSrc[0] >> uiShift) & (WX_RADIX_SIZE - 1));
+        if (pCounts[uiFirstDigit] == uiSize) continue;
+
+        //offsets
+        size_t uiOffset = 0;
+        size_t d;
+        for(d=0;d<WX_RADIX_SIZE;d++)
+        {
+            size_t uiCount = pCounts[d];
+            pCounts[d] = uiOffset;
+            uiOffset += uiCount;
+        }
+
+        //scatter
+        for(i=0;i<uiSize;i++)
+        {
+            size_t uiDigit = (size_t) ((pKeysSrc[i] >> uiShift) & (WX_RADIX_SIZE - 1));
+            size_t uiPos   = pCounts[uiDigit]++;
+            pKeysDst[uiPos] = pKeysSrc[i];
+            pPermDst[uiPos] = pPermSrc[i];
+        }
+
+        std::swap(pKeysSrc, pKeysDst);
+        std::swap(pPermSrc, pPermDst);
+    }
+
+    //copy back the result if it ended in the temporary buffer
+    if (pPermSrc != &vPermutation[0])
+    {
+        for(i=0;i<uiSize;i++) vPermutation[i] = pPermSrc[i];
+    }
+}
@@ -0,0 +1,522 @@
+/**********************************************************************/
+/** FILE    : VariantTypeRegistry.cpp                                **/
+/** PROJECT : wxVirtualDataViewCtrl                                  **/
+/** LICENSE : wxWindows Library Licence                              **/
+/** PURPOSE : integer IDs & functions for wxVariant types            **/
+/**********************************************************************/
+
+
+#include <wx/VirtualDataView/Types/VariantTypeRegistry.h>
+#include <wx/VirtualDataView/Types/BitmapText.h>
+#include <wx/thread.h>
+#include <string.h>
+#if WX_USE_COMPATIBILITY_LAYER_WITH_DVC != 0
+    #include <wx/dataview.h>
+#endif // WX_USE_COMPATIBILITY_LAYER_WITH_DVC
+
+//-------------------------- STATIC DATA ----------------------------//
+wxVector<wxVariantTypeRegistry::TTypeEntry> wxVariantTypeRegistry::ms_vTypes;
+wxVariantTypeRegistry::TClassTable          wxVariantTypeRegistry::ms_EmptyClasses;
+wxVariantTypeRegistry::TClassTable*         wxVariantTypeRegistry::ms_pClasses = &wxVariantTypeRegistry::ms_EmptyClasses;
+bool                                        wxVariantTypeRegistry::ms_bInitialized = false;
+
+#if wxUSE_THREADS != 0
+static wxCriticalSection s_RegistryLock;                                    ///< \brief protects the registration & the class cache updates
+#endif // wxUSE_THREADS
+
+//all the class caches ever published: a reader may still use a replaced one
+static wxVector<void*> s_vClassTables;
+
+//---------------------- COMPARISON FUNCTIONS -----------------------//
+/** Convert the result of a 3 ways comparison
+  * \param iRes [input]: < 0, 0 or > 0
+  * \return the comparison result
+  */
+WX_VDV_INLINE EVariantComparison ToComparison(int iRes)
+{
+    if (iRes < 0) return(WX_VARIANT_LESS_THAN);
+    if (iRes > 0) return(WX_VARIANT_GREATER_THAN);
+    return(WX_VARIANT_EQUAL);
+}
+
+/** Compare 2 scalar values
+  * \param v1 [input]: the 1st value
+  * \param v2 [input]: the 2nd value
+  * \return the comparison result
+  */
+template<typename T>
+WX_VDV_INLINE EVariantComparison CompareScalars(const T &v1, const T &v2)
+{
+    if (v1 < v2) return(WX_VARIANT_LESS_THAN);
+    if (v2 < v1) return(WX_VARIANT_GREATER_THAN);
+    return(WX_VARIANT_EQUAL);
+}
+
+static EVariantComparison CompareString(const wxVariant &rValue1, const wxVariant &rValue2)
+{
+    return(ToComparison(rValue1.GetString().Cmp(rValue2.GetString())));
+}
+
+static EVariantComparison CompareLong(const wxVariant &rValue1, const wxVariant &rValue2)
+{
+    return(CompareScalars(rValue1.GetLong(), rValue2.GetLong()));
+}
+
+static EVariantComparison CompareDouble(const wxVariant &rValue1, const wxVariant &rValue2)
+{
+    return(CompareScalars(rValue1.GetDouble(), rValue2.GetDouble()));
+}
+
+static EVariantComparison CompareBool(const wxVariant &rValue1, const wxVariant &rValue2)
+{
+    //false < true
+    int i1 = rValue1.GetBool() ? 1 : 0;
+    int i2 = rValue2.GetBool() ? 1 : 0;
+    return(CompareScalars(i1, i2));
+}
+
+static EVariantComparison CompareChar(const wxVariant &rValue1, const wxVariant &rValue2)
+{
+    long l1 = (long) rValue1.GetChar().GetValue();
+    long l2 = (long) rValue2.GetChar().GetValue();
+    return(CompareScalars(l1, l2));
+}
+
+#if wxUSE_LONGLONG
+static EVariantComparison CompareLongLong(const wxVariant &rValue1, const wxVariant &rValue2)
+{
+    return(CompareScalars(rValue1.GetLongLong(), rValue2.GetLongLong()));
+}
+
+static EVariantComparison CompareULongLong(const wxVariant &rValue1, const wxVariant &rValue2)
+{
+    return(CompareScalars(rValue1.GetULongLong(), rValue2.GetULongLong()));
+}
+#endif // wxUSE_LONGLONG
+
+#if wxUSE_DATETIME
+static EVariantComparison CompareDateTime(const wxVariant &rValue1, const wxVariant &rValue2)
+{
+    wxDateTime dt1 = rValue1.GetDateTime();
+    wxDateTime dt2 = rValue2.GetDateTime();
+    if (dt1.IsEarlierThan(dt2)) return(WX_VARIANT_LESS_THAN);
+    if (dt2.IsEarlierThan(dt1)) return(WX_VARIANT_GREATER_THAN);
+    return(WX_VARIANT_EQUAL);
+}
+#endif // wxUSE_DATETIME
+
+static EVariantComparison CompareBitmapText(const wxVariant &rValue1, const wxVariant &rValue2)
+{
+    wxBitmapText bt1;
+    wxBitmapText bt2;
+    bt1 << rValue1;
+    bt2 << rValue2;
+    return(ToComparison(bt1.GetText().Cmp(bt2.GetText())));
+}
+
+#if WX_USE_COMPATIBILITY_LAYER_WITH_DVC != 0
+static EVariantComparison CompareIconText(const wxVariant &rValue1, const wxVariant &rValue2)
+{
+    wxDataViewIconText it1;
+    wxDataViewIconText it2;
+    it1 << rValue1;
+    it2 << rValue2;
+    return(ToComparison(it1.GetText().Cmp(it2.GetText())));
+}
+#endif // WX_USE_COMPATIBILITY_LAYER_WITH_DVC
+
+//---------------------- CONVERSION FUNCTIONS -----------------------//
+static wxString BitmapTextToString(const wxVariant &rValue)
+{
+    wxBitmapText bt;
+    bt << rValue;
+    return(bt.GetText());
+}
+
+#if WX_USE_COMPATIBILITY_LAYER_WITH_DVC != 0
+static wxString IconTextToString(const wxVariant &rValue)
+{
+    wxDataViewIconText it;
+    it << rValue;
+    return(it.GetText());
+}
+#endif // WX_USE_COMPATIBILITY_LAYER_WITH_DVC
+
+static bool LongToDouble(const wxVariant &rValue, double &rdResult)
+{
+    rdResult = (double) rValue.GetLong();
+    return(true);
+}
+
+static bool DoubleToDouble(const wxVariant &rValue, double &rdResult)
+{
+    rdResult = rValue.GetDouble();
+    return(true);
+}
+
+static bool BoolToDouble(const wxVariant &rValue, double &rdResult)
+{
+    rdResult = rValue.GetBool() ? 1.0 : 0.0; //can convert to 0 or 1
+    return(true);
+}
+
+static bool CharToDouble(const wxVariant &rValue, double &rdResult)
+{
+    rdResult = (double) rValue.GetChar().GetValue();
+    return(true);
+}
+
+static bool VoidPtrToDouble(const wxVariant &rValue, double &rdResult)
+{
+    rdResult = (double) (size_t) rValue.GetVoidPtr();
+    return(true);
+}
+
+#if wxUSE_LONGLONG
+static bool LongLongToDouble(const wxVariant &rValue, double &rdResult)
+{
+    rdResult = rValue.GetLongLong().ToDouble();
+    return(true);
+}
+
+static bool ULongLongToDouble(const wxVariant &rValue, double &rdResult)
+{
+    rdResult = rValue.GetULongLong().ToDouble();
+    return(true);
+}
+#endif // wxUSE_LONGLONG
+
+#if wxUSE_DATETIME
+static bool DateTimeToDouble(const wxVariant &rValue, double &rdResult)
+{
+    wxDateTime dt = rValue.GetDateTime();
+    if (!dt.IsValid()) return(false);
+    rdResult = dt.GetValue().ToDouble();
+    return(true);
+}
+#endif // wxUSE_DATETIME
+
+//------------------------ HASH FUNCTIONS ---------------------------//
+/** Fold a 64 bits value to an unsigned long
+  * \param uiValue [input]: the value to fold
+  * \return the hash value
+  */
+WX_VDV_INLINE unsigned long FoldHash(wxUint64 uiValue)
+{
+    if (sizeof(unsigned long) >= sizeof(wxUint64)) return((unsigned long) uiValue);
+    return((unsigned long) (uiValue ^ (uiValue >> 32)));
+}
+
+static unsigned long HashString(const wxVariant &rValue)
+{
+    return(wxStringHash::stringHash(rValue.GetString().wx_str()));
+}
+
+static unsigned long HashLong(const wxVariant &rValue)
+{
+    return((unsigned long) rValue.GetLong());
+}
+
+static unsigned long HashBool(const wxVariant &rValue)
+{
+    return(rValue.GetBool() ? 1 : 0);
+}
+
+static unsigned long HashChar(const wxVariant &rValue)
+{
+    return((unsigned long) rValue.GetChar().GetValue());
+}
+
+static unsigned long HashDouble(const wxVariant &rValue)
+{
+    double dValue = rValue.GetDouble();
+    if (dValue == 0.0) dValue = 0.0; //-0.0 == +0.0
+
+    wxUint64 uiBits;
+    memcpy(&uiBits, &dValue, sizeof(wxUint64));
+    return(FoldHash(uiBits));
+}
+
+#if wxUSE_LONGLONG
+static unsigned long HashLongLong(const wxVariant &rValue)
+{
+    return(FoldHash((wxUint64) rValue.GetLongLong().GetValue()));
+}
+
+static unsigned long HashULongLong(const wxVariant &rValue)
+{
+    return(FoldHash((wxUint64) rValue.GetULongLong().GetValue()));
+}
+#endif // wxUSE_LONGLONG
+
+//---------------------- REGISTRATION HELPER ------------------------//
+/** Build a set of type functions
+  * \param pCompare  [input]: the comparison function
+  * \param pToString [input]: the string conversion function
+  * \param pToDouble [input]: the numeric conversion function
+  * \param pHash     [input]: the hashing function
+  * \return the set of functions
+  */
+static wxVariantTypeRegistry::TTypeFunctions MakeFunctions(wxVariantTypeRegistry::TCompareFunction pCompare,
+                                                           wxVariantTypeRegistry::TToStringFunction pToString,
+                                                           wxVariantTypeRegistry::TToDoubleFunction pToDouble,
+                                                           wxVariantTypeRegistry::THashFunction pHash)
+{
+    wxVariantTypeRegistry::TTypeFunctions oFunctions;
+    oFunctions.m_pCompare  = pCompare;
+    oFunctions.m_pToString = pToString;
+    oFunctions.m_pToDouble = pToDouble;
+    oFunctions.m_pHash     = pHash;
+    return(oFunctions);
+}
+
+/** \class wxVariantTypeRegistryInitializer : register the predefined types at startup,
+  * and release the class caches at exit
+  */
+class wxVariantTypeRegistryInitializer
+{
+    public:
+        wxVariantTypeRegistryInitializer(void)
+        {
+            wxVariantTypeRegistry::GetTypeCount();
+        }
+
+        ~wxVariantTypeRegistryInitializer(void)
+        {
+            wxVariantTypeRegistry::ReleaseClassTables();
+        }
+};
+static wxVariantTypeRegistryInitializer s_RegistryInitializer;
+
+//----------------------------- TYPE IDs ----------------------------//
+/** Get the type ID of a type name
+  * \param sType [input]: the type name, as returned by wxVariant::GetType()
+  * \return the type ID. WX_VARIANT_TYPE_UNKNOWN if the type is not registered
+  */
+size_t wxVariantTypeRegistry::GetTypeID(const wxString &sType)
+{
+#if wxUSE_THREADS != 0
+    wxCriticalSectionLocker oLock(s_RegistryLock);
+#endif // wxUSE_THREADS
+    Initialize();
+    return(FindTypeID(sType));
+}
+
+/** Get the name of a type
+  * \param uiTypeID [input]: the type ID
+  * \return the type name. Empty string for WX_VARIANT_TYPE_NULL, WX_VARIANT_TYPE_UNKNOWN
+  *         and invalid IDs
+  */
+wxString wxVariantTypeRegistry::GetTypeName(size_t uiTypeID)
+{
+#if wxUSE_THREADS != 0
+    wxCriticalSectionLocker oLock(s_RegistryLock);
+#endif // wxUSE_THREADS
+    Initialize();
+    if (uiTypeID >= ms_vTypes.size()) return(wxEmptyString);
+    return(ms_vTypes[uiTypeID].m_sName);
+}
+
+/** Get the amount of registered types
+  * \return the amount of registered types, including WX_VARIANT_TYPE_NULL & WX_VARIANT_TYPE_UNKNOWN
+  */
+size_t wxVariantTypeRegistry::GetTypeCount(void)
+{
+#if wxUSE_THREADS != 0
+    wxCriticalSectionLocker oLock(s_RegistryLock);
+#endif // wxUSE_THREADS
+    Initialize();
+    return(ms_vTypes.size());
+}
+
+//--------------------------- REGISTRATION --------------------------//
+/** Register a type, or replace the functions of a registered type
+  * Must be called from the main thread, before values of this type are used in other threads
+  * \param sType      [input]: the type name, as returned by wxVariant::GetType()
+  * \param rFunctions [input]: the functions of the type
+  * \return the type ID
+  */
+size_t wxVariantTypeRegistry::RegisterType(const wxString &sType, const TTypeFunctions &rFunctions)
+{
+#if wxUSE_THREADS != 0
+    wxCriticalSectionLocker oLock(s_RegistryLock);
+#endif // wxUSE_THREADS
+    Initialize();
+
+    size_t uiTypeID = FindTypeID(sType);
+    if (uiTypeID != WX_VARIANT_TYPE_UNKNOWN)
+    {
+        ms_vTypes[uiTypeID].m_Functions = rFunctions;
+        return(uiTypeID);
+    }
+
+    TTypeEntry oEntry;
+    oEntry.m_sName      = sType;
+    oEntry.m_Functions  = rFunctions;
+    ms_vTypes.push_back(oEntry);
+
+    //classes of this type were cached as WX_VARIANT_TYPE_UNKNOWN
+    PublishClassTable(&ms_EmptyClasses);
+    return(ms_vTypes.size() - 1);
+}
+
+//------------------------------ HASHING ----------------------------//
+/** Hash a value
+  * \param uiTypeID [input]: the type ID of the value, from GetTypeID()
+  * \param rValue   [input]: the value
+  * \return the hash value. Values which compare equal have the same hash value
+  */
+unsigned long wxVariantTypeRegistry::Hash(size_t uiTypeID, const wxVariant &rValue)
+{
+    THashFunction pHash = GetTypeFunctions(uiTypeID).m_pHash;
+    if (pHash) return(pHash(rValue));
+    return(wxStringHash::stringHash(ToString(uiTypeID, rValue).wx_str()));
+}
+
+//------------------------- INTERNAL METHODS ------------------------//
+/** Register the predefined types. The lock must be held by the caller
+  * The order of the registration must match EVariantTypeID
+  */
+void wxVariantTypeRegistry::Initialize(void)
+{
+    if (ms_bInitialized) return;
+
+    TTypeEntry oEntry;
+    ms_vTypes.clear();
+    ms_vTypes.reserve(WX_VARIANT_TYPE_FIRST_CUSTOM);
+
+#define WX_REGISTER_TYPE(NAME, COMPARE, TO_STRING, TO_DOUBLE, HASH)             \
+    oEntry.m_sName     = NAME;                                                  \
+    oEntry.m_Functions = MakeFunctions(COMPARE, TO_STRING, TO_DOUBLE, HASH);    \
+    ms_vTypes.push_back(oEntry);
+
+    WX_REGISTER_TYPE(wxEmptyString,     WX_VDV_NULL_PTR,    WX_VDV_NULL_PTR,    WX_VDV_NULL_PTR,    WX_VDV_NULL_PTR);
+    WX_REGISTER_TYPE(wxEmptyString,     WX_VDV_NULL_PTR,    WX_VDV_NULL_PTR,    WX_VDV_NULL_PTR,    WX_VDV_NULL_PTR);
+    WX_REGISTER_TYPE(wxT("string"),     CompareString,      WX_VDV_NULL_PTR,    WX_VDV_NULL_PTR,    HashString);
+    WX_REGISTER_TYPE(wxT("long"),       CompareLong,        WX_VDV_NULL_PTR,    LongToDouble,       HashLong);
+    WX_REGISTER_TYPE(wxT("double"),     CompareDouble,      WX_VDV_NULL_PTR,    DoubleToDouble,     HashDouble);
+    WX_REGISTER_TYPE(wxT("bool"),       CompareBool,        WX_VDV_NULL_PTR,    BoolToDouble,       HashBool);
+    WX_REGISTER_TYPE(wxT("char"),       CompareChar,        WX_VDV_NULL_PTR,    CharToDouble,       HashChar);
+#if wxUSE_DATETIME
+    WX_REGISTER_TYPE(wxT("datetime"),   CompareDateTime,    WX_VDV_NULL_PTR,    DateTimeToDouble,   WX_VDV_NULL_PTR);
+#else
+    WX_REGISTER_TYPE(wxT("datetime"),   WX_VDV_NULL_PTR,    WX_VDV_NULL_PTR,    WX_VDV_NULL_PTR,    WX_VDV_NULL_PTR);
+#endif // wxUSE_DATETIME
+#if wxUSE_LONGLONG
+    WX_REGISTER_TYPE(wxT("longlong"),   CompareLongLong,    WX_VDV_NULL_PTR,    LongLongToDouble,   HashLongLong);
+    WX_REGISTER_TYPE(wxT("ulonglong"),  CompareULongLong,   WX_VDV_NULL_PTR,    ULongLongToDouble,  HashULongLong);
+#else
+    WX_REGISTER_TYPE(wxT("longlong"),   WX_VDV_NULL_PTR,    WX_VDV_NULL_PTR,    WX_VDV_NULL_PTR,    WX_VDV_NULL_PTR);
+    WX_REGISTER_TYPE(wxT("ulonglong"),  WX_VDV_NULL_PTR,    WX_VDV_NULL_PTR,    WX_VDV_NULL_PTR,    WX_VDV_NULL_PTR);
+#endif // wxUSE_LONGLONG
+    WX_REGISTER_TYPE(wxT("void*"),      WX_VDV_NULL_PTR,    WX_VDV_NULL_PTR,    VoidPtrToDouble,    WX_VDV_NULL_PTR);
+    WX_REGISTER_TYPE(wxT("list"),       WX_VDV_NULL_PTR,    WX_VDV_NULL_PTR,    WX_VDV_NULL_PTR,    WX_VDV_NULL_PTR);
+    WX_REGISTER_TYPE(wxT("arrstring"),  WX_VDV_NULL_PTR,    WX_VDV_NULL_PTR,    WX_VDV_NULL_PTR,    WX_VDV_NULL_PTR);
+    WX_REGISTER_TYPE(wxT("wxBitmapText"), CompareBitmapText, BitmapTextToString, WX_VDV_NULL_PTR,   WX_VDV_NULL_PTR);
+#if WX_USE_COMPATIBILITY_LAYER_WITH_DVC != 0
+    WX_REGISTER_TYPE(wxT("wxDataViewIconText"), CompareIconText, IconTextToString, WX_VDV_NULL_PTR, WX_VDV_NULL_PTR);
+#else
+    WX_REGISTER_TYPE(wxT("wxDataViewIconText"), WX_VDV_NULL_PTR, WX_VDV_NULL_PTR, WX_VDV_NULL_PTR,  WX_VDV_NULL_PTR);
+#endif // WX_USE_COMPATIBILITY_LAYER_WITH_DVC
+    WX_REGISTER_TYPE(wxT("wxBitmap"),   WX_VDV_NULL_PTR,    WX_VDV_NULL_PTR,    WX_VDV_NULL_PTR,    WX_VDV_NULL_PTR);
+    WX_REGISTER_TYPE(wxT("wxIcon"),     WX_VDV_NULL_PTR,    WX_VDV_NULL_PTR,    WX_VDV_NULL_PTR,    WX_VDV_NULL_PTR);
+    WX_REGISTER_TYPE(wxT("wxImage"),    WX_VDV_NULL_PTR,    WX_VDV_NULL_PTR,    WX_VDV_NULL_PTR,    WX_VDV_NULL_PTR);
+    WX_REGISTER_TYPE(wxT("wxColour"),   WX_VDV_NULL_PTR,    WX_VDV_NULL_PTR,    WX_VDV_NULL_PTR,    WX_VDV_NULL_PTR);
+
+#undef WX_REGISTER_TYPE
+
+    PublishClassTable(&ms_EmptyClasses);
+    ms_bInitialized = true;
+}
+
+/** Find a type by name. The lock must be held by the caller
+  * \param sType [input]: the type name
+  * \return the type ID. WX_VARIANT_TYPE_UNKNOWN if the type is not registered
+  */
+size_t wxVariantTypeRegistry::FindTypeID(const wxString &sType)
+{
+    size_t i, uiCount;
+    uiCount = ms_vTypes.size();
+    for(i=WX_VARIANT_TYPE_STRING;i<uiCount;i++)
+    {
+        if (ms_vTypes[i].m_sName == sType) return(i);
+    }
+    return(WX_VARIANT_TYPE_UNKNOWN);
+}
+
+/** Get the type ID of a variant data which is not in the class cache, and add it to the cache
+  * Any thread can add a class: the current cache is copied with the new entry, and the copy
+  * is published. The replaced caches are kept until exit, since readers may still use them
+  * \param pData  [input]: the variant data. Must not be NULL
+  * \param pClass [input]: the class key of pData
+  * \return the type ID
+  */
+size_t wxVariantTypeRegistry::GetTypeIDSlow(const wxVariantData *pData, const void *pClass)
+{
+    wxString sType = pData->GetType();
+
+#if wxUSE_THREADS != 0
+    wxCriticalSectionLocker oLock(s_RegistryLock);
+#endif // wxUSE_THREADS
+    Initialize();
+
+    size_t uiTypeID = FindTypeID(sType);
+
+    //another thread may have added the class meanwhile
+    const TClassTable *pTable = ms_pClasses;
+    size_t i, uiCount;
+    uiCount = pTable->m_uiCount;
+    for(i=0;i<uiCount;i++)
+    {
+        if (pTable->m_vEntries[i].m_pClass == pClass) return(pTable->m_vEntries[i].m_uiTypeID);
+    }
+    if (uiCount >= WX_CLASS_CACHE_SIZE) return(uiTypeID);
+
+    TClassTable *pNewTable = new TClassTable(*pTable);
+    pNewTable->m_vEntries[uiCount].m_pClass   = pClass;
+    pNewTable->m_vEntries[uiCount].m_uiTypeID = uiTypeID;
+    pNewTable->m_uiCount = uiCount + 1;
+    s_vClassTables.push_back(pNewTable);
+
+    PublishClassTable(pNewTable);
+    return(uiTypeID);
+}
+
+/** Get the current class cache, with lock. Used when the platform has no acquire load
+  * \return the current class cache. Never NULL
+  */
+const wxVariantTypeRegistry::TClassTable* wxVariantTypeRegistry::LoadClassTableLocked(void)
+{
+#if wxUSE_THREADS != 0
+    wxCriticalSectionLocker oLock(s_RegistryLock);
+#endif // wxUSE_THREADS
+    return(ms_pClasses);
+}
+
+/** Replace the current class cache (release store). The lock must be held by the caller
+  * \param pTable [input]: the new class cache. It must not be modified after this call
+  */
+void wxVariantTypeRegistry::PublishClassTable(TClassTable *pTable)
+{
+#if wxUSE_THREADS == 0
+    ms_pClasses = pTable;
+#elif defined(__clang__) || (defined(__GNUC__) && ((__GNUC__ > 4) || ((__GNUC__ == 4) && (__GNUC_MINOR__ >= 7))))
+    __atomic_store_n(&ms_pClasses, pTable, __ATOMIC_RELEASE);
+#elif defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
+    *static_cast<TClassTable* volatile*>(&ms_pClasses) = pTable;
+#else
+    ms_pClasses = pTable; //the readers use LoadClassTableLocked()
+#endif
+}
+
+/** Release all the class caches. Called at exit, when no other thread uses the registry
+  */
+void wxVariantTypeRegistry::ReleaseClassTables(void)
+{
+    ms_pClasses = &ms_EmptyClasses;
+
+    size_t i, uiCount;
+    uiCount = s_vClassTables.size();
+    for(i=0;i<uiCount;i++) delete(static_cast<TClassTable*>(s_vClassTables[i]));
+    s_vClassTables.clear();
+}
@@ -7,9 +7,7 @@
 
 
 #include <wx/VirtualDataView/Types/VariantUtils.h>
-#if WX_USE_COMPATIBILITY_LAYER_WITH_DVC != 0
-    #include <wx/dataview.h>
-#endif // WX_USE_COMPATIBILITY_LAYER_WITH_DVC
+#include <wx/VirtualDataView/Types/VariantTypeRegistry.h>
 
 /** Convert a variant to string
   * \param rvValue [input]: the variant to convert
@@ -17,39 +15,27 @@
   */
 wxString GetStringValue(const wxVariant &rvValue)
 {
-    if (rvValue.GetType() == "wxBitmapText")
-    {
-        wxBitmapText bt;
-        bt << rvValue;
-        return(bt.GetText());
-    }
-
-#if WX_USE_COMPATIBILITY_LAYER_WITH_DVC != 0
-    if (rvValue.GetType() == "wxDataViewIconText")
-    {
-        wxDataViewIconText it;
-        it << rvValue;
-        return(it.GetText());
-    }
-#endif // WX_USE_COMPATIBILITY_LAYER_WITH_DVC
-    return(rvValue.GetString());
+    size_t uiTypeID = wxVariantTypeRegistry::GetTypeID(rvValue);
+    return(wxVariantTypeRegistry::ToString(uiTypeID, rvValue));
 }
 
 //----------------- VARIANT COMPARISON METHOD -----------------------//
+/** Check if a variant can be converted to a number
+  * \param rvValue [input]: the variant to check
+  * \return true if the variant is numeric ("bool", "char", "datetime", "double", "long", ...)
+  */
+bool IsNumericType(const wxVariant &rvValue)
+{
+    return(wxVariantTypeRegistry::IsNumeric(wxVariantTypeRegistry::GetTypeID(rvValue)));
+}
+
+/** Check if a variant type can be converted to a number
+  * \param sType [input]: the type name, as returned by wxVariant::GetType()
+  * \return true if the type is numeric ("bool", "char", "datetime", "double", "long", ...)
+  */
 bool IsNumericType(const wxString &sType)
 {
-    if (sType == "bool")        return(true); //can convert to 0 or 1
-    if (sType == "char")        return(true);
-    if (sType == "datetime")    return(true);
-    if (sType == "double")      return(true);
-    if (sType == "list")        return(false);
-    if (sType == "long")        return(true);
-    if (sType == "longlong")    return(true);
-    if (sType == "string")      return(false);
-    if (sType == "ulonglong")   return(true);
-    if (sType == "arrstring")   return(false);
-    if (sType == "void*")       return(true);
-    return(false);
+    return(wxVariantTypeRegistry::IsNumeric(wxVariantTypeRegistry::GetTypeID(sType)));
 }
 
 /** Compare 2 variants. Both variants are assumed to be of the same type
@@ -58,7 +44,10 @@ bool IsNumericType(const wxString &sType)
   * \param bAssumeSameType  [input]: if true, both variant are assumed to be of the same type,
   *                                  and the type of vValue1 is used for the comparison type.
   *                                  if false, both variants type are checked, and
-  *                                  WX_VARIANT_CANNOT_COMPARE is returned if they are incompatible
+  *                                  WX_VARIANT_CANNOT_COMPARE is returned if they are incompatible.
+  *                                  2 numeric variants of different types are compared as doubles.
+  *                                  2 comparable non-numeric variants of different types
+  *                                  ("string", "wxBitmapText", ...) are compared by their text
   * \return WX_VARIANT_LESS_THAN     if vValue1 < vValue2
   *         WX_VARIANT_EQUAL         if vValue1 == vValue2
   *         WX_VARIANT_GREATER_THAN  if vValue1 > vValue2
@@ -67,96 +56,38 @@ bool IsNumericType(const wxString &sType)
 EVariantComparison CompareVariants(const wxVariant &vValue1, const wxVariant &vValue2,
                                    bool bAssumeSameType)
 {
-    wxString sType1 = vValue1.GetType();
+    size_t uiType1 = wxVariantTypeRegistry::GetTypeID(vValue1);
     if (!bAssumeSameType)
     {
-        wxString sType2 = vValue2.GetType();
-        if (sType1 != sType2)
+        size_t uiType2 = wxVariantTypeRegistry::GetTypeID(vValue2);
+        if (uiType1 != uiType2)
         {
-            bool bNumeric1 = IsNumericType(sType1);
-            bool bNumeric2 = IsNumericType(sType2);
-            if ((bNumeric1) && (!bNumeric2)) return(WX_VARIANT_CANNOT_COMPARE);
-            if ((!bNumeric1) && (bNumeric2)) return(WX_VARIANT_CANNOT_COMPARE);
+            bool bNumeric1 = wxVariantTypeRegistry::IsNumeric(uiType1);
+            bool bNumeric2 = wxVariantTypeRegistry::IsNumeric(uiType2);
+            if (bNumeric1 != bNumeric2) return(WX_VARIANT_CANNOT_COMPARE);
+            if (!bNumeric1)
+            {
+                //text-like types : compare their text
+                if (!wxVariantTypeRegistry::GetTypeFunctions(uiType1).m_pCompare) return(WX_VARIANT_CANNOT_COMPARE);
+                if (!wxVariantTypeRegistry::GetTypeFunctions(uiType2).m_pCompare) return(WX_VARIANT_CANNOT_COMPARE);
+                wxString s1 = wxVariantTypeRegistry::ToString(uiType1, vValue1);
+                wxString s2 = wxVariantTypeRegistry::ToString(uiType2, vValue2);
+                int iRes = s1.Cmp(s2);
+                if (iRes < 0) return(WX_VARIANT_LESS_THAN);
+                if (iRes > 0) return(WX_VARIANT_GREATER_THAN);
+                return(WX_VARIANT_EQUAL);
+            }
+
+            double d1, d2;
+            if (!wxVariantTypeRegistry::ToDouble(uiType1, vValue1, d1)) return(WX_VARIANT_CANNOT_COMPARE);
+            if (!wxVariantTypeRegistry::ToDouble(uiType2, vValue2, d2)) return(WX_VARIANT_CANNOT_COMPARE);
+            if (d1 < d2) return(WX_VARIANT_LESS_THAN);
+            if (d1 > d2) return(WX_VARIANT_GREATER_THAN);
+            return(WX_VARIANT_EQUAL);
         }
     }
 
-    if (sType1 == wxT("string"))
-    {
-        wxString str1 = vValue1.GetString();
-        wxString str2 = vValue2.GetString();
-        int res = str1.Cmp(str2);
-        if (res < 0) return(WX_VARIANT_LESS_THAN); //str1.Cmp(str2) returns a positive value if str1 > str2
-        if (res > 0) return(WX_VARIANT_GREATER_THAN);
-        return(WX_VARIANT_EQUAL);
-    }
-    else if (sType1 == wxT("long"))
-    {
-        long l1 = vValue1.GetLong();
-        long l2 = vValue2.GetLong();
-        if (l1 < l2) return(WX_VARIANT_LESS_THAN);
-        if (l1 > l2) return(WX_VARIANT_GREATER_THAN);
-        return(WX_VARIANT_EQUAL);
-    }
-    else if (sType1 == wxT("double"))
-    {
-        double f1 = vValue1.GetDouble();
-        double f2 = vValue2.GetDouble();
-        if (f1 < f2) return(WX_VARIANT_LESS_THAN);
-        if (f1 > f2) return(WX_VARIANT_GREATER_THAN);
-        return(WX_VARIANT_EQUAL);
-    }
-
-#if wxUSE_DATETIME
-    else if (sType1 == wxT("datetime"))
-    {
-        wxDateTime dt1 = vValue1.GetDateTime();
-        wxDateTime dt2 = vValue2.GetDateTime();
-        if (dt1.IsEarlierThan(dt2)) return(WX_VARIANT_LESS_THAN);
-        if (dt2.IsEarlierThan(dt1)) return(WX_VARIANT_GREATER_THAN);
-        return(WX_VARIANT_EQUAL);
-    }
-#endif // wxUSE_DATETIME
-
-    else if (sType1 == wxT("bool"))
-    {
-        bool b1 = vValue1.GetBool();
-        bool b2 = vValue2.GetBool();
-
-        //false < true
-        if ((!b1) && (b2)) return(WX_VARIANT_LESS_THAN);
-        if ((b1) && (!b2)) return(WX_VARIANT_GREATER_THAN);
-        return(WX_VARIANT_EQUAL);
-    }
-    else if (sType1 == wxT("wxBitmapText"))
-    {
-        wxBitmapText bt1;
-        wxBitmapText bt2;
-
-        bt1 << vValue1;
-        bt2 << vValue2;
-
-        int res = bt1.GetText().Cmp(bt2.GetText());
-        if (res < 0) return(WX_VARIANT_LESS_THAN); //str1.Cmp(str2) returns a positive value if str1 > str2
-        if (res > 0) return(WX_VARIANT_GREATER_THAN);
-        return(WX_VARIANT_EQUAL);
-    }
-#if WX_USE_COMPATIBILITY_LAYER_WITH_DVC != 0
-    else if (sType1 == wxT("wxDataViewIconText"))
-    {
-        wxBitmapText bt1;
-        wxBitmapText bt2;
-
-        bt1 << vValue1;
-        bt2 << vValue2;
-
-        int res = bt1.GetText().Cmp(bt2.GetText());
-        if (res < 0) return(WX_VARIANT_LESS_THAN); //str1.Cmp(str2) returns a positive value if str1 > str2
-        if (res > 0) return(WX_VARIANT_GREATER_THAN);
-        return(WX_VARIANT_EQUAL);
-    }
-#endif // WX_USE_COMPATIBILITY_LAYER_WITH_DVC
-
-    return(WX_VARIANT_CANNOT_COMPARE);
+    return(wxVariantTypeRegistry::Compare(uiType1, vValue1, vValue2));
 }
 
 /** Return true if vValue1 < vValue2
@@ -172,87 +103,43 @@ EVariantComparison CompareVariants(const wxVariant &vValue1, const wxVariant &vV
   */
 int IsVariantLessThan(const wxVariant &vValue1, const wxVariant &vValue2, bool bAssumeSameType)
 {
-    wxString sType1 = vValue1.GetType();
-    if (!bAssumeSameType)
-    {
-        wxString sType2 = vValue2.GetType();
-        if (sType1 != sType2)
-        {
-            bool bNumeric1 = IsNumericType(sType1);
-            bool bNumeric2 = IsNumericType(sType2);
-            if ((bNumeric1) && (!bNumeric2)) return(-1);
-            if ((!bNumeric1) && (bNumeric2)) return(-1);
-        }
-    }
-
-    if (sType1 == wxT("string"))
-    {
-        wxString str1 = vValue1.GetString();
-        wxString str2 = vValue2.GetString();
-        int res = str1.Cmp(str2);
-        if (res < 0) return(1); //str1.Cmp(str2) returns a positive value if str1 > str2
-        return(0);
-    }
-    else if (sType1 == wxT("long"))
-    {
-        long l1 = vValue1.GetLong();
-        long l2 = vValue2.GetLong();
-        if (l1 < l2) return(1);
-        return(0);
-    }
-    else if (sType1 == wxT("double"))
-    {
-        double f1 = vValue1.GetDouble();
-        double f2 = vValue2.GetDouble();
-        if (f1 < f2) return(1);
-        return(0);
-    }
-
-#if wxUSE_DATETIME
-    else if (sType1 == wxT("datetime"))
-    {
-        wxDateTime dt1 = vValue1.GetDateTime();
-        wxDateTime dt2 = vValue2.GetDateTime();
-        if (dt1.IsEarlierThan(dt2)) return(1);
-        return(0);
-    }
-#endif // wxUSE_DATETIME
-
-    else if (sType1 == wxT("bool"))
-    {
-        bool b1 = vValue1.GetBool();
-        bool b2 = vValue2.GetBool();
+    EVariantComparison eRes = CompareVariants(vValue1, vValue2, bAssumeSameType);
+    if (eRes == WX_VARIANT_LESS_THAN) return(1);
+    if (eRes == WX_VARIANT_CANNOT_COMPARE) return(-1);
+    return(0);
+}
 
-        //false < true
-        if ((!b1) && (b2)) return(1);
-        return(0);
-    }
-    else if (sType1 == wxT("wxBitmapText"))
-    {
-        wxBitmapText bt1;
-        wxBitmapText bt2;
+//------------------------------ HASHING ----------------------------//
+/** Hash a variant
+  * \param vValue [input]: the variant to hash
+  * \return the hash value. Variants for which AreVariantsEqual() returns true have the same hash value
+  */
+unsigned long GetVariantHash(const wxVariant &vValue)
+{
+    size_t uiTypeID = wxVariantTypeRegistry::GetTypeID(vValue);
+    return(wxVariantTypeRegistry::Hash(uiTypeID, vValue));
+}
 
-        bt1 << vValue1;
-        bt2 << vValue2;
+/** Return true if vValue1 == vValue2
+  * Variants of different types are different. Variants which cannot be compared
+  * are equal if their string values are equal
+  * \param vValue1 [input]: the 1st variant
+  * \param vValue2 [input]: the 2nd variant
+  * \return true if both variants are equal
+  */
+bool AreVariantsEqual(const wxVariant &vValue1, const wxVariant &vValue2)
+{
+    size_t uiType1 = wxVariantTypeRegistry::GetTypeID(vValue1);
+    size_t uiType2 = wxVariantTypeRegistry::GetTypeID(vValue2);
+    if (uiType1 != uiType2) return(false);
 
-        int res = bt1.GetText().Cmp(bt2.GetText());
-        if (res < 0) return(1); //str1.Cmp(str2) returns a positive value if str1 > str2
-        return(0);
-    }
-#if WX_USE_COMPATIBILITY_LAYER_WITH_DVC != 0
-    else if (sType1 == wxT("wxDataViewIconText"))
+    EVariantComparison eRes = wxVariantTypeRegistry::Compare(uiType1, vValue1, vValue2);
+    if (eRes == WX_VARIANT_CANNOT_COMPARE)
     {
-        wxBitmapText bt1;
-        wxBitmapText bt2;
-
-        bt1 << vValue1;
-        bt2 << vValue2;
-
-        int res = bt1.GetText().Cmp(bt2.GetText());
-        if (res < 0) return(1); //str1.Cmp(str2) returns a positive value if str1 > str2
-        return(0);
+        wxString s1 = wxVariantTypeRegistry::ToString(uiType1, vValue1);
+        wxString s2 = wxVariantTypeRegistry::ToString(uiType2, vValue2);
+        return(s1 == s2);
     }
-#endif // WX_USE_COMPATIBILITY_LAYER_WITH_DVC
-
-    return(-1);
+    if (eRes == WX_VARIANT_EQUAL) return(true);
+    return(false);
 }
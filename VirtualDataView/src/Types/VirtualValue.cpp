@@ -0,0 +1,149 @@
+/**********************************************************************/
+/** FILE    : VirtualValue.cpp                                       **/
+/** PROJECT : wxVirtualDataViewCtrl                                  **/
+/** LICENSE : wxWindows Library Licence                              **/
+/** PURPOSE : a lightweight tagged value                             **/
+/**********************************************************************/
+
+
+#include <wx/VirtualDataView/Types/VirtualValue.h>
+
+//------------------------ HELPERS ----------------------------------//
+/** Compare 2 scalar values
+  * \param v1 [input]: the 1st value
+  * \param v2 [input]: the 2nd value
+  * \return the comparison result
+  */
+template<typename T>
+WX_VDV_INLINE EVariantComparison CompareValues(T v1, T v2)
+{
+    if (v1 < v2) return(WX_VARIANT_LESS_THAN);
+    if (v2 < v1) return(WX_VARIANT_GREATER_THAN);
+    return(WX_VARIANT_EQUAL);
+}
+
+//----------------------- CONVERSIONS -------------------------------//
+/** Convert to an integer
+  * \param rResult [output]: the value as an integer
+  * \return true on success, false if the value is not an integer or a boolean
+  */
+bool wxVirtualValue::ToInt64(wxInt64 &rResult) const
+{
+    switch(m_eType)
+    {
+        case WX_VALUE_INT64     : rResult = m_iValue; return(true);
+        case WX_VALUE_BOOL      : rResult = m_bValue ? 1 : 0; return(true);
+        default                 : break;
+    }
+    return(false);
+}
+
+/** Convert to a double
+  * \param rResult [output]: the value as a double
+  * \return true on success, false if the value is not numeric
+  */
+bool wxVirtualValue::ToDouble(double &rResult) const
+{
+    switch(m_eType)
+    {
+        case WX_VALUE_INT64     : rResult = (double) m_iValue; return(true);
+        case WX_VALUE_DOUBLE    : rResult = m_dValue; return(true);
+        case WX_VALUE_BOOL      : rResult = m_bValue ? 1.0 : 0.0; return(true);
+        case WX_VALUE_DATETIME  : rResult = (double) m_iValue; return(true);
+        default                 : break;
+    }
+    return(false);
+}
+
+/** Convert to a string
+  * The result is the same as GetStringValue(ToVariant())
+  * \return the value as a string
+  */
+wxString wxVirtualValue::GetString(void) const
+{
+    switch(m_eType)
+    {
+        case WX_VALUE_NULL      : return(wxEmptyString);
+        case WX_VALUE_STRING    : return(*m_pString);
+        case WX_VALUE_VARIANT   : return(GetStringValue(m_vValue));
+        default                 : break;
+    }
+    return(ToVariant().GetString());
+}
+
+/** Convert to a wxVariant
+  * Integers which fit in a long are converted to a "long" variant, other integers to "longlong"
+  * \return the value as a wxVariant
+  */
+wxVariant wxVirtualValue::ToVariant(void) const
+{
+    switch(m_eType)
+    {
+        case WX_VALUE_INT64     :
+            {
+                long lValue = (long) m_iValue;
+                if (((wxInt64) lValue) == m_iValue) return(wxVariant(lValue));
+#if wxUSE_LONGLONG
+                return(wxVariant(wxLongLong(m_iValue)));
+#else
+                return(wxVariant((double) m_iValue));
+#endif // wxUSE_LONGLONG
+            }
+
+        case WX_VALUE_DOUBLE    : return(wxVariant(m_dValue));
+        case WX_VALUE_BOOL      : return(wxVariant(m_bValue));
+#if wxUSE_DATETIME
+        case WX_VALUE_DATETIME  : return(wxVariant(GetDateTime()));
+#endif // wxUSE_DATETIME
+        case WX_VALUE_STRING    : return(wxVariant(*m_pString));
+        case WX_VALUE_VARIANT   : return(m_vValue);
+        case WX_VALUE_NULL      :
+        default                 : break;
+    }
+    return(wxVariant());
+}
+
+//------------------------ COMPARISON -------------------------------//
+/** Compare 2 values
+  * Values of the same inline type are compared directly. Numbers of different types are compared
+  * as doubles. Values stored in wxVariant are compared with CompareVariants()
+  * \param rhs [input]: the value to compare with
+  * \return WX_VARIANT_LESS_THAN     if this < rhs
+  *         WX_VARIANT_EQUAL         if this == rhs
+  *         WX_VARIANT_GREATER_THAN  if this > rhs
+  *         WX_VARIANT_CANNOT_COMPARE if the values cannot be compared
+  */
+EVariantComparison wxVirtualValue::Compare(const wxVirtualValue &rhs) const
+{
+    if (m_eType == rhs.m_eType)
+    {
+        switch(m_eType)
+        {
+            case WX_VALUE_INT64     : return(CompareValues(m_iValue, rhs.m_iValue));
+            case WX_VALUE_DOUBLE    : return(CompareValues(m_dValue, rhs.m_dValue));
+            case WX_VALUE_BOOL      : return(CompareValues(m_bValue ? 1 : 0, rhs.m_bValue ? 1 : 0));
+            case WX_VALUE_DATETIME  : return(CompareValues(m_iValue, rhs.m_iValue));
+            case WX_VALUE_STRING    :
+                {
+                    int iRes = m_pString->Cmp(*rhs.m_pString);
+                    if (iRes < 0) return(WX_VARIANT_LESS_THAN);
+                    if (iRes > 0) return(WX_VARIANT_GREATER_THAN);
+                    return(WX_VARIANT_EQUAL);
+                }
+            case WX_VALUE_VARIANT   : return(CompareVariants(m_vValue, rhs.m_vValue, false));
+            case WX_VALUE_NULL      :
+            default                 : return(WX_VARIANT_CANNOT_COMPARE);
+        }
+    }
+
+    if ((IsNumeric()) && (rhs.IsNumeric()))
+    {
+        double d1, d2;
+        ToDouble(d1);
+        rhs.ToDouble(d2);
+        return(CompareValues(d1, d2));
+    }
+
+    if ((m_eType == WX_VALUE_NULL) || (rhs.m_eType == WX_VALUE_NULL)) return(WX_VARIANT_CANNOT_COMPARE);
+    return(CompareVariants(ToVariant(), rhs.ToVariant(), false));
+}
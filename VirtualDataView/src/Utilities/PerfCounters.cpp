@@ -0,0 +1,209 @@
+/**********************************************************************/
+/** FILE    : PerfCounters.cpp                                       **/
+/** PROJECT : wxVirtualDataViewCtrl                                  **/
+/** LICENSE : wxWindows Library Licence                              **/
+/** PURPOSE : run-time switchable timers & performance counters      **/
+/**********************************************************************/
+
+#include <wx/VirtualDataView/Utilities/PerfCounters.h>
+#include <wx/time.h>
+#ifdef __WXMSW__
+    #include <wx/msw/wrapwin.h>
+#else
+    #include <time.h>
+#endif // __WXMSW__
+
+//----------------------------- DATA --------------------------------//
+bool        wxVirtualPerfCounters::ms_bEnabled = false;
+wxLongLong  wxVirtualPerfCounters::ms_vTotalTimes[WX_PERF_TIMER_COUNT];
+wxLongLong  wxVirtualPerfCounters::ms_vLastTimes[WX_PERF_TIMER_COUNT];
+size_t      wxVirtualPerfCounters::ms_vCalls[WX_PERF_TIMER_COUNT];
+size_t      wxVirtualPerfCounters::ms_vCounters[WX_PERF_COUNTER_COUNT];
+size_t      wxVirtualPerfCounters::ms_vFrameStart[WX_PERF_COUNTER_COUNT];
+size_t      wxVirtualPerfCounters::ms_vLastFrame[WX_PERF_COUNTER_COUNT];
+
+/** Convert microseconds to milliseconds
+  * \param llMicroSeconds [input]: the duration in microseconds
+  * \return the duration in milliseconds
+  */
+WX_VDV_INLINE double ToMilliSeconds(wxLongLong llMicroSeconds)
+{
+    return(llMicroSeconds.ToDouble() / 1000.0);
+}
+
+/** Compute a throughput
+  * \param uiCount        [input]: amount of processed items
+  * \param llMicroSeconds [input]: the time spent
+  * \return the amount of items per second. 0 if no time was measured
+  */
+WX_VDV_INLINE double GetItemsPerSecond(size_t uiCount, wxLongLong llMicroSeconds)
+{
+    if (llMicroSeconds <= 0) return(0.0);
+    return(((double) uiCount) * 1000000.0 / llMicroSeconds.ToDouble());
+}
+
+//------------------------ RUN-TIME SWITCH --------------------------//
+/** Enable / disable the counters
+  * \param bEnable [input]: true for enabling the counters, false for disabling them
+  *                         The values are kept when the counters are disabled
+  */
+void wxVirtualPerfCounters::Enable(bool bEnable)
+{
+    ms_bEnabled = bEnable;
+}
+
+/** Reset all timers & counters
+  */
+void wxVirtualPerfCounters::Reset(void)
+{
+    size_t i;
+    for(i=0;i<WX_PERF_TIMER_COUNT;i++)
+    {
+        ms_vTotalTimes[i]   = 0;
+        ms_vLastTimes[i]    = 0;
+        ms_vCalls[i]        = 0;
+    }
+    for(i=0;i<WX_PERF_COUNTER_COUNT;i++)
+    {
+        ms_vCounters[i]     = 0;
+        ms_vFrameStart[i]   = 0;
+        ms_vLastFrame[i]    = 0;
+    }
+}
+
+//----------------------------- UPDATE ------------------------------//
+/** Get the current time in microseconds
+  * A monotonic clock is used when available, so that the measures are not affected by
+  * changes of the system clock. The origin of the time is unspecified: only differences
+  * are meaningful
+  * \return the current time, in microseconds
+  */
+wxLongLong wxVirtualPerfCounters::Now(void)
+{
+#ifdef __WXMSW__
+    static LARGE_INTEGER s_Frequency = {0};
+    if (s_Frequency.QuadPart == 0) ::QueryPerformanceFrequency(&s_Frequency);
+    LARGE_INTEGER oCounter;
+    if ((s_Frequency.QuadPart > 0) && (::QueryPerformanceCounter(&oCounter)))
+    {
+        wxLongLong llSeconds = oCounter.QuadPart / s_Frequency.QuadPart;
+        wxLongLong llRemain  = oCounter.QuadPart % s_Frequency.QuadPart;
+        return(llSeconds * 1000000 + (llRemain * 1000000) / s_Frequency.QuadPart);
+    }
+#elif defined(CLOCK_MONOTONIC)
+    struct timespec oTime;
+    if (clock_gettime(CLOCK_MONOTONIC, &oTime) == 0)
+    {
+        return(wxLongLong(oTime.tv_sec) * 1000000 + oTime.tv_nsec / 1000);
+    }
+#endif // __WXMSW__
+    return(wxGetUTCTimeUSec());
+}
+
+/** Add a measure to a timer
+  * \param eTimer         [input]: the timer to update
+  * \param llMicroSeconds [input]: the measured duration
+  */
+void wxVirtualPerfCounters::AddTime(ETimer eTimer, wxLongLong llMicroSeconds)
+{
+    ms_vTotalTimes[eTimer] += llMicroSeconds;
+    ms_vLastTimes[eTimer]   = llMicroSeconds;
+    ms_vCalls[eTimer]++;
+}
+
+/** Start a paint frame : the counters are memorized
+  */
+void wxVirtualPerfCounters::BeginFrame(void)
+{
+    size_t i;
+    for(i=0;i<WX_PERF_COUNTER_COUNT;i++) ms_vFrameStart[i] = ms_vCounters[i];
+}
+
+/** End a paint frame : the increments of the counters during the frame are memorized
+  */
+void wxVirtualPerfCounters::EndFrame(void)
+{
+    size_t i;
+    for(i=0;i<WX_PERF_COUNTER_COUNT;i++) ms_vLastFrame[i] = ms_vCounters[i] - ms_vFrameStart[i];
+}
+
+//------------------------------ QUERY ------------------------------//
+/** Get the total time of a timer
+  * \param eTimer [input]: the timer to query
+  * \return the sum of all measures, in microseconds
+  */
+wxLongLong wxVirtualPerfCounters::GetTotalTime(ETimer eTimer)
+{
+    return(ms_vTotalTimes[eTimer]);
+}
+
+/** Get the last measure of a timer
+  * \param eTimer [input]: the timer to query
+  * \return the last measure, in microseconds
+  */
+wxLongLong wxVirtualPerfCounters::GetLastTime(ETimer eTimer)
+{
+    return(ms_vLastTimes[eTimer]);
+}
+
+/** Get the amount of measures of a timer
+  * \param eTimer [input]: the timer to query
+  * \return the amount of measures
+  */
+size_t wxVirtualPerfCounters::GetCalls(ETimer eTimer)
+{
+    return(ms_vCalls[eTimer]);
+}
+
+/** Get the value of a counter
+  * \param eCounter [input]: the counter to query
+  * \return the value of the counter
+  */
+size_t wxVirtualPerfCounters::GetCount(ECounter eCounter)
+{
+    return(ms_vCounters[eCounter]);
+}
+
+/** Get the increment of a counter during the last frame
+  * \param eCounter [input]: the counter to query
+  * \return the increment of the counter during the last paint frame
+  */
+size_t wxVirtualPerfCounters::GetLastFrameCount(ECounter eCounter)
+{
+    return(ms_vLastFrame[eCounter]);
+}
+
+/** Get a summary of the counters
+  * \param rStats [output]: the summary
+  */
+void wxVirtualPerfCounters::GetStats(wxVirtualDataViewStats &rStats)
+{
+    rStats.m_uiPaintCount           = ms_vCalls[WX_PERF_PAINT_MODEL];
+    rStats.m_dLastPaintTime         = ToMilliSeconds(ms_vLastTimes[WX_PERF_PAINT_MODEL]);
+    rStats.m_dAveragePaintTime      = 0.0;
+    if (rStats.m_uiPaintCount > 0)
+    {
+        rStats.m_dAveragePaintTime  = ToMilliSeconds(ms_vTotalTimes[WX_PERF_PAINT_MODEL]) / rStats.m_uiPaintCount;
+    }
+    rStats.m_uiModelCallsPerFrame   = ms_vLastFrame[WX_PERF_MODEL_CALLS];
+    rStats.m_uiItemsDrawnPerFrame   = ms_vLastFrame[WX_PERF_ITEMS_DRAWN];
+    rStats.m_uiGDIObjectsPerFrame   = ms_vLastFrame[WX_PERF_GDI_OBJECTS];
+    rStats.m_uiTextMeasuresPerFrame = ms_vLastFrame[WX_PERF_TEXT_MEASURES];
+    rStats.m_uiTextMeasures         = ms_vCounters[WX_PERF_TEXT_MEASURES];
+    rStats.m_uiTextCacheHits        = ms_vCounters[WX_PERF_TEXT_CACHE_HITS];
+    rStats.m_dDrawItemTime          = ToMilliSeconds(ms_vTotalTimes[WX_PERF_DRAW_ITEM]);
+    rStats.m_dComputeSizeTime       = ToMilliSeconds(ms_vTotalTimes[WX_PERF_COMPUTE_SIZE]);
+    rStats.m_dSelectionTime         = ToMilliSeconds(ms_vTotalTimes[WX_PERF_SELECTION]);
+    rStats.m_dGetAllValuesTime      = ToMilliSeconds(ms_vTotalTimes[WX_PERF_GET_ALL_VALUES]);
+
+    rStats.m_uiCacheHits            = ms_vCounters[WX_PERF_CACHE_HITS];
+    rStats.m_uiCacheMisses          = ms_vCounters[WX_PERF_CACHE_MISSES];
+    rStats.m_dCacheHitRate          = 0.0;
+    size_t uiLookups = rStats.m_uiCacheHits + rStats.m_uiCacheMisses;
+    if (uiLookups > 0) rStats.m_dCacheHitRate = ((double) rStats.m_uiCacheHits) / uiLookups;
+
+    rStats.m_uiItemsSorted          = ms_vCounters[WX_PERF_ITEMS_SORTED];
+    rStats.m_dItemsSortedPerSecond  = GetItemsPerSecond(rStats.m_uiItemsSorted, ms_vTotalTimes[WX_PERF_SORT]);
+    rStats.m_uiItemsFiltered        = ms_vCounters[WX_PERF_ITEMS_FILTERED];
+    rStats.m_dItemsFilteredPerSecond = GetItemsPerSecond(rStats.m_uiItemsFiltered, ms_vTotalTimes[WX_PERF_FILTER]);
+}
@@ -0,0 +1,172 @@
+/**********************************************************************/
+/** FILE    : VirtualMappedFile.cpp                                  **/
+/** PROJECT : wxVirtualDataViewCtrl                                  **/
+/** LICENSE : wxWindows Library Licence                              **/
+/** PURPOSE : read-only memory-mapped file                           **/
+/**********************************************************************/
+
+#include <wx/VirtualDataView/Utilities/VirtualMappedFile.h>
+#ifdef __WXMSW__
+    #include <wx/msw/wrapwin.h>
+#else
+    #include <sys/types.h>
+    #include <sys/stat.h>
+    #include <sys/mman.h>
+    #include <fcntl.h>
+    #include <unistd.h>
+#endif // __WXMSW__
+
+//------------------ CONSTRUCTORS & DESTRUCTOR ----------------------//
+/** Default constructor
+  */
+wxVirtualMappedFile::wxVirtualMappedFile(void)
+    : m_pData(WX_VDV_NULL_PTR),
+      m_uiSize(0),
+      m_sFileName(),
+      m_bOpened(false)
+#ifdef __WXMSW__
+      , m_hFile(INVALID_HANDLE_VALUE),
+      m_hMapping(WX_VDV_NULL_PTR)
+#endif // __WXMSW__
+{
+
+}
+
+/** Destructor
+  */
+wxVirtualMappedFile::~wxVirtualMappedFile(void)
+{
+    Close();
+}
+
+//------------------------- OPEN / CLOSE ----------------------------//
+/** Map a file
+  * The previous file is unmapped
+  * \param sFileName [input]: the name of the file to map
+  * \return true on success, false on failure
+  */
+bool wxVirtualMappedFile::Open(const wxString &sFileName)
+{
+    Close();
+
+#ifdef __WXMSW__
+    HANDLE hFile = ::CreateFileW(sFileName.wc_str(), GENERIC_READ,
+                                 FILE_SHARE_READ | FILE_SHARE_WRITE, WX_VDV_NULL_PTR,
+                                 OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, WX_VDV_NULL_PTR);
+    if (hFile == INVALID_HANDLE_VALUE) return(false);
+
+    LARGE_INTEGER liSize;
+    if ((!::GetFileSizeEx(hFile, &liSize)) || (wxUint64(liSize.QuadPart) > wxUint64(size_t(-1))))
+    {
+        ::CloseHandle(hFile);
+        return(false);
+    }
+
+    m_uiSize = liSize.QuadPart;
+    if (m_uiSize > 0)
+    {
+        HANDLE hMapping = ::CreateFileMappingW(hFile, WX_VDV_NULL_PTR, PAGE_READONLY, 0, 0, WX_VDV_NULL_PTR);
+        if (!hMapping)
+        {
+            ::CloseHandle(hFile);
+            m_uiSize = 0;
+            return(false);
+        }
+
+        m_pData = (const char *) ::MapViewOfFile(hMapping, FILE_MAP_READ, 0, 0, 0);
+        if (!m_pData)
+        {
+            ::CloseHandle(hMapping);
+            ::CloseHandle(hFile);
+            m_uiSize = 0;
+            return(false);
+        }
+        m_hMapping = hMapping;
+    }
+    m_hFile = hFile;
+#else
+    int iFile = ::open(sFileName.fn_str(), O_RDONLY);
+    if (iFile < 0) return(false);
+
+    struct stat oStat;
+    if ((::fstat(iFile, &oStat) != 0) || (wxUint64(oStat.st_size) > wxUint64(size_t(-1))))
+    {
+        ::close(iFile);
+        return(false);
+    }
+
+    m_uiSize = oStat.st_size;
+    if (m_uiSize > 0)
+    {
+        void *pData = ::mmap(WX_VDV_NULL_PTR, m_uiSize, PROT_READ, MAP_PRIVATE, iFile, 0);
+        if (pData == MAP_FAILED)
+        {
+            ::close(iFile);
+            m_uiSize = 0;
+            return(false);
+        }
+        m_pData = (const char *) pData;
+    }
+    //the mapping stays valid after closing the descriptor
+    ::close(iFile);
+#endif // __WXMSW__
+
+    m_sFileName = sFileName;
+    m_bOpened = true;
+    return(true);
+}
+
+/** Unmap the file
+  */
+void wxVirtualMappedFile::Close(void)
+{
+    if (!m_bOpened) return;
+
+#ifdef __WXMSW__
+    if (m_pData) ::UnmapViewOfFile(m_pData);
+    if (m_hMapping) ::CloseHandle((HANDLE) m_hMapping);
+    if (m_hFile != INVALID_HANDLE_VALUE) ::CloseHandle((HANDLE) m_hFile);
+    m_hMapping = WX_VDV_NULL_PTR;
+    m_hFile = INVALID_HANDLE_VALUE;
+#else
+    if (m_pData) ::munmap((void *) m_pData, m_uiSize);
+#endif // __WXMSW__
+
+    m_pData = WX_VDV_NULL_PTR;
+    m_uiSize = 0;
+    m_sFileName.Clear();
+    m_bOpened = false;
+}
+
+/** Check if a file is mapped
+  * \return true if a file is mapped
+  */
+bool wxVirtualMappedFile::IsOpened(void) const
+{
+    return(m_bOpened);
+}
+
+//----------------------------- ACCESS ------------------------------//
+/** Get the 1st byte of the file
+  * \return the 1st byte of the file. NULL if the file is empty or not mapped
+  */
+const char* wxVirtualMappedFile::GetData(void) const
+{
+    return(m_pData);
+}
+
+/** Get the size of the file
+  * \return the size of the file, in bytes
+  */
+wxUint64 wxVirtualMappedFile::GetSize(void) const
+{
+    return(m_uiSize);
+}
+
+/** Get the name of the mapped file
+  * \return the name of the mapped file
+  */
+wxString wxVirtualMappedFile::GetFileName(void) const
+{
+    return(m_sFileName);
+}
@@ -0,0 +1,322 @@
+/**********************************************************************/
+/** FILE    : VirtualTextExtentCache.cpp                             **/
+/** PROJECT : wxVirtualDataViewCtrl                                  **/
+/** LICENSE : wxWindows Library Licence                              **/
+/** PURPOSE : cache of text measurements                             **/
+/**********************************************************************/
+
+#include <wx/VirtualDataView/Utilities/VirtualTextExtentCache.h>
+#include <wx/VirtualDataView/Utilities/PerfCounters.h>
+#include <wx/window.h>
+#include <wx/dc.h>
+#include <wx/font.h>
+#include <wx/hashmap.h>
+#include <wx/module.h>
+
+//glyphs of the numeric fast path
+static const wxChar s_NumericGlyphs[] = wxT("0123456789+-.,");
+static const size_t s_uiNumericGlyphs = 14;
+
+//amount of copies of a glyph measured at once : averages the rounding of the glyph width
+static const size_t s_uiGlyphRepeat = 10;
+
+//strings longer than this are never cached
+static const size_t s_uiMaxCachedLength = 256;
+
+//maximal amount of cached fonts
+static const size_t s_uiMaxFonts = 32;
+
+//default maximal amount of cached strings
+static const size_t s_uiDefaultMaxEntries = 16384;
+
+WX_DECLARE_STRING_HASH_MAP(wxSize, THashMapTextExtents);
+
+/** \struct wxVirtualTextExtentFont : the cached measurements of 1 font
+  */
+struct wxVirtualTextExtentFont
+{
+    wxFont              m_Font;                                     ///< \brief the font
+    wxSize              m_PPI;                                      ///< \brief the resolution of the DC. (0,0) for a window
+    THashMapTextExtents m_MapOfSizes;                               ///< \brief the cached sizes
+    bool                m_bHasGlyphs;                               ///< \brief true if the numeric glyphs were measured
+    double              m_vGlyphWidths[s_uiNumericGlyphs];          ///< \brief width of each numeric glyph
+    int                 m_iGlyphHeight;                             ///< \brief height of the numeric glyphs
+};
+
+//----------------------------- DATA --------------------------------//
+bool                                wxVirtualTextExtentCache::ms_bEnabled      = true;
+size_t                              wxVirtualTextExtentCache::ms_uiMaxEntries  = s_uiDefaultMaxEntries;
+size_t                              wxVirtualTextExtentCache::ms_uiEntries     = 0;
+wxVector<wxVirtualTextExtentFont*>  wxVirtualTextExtentCache::ms_vFonts;
+
+/** Get the index of a numeric glyph
+  * \param c [input]: the character
+  * \return the index of the glyph in s_NumericGlyphs, or s_uiNumericGlyphs if not found
+  */
+WX_VDV_INLINE size_t GetNumericGlyphIndex(wxUniChar c)
+{
+    if ((c >= '0') && (c <= '9')) return(c.GetValue() - '0');
+    switch(c.GetValue())
+    {
+        case '+'    : return(10);
+        case '-'    : return(11);
+        case '.'    : return(12);
+        case ','    : return(13);
+        default     : break;
+    }
+    return(s_uiNumericGlyphs);
+}
+
+/** \class wxVirtualTextExtentCacheModule : release the cached fonts when wxWidgets is shut down
+  */
+class wxVirtualTextExtentCacheModule : public wxModule
+{
+    public:
+        bool OnInit(void) {return(true);}                           ///< \brief module initialization
+        void OnExit(void) {wxVirtualTextExtentCache::Clear();}      ///< \brief module cleanup
+
+    private:
+        wxDECLARE_DYNAMIC_CLASS(wxVirtualTextExtentCacheModule);
+};
+
+wxIMPLEMENT_DYNAMIC_CLASS(wxVirtualTextExtentCacheModule, wxModule);
+
+//-------------------------- MEASUREMENT ----------------------------//
+/** Measure a text drawn in a window
+  * \param pWindow [input]: the window where the text is drawn
+  * \param rsText  [input]: the text to measure
+  * \param rFont   [input]: the font used for drawing the text
+  * \return the size of the text
+  */
+wxSize wxVirtualTextExtentCache::GetTextExtent(wxWindow *pWindow, const wxString &rsText,
+                                               const wxFont &rFont)
+{
+    if (!pWindow) return(wxSize(0, 0));
+    return(DoGetTextExtent(pWindow, WX_VDV_NULL_PTR, rsText, rFont, wxSize(0, 0)));
+}
+
+/** Measure a text drawn with the current font of a DC
+  * The cache is not used if the DC is scaled
+  * \param rDC    [input]: the DC where the text is drawn
+  * \param rsText [input]: the text to measure
+  * \return the size of the text, in logical units
+  */
+wxSize wxVirtualTextExtentCache::GetTextExtent(const wxDC &rDC, const wxString &rsText)
+{
+    double dScaleX, dScaleY;
+    rDC.GetUserScale(&dScaleX, &dScaleY);
+    const wxFont &rFont = rDC.GetFont();
+    if ((dScaleX != 1.0) || (dScaleY != 1.0) || (!rFont.IsOk()))
+    {
+        return(Measure(WX_VDV_NULL_PTR, &rDC, rsText, rFont));
+    }
+    return(DoGetTextExtent(WX_VDV_NULL_PTR, &rDC, rsText, rFont, rDC.GetPPI()));
+}
+
+//---------------------------- SETTINGS -----------------------------//
+/** Check if the cache is enabled
+  * \return true if the cache is enabled
+  */
+bool wxVirtualTextExtentCache::IsEnabled(void)
+{
+    return(ms_bEnabled);
+}
+
+/** Enable / disable the cache
+  * \param bEnable [input]: true for enabling the cache, false for measuring every text
+  */
+void wxVirtualTextExtentCache::Enable(bool bEnable)
+{
+    ms_bEnabled = bEnable;
+    if (!bEnable) Clear();
+}
+
+/** Get the maximal amount of cached strings
+  * \return the maximal amount of cached strings
+  */
+size_t wxVirtualTextExtentCache::GetMaxEntries(void)
+{
+    return(ms_uiMaxEntries);
+}
+
+/** Set the maximal amount of cached strings
+  * When the limit is reached, all the cached strings are discarded
+  * \param uiMaxEntries [input]: the new maximal amount of cached strings
+  */
+void wxVirtualTextExtentCache::SetMaxEntries(size_t uiMaxEntries)
+{
+    ms_uiMaxEntries = uiMaxEntries;
+    if (ms_uiEntries > ms_uiMaxEntries) Clear();
+}
+
+//-------------------------- MAINTENANCE ----------------------------//
+/** Clear the cache
+  */
+void wxVirtualTextExtentCache::Clear(void)
+{
+    size_t i, uiNbFonts;
+    uiNbFonts = ms_vFonts.size();
+    for(i = 0; i < uiNbFonts; i++) delete(ms_vFonts[i]);
+    ms_vFonts.clear();
+    ms_uiEntries = 0;
+}
+
+/** Get the amount of cached strings
+  * \return the amount of cached strings
+  */
+size_t wxVirtualTextExtentCache::GetEntriesCount(void)
+{
+    return(ms_uiEntries);
+}
+
+//---------------------------- HELPERS ------------------------------//
+/** Check if a string uses the numeric fast path
+  * \param rsText [input]: the string to check
+  * \return true if the string is not empty and contains only digits, signs, '.' and ','
+  */
+bool wxVirtualTextExtentCache::IsNumeric(const wxString &rsText)
+{
+    if (rsText.IsEmpty()) return(false);
+    wxString::const_iterator it    = rsText.begin();
+    wxString::const_iterator itEnd = rsText.end();
+    while (it != itEnd)
+    {
+        if (GetNumericGlyphIndex(*it) >= s_uiNumericGlyphs) return(false);
+        ++it;
+    }
+    return(true);
+}
+
+//----------------------- INTERNAL METHODS --------------------------//
+/** Get the cache of a font, create it if needed
+  * The fonts sharing the same data are found first. Then the fonts are compared by value
+  * \param rFont [input]: the font
+  * \param rPPI  [input]: the resolution of the DC. (0,0) for a window
+  * \return the cache of the font
+  */
+wxVirtualTextExtentFont* wxVirtualTextExtentCache::GetFont(const wxFont &rFont,
+                                                           const wxSize &rPPI)
+{
+    size_t i, uiNbFonts;
+    uiNbFonts = ms_vFonts.size();
+    for(i = 0; i < uiNbFonts; i++)
+    {
+        wxVirtualTextExtentFont *pFont = ms_vFonts[i];
+        if ((pFont->m_PPI == rPPI) && (pFont->m_Font.IsSameAs(rFont))) return(pFont);
+    }
+    for(i = 0; i < uiNbFonts; i++)
+    {
+        wxVirtualTextExtentFont *pFont = ms_vFonts[i];
+        if ((pFont->m_PPI == rPPI) && (pFont->m_Font == rFont)) return(pFont);
+    }
+
+    //new font
+    if (uiNbFonts >= s_uiMaxFonts) Clear();
+    wxVirtualTextExtentFont *pFont = new wxVirtualTextExtentFont;
+    pFont->m_Font         = rFont;
+    pFont->m_PPI          = rPPI;
+    pFont->m_bHasGlyphs   = false;
+    pFont->m_iGlyphHeight = 0;
+    ms_vFonts.push_back(pFont);
+    return(pFont);
+}
+
+/** Really measure a text
+  * \param pWindow [input]: the window where the text is drawn. Used if pDC is NULL
+  * \param pDC     [input]: the DC where the text is drawn
+  * \param rsText  [input]: the text to measure
+  * \param rFont   [input]: the font used for drawing the text
+  * \return the size of the text
+  */
+wxSize wxVirtualTextExtentCache::Measure(wxWindow *pWindow, const wxDC *pDC,
+                                         const wxString &rsText, const wxFont &rFont)
+{
+    WX_VDV_PERF_COUNT(WX_PERF_TEXT_MEASURES, 1);
+
+    wxCoord w = 0;
+    wxCoord h = 0;
+    if (pDC)
+    {
+        pDC->GetTextExtent(rsText, &w, &h, WX_VDV_NULL_PTR, WX_VDV_NULL_PTR, &rFont);
+    }
+    else if (pWindow)
+    {
+        pWindow->GetTextExtent(rsText, &w, &h, WX_VDV_NULL_PTR, WX_VDV_NULL_PTR, &rFont);
+    }
+    return(wxSize(w, h));
+}
+
+/** Measure a text, using the cache
+  * \param pWindow [input]: the window where the text is drawn. Used if pDC is NULL
+  * \param pDC     [input]: the DC where the text is drawn
+  * \param rsText  [input]: the text to measure
+  * \param rFont   [input]: the font used for drawing the text
+  * \param rPPI    [input]: the resolution of the DC. (0,0) for a window
+  * \return the size of the text
+  */
+wxSize wxVirtualTextExtentCache::DoGetTextExtent(wxWindow *pWindow, const wxDC *pDC,
+                                                 const wxString &rsText,
+                                                 const wxFont &rFont,
+                                                 const wxSize &rPPI)
+{
+    size_t uiLength = rsText.Length();
+    if ((!ms_bEnabled) || (uiLength > s_uiMaxCachedLength) || (!rFont.IsOk()))
+    {
+        return(Measure(pWindow, pDC, rsText, rFont));
+    }
+
+    wxVirtualTextExtentFont *pFont = GetFont(rFont, rPPI);
+
+    //numeric fast path : sum of the glyph widths
+    if (IsNumeric(rsText))
+    {
+        if (!pFont->m_bHasGlyphs)
+        {
+            size_t uiGlyph;
+            for(uiGlyph = 0; uiGlyph < s_uiNumericGlyphs; uiGlyph++)
+            {
+                wxString sGlyphs(s_NumericGlyphs[uiGlyph], s_uiGlyphRepeat);
+                wxSize sSize = Measure(pWindow, pDC, sGlyphs, rFont);
+                pFont->m_vGlyphWidths[uiGlyph] = ((double) sSize.GetWidth()) / s_uiGlyphRepeat;
+                if (sSize.GetHeight() > pFont->m_iGlyphHeight) pFont->m_iGlyphHeight = sSize.GetHeight();
+            }
+            pFont->m_bHasGlyphs = true;
+        }
+        else
+        {
+            WX_VDV_PERF_COUNT(WX_PERF_TEXT_CACHE_HITS, 1);
+        }
+
+        double dWidth = 0.0;
+        wxString::const_iterator it    = rsText.begin();
+        wxString::const_iterator itEnd = rsText.end();
+        while (it != itEnd)
+        {
+            dWidth += pFont->m_vGlyphWidths[GetNumericGlyphIndex(*it)];
+            ++it;
+        }
+        return(wxSize((int) (dWidth + 0.999), pFont->m_iGlyphHeight));
+    }
+
+    //cached strings
+    THashMapTextExtents::iterator itSize = pFont->m_MapOfSizes.find(rsText);
+    if (itSize != pFont->m_MapOfSizes.end())
+    {
+        WX_VDV_PERF_COUNT(WX_PERF_TEXT_CACHE_HITS, 1);
+        return(itSize->second);
+    }
+
+    //measure & store
+    wxSize sSize = Measure(pWindow, pDC, rsText, rFont);
+    if (ms_uiEntries >= ms_uiMaxEntries)
+    {
+        size_t i, uiNbFonts;
+        uiNbFonts = ms_vFonts.size();
+        for(i = 0; i < uiNbFonts; i++) ms_vFonts[i]->m_MapOfSizes.clear();
+        ms_uiEntries = 0;
+        if (ms_uiMaxEntries == 0) return(sSize);
+    }
+    pFont->m_MapOfSizes[rsText] = sSize;
+    ms_uiEntries++;
+    return(sSize);
+}
@@ -0,0 +1,341 @@
+/**********************************************************************/
+/** FILE    : BenchmarkModels.cpp                                    **/
+/** PROJECT : wxVirtualDataViewCtrl                                  **/
+/** LICENSE : wxWindows Library Licence                              **/
+/** PURPOSE : synthetic data models for benchmarking                 **/
+/**********************************************************************/
+
+#include "BenchmarkModels.h"
+
+#include <wx/utils.h>
+
+//------------------------- VALUES ----------------------------------//
+/** Mix the bits of an integer (deterministic pseudo-random generator)
+  * \param uiValue [input]: the value to mix
+  * \return the mixed value
+  */
+static wxUint32 MixBits(wxUint32 uiValue)
+{
+    uiValue ^= uiValue >> 16;
+    uiValue *= 0x7FEB352Du;
+    uiValue ^= uiValue >> 15;
+    uiValue *= 0x846CA68Bu;
+    uiValue ^= uiValue >> 16;
+    return(uiValue);
+}
+
+//values of BENCHMARK_FIELD_CATEGORY
+static const wxString s_vCategories[16] =
+{
+    "alpha", "bravo", "charlie", "delta", "echo", "foxtrot", "golf", "hotel",
+    "india", "juliett", "kilo", "lima", "mike", "november", "oscar", "papa"
+};
+
+/** Compute the value of a field of a synthetic item
+  * \param uiKey   [input]: the unique key of the item
+  * \param uiField [input]: the field to compute (see EBenchmarkField)
+  * \return the value. The same key & field always give the same value
+  */
+wxVariant GetBenchmarkValue(size_t uiKey, size_t uiField)
+{
+    wxUint32 uiHash = MixBits((wxUint32) uiKey);
+    switch(uiField)
+    {
+        case BENCHMARK_FIELD_NAME       :   return(wxVariant(wxString::Format("Item %lu", (unsigned long) uiKey)));
+        case BENCHMARK_FIELD_INTEGER    :   return(wxVariant((long) (uiHash % 1000000)));
+        case BENCHMARK_FIELD_DOUBLE     :   return(wxVariant(((double) MixBits(uiHash)) * (1000.0 / 4294967296.0)));
+        case BENCHMARK_FIELD_BOOL       :   return(wxVariant(((uiHash >> 7) & 1) != 0));
+        case BENCHMARK_FIELD_CATEGORY   :   return(wxVariant(s_vCategories[(uiHash >> 11) & 15]));
+        default                         :   break;
+    }
+    return(wxVariant());
+}
+
+/** Compute the value of a field of a synthetic item, without allocation
+  * \param rValue  [output]: the value. Same as GetBenchmarkValue()
+  * \param uiKey   [input] : the unique key of the item
+  * \param uiField [input] : the field to compute (see EBenchmarkField)
+  */
+void GetBenchmarkValue(wxVirtualValue &rValue, size_t uiKey, size_t uiField)
+{
+    wxUint32 uiHash = MixBits((wxUint32) uiKey);
+    switch(uiField)
+    {
+        case BENCHMARK_FIELD_INTEGER    :   rValue.SetInt64(uiHash % 1000000); return;
+        case BENCHMARK_FIELD_DOUBLE     :   rValue.SetDouble(((double) MixBits(uiHash)) * (1000.0 / 4294967296.0)); return;
+        case BENCHMARK_FIELD_BOOL       :   rValue.SetBool(((uiHash >> 7) & 1) != 0); return;
+        case BENCHMARK_FIELD_CATEGORY   :   rValue.SetString(s_vCategories[(uiHash >> 11) & 15]); return;
+        default                         :   break;
+    }
+    rValue.SetVariant(GetBenchmarkValue(uiKey, uiField));
+}
+
+//----------------------- LIST MODEL --------------------------------//
+/** Constructor
+  * \param uiItemCount [input]: the amount of items in the list
+  */
+BenchmarkListModel::BenchmarkListModel(size_t uiItemCount)
+    : wxVirtualIListDataModel(),
+      m_uiItemCount(uiItemCount)
+{
+}
+
+/** Destructor
+  */
+BenchmarkListModel::~BenchmarkListModel(void)
+{
+}
+
+/** Get amount of items
+  * \return the amount of items
+  */
+size_t BenchmarkListModel::GetItemCount(void)
+{
+    return(m_uiItemCount);
+}
+
+/** Get the amount of fields in the item
+  * \param rID [input]: the item to query
+  * \return the amount of fields
+  */
+size_t BenchmarkListModel::GetFieldCount(const wxVirtualItemID &rID)
+{
+    return(BENCHMARK_FIELD_COUNT);
+}
+
+/** Get the item data
+  * \param uiItemID [input]: index of the item to query
+  * \param uiField  [input]: the field of the data to query
+  * \param eType    [input]: the kind of data to get
+  * \return the data of the item. Return invalid variant if no data is associated
+  */
+wxVariant BenchmarkListModel::GetListItemData(size_t uiItemID, size_t uiField, EDataType eType)
+{
+    if (eType != WX_ITEM_MAIN_DATA) return(wxVariant());
+    if (uiItemID >= m_uiItemCount) return(wxVariant());
+    return(GetBenchmarkValue(uiItemID, uiField));
+}
+
+/** Get the item data without allocation
+  * \param rValue   [output]: the data of the item. Null if no data is associated
+  * \param uiItemID [input] : index of the item to query
+  * \param uiField  [input] : the field of the data to query
+  * \param eType    [input] : the kind of data to get
+  */
+void BenchmarkListModel::GetListItemValue(wxVirtualValue &rValue, size_t uiItemID,
+                                          size_t uiField, EDataType eType)
+{
+    if ((eType != WX_ITEM_MAIN_DATA) || (uiItemID >= m_uiItemCount))
+    {
+        rValue.SetNull();
+        return;
+    }
+    GetBenchmarkValue(rValue, uiItemID, uiField);
+}
+
+/** Check if Compare() is reimplemented for a field
+  * \param uiField [input]: the field to check
+  * \return false : the default comparison is used, the fields can be sorted with typed keys
+  */
+bool BenchmarkListModel::HasCustomCompare(size_t uiField)
+{
+    return(false);
+}
+
+//-------------------- SLOW LIST MODEL ------------------------------//
+/** Constructor
+  * \param uiItemCount [input]: the amount of items in the list
+  * \param ulDelay     [input]: the delay of each value, in microseconds
+  */
+BenchmarkSlowListModel::BenchmarkSlowListModel(size_t uiItemCount, unsigned long ulDelay)
+    : BenchmarkListModel(uiItemCount),
+      m_ulDelay(ulDelay)
+{
+}
+
+/** Destructor
+  */
+BenchmarkSlowListModel::~BenchmarkSlowListModel(void)
+{
+}
+
+/** Get the item data
+  * \param uiItemID [input]: index of the item to query
+  * \param uiField  [input]: the field of the data to query
+  * \param eType    [input]: the kind of data to get
+  * \return the data of the item. Return invalid variant if no data is associated
+  */
+wxVariant BenchmarkSlowListModel::GetListItemData(size_t uiItemID, size_t uiField, EDataType eType)
+{
+    if ((eType == WX_ITEM_MAIN_DATA) && (m_ulDelay > 0)) wxMicroSleep(m_ulDelay);
+    return(BenchmarkListModel::GetListItemData(uiItemID, uiField, eType));
+}
+
+/** Get the item data without allocation
+  * \param rValue   [output]: the data of the item. Null if no data is associated
+  * \param uiItemID [input] : index of the item to query
+  * \param uiField  [input] : the field of the data to query
+  * \param eType    [input] : the kind of data to get
+  */
+void BenchmarkSlowListModel::GetListItemValue(wxVirtualValue &rValue, size_t uiItemID,
+                                              size_t uiField, EDataType eType)
+{
+    if ((eType == WX_ITEM_MAIN_DATA) && (m_ulDelay > 0)) wxMicroSleep(m_ulDelay);
+    BenchmarkListModel::GetListItemValue(rValue, uiItemID, uiField, eType);
+}
+
+/** Check if GetItemData() & Compare() can be called from worker threads
+  * \return true : the values are computed, and never shared
+  */
+bool BenchmarkSlowListModel::IsThreadSafe(void)
+{
+    return(true);
+}
+
+//----------------------- TREE MODEL --------------------------------//
+/** Constructor
+  * \param vFanOut [input]: the amount of children of the items of each level.
+  *                         vFanOut[0] is the amount of children of the root item
+  */
+BenchmarkTreeModel::BenchmarkTreeModel(const wxVector<size_t> &vFanOut)
+    : wxVirtualIDataModel(),
+      m_vFanOut(vFanOut),
+      m_uiItemCount(0)
+{
+    //level 0 : root
+    size_t uiSize = 1;
+    m_vLevelSize.push_back(uiSize);
+    m_vLevelOffset.push_back(0);
+
+    size_t i, uiNbLevels;
+    uiNbLevels = m_vFanOut.size();
+    for(i=0;i<uiNbLevels;i++)
+    {
+        m_vLevelOffset.push_back(m_uiItemCount);
+        uiSize *= m_vFanOut[i];
+        m_vLevelSize.push_back(uiSize);
+        m_uiItemCount += uiSize;
+    }
+}
+
+/** Destructor
+  */
+BenchmarkTreeModel::~BenchmarkTreeModel(void)
+{
+}
+
+//------------------------ TREE SHAPE -------------------------------//
+/** Get the amount of items, root excluded
+  * \return the amount of items
+  */
+size_t BenchmarkTreeModel::GetItemCount(void) const
+{
+    return(m_uiItemCount);
+}
+
+/** Get the amount of levels, root excluded
+  * \return the amount of levels
+  */
+size_t BenchmarkTreeModel::GetLevelCount(void) const
+{
+    return(m_vFanOut.size());
+}
+
+//-------------------- INTERFACE IMPLEMENTATION ---------------------//
+/** Get the parent item ID
+  * \param rID [input]: the child item
+  * \return the parent item
+  */
+wxVirtualItemID BenchmarkTreeModel::GetParent(const wxVirtualItemID &rID)
+{
+    if (rID.IsRootOrInvalid()) return(CreateInvalidItemID());
+
+    size_t uiLevel = rID.GetRow();
+    if (uiLevel <= 1) return(GetRootItem());
+
+    size_t uiIndex = rID.GetUInt32() - 1;
+    size_t uiParentIndex = uiIndex / m_vFanOut[uiLevel - 1];
+    wxVirtualItemID id = MakeItemID(uiLevel - 1, uiParentIndex);
+    id.SetChildIndex(uiParentIndex % m_vFanOut[uiLevel - 2]);
+    return(id);
+}
+
+/** Get the amount of children
+  * \param rID [input]: the parent item to query
+  * \return the amount of children of rID
+  */
+size_t BenchmarkTreeModel::GetChildCount(const wxVirtualItemID &rID)
+{
+    size_t uiLevel = 0;
+    if (!IsRootItem(rID)) uiLevel = rID.GetRow();
+    if (uiLevel >= m_vFanOut.size()) return(0);
+    return(m_vFanOut[uiLevel]);
+}
+
+/** Get child item ID
+  * \param rIDParent    [input]: the parent item ID
+  * \param uiChildIndex [input]: the index of the child to get (0 based)
+  * \return the ID of the child item
+  */
+wxVirtualItemID BenchmarkTreeModel::GetChild(const wxVirtualItemID &rIDParent,
+                                             size_t uiChildIndex)
+{
+    size_t uiLevel = 0;
+    size_t uiIndex = 0;
+    if (!IsRootItem(rIDParent))
+    {
+        uiLevel = rIDParent.GetRow();
+        uiIndex = rIDParent.GetUInt32() - 1;
+    }
+    if (uiLevel >= m_vFanOut.size()) return(CreateInvalidItemID());
+    if (uiChildIndex >= m_vFanOut[uiLevel]) return(CreateInvalidItemID());
+
+    wxVirtualItemID id = MakeItemID(uiLevel + 1, uiIndex * m_vFanOut[uiLevel] + uiChildIndex);
+    id.SetChildIndex(uiChildIndex);
+    return(id);
+}
+
+/** Get the amount of fields in the item
+  * \param rID [input]: the item to query
+  * \return the amount of fields
+  */
+size_t BenchmarkTreeModel::GetFieldCount(const wxVirtualItemID &rID)
+{
+    return(BENCHMARK_FIELD_COUNT);
+}
+
+/** Get the item data
+  * \param rID     [input]: the item to query
+  * \param uiField [input]: the field of the data to query
+  * \param eType   [input]: the kind of data to get
+  * \return the data of the item. Return invalid variant if no data is associated
+  */
+wxVariant BenchmarkTreeModel::GetItemData(const wxVirtualItemID &rID, size_t uiField, EDataType eType)
+{
+    if (eType != WX_ITEM_MAIN_DATA) return(wxVariant());
+    if (rID.IsRootOrInvalid()) return(wxVariant());
+
+    size_t uiLevel = rID.GetRow();
+    size_t uiIndex = rID.GetUInt32() - 1;
+    return(GetBenchmarkValue(m_vLevelOffset[uiLevel] + uiIndex, uiField));
+}
+
+/** Check if Compare() is reimplemented for a field
+  * \param uiField [input]: the field to check
+  * \return false : the default comparison is used, the fields can be sorted with typed keys
+  */
+bool BenchmarkTreeModel::HasCustomCompare(size_t uiField)
+{
+    return(false);
+}
+
+//------------------------ INTERNAL METHODS -------------------------//
+/** Create an item ID
+  * \param uiLevel [input]: the level of the item (1 based)
+  * \param uiIndex [input]: the index of the item in its level (0 based)
+  * \return the item ID
+  */
+wxVirtualItemID BenchmarkTreeModel::MakeItemID(size_t uiLevel, size_t uiIndex)
+{
+    return(wxVirtualItemID((wxUint32) (uiIndex + 1), uiLevel, 0, this));
+}
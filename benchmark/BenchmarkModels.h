@@ -0,0 +1,129 @@
+/**********************************************************************/
+/** FILE    : BenchmarkModels.h                                      **/
+/** PROJECT : wxVirtualDataViewCtrl                                  **/
+/** LICENSE : wxWindows Library Licence                              **/
+/** PURPOSE : synthetic data models for benchmarking                 **/
+/**********************************************************************/
+
+#ifndef WX_VIRTUAL_BENCHMARK_MODELS_H_
+#define WX_VIRTUAL_BENCHMARK_MODELS_H_
+
+#include <wx/VirtualDataView/Models/VirtualIDataModel.h>
+#include <wx/VirtualDataView/Models/VirtualIListDataModel.h>
+#include <wx/VirtualDataView/Types/VirtualValue.h>
+#include <wx/vector.h>
+
+/// \enum EBenchmarkField : the fields of the synthetic models (mixed column types)
+enum EBenchmarkField
+{
+    BENCHMARK_FIELD_NAME        = 0,                                                    ///< \brief string, unique per item ("Item 123")
+    BENCHMARK_FIELD_INTEGER     = 1,                                                    ///< \brief long, pseudo-random in [0, 1000000[
+    BENCHMARK_FIELD_DOUBLE      = 2,                                                    ///< \brief double, pseudo-random in [0.0, 1000.0[
+    BENCHMARK_FIELD_BOOL        = 3,                                                    ///< \brief bool, pseudo-random
+    BENCHMARK_FIELD_CATEGORY    = 4,                                                    ///< \brief string, 16 distinct values
+    BENCHMARK_FIELD_COUNT       = 5                                                     ///< \brief amount of fields
+};
+
+/** \class BenchmarkListModel : a flat list of items with mixed column types
+  * The values are computed on the fly from the row index: no memory is used per item
+  */
+class BenchmarkListModel : public wxVirtualIListDataModel
+{
+    public:
+        //constructors & destructor
+        BenchmarkListModel(size_t uiItemCount);                                         ///< \brief constructor
+        virtual ~BenchmarkListModel(void);                                              ///< \brief destructor
+
+        //wxVirtualIListDataModel interface
+        virtual size_t GetItemCount(void);                                              ///< \brief get amount of items
+        virtual size_t GetFieldCount(const wxVirtualItemID &rID);                       ///< \brief get the amount of fields in the item
+        virtual wxVariant GetListItemData(size_t uiItemID,
+                                          size_t uiField = 0,
+                                          EDataType eType = WX_ITEM_MAIN_DATA);         ///< \brief get the item data
+        virtual void      GetListItemValue(wxVirtualValue &rValue,
+                                           size_t uiItemID,
+                                           size_t uiField = 0,
+                                           EDataType eType = WX_ITEM_MAIN_DATA);        ///< \brief get the item data without allocation
+        virtual bool      HasCustomCompare(size_t uiField);                             ///< \brief check if Compare() is reimplemented for a field
+
+    private:
+        //data
+        size_t  m_uiItemCount;                                                          ///< \brief amount of items
+};
+
+/** \class BenchmarkSlowListModel : a flat list whose values are slow to get (database, network, ...)
+  * Each value costs a fixed delay. The values are the same as BenchmarkListModel.
+  * The model can be read from worker threads
+  */
+class BenchmarkSlowListModel : public BenchmarkListModel
+{
+    public:
+        //constructors & destructor
+        BenchmarkSlowListModel(size_t uiItemCount, unsigned long ulDelay);              ///< \brief constructor
+        virtual ~BenchmarkSlowListModel(void);                                          ///< \brief destructor
+
+        //wxVirtualIListDataModel interface
+        virtual wxVariant GetListItemData(size_t uiItemID,
+                                          size_t uiField = 0,
+                                          EDataType eType = WX_ITEM_MAIN_DATA);         ///< \brief get the item data
+        virtual void      GetListItemValue(wxVirtualValue &rValue,
+                                           size_t uiItemID,
+                                           size_t uiField = 0,
+                                           EDataType eType = WX_ITEM_MAIN_DATA);        ///< \brief get the item data without allocation
+
+        //multi-threading
+        virtual bool IsThreadSafe(void);                                                ///< \brief check if GetItemData() & Compare() can be called from worker threads
+
+    private:
+        //data
+        unsigned long   m_ulDelay;                                                      ///< \brief delay per value, in microseconds
+};
+
+/** \class BenchmarkTreeModel : a regular tree with mixed column types
+  * All the items of a level have the same amount of children (the fan-out of the level)
+  *     deep narrow tree  : many levels with a small fan-out (2, 2, 2, ...)
+  *     wide shallow tree : few levels with a large fan-out (1000, 1000)
+  *
+  * Item IDs : row = level (1 based), ID = index of the item in its level + 1
+  *            the root item is level 0
+  * The values are computed on the fly from the item position: no memory is used per item
+  */
+class BenchmarkTreeModel : public wxVirtualIDataModel
+{
+    public:
+        //constructors & destructor
+        BenchmarkTreeModel(const wxVector<size_t> &vFanOut);                            ///< \brief constructor
+        virtual ~BenchmarkTreeModel(void);                                              ///< \brief destructor
+
+        //tree shape
+        size_t GetItemCount(void) const;                                                ///< \brief get the amount of items, root excluded
+        size_t GetLevelCount(void) const;                                               ///< \brief get the amount of levels, root excluded
+
+        //wxVirtualIDataModel interface
+        virtual wxVirtualItemID GetParent(const wxVirtualItemID &rID = s_RootID);       ///< \brief get the parent item ID
+        virtual size_t          GetChildCount(const wxVirtualItemID &rID);              ///< \brief get the amount of children
+        virtual wxVirtualItemID GetChild(const wxVirtualItemID &rIDParent,
+                                         size_t uiChildIndex);                          ///< \brief get child item ID
+        virtual size_t          GetFieldCount(const wxVirtualItemID &rID);              ///< \brief get the amount of fields in the item
+        virtual wxVariant       GetItemData(const wxVirtualItemID &rID,
+                                            size_t uiField = 0,
+                                            EDataType eType = WX_ITEM_MAIN_DATA);       ///< \brief get the item data
+        virtual bool            HasCustomCompare(size_t uiField);                       ///< \brief check if Compare() is reimplemented for a field
+
+    private:
+        //data
+        wxVector<size_t>    m_vFanOut;                                                  ///< \brief amount of children of the items of each level (level 0 = root)
+        wxVector<size_t>    m_vLevelSize;                                               ///< \brief amount of items in each level (level 0 = root)
+        wxVector<size_t>    m_vLevelOffset;                                             ///< \brief amount of items in all the previous levels
+        size_t              m_uiItemCount;                                              ///< \brief amount of items, root excluded
+
+        //methods
+        wxVirtualItemID MakeItemID(size_t uiLevel, size_t uiIndex);                     ///< \brief create an item ID
+};
+
+//helper
+wxVariant GetBenchmarkValue(size_t uiKey, size_t uiField);                              ///< \brief compute the value of a field of a synthetic item
+void      GetBenchmarkValue(wxVirtualValue &rValue,
+                            size_t uiKey, size_t uiField);                              ///< \brief compute the value of a field of a synthetic item
+
+#endif // WX_VIRTUAL_BENCHMARK_MODELS_H_
@@ -0,0 +1,976 @@
+/**********************************************************************/
+/** FILE    : BenchmarkRunner.cpp                                    **/
+/** PROJECT : wxVirtualDataViewCtrl                                  **/
+/** LICENSE : wxWindows Library Licence                              **/
+/** PURPOSE : run the benchmarks & record the results                **/
+/**********************************************************************/
+
+#include "BenchmarkRunner.h"
+#include "BenchmarkModels.h"
+
+#include <wx/VirtualDataView/DataView/VirtualDataViewCtrl.h>
+#include <wx/VirtualDataView/DataView/VirtualDataViewListCtrl.h>
+#include <wx/VirtualDataView/DataView/VirtualDataViewBase.h>
+#include <wx/VirtualDataView/Columns/VirtualDataViewColumn.h>
+#include <wx/VirtualDataView/Models/VirtualSortingDataModel.h>
+#include <wx/VirtualDataView/Models/VirtualFilteringDataModel.h>
+#include <wx/VirtualDataView/Models/VirtualAsyncDataModel.h>
+#include <wx/VirtualDataView/Models/VirtualPagingDataModel.h>
+#include <wx/VirtualDataView/StateModels/VirtualDefaultStateModel.h>
+#include <wx/VirtualDataView/StateModels/VirtualListStateModel.h>
+#include <wx/VirtualDataView/ModelRenderer/VirtualIModelRenderer.h>
+#include <wx/VirtualDataView/Filters/VirtualDataViewIntegerFilter.h>
+#include <wx/VirtualDataView/Filters/VirtualDataViewStringFilter.h>
+#include <wx/VirtualDataView/Utilities/PerfCounters.h>
+
+#include <wx/app.h>
+#include <wx/frame.h>
+#include <wx/dcmemory.h>
+#include <wx/bitmap.h>
+#include <wx/ffile.h>
+#include <wx/datetime.h>
+#include <wx/utils.h>
+#include <wx/version.h>
+#include <wx/dynarray.h>
+#include <wx/arrstr.h>
+
+//amount of items selected by the SelectRange benchmark (at most)
+#define BENCHMARK_SELECTION_RANGE       1000000
+
+//size of the off-screen rendering & amount of frames painted per run
+#define BENCHMARK_RENDER_WIDTH          1280
+#define BENCHMARK_RENDER_HEIGHT         1024
+#define BENCHMARK_RENDER_FRAMES         20
+
+//delay of each value of the slow model (microseconds), amount of rows scrolled between 2 frames, and rows per page of the paging adapter
+#define BENCHMARK_SLOW_VALUE_DELAY      20
+#define BENCHMARK_SLOW_SCROLL_STEP      37
+#define BENCHMARK_SLOW_PAGE_SIZE        128
+
+/// \struct TLoadFrame : an item whose children are being scanned (see BenchmarkRunner::LoadAllChildren)
+struct TLoadFrame
+{
+    wxVirtualItemID m_ID;                                                               ///< \brief the parent item
+    size_t          m_uiCount;                                                          ///< \brief amount of children
+    size_t          m_uiNext;                                                           ///< \brief next child to scan
+};
+
+//------------------------- JSON HELPERS ----------------------------//
+/** Quote & escape a string for JSON
+  * \param sValue [input]: the string to quote
+  * \return the quoted string
+  */
+static wxString JSONString(const wxString &sValue)
+{
+    wxString sResult = "\"";
+    wxString::const_iterator it    = sValue.begin();
+    wxString::const_iterator itEnd = sValue.end();
+    while(it != itEnd)
+    {
+        wxUniChar c = *it;
+        if      (c == '"')  sResult += "\\\"";
+        else if (c == '\\') sResult += "\\\\";
+        else if (c == '\n') sResult += "\\n";
+        else if (c < 32)    sResult += wxString::Format("\\u%04x", (int) c.GetValue());
+        else                sResult += c;
+        ++it;
+    }
+    sResult += "\"";
+    return(sResult);
+}
+
+/** Format a number for JSON, independently of the current locale
+  * \param dValue [input]: the number to format
+  * \return the formatted number
+  */
+static wxString JSONNumber(double dValue)
+{
+    return(wxString::FromCDouble(dValue, 4));
+}
+
+//-------------------------- MEASURE --------------------------------//
+/** Constructor
+  */
+BenchmarkRunner::TMeasure::TMeasure(void)
+    : m_llStart(0),
+      m_llTotal(0),
+      m_llMin(0),
+      m_llMax(0),
+      m_uiRuns(0)
+{
+}
+
+/** Start a run
+  */
+void BenchmarkRunner::TMeasure::Start(void)
+{
+    m_llStart = wxVirtualPerfCounters::Now();
+}
+
+/** Stop a run
+  */
+void BenchmarkRunner::TMeasure::Stop(void)
+{
+    wxLongLong llTime = wxVirtualPerfCounters::Now() - m_llStart;
+    if ((m_uiRuns == 0) || (llTime < m_llMin)) m_llMin = llTime;
+    if ((m_uiRuns == 0) || (llTime > m_llMax)) m_llMax = llTime;
+    m_llTotal += llTime;
+    m_uiRuns++;
+}
+
+//---------------- CONSTRUCTORS & DESTRUCTOR ------------------------//
+/** Constructor
+  */
+BenchmarkRunner::BenchmarkRunner(void)
+    : m_uiIterations(3),
+      m_uiSamples(10000),
+      m_bRendering(true)
+{
+}
+
+/** Destructor
+  */
+BenchmarkRunner::~BenchmarkRunner(void)
+{
+}
+
+//--------------------------- OPTIONS -------------------------------//
+/** Set the amount of runs per benchmark
+  * \param uiIterations [input]: the amount of runs. At least 1
+  */
+void BenchmarkRunner::SetIterations(size_t uiIterations)
+{
+    if (uiIterations == 0) uiIterations = 1;
+    m_uiIterations = uiIterations;
+}
+
+/** Get the amount of runs per benchmark
+  * \return the amount of runs
+  */
+size_t BenchmarkRunner::GetIterations(void) const
+{
+    return(m_uiIterations);
+}
+
+/** Set the amount of items used for random access queries (GetItemRank, FindItem, ...)
+  * \param uiSamples [input]: the amount of items. At least 1
+  */
+void BenchmarkRunner::SetSampleCount(size_t uiSamples)
+{
+    if (uiSamples == 0) uiSamples = 1;
+    m_uiSamples = uiSamples;
+}
+
+/** Get the amount of items used for random access queries
+  * \return the amount of items
+  */
+size_t BenchmarkRunner::GetSampleCount(void) const
+{
+    return(m_uiSamples);
+}
+
+/** Enable / disable the rendering benchmarks
+  * \param bEnable [input]: true for running the rendering benchmarks
+  *                         They need a display (Xvfb is enough on Linux)
+  */
+void BenchmarkRunner::EnableRendering(bool bEnable)
+{
+    m_bRendering = bEnable;
+}
+
+/** Check if the rendering benchmarks are enabled
+  * \return true if the rendering benchmarks are run
+  */
+bool BenchmarkRunner::IsRenderingEnabled(void) const
+{
+    return(m_bRendering);
+}
+
+//----------------------------- RUN ---------------------------------//
+/** Run all the benchmarks on a synthetic model
+  * \param rSuite [input]: the description of the model
+  */
+void BenchmarkRunner::RunSuite(const TSuite &rSuite)
+{
+    wxPrintf("suite %s\n", rSuite.m_sName);
+
+    wxVirtualIDataModel *pModel = CreateModel(rSuite);
+    wxVirtualIStateModel *pStateModel = CreateStateModel(rSuite, pModel);
+
+    RunTraversal(rSuite, pModel, pStateModel);
+    RunSelection(rSuite, pModel, pStateModel);
+    RunGetAllValues(rSuite, pModel);
+    RunSorting(rSuite, pModel);
+    RunFiltering(rSuite, pModel);
+
+    delete(pStateModel);
+    delete(pModel);
+
+    if (m_bRendering)
+    {
+        RunRendering(rSuite);
+        RunAsyncRendering(rSuite);
+    }
+}
+
+//---------------------------- MODELS -------------------------------//
+/** Create the synthetic model of a suite
+  * \param rSuite [input]: the description of the model
+  * \return a new data model. The caller takes ownership
+  */
+wxVirtualIDataModel* BenchmarkRunner::CreateModel(const TSuite &rSuite) const
+{
+    if (rSuite.m_bIsList) return(new BenchmarkListModel(rSuite.m_uiItemCount));
+    return(new BenchmarkTreeModel(rSuite.m_vFanOut));
+}
+
+/** Create a state model with all items expanded
+  * \param rSuite [input]: the description of the model
+  * \param pModel [input]: the data model
+  * \return a new state model. The caller takes ownership
+  */
+wxVirtualIStateModel* BenchmarkRunner::CreateStateModel(const TSuite &rSuite,
+                                                        wxVirtualIDataModel *pModel) const
+{
+    if (rSuite.m_bIsList) return(new wxVirtualListStateModel);
+
+    wxVirtualDefaultStateModel *pStateModel = new wxVirtualDefaultStateModel;
+    pStateModel->OnDataModelChanged(pModel);
+    pStateModel->Expand(pModel->GetRootItem(), true, true);
+    return(pStateModel);
+}
+
+//------------------------- BENCHMARKS ------------------------------//
+/** NextItem / PrevItem walks, GetItemRank, FindItem, GetSubTreeSize
+  * \param rSuite      [input]: the description of the model
+  * \param pModel      [input]: the data model
+  * \param pStateModel [input]: the state model
+  */
+void BenchmarkRunner::RunTraversal(const TSuite &rSuite, wxVirtualIDataModel *pModel,
+                                   wxVirtualIStateModel *pStateModel)
+{
+    size_t i, uiRun, uiCount = 0;
+    wxVirtualItemID idRoot = pModel->GetRootItem();
+
+    //NextItem walk : like the renderer, with the level
+    TMeasure oNext;
+    for(uiRun = 0; uiRun < m_uiIterations; uiRun++)
+    {
+        oNext.Start();
+        uiCount = 0;
+        size_t uiLevel = 0;
+        wxVirtualItemID id = pModel->NextItem(idRoot, uiLevel, uiLevel, pStateModel);
+        while (id.IsOK())
+        {
+            uiCount++;
+            id = pModel->NextItem(id, uiLevel, uiLevel, pStateModel);
+        }
+        oNext.Stop();
+    }
+    AddResult(rSuite, "next_item_walk", uiCount, oNext, uiCount);
+    size_t uiVisibleCount = uiCount;
+    if (uiVisibleCount == 0) return;
+
+    //PrevItem walk
+    TMeasure oPrev;
+    for(uiRun = 0; uiRun < m_uiIterations; uiRun++)
+    {
+        oPrev.Start();
+        uiCount = 0;
+        wxVirtualItemID id = pModel->GetLastItem();
+        while (id.IsOK())
+        {
+            uiCount++;
+            id = pModel->PrevItem(id, pStateModel);
+        }
+        oPrev.Stop();
+    }
+    AddResult(rSuite, "prev_item_walk", uiCount, oPrev, uiCount);
+
+    //samples : evenly spaced items
+    size_t uiSamples = m_uiSamples;
+    if (uiSamples > uiVisibleCount) uiSamples = uiVisibleCount;
+    size_t uiStep = uiVisibleCount / uiSamples;
+    wxVector<size_t> vRanks;
+    vRanks.reserve(uiSamples);
+    for(i=0;i<uiSamples;i++) vRanks.push_back(i * uiStep);
+
+    //FindItem (rank 0 is the 1st item under the root)
+    wxVirtualItemIDs vSampleIDs;
+    vSampleIDs.resize(uiSamples);
+    TMeasure oFind;
+    size_t uiChecksum = 0;
+    for(uiRun = 0; uiRun < m_uiIterations; uiRun++)
+    {
+        oFind.Start();
+        uiChecksum = 0;
+        for(i=0;i<uiSamples;i++)
+        {
+            vSampleIDs[i] = pModel->FindItem(vRanks[i] + 1, pStateModel);
+            if (vSampleIDs[i].IsOK()) uiChecksum++;
+        }
+        oFind.Stop();
+    }
+    AddResult(rSuite, "find_item", uiSamples, oFind, uiChecksum);
+
+    //GetItemRank
+    TMeasure oRank;
+    for(uiRun = 0; uiRun < m_uiIterations; uiRun++)
+    {
+        oRank.Start();
+        uiChecksum = 0;
+        for(i=0;i<uiSamples;i++) uiChecksum += pModel->GetItemRank(vSampleIDs[i], pStateModel);
+        oRank.Stop();
+    }
+    AddResult(rSuite, "get_item_rank", uiSamples, oRank, uiChecksum);
+
+    //GetSubTreeSize
+    TMeasure oSubTree;
+    for(uiRun = 0; uiRun < m_uiIterations; uiRun++)
+    {
+        oSubTree.Start();
+        uiChecksum = pModel->GetSubTreeSize(idRoot, pStateModel);
+        for(i=0;i<uiSamples;i++) uiChecksum += pModel->GetSubTreeSize(vSampleIDs[i], pStateModel);
+        oSubTree.Stop();
+    }
+    AddResult(rSuite, "get_sub_tree_size", uiSamples + 1, oSubTree, uiChecksum);
+}
+
+/** Sorting proxy, all sorting modes.
+  * The time includes the sorting of all the lists of children
+  * \param rSuite [input]: the description of the model
+  * \param pModel [input]: the data model
+  */
+void BenchmarkRunner::RunSorting(const TSuite &rSuite, wxVirtualIDataModel *pModel)
+{
+    static const wxVirtualSortingDataModel::ESortingMode s_vModes[3] =
+    {
+        wxVirtualSortingDataModel::WX_E_SORTING_FAST,
+        wxVirtualSortingDataModel::WX_E_SORTING_MEMORY_EFFICIENT,
+        wxVirtualSortingDataModel::WX_E_SORTING_PARALLEL
+    };
+    static const char* s_vModeNames[3] = {"fast", "memory_efficient", "parallel"};
+
+    static const size_t s_vFields[3] = {BENCHMARK_FIELD_INTEGER, BENCHMARK_FIELD_DOUBLE, BENCHMARK_FIELD_NAME};
+    static const char* s_vFieldNames[3] = {"integer", "double", "string"};
+
+    size_t uiMode, uiField, uiRun, uiCount = 0;
+    for(uiMode = 0; uiMode < 3; uiMode++)
+    {
+        for(uiField = 0; uiField < 3; uiField++)
+        {
+            wxVirtualSortingDataModel oSortingModel;
+            oSortingModel.AttachMasterModel(pModel);
+            oSortingModel.SetSortingMode(s_vModes[uiMode]);
+
+            wxVirtualIDataModel::TSortFilters vSortFilters;
+            vSortFilters.push_back(wxVirtualIDataModel::TSort(s_vFields[uiField],
+                                                              wxVirtualIDataModel::WX_E_SORT_ASCENDING));
+
+            TMeasure oMeasure;
+            for(uiRun = 0; uiRun < m_uiIterations; uiRun++)
+            {
+                oMeasure.Start();
+                oSortingModel.Sort(vSortFilters);
+                uiCount = LoadAllChildren(&oSortingModel);
+                oMeasure.Stop();
+            }
+            oSortingModel.DetachMasterModel();
+
+            wxString sName = wxString::Format("sort_%s_%s", s_vModeNames[uiMode], s_vFieldNames[uiField]);
+            AddResult(rSuite, sName, uiCount, oMeasure, uiCount);
+        }
+    }
+}
+
+/** Filtering proxy
+  * \param rSuite [input]: the description of the model
+  * \param pModel [input]: the data model
+  */
+void BenchmarkRunner::RunFiltering(const TSuite &rSuite, wxVirtualIDataModel *pModel)
+{
+    size_t uiRun, uiCount = 0;
+
+    //numeric filter : about 1 item out of 2 is accepted
+    wxVirtualDataViewIntegerFilter oIntegerFilter;
+    oIntegerFilter.SetComparisonOperator(wxVirtualDataViewNumericFilter::WX_E_LESS_THAN);
+    oIntegerFilter.UseNumericMatching();
+    oIntegerFilter.SetReferenceValue(wxVariant((long) 500000));
+    oIntegerFilter.SetRecursive(!rSuite.m_bIsList);
+    oIntegerFilter.SetActive();
+
+    //string filter : about 1 item out of 16 is accepted
+    wxVirtualDataViewStringFilter oStringFilter;
+    oStringFilter.UseFullMatchOnly();
+    oStringFilter.SetReferenceValue(wxVariant(wxString("delta")));
+    oStringFilter.SetRecursive(!rSuite.m_bIsList);
+    oStringFilter.SetActive();
+
+    //integer filter
+    wxVirtualFilteringDataModel oFilteringModel;
+    oFilteringModel.AttachMasterModel(pModel);
+    oFilteringModel.PushFilter(BENCHMARK_FIELD_INTEGER, &oIntegerFilter);
+
+    TMeasure oInteger;
+    for(uiRun = 0; uiRun < m_uiIterations; uiRun++)
+    {
+        oFilteringModel.ClearCache();
+        oInteger.Start();
+        uiCount = LoadAllChildren(&oFilteringModel);
+        oInteger.Stop();
+    }
+    AddResult(rSuite, "filter_integer", uiCount, oInteger, uiCount);
+
+    //string filter
+    oFilteringModel.ClearFilters();
+    oFilteringModel.PushFilter(BENCHMARK_FIELD_CATEGORY, &oStringFilter);
+
+    TMeasure oString;
+    for(uiRun = 0; uiRun < m_uiIterations; uiRun++)
+    {
+        oFilteringModel.ClearCache();
+        oString.Start();
+        uiCount = LoadAllChildren(&oFilteringModel);
+        oString.Stop();
+    }
+    AddResult(rSuite, "filter_string", uiCount, oString, uiCount);
+
+    //both filters
+    oFilteringModel.PushFilter(BENCHMARK_FIELD_INTEGER, &oIntegerFilter);
+
+    TMeasure oBoth;
+    for(uiRun = 0; uiRun < m_uiIterations; uiRun++)
+    {
+        oFilteringModel.ClearCache();
+        oBoth.Start();
+        uiCount = LoadAllChildren(&oFilteringModel);
+        oBoth.Stop();
+    }
+    AddResult(rSuite, "filter_integer_and_string", uiCount, oBoth, uiCount);
+
+    oFilteringModel.ClearFilters();
+    oFilteringModel.DetachMasterModel();
+}
+
+/** GetAllValues, typed & variants. All items are scanned (no state model)
+  * \param rSuite [input]: the description of the model
+  * \param pModel [input]: the data model
+  */
+void BenchmarkRunner::RunGetAllValues(const TSuite &rSuite, wxVirtualIDataModel *pModel)
+{
+    size_t uiRun;
+
+    //strings
+    TMeasure oStrings;
+    wxArrayString vStrings;
+    for(uiRun = 0; uiRun < m_uiIterations; uiRun++)
+    {
+        oStrings.Start();
+        pModel->GetAllValues(vStrings, BENCHMARK_FIELD_CATEGORY, WX_VDV_NULL_PTR);
+        oStrings.Stop();
+    }
+    AddResult(rSuite, "get_all_values_string", vStrings.size(), oStrings, vStrings.size());
+    vStrings.clear();
+
+    //longs
+    TMeasure oLongs;
+    wxArrayLong vLongs;
+    for(uiRun = 0; uiRun < m_uiIterations; uiRun++)
+    {
+        oLongs.Start();
+        pModel->GetAllValues(vLongs, BENCHMARK_FIELD_INTEGER, WX_VDV_NULL_PTR);
+        oLongs.Stop();
+    }
+    AddResult(rSuite, "get_all_values_long", vLongs.size(), oLongs, vLongs.size());
+    vLongs.clear();
+
+    //doubles
+    TMeasure oDoubles;
+    wxArrayDouble vDoubles;
+    for(uiRun = 0; uiRun < m_uiIterations; uiRun++)
+    {
+        oDoubles.Start();
+        pModel->GetAllValues(vDoubles, BENCHMARK_FIELD_DOUBLE, WX_VDV_NULL_PTR);
+        oDoubles.Stop();
+    }
+    AddResult(rSuite, "get_all_values_double", vDoubles.size(), oDoubles, vDoubles.size());
+    vDoubles.clear();
+
+    //variants
+    TMeasure oVariants;
+    wxVector<wxVariant> vVariants;
+    for(uiRun = 0; uiRun < m_uiIterations; uiRun++)
+    {
+        oVariants.Start();
+        pModel->GetAllValues(vVariants, BENCHMARK_FIELD_INTEGER, WX_VDV_NULL_PTR);
+        oVariants.Stop();
+    }
+    AddResult(rSuite, "get_all_values_variant", vVariants.size(), oVariants, vVariants.size());
+    vVariants.clear();
+}
+
+/** SelectRange / SelectAll / GetSelectedItems
+  * \param rSuite      [input]: the description of the model
+  * \param pModel      [input]: the data model
+  * \param pStateModel [input]: the state model
+  */
+void BenchmarkRunner::RunSelection(const TSuite &rSuite, wxVirtualIDataModel *pModel,
+                                   wxVirtualIStateModel *pStateModel)
+{
+    size_t uiRun;
+    size_t uiVisibleCount = pModel->GetSubTreeSize(pModel->GetRootItem(), pStateModel);
+    if (uiVisibleCount <= 1) return;
+    uiVisibleCount--; //root item
+
+    size_t uiRange = BENCHMARK_SELECTION_RANGE;
+    if (uiRange > uiVisibleCount) uiRange = uiVisibleCount;
+    wxVirtualItemID idFirst = pModel->FindItem(1, pStateModel);
+    wxVirtualItemID idLast  = pModel->FindItem(uiRange, pStateModel);
+    if (!idLast.IsOK()) idLast = pModel->GetLastItem();
+
+    //SelectRange
+    TMeasure oRange;
+    for(uiRun = 0; uiRun < m_uiIterations; uiRun++)
+    {
+        pStateModel->DeselectAll();
+        oRange.Start();
+        pStateModel->SelectRange(idFirst, idLast, true);
+        oRange.Stop();
+    }
+    AddResult(rSuite, "select_range", uiRange, oRange, uiRange);
+
+    //GetSelectedItems, after SelectRange
+    TMeasure oGetRange;
+    wxVirtualItemIDs vIDs;
+    for(uiRun = 0; uiRun < m_uiIterations; uiRun++)
+    {
+        oGetRange.Start();
+        pStateModel->GetSelectedItems(vIDs);
+        oGetRange.Stop();
+    }
+    AddResult(rSuite, "get_selected_items_range", uiRange, oGetRange, vIDs.size());
+
+    //GetSelectedItemCount, after SelectRange
+    TMeasure oCountRange;
+    size_t uiCount = 0;
+    for(uiRun = 0; uiRun < m_uiIterations; uiRun++)
+    {
+        oCountRange.Start();
+        uiCount = pStateModel->GetSelectedItemCount();
+        oCountRange.Stop();
+    }
+    AddResult(rSuite, "get_selected_item_count_range", uiRange, oCountRange, uiCount);
+
+    //SelectAll
+    TMeasure oAll;
+    for(uiRun = 0; uiRun < m_uiIterations; uiRun++)
+    {
+        pStateModel->DeselectAll();
+        oAll.Start();
+        pStateModel->SelectAll();
+        oAll.Stop();
+    }
+    AddResult(rSuite, "select_all", uiVisibleCount, oAll, uiVisibleCount);
+
+    //GetSelectedItems, after SelectAll
+    TMeasure oGetAll;
+    for(uiRun = 0; uiRun < m_uiIterations; uiRun++)
+    {
+        oGetAll.Start();
+        pStateModel->GetSelectedItems(vIDs);
+        oGetAll.Stop();
+    }
+    AddResult(rSuite, "get_selected_items_all", uiVisibleCount, oGetAll, vIDs.size());
+
+    vIDs.clear();
+    pStateModel->DeselectAll();
+}
+
+/** Off-screen rendering of PaintModel() into a wxMemoryDC
+  * The frames are painted with the first item at the top, and then with the middle item at the top
+  * \param rSuite [input]: the description of the model
+  */
+void BenchmarkRunner::RunRendering(const TSuite &rSuite)
+{
+    //create a control in a frame
+    wxFrame *pFrame = new wxFrame(WX_VDV_NULL_PTR, wxID_ANY, "wxVirtualDataViewCtrl benchmark",
+                                  wxDefaultPosition, wxSize(BENCHMARK_RENDER_WIDTH, BENCHMARK_RENDER_HEIGHT));
+    wxVirtualDataViewCtrl *pCtrl;
+    if (rSuite.m_bIsList)
+    {
+        pCtrl = new wxVirtualDataViewListCtrl(pFrame, wxID_ANY, wxDefaultPosition, wxDefaultSize, 0);
+    }
+    else
+    {
+        pCtrl = new wxVirtualDataViewCtrl(pFrame, wxID_ANY, wxDefaultPosition, wxDefaultSize, 0);
+    }
+    AddColumns(pCtrl);
+    pCtrl->SetDataModel(CreateModel(rSuite));
+    if (!rSuite.m_bIsList) pCtrl->ExpandAll(true, false);
+    pFrame->Show(true);
+    wxTheApp->Yield(true);
+
+    wxVirtualIModelRenderer *pRenderer = pCtrl->GetModelRenderer();
+    wxVirtualDataViewBase *pClient = pCtrl->GetMainWindow();
+    if ((pRenderer) && (pClient))
+    {
+        wxSize sz = pClient->GetClientSize();
+        if (sz.GetWidth() < 1)  sz.SetWidth(BENCHMARK_RENDER_WIDTH);
+        if (sz.GetHeight() < 1) sz.SetHeight(BENCHMARK_RENDER_HEIGHT);
+        wxBitmap oBitmap(sz.GetWidth(), sz.GetHeight());
+        wxMemoryDC oDC(oBitmap);
+
+        bool bWasEnabled = wxVirtualDataViewCtrl::ArePerformanceCountersEnabled();
+        wxVirtualDataViewCtrl::EnablePerformanceCounters(true);
+
+        size_t uiPass, uiRun, uiFrame;
+        for(uiPass = 0; uiPass < 2; uiPass++)
+        {
+            //scroll
+            wxString sName = "paint_model_top";
+            if (uiPass == 1)
+            {
+                sName = "paint_model_middle";
+                wxVirtualIDataModel *pDataModel = pCtrl->GetDataModel();
+                wxVirtualIStateModel *pStateModel = pCtrl->GetStateModel();
+                size_t uiVisible = pDataModel->GetSubTreeSize(pDataModel->GetRootItem(), pStateModel);
+                wxVirtualItemID idMiddle = pDataModel->FindItem(uiVisible / 2, pStateModel);
+                pCtrl->MakeItemVisible(idMiddle, 0, wxVirtualDataViewCtrl::WX_VISIBLE_AT_TOP, false);
+            }
+
+            //paint
+            pCtrl->ResetStatistics();
+            TMeasure oMeasure;
+            for(uiRun = 0; uiRun < m_uiIterations; uiRun++)
+            {
+                oMeasure.Start();
+                for(uiFrame = 0; uiFrame < BENCHMARK_RENDER_FRAMES; uiFrame++) pRenderer->PaintModel(oDC);
+                oMeasure.Stop();
+            }
+
+            wxVirtualDataViewStats oStats;
+            pCtrl->GetStatistics(oStats);
+            TResult &rResult = AddResult(rSuite, sName, BENCHMARK_RENDER_FRAMES, oMeasure,
+                                         oStats.m_uiItemsDrawnPerFrame);
+
+            TMetric oMetric;
+            oMetric.m_sName  = "items_drawn_per_frame";
+            oMetric.m_dValue = oStats.m_uiItemsDrawnPerFrame;
+            rResult.m_vMetrics.push_back(oMetric);
+            oMetric.m_sName  = "model_calls_per_frame";
+            oMetric.m_dValue = oStats.m_uiModelCallsPerFrame;
+            rResult.m_vMetrics.push_back(oMetric);
+            oMetric.m_sName  = "gdi_objects_per_frame";
+            oMetric.m_dValue = oStats.m_uiGDIObjectsPerFrame;
+            rResult.m_vMetrics.push_back(oMetric);
+            oMetric.m_sName  = "text_measures_per_frame";
+            oMetric.m_dValue = oStats.m_uiTextMeasuresPerFrame;
+            rResult.m_vMetrics.push_back(oMetric);
+            oMetric.m_sName  = "average_frame_ms";
+            oMetric.m_dValue = oStats.m_dAveragePaintTime;
+            rResult.m_vMetrics.push_back(oMetric);
+        }
+
+        oDC.SelectObject(wxNullBitmap);
+        wxVirtualDataViewCtrl::EnablePerformanceCounters(bWasEnabled);
+    }
+
+    pFrame->Destroy();
+    wxTheApp->Yield(true);
+}
+
+/** Off-screen rendering of PaintModel() into a wxMemoryDC, for a model with slow values (flat lists only)
+  * The list is scrolled between 2 frames, so that most of the painted rows are new. The frames are painted
+  * from the slow model directly, then through a wxVirtualAsyncDataModel adapter, and then through a
+  * wxVirtualPagingDataModel prefetching the pages ahead of the scrolling
+  * \param rSuite [input]: the description of the model
+  */
+void BenchmarkRunner::RunAsyncRendering(const TSuite &rSuite)
+{
+    if (!rSuite.m_bIsList) return;
+    if (rSuite.m_uiItemCount == 0) return;
+
+    size_t uiPass, uiRun, uiFrame, uiRank;
+    for(uiPass = 0; uiPass < 3; uiPass++)
+    {
+        //create a control in a frame
+        wxFrame *pFrame = new wxFrame(WX_VDV_NULL_PTR, wxID_ANY, "wxVirtualDataViewCtrl benchmark",
+                                      wxDefaultPosition, wxSize(BENCHMARK_RENDER_WIDTH, BENCHMARK_RENDER_HEIGHT));
+        wxVirtualDataViewCtrl *pCtrl = new wxVirtualDataViewListCtrl(pFrame, wxID_ANY, wxDefaultPosition,
+                                                                     wxDefaultSize, 0);
+        AddColumns(pCtrl);
+
+        wxString sName = "paint_model_slow_sync";
+        wxVirtualIDataModel *pSlowModel = new BenchmarkSlowListModel(rSuite.m_uiItemCount,
+                                                                     BENCHMARK_SLOW_VALUE_DELAY);
+        wxVirtualAsyncDataModel *pAsyncModel = WX_VDV_NULL_PTR;
+        wxVirtualPagingDataModel *pPagingModel = WX_VDV_NULL_PTR;
+        if (uiPass == 1)
+        {
+            sName = "paint_model_slow_async";
+            pAsyncModel = new wxVirtualAsyncDataModel;
+            pAsyncModel->AttachMasterModel(pSlowModel);
+            pCtrl->SetDataModel(pAsyncModel);
+        }
+        else if (uiPass == 2)
+        {
+            sName = "paint_model_slow_paged";
+            pPagingModel = new wxVirtualPagingDataModel(new wxVirtualPrefetchPolicy(BENCHMARK_SLOW_PAGE_SIZE));
+            pPagingModel->AttachMasterModel(pSlowModel);
+            pCtrl->SetDataModel(pPagingModel);
+        }
+        else
+        {
+            pCtrl->SetDataModel(pSlowModel);
+        }
+        pFrame->Show(true);
+        wxTheApp->Yield(true);
+
+        wxVirtualIModelRenderer *pRenderer = pCtrl->GetModelRenderer();
+        wxVirtualDataViewBase *pClient = pCtrl->GetMainWindow();
+        if ((pRenderer) && (pClient))
+        {
+            wxSize sz = pClient->GetClientSize();
+            if (sz.GetWidth() < 1)  sz.SetWidth(BENCHMARK_RENDER_WIDTH);
+            if (sz.GetHeight() < 1) sz.SetHeight(BENCHMARK_RENDER_HEIGHT);
+            wxBitmap oBitmap(sz.GetWidth(), sz.GetHeight());
+            wxMemoryDC oDC(oBitmap);
+
+            bool bWasEnabled = wxVirtualDataViewCtrl::ArePerformanceCountersEnabled();
+            wxVirtualDataViewCtrl::EnablePerformanceCounters(true);
+
+            //paint, scrolling between 2 frames
+            wxVirtualIDataModel *pDataModel = pCtrl->GetDataModel();
+            wxVirtualIStateModel *pStateModel = pCtrl->GetStateModel();
+            pCtrl->ResetStatistics();
+            TMeasure oMeasure;
+            uiRank = 0;
+            for(uiRun = 0; uiRun < m_uiIterations; uiRun++)
+            {
+                oMeasure.Start();
+                for(uiFrame = 0; uiFrame < BENCHMARK_RENDER_FRAMES; uiFrame++)
+                {
+                    wxVirtualItemID id = pDataModel->FindItem(uiRank % rSuite.m_uiItemCount, pStateModel);
+                    pCtrl->MakeItemVisible(id, 0, wxVirtualDataViewCtrl::WX_VISIBLE_AT_TOP, false);
+                    pRenderer->PaintModel(oDC);
+                    uiRank += BENCHMARK_SLOW_SCROLL_STEP;
+                }
+                oMeasure.Stop();
+            }
+
+            wxVirtualDataViewStats oStats;
+            pCtrl->GetStatistics(oStats);
+            TResult &rResult = AddResult(rSuite, sName, BENCHMARK_RENDER_FRAMES, oMeasure,
+                                         oStats.m_uiItemsDrawnPerFrame);
+
+            TMetric oMetric;
+            oMetric.m_sName  = "items_drawn_per_frame";
+            oMetric.m_dValue = oStats.m_uiItemsDrawnPerFrame;
+            rResult.m_vMetrics.push_back(oMetric);
+            oMetric.m_sName  = "average_frame_ms";
+            oMetric.m_dValue = oStats.m_dAveragePaintTime;
+            rResult.m_vMetrics.push_back(oMetric);
+            if (pAsyncModel)
+            {
+                oMetric.m_sName  = "placeholder_cells";
+                oMetric.m_dValue = pAsyncModel->GetCacheMisses();
+                rResult.m_vMetrics.push_back(oMetric);
+                oMetric.m_sName  = "cached_cells";
+                oMetric.m_dValue = pAsyncModel->GetCacheHits();
+                rResult.m_vMetrics.push_back(oMetric);
+                oMetric.m_sName  = "cancelled_requests";
+                oMetric.m_dValue = pAsyncModel->GetCancelledRequestCount();
+                rResult.m_vMetrics.push_back(oMetric);
+            }
+            if (pPagingModel)
+            {
+                oMetric.m_sName  = "prefetched_pages";
+                oMetric.m_dValue = pPagingModel->GetPrefetchedPageCount();
+                rResult.m_vMetrics.push_back(oMetric);
+                oMetric.m_sName  = "page_misses";
+                oMetric.m_dValue = pPagingModel->GetPageMisses();
+                rResult.m_vMetrics.push_back(oMetric);
+            }
+
+            oDC.SelectObject(wxNullBitmap);
+            wxVirtualDataViewCtrl::EnablePerformanceCounters(bWasEnabled);
+        }
+
+        pFrame->Destroy();
+        wxTheApp->Yield(true);
+    }
+}
+
+//--------------------------- HELPERS -------------------------------//
+/** Get the children of all items with an expander.
+  * This forces the proxy models to compute all their lists of children
+  * \param pModel [input]: the data model to scan
+  * \return the amount of items found, root excluded
+  */
+size_t BenchmarkRunner::LoadAllChildren(wxVirtualIDataModel *pModel) const
+{
+    size_t uiCount = 0;
+    wxVector<TLoadFrame> vStack;
+    TLoadFrame oFrame;
+    oFrame.m_ID      = pModel->GetRootItem();
+    oFrame.m_uiCount = pModel->GetChildCount(oFrame.m_ID);
+    oFrame.m_uiNext  = 0;
+    vStack.push_back(oFrame);
+
+    while (!vStack.empty())
+    {
+        TLoadFrame &rTop = vStack.back();
+        if (rTop.m_uiNext >= rTop.m_uiCount)
+        {
+            vStack.pop_back();
+            continue;
+        }
+
+        wxVirtualItemID idChild = pModel->GetChild(rTop.m_ID, rTop.m_uiNext);
+        rTop.m_uiNext++;
+        uiCount++;
+        if (!pModel->HasExpander(idChild)) continue;
+
+        oFrame.m_ID      = idChild;
+        oFrame.m_uiCount = pModel->GetChildCount(idChild);
+        oFrame.m_uiNext  = 0;
+        vStack.push_back(oFrame);
+    }
+    return(uiCount);
+}
+
+/** Add a column per field
+  * \param pCtrl [input]: the control to modify
+  */
+void BenchmarkRunner::AddColumns(wxVirtualDataViewCtrl *pCtrl) const
+{
+    wxVirtualDataViewColumn oName("Name", BENCHMARK_FIELD_NAME);
+    oName.SetType(wxVirtualDataViewColumn::wxVDATAVIEW_COL_STRING);
+    oName.SetFromType();
+    oName.SetWidth(250);
+    pCtrl->Columns().AppendColumn(oName);
+
+    wxVirtualDataViewColumn oInteger("Integer", BENCHMARK_FIELD_INTEGER);
+    oInteger.SetType(wxVirtualDataViewColumn::wxVDATAVIEW_COL_INTEGER);
+    oInteger.SetFromType();
+    oInteger.SetWidth(120);
+    pCtrl->Columns().AppendColumn(oInteger);
+
+    wxVirtualDataViewColumn oDouble("Double", BENCHMARK_FIELD_DOUBLE);
+    oDouble.SetType(wxVirtualDataViewColumn::wxVDATAVIEW_COL_DOUBLE);
+    oDouble.SetFromType();
+    oDouble.SetWidth(120);
+    pCtrl->Columns().AppendColumn(oDouble);
+
+    wxVirtualDataViewColumn oBool("Bool", BENCHMARK_FIELD_BOOL);
+    oBool.SetType(wxVirtualDataViewColumn::wxVDATAVIEW_COL_BOOL);
+    oBool.SetFromType();
+    oBool.SetWidth(50);
+    pCtrl->Columns().AppendColumn(oBool);
+
+    wxVirtualDataViewColumn oCategory("Category", BENCHMARK_FIELD_CATEGORY);
+    oCategory.SetType(wxVirtualDataViewColumn::wxVDATAVIEW_COL_STRING);
+    oCategory.SetFromType();
+    oCategory.SetWidth(120);
+    pCtrl->Columns().AppendColumn(oCategory);
+}
+
+/** Record a result
+  * \param rSuite     [input]: the description of the model
+  * \param sName      [input]: the name of the benchmark
+  * \param uiItems    [input]: the amount of items processed per run
+  * \param rMeasure   [input]: the timings
+  * \param uiChecksum [input]: the result of the work
+  * \return a reference to the new result, for adding metrics
+  */
+BenchmarkRunner::TResult& BenchmarkRunner::AddResult(const TSuite &rSuite, const wxString &sName,
+                                                     size_t uiItems, const TMeasure &rMeasure,
+                                                     size_t uiChecksum)
+{
+    TResult oResult;
+    oResult.m_sSuite        = rSuite.m_sName;
+    oResult.m_sName         = sName;
+    oResult.m_uiItems       = uiItems;
+    oResult.m_uiIterations  = rMeasure.m_uiRuns;
+    oResult.m_dMinTime      = rMeasure.m_llMin.ToDouble() / 1000.0;
+    oResult.m_dMaxTime      = rMeasure.m_llMax.ToDouble() / 1000.0;
+    oResult.m_dMeanTime     = 0.0;
+    if (rMeasure.m_uiRuns > 0) oResult.m_dMeanTime = rMeasure.m_llTotal.ToDouble() / 1000.0 / rMeasure.m_uiRuns;
+    oResult.m_uiChecksum    = uiChecksum;
+    m_vResults.push_back(oResult);
+
+    wxPrintf("    %-32s %12lu items %12.3f ms\n", sName, (unsigned long) uiItems, oResult.m_dMinTime);
+    return(m_vResults.back());
+}
+
+//--------------------------- RESULTS -------------------------------//
+/** Write the results in a JSON file
+  * \param sFileName [input]: the file to write
+  * \return true on success, false otherwise
+  */
+bool BenchmarkRunner::WriteJSON(const wxString &sFileName) const
+{
+    wxString sJSON = "{\n";
+    sJSON += "  \"library\": \"wxVirtualDataView\",\n";
+    sJSON += "  \"wx_version\": " + JSONString(wxVERSION_STRING) + ",\n";
+    sJSON += "  \"platform\": " + JSONString(wxGetOsDescription()) + ",\n";
+    sJSON += "  \"date\": " + JSONString(wxDateTime::Now().FormatISOCombined(' ')) + ",\n";
+    sJSON += wxString::Format("  \"iterations\": %lu,\n", (unsigned long) m_uiIterations);
+    sJSON += "  \"results\": [\n";
+
+    size_t i, uiNbResults;
+    uiNbResults = m_vResults.size();
+    for(i=0;i<uiNbResults;i++)
+    {
+        const TResult &rResult = m_vResults[i];
+        double dItemsPerSecond = 0.0;
+        if (rResult.m_dMinTime > 0.0) dItemsPerSecond = rResult.m_uiItems * 1000.0 / rResult.m_dMinTime;
+
+        sJSON += "    {";
+        sJSON += "\"suite\": " + JSONString(rResult.m_sSuite);
+        sJSON += ", \"name\": " + JSONString(rResult.m_sName);
+        sJSON += wxString::Format(", \"items\": %lu", (unsigned long) rResult.m_uiItems);
+        sJSON += wxString::Format(", \"iterations\": %lu", (unsigned long) rResult.m_uiIterations);
+        sJSON += ", \"min_ms\": " + JSONNumber(rResult.m_dMinTime);
+        sJSON += ", \"mean_ms\": " + JSONNumber(rResult.m_dMeanTime);
+        sJSON += ", \"max_ms\": " + JSONNumber(rResult.m_dMaxTime);
+        sJSON += ", \"items_per_second\": " + JSONNumber(dItemsPerSecond);
+        sJSON += wxString::Format(", \"checksum\": %lu", (unsigned long) rResult.m_uiChecksum);
+
+        size_t j, uiNbMetrics;
+        uiNbMetrics = rResult.m_vMetrics.size();
+        for(j=0;j<uiNbMetrics;j++)
+        {
+            sJSON += ", " + JSONString(rResult.m_vMetrics[j].m_sName) + ": " + JSONNumber(rResult.m_vMetrics[j].m_dValue);
+        }
+
+        sJSON += "}";
+        if (i + 1 < uiNbResults) sJSON += ",";
+        sJSON += "\n";
+    }
+    sJSON += "  ]\n";
+    sJSON += "}\n";
+
+    wxFFile oFile(sFileName, "w");
+    if (!oFile.IsOpened()) return(false);
+    return(oFile.Write(sJSON, wxConvUTF8));
+}
+
+/** Print the results on the standard output
+  */
+void BenchmarkRunner::PrintSummary(void) const
+{
+    wxPrintf("\n%-20s %-32s %12s %12s %12s %14s\n", "suite", "benchmark", "items", "min (ms)", "mean (ms)", "items/s");
+
+    size_t i, uiNbResults;
+    uiNbResults = m_vResults.size();
+    for(i=0;i<uiNbResults;i++)
+    {
+        const TResult &rResult = m_vResults[i];
+        double dItemsPerSecond = 0.0;
+        if (rResult.m_dMinTime > 0.0) dItemsPerSecond = rResult.m_uiItems * 1000.0 / rResult.m_dMinTime;
+        wxPrintf("%-20s %-32s %12lu %12.3f %12.3f %14.0f\n",
+                 rResult.m_sSuite, rResult.m_sName, (unsigned long) rResult.m_uiItems,
+                 rResult.m_dMinTime, rResult.m_dMeanTime, dItemsPerSecond);
+    }
+}
@@ -0,0 +1,123 @@
+/**********************************************************************/
+/** FILE    : BenchmarkRunner.h                                      **/
+/** PROJECT : wxVirtualDataViewCtrl                                  **/
+/** LICENSE : wxWindows Library Licence                              **/
+/** PURPOSE : run the benchmarks & record the results                **/
+/**********************************************************************/
+
+#ifndef WX_VIRTUAL_BENCHMARK_RUNNER_H_
+#define WX_VIRTUAL_BENCHMARK_RUNNER_H_
+
+#include <wx/VirtualDataView/VirtualDataViewDefs.h>
+#include <wx/VirtualDataView/VirtualItemID.h>
+#include <wx/longlong.h>
+#include <wx/string.h>
+#include <wx/vector.h>
+
+class WXDLLIMPEXP_VDV wxVirtualIDataModel;
+class WXDLLIMPEXP_VDV wxVirtualIStateModel;
+class WXDLLIMPEXP_VDV wxVirtualDataViewCtrl;
+
+/** \class BenchmarkRunner : run the benchmarks on the synthetic models & record the results
+  * Each benchmark is run several times. The minimal, mean and maximal times are recorded.
+  * Results are written as JSON, so that a run can be compared against a baseline
+  */
+class BenchmarkRunner
+{
+    public:
+        /// \struct TSuite : description of a synthetic model
+        struct TSuite
+        {
+            wxString            m_sName;                                                ///< \brief name of the suite
+            bool                m_bIsList;                                              ///< \brief true for a flat list, false for a tree
+            size_t              m_uiItemCount;                                          ///< \brief amount of items (flat list only)
+            wxVector<size_t>    m_vFanOut;                                              ///< \brief fan-out of each level (tree only)
+        };
+
+        //constructors & destructor
+        BenchmarkRunner(void);                                                          ///< \brief constructor
+        ~BenchmarkRunner(void);                                                         ///< \brief destructor
+
+        //options
+        void    SetIterations(size_t uiIterations);                                     ///< \brief set the amount of runs per benchmark
+        size_t  GetIterations(void) const;                                              ///< \brief get the amount of runs per benchmark
+        void    SetSampleCount(size_t uiSamples);                                       ///< \brief set the amount of items used for random access queries
+        size_t  GetSampleCount(void) const;                                             ///< \brief get the amount of items used for random access queries
+        void    EnableRendering(bool bEnable = true);                                   ///< \brief enable / disable the rendering benchmarks
+        bool    IsRenderingEnabled(void) const;                                         ///< \brief check if the rendering benchmarks are enabled
+
+        //run
+        void    RunSuite(const TSuite &rSuite);                                         ///< \brief run all the benchmarks on a synthetic model
+
+        //results
+        bool    WriteJSON(const wxString &sFileName) const;                             ///< \brief write the results in a JSON file
+        void    PrintSummary(void) const;                                               ///< \brief print the results on the standard output
+
+    private:
+        /// \struct TMetric : an additional named value attached to a result
+        struct TMetric
+        {
+            wxString    m_sName;                                                        ///< \brief name of the metric
+            double      m_dValue;                                                       ///< \brief value of the metric
+        };
+
+        /// \struct TResult : the result of 1 benchmark
+        struct TResult
+        {
+            wxString            m_sSuite;                                               ///< \brief name of the suite
+            wxString            m_sName;                                                ///< \brief name of the benchmark
+            size_t              m_uiItems;                                              ///< \brief amount of items processed per run
+            size_t              m_uiIterations;                                         ///< \brief amount of runs
+            double              m_dMinTime;                                             ///< \brief fastest run (ms)
+            double              m_dMeanTime;                                            ///< \brief mean run (ms)
+            double              m_dMaxTime;                                             ///< \brief slowest run (ms)
+            size_t              m_uiChecksum;                                           ///< \brief result of the work (guards against dead code elimination)
+            wxVector<TMetric>   m_vMetrics;                                             ///< \brief additional metrics
+        };
+
+        /// \class TMeasure : accumulate the timings of several runs
+        class TMeasure
+        {
+            public:
+                TMeasure(void);                                                         ///< \brief constructor
+                void    Start(void);                                                    ///< \brief start a run
+                void    Stop(void);                                                     ///< \brief stop a run
+
+                wxLongLong  m_llStart;                                                  ///< \brief start of the current run
+                wxLongLong  m_llTotal;                                                  ///< \brief total time (microseconds)
+                wxLongLong  m_llMin;                                                    ///< \brief fastest run (microseconds)
+                wxLongLong  m_llMax;                                                    ///< \brief slowest run (microseconds)
+                size_t      m_uiRuns;                                                   ///< \brief amount of runs
+        };
+
+        //data
+        wxVector<TResult>   m_vResults;                                                 ///< \brief the results
+        size_t              m_uiIterations;                                             ///< \brief amount of runs per benchmark
+        size_t              m_uiSamples;                                                ///< \brief amount of items used for random access queries
+        bool                m_bRendering;                                               ///< \brief true if the rendering benchmarks are run
+
+        //models
+        wxVirtualIDataModel*    CreateModel(const TSuite &rSuite) const;                ///< \brief create the synthetic model of a suite
+        wxVirtualIStateModel*   CreateStateModel(const TSuite &rSuite,
+                                                 wxVirtualIDataModel *pModel) const;    ///< \brief create a state model with all items expanded
+
+        //benchmarks
+        void    RunTraversal(const TSuite &rSuite, wxVirtualIDataModel *pModel,
+                             wxVirtualIStateModel *pStateModel);                        ///< \brief NextItem / PrevItem walks, GetItemRank, FindItem, GetSubTreeSize
+        void    RunSorting(const TSuite &rSuite, wxVirtualIDataModel *pModel);          ///< \brief sorting proxy, all sorting modes
+        void    RunFiltering(const TSuite &rSuite, wxVirtualIDataModel *pModel);        ///< \brief filtering proxy
+        void    RunGetAllValues(const TSuite &rSuite, wxVirtualIDataModel *pModel);     ///< \brief GetAllValues, typed & variants
+        void    RunSelection(const TSuite &rSuite, wxVirtualIDataModel *pModel,
+                             wxVirtualIStateModel *pStateModel);                        ///< \brief SelectRange / SelectAll / GetSelectedItems
+        void    RunRendering(const TSuite &rSuite);                                     ///< \brief off-screen PaintModel
+        void    RunAsyncRendering(const TSuite &rSuite);                                ///< \brief off-screen PaintModel of a slow model, with & without async / paging adapters
+
+        //helpers
+        size_t  LoadAllChildren(wxVirtualIDataModel *pModel) const;                     ///< \brief get the children of all items with an expander
+        void    AddColumns(wxVirtualDataViewCtrl *pCtrl) const;                         ///< \brief add a column per field
+        TResult& AddResult(const TSuite &rSuite, const wxString &sName,
+                           size_t uiItems, const TMeasure &rMeasure,
+                           size_t uiChecksum);                                          ///< \brief record a result
+};
+
+#endif // WX_VIRTUAL_BENCHMARK_RUNNER_H_
@@ -0,0 +1,167 @@
+/**********************************************************************/
+/** FILE    : main.cpp                                               **/
+/** PROJECT : wxVirtualDataViewCtrl                                  **/
+/** LICENSE : wxWindows Library Licence                              **/
+/** PURPOSE : benchmark executable                                   **/
+/**********************************************************************/
+
+// For compilers that support precompilation, includes "wx/wx.h".
+#include "wx/wxprec.h"
+
+#ifdef __BORLANDC__
+#pragma hdrstop
+#endif
+
+#ifndef WX_PRECOMP
+    #include "wx/wx.h"
+#endif
+
+#include "BenchmarkRunner.h"
+#include <wx/cmdline.h>
+
+//default options
+#define BENCHMARK_DEFAULT_ROWS          10000000
+#define BENCHMARK_DEFAULT_ITERATIONS    3
+#define BENCHMARK_DEFAULT_SAMPLES       10000
+#define BENCHMARK_DEFAULT_OUTPUT        "benchmark.json"
+
+/** \class BenchmarkApp : run all the benchmarks, write the results & exit
+  * Usage:
+  *     VirtualDataViewBenchmark [-o results.json] [-r rows] [-n iterations] [-s suite] [--no-rendering]
+  * The rendering benchmarks need a display. On Linux, Xvfb is enough:
+  *     xvfb-run ./VirtualDataViewBenchmark -o results.json
+  */
+class BenchmarkApp : public wxApp
+{
+    public:
+        //wxApp override
+        virtual bool OnInit(void);                                                      ///< \brief run the benchmarks
+        virtual int  OnRun(void);                                                       ///< \brief do not enter the main loop
+        virtual void OnInitCmdLine(wxCmdLineParser &rParser);                           ///< \brief declare the command line options
+        virtual bool OnCmdLineParsed(wxCmdLineParser &rParser);                         ///< \brief read the command line options
+
+    private:
+        //data
+        wxString    m_sOutput;                                                          ///< \brief the JSON output file
+        wxString    m_sSuite;                                                           ///< \brief run only this suite (empty = all)
+        long        m_lRows;                                                            ///< \brief amount of rows of the flat list
+        long        m_lIterations;                                                      ///< \brief amount of runs per benchmark
+        long        m_lSamples;                                                         ///< \brief amount of items for random access queries
+        bool        m_bRendering;                                                       ///< \brief true for running the rendering benchmarks
+        int         m_iExitCode;                                                        ///< \brief the exit code
+};
+
+wxIMPLEMENT_APP(BenchmarkApp);
+
+/** Declare the command line options
+  * \param rParser [input]: the command line parser
+  */
+void BenchmarkApp::OnInitCmdLine(wxCmdLineParser &rParser)
+{
+    wxApp::OnInitCmdLine(rParser);
+    rParser.AddOption("o", "output", "JSON file for the results (default: " BENCHMARK_DEFAULT_OUTPUT ")");
+    rParser.AddOption("r", "rows", "amount of rows of the flat list (default: 10000000)", wxCMD_LINE_VAL_NUMBER);
+    rParser.AddOption("n", "iterations", "amount of runs per benchmark (default: 3)", wxCMD_LINE_VAL_NUMBER);
+    rParser.AddOption("q", "samples", "amount of items for GetItemRank / FindItem / GetSubTreeSize (default: 10000)", wxCMD_LINE_VAL_NUMBER);
+    rParser.AddOption("s", "suite", "run only 1 suite: flat_list, deep_narrow_tree, wide_shallow_tree");
+    rParser.AddSwitch("", "no-rendering", "skip the off-screen rendering benchmarks");
+}
+
+/** Read the command line options
+  * \param rParser [input]: the command line parser
+  * \return true if the options are valid
+  */
+bool BenchmarkApp::OnCmdLineParsed(wxCmdLineParser &rParser)
+{
+    if (!wxApp::OnCmdLineParsed(rParser)) return(false);
+
+    m_sOutput     = BENCHMARK_DEFAULT_OUTPUT;
+    m_lRows       = BENCHMARK_DEFAULT_ROWS;
+    m_lIterations = BENCHMARK_DEFAULT_ITERATIONS;
+    m_lSamples    = BENCHMARK_DEFAULT_SAMPLES;
+    m_bRendering  = !rParser.Found("no-rendering");
+
+    rParser.Found("o", &m_sOutput);
+    rParser.Found("s", &m_sSuite);
+    rParser.Found("r", &m_lRows);
+    rParser.Found("n", &m_lIterations);
+    rParser.Found("q", &m_lSamples);
+
+    if ((m_lRows <= 0) || (m_lIterations <= 0) || (m_lSamples <= 0))
+    {
+        wxFprintf(stderr, "rows, iterations and samples must be > 0\n");
+        return(false);
+    }
+    return(true);
+}
+
+/** Run the benchmarks
+  * \return false : the application exits once the results are written
+  */
+bool BenchmarkApp::OnInit(void)
+{
+    m_iExitCode = 0;
+    if (!wxApp::OnInit()) return(false);
+
+    BenchmarkRunner oRunner;
+    oRunner.SetIterations(m_lIterations);
+    oRunner.SetSampleCount(m_lSamples);
+    oRunner.EnableRendering(m_bRendering);
+
+    //the synthetic models
+    size_t i;
+    wxVector<BenchmarkRunner::TSuite> vSuites;
+    BenchmarkRunner::TSuite oSuite;
+
+    oSuite.m_sName       = "flat_list";
+    oSuite.m_bIsList     = true;
+    oSuite.m_uiItemCount = m_lRows;
+    vSuites.push_back(oSuite);
+
+    //2^21 - 2 items, 20 levels
+    oSuite.m_sName       = "deep_narrow_tree";
+    oSuite.m_bIsList     = false;
+    oSuite.m_uiItemCount = 0;
+    oSuite.m_vFanOut.clear();
+    for(i=0;i<20;i++) oSuite.m_vFanOut.push_back(2);
+    vSuites.push_back(oSuite);
+
+    //1001000 items, 2 levels
+    oSuite.m_sName       = "wide_shallow_tree";
+    oSuite.m_vFanOut.clear();
+    for(i=0;i<2;i++) oSuite.m_vFanOut.push_back(1000);
+    vSuites.push_back(oSuite);
+
+    //run
+    size_t uiNbSuites, uiRun = 0;
+    uiNbSuites = vSuites.size();
+    for(i=0;i<uiNbSuites;i++)
+    {
+        if ((!m_sSuite.IsEmpty()) && (m_sSuite != vSuites[i].m_sName)) continue;
+        oRunner.RunSuite(vSuites[i]);
+        uiRun++;
+    }
+    if (uiRun == 0)
+    {
+        wxFprintf(stderr, "unknown suite %s\n", m_sSuite);
+        m_iExitCode = 1;
+        return(true);
+    }
+
+    //results
+    oRunner.PrintSummary();
+    if (!oRunner.WriteJSON(m_sOutput))
+    {
+        wxFprintf(stderr, "cannot write %s\n", m_sOutput);
+        m_iExitCode = 1;
+    }
+    return(true);
+}
+
+/** Do not enter the main loop : all the work is done in OnInit()
+  * \return the exit code
+  */
+int BenchmarkApp::OnRun(void)
+{
+    return(m_iExitCode);
+}